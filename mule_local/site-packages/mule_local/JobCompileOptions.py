@@ -78,6 +78,12 @@ class JobCompileOptions(InfoError):
         # Use reduce all instead of reduce to root rank
         self.rexi_allreduce = 'disable'
 
+        # FLOP/byte counters for core kernels
+        self.kernel_counters = 'disable'
+
+        # Complex kernels on split real/imaginary parts
+        self.complex_split = 'disable'
+
         # Memory allocator
         if _exec_command('uname -s') == "Darwin":
             # Deactivate efficient NUMA block allocation on MacOSX systems (missing numa.h0 file)
@@ -107,6 +113,7 @@ class JobCompileOptions(InfoError):
         self.sphere_spectral_space = 'disable'
         self.sphere_spectral_dealiasing = 'enable'
         self.libxml = 'disable'
+        self.zlib = 'disable'
 
         # GUI
         self.gui = 'disable'
@@ -155,6 +162,8 @@ class JobCompileOptions(InfoError):
         retval += ' --rexi-timings='+self.rexi_timings
         retval += ' --rexi-timings-additional-barriers='+self.rexi_timings_additional_barriers
         retval += ' --rexi-allreduce='+self.rexi_allreduce
+        retval += ' --kernel-counters='+self.kernel_counters
+        retval += ' --complex-split='+self.complex_split
 
         # Memory allocator
         retval += ' --numa-block-allocator='+str(self.numa_block_allocator)
@@ -182,6 +191,7 @@ class JobCompileOptions(InfoError):
         retval += ' --sphere-spectral-space='+self.sphere_spectral_space
         retval += ' --sphere-spectral-dealiasing='+self.sphere_spectral_dealiasing
         retval += ' --libxml='+self.libxml
+        retval += ' --zlib='+self.zlib
 
         # GUI
         retval += ' --gui='+self.gui
@@ -404,6 +414,19 @@ class JobCompileOptions(InfoError):
         self.libxml = scons.GetOption('libxml')
 
 
+        #
+        # ZLIB
+        #
+        scons.AddOption(    '--zlib',
+                dest='zlib',
+                type='choice',
+                choices=['enable','disable'],
+                default='disable',
+                help='Compile with zlib for compressed output and checkpoints: enable, disable [default: %default]'
+        )
+        self.zlib = scons.GetOption('zlib')
+
+
         scons.AddOption(    '--plane-spectral-dealiasing',
                 dest='plane_spectral_dealiasing',
                 type='choice',
@@ -486,6 +509,24 @@ class JobCompileOptions(InfoError):
         )
         self.rexi_allreduce = scons.GetOption('rexi_allreduce')
 
+        scons.AddOption(    '--kernel-counters',
+                dest='kernel_counters',
+                type='choice',
+                choices=['enable','disable'],
+                default='disable',
+                help='FLOP/byte counters (analytical models and perf_event hardware counters) for core kernels: enable, disable [default: %default]'
+        )
+        self.kernel_counters = scons.GetOption('kernel_counters')
+
+        scons.AddOption(    '--complex-split',
+                dest='complex_split',
+                type='choice',
+                choices=['enable','disable'],
+                default='disable',
+                help='Vectorized complex kernels with real arithmetic and REXI sums with split real/imaginary parts: enable, disable [default: %default]'
+        )
+        self.complex_split = scons.GetOption('complex_split')
+
 
         scons.AddOption(    '--sweet-mpi',
                 dest='sweet_mpi',
@@ -656,6 +697,9 @@ class JobCompileOptions(InfoError):
             if self.libfft == 'enable':
                 retval+='_fft'
 
+            if self.zlib == 'enable':
+                retval+='_zlib'
+
             retval += '_'+self.compiler
 
         if not 'compile.parallelization' in i_filter_list:
@@ -677,6 +721,12 @@ class JobCompileOptions(InfoError):
             if self.rexi_allreduce == 'enable':
                 retval+='_redall'
 
+            if self.kernel_counters == 'enable':
+                retval+='_kcnt'
+
+            if self.complex_split == 'enable':
+                retval+='_csplit'
+
         retval += '_'+self.mode
 
         if retval != '':
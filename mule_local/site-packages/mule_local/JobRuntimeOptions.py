@@ -25,6 +25,16 @@ class JobRuntimeOptions(InfoError):
 		self.output_timestep_size = None
 		self.output_filename = ''
 		self.output_file_mode = ''
+		self.output_async_queue_size = None
+		self.output_compression = ''
+		self.output_compression_tolerance = None
+
+		self.insitu_diagnostics_file_name = ''
+		self.insitu_diagnostics = ''
+
+		self.checkpoint_file_name = ''
+		self.checkpoint_each_sim_seconds = None
+		self.checkpoint_restart_file_name = ''
 
 		self.f_sphere = None
 		self.verbosity = 0
@@ -38,11 +48,19 @@ class JobRuntimeOptions(InfoError):
 		self.timestepping_method = None
 		self.timestepping_order = 1
 		self.timestepping_order2 = 1
+		self.timestepping_rk_low_storage = None
 
 		self.timestep_size = None
+
+		self.adaptive_timestepping = None
+		self.adaptive_tolerance_abs = None
+		self.adaptive_tolerance_rel = None
+		self.adaptive_dt_min = None
+		self.adaptive_dt_max = None
 		self.max_timesteps_nr = -1
 
 		self.normal_mode_analysis = None
+		self.normal_mode_analysis_batched = None
 
 		#
 		# REXI method:
@@ -57,6 +75,8 @@ class JobRuntimeOptions(InfoError):
 		# Generic REXI parameters
 		self.rexi_extended_modes = 0
 		self.rexi_sphere_preallocation = 0
+		self.rexi_thread_groups = None
+		self.rexi_load_balancing = None
 
 		# List of REXI Coefficients
 		self.rexi_files_coefficients = []
@@ -95,10 +115,14 @@ class JobRuntimeOptions(InfoError):
 		self.benchmark_galewsky_hamp = -1
 		self.benchmark_galewsky_phi2 = -1
 
+		self.initial_condition_cache_dir = None
+
 		self.use_robert_functions = 1
 
 		self.space_grid_use_c_staggering = 0
 		self.space_use_spectral_basis_diffs = 1
+		self.space_plane_distributed = None
+		self.space_sphere_distributed = None
 		self.viscosity = None
 		self.viscosity_order = None
 
@@ -112,6 +136,15 @@ class JobRuntimeOptions(InfoError):
 
 		self.reuse_plans = -1
 
+		self.implicit_operator_cache_size = None
+		self.derived_transform_cache_size = None
+
+		self.profiler = None
+		self.profiler_trace_file_name = ''
+
+		self.ensemble_members = None
+		self.ensemble_perturbation = None
+
 		#
 		# User defined parameters
 		# Each new entry must set three values:
@@ -210,6 +243,12 @@ class JobRuntimeOptions(InfoError):
 			if self.benchmark_galewsky_phi2 > 0:
 				idstr += '_bgp'+str("{:.4E}".format(self.benchmark_galewsky_phi2))
 
+		if not 'runtime.ensemble' in filter_list:
+			if self.ensemble_members != None:
+				idstr += '_ens'+str(self.ensemble_members)
+			if self.ensemble_perturbation != None:
+				idstr += '_ensp'+str("{:.4E}".format(self.ensemble_perturbation))
+
 		if not 'runtime.simparams' in filter_list:
 			if self.gravitation!= None:
 				idstr += '_g'+str("{:05.2f}".format(self.gravitation))
@@ -337,6 +376,12 @@ class JobRuntimeOptions(InfoError):
 			if self.space_use_spectral_basis_diffs != 1:
 				idstr += '_spd'+str(self.space_use_spectral_basis_diffs)
 
+			if self.space_plane_distributed != None:
+				idstr += '_dist'+str(self.space_plane_distributed)
+
+			if self.space_sphere_distributed != None:
+				idstr += '_sdist'+str(self.space_sphere_distributed)
+
 		if self.reuse_plans != -1:
 			idstr += '_plans'+str(self.reuse_plans)
 
@@ -381,6 +426,12 @@ class JobRuntimeOptions(InfoError):
 		retval += ' --space-grid-use-c-staggering='+str(self.space_grid_use_c_staggering)
 		retval += ' -S '+str(self.space_use_spectral_basis_diffs)
 
+		if self.space_plane_distributed != None:
+			retval += ' --space-plane-distributed='+str(self.space_plane_distributed)
+
+		if self.space_sphere_distributed != None:
+			retval += ' --space-sphere-distributed='+str(self.space_sphere_distributed)
+
 		if self.plane_domain_size != None:
 			if isinstance(self.plane_domain_size, (int, float)):
 				retval += ' -X '+str(self.plane_domain_size)
@@ -392,11 +443,29 @@ class JobRuntimeOptions(InfoError):
 		if self.benchmark_name != None:
 			retval += ' --benchmark-name='+str(self.benchmark_name)
 
+		if self.initial_condition_cache_dir != None:
+			retval += ' --initial-condition-cache-dir='+str(self.initial_condition_cache_dir)
+
 		retval += ' -v '+str(self.verbosity)
 
 		if self.timestep_size != None:
 			retval += ' --dt='+str(self.timestep_size)
 
+		if self.adaptive_timestepping != None:
+			retval += ' --adaptive-timestepping='+str(self.adaptive_timestepping)
+
+		if self.adaptive_tolerance_abs != None:
+			retval += ' --adaptive-tolerance-abs='+str(self.adaptive_tolerance_abs)
+
+		if self.adaptive_tolerance_rel != None:
+			retval += ' --adaptive-tolerance-rel='+str(self.adaptive_tolerance_rel)
+
+		if self.adaptive_dt_min != None:
+			retval += ' --adaptive-dt-min='+str(self.adaptive_dt_min)
+
+		if self.adaptive_dt_max != None:
+			retval += ' --adaptive-dt-max='+str(self.adaptive_dt_max)
+
 		if self.max_timesteps_nr != -1:
 			retval += ' -T '+str(self.max_timesteps_nr)
 
@@ -411,6 +480,30 @@ class JobRuntimeOptions(InfoError):
 		if self.output_file_mode != '':
 			retval += ' --output-file-mode='+self.output_file_mode
 
+		if self.output_async_queue_size != None:
+			retval += ' --output-async-queue-size='+str(self.output_async_queue_size)
+
+		if self.output_compression != '':
+			retval += ' --output-compression='+self.output_compression
+
+		if self.output_compression_tolerance != None:
+			retval += ' --output-compression-tolerance='+str(self.output_compression_tolerance)
+
+		if self.insitu_diagnostics_file_name != '':
+			retval += ' --insitu-diagnostics-file-name='+self.insitu_diagnostics_file_name
+
+		if self.insitu_diagnostics != '':
+			retval += ' --insitu-diagnostics='+self.insitu_diagnostics
+
+		if self.checkpoint_file_name != '':
+			retval += ' --checkpoint-file-name='+self.checkpoint_file_name
+
+		if self.checkpoint_each_sim_seconds != None:
+			retval += ' --checkpoint-each-sim-seconds='+str(self.checkpoint_each_sim_seconds)
+
+		if self.checkpoint_restart_file_name != '':
+			retval += ' --checkpoint-restart-file-name='+self.checkpoint_restart_file_name
+
 
 		if self.viscosity != None:
 			retval += ' -u '+str(self.viscosity)
@@ -442,15 +535,27 @@ class JobRuntimeOptions(InfoError):
 			retval += ' --timestepping-order='+str(self.timestepping_order)
 			retval += ' --timestepping-order2='+str(self.timestepping_order2)
 
+		if self.timestepping_rk_low_storage != None:
+			retval += ' --timestepping-rk-low-storage='+str(self.timestepping_rk_low_storage)
+
 		if self.normal_mode_analysis != None:
 			retval += ' --normal-mode-analysis-generation='+str(self.normal_mode_analysis)
 
+		if self.normal_mode_analysis_batched != None:
+			retval += ' --normal-mode-analysis-batched='+str(self.normal_mode_analysis_batched)
+
 		retval += ' --rexi-method='+str(self.rexi_method)
 
 		if self.rexi_method != '' and self.rexi_method != 'direct':
 			retval += ' --rexi-sphere-preallocation='+str(self.rexi_sphere_preallocation)
 			retval += ' --rexi-ext-modes='+str(self.rexi_extended_modes)
 
+			if self.rexi_thread_groups != None:
+				retval += ' --rexi-thread-groups='+str(self.rexi_thread_groups)
+
+			if self.rexi_load_balancing != None:
+				retval += ' --rexi-load-balancing='+str(self.rexi_load_balancing)
+
 			if self.rexi_method == 'file':
 
 				if self.p_job_dirpath == None:
@@ -502,6 +607,24 @@ class JobRuntimeOptions(InfoError):
 
 		retval += ' --reuse-plans='+str(self.reuse_plans)
 
+		if self.implicit_operator_cache_size != None:
+			retval += ' --implicit-operator-cache-size='+str(self.implicit_operator_cache_size)
+
+		if self.derived_transform_cache_size != None:
+			retval += ' --derived-transform-cache-size='+str(self.derived_transform_cache_size)
+
+		if self.profiler != None:
+			retval += ' --profiler='+str(self.profiler)
+
+		if self.profiler_trace_file_name != '':
+			retval += ' --profiler-trace-file-name='+self.profiler_trace_file_name
+
+		if self.ensemble_members != None:
+			retval += ' --ensemble-members='+str(self.ensemble_members)
+
+		if self.ensemble_perturbation != None:
+			retval += ' --ensemble-perturbation='+str(self.ensemble_perturbation)
+
 		for key, param in self.user_defined_parameters.items():
 			retval += ' '+param['option']+str(param['value'])
 
@@ -0,0 +1,177 @@
+#! /usr/bin/env python3
+
+import sys
+
+
+class KernelCountersRoofline:
+	"""
+	Roofline summary of kernel counters
+	(see src/include/sweet/KernelCounters.hpp, compile with --kernel-counters=enable)
+
+	The '[MULE] kernel_counters.*' lines of job outputs are parsed and each
+	kernel is classified as memory or compute bound based on its arithmetic
+	intensity and the machine balance (peak GFLOP/s / peak GB/s).
+	"""
+
+	def __init__(self, filename = None, peak_gflops = None, peak_gbytes_per_s = None):
+
+		self.kernels = {}
+		self.peak_gflops = peak_gflops
+		self.peak_gbytes_per_s = peak_gbytes_per_s
+
+		if filename != None:
+			self.read_file(filename)
+
+
+	def read_file(self, filename):
+		"""
+		Load kernel counters from job output
+
+		Values of several files are accumulated.
+		"""
+		print("Loading file: "+filename)
+
+		prefix = '[MULE] kernel_counters.'
+
+		with open(filename, 'r') as f:
+			for line in f:
+				if not line.startswith(prefix):
+					continue
+
+				key, value = line[len(prefix):].split(':', 1)
+
+				if '.' not in key:
+					continue
+
+				kernel, attr = key.rsplit('.', 1)
+
+				# Only accumulate absolute values, rates are recomputed
+				if attr not in ['calls', 'time', 'flops', 'bytes', 'hw_calls', 'hw_cycles', 'hw_instructions', 'hw_llc_misses']:
+					continue
+
+				if kernel not in self.kernels:
+					self.kernels[kernel] = {}
+
+				k = self.kernels[kernel]
+				k[attr] = k.get(attr, 0) + float(value)
+
+
+	def get_summary(self):
+		"""
+		Return list of dictionaries with the roofline metrics of each kernel
+		"""
+		balance = None
+		if self.peak_gflops != None and self.peak_gbytes_per_s != None:
+			balance = self.peak_gflops/self.peak_gbytes_per_s
+
+		retval = []
+		for name in sorted(self.kernels.keys()):
+			k = self.kernels[name]
+
+			time = k.get('time', 0)
+			flops = k.get('flops', 0)
+			bytes = k.get('bytes', 0)
+
+			s = {'kernel': name, 'calls': int(k.get('calls', 0)), 'time': time}
+
+			s['gflops_per_s'] = flops/time*1e-9 if time > 0 else None
+			s['gbytes_per_s'] = bytes/time*1e-9 if time > 0 else None
+			s['arithmetic_intensity'] = flops/bytes if bytes > 0 else None
+
+			s['bound'] = None
+			s['roofline_fraction'] = None
+
+			ai = s['arithmetic_intensity']
+			if balance != None and ai != None:
+				s['bound'] = 'memory' if ai < balance else 'compute'
+
+				# Attainable performance according to the roofline model
+				attainable = min(self.peak_gflops, ai*self.peak_gbytes_per_s)
+				if s['gflops_per_s'] != None and attainable > 0:
+					s['roofline_fraction'] = s['gflops_per_s']/attainable
+
+			if k.get('hw_cycles', 0) > 0:
+				s['ipc'] = k['hw_instructions']/k['hw_cycles']
+
+			retval.append(s)
+
+		return retval
+
+
+	def print_summary(self):
+
+		def fmt(value, f):
+			return f.format(value) if value != None else '-'
+
+		if self.peak_gflops != None and self.peak_gbytes_per_s != None:
+			print("Peak: "+str(self.peak_gflops)+" GFLOP/s, "+str(self.peak_gbytes_per_s)+" GB/s, machine balance: "+str(self.peak_gflops/self.peak_gbytes_per_s)+" FLOP/byte")
+
+		print("\t".join(['kernel', 'calls', 'time', 'GFLOP/s', 'GB/s', 'FLOP/byte', 'IPC', 'bound', 'roofline']))
+
+		for s in self.get_summary():
+			print("\t".join([
+					s['kernel'],
+					str(s['calls']),
+					fmt(s['time'], '{:.4e}'),
+					fmt(s['gflops_per_s'], '{:.3f}'),
+					fmt(s['gbytes_per_s'], '{:.3f}'),
+					fmt(s['arithmetic_intensity'], '{:.4f}'),
+					fmt(s.get('ipc'), '{:.2f}'),
+					fmt(s['bound'], '{}'),
+					fmt(s['roofline_fraction'], '{:.1%}'),
+				]))
+
+
+	def plot(self, filename):
+		"""
+		Plot roofline with all kernels
+		"""
+		import matplotlib
+		matplotlib.use('Agg')
+		import matplotlib.pyplot as plt
+		import numpy as np
+
+		fig, ax = plt.subplots()
+
+		summary = [s for s in self.get_summary() if s['arithmetic_intensity'] != None and s['gflops_per_s'] != None]
+
+		if self.peak_gflops != None and self.peak_gbytes_per_s != None:
+			ai = np.logspace(-3, 3, 200)
+			ax.plot(ai, np.minimum(self.peak_gflops, ai*self.peak_gbytes_per_s), 'k-', label='roofline')
+
+		for s in summary:
+			ax.plot(s['arithmetic_intensity'], s['gflops_per_s'], 'o', label=s['kernel'])
+
+		ax.set_xscale('log')
+		ax.set_yscale('log')
+		ax.set_xlabel('Arithmetic intensity [FLOP/byte]')
+		ax.set_ylabel('Performance [GFLOP/s]')
+		ax.legend()
+
+		fig.savefig(filename)
+
+
+
+if __name__ == '__main__':
+
+	if len(sys.argv) < 2:
+		print("Usage: "+sys.argv[0]+" [job output files] [--peak-gflops=...] [--peak-gbytes-per-s=...] [--plot=file.pdf]")
+		sys.exit(1)
+
+	r = KernelCountersRoofline()
+	plot_file = None
+
+	for arg in sys.argv[1:]:
+		if arg.startswith('--peak-gflops='):
+			r.peak_gflops = float(arg.split('=', 1)[1])
+		elif arg.startswith('--peak-gbytes-per-s='):
+			r.peak_gbytes_per_s = float(arg.split('=', 1)[1])
+		elif arg.startswith('--plot='):
+			plot_file = arg.split('=', 1)[1]
+		else:
+			r.read_file(arg)
+
+	r.print_summary()
+
+	if plot_file != None:
+		r.plot(plot_file)
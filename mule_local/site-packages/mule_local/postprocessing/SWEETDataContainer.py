@@ -0,0 +1,184 @@
+#! /usr/bin/env python3
+
+import mmap
+import zlib
+import numpy as np
+
+
+class SWEETDataContainer:
+	"""
+	Reader for single file SWEET data containers (see src/include/sweet/SWEETDataContainer.hpp)
+
+	The file is memory mapped and the payloads are returned as numpy arrays
+	which directly reference the memory mapped file (no copy operation).
+
+	Compressed payloads (see src/include/sweet/SWEETCompression.hpp)
+	are decompressed to new arrays.
+	"""
+
+	file_header_dtype = np.dtype([
+		('magic', 'S8'),
+		('version', np.uint32),
+		('byte_order_mark', np.uint32),
+		('alignment', np.uint64),
+		('first_record_offset', np.uint64),
+		('reserved', 'V32'),
+	])
+
+	record_header_dtype = np.dtype([
+		('magic', 'S8'),
+		('field_name', 'S64'),
+		('time', np.float64),
+		('primitive', np.int32),
+		('space', np.int32),
+		('data_type', np.int32),
+		('compression', np.int32),
+		('resolution', np.int64, (4,)),
+		('payload_offset', np.uint64),
+		('payload_num_elements', np.uint64),
+		('payload_size', np.uint64),
+		('next_record_offset', np.uint64),
+		('compression_tolerance', np.float64),
+		('reserved', 'V24'),
+	])
+
+	primitives = {0: 'sphere', 1: 'plane', 2: 'scalar'}
+	spaces = {0: 'physical', 1: 'spectral'}
+	data_types = {0: np.float64, 1: np.complex128}
+
+
+	def __init__(self, filename = None):
+
+		self.records = []
+
+		if filename != None:
+			self.read_file(filename)
+
+
+	def read_file(self, filename):
+		"""
+		Open container and setup index of all records
+		"""
+		print("Loading file: "+filename)
+
+		self.filename = filename
+		self.file = open(filename, 'rb')
+		self.mmap = mmap.mmap(self.file.fileno(), 0, access=mmap.ACCESS_READ)
+
+		header = np.frombuffer(self.mmap, dtype=self.file_header_dtype, count=1, offset=0)[0]
+
+		if header['magic'] != b'SWEETDC':
+			raise Exception("'"+filename+"' is not a SWEET data container")
+
+		if header['byte_order_mark'] != 0x01020304:
+			raise Exception("Byte order of '"+filename+"' doesn't match")
+
+		self.records = []
+
+		offset = int(header['first_record_offset'])
+		while offset + self.record_header_dtype.itemsize <= len(self.mmap):
+			record = np.frombuffer(self.mmap, dtype=self.record_header_dtype, count=1, offset=offset)[0]
+
+			if record['magic'] != b'SWEETRC':
+				break
+
+			if int(record['payload_offset']) + int(record['payload_size']) > len(self.mmap):
+				break
+
+			self.records.append({
+				'field_name': record['field_name'].decode('ascii'),
+				'time': float(record['time']),
+				'primitive': self.primitives[int(record['primitive'])],
+				'space': self.spaces[int(record['space'])],
+				'data_type': self.data_types[int(record['data_type'])],
+				'resolution': [int(i) for i in record['resolution']],
+				'payload_offset': int(record['payload_offset']),
+				'payload_num_elements': int(record['payload_num_elements']),
+				'payload_size': int(record['payload_size']),
+				'compression': int(record['compression']),
+				'compression_tolerance': float(record['compression_tolerance']),
+			})
+
+			offset = int(record['next_record_offset'])
+
+
+	def get_field_names(self):
+		"""
+		Return list of all field names in container
+		"""
+		names = []
+		for r in self.records:
+			if r['field_name'] not in names:
+				names.append(r['field_name'])
+		return names
+
+
+	def get_times(self, field_name):
+		"""
+		Return list of all times for which the field is available
+		"""
+		return [r['time'] for r in self.records if r['field_name'] == field_name]
+
+
+	def get_data(self, field_name, time, time_eps = 1e-10):
+		"""
+		Return numpy array referencing the payload of a record
+
+		Physical data is returned as 2D array with shape (resolution[1], resolution[0]).
+		Spectral data is returned as 1D array.
+		"""
+		for r in self.records:
+			if r['field_name'] != field_name:
+				continue
+
+			if abs(r['time'] - time) > time_eps:
+				continue
+
+			if r['compression'] == 0:
+				data = np.frombuffer(self.mmap, dtype=r['data_type'], count=r['payload_num_elements'], offset=r['payload_offset'])
+			else:
+				data = self._decompress(r)
+
+			if r['space'] == 'physical':
+				data = data.reshape((r['resolution'][1], r['resolution'][0]))
+
+			return data
+
+		raise Exception("Record for field '"+field_name+"' at time "+str(time)+" not found")
+
+
+	def _decompress(self, r):
+		"""
+		Decompress payload of record to new array
+		"""
+		payload = self.mmap[r['payload_offset']:r['payload_offset']+r['payload_size']]
+		num_values = r['payload_num_elements']*np.dtype(r['data_type']).itemsize//8
+
+		if r['compression'] == 1:
+			# shuffle + deflate
+			shuffled = np.frombuffer(zlib.decompress(payload), dtype=np.uint8)
+			values = shuffled.reshape((8, num_values)).T.copy().view(np.float64).reshape(num_values)
+
+		elif r['compression'] in [2, 3]:
+			# quantization + zigzag varint (+ deflate)
+			if r['compression'] == 3:
+				payload = zlib.decompress(payload)
+
+			b = np.frombuffer(payload, dtype=np.uint8)
+			ends = np.flatnonzero(b < 0x80)
+			starts = np.concatenate(([0], ends[:-1]+1))
+			shifts = 7*(np.arange(len(b)) - np.repeat(starts, ends-starts+1))
+
+			# Bits of different bytes don't overlap, hence sum == bitwise or
+			z = np.add.reduceat((b & 0x7f).astype(np.uint64) << shifts.astype(np.uint64), starts)
+			q = (z >> np.uint64(1)).astype(np.int64) ^ -(z & np.uint64(1)).astype(np.int64)
+
+			if len(q) != num_values:
+				raise Exception("Corrupted compressed payload")
+
+			values = q*(2.0*r['compression_tolerance'])
+
+		else:
+			raise Exception("Unknown compression "+str(r['compression']))
+
+		return values.view(r['data_type'])
@@ -0,0 +1,45 @@
+#! /usr/bin/env python3
+
+import numpy as np
+
+
+class SphereInSituDiagnostics:
+	"""
+	Reader for time series of in-situ diagnostics
+	(see src/include/sweet/sphere/SphereHelpers_InSituDiagnostics.hpp)
+	"""
+
+	def __init__(self, filename = None):
+
+		if filename != None:
+			self.read_file(filename)
+
+
+	def read_file(self, filename):
+		"""
+		Load time series
+
+		self.data is a dictionary with the column names as keys.
+		The kinetic energy spectrum is additionally provided as 2D array
+		self.ke_spectrum with shape (time steps, n_max+1).
+		"""
+		print("Loading file: "+filename)
+
+		with open(filename, 'r') as f:
+			lines = [l for l in f.readlines() if not l.startswith('#')]
+
+		self.columns = lines[0].strip().split('\t')
+
+		values = np.loadtxt(lines[1:], ndmin=2)
+
+		self.data = {}
+		for i, c in enumerate(self.columns):
+			self.data[c] = values[:,i]
+
+		self.time = self.data['time']
+
+		ke_columns = [i for i, c in enumerate(self.columns) if c.startswith('ke_n')]
+		if len(ke_columns) > 0:
+			self.ke_spectrum = values[:,ke_columns]
+		else:
+			self.ke_spectrum = None
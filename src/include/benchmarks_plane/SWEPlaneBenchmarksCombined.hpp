@@ -11,6 +11,7 @@
 #include <iostream>
 //#include <benchmarks_plane/SWE_bench_PlaneBenchmarks_DEPRECATED.hpp>
 #include <sweet/plane/PlaneData.hpp>
+#include <sweet/plane/PlaneDataDistributed.hpp>
 #include <sweet/plane/PlaneOperators.hpp>
 #include <sweet/SimulationVariables.hpp>
 
@@ -37,6 +38,245 @@ public:
 
 
 
+private:
+	/**
+	 * Benchmarks which are given point-wise in physical space.
+	 *
+	 * These are available for PlaneData and PlaneDataDistributed.
+	 */
+	template <typename T_PlaneData>
+	bool p_setupPointwiseInitialConditions(
+			T_PlaneData &o_h_pert,
+			T_PlaneData &o_u,
+			T_PlaneData &o_v,
+			SimulationVariables &io_simVars
+	)
+	{
+		if (
+				io_simVars.benchmark.benchmark_name == "benchmark_id_0" ||
+				io_simVars.benchmark.benchmark_name == "cylinder"
+		)
+		{
+			double sx = simVars->sim.plane_domain_size[0];
+			double sy = simVars->sim.plane_domain_size[1];
+
+
+			o_h_pert.physical_set_zero();
+			o_h_pert.physical_update_lambda_array_indices(
+				[&](int i, int j, double &io_data)
+				{
+					double x = (double)i*(io_simVars.sim.plane_domain_size[0]/(double)io_simVars.disc.space_res_physical[0]);
+					double y = (double)j*(io_simVars.sim.plane_domain_size[1]/(double)io_simVars.disc.space_res_physical[1]);
+
+					// radial dam break
+					double dx = x-simVars->benchmark.object_coord_x*sx;
+					double dy = y-simVars->benchmark.object_coord_y*sy;
+
+					double radius = simVars->benchmark.object_scale*sqrt(sx*sx+sy*sy);
+					if (dx*dx+dy*dy < radius*radius)
+						io_data = 1.0;
+					else
+						io_data = 0.0;
+				}
+			);
+
+			o_u.physical_set_zero();
+			o_v.physical_set_zero();
+
+			return true;
+		}
+		else if (
+				io_simVars.benchmark.benchmark_name == "benchmark_id_1" ||
+				io_simVars.benchmark.benchmark_name == "radial_gaussian_bump"
+		)
+		{
+			double sx = simVars->sim.plane_domain_size[0];
+			double sy = simVars->sim.plane_domain_size[1];
+
+
+			o_h_pert.physical_set_zero();
+			o_h_pert.physical_update_lambda_array_indices(
+				[&](int i, int j, double &io_data)
+				{
+					double x = (double)i*(io_simVars.sim.plane_domain_size[0]/(double)io_simVars.disc.space_res_physical[0]);
+					double y = (double)j*(io_simVars.sim.plane_domain_size[1]/(double)io_simVars.disc.space_res_physical[1]);
+
+					// radial dam break
+					double dx = x-simVars->benchmark.object_coord_x*sx;
+					double dy = y-simVars->benchmark.object_coord_y*sy;
+
+					double radius = simVars->benchmark.object_scale*sqrt((double)sx*(double)sx+(double)sy*(double)sy);
+					dx /= radius;
+					dy /= radius;
+
+					io_data = std::exp(-50.0*(dx*dx + dy*dy));
+				}
+			);
+
+			o_u.physical_set_zero();
+			o_v.physical_set_zero();
+
+			return true;
+		}
+		else if (
+				io_simVars.benchmark.benchmark_name == "benchmark_id_2" ||
+				io_simVars.benchmark.benchmark_name == "steady_state_meridional_flow"
+		)
+		{
+			double f = simVars->sim.plane_rotating_f0;
+			double sx = simVars->sim.plane_domain_size[0];
+			//double sy = simVars->sim.domain_size[1];
+
+			if (io_simVars.sim.plane_rotating_f0 == 0)
+				FatalError("Coriolis = 0!");
+
+			o_h_pert.physical_set_zero();
+			o_h_pert.physical_update_lambda_array_indices(
+				[&](int i, int j, double &io_data)
+				{
+					double x = (double)i/(double)simVars->disc.space_res_physical[0];
+					//double y = (double)j*(simVars->sim.domain_size[1]/(double)simVars->disc.res_physical[1]);
+
+					io_data = std::sin(2.0*M_PI*x);
+				}
+			);
+
+			o_u.physical_set_zero();
+
+			o_v.physical_set_zero();
+			o_v.physical_update_lambda_array_indices(
+				[&](int i, int j, double &io_data)
+				{
+					double x = (double)i/(double)simVars->disc.space_res_physical[0];
+					//double y = (double)j*(simVars->sim.domain_size[1]/(double)simVars->disc.res_physical[1]);
+
+					io_data = simVars->sim.gravitation/f*2.0*M_PIl*std::cos(2.0*M_PIl*x)/sx;
+				}
+			);
+
+			return true;
+		}
+		else if (
+				io_simVars.benchmark.benchmark_name == "benchmark_id_3" ||
+				io_simVars.benchmark.benchmark_name == "steady_state_zonal_flow"
+		)
+		{
+			double f = simVars->sim.plane_rotating_f0;
+			//double sx = simVars->sim.domain_size[0];
+			double sy = simVars->sim.plane_domain_size[1];
+
+			if (io_simVars.sim.plane_rotating_f0 == 0)
+				FatalError("Coriolis = 0!");
+
+			o_h_pert.physical_set_zero();
+			o_h_pert.physical_update_lambda_array_indices(
+				[&](int i, int j, double &io_data)
+				{
+					//double x = (double)i*(simVars->sim.domain_size[0]/(double)simVars->disc.res_physical[0]);
+					double y = (double)j*(simVars->sim.plane_domain_size[1]/(double)simVars->disc.space_res_physical[1]);
+
+					io_data = std::sin(2.0*M_PI*y/sy);
+				}
+			);
+
+			o_u.physical_set_zero();
+			o_u.physical_update_lambda_array_indices(
+				[&](int i, int j, double &io_data)
+				{
+					//double x = (double)i*(simVars->sim.domain_size[0]/(double)simVars->disc.res_physical[0]);
+					double y = (double)j*(simVars->sim.plane_domain_size[1]/(double)simVars->disc.space_res_physical[1]);
+
+					io_data = -simVars->sim.gravitation*2.0*M_PI*std::cos(2.0*M_PI*y/sy)/(f*sy);
+				}
+			);
+
+			o_v.physical_set_zero();
+
+			return true;
+		}
+		else if (
+				io_simVars.benchmark.benchmark_name == "benchmark_id_4" ||
+				io_simVars.benchmark.benchmark_name == "yadda_yadda_whatever_this_is"
+		)
+		{
+			double sx = simVars->sim.plane_domain_size[0];
+			double sy = simVars->sim.plane_domain_size[1];
+
+			if (io_simVars.sim.plane_rotating_f0 == 0)
+				FatalError("Coriolis = 0!");
+
+			o_h_pert.physical_set_zero();
+			o_h_pert.physical_update_lambda_array_indices(
+				[&](int i, int j, double &io_data)
+				{
+					double x = (double)i*(simVars->sim.plane_domain_size[0]/(double)simVars->disc.space_res_physical[0]);
+					double y = (double)j*(simVars->sim.plane_domain_size[1]/(double)simVars->disc.space_res_physical[1]);
+
+					// radial dam break
+					double dx = x-simVars->benchmark.object_coord_x*sx;
+					double dy = y-simVars->benchmark.object_coord_y*sy;
+
+					io_data = (std::abs(dx-0.5) < 0.3)*(std::abs(dy-0.5) < 0.1);
+				}
+			);
+
+			o_u.physical_set_zero();
+			o_v.physical_set_zero();
+
+			return true;
+		}
+
+
+		else if (
+				io_simVars.benchmark.benchmark_name == "benchmark_id_14" ||
+				io_simVars.benchmark.benchmark_name == "rotated_steady_state"
+		)
+		{
+			double freq = 10.0;
+
+			double sx = simVars->sim.plane_domain_size[0];
+			double sy = simVars->sim.plane_domain_size[1];
+
+			o_h_pert.physical_update_lambda_array_indices(
+				[&](int i, int j, double &io_data)
+				{
+					double x = (double)i*(simVars->sim.plane_domain_size[0]/(double)simVars->disc.space_res_physical[0]);
+					double y = (double)j*(simVars->sim.plane_domain_size[1]/(double)simVars->disc.space_res_physical[1]);
+
+					io_data = std::cos(2.0*M_PI*freq*(x/sx+y/sy));
+				}
+			);
+
+			o_u.physical_update_lambda_array_indices(
+				[&](int i, int j, double &io_data)
+				{
+					double x = (double)i*(simVars->sim.plane_domain_size[0]/(double)simVars->disc.space_res_physical[0]);
+					double y = (double)j*(simVars->sim.plane_domain_size[1]/(double)simVars->disc.space_res_physical[1]);
+
+					double factor = simVars->sim.gravitation*2.0*M_PI*freq/(simVars->sim.plane_rotating_f0*sy);
+					io_data = factor*std::sin(2.0*M_PI*freq*(x/sx+y/sy));
+				}
+			);
+
+			o_v.physical_update_lambda_array_indices(
+				[&](int i, int j, double &io_data)
+				{
+					double x = (double)i*(simVars->sim.plane_domain_size[0]/(double)simVars->disc.space_res_physical[0]);
+					double y = (double)j*(simVars->sim.plane_domain_size[1]/(double)simVars->disc.space_res_physical[1]);
+
+					double factor = -simVars->sim.gravitation*2.0*M_PI*freq/(simVars->sim.plane_rotating_f0*sx);
+					io_data = factor*std::sin(2.0*M_PI*freq*(x/sx+y/sy));
+				}
+			);
+
+			return true;
+		}
+
+		return false;
+	}
+
+
+
 public:
 	bool setupInitialConditions(
 			PlaneData &o_h_pert,
@@ -278,233 +518,46 @@ public:
 			);
 			return true;
 		}
-		else if (
-				io_simVars.benchmark.benchmark_name == "benchmark_id_0" ||
-				io_simVars.benchmark.benchmark_name == "cylinder"
-		)
-		{
-			double sx = simVars->sim.plane_domain_size[0];
-			double sy = simVars->sim.plane_domain_size[1];
-
-
-			o_h_pert.physical_set_zero();
-			o_h_pert.physical_update_lambda_array_indices(
-				[&](int i, int j, double &io_data)
-				{
-					double x = (double)i*(io_simVars.sim.plane_domain_size[0]/(double)io_simVars.disc.space_res_physical[0]);
-					double y = (double)j*(io_simVars.sim.plane_domain_size[1]/(double)io_simVars.disc.space_res_physical[1]);
-
-					// radial dam break
-					double dx = x-simVars->benchmark.object_coord_x*sx;
-					double dy = y-simVars->benchmark.object_coord_y*sy;
-
-					double radius = simVars->benchmark.object_scale*sqrt(sx*sx+sy*sy);
-					if (dx*dx+dy*dy < radius*radius)
-						io_data = 1.0;
-					else
-						io_data = 0.0;
-				}
-			);
-
-			o_u.physical_set_zero();
-			o_v.physical_set_zero();
 
+		if (p_setupPointwiseInitialConditions(o_h_pert, o_u, o_v, io_simVars))
 			return true;
-		}
-		else if (
-				io_simVars.benchmark.benchmark_name == "benchmark_id_1" ||
-				io_simVars.benchmark.benchmark_name == "radial_gaussian_bump"
-		)
-		{
-			double sx = simVars->sim.plane_domain_size[0];
-			double sy = simVars->sim.plane_domain_size[1];
-
-
-			o_h_pert.physical_set_zero();
-			o_h_pert.physical_update_lambda_array_indices(
-				[&](int i, int j, double &io_data)
-				{
-					double x = (double)i*(io_simVars.sim.plane_domain_size[0]/(double)io_simVars.disc.space_res_physical[0]);
-					double y = (double)j*(io_simVars.sim.plane_domain_size[1]/(double)io_simVars.disc.space_res_physical[1]);
-
-					// radial dam break
-					double dx = x-simVars->benchmark.object_coord_x*sx;
-					double dy = y-simVars->benchmark.object_coord_y*sy;
 
-					double radius = simVars->benchmark.object_scale*sqrt((double)sx*(double)sx+(double)sy*(double)sy);
-					dx /= radius;
-					dy /= radius;
-
-					io_data = std::exp(-50.0*(dx*dx + dy*dy));
-				}
-			);
-
-			o_u.physical_set_zero();
-			o_v.physical_set_zero();
-
-			return true;
-		}
-		else if (
-				io_simVars.benchmark.benchmark_name == "benchmark_id_2" ||
-				io_simVars.benchmark.benchmark_name == "steady_state_meridional_flow"
-		)
-		{
-			double f = simVars->sim.plane_rotating_f0;
-			double sx = simVars->sim.plane_domain_size[0];
-			//double sy = simVars->sim.domain_size[1];
-
-			if (io_simVars.sim.plane_rotating_f0 == 0)
-				FatalError("Coriolis = 0!");
-
-			o_h_pert.physical_set_zero();
-			o_h_pert.physical_update_lambda_array_indices(
-				[&](int i, int j, double &io_data)
-				{
-					double x = (double)i/(double)simVars->disc.space_res_physical[0];
-					//double y = (double)j*(simVars->sim.domain_size[1]/(double)simVars->disc.res_physical[1]);
-
-					io_data = std::sin(2.0*M_PI*x);
-				}
-			);
-
-			o_u.physical_set_zero();
-
-			o_v.physical_set_zero();
-			o_v.physical_update_lambda_array_indices(
-				[&](int i, int j, double &io_data)
-				{
-					double x = (double)i/(double)simVars->disc.space_res_physical[0];
-					//double y = (double)j*(simVars->sim.domain_size[1]/(double)simVars->disc.res_physical[1]);
-
-					io_data = simVars->sim.gravitation/f*2.0*M_PIl*std::cos(2.0*M_PIl*x)/sx;
-				}
-			);
-
-			return true;
-		}
-		else if (
-				io_simVars.benchmark.benchmark_name == "benchmark_id_3" ||
-				io_simVars.benchmark.benchmark_name == "steady_state_zonal_flow"
-		)
-		{
-			double f = simVars->sim.plane_rotating_f0;
-			//double sx = simVars->sim.domain_size[0];
-			double sy = simVars->sim.plane_domain_size[1];
-
-			if (io_simVars.sim.plane_rotating_f0 == 0)
-				FatalError("Coriolis = 0!");
-
-			o_h_pert.physical_set_zero();
-			o_h_pert.physical_update_lambda_array_indices(
-				[&](int i, int j, double &io_data)
-				{
-					//double x = (double)i*(simVars->sim.domain_size[0]/(double)simVars->disc.res_physical[0]);
-					double y = (double)j*(simVars->sim.plane_domain_size[1]/(double)simVars->disc.space_res_physical[1]);
-
-					io_data = std::sin(2.0*M_PI*y/sy);
-				}
-			);
-
-			o_u.physical_set_zero();
-			o_u.physical_update_lambda_array_indices(
-				[&](int i, int j, double &io_data)
-				{
-					//double x = (double)i*(simVars->sim.domain_size[0]/(double)simVars->disc.res_physical[0]);
-					double y = (double)j*(simVars->sim.plane_domain_size[1]/(double)simVars->disc.space_res_physical[1]);
-
-					io_data = -simVars->sim.gravitation*2.0*M_PI*std::cos(2.0*M_PI*y/sy)/(f*sy);
-				}
-			);
-
-			o_v.physical_set_zero();
-
-			return true;
-		}
-		else if (
-				io_simVars.benchmark.benchmark_name == "benchmark_id_4" ||
-				io_simVars.benchmark.benchmark_name == "yadda_yadda_whatever_this_is"
-		)
-		{
-			double sx = simVars->sim.plane_domain_size[0];
-			double sy = simVars->sim.plane_domain_size[1];
-
-			if (io_simVars.sim.plane_rotating_f0 == 0)
-				FatalError("Coriolis = 0!");
-
-			o_h_pert.physical_set_zero();
-			o_h_pert.physical_update_lambda_array_indices(
-				[&](int i, int j, double &io_data)
-				{
-					double x = (double)i*(simVars->sim.plane_domain_size[0]/(double)simVars->disc.space_res_physical[0]);
-					double y = (double)j*(simVars->sim.plane_domain_size[1]/(double)simVars->disc.space_res_physical[1]);
-
-					// radial dam break
-					double dx = x-simVars->benchmark.object_coord_x*sx;
-					double dy = y-simVars->benchmark.object_coord_y*sy;
-
-					io_data = (std::abs(dx-0.5) < 0.3)*(std::abs(dy-0.5) < 0.1);
-				}
-			);
-
-			o_u.physical_set_zero();
-			o_v.physical_set_zero();
-
-			return true;
-		}
-
-
-		else if (
-				io_simVars.benchmark.benchmark_name == "benchmark_id_14" ||
-				io_simVars.benchmark.benchmark_name == "rotated_steady_state"
-		)
-		{
-			double freq = 10.0;
-
-			double sx = simVars->sim.plane_domain_size[0];
-			double sy = simVars->sim.plane_domain_size[1];
-
-			o_h_pert.physical_update_lambda_array_indices(
-				[&](int i, int j, double &io_data)
-				{
-					double x = (double)i*(simVars->sim.plane_domain_size[0]/(double)simVars->disc.space_res_physical[0]);
-					double y = (double)j*(simVars->sim.plane_domain_size[1]/(double)simVars->disc.space_res_physical[1]);
-
-					io_data = std::cos(2.0*M_PI*freq*(x/sx+y/sy));
-				}
-			);
+		printBenchmarkInformation();
+		FatalError(std::string("Benchmark ")+io_simVars.benchmark.benchmark_name+ " not found (or not availble)");
 
-			o_u.physical_update_lambda_array_indices(
-				[&](int i, int j, double &io_data)
-				{
-					double x = (double)i*(simVars->sim.plane_domain_size[0]/(double)simVars->disc.space_res_physical[0]);
-					double y = (double)j*(simVars->sim.plane_domain_size[1]/(double)simVars->disc.space_res_physical[1]);
 
-					double factor = simVars->sim.gravitation*2.0*M_PI*freq/(simVars->sim.plane_rotating_f0*sy);
-					io_data = factor*std::sin(2.0*M_PI*freq*(x/sx+y/sy));
-				}
-			);
+		return false;
+	}
 
-			o_v.physical_update_lambda_array_indices(
-				[&](int i, int j, double &io_data)
-				{
-					double x = (double)i*(simVars->sim.plane_domain_size[0]/(double)simVars->disc.space_res_physical[0]);
-					double y = (double)j*(simVars->sim.plane_domain_size[1]/(double)simVars->disc.space_res_physical[1]);
+	/**
+	 * Setup initial conditions of plane data distributed over MPI ranks
+	 *
+	 * Only the benchmarks given point-wise in physical space are supported.
+	 * This has to be called by all ranks.
+	 */
+	bool setupInitialConditions(
+			PlaneDataDistributed &o_h_pert,
+			PlaneDataDistributed &o_u,
+			PlaneDataDistributed &o_v,
+			SimulationVariables &io_simVars
+	)
+	{
+		simVars = &io_simVars;
 
-					double factor = -simVars->sim.gravitation*2.0*M_PI*freq/(simVars->sim.plane_rotating_f0*sx);
-					io_data = factor*std::sin(2.0*M_PI*freq*(x/sx+y/sy));
-				}
-			);
+		if (io_simVars.benchmark.benchmark_name == "")
+			FatalError("Benchmark name not given");
 
+		if (p_setupPointwiseInitialConditions(o_h_pert, o_u, o_v, io_simVars))
 			return true;
-		}
 
 		printBenchmarkInformation();
-		FatalError(std::string("Benchmark ")+io_simVars.benchmark.benchmark_name+ " not found (or not availble)");
-
+		FatalError(std::string("Benchmark ")+io_simVars.benchmark.benchmark_name+ " not available for distributed plane data");
 
 		return false;
 	}
 
+
+
 	void printBenchmarkInformation()
 	{
 		std::cout << "Available benchmark scenarios (--benchmark):" << std::endl;
@@ -13,9 +13,13 @@ class BenchmarkGaussianDam
 {
 
 public:
+	/**
+	 * This is available for SphereData_Physical and SphereData_PhysicalDistributed
+	 */
+	template <typename T_SphereDataPhysical>
 	static
 	void setup_initial_conditions_gaussian(
-			SphereData_Physical &o_h,
+			T_SphereDataPhysical &o_h,
 			SimulationVariables &i_simVars,
 			double i_center_lon = M_PI/3,
 			double i_center_lat = M_PI/3,
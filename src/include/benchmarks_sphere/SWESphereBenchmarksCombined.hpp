@@ -8,11 +8,15 @@
 #ifndef SRC_INCLUDE_BENCHMARKS_SPHERE_SWESPHEREBENCHMARKSCOMBINED_HPP_
 #define SRC_INCLUDE_BENCHMARKS_SPHERE_SWESPHEREBENCHMARKSCOMBINED_HPP_
 
+#include <vector>
 #include <sweet/SimulationVariables.hpp>
+#include <sweet/openmp_helper.hpp>
 //#include <benchmarks_sphere/BenchmarkGalewsky.hpp>
 #include <benchmarks_sphere/BenchmarkGaussianDam.hpp>
 #include <benchmarks_sphere/BenchmarkFlowOverMountain.hpp>
+#include <benchmarks_sphere/SWESphereBenchmarksInitialConditionCache.hpp>
 #include <sweet/sphere/SphereData_Spectral.hpp>
+#include <sweet/sphere/SphereData_SpectralDistributed.hpp>
 #include <sweet/sphere/SphereOperators_SphereData.hpp>
 
 #if SWEET_MPI
@@ -218,6 +222,12 @@ public:
 	}
 
 
+	/**
+	 * Setup initial conditions of benchmark
+	 *
+	 * If a cache directory is given, the initial conditions are loaded
+	 * from or stored to the cache (see SWESphereBenchmarksInitialConditionCache)
+	 */
 	void setupInitialConditions(
 			SphereData_Spectral &o_phi,
 			SphereData_Spectral &o_vort,
@@ -227,6 +237,101 @@ public:
 		if (simVars == nullptr)
 			FatalError("Benchmarks are not yet initialized");
 
+		if (simVars->benchmark.initial_condition_cache_dir == "")
+		{
+			p_setupInitialConditions(o_phi, o_vort, o_div);
+			return;
+		}
+
+		// Determine cache entry before the benchmark overrides any parameters
+		std::string cache_filename = SWESphereBenchmarksInitialConditionCache::getFilename(*simVars, o_phi.sphereDataConfig);
+
+		if (SWESphereBenchmarksInitialConditionCache::load(cache_filename, *simVars, o_phi, o_vort, o_div))
+		{
+			std::cout << "Loaded initial conditions from cache '" << cache_filename << "'" << std::endl;
+
+			// update operators with the potentially new parameters
+			op->setup(o_phi.sphereDataConfig, simVars->sim.sphere_radius);
+			return;
+		}
+
+		p_setupInitialConditions(o_phi, o_vort, o_div);
+
+		// Benchmarks with external forces have a state which can't be cached
+		if (simVars->benchmark.getExternalForcesCallback != nullptr)
+			return;
+
+#if SWEET_MPI
+		int mpi_rank;
+		MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+		if (mpi_rank != 0)
+			return;
+#endif
+
+		std::cout << "Storing initial conditions in cache '" << cache_filename << "'" << std::endl;
+		SWESphereBenchmarksInitialConditionCache::store(cache_filename, *simVars, o_phi, o_vort, o_div);
+	}
+
+
+
+	/**
+	 * Setup initial conditions for sphere data distributed over MPI ranks
+	 *
+	 * Only the benchmarks which are given point-wise in physical space are
+	 * available. These don't require the sphere operators, hence this can
+	 * be called without setup(). Collective operation with MPI.
+	 */
+	void setupInitialConditions(
+			SphereData_SpectralDistributed &o_phi,
+			SphereData_SpectralDistributed &o_vort,
+			SphereData_SpectralDistributed &o_div,
+			SimulationVariables &io_simVars
+	)
+	{
+		simVars = &io_simVars;
+		simVars->iodata.output_time_scale = 1.0/(60.0*60.0);
+
+		if (simVars->benchmark.benchmark_name == "")
+			FatalError("Benchmark name not specified!");
+
+		SphereData_PhysicalDistributed tmp(o_phi.sphereDataConfig);
+
+		if (simVars->benchmark.benchmark_name == "flat")
+		{
+			tmp.physical_set_all_value(simVars->sim.h0*simVars->sim.gravitation);
+			o_phi = SphereData_SpectralDistributed(tmp);
+		}
+		else if (simVars->benchmark.benchmark_name == "gaussian_bumps2" || simVars->benchmark.benchmark_name == "three_gaussian_bumps")
+		{
+			SphereData_PhysicalDistributed h(o_phi.sphereDataConfig);
+			h.physical_set_all_value(simVars->sim.h0);
+
+			BenchmarkGaussianDam::setup_initial_conditions_gaussian(tmp, *simVars, 2.0*M_PI*0.1, M_PI/3, 20.0);
+			h += tmp - simVars->sim.h0;
+			BenchmarkGaussianDam::setup_initial_conditions_gaussian(tmp, *simVars, 2.0*M_PI*0.6, M_PI/5.0, 80.0);
+			h += tmp - simVars->sim.h0;
+			BenchmarkGaussianDam::setup_initial_conditions_gaussian(tmp, *simVars, 2.0*M_PI*0.8, -M_PI/4, 360.0);
+			h += tmp - simVars->sim.h0;
+
+			o_phi = SphereData_SpectralDistributed(h)*simVars->sim.gravitation;
+		}
+		else
+		{
+			FatalError("Benchmark '"+simVars->benchmark.benchmark_name+"' not supported for distributed sphere data");
+		}
+
+		o_vort.spectral_set_zero();
+		o_div.spectral_set_zero();
+	}
+
+
+private:
+	void p_setupInitialConditions(
+			SphereData_Spectral &o_phi,
+			SphereData_Spectral &o_vort,
+			SphereData_Spectral &o_div
+	)
+	{
 		simVars->iodata.output_time_scale = 1.0/(60.0*60.0);
 
 		if (simVars->benchmark.benchmark_name == "")
@@ -573,14 +678,31 @@ public:
 			 * Setup U=...
 			 * initial velocity along longitude
 			 */
+			const SphereData_Config *sphereDataConfig = o_phi.sphereDataConfig;
+			int num_lat = sphereDataConfig->physical_num_lat;
+			int num_lon = sphereDataConfig->physical_num_lon;
+
+			/*
+			 * The jet only depends on the latitude, hence evaluate it once per latitude
+			 */
+			std::vector<double> u_lat(num_lat);
+
+			SWEET_THREADING_SPACE_PARALLEL_FOR
+			for (int j = 0; j < num_lat; j++)
+			{
+				double phi = sphereDataConfig->lat[j];
+
+				if (phi >= phi1 || phi <= phi0)
+					u_lat[j] = 0;
+				else
+					u_lat[j] = umax/en*std::exp(1.0/((phi-phi0)*(phi-phi1)));
+			}
+
 			SphereData_Physical ug(o_phi.sphereDataConfig);
-			ug.physical_update_lambda(
-				[&](double lon, double phi, double &o_data)
+			ug.physical_update_lambda_array(
+				[&](int i, int j, double &o_data)
 				{
-					if (phi >= phi1 || phi <= phi0)
-						o_data = 0;
-					else
-						o_data = umax/en*std::exp(1.0/((phi-phi0)*(phi-phi1)));
+					o_data = u_lat[j];
 				}
 			);
 
@@ -616,10 +738,33 @@ public:
 			SphereData_Physical hbump(o_phi.sphereDataConfig);
 			if (simVars->benchmark.benchmark_name == "galewsky")
 			{
-				hbump.physical_update_lambda(
-					[&](double lon, double phi, double &o_data)
+				/*
+				 * The bump is separable in longitude and latitude, hence only
+				 * evaluate the exponentials once per longitude and latitude
+				 */
+				std::vector<double> bump_lon(num_lon);
+				std::vector<double> bump_amp_lat(num_lat);
+				std::vector<double> bump_lat(num_lat);
+
+				SWEET_THREADING_SPACE_PARALLEL_FOR
+				for (int i = 0; i < num_lon; i++)
+				{
+					double lon = ((double)i/(double)num_lon)*2.0*M_PI;
+					bump_lon[i] = std::exp(-(lon/alpha)*(lon/alpha));
+				}
+
+				SWEET_THREADING_SPACE_PARALLEL_FOR
+				for (int j = 0; j < num_lat; j++)
+				{
+					double phi = sphereDataConfig->lat[j];
+					bump_amp_lat[j] = hamp*std::cos(phi);
+					bump_lat[j] = std::exp(-(phi2-phi)*(phi2-phi)/beta);
+				}
+
+				hbump.physical_update_lambda_array(
+					[&](int i, int j, double &o_data)
 					{
-						o_data = hamp*std::cos(phi)*std::exp(-(lon/alpha)*(lon/alpha))*std::exp(-(phi2-phi)*(phi2-phi)/beta);
+						o_data = bump_amp_lat[j]*bump_lon[i]*bump_lat[j];
 					}
 				);
 			}
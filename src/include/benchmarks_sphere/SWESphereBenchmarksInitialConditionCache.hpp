@@ -0,0 +1,288 @@
+/*
+ * SWESphereBenchmarksInitialConditionCache.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_BENCHMARKS_SPHERE_SWESPHEREBENCHMARKSINITIALCONDITIONCACHE_HPP_
+#define SRC_INCLUDE_BENCHMARKS_SPHERE_SWESPHEREBENCHMARKSINITIALCONDITIONCACHE_HPP_
+
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sweet/FatalError.hpp>
+#include <sweet/parmemcpy.hpp>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/SWEETDataContainer.hpp>
+#include <sweet/sphere/SphereData_Config.hpp>
+#include <sweet/sphere/SphereData_Spectral.hpp>
+
+
+
+/**
+ * On-disk cache of initial conditions of benchmarks
+ *
+ * The initial conditions are stored in a SWEET data container which is
+ * keyed by a hash of all benchmark and simulation parameters which are
+ * used to generate them as well as the resolution. Subsequent runs of
+ * an ensemble or parameter sweep directly copy the payload of the
+ * mmap'ed container to the prognostic fields.
+ *
+ * Benchmarks can override simulation parameters (e.g. the gravitation),
+ * hence these are stored as well and restored while loading.
+ */
+class SWESphereBenchmarksInitialConditionCache
+{
+	/// Increase this if the generation of any initial condition changes
+	static const int cache_version = 1;
+
+
+public:
+	/**
+	 * Return file name of cache entry for the current parameters
+	 *
+	 * This has to be called before the benchmark is setup since this
+	 * can change the simulation parameters.
+	 */
+	static
+	std::string getFilename(
+			const SimulationVariables &i_simVars,
+			const SphereData_Config *i_sphereDataConfig
+	)
+	{
+		std::ostringstream key;
+		key << std::setprecision(17);
+
+		key << "v" << cache_version;
+		key << "|" << i_simVars.benchmark.benchmark_name;
+		key << "|" << i_simVars.benchmark.random_seed;
+		key << "|" << i_simVars.benchmark.benchmark_galewsky_umax;
+		key << "|" << i_simVars.benchmark.benchmark_galewsky_hamp;
+		key << "|" << i_simVars.benchmark.benchmark_galewsky_phi2;
+		key << "|" << i_simVars.benchmark.object_scale;
+		key << "|" << i_simVars.benchmark.object_coord_x;
+		key << "|" << i_simVars.benchmark.object_coord_y;
+		key << "|" << i_simVars.benchmark.sphere_advection_rotation_angle;
+
+		key << "|" << i_simVars.sim.gravitation;
+		key << "|" << i_simVars.sim.h0;
+		key << "|" << i_simVars.sim.sphere_radius;
+		key << "|" << i_simVars.sim.sphere_rotating_coriolis_omega;
+		key << "|" << i_simVars.sim.advection_velocity[0];
+		key << "|" << i_simVars.sim.advection_velocity[1];
+		key << "|" << i_simVars.sim.advection_velocity[2];
+
+		key << "|" << i_simVars.misc.sphere_use_robert_functions;
+
+		key << "|" << i_sphereDataConfig->spectral_modes_n_max;
+		key << "|" << i_sphereDataConfig->spectral_modes_m_max;
+		key << "|" << i_sphereDataConfig->physical_num_lon;
+		key << "|" << i_sphereDataConfig->physical_num_lat;
+
+		std::ostringstream filename;
+		filename << i_simVars.benchmark.initial_condition_cache_dir << "/sweet_ic_";
+		filename << i_simVars.benchmark.benchmark_name << "_";
+		filename << std::hex << std::setw(16) << std::setfill('0') << p_hash(key.str());
+		filename << ".sweetdc";
+
+		return filename.str();
+	}
+
+
+
+	/**
+	 * Load initial conditions from cache
+	 *
+	 * Returns false if there's no cache entry.
+	 */
+	static
+	bool load(
+			const std::string &i_filename,
+			SimulationVariables &io_simVars,
+			SphereData_Spectral &o_phi,
+			SphereData_Spectral &o_vort,
+			SphereData_Spectral &o_div
+	)
+	{
+		struct stat st;
+		if (stat(i_filename.c_str(), &st) != 0)
+			return false;
+
+		SWEETDataContainerReader reader;
+		reader.open(i_filename);
+
+		p_loadField(reader, "prog_phi", o_phi);
+		p_loadField(reader, "prog_vort", o_vort);
+		p_loadField(reader, "prog_div", o_div);
+
+		io_simVars.sim.gravitation = p_loadScalar(reader, "sim.gravitation");
+		io_simVars.sim.h0 = p_loadScalar(reader, "sim.h0");
+		io_simVars.sim.sphere_radius = p_loadScalar(reader, "sim.sphere_radius");
+		io_simVars.sim.sphere_rotating_coriolis_omega = p_loadScalar(reader, "sim.sphere_rotating_coriolis_omega");
+		io_simVars.iodata.output_time_scale = p_loadScalar(reader, "iodata.output_time_scale");
+
+		return true;
+	}
+
+
+
+	/**
+	 * Store initial conditions in cache
+	 *
+	 * The container is first written to a temporary file which is then
+	 * renamed. Hence, concurrently started runs never read an incomplete
+	 * cache entry.
+	 */
+	static
+	void store(
+			const std::string &i_filename,
+			const SimulationVariables &i_simVars,
+			const SphereData_Spectral &i_phi,
+			const SphereData_Spectral &i_vort,
+			const SphereData_Spectral &i_div
+	)
+	{
+		std::string tmp_filename = i_filename+".tmp"+std::to_string(getpid());
+
+		{
+			SWEETDataContainerWriter writer;
+			writer.open(tmp_filename);
+
+			p_storeField(writer, "prog_phi", i_phi);
+			p_storeField(writer, "prog_vort", i_vort);
+			p_storeField(writer, "prog_div", i_div);
+
+			p_storeScalar(writer, "sim.gravitation", i_simVars.sim.gravitation);
+			p_storeScalar(writer, "sim.h0", i_simVars.sim.h0);
+			p_storeScalar(writer, "sim.sphere_radius", i_simVars.sim.sphere_radius);
+			p_storeScalar(writer, "sim.sphere_rotating_coriolis_omega", i_simVars.sim.sphere_rotating_coriolis_omega);
+			p_storeScalar(writer, "iodata.output_time_scale", i_simVars.iodata.output_time_scale);
+		}
+
+		if (std::rename(tmp_filename.c_str(), i_filename.c_str()) != 0)
+			FatalError("SWESphereBenchmarksInitialConditionCache: Failed to rename '"+tmp_filename+"' to '"+i_filename+"'");
+	}
+
+
+
+private:
+	/**
+	 * 64-bit FNV-1a hash (independent of the standard library implementation)
+	 */
+	static
+	std::uint64_t p_hash(
+			const std::string &i_string
+	)
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+
+		for (std::size_t i = 0; i < i_string.size(); i++)
+		{
+			hash ^= (unsigned char)i_string[i];
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+
+
+	static
+	void p_storeField(
+			SWEETDataContainerWriter &io_writer,
+			const std::string &i_name,
+			const SphereData_Spectral &i_data
+	)
+	{
+		const SphereData_Config *sphereDataConfig = i_data.sphereDataConfig;
+		int64_t res[4] = {sphereDataConfig->spectral_modes_n_max, sphereDataConfig->spectral_modes_m_max, 0, 0};
+
+		// Uncompressed to allow direct access to the payload
+		io_writer.appendRecord(
+				i_name,
+				0,
+				SWEETDataContainer::PRIMITIVE_SPHERE,
+				SWEETDataContainer::SPACE_SPECTRAL,
+				SWEETDataContainer::DATA_TYPE_COMPLEX128,
+				res,
+				i_data.spectral_space_data,
+				sphereDataConfig->spectral_array_data_number_of_elements
+			);
+	}
+
+
+
+	static
+	void p_storeScalar(
+			SWEETDataContainerWriter &io_writer,
+			const std::string &i_name,
+			double i_value
+	)
+	{
+		int64_t res[4] = {1, 0, 0, 0};
+
+		io_writer.appendRecord(
+				i_name,
+				0,
+				SWEETDataContainer::PRIMITIVE_SCALAR,
+				SWEETDataContainer::SPACE_PHYSICAL,
+				SWEETDataContainer::DATA_TYPE_FLOAT64,
+				res,
+				&i_value,
+				1
+			);
+	}
+
+
+
+	static
+	void p_loadField(
+			const SWEETDataContainerReader &i_reader,
+			const std::string &i_name,
+			SphereData_Spectral &o_data
+	)
+	{
+		const SphereData_Config *sphereDataConfig = o_data.sphereDataConfig;
+
+		int record_id = i_reader.findRecord(i_name, 0);
+		if (record_id < 0)
+			FatalError("SWESphereBenchmarksInitialConditionCache: Field '"+i_name+"' not found");
+
+		const SWEETDataContainer::RecordHeader *r = i_reader.records[record_id];
+
+		if (
+				r->resolution[0] != sphereDataConfig->spectral_modes_n_max ||
+				r->resolution[1] != sphereDataConfig->spectral_modes_m_max ||
+				r->payload_num_elements != sphereDataConfig->spectral_array_data_number_of_elements
+		)
+			FatalError("SWESphereBenchmarksInitialConditionCache: Resolution of '"+i_name+"' doesn't match");
+
+		const std::complex<double> *payload = i_reader.getPayload<std::complex<double>>(record_id);
+
+		parmemcpy(o_data.spectral_space_data, (void*)payload, sizeof(std::complex<double>)*r->payload_num_elements);
+		o_data.spectral_data_modified();
+	}
+
+
+
+	static
+	double p_loadScalar(
+			const SWEETDataContainerReader &i_reader,
+			const std::string &i_name
+	)
+	{
+		int record_id = i_reader.findRecord(i_name, 0);
+		if (record_id < 0)
+			FatalError("SWESphereBenchmarksInitialConditionCache: Scalar '"+i_name+"' not found");
+
+		return *i_reader.getPayload<double>(record_id);
+	}
+};
+
+
+#endif /* SRC_INCLUDE_BENCHMARKS_SPHERE_SWESPHEREBENCHMARKSINITIALCONDITIONCACHE_HPP_ */
@@ -73,6 +73,31 @@ extern "C"
 			const int &LDB,
 			int &INFO
 	);
+
+	void zgbtrf_(
+			const int &M,
+			const int &N,
+			const int &KL,
+			const int &KU,
+			std::complex<double> *AB,
+			const int &LDAB,
+			int *IPIV,
+			int &INFO
+	);
+
+	void zgbtrs_(
+			const char *TRANS,
+			const int &N,
+			const int &KL,
+			const int &KU,
+			const int &NRHS,
+			const std::complex<double> *AB,
+			const int &LDAB,
+			const int *IPIV,
+			std::complex<double> *B,
+			const int &LDB,
+			int &INFO
+	);
 #if 0
 	void zlapmr_(
 			int &forward,
@@ -339,9 +364,28 @@ public:
 
 #else
 
+		convert_Carray_to_FortranArray(i_A, AB, i_size);
+#endif
+
+		solve_diagBandedInverse_FortranArray(AB, i_b, o_x, i_size);
+	}
+
+
+
+	/**
+	 * Convert compact C array (see solve_diagBandedInverse_Carray)
+	 * to LAPACK general band matrix format with LDAB rows and i_size columns
+	 */
+public:
+	void convert_Carray_to_FortranArray(
+		const std::complex<double>* i_A,
+		std::complex<double>* o_AB,
+		int i_size
+	)	const
+	{
 #ifndef NDEBUG
 		for (int i = 0; i < i_size*LDAB; i++)
-			AB[i] = std::numeric_limits<double>::infinity();
+			o_AB[i] = std::numeric_limits<double>::infinity();
 #endif
 
 		// columns for output fortran array
@@ -364,12 +408,92 @@ public:
 				assert(LDAB*max_N > i*i_size+j);
 				assert(LDAB*max_N > i+j*num_diagonals);
 
-				AB[(num_diagonals+si-sj-1) + sj*LDAB] = i_A[(j-i+num_halo_size_diagonals)*num_diagonals + i];
+				o_AB[(num_diagonals+si-sj-1) + sj*LDAB] = i_A[(j-i+num_halo_size_diagonals)*num_diagonals + i];
 			}
 		}
+	}
+
+
+
+	/**
+	 * Compute the LU factorization of the matrix given as compact C array.
+	 *
+	 * o_AB has to provide space for LDAB*i_size values, o_IPIV for i_size values.
+	 * The factorization can be used for an arbitrary number of solves
+	 * with solve_factorized() without changing any member variables.
+	 */
+public:
+	void factorize_Carray(
+		const std::complex<double>* i_A,
+		std::complex<double>* o_AB,
+		int *o_IPIV,
+		int i_size
+	)	const
+	{
+		convert_Carray_to_FortranArray(i_A, o_AB, i_size);
+
+#if SWEET_LAPACK
+		int info;
+		zgbtrf_(
+				i_size,						// number of rows
+				i_size,						// number of columns
+				num_halo_size_diagonals,	// number of subdiagonals
+				num_halo_size_diagonals,	// number of superdiagonals
+				o_AB,						// matrix A, overwritten by its LU factorization
+				LDAB,						// leading dimension of matrix A
+				o_IPIV,						// integer array for pivoting
+				info
+			);
+
+		if (info != 0)
+		{
+			std::cerr << "zgbtrf returned INFO != 0: " << info << std::endl;
+			assert(false);
+			exit(1);
+		}
+#else
+		FatalError("SWEET compiled without LAPACK!!!");
 #endif
+	}
 
-		solve_diagBandedInverse_FortranArray(AB, i_b, o_x, i_size);
+
+
+	/**
+	 * Solve with the LU factorization computed with factorize_Carray()
+	 */
+public:
+	void solve_factorized(
+		const std::complex<double>* i_AB,
+		const int *i_IPIV,
+		std::complex<double>* io_b_x,	///< rhs and solution x
+		int i_size
+	)	const
+	{
+#if SWEET_LAPACK
+		int info;
+		zgbtrs_(
+				"N",						// no transpose
+				i_size,						// order of matrix A
+				num_halo_size_diagonals,	// number of subdiagonals
+				num_halo_size_diagonals,	// number of superdiagonals
+				1,							// number of columns of matrix B
+				i_AB,						// LU factorization of matrix A
+				LDAB,						// leading dimension of matrix A
+				i_IPIV,						// pivot indices
+				io_b_x,						// rhs and solution
+				i_size,						// leading dimension of array io_b_x
+				info
+			);
+
+		if (info != 0)
+		{
+			std::cerr << "zgbtrs returned INFO != 0: " << info << std::endl;
+			assert(false);
+			exit(1);
+		}
+#else
+		FatalError("SWEET compiled without LAPACK!!!");
+#endif
 	}
 
 
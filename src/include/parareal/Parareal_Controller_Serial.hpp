@@ -12,6 +12,8 @@
 #include <parareal/Parareal_ConsolePrefix.hpp>
 #include <parareal/Parareal_SimulationInstance.hpp>
 #include <parareal/Parareal_SimulationVariables.hpp>
+#include <sweet/SWEETCheckpoint.hpp>
+#include <sweet/BackgroundOutputWriter.hpp>
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -48,6 +50,21 @@ class Parareal_Controller_Serial
 	 */
 	Parareal_ConsolePrefix CONSOLEPREFIX;
 
+	/**
+	 * Filename to write checkpoint to after each iteration
+	 */
+	std::string checkpoint_file_name;
+
+	/**
+	 * Filename of checkpoint to restart from
+	 */
+	std::string checkpoint_restart_file_name;
+
+	/**
+	 * Write checkpoints without blocking the iterations
+	 */
+	BackgroundOutputWriter checkpointWriter;
+
 public:
 	Parareal_Controller_Serial()
 	{
@@ -166,37 +183,118 @@ public:
 		CONSOLEPREFIX_end();
 	}
 
-	void run()
+	/**
+	 * Setup checkpointing
+	 */
+	void setup_checkpointing(
+			const std::string &i_checkpoint_file_name,			///< write checkpoint after each iteration to this file (empty: no checkpoints)
+			const std::string &i_checkpoint_restart_file_name	///< restart from this checkpoint (empty: no restart)
+	)
+	{
+		checkpoint_file_name = i_checkpoint_file_name;
+		checkpoint_restart_file_name = i_checkpoint_restart_file_name;
+
+		if (checkpoint_file_name != "")
+			checkpointWriter.setup(1);
+	}
+
+
+
+	/**
+	 * Write checkpoint with the data of all time slices after the given iteration
+	 */
+	void checkpoint_write(
+			int i_iteration
+	)
 	{
+		std::shared_ptr<SWEETCheckpoint> checkpoint(new SWEETCheckpoint);
+
+		checkpoint->addScalar("parareal.coarse_slices", pVars->coarse_slices);
+		checkpoint->addScalar("parareal.iteration", i_iteration);
+
+		for (int i = 0; i < pVars->coarse_slices; i++)
+			parareal_simulationInstances[i]->checkpoint_write(*checkpoint, "slice"+std::to_string(i)+".");
+
 		CONSOLEPREFIX_start("[MAIN] ");
-		std::cout << "Initial propagation" << std::endl;
+		std::cout << "Writing checkpoint '" << checkpoint_file_name << "' after iteration " << i_iteration << std::endl;
+
+		std::string filename = checkpoint_file_name;
+		checkpointWriter.enqueue(
+				[checkpoint, filename]()
+				{
+					checkpoint->writeFile(filename);
+				}
+			);
+	}
 
-		/**
-		 * Initial propagation
-		 */
-		CONSOLEPREFIX_start(0);
-		parareal_simulationInstances[0]->run_timestep_coarse();
-		for (int i = 1; i < pVars->coarse_slices; i++)
-		{
-			CONSOLEPREFIX_start(i-1);
-			Parareal_Data &tmp = parareal_simulationInstances[i-1]->get_reference_to_data_timestep_coarse();
 
-			// use coarse time step output data as initial data of next coarse time step
-			CONSOLEPREFIX_start(i);
-			parareal_simulationInstances[i]->sim_set_data(tmp);
 
-			// run coarse time step
-			parareal_simulationInstances[i]->run_timestep_coarse();
+	/**
+	 * Load data of all time slices from checkpoint
+	 *
+	 * Return: iteration after which the checkpoint was written
+	 */
+	int checkpoint_read()
+	{
+		CONSOLEPREFIX_start("[MAIN] ");
+		std::cout << "Restarting from checkpoint '" << checkpoint_restart_file_name << "'" << std::endl;
+
+		SWEETCheckpoint checkpoint;
+		checkpoint.readFile(checkpoint_restart_file_name);
+
+		if ((int)checkpoint.getScalar("parareal.coarse_slices") != pVars->coarse_slices)
+			FatalError("Checkpoint: Number of coarse slices doesn't match");
+
+		for (int i = 0; i < pVars->coarse_slices; i++)
+		{
+			CONSOLEPREFIX_start(i);
+			parareal_simulationInstances[i]->checkpoint_read(checkpoint, "slice"+std::to_string(i)+".");
 		}
 
+		return checkpoint.getScalar("parareal.iteration");
+	}
+
 
 
+	void run()
+	{
 		/**
 		 * We run as much Parareal iterations as there are coarse slices
 		 */
 //		int start_slice = 0;
 
 		int k = 0;
+
+		if (checkpoint_restart_file_name != "")
+		{
+			// continue with iteration after checkpoint
+			k = checkpoint_read()+1;
+		}
+		else
+		{
+			CONSOLEPREFIX_start("[MAIN] ");
+			std::cout << "Initial propagation" << std::endl;
+
+			/**
+			 * Initial propagation
+			 */
+			CONSOLEPREFIX_start(0);
+			parareal_simulationInstances[0]->run_timestep_coarse();
+			for (int i = 1; i < pVars->coarse_slices; i++)
+			{
+				CONSOLEPREFIX_start(i-1);
+				Parareal_Data &tmp = parareal_simulationInstances[i-1]->get_reference_to_data_timestep_coarse();
+
+				// use coarse time step output data as initial data of next coarse time step
+				CONSOLEPREFIX_start(i);
+				parareal_simulationInstances[i]->sim_set_data(tmp);
+
+				// run coarse time step
+				parareal_simulationInstances[i]->run_timestep_coarse();
+			}
+		}
+
+
 		for (; k < pVars->coarse_slices; k++)
 		{
 			CONSOLEPREFIX_start("[MAIN] ");
@@ -287,11 +385,18 @@ public:
 				}
 
 			}
+
+			if (checkpoint_file_name != "")
+				checkpoint_write(k);
+
 ///			start_slice++;
 		}
 
 converged:
 
+		// Finish writing of checkpoints
+		checkpointWriter.shutdown();
+
 		CONSOLEPREFIX_end();
 	}
 };
@@ -10,6 +10,7 @@
 
 #include <assert.h>
 #include <parareal/Parareal_Data.hpp>
+#include <sweet/SWEETCheckpoint.hpp>
 
 
 
@@ -92,6 +93,32 @@ public:
 		assert(false);
 	}
 
+	/**
+	 * Store data to checkpoint
+	 */
+	void checkpoint_write(
+			SWEETCheckpoint &io_checkpoint,
+			const std::string &i_prefix
+	)	const
+	{
+		for (int i = 0; i < N; i++)
+			data_arrays[i]->checkpoint_write(io_checkpoint, i_prefix+std::to_string(i));
+	}
+
+
+	/**
+	 * Load data from checkpoint
+	 */
+	void checkpoint_read(
+			const SWEETCheckpoint &i_checkpoint,
+			const std::string &i_prefix
+	)
+	{
+		for (int i = 0; i < N; i++)
+			data_arrays[i]->checkpoint_read(i_checkpoint, i_prefix+std::to_string(i));
+	}
+
+
 	virtual ~Parareal_Data_PlaneData()
 	{
 	}
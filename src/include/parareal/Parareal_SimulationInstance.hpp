@@ -11,6 +11,8 @@
 
 #include <parareal/Parareal_Data.hpp>
 #include "../sweet/plane/PlaneData.hpp"
+#include <sweet/SWEETCheckpoint.hpp>
+#include <sweet/FatalError.hpp>
 
 
 /**
@@ -131,6 +133,30 @@ public:
 			int time_slice_id
 	) = 0;
 
+	/**
+	 * Store all Parareal data of this time slice to checkpoint
+	 */
+	virtual
+	void checkpoint_write(
+			SWEETCheckpoint &io_checkpoint,
+			const std::string &i_prefix		///< prefix for names of checkpoint entries
+	)
+	{
+		FatalError("Checkpointing not supported by this Parareal simulation");
+	}
+
+	/**
+	 * Load all Parareal data of this time slice from checkpoint
+	 */
+	virtual
+	void checkpoint_read(
+			const SWEETCheckpoint &i_checkpoint,
+			const std::string &i_prefix		///< prefix for names of checkpoint entries
+	)
+	{
+		FatalError("Checkpointing not supported by this Parareal simulation");
+	}
+
 	virtual ~Parareal_SimulationInstance()
 	{
 	}
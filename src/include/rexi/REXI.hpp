@@ -15,6 +15,10 @@
 #include <rexi/REXICoefficients.hpp>
 #include <vector>
 #include <complex>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <iomanip>
 
 
 /**
@@ -30,6 +34,53 @@ public:
 	}
 
 
+private:
+	/**
+	 * Coefficients which were already computed in this process
+	 *
+	 * E.g. all members of an ensemble (see --ensemble-members) and all
+	 * time steppers with the same REXI parameters share them.
+	 */
+	struct CoefficientCache
+	{
+		std::mutex mutex;
+		std::map<std::string, std::pair<std::vector<std::complex<T>>, std::vector<std::complex<T>>>> entries;
+	};
+
+	static
+	CoefficientCache& p_getCoefficientCache()
+	{
+		static CoefficientCache cache;
+		return cache;
+	}
+
+
+	static
+	std::string p_getCoefficientCacheKey(
+			const REXI_SimulationVariables *i_rexiSimVars,
+			const std::string &i_function_name
+	)
+	{
+		std::ostringstream key;
+		key << std::setprecision(17);
+
+		key << i_rexiSimVars->rexi_method << "|" << i_function_name;
+
+		if (i_rexiSimVars->rexi_method == "terry")
+		{
+			key << "|" << i_rexiSimVars->terry_h << "|" << i_rexiSimVars->terry_M << "|" << i_rexiSimVars->terry_L;
+			key << "|" << i_rexiSimVars->terry_reduce_to_half << "|" << i_rexiSimVars->terry_normalization;
+		}
+		else if (i_rexiSimVars->rexi_method == "ci")
+		{
+			key << "|" << i_rexiSimVars->ci_n << "|" << i_rexiSimVars->ci_max_real << "|" << i_rexiSimVars->ci_max_imag;
+			key << "|" << i_rexiSimVars->ci_primitive << "|" << i_rexiSimVars->ci_s_real << "|" << i_rexiSimVars->ci_s_imag << "|" << i_rexiSimVars->ci_mu;
+		}
+
+		return key.str();
+	}
+
+
 
 public:
 	static
@@ -47,7 +98,25 @@ public:
 		o_alpha.clear();
 		o_beta.clear();
 
-		if (i_rexiSimVars->rexi_method == "terry")
+		CoefficientCache &cache = p_getCoefficientCache();
+		std::string cache_key = p_getCoefficientCacheKey(i_rexiSimVars, i_function_name);
+
+		{
+			std::lock_guard<std::mutex> lock(cache.mutex);
+
+			typename std::map<std::string, std::pair<std::vector<std::complex<T>>, std::vector<std::complex<T>>>>::const_iterator iter = cache.entries.find(cache_key);
+			if (iter != cache.entries.end())
+			{
+				o_alpha = iter->second.first;
+				o_beta = iter->second.second;
+			}
+		}
+
+		if (o_alpha.size() > 0)
+		{
+			// reuse cached coefficients
+		}
+		else if (i_rexiSimVars->rexi_method == "terry")
 		{
 			std::cout << "WARNING: This way of using REXI is deprecated" << std::endl;
 			/// REXI stuff
@@ -92,6 +161,12 @@ public:
 			FatalError("REXI Mode not supported");
 		}
 
+		if (o_alpha.size() > 0)
+		{
+			std::lock_guard<std::mutex> lock(cache.mutex);
+			cache.entries[cache_key] = std::make_pair(o_alpha, o_beta);
+		}
+
 
 		if (i_verbosity > 2)
 		{
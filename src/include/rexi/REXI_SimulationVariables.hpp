@@ -35,6 +35,24 @@ struct REXI_SimulationVariables
 	 */
 	bool sphere_solver_preallocation = true;
 
+	/**
+	 * Number of thread groups for the parallel REXI sum (SWEET_THREADING_TIME_REXI),
+	 * each group uses the remaining threads for the spatial parallelization.
+	 *
+	 * 0: One thread per group (parallelization over REXI terms only)
+	 * -1: Automatically determined by a calibration run
+	 */
+	int thread_groups = 0;
+
+	/**
+	 * Distribution of the REXI terms to the thread groups and MPI ranks
+	 *
+	 * 0: Equally sized contiguous blocks
+	 * 1: Balanced by the wallclock time of each term measured in the 2nd time step
+	 * 2: Like 1, but with work stealing between the thread groups of a rank
+	 */
+	int load_balancing = 0;
+
 
 	/***************************************************
 	 * REXI Terry
@@ -155,6 +173,8 @@ public:
 		std::cout << "REXI generic parameters:" << std::endl;
 		std::cout << " + use_extended_modes: " << use_sphere_extended_modes << std::endl;
 		std::cout << " + rexi_sphere_solver_preallocation: " << sphere_solver_preallocation << std::endl;
+		std::cout << " + thread_groups: " << thread_groups << std::endl;
+		std::cout << " + load_balancing: " << load_balancing << std::endl;
 
 		std::cout << " [REXI Files]" << std::endl;
 		std::cout << " + rexi_files: " << rexi_files << std::endl;
@@ -188,6 +208,10 @@ public:
 		std::cout << "	--rexi-use-direct-solution [bool]	Use direct solution (analytical) for REXI, default:0" << std::endl;
 		std::cout << "	--rexi-sphere-preallocation [bool]	Use preallocation of SPH-REXI solver coefficients, default:1" << std::endl;
 		std::cout << "	--rexi-ext-modes [int]	Use this number of extended modes in spherical harmonics" << std::endl;
+		std::cout << "	--rexi-thread-groups [int]	Number of thread groups for the parallel REXI sum, the threads of each group" << std::endl;
+		std::cout << "					are used for the spatial parallelization (0: one thread per group, -1: calibrate), default:0" << std::endl;
+		std::cout << "	--rexi-load-balancing [int]	Distribution of REXI terms (0: equal blocks, 1: by measured costs," << std::endl;
+		std::cout << "					2: by measured costs and work stealing between thread groups with one thread each), default:0" << std::endl;
 		std::cout << std::endl;
 		std::cout << "  REXI file interface:" << std::endl;
 		std::cout << "	--rexi-files [str]	REXI files: [function_name0:]filepath0,[function_name1:]filepath1,..." << std::endl;
@@ -233,6 +257,13 @@ public:
 		io_next_free_program_option++;
 
 
+		io_long_options[io_next_free_program_option] = {"rexi-thread-groups", required_argument, 0, 256+io_next_free_program_option};
+		io_next_free_program_option++;
+
+		io_long_options[io_next_free_program_option] = {"rexi-load-balancing", required_argument, 0, 256+io_next_free_program_option};
+		io_next_free_program_option++;
+
+
 		// Files
 		io_long_options[io_next_free_program_option] = {"rexi-files", required_argument, 0, 256+io_next_free_program_option};
 		io_next_free_program_option++;
@@ -320,21 +351,24 @@ public:
 			case 1:		sphere_solver_preallocation = atoi(optarg);	return 0;
 			case 2:		use_sphere_extended_modes = atoi(optarg);	return 0;
 
-			case 3:		rexi_files = optarg;	rexi_files_given = true; break;
-
-			case 4:		terry_h = atof(optarg);	return 0;
-			case 5:		terry_M = atoi(optarg);	return 0;
-			case 6:		terry_L = atoi(optarg);	return 0;
-			case 7:		terry_reduce_to_half = atoi(optarg);	return 0;
-			case 8:		terry_normalization = atoi(optarg);	return 0;
-
-			case 9:	ci_n = atoi(optarg);	return 0;
-			case 10:	ci_primitive = optarg;	return 0;
-			case 11:	ci_max_real = atof(optarg);	return 0;
-			case 12:	ci_max_imag = atof(optarg);	return 0;
-			case 13:	ci_s_real = atof(optarg);	return 0;
-			case 14:	ci_s_imag = atof(optarg);	return 0;
-			case 15:	ci_mu = atof(optarg);	return 0;
+			case 3:		thread_groups = atoi(optarg);	return 0;
+			case 4:		load_balancing = atoi(optarg);	return 0;
+
+			case 5:		rexi_files = optarg;	rexi_files_given = true; break;
+
+			case 6:		terry_h = atof(optarg);	return 0;
+			case 7:		terry_M = atoi(optarg);	return 0;
+			case 8:		terry_L = atoi(optarg);	return 0;
+			case 9:		terry_reduce_to_half = atoi(optarg);	return 0;
+			case 10:	terry_normalization = atoi(optarg);	return 0;
+
+			case 11:	ci_n = atoi(optarg);	return 0;
+			case 12:	ci_primitive = optarg;	return 0;
+			case 13:	ci_max_real = atof(optarg);	return 0;
+			case 14:	ci_max_imag = atof(optarg);	return 0;
+			case 15:	ci_s_real = atof(optarg);	return 0;
+			case 16:	ci_s_imag = atof(optarg);	return 0;
+			case 17:	ci_mu = atof(optarg);	return 0;
 		}
 
 		if (rexi_files_given)
@@ -380,7 +414,7 @@ public:
 		if (rexi_method != "" && rexi_method == "terry" && rexi_method == "file")
 			FatalError("Invalid argument for '--rexi-method='");
 
-		return 16;
+		return 18;
 	}
 };
 
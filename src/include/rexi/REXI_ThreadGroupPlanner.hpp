@@ -0,0 +1,324 @@
+/*
+ * REXI_ThreadGroupPlanner.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_REXI_REXI_THREADGROUPPLANNER_HPP_
+#define SRC_INCLUDE_REXI_REXI_THREADGROUPPLANNER_HPP_
+
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <sweet/FatalError.hpp>
+
+#if SWEET_THREADING_TIME_REXI || SWEET_THREADING_SPACE
+#	include <omp.h>
+#endif
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
+
+
+
+/**
+ * Nested parallelism for the parallel REXI sum
+ *
+ * The P threads of a process are split into G groups with T threads each.
+ * Each group processes a chunk of the REXI terms and each term is
+ * processed with a team of T threads (SWEET_THREADING_SPACE loops).
+ * Without spatial threading, there's only one thread per group.
+ *
+ * The number of groups is either given (--rexi-thread-groups=G) or
+ * determined by a calibration which measures the wallclock time of a
+ * REXI time step for each possible split of the threads.
+ *
+ * Usage:
+ *
+ *   planner.setup(rexiSimVars->thread_groups, num_terms);
+ *
+ *   if (planner.isCalibrationPending())
+ *       planner.calibrate(
+ *               "rexi",
+ *               [&]() { [setup for planner.num_groups] },
+ *               [&]() { [run time step] }
+ *           );
+ *
+ *   {
+ *       REXI_ThreadGroupPlanner::NestedRegion nested(planner);
+ *
+ *       #pragma omp parallel for schedule(static,1) num_threads(planner.num_groups)
+ *       for (int group_id = 0; group_id < planner.num_groups; group_id++)
+ *       {
+ *           planner.setupGroupThread();
+ *           ...
+ *       }
+ *   }
+ */
+class REXI_ThreadGroupPlanner
+{
+public:
+	/// Number of threads of this process (P)
+	int num_threads;
+
+	/// Number of thread groups (G)
+	int num_groups;
+
+	/// Number of threads in each group (T)
+	int num_threads_per_group;
+
+private:
+	/// Max. number of groups which can be utilized (e.g. number of REXI terms)
+	int max_groups;
+
+	/// Calibration was requested, but not yet done
+	bool calibration_pending;
+
+
+public:
+	REXI_ThreadGroupPlanner()	:
+		num_threads(1),
+		num_groups(1),
+		num_threads_per_group(1),
+		max_groups(1),
+		calibration_pending(false)
+	{
+	}
+
+
+	/**
+	 * Setup the split of the threads
+	 */
+	void setup(
+			int i_num_groups,		///< >0: number of groups, 0: one thread per group, -1: calibrate
+			int i_max_groups		///< max. number of groups which can be utilized
+	)
+	{
+#if SWEET_THREADING_TIME_REXI
+		num_threads = omp_get_max_threads();
+#else
+		num_threads = 1;
+#endif
+
+		if (num_threads <= 0)
+			FatalError("REXI_ThreadGroupPlanner: omp_get_max_threads <= 0");
+
+		max_groups = std::max(1, i_max_groups);
+		calibration_pending = false;
+
+		if (i_num_groups > 0)
+		{
+			if (i_num_groups > num_threads)
+				FatalError("REXI_ThreadGroupPlanner: More thread groups than threads requested");
+
+			p_setGroups(i_num_groups);
+		}
+		else if (i_num_groups == 0)
+		{
+			p_setGroups(num_threads);
+		}
+		else if (i_num_groups == -1)
+		{
+			// One thread per group until calibrated
+			p_setGroups(num_threads);
+			calibration_pending = (getCandidates().size() > 1);
+		}
+		else
+		{
+			FatalError("REXI_ThreadGroupPlanner: Invalid number of thread groups");
+		}
+	}
+
+
+
+	bool isCalibrationPending()	const
+	{
+		return calibration_pending;
+	}
+
+
+
+	/**
+	 * Return all reasonable numbers of groups
+	 *
+	 * These are the divisors of the number of threads.
+	 * More groups than work items are only considered for one thread per group.
+	 */
+	std::vector<int> getCandidates()	const
+	{
+		std::vector<int> candidates;
+
+#if SWEET_THREADING_SPACE
+		for (int g = 1; g <= num_threads; g++)
+		{
+			if (num_threads % g != 0)
+				continue;
+
+			if (g > max_groups && g != num_threads)
+				continue;
+
+			candidates.push_back(g);
+		}
+#else
+		// Groups can't utilize more than one thread
+		candidates.push_back(num_threads);
+#endif
+
+		return candidates;
+	}
+
+
+
+	/**
+	 * Determine the fastest split of the threads
+	 *
+	 * For each candidate split (num_groups, num_threads_per_group),
+	 * the setup callback is executed once and the run callback, which
+	 * should execute a representative workload, is measured.
+	 * Finally, the setup callback is executed for the fastest split.
+	 *
+	 * With MPI, all ranks have to call this method and the max. time
+	 * over all ranks is used.
+	 */
+	template <typename T_SetupCallback, typename T_RunCallback>
+	void calibrate(
+			const std::string &i_name,		///< prefix for output
+			T_SetupCallback i_setup_callback,
+			T_RunCallback i_run_callback,
+			int i_verbosity = 0
+	)
+	{
+		// Avoid recursive calibration if the run callback executes the time stepper
+		calibration_pending = false;
+
+		std::vector<int> candidates = getCandidates();
+
+		int best_num_groups = num_threads;
+		double best_seconds = std::numeric_limits<double>::infinity();
+
+		for (std::size_t i = 0; i < candidates.size(); i++)
+		{
+			p_setGroups(candidates[i]);
+			i_setup_callback();
+
+			// Use the fastest out of 2 runs to reduce the impact of first-touch effects
+			double seconds = std::numeric_limits<double>::infinity();
+			for (int r = 0; r < 2; r++)
+			{
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				i_run_callback();
+				seconds = std::min(seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+			}
+
+#if SWEET_MPI
+			MPI_Allreduce(MPI_IN_PLACE, &seconds, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif
+
+			if (i_verbosity > 0 && p_getMPIRank() == 0)
+				std::cout << i_name << " thread groups calibration: " << num_groups << " x " << num_threads_per_group << " threads: " << seconds << " seconds" << std::endl;
+
+			if (seconds < best_seconds)
+			{
+				best_seconds = seconds;
+				best_num_groups = num_groups;
+			}
+		}
+
+		if (best_num_groups != num_groups)
+		{
+			p_setGroups(best_num_groups);
+			i_setup_callback();
+		}
+
+		if (p_getMPIRank() == 0)
+		{
+			std::cout << "[MULE] " << i_name << ".thread_groups: " << num_groups << std::endl;
+			std::cout << "[MULE] " << i_name << ".threads_per_group: " << num_threads_per_group << std::endl;
+		}
+	}
+
+
+
+	/**
+	 * Set the size of the team for nested parallel regions in a group thread
+	 *
+	 * This has to be called by each group thread in the outer parallel region.
+	 */
+	void setupGroupThread()	const
+	{
+#if SWEET_THREADING_TIME_REXI && SWEET_THREADING_SPACE
+		omp_set_num_threads(num_threads_per_group);
+#endif
+	}
+
+
+
+	/**
+	 * Activate nested parallel regions in the current scope if groups have more than one thread
+	 */
+	class NestedRegion
+	{
+#if SWEET_THREADING_TIME_REXI && SWEET_THREADING_SPACE
+		int max_active_levels;
+#endif
+
+	public:
+		NestedRegion(
+				const REXI_ThreadGroupPlanner &i_planner
+		)
+		{
+#if SWEET_THREADING_TIME_REXI && SWEET_THREADING_SPACE
+			max_active_levels = omp_get_max_active_levels();
+
+			if (i_planner.num_threads_per_group > 1)
+				omp_set_max_active_levels(std::max(max_active_levels, 2));
+#endif
+		}
+
+		~NestedRegion()
+		{
+#if SWEET_THREADING_TIME_REXI && SWEET_THREADING_SPACE
+			omp_set_max_active_levels(max_active_levels);
+#endif
+		}
+	};
+
+
+
+private:
+	void p_setGroups(
+			int i_num_groups
+	)
+	{
+		num_groups = i_num_groups;
+
+#if SWEET_THREADING_SPACE
+		num_threads_per_group = std::max(1, num_threads/num_groups);
+#else
+		num_threads_per_group = 1;
+#endif
+	}
+
+
+
+	static
+	int p_getMPIRank()
+	{
+#if SWEET_MPI
+		int rank;
+		MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+		return rank;
+#else
+		return 0;
+#endif
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_REXI_REXI_THREADGROUPPLANNER_HPP_ */
@@ -0,0 +1,224 @@
+/*
+ * REXI_WorkloadPartitioner.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_REXI_REXI_WORKLOADPARTITIONER_HPP_
+#define SRC_INCLUDE_REXI_REXI_WORKLOADPARTITIONER_HPP_
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <algorithm>
+#include <sweet/FatalError.hpp>
+
+
+
+/**
+ * Distribution of the REXI terms to all thread groups of all MPI ranks
+ *
+ * Each part is a list of the (global) indices of the REXI terms.
+ * The partitioning has to be deterministic since each rank computes
+ * the partitioning of all ranks.
+ */
+class REXI_WorkloadPartitioner
+{
+public:
+	/**
+	 * Split the terms into equally sized contiguous blocks
+	 */
+	static
+	void partitionBlocks(
+			std::size_t i_num_terms,
+			int i_num_parts,
+			std::vector< std::vector<std::size_t> > &o_parts
+	)
+	{
+		if (i_num_parts <= 0)
+			FatalError("REXI_WorkloadPartitioner: Number of parts must be > 0");
+
+		std::size_t block_size = i_num_terms/i_num_parts;
+		if (block_size*i_num_parts != i_num_terms)
+			block_size++;
+
+		o_parts.clear();
+		o_parts.resize(i_num_parts);
+
+		for (int p = 0; p < i_num_parts; p++)
+		{
+			std::size_t start = std::min(i_num_terms, block_size*p);
+			std::size_t end = std::min(i_num_terms, start+block_size);
+
+			for (std::size_t n = start; n < end; n++)
+				o_parts[p].push_back(n);
+		}
+	}
+
+
+
+	/**
+	 * Split the terms into parts with balanced costs
+	 *
+	 * Longest-processing-time-first: The terms are assigned in the order
+	 * of descending costs to the part with the currently smallest costs.
+	 * The terms of each part are sorted by their index afterwards.
+	 */
+	static
+	void partitionCosts(
+			const std::vector<double> &i_costs,
+			int i_num_parts,
+			std::vector< std::vector<std::size_t> > &o_parts
+	)
+	{
+		if (i_num_parts <= 0)
+			FatalError("REXI_WorkloadPartitioner: Number of parts must be > 0");
+
+		std::vector<std::size_t> order(i_costs.size());
+		std::iota(order.begin(), order.end(), 0);
+
+		std::stable_sort(
+				order.begin(), order.end(),
+				[&](std::size_t a, std::size_t b)
+				{
+					return i_costs[a] > i_costs[b];
+				}
+			);
+
+		o_parts.clear();
+		o_parts.resize(i_num_parts);
+
+		std::vector<double> loads(i_num_parts, 0.0);
+
+		for (std::size_t i = 0; i < order.size(); i++)
+		{
+			int p = std::min_element(loads.begin(), loads.end()) - loads.begin();
+
+			o_parts[p].push_back(order[i]);
+			loads[p] += i_costs[order[i]];
+		}
+
+		for (int p = 0; p < i_num_parts; p++)
+			std::sort(o_parts[p].begin(), o_parts[p].end());
+	}
+
+
+
+	/**
+	 * Return ratio of max. and average load (1 means perfectly balanced)
+	 */
+	static
+	double getImbalance(
+			double i_max_load,
+			double i_sum_loads,
+			int i_num_loads
+	)
+	{
+		if (i_sum_loads <= 0 || i_num_loads <= 0)
+			return 1.0;
+
+		return i_max_load/(i_sum_loads/(double)i_num_loads);
+	}
+};
+
+
+
+/**
+ * Work queues of the thread groups of one rank
+ *
+ * Each thread group first processes the terms of its own queue.
+ * With work stealing, it continues with the remaining terms of the
+ * queues of the other groups afterwards.
+ */
+class REXI_WorkStealingQueues
+{
+	struct Queue
+	{
+		std::atomic<std::size_t> next;
+		std::size_t size;
+
+		// avoid false sharing of the counters
+		char padding[64];
+	};
+
+	std::unique_ptr<Queue[]> queues;
+	int num_queues;
+	bool work_stealing;
+
+
+public:
+	REXI_WorkStealingQueues()	:
+		num_queues(0),
+		work_stealing(false)
+	{
+	}
+
+
+	void setup(
+			const std::vector<std::size_t> &i_queue_sizes,
+			bool i_work_stealing
+	)
+	{
+		num_queues = i_queue_sizes.size();
+		work_stealing = i_work_stealing;
+
+		queues.reset(new Queue[num_queues]);
+
+		for (int i = 0; i < num_queues; i++)
+		{
+			queues[i].next = 0;
+			queues[i].size = i_queue_sizes[i];
+		}
+	}
+
+
+	/**
+	 * Make all terms available again, e.g. for the next time step
+	 *
+	 * This must not be called concurrently to getNext()
+	 */
+	void reset()
+	{
+		for (int i = 0; i < num_queues; i++)
+			queues[i].next = 0;
+	}
+
+
+	/**
+	 * Get next term to be processed by the given thread group
+	 *
+	 * Returns false if there's no term left.
+	 */
+	bool getNext(
+			int i_queue_id,				///< queue of the calling thread group
+			int &o_queue_id,			///< queue of the term
+			std::size_t &o_queue_idx	///< index of the term in this queue
+	)
+	{
+		int num_tries = work_stealing ? num_queues : 1;
+
+		for (int i = 0; i < num_tries; i++)
+		{
+			int q = (i_queue_id + i) % num_queues;
+
+			if (queues[q].next.load(std::memory_order_relaxed) >= queues[q].size)
+				continue;
+
+			std::size_t idx = queues[q].next.fetch_add(1, std::memory_order_relaxed);
+			if (idx >= queues[q].size)
+				continue;
+
+			o_queue_id = q;
+			o_queue_idx = idx;
+			return true;
+		}
+
+		return false;
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_REXI_REXI_WORKLOADPARTITIONER_HPP_ */
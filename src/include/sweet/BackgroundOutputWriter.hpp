@@ -0,0 +1,272 @@
+/*
+ * BackgroundOutputWriter.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_BACKGROUNDOUTPUTWRITER_HPP_
+#define SRC_INCLUDE_SWEET_BACKGROUNDOUTPUTWRITER_HPP_
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <iostream>
+#include <sweet/Stopwatch.hpp>
+#include <sweet/FatalError.hpp>
+
+
+
+/**
+ * Execute output jobs (formatting, compression, writing files)
+ * in a dedicated I/O thread.
+ *
+ * The time stepping loop only has to create a snapshot of the data
+ * to be written (see createStagingBuffer()) and to hand over a job
+ * which works exclusively on this snapshot.
+ *
+ * The caller is only blocked if the queue of pending jobs is full.
+ *
+ * IMPORTANT:
+ * Jobs are executed outside of any OpenMP region and without a
+ * MemBlockAlloc domain. Therefore, jobs must not allocate or free
+ * any SWEET data containers (SphereData_*, PlaneData, ...).
+ * Only the staging buffers should be used which rely on the system's allocator.
+ */
+class BackgroundOutputWriter
+{
+public:
+	typedef std::function<void()> Job;
+
+private:
+	/// Max. number of pending jobs. 0 means synchronous output
+	std::size_t max_queue_size;
+
+	/// queue of pending jobs
+	std::deque<Job> job_queue;
+
+	/// Number of jobs which are currently being processed
+	int jobs_in_progress;
+
+	std::mutex mutex;
+	std::condition_variable cond_queue_not_empty;
+	std::condition_variable cond_queue_not_full;
+
+	bool shutdown_requested;
+
+	std::thread io_thread;
+
+public:
+	/// Time which the simulation was blocked due to a full queue
+	Stopwatch stopwatch_blocked;
+
+	/// Time spent in the I/O thread executing jobs
+	Stopwatch stopwatch_io;
+
+
+
+public:
+	BackgroundOutputWriter()	:
+		max_queue_size(0),
+		jobs_in_progress(0),
+		shutdown_requested(false)
+	{
+	}
+
+
+
+	~BackgroundOutputWriter()
+	{
+		shutdown();
+	}
+
+
+
+	/**
+	 * Setup the writer
+	 */
+	void setup(
+			int i_max_queue_size		///< Max. number of pending output jobs, use 0 for synchronous output
+	)
+	{
+		shutdown();
+
+		if (i_max_queue_size < 0)
+			FatalError("Invalid size of output queue");
+
+		max_queue_size = i_max_queue_size;
+		shutdown_requested = false;
+
+		if (max_queue_size > 0)
+			io_thread = std::thread(&BackgroundOutputWriter::p_thread_loop, this);
+	}
+
+
+
+	/**
+	 * Return true if output is executed asynchronously
+	 */
+	bool isAsynchronous()
+	{
+		return io_thread.joinable();
+	}
+
+
+
+	/**
+	 * Allocate a staging buffer to store a snapshot of the data.
+	 *
+	 * This buffer can be directly captured by the job.
+	 */
+	template <typename T>
+	static
+	std::shared_ptr< std::vector<T> > createStagingBuffer(
+			const T *i_data,
+			std::size_t i_size
+	)
+	{
+		return std::make_shared< std::vector<T> >(i_data, i_data+i_size);
+	}
+
+
+
+	/**
+	 * Enqueue a new job.
+	 *
+	 * This blocks only if the queue is full.
+	 * For synchronous output, the job is directly executed.
+	 */
+	void enqueue(
+			const Job &i_job
+	)
+	{
+		if (!isAsynchronous())
+		{
+			i_job();
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(mutex);
+
+		if (job_queue.size() >= max_queue_size)
+		{
+			stopwatch_blocked.start();
+
+			cond_queue_not_full.wait(
+					lock,
+					[this]{ return job_queue.size() < max_queue_size; }
+				);
+
+			stopwatch_blocked.stop();
+		}
+
+		job_queue.push_back(i_job);
+
+		lock.unlock();
+		cond_queue_not_empty.notify_one();
+	}
+
+
+
+	/**
+	 * Wait until all pending jobs are processed
+	 */
+	void flush()
+	{
+		if (!isAsynchronous())
+			return;
+
+		std::unique_lock<std::mutex> lock(mutex);
+
+		stopwatch_blocked.start();
+
+		cond_queue_not_full.wait(
+				lock,
+				[this]{ return job_queue.size() == 0 && jobs_in_progress == 0; }
+			);
+
+		stopwatch_blocked.stop();
+	}
+
+
+
+	/**
+	 * Process all pending jobs and shutdown the I/O thread
+	 */
+	void shutdown()
+	{
+		if (!isAsynchronous())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			shutdown_requested = true;
+		}
+		cond_queue_not_empty.notify_one();
+
+		io_thread.join();
+	}
+
+
+
+	void output()
+	{
+		if (max_queue_size == 0)
+			return;
+
+		std::cout << "[MULE] output_writer.max_queue_size: " << max_queue_size << std::endl;
+		std::cout << "[MULE] output_writer.time_blocked: " << stopwatch_blocked() << std::endl;
+		std::cout << "[MULE] output_writer.time_io: " << stopwatch_io() << std::endl;
+	}
+
+
+
+private:
+	void p_thread_loop()
+	{
+		while (true)
+		{
+			Job job;
+
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+
+				cond_queue_not_empty.wait(
+						lock,
+						[this]{ return job_queue.size() > 0 || shutdown_requested; }
+					);
+
+				// Finish all pending jobs before shutting down
+				if (job_queue.size() == 0)
+					return;
+
+				job = job_queue.front();
+				job_queue.pop_front();
+				jobs_in_progress++;
+			}
+
+			// New slot available in queue
+			cond_queue_not_full.notify_all();
+
+			stopwatch_io.start();
+			job();
+			stopwatch_io.stop();
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				jobs_in_progress--;
+			}
+
+			// Wake up flush()
+			cond_queue_not_full.notify_all();
+		}
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_BACKGROUNDOUTPUTWRITER_HPP_ */
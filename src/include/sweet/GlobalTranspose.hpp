@@ -0,0 +1,387 @@
+/*
+ * GlobalTranspose.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_GLOBALTRANSPOSE_HPP_
+#define SRC_INCLUDE_SWEET_GLOBALTRANSPOSE_HPP_
+
+#include <vector>
+#include <complex>
+#include <climits>
+#include <sweet/MemBlockAlloc.hpp>
+#include <sweet/FatalError.hpp>
+#include <sweet/openmp_helper.hpp>
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
+
+
+
+/**
+ * Transpose of a complex-valued 2D array which is distributed over MPI ranks
+ *
+ * Row-distributed layout:
+ *   Each rank stores a contiguous range of rows with all columns,
+ *   layout [row-row_start][col] with a given stride >= number of columns.
+ *
+ * Column-distributed layout:
+ *   Each rank stores a contiguous range of columns with all rows,
+ *   layout [col-col_start][row].
+ *
+ * The redistribution is done with a single MPI_Alltoallv.
+ * All blocks consist of entire local rows or columns, hence the data is
+ * sent with datatypes of these blocks. This keeps the counts and
+ * displacements (int) small also for large arrays.
+ * Temporary buffers are allocated with the MemBlockAlloc,
+ * hence the transposes are reentrant.
+ */
+class GlobalTranspose
+{
+public:
+	std::size_t num_rows;
+	std::size_t num_cols;
+
+	int mpi_rank;
+	int mpi_size;
+
+#if SWEET_MPI
+	MPI_Comm mpi_comm;
+#endif
+
+	/// Distribution of the rows and columns of all ranks
+	std::vector<std::size_t> row_start_ranks;
+	std::vector<std::size_t> row_size_ranks;
+	std::vector<std::size_t> col_start_ranks;
+	std::vector<std::size_t> col_size_ranks;
+
+	std::size_t local_row_start;
+	std::size_t local_row_size;
+	std::size_t local_col_start;
+	std::size_t local_col_size;
+
+
+public:
+	GlobalTranspose()	:
+		num_rows(0),
+		num_cols(0),
+		mpi_rank(0),
+		mpi_size(1),
+		local_row_start(0),
+		local_row_size(0),
+		local_col_start(0),
+		local_col_size(0)
+	{
+#if SWEET_MPI
+		mpi_comm = MPI_COMM_WORLD;
+#endif
+	}
+
+
+	/**
+	 * Block distribution of n items to all ranks
+	 */
+	static
+	void distributeBlocks(
+			std::size_t i_n,
+			int i_num_ranks,
+			std::vector<std::size_t> &o_start,
+			std::vector<std::size_t> &o_size
+	)
+	{
+		o_start.resize(i_num_ranks);
+		o_size.resize(i_num_ranks);
+
+		std::size_t base = i_n / i_num_ranks;
+		std::size_t remainder = i_n % i_num_ranks;
+
+		std::size_t start = 0;
+		for (int r = 0; r < i_num_ranks; r++)
+		{
+			o_start[r] = start;
+			o_size[r] = base + ((std::size_t)r < remainder ? 1 : 0);
+			start += o_size[r];
+		}
+	}
+
+
+	/**
+	 * Contiguous distribution of n items with the given costs to all ranks
+	 *
+	 * Each rank gets at least one item.
+	 */
+	static
+	void distributeCosts(
+			const std::vector<double> &i_costs,
+			int i_num_ranks,
+			std::vector<std::size_t> &o_start,
+			std::vector<std::size_t> &o_size
+	)
+	{
+		std::size_t n = i_costs.size();
+
+		if ((std::size_t)i_num_ranks > n)
+			FatalError("GlobalTranspose: More ranks than items");
+
+		double total = 0;
+		for (std::size_t i = 0; i < n; i++)
+			total += i_costs[i];
+
+		o_start.resize(i_num_ranks);
+		o_size.resize(i_num_ranks);
+
+		std::size_t i = 0;
+		double sum = 0;
+		for (int r = 0; r < i_num_ranks; r++)
+		{
+			o_start[r] = i;
+
+			// leave at least one item for each remaining rank
+			std::size_t max_end = n - (i_num_ranks-1-r);
+			double target = total*(double)(r+1)/(double)i_num_ranks;
+
+			do
+			{
+				sum += i_costs[i];
+				i++;
+			}
+			while (i < max_end && sum + 0.5*i_costs[i] <= target);
+
+			if (r == i_num_ranks-1)
+				i = n;
+
+			o_size[r] = i - o_start[r];
+		}
+	}
+
+
+	/**
+	 * Setup the transpose
+	 *
+	 * With MPI, the distributions have to be identical on all ranks.
+	 */
+	void setup(
+			const std::vector<std::size_t> &i_row_start_ranks,
+			const std::vector<std::size_t> &i_row_size_ranks,
+			const std::vector<std::size_t> &i_col_start_ranks,
+			const std::vector<std::size_t> &i_col_size_ranks,
+			int i_mpi_rank
+#if SWEET_MPI
+			, MPI_Comm i_mpi_comm
+#endif
+	)
+	{
+		row_start_ranks = i_row_start_ranks;
+		row_size_ranks = i_row_size_ranks;
+		col_start_ranks = i_col_start_ranks;
+		col_size_ranks = i_col_size_ranks;
+
+		mpi_size = row_start_ranks.size();
+		mpi_rank = i_mpi_rank;
+
+#if SWEET_MPI
+		mpi_comm = i_mpi_comm;
+#else
+		if (mpi_size != 1)
+			FatalError("GlobalTranspose: More than one rank requires MPI");
+#endif
+
+		num_rows = row_start_ranks[mpi_size-1] + row_size_ranks[mpi_size-1];
+		num_cols = col_start_ranks[mpi_size-1] + col_size_ranks[mpi_size-1];
+
+		local_row_start = row_start_ranks[mpi_rank];
+		local_row_size = row_size_ranks[mpi_rank];
+		local_col_start = col_start_ranks[mpi_rank];
+		local_col_size = col_size_ranks[mpi_rank];
+
+		// Number of doubles of a block type (see p_createBlockType)
+		if (2*num_rows > INT_MAX || 2*num_cols > INT_MAX)
+			FatalError("GlobalTranspose: Number of rows or columns too large");
+	}
+
+
+
+private:
+#if SWEET_MPI
+	/**
+	 * Datatype for a block of complex values which are sent as pairs of doubles
+	 */
+	static
+	MPI_Datatype p_createBlockType(
+			std::size_t i_num_values
+	)
+	{
+		MPI_Datatype type;
+		MPI_Type_contiguous(2*i_num_values, MPI_DOUBLE, &type);
+		MPI_Type_commit(&type);
+		return type;
+	}
+#endif
+
+
+
+public:
+
+
+
+	/**
+	 * From local rows [row][col] (with stride) to local columns [col][row]
+	 *
+	 * Collective operation with MPI
+	 */
+	void rowsToColumns(
+			const std::complex<double> *i_rows,
+			std::size_t i_row_stride,
+			std::complex<double> *o_columns
+	)	const
+	{
+#if SWEET_MPI
+		if (mpi_size > 1)
+		{
+			std::size_t send_size = local_row_size*num_cols;
+			std::size_t recv_size = num_rows*local_col_size;
+
+			std::complex<double> *send_buf = MemBlockAlloc::alloc< std::complex<double> >(send_size*sizeof(std::complex<double>));
+			std::complex<double> *recv_buf = MemBlockAlloc::alloc< std::complex<double> >(recv_size*sizeof(std::complex<double>));
+
+			std::vector<int> send_counts(mpi_size), send_displs(mpi_size);
+			std::vector<int> recv_counts(mpi_size), recv_displs(mpi_size);
+
+			// Send blocks of local rows, receive blocks of local columns
+			MPI_Datatype send_type = p_createBlockType(local_row_size);
+			MPI_Datatype recv_type = p_createBlockType(local_col_size);
+
+			for (int r = 0; r < mpi_size; r++)
+			{
+				send_counts[r] = col_size_ranks[r];
+				send_displs[r] = col_start_ranks[r];
+				recv_counts[r] = row_size_ranks[r];
+				recv_displs[r] = row_start_ranks[r];
+			}
+
+			// Block for rank r: [row][col of rank r]
+			SWEET_THREADING_SPACE_PARALLEL_FOR
+			for (int r = 0; r < mpi_size; r++)
+			{
+				std::complex<double> *dst = send_buf + local_row_size*col_start_ranks[r];
+				std::size_t col_start = col_start_ranks[r];
+				std::size_t col_size = col_size_ranks[r];
+
+				for (std::size_t row = 0; row < local_row_size; row++)
+					for (std::size_t col = 0; col < col_size; col++)
+						dst[row*col_size + col] = i_rows[row*i_row_stride + col_start + col];
+			}
+
+			MPI_Alltoallv(
+					send_buf, send_counts.data(), send_displs.data(), send_type,
+					recv_buf, recv_counts.data(), recv_displs.data(), recv_type,
+					mpi_comm
+				);
+
+			MPI_Type_free(&send_type);
+			MPI_Type_free(&recv_type);
+
+			// The received blocks form the array [row][local col]
+			SWEET_THREADING_SPACE_PARALLEL_FOR
+			for (std::size_t col = 0; col < local_col_size; col++)
+				for (std::size_t row = 0; row < num_rows; row++)
+					o_columns[col*num_rows + row] = recv_buf[row*local_col_size + col];
+
+			MemBlockAlloc::free(send_buf, send_size*sizeof(std::complex<double>));
+			MemBlockAlloc::free(recv_buf, recv_size*sizeof(std::complex<double>));
+			return;
+		}
+#endif
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (std::size_t col = 0; col < num_cols; col++)
+			for (std::size_t row = 0; row < num_rows; row++)
+				o_columns[col*num_rows + row] = i_rows[row*i_row_stride + col];
+	}
+
+
+
+	/**
+	 * From local columns [col][row] to local rows [row][col] (with stride)
+	 *
+	 * Entries of the rows beyond the number of columns are not modified.
+	 *
+	 * Collective operation with MPI
+	 */
+	void columnsToRows(
+			const std::complex<double> *i_columns,
+			std::complex<double> *o_rows,
+			std::size_t i_row_stride
+	)	const
+	{
+#if SWEET_MPI
+		if (mpi_size > 1)
+		{
+			std::size_t send_size = num_rows*local_col_size;
+			std::size_t recv_size = local_row_size*num_cols;
+
+			std::complex<double> *send_buf = MemBlockAlloc::alloc< std::complex<double> >(send_size*sizeof(std::complex<double>));
+			std::complex<double> *recv_buf = MemBlockAlloc::alloc< std::complex<double> >(recv_size*sizeof(std::complex<double>));
+
+			std::vector<int> send_counts(mpi_size), send_displs(mpi_size);
+			std::vector<int> recv_counts(mpi_size), recv_displs(mpi_size);
+
+			// Send blocks of local columns, receive blocks of local rows
+			MPI_Datatype send_type = p_createBlockType(local_col_size);
+			MPI_Datatype recv_type = p_createBlockType(local_row_size);
+
+			for (int r = 0; r < mpi_size; r++)
+			{
+				send_counts[r] = row_size_ranks[r];
+				send_displs[r] = row_start_ranks[r];
+				recv_counts[r] = col_size_ranks[r];
+				recv_displs[r] = col_start_ranks[r];
+			}
+
+			// The blocks for all ranks form the array [row][local col]
+			SWEET_THREADING_SPACE_PARALLEL_FOR
+			for (std::size_t row = 0; row < num_rows; row++)
+				for (std::size_t col = 0; col < local_col_size; col++)
+					send_buf[row*local_col_size + col] = i_columns[col*num_rows + row];
+
+			MPI_Alltoallv(
+					send_buf, send_counts.data(), send_displs.data(), send_type,
+					recv_buf, recv_counts.data(), recv_displs.data(), recv_type,
+					mpi_comm
+				);
+
+			MPI_Type_free(&send_type);
+			MPI_Type_free(&recv_type);
+
+			// Block from rank r: [row][col of rank r]
+			SWEET_THREADING_SPACE_PARALLEL_FOR
+			for (int r = 0; r < mpi_size; r++)
+			{
+				const std::complex<double> *src = recv_buf + local_row_size*col_start_ranks[r];
+				std::size_t col_start = col_start_ranks[r];
+				std::size_t col_size = col_size_ranks[r];
+
+				for (std::size_t row = 0; row < local_row_size; row++)
+					for (std::size_t col = 0; col < col_size; col++)
+						o_rows[row*i_row_stride + col_start + col] = src[row*col_size + col];
+			}
+
+			MemBlockAlloc::free(send_buf, send_size*sizeof(std::complex<double>));
+			MemBlockAlloc::free(recv_buf, recv_size*sizeof(std::complex<double>));
+			return;
+		}
+#endif
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (std::size_t row = 0; row < num_rows; row++)
+			for (std::size_t col = 0; col < num_cols; col++)
+				o_rows[row*i_row_stride + col] = i_columns[col*num_rows + row];
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_GLOBALTRANSPOSE_HPP_ */
@@ -0,0 +1,465 @@
+/*
+ * KernelCounters.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_KERNELCOUNTERS_HPP_
+#define SRC_INCLUDE_SWEET_KERNELCOUNTERS_HPP_
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#ifndef SWEET_KERNEL_COUNTERS
+#	define SWEET_KERNEL_COUNTERS 0
+#endif
+
+#if SWEET_KERNEL_COUNTERS
+#	include <unistd.h>
+#	include <sys/ioctl.h>
+#	include <sys/syscall.h>
+#	include <linux/perf_event.h>
+#	if SWEET_THREADING_SPACE || SWEET_THREADING_TIME_REXI
+#		include <omp.h>
+#	endif
+#endif
+
+
+
+/**
+ * Counters for FLOPs and memory traffic of core kernels
+ *
+ * Only available if compiled with --kernel-counters=enable
+ * (SWEET_KERNEL_COUNTERS=1), otherwise all regions are removed
+ * by the preprocessor.
+ *
+ * Each kernel region is annotated with an analytical model of
+ * the number of floating point operations and the compulsory
+ * memory traffic in bytes:
+ *
+ *   SWEET_KERNEL_COUNTER_REGION("plane_mul", N, 3*8*N);
+ *
+ * This allows computing the achieved GFLOP/s and GB/s as well as
+ * the arithmetic intensity for a roofline analysis
+ * (see mule_local/postprocessing/KernelCountersRoofline.py).
+ *
+ * Additionally, hardware counters (cycles, instructions and last level
+ * cache misses) are measured with perf_event_open for all threads of
+ * the space parallelization. The last level cache misses provide an
+ * estimate of the actual memory traffic. Hardware counters are only
+ * read for regions which are not nested and called outside of
+ * parallel regions. If perf_event_open is not available
+ * (e.g. due to /proc/sys/kernel/perf_event_paranoid), only the
+ * analytical model is used.
+ */
+class KernelCounters
+{
+public:
+	enum
+	{
+		HW_CYCLES = 0,
+		HW_INSTRUCTIONS,
+		HW_LLC_MISSES,
+		HW_NUM_EVENTS
+	};
+
+
+	struct Stats
+	{
+		std::string name;
+
+		std::size_t calls = 0;
+		double time = 0;
+
+		/// analytical model
+		double flops = 0;
+		double bytes = 0;
+
+		/// hardware counters (only for calls with hardware counters)
+		std::size_t hw_calls = 0;
+		double hw_time = 0;
+		uint64_t hw_values[HW_NUM_EVENTS] = {0, 0, 0};
+	};
+
+
+private:
+	std::mutex mutex;
+
+	std::vector<Stats> stats;
+
+	/// File descriptors of event group leaders, one per thread
+	std::vector<int> hw_group_fds;
+
+	/// File descriptors of all events
+	std::vector<int> hw_fds;
+
+	bool hw_available;
+
+
+public:
+	KernelCounters()	:
+		hw_available(false)
+	{
+	}
+
+
+	~KernelCounters()
+	{
+		shutdown();
+	}
+
+
+	static KernelCounters& getInstance()
+	{
+		static KernelCounters instance;
+		return instance;
+	}
+
+
+	bool isHardwareCountersAvailable()	const
+	{
+		return hw_available;
+	}
+
+
+#if SWEET_KERNEL_COUNTERS
+
+private:
+	static
+	int p_perf_event_open(
+			uint32_t i_config,
+			int i_group_fd
+	)
+	{
+		struct perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.size = sizeof(attr);
+		attr.config = i_config;
+		attr.disabled = (i_group_fd == -1 ? 1 : 0);
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_GROUP;
+
+		// Measure calling thread on any CPU
+		return syscall(__NR_perf_event_open, &attr, 0, -1, i_group_fd, 0);
+	}
+
+
+	/**
+	 * Open one group of events for the calling thread
+	 */
+	bool p_open_thread_counters(
+			int i_thread_id
+	)
+	{
+		static const uint32_t configs[HW_NUM_EVENTS] = {
+				PERF_COUNT_HW_CPU_CYCLES,
+				PERF_COUNT_HW_INSTRUCTIONS,
+				PERF_COUNT_HW_CACHE_MISSES
+		};
+
+		int leader = -1;
+		for (int e = 0; e < HW_NUM_EVENTS; e++)
+		{
+			int fd = p_perf_event_open(configs[e], leader);
+			if (fd == -1)
+				return false;
+
+			if (leader == -1)
+				leader = fd;
+
+			std::lock_guard<std::mutex> lock(mutex);
+			hw_fds.push_back(fd);
+		}
+
+		ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		hw_group_fds[i_thread_id] = leader;
+		return true;
+	}
+
+
+public:
+	/**
+	 * Open hardware counters for all threads of the space parallelization.
+	 *
+	 * Has to be called outside of parallel regions.
+	 */
+	void setup()
+	{
+		shutdown();
+
+		int num_threads = 1;
+#if SWEET_THREADING_SPACE
+		num_threads = omp_get_max_threads();
+#endif
+		hw_group_fds.resize(num_threads, -1);
+
+		bool success = true;
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel num_threads(num_threads) reduction(&&:success)
+		success = p_open_thread_counters(omp_get_thread_num());
+#else
+		success = p_open_thread_counters(0);
+#endif
+
+		if (!success)
+		{
+			std::cerr << "Warning: Failed to open hardware counters with perf_event_open, only analytical models are used for kernel counters" << std::endl;
+			shutdown();
+			return;
+		}
+
+		hw_available = true;
+	}
+
+
+	void shutdown()
+	{
+		for (std::size_t i = 0; i < hw_fds.size(); i++)
+			close(hw_fds[i]);
+
+		hw_fds.clear();
+		hw_group_fds.clear();
+		hw_available = false;
+	}
+
+
+	/**
+	 * Read sum of hardware counters of all threads
+	 */
+	void readHardwareCounters(
+			uint64_t o_values[HW_NUM_EVENTS]
+	)
+	{
+		for (int e = 0; e < HW_NUM_EVENTS; e++)
+			o_values[e] = 0;
+
+		// nr + values
+		uint64_t buffer[1+HW_NUM_EVENTS];
+
+		for (std::size_t i = 0; i < hw_group_fds.size(); i++)
+		{
+			if (read(hw_group_fds[i], buffer, sizeof(buffer)) != (ssize_t)sizeof(buffer))
+				continue;
+
+			for (int e = 0; e < HW_NUM_EVENTS; e++)
+				o_values[e] += buffer[1+e];
+		}
+	}
+
+
+#else
+
+public:
+	void setup()	{}
+	void shutdown()	{}
+
+#endif
+
+
+	/**
+	 * Return unique id of a kernel name
+	 */
+	int getKernelId(
+			const std::string &i_name
+	)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		for (std::size_t i = 0; i < stats.size(); i++)
+			if (stats[i].name == i_name)
+				return i;
+
+		stats.push_back(Stats());
+		stats.back().name = i_name;
+		return stats.size()-1;
+	}
+
+
+	/**
+	 * Accumulate measurements of one call of a kernel
+	 */
+	void add(
+			int i_kernel_id,
+			double i_time,
+			double i_flops,
+			double i_bytes,
+			const uint64_t *i_hw_values		///< nullptr if not available
+	)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		Stats &s = stats[i_kernel_id];
+		s.calls++;
+		s.time += i_time;
+		s.flops += i_flops;
+		s.bytes += i_bytes;
+
+		if (i_hw_values != nullptr)
+		{
+			s.hw_calls++;
+			s.hw_time += i_time;
+			for (int e = 0; e < HW_NUM_EVENTS; e++)
+				s.hw_values[e] += i_hw_values[e];
+		}
+	}
+
+
+	/**
+	 * Output measurements of all kernels
+	 *
+	 * The LLC bandwidth is estimated with a cache line size of 64 bytes.
+	 */
+	void output()
+	{
+#if SWEET_KERNEL_COUNTERS
+		std::lock_guard<std::mutex> lock(mutex);
+
+		std::cout << "[MULE] kernel_counters.hw_available: " << hw_available << std::endl;
+
+		for (std::size_t i = 0; i < stats.size(); i++)
+		{
+			const Stats &s = stats[i];
+			std::string prefix = "[MULE] kernel_counters." + s.name;
+
+			std::cout << prefix << ".calls: " << s.calls << std::endl;
+			std::cout << prefix << ".time: " << s.time << std::endl;
+			std::cout << prefix << ".flops: " << s.flops << std::endl;
+			std::cout << prefix << ".bytes: " << s.bytes << std::endl;
+
+			if (s.time > 0)
+			{
+				std::cout << prefix << ".gflops_per_s: " << s.flops/s.time*1e-9 << std::endl;
+				std::cout << prefix << ".gbytes_per_s: " << s.bytes/s.time*1e-9 << std::endl;
+			}
+
+			if (s.bytes > 0)
+				std::cout << prefix << ".arithmetic_intensity: " << s.flops/s.bytes << std::endl;
+
+			if (s.hw_calls > 0)
+			{
+				std::cout << prefix << ".hw_calls: " << s.hw_calls << std::endl;
+				std::cout << prefix << ".hw_cycles: " << s.hw_values[HW_CYCLES] << std::endl;
+				std::cout << prefix << ".hw_instructions: " << s.hw_values[HW_INSTRUCTIONS] << std::endl;
+				std::cout << prefix << ".hw_llc_misses: " << s.hw_values[HW_LLC_MISSES] << std::endl;
+
+				if (s.hw_values[HW_CYCLES] > 0)
+					std::cout << prefix << ".hw_ipc: " << (double)s.hw_values[HW_INSTRUCTIONS]/(double)s.hw_values[HW_CYCLES] << std::endl;
+
+				if (s.hw_time > 0)
+					std::cout << prefix << ".hw_llc_gbytes_per_s: " << (double)s.hw_values[HW_LLC_MISSES]*64.0/s.hw_time*1e-9 << std::endl;
+			}
+		}
+#endif
+	}
+};
+
+
+
+#if SWEET_KERNEL_COUNTERS
+
+/**
+ * Scoped region of a kernel
+ */
+class KernelCountersRegion
+{
+	typedef std::chrono::steady_clock Clock;
+
+	int kernel_id;
+	double flops;
+	double bytes;
+
+	bool use_hw;
+	uint64_t hw_start[KernelCounters::HW_NUM_EVENTS];
+
+	Clock::time_point start;
+
+	/// Nesting level of regions in this thread
+	static int& p_depth()
+	{
+		static thread_local int depth = 0;
+		return depth;
+	}
+
+public:
+	KernelCountersRegion(
+			int i_kernel_id,
+			double i_flops,
+			double i_bytes
+	)	:
+		kernel_id(i_kernel_id),
+		flops(i_flops),
+		bytes(i_bytes),
+		use_hw(false)
+	{
+		KernelCounters &kc = KernelCounters::getInstance();
+
+		use_hw = kc.isHardwareCountersAvailable() && p_depth() == 0;
+#if SWEET_THREADING_SPACE || SWEET_THREADING_TIME_REXI
+		use_hw = use_hw && !omp_in_parallel();
+#endif
+		p_depth()++;
+
+		if (use_hw)
+			kc.readHardwareCounters(hw_start);
+
+		start = Clock::now();
+	}
+
+
+	~KernelCountersRegion()
+	{
+		double time = std::chrono::duration<double>(Clock::now() - start).count();
+
+		KernelCounters &kc = KernelCounters::getInstance();
+
+		p_depth()--;
+
+		if (use_hw)
+		{
+			uint64_t hw_end[KernelCounters::HW_NUM_EVENTS];
+			kc.readHardwareCounters(hw_end);
+
+			for (int e = 0; e < KernelCounters::HW_NUM_EVENTS; e++)
+				hw_end[e] -= hw_start[e];
+
+			kc.add(kernel_id, time, flops, bytes, hw_end);
+		}
+		else
+		{
+			kc.add(kernel_id, time, flops, bytes, nullptr);
+		}
+	}
+};
+
+
+#define SWEET_KERNEL_COUNTERS_CONCAT_(a, b)	a##b
+#define SWEET_KERNEL_COUNTERS_CONCAT(a, b)	SWEET_KERNEL_COUNTERS_CONCAT_(a, b)
+
+/**
+ * Count kernel until the end of the current scope
+ */
+#define SWEET_KERNEL_COUNTER_REGION(name, flops, bytes)	\
+	static const int SWEET_KERNEL_COUNTERS_CONCAT(sweet_kernel_id_, __LINE__) = KernelCounters::getInstance().getKernelId(name);	\
+	KernelCountersRegion SWEET_KERNEL_COUNTERS_CONCAT(sweet_kernel_region_, __LINE__)(SWEET_KERNEL_COUNTERS_CONCAT(sweet_kernel_id_, __LINE__), (flops), (bytes))
+
+#else
+
+#define SWEET_KERNEL_COUNTER_REGION(name, flops, bytes)
+
+#endif
+
+
+#endif /* SRC_INCLUDE_SWEET_KERNELCOUNTERS_HPP_ */
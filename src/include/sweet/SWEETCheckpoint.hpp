@@ -0,0 +1,239 @@
+/*
+ * SWEETCheckpoint.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SWEETCHECKPOINT_HPP_
+#define SRC_INCLUDE_SWEET_SWEETCHECKPOINT_HPP_
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <sweet/SWEETDataContainer.hpp>
+#include <sweet/FatalError.hpp>
+
+
+
+/**
+ * Checkpoint with the full state of a simulation which is required
+ * to continue a simulation bit-for-bit identical after a restart.
+ *
+ * All entries are stored as raw copies in buffers which are independent
+ * of any SWEET data container. Therefore, a checkpoint can be written
+ * to disk by the BackgroundOutputWriter while the simulation continues.
+ *
+ * Data containers provide checkpoint_write() / checkpoint_read() to
+ * add their data to or load their data from a checkpoint.
+ * Time steppers with an internal state (e.g. data of previous
+ * time steps) provide methods with the same names.
+ *
+ * Checkpoints are stored in the SWEETDataContainer format
+ * and losslessly compressed if zlib is available.
+ */
+class SWEETCheckpoint
+{
+public:
+	struct Entry
+	{
+		std::string name;
+		SWEETDataContainer::Primitive primitive;
+		SWEETDataContainer::Space space;
+		SWEETDataContainer::DataType data_type;
+		int64_t resolution[4];
+		std::size_t num_elements;
+		std::vector<char> data;
+	};
+
+	std::vector<Entry> entries;
+
+	/// Simulation time at which the checkpoint was created
+	double time;
+
+
+public:
+	SWEETCheckpoint()	:
+		time(0)
+	{
+	}
+
+
+	void clear()
+	{
+		entries.clear();
+	}
+
+
+	/**
+	 * Add raw data to checkpoint. A copy of the data is created.
+	 */
+	void addData(
+			const std::string &i_name,
+			SWEETDataContainer::Primitive i_primitive,
+			SWEETDataContainer::Space i_space,
+			SWEETDataContainer::DataType i_data_type,
+			const int64_t i_resolution[4],
+			const void *i_data,
+			std::size_t i_num_elements
+	)
+	{
+		if (findEntry(i_name) != nullptr)
+			FatalError("SWEETCheckpoint: Entry '"+i_name+"' already exists");
+
+		entries.push_back(Entry());
+		Entry &e = entries.back();
+
+		e.name = i_name;
+		e.primitive = i_primitive;
+		e.space = i_space;
+		e.data_type = i_data_type;
+		for (int i = 0; i < 4; i++)
+			e.resolution[i] = i_resolution[i];
+		e.num_elements = i_num_elements;
+
+		std::size_t size = i_num_elements*SWEETDataContainer::getDataTypeSize(i_data_type);
+		e.data.resize(size);
+		std::memcpy(e.data.data(), i_data, size);
+	}
+
+
+	/**
+	 * Add a scalar value to the checkpoint
+	 */
+	void addScalar(
+			const std::string &i_name,
+			double i_value
+	)
+	{
+		int64_t res[4] = {1, 0, 0, 0};
+		addData(i_name, SWEETDataContainer::PRIMITIVE_SCALAR, SWEETDataContainer::SPACE_PHYSICAL, SWEETDataContainer::DATA_TYPE_FLOAT64, res, &i_value, 1);
+	}
+
+
+	const Entry* findEntry(
+			const std::string &i_name
+	)	const
+	{
+		for (std::size_t i = 0; i < entries.size(); i++)
+			if (entries[i].name == i_name)
+				return &entries[i];
+
+		return nullptr;
+	}
+
+
+	bool hasEntry(
+			const std::string &i_name
+	)	const
+	{
+		return findEntry(i_name) != nullptr;
+	}
+
+
+	/**
+	 * Return entry and check for matching properties
+	 */
+	const Entry& getEntry(
+			const std::string &i_name,
+			SWEETDataContainer::Primitive i_primitive,
+			SWEETDataContainer::DataType i_data_type,
+			std::size_t i_num_elements
+	)	const
+	{
+		const Entry *e = findEntry(i_name);
+
+		if (e == nullptr)
+			FatalError("SWEETCheckpoint: Entry '"+i_name+"' not found");
+
+		if (e->primitive != i_primitive || e->data_type != i_data_type)
+			FatalError("SWEETCheckpoint: Type of entry '"+i_name+"' doesn't match");
+
+		if (e->num_elements != i_num_elements)
+			FatalError("SWEETCheckpoint: Size of entry '"+i_name+"' doesn't match (different resolution?)");
+
+		return *e;
+	}
+
+
+	double getScalar(
+			const std::string &i_name
+	)	const
+	{
+		const Entry &e = getEntry(i_name, SWEETDataContainer::PRIMITIVE_SCALAR, SWEETDataContainer::DATA_TYPE_FLOAT64, 1);
+
+		double value;
+		std::memcpy(&value, e.data.data(), sizeof(double));
+		return value;
+	}
+
+
+	/**
+	 * Write checkpoint to file.
+	 *
+	 * The data is first written to a temporary file which is then renamed.
+	 * Hence, an existing checkpoint is not lost if the program is killed during writing.
+	 */
+	void writeFile(
+			const std::string &i_filename
+	)	const
+	{
+		std::string tmp_filename = i_filename+".tmp";
+
+		{
+			SWEETDataContainerWriter writer;
+			writer.open(tmp_filename);
+
+			for (std::size_t i = 0; i < entries.size(); i++)
+			{
+				const Entry &e = entries[i];
+				writer.appendRecord(e.name, time, e.primitive, e.space, e.data_type, e.resolution, e.data.data(), e.num_elements, SWEETCompression::getCheckpointCodec());
+			}
+		}
+
+		if (std::rename(tmp_filename.c_str(), i_filename.c_str()) != 0)
+			FatalError("SWEETCheckpoint: Failed to rename '"+tmp_filename+"' to '"+i_filename+"'");
+	}
+
+
+	/**
+	 * Load checkpoint from file
+	 */
+	void readFile(
+			const std::string &i_filename
+	)
+	{
+		clear();
+
+		SWEETDataContainerReader reader;
+		reader.open(i_filename);
+
+		for (std::size_t i = 0; i < reader.records.size(); i++)
+		{
+			const SWEETDataContainer::RecordHeader *r = reader.records[i];
+
+			if (findEntry(r->field_name) != nullptr)
+				FatalError(std::string("SWEETCheckpoint: Entry '")+r->field_name+"' already exists");
+
+			time = r->time;
+
+			entries.push_back(Entry());
+			Entry &e = entries.back();
+
+			e.name = r->field_name;
+			e.primitive = (SWEETDataContainer::Primitive)r->primitive;
+			e.space = (SWEETDataContainer::Space)r->space;
+			e.data_type = (SWEETDataContainer::DataType)r->data_type;
+			for (int j = 0; j < 4; j++)
+				e.resolution[j] = r->resolution[j];
+			e.num_elements = r->payload_num_elements;
+
+			e.data.resize(e.num_elements*SWEETDataContainer::getDataTypeSize(e.data_type));
+			reader.readPayload(i, e.data.data());
+		}
+	}
+};
+
+
+#endif /* SRC_INCLUDE_SWEET_SWEETCHECKPOINT_HPP_ */
@@ -0,0 +1,406 @@
+/*
+ * SWEETCompression.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SWEETCOMPRESSION_HPP_
+#define SRC_INCLUDE_SWEET_SWEETCOMPRESSION_HPP_
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <sweet/FatalError.hpp>
+
+#ifndef SWEET_ZLIB
+	#define SWEET_ZLIB	0
+#endif
+
+#if SWEET_ZLIB
+	#include <zlib.h>
+#endif
+
+
+
+/**
+ * Compression of raw payloads of double precision data
+ * (float64 or complex128 which is treated as two float64 values).
+ *
+ * Codecs:
+ *
+ *  - CODEC_SHUFFLE_DEFLATE (lossless):
+ *      Byte shuffling (first byte of all values, second byte of all values, ...)
+ *      followed by deflate. The shuffling groups the sign/exponent bytes
+ *      which are very similar for smooth fields and hence well compressible.
+ *
+ *  - CODEC_QUANTIZE_VARINT (error bounded lossy):
+ *      Each value x is quantized to q = round(x/(2*tol)) which guarantees
+ *      |x - 2*tol*q| <= tol. The integers are stored with a zigzag variable
+ *      length encoding (small values require only a few bytes).
+ *      The tolerance applies to the space the data is stored in
+ *      (physical values or real/imaginary parts of spectral coefficients).
+ *
+ *  - CODEC_QUANTIZE_VARINT_DEFLATE (error bounded lossy):
+ *      Same as before, followed by deflate.
+ *
+ * Deflate is only available if compiled with --zlib=enable.
+ *
+ * All functions only use the system allocator and are hence safe
+ * to be executed in the BackgroundOutputWriter thread.
+ */
+class SWEETCompression
+{
+public:
+	enum Codec
+	{
+		CODEC_NONE = 0,
+		CODEC_SHUFFLE_DEFLATE = 1,
+		CODEC_QUANTIZE_VARINT = 2,
+		CODEC_QUANTIZE_VARINT_DEFLATE = 3,
+	};
+
+
+	/**
+	 * Return codec for the compression modes which are available as program parameters
+	 */
+	static Codec getCodecFromString(
+			const std::string &i_mode		///< "none", "lossless" or "lossy"
+	)
+	{
+		if (i_mode == "none" || i_mode == "")
+			return CODEC_NONE;
+
+		if (i_mode == "lossless")
+		{
+#if SWEET_ZLIB
+			return CODEC_SHUFFLE_DEFLATE;
+#else
+			FatalError("SWEETCompression: Lossless compression requires compilation with --zlib=enable");
+#endif
+		}
+
+		if (i_mode == "lossy")
+		{
+#if SWEET_ZLIB
+			return CODEC_QUANTIZE_VARINT_DEFLATE;
+#else
+			return CODEC_QUANTIZE_VARINT;
+#endif
+		}
+
+		FatalError("SWEETCompression: Unknown compression mode '"+i_mode+"'");
+		return CODEC_NONE;
+	}
+
+
+	/**
+	 * Return codec which should be used for checkpoints (lossless if available)
+	 */
+	static Codec getCheckpointCodec()
+	{
+#if SWEET_ZLIB
+		return CODEC_SHUFFLE_DEFLATE;
+#else
+		return CODEC_NONE;
+#endif
+	}
+
+
+	static bool isLossy(
+			int i_codec
+	)
+	{
+		return i_codec == CODEC_QUANTIZE_VARINT || i_codec == CODEC_QUANTIZE_VARINT_DEFLATE;
+	}
+
+
+
+	/**
+	 * Byte shuffle: o_data[j*num_elements+i] = i_data[i*element_size+j]
+	 */
+	static void shuffle(
+			const void *i_data,
+			std::size_t i_num_elements,
+			std::size_t i_element_size,
+			void *o_data
+	)
+	{
+		const unsigned char *src = (const unsigned char*)i_data;
+		unsigned char *dst = (unsigned char*)o_data;
+
+		for (std::size_t i = 0; i < i_num_elements; i++)
+			for (std::size_t j = 0; j < i_element_size; j++)
+				dst[j*i_num_elements+i] = src[i*i_element_size+j];
+	}
+
+
+	/**
+	 * Inverse of shuffle()
+	 */
+	static void unshuffle(
+			const void *i_data,
+			std::size_t i_num_elements,
+			std::size_t i_element_size,
+			void *o_data
+	)
+	{
+		const unsigned char *src = (const unsigned char*)i_data;
+		unsigned char *dst = (unsigned char*)o_data;
+
+		for (std::size_t i = 0; i < i_num_elements; i++)
+			for (std::size_t j = 0; j < i_element_size; j++)
+				dst[i*i_element_size+j] = src[j*i_num_elements+i];
+	}
+
+
+
+	/**
+	 * Quantize values and store them with zigzag variable length encoding
+	 */
+	static void quantize_varint(
+			const double *i_data,
+			std::size_t i_num_values,
+			double i_tolerance,
+			std::vector<char> &o_buffer
+	)
+	{
+		if (i_tolerance <= 0)
+			FatalError("SWEETCompression: Tolerance for lossy compression must be positive");
+
+		double inv_step = 1.0/(2.0*i_tolerance);
+
+		o_buffer.clear();
+		o_buffer.reserve(i_num_values*2);
+
+		for (std::size_t i = 0; i < i_num_values; i++)
+		{
+			double q = std::round(i_data[i]*inv_step);
+
+			// Also catches NaN values
+			if (!(std::abs(q) < 4.0e18))
+				FatalError("SWEETCompression: Value can't be quantized (tolerance too small or invalid value)");
+
+			int64_t qi = (int64_t)q;
+			uint64_t z = ((uint64_t)qi << 1) ^ (uint64_t)(qi >> 63);
+
+			while (z >= 0x80)
+			{
+				o_buffer.push_back((char)((z & 0x7f) | 0x80));
+				z >>= 7;
+			}
+			o_buffer.push_back((char)z);
+		}
+	}
+
+
+	/**
+	 * Inverse of quantize_varint()
+	 */
+	static void dequantize_varint(
+			const char *i_buffer,
+			std::size_t i_buffer_size,
+			double i_tolerance,
+			double *o_data,
+			std::size_t i_num_values
+	)
+	{
+		double step = 2.0*i_tolerance;
+
+		std::size_t pos = 0;
+		for (std::size_t i = 0; i < i_num_values; i++)
+		{
+			uint64_t z = 0;
+			int shift = 0;
+
+			while (true)
+			{
+				if (pos >= i_buffer_size || shift > 63)
+					FatalError("SWEETCompression: Corrupted quantized data");
+
+				unsigned char b = (unsigned char)i_buffer[pos++];
+				z |= (uint64_t)(b & 0x7f) << shift;
+				shift += 7;
+
+				if ((b & 0x80) == 0)
+					break;
+			}
+
+			int64_t qi = (int64_t)(z >> 1) ^ -(int64_t)(z & 1);
+			o_data[i] = step*(double)qi;
+		}
+	}
+
+
+
+#if SWEET_ZLIB
+	static void deflate_data(
+			const void *i_data,
+			std::size_t i_size,
+			std::vector<char> &o_buffer
+	)
+	{
+		uLongf dst_size = compressBound(i_size);
+		o_buffer.resize(dst_size);
+
+		// Level 1: Fast compression since throughput is more important than ratio
+		if (compress2((Bytef*)o_buffer.data(), &dst_size, (const Bytef*)i_data, i_size, 1) != Z_OK)
+			FatalError("SWEETCompression: compress2 failed");
+
+		o_buffer.resize(dst_size);
+	}
+
+
+	static void inflate_data(
+			const void *i_data,
+			std::size_t i_size,
+			void *o_data,
+			std::size_t i_uncompressed_size
+	)
+	{
+		uLongf dst_size = i_uncompressed_size;
+
+		if (uncompress((Bytef*)o_data, &dst_size, (const Bytef*)i_data, i_size) != Z_OK || dst_size != i_uncompressed_size)
+			FatalError("SWEETCompression: uncompress failed");
+	}
+#endif
+
+
+
+	/**
+	 * Compress data
+	 */
+	static void compress(
+			Codec i_codec,
+			double i_tolerance,				///< tolerance for lossy codecs
+			const double *i_data,
+			std::size_t i_num_values,		///< number of double values (2 per complex value)
+			std::vector<char> &o_buffer
+	)
+	{
+		switch(i_codec)
+		{
+		case CODEC_NONE:
+			o_buffer.resize(i_num_values*sizeof(double));
+			std::memcpy(o_buffer.data(), i_data, o_buffer.size());
+			return;
+
+		case CODEC_QUANTIZE_VARINT:
+			quantize_varint(i_data, i_num_values, i_tolerance, o_buffer);
+			return;
+
+#if SWEET_ZLIB
+		case CODEC_SHUFFLE_DEFLATE:
+		{
+			std::vector<char> shuffled(i_num_values*sizeof(double));
+			shuffle(i_data, i_num_values, sizeof(double), shuffled.data());
+			deflate_data(shuffled.data(), shuffled.size(), o_buffer);
+			return;
+		}
+
+		case CODEC_QUANTIZE_VARINT_DEFLATE:
+		{
+			std::vector<char> quantized;
+			quantize_varint(i_data, i_num_values, i_tolerance, quantized);
+			deflate_data(quantized.data(), quantized.size(), o_buffer);
+			return;
+		}
+#endif
+
+		default:
+			break;
+		}
+
+		FatalError("SWEETCompression: Codec not supported (deflate requires compilation with --zlib=enable)");
+	}
+
+
+
+	/**
+	 * Decompress data
+	 */
+	static void decompress(
+			int i_codec,
+			double i_tolerance,
+			const void *i_buffer,
+			std::size_t i_buffer_size,
+			double *o_data,
+			std::size_t i_num_values
+	)
+	{
+		switch(i_codec)
+		{
+		case CODEC_NONE:
+			if (i_buffer_size != i_num_values*sizeof(double))
+				FatalError("SWEETCompression: Size mismatch of uncompressed data");
+
+			std::memcpy(o_data, i_buffer, i_buffer_size);
+			return;
+
+		case CODEC_QUANTIZE_VARINT:
+			dequantize_varint((const char*)i_buffer, i_buffer_size, i_tolerance, o_data, i_num_values);
+			return;
+
+#if SWEET_ZLIB
+		case CODEC_SHUFFLE_DEFLATE:
+		{
+			std::vector<char> shuffled(i_num_values*sizeof(double));
+			inflate_data(i_buffer, i_buffer_size, shuffled.data(), shuffled.size());
+			unshuffle(shuffled.data(), i_num_values, sizeof(double), o_data);
+			return;
+		}
+
+		case CODEC_QUANTIZE_VARINT_DEFLATE:
+		{
+			/*
+			 * Each value requires between 1 and 10 bytes.
+			 * Decompress in chunks to avoid storing the size of the varint stream.
+			 */
+			std::vector<char> quantized;
+
+			z_stream s;
+			std::memset(&s, 0, sizeof(s));
+			if (inflateInit(&s) != Z_OK)
+				FatalError("SWEETCompression: inflateInit failed");
+
+			s.next_in = (Bytef*)i_buffer;
+			s.avail_in = i_buffer_size;
+
+			int ret = Z_OK;
+			while (ret != Z_STREAM_END)
+			{
+				std::size_t old_size = quantized.size();
+				quantized.resize(old_size + i_num_values + 1024);
+
+				s.next_out = (Bytef*)(quantized.data() + old_size);
+				s.avail_out = quantized.size() - old_size;
+
+				ret = inflate(&s, Z_NO_FLUSH);
+
+				if (ret != Z_OK && ret != Z_STREAM_END)
+				{
+					inflateEnd(&s);
+					FatalError("SWEETCompression: inflate failed");
+				}
+
+				quantized.resize(quantized.size() - s.avail_out);
+			}
+			inflateEnd(&s);
+
+			dequantize_varint(quantized.data(), quantized.size(), i_tolerance, o_data, i_num_values);
+			return;
+		}
+#endif
+
+		default:
+			break;
+		}
+
+		FatalError("SWEETCompression: Codec not supported (deflate requires compilation with --zlib=enable)");
+	}
+};
+
+
+#endif /* SRC_INCLUDE_SWEET_SWEETCOMPRESSION_HPP_ */
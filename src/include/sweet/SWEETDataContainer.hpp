@@ -0,0 +1,538 @@
+/*
+ * SWEETDataContainer.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SWEETDATACONTAINER_HPP_
+#define SRC_INCLUDE_SWEET_SWEETDATACONTAINER_HPP_
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <complex>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sweet/FatalError.hpp>
+#include <sweet/SWEETCompression.hpp>
+
+
+
+/**
+ * Single self-describing binary container to store multiple fields
+ * for multiple time steps in one file.
+ *
+ * File layout (native byte order, all offsets in bytes from file start):
+ *
+ *   [FileHeader (64 bytes)]
+ *   [RecordHeader (192 bytes)][payload][zero padding to alignment]
+ *   [RecordHeader (192 bytes)][payload][zero padding to alignment]
+ *   ...
+ *
+ * Each record header and each payload starts at an offset which is a
+ * multiple of the alignment (64 bytes) given in the file header.
+ * This allows to directly use the payload of an mmap'ed file,
+ * e.g. with numpy.frombuffer() in Python without any copy operation.
+ *
+ * Records are only appended, hence a container can be reopened
+ * to add further time steps. The index of all records is reconstructed
+ * by the reader by following the record headers. An incompletely written
+ * record at the end of the file (e.g. due to a crash) is ignored.
+ *
+ * Payloads can be compressed (see SWEETCompression). Only uncompressed
+ * payloads can be directly accessed, compressed payloads have to be
+ * read with SWEETDataContainerReader::readPayload().
+ *
+ * See mule_local/postprocessing/SWEETDataContainer.py for the Python reader.
+ */
+class SWEETDataContainer
+{
+public:
+	enum Primitive
+	{
+		PRIMITIVE_SPHERE = 0,
+		PRIMITIVE_PLANE = 1,
+		PRIMITIVE_SCALAR = 2,
+	};
+
+	enum Space
+	{
+		SPACE_PHYSICAL = 0,
+		SPACE_SPECTRAL = 1,
+	};
+
+	enum DataType
+	{
+		DATA_TYPE_FLOAT64 = 0,
+		DATA_TYPE_COMPLEX128 = 1,
+	};
+
+	static const std::size_t alignment = 64;
+	static const uint32_t version = 1;
+	static const uint32_t byte_order_mark = 0x01020304;
+
+
+	struct FileHeader
+	{
+		char magic[8];					///< "SWEETDC" + '\0'
+		uint32_t version;				///< version of container format
+		uint32_t byte_order_mark;		///< 0x01020304 written in native byte order
+		uint64_t alignment;				///< alignment of record headers and payloads
+		uint64_t first_record_offset;	///< offset of first record header
+		uint8_t reserved[32];
+	};
+
+
+	struct RecordHeader
+	{
+		char magic[8];					///< "SWEETRC" + '\0'
+		char field_name[64];			///< name of field, '\0' terminated
+		double time;					///< simulation time
+		int32_t primitive;				///< see Primitive
+		int32_t space;					///< see Space
+		int32_t data_type;				///< see DataType
+		int32_t compression;			///< see SWEETCompression::Codec
+		int64_t resolution[4];			///< resolution, depending on primitive/space (unused entries are 0)
+		uint64_t payload_offset;		///< offset of payload
+		uint64_t payload_num_elements;	///< number of elements of data_type in payload
+		uint64_t payload_size;			///< size of (compressed) payload in bytes
+		uint64_t next_record_offset;	///< offset of next record header
+		double compression_tolerance;	///< tolerance of lossy compression
+		uint8_t reserved[24];
+	};
+
+
+	static std::size_t getDataTypeSize(
+			int i_data_type
+	)
+	{
+		switch(i_data_type)
+		{
+		case DATA_TYPE_FLOAT64:		return sizeof(double);
+		case DATA_TYPE_COMPLEX128:	return sizeof(std::complex<double>);
+		}
+
+		FatalError("SWEETDataContainer: Unknown data type");
+		return 0;
+	}
+
+
+	static uint64_t alignOffset(
+			uint64_t i_offset
+	)
+	{
+		return (i_offset + alignment - 1) / alignment * alignment;
+	}
+};
+
+
+
+/**
+ * Writer for containers
+ */
+class SWEETDataContainerWriter
+{
+	std::fstream file;
+
+	/// Offset at which next record is written
+	uint64_t next_offset;
+
+	std::string filename;
+
+public:
+	SWEETDataContainerWriter()	:
+		next_offset(0)
+	{
+		static_assert(sizeof(SWEETDataContainer::FileHeader) == 64, "Invalid size of file header");
+		static_assert(sizeof(SWEETDataContainer::RecordHeader) == 192, "Invalid size of record header");
+	}
+
+
+	~SWEETDataContainerWriter()
+	{
+		close();
+	}
+
+
+	/**
+	 * Open a container file
+	 */
+	void open(
+			const std::string &i_filename,
+			bool i_append = false			///< append records to existing container
+	)
+	{
+		close();
+
+		filename = i_filename;
+
+		if (i_append)
+		{
+			file.open(i_filename, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+
+			if (file.is_open())
+			{
+				SWEETDataContainer::FileHeader header;
+				file.read((char*)&header, sizeof(header));
+
+				if (!file || std::memcmp(header.magic, "SWEETDC", sizeof(header.magic)) != 0)
+					FatalError("SWEETDataContainerWriter: '"+i_filename+"' is not a SWEET data container");
+
+				if (header.byte_order_mark != SWEETDataContainer::byte_order_mark)
+					FatalError("SWEETDataContainerWriter: Byte order of '"+i_filename+"' doesn't match");
+
+				if (header.version != SWEETDataContainer::version)
+					FatalError("SWEETDataContainerWriter: Unsupported container version of '"+i_filename+"'");
+
+				/*
+				 * Search for end of last complete record
+				 */
+				file.seekg(0, std::ios_base::end);
+				uint64_t file_size = file.tellg();
+
+				next_offset = header.first_record_offset;
+				while (next_offset + sizeof(SWEETDataContainer::RecordHeader) <= file_size)
+				{
+					SWEETDataContainer::RecordHeader record;
+					file.seekg(next_offset);
+					file.read((char*)&record, sizeof(record));
+
+					if (!file || std::memcmp(record.magic, "SWEETRC", sizeof(record.magic)) != 0)
+						break;
+
+					if (record.payload_offset + record.payload_size > file_size)
+						break;
+
+					// Corrupt link to next record, treat as incomplete record
+					if (record.next_record_offset <= next_offset)
+						break;
+
+					next_offset = record.next_record_offset;
+				}
+
+				file.clear();
+				return;
+			}
+		}
+
+		file.open(i_filename, std::ios_base::in | std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+
+		if (!file.is_open())
+			FatalError("SWEETDataContainerWriter: Error while opening file '"+i_filename+"'");
+
+		SWEETDataContainer::FileHeader header;
+		std::memset(&header, 0, sizeof(header));
+		std::strcpy(header.magic, "SWEETDC");
+		header.version = SWEETDataContainer::version;
+		header.byte_order_mark = SWEETDataContainer::byte_order_mark;
+		header.alignment = SWEETDataContainer::alignment;
+		header.first_record_offset = SWEETDataContainer::alignOffset(sizeof(header));
+
+		file.write((const char*)&header, sizeof(header));
+
+		next_offset = header.first_record_offset;
+	}
+
+
+	bool isOpen()
+	{
+		return file.is_open();
+	}
+
+
+	const std::string& getFilename()
+	{
+		return filename;
+	}
+
+
+	/**
+	 * Append a new record to the container
+	 */
+	void appendRecord(
+			const std::string &i_field_name,	///< name of field, e.g. "prog_phi"
+			double i_time,						///< simulation time
+			SWEETDataContainer::Primitive i_primitive,
+			SWEETDataContainer::Space i_space,
+			SWEETDataContainer::DataType i_data_type,
+			const int64_t i_resolution[4],		///< resolution information (unused entries set to 0)
+			const void *i_data,					///< raw payload data
+			std::size_t i_num_elements,			///< number of elements of type i_data_type
+			SWEETCompression::Codec i_codec = SWEETCompression::CODEC_NONE,
+			double i_compression_tolerance = 0	///< tolerance for lossy compression
+	)
+	{
+		if (!file.is_open())
+			FatalError("SWEETDataContainerWriter: Container not opened");
+
+		SWEETDataContainer::RecordHeader record;
+		std::memset(&record, 0, sizeof(record));
+
+		if (i_field_name.size() >= sizeof(record.field_name))
+			FatalError("SWEETDataContainerWriter: Field name '"+i_field_name+"' too long");
+
+		std::strcpy(record.magic, "SWEETRC");
+		std::strcpy(record.field_name, i_field_name.c_str());
+		record.time = i_time;
+		record.primitive = i_primitive;
+		record.space = i_space;
+		record.data_type = i_data_type;
+
+		for (int i = 0; i < 4; i++)
+			record.resolution[i] = i_resolution[i];
+
+		record.compression = i_codec;
+		record.compression_tolerance = i_compression_tolerance;
+
+		std::size_t raw_size = i_num_elements*SWEETDataContainer::getDataTypeSize(i_data_type);
+
+		std::vector<char> compressed;
+		if (i_codec != SWEETCompression::CODEC_NONE)
+		{
+			SWEETCompression::compress(i_codec, i_compression_tolerance, (const double*)i_data, raw_size/sizeof(double), compressed);
+			i_data = compressed.data();
+			record.payload_size = compressed.size();
+		}
+		else
+		{
+			record.payload_size = raw_size;
+		}
+
+		record.payload_offset = SWEETDataContainer::alignOffset(next_offset + sizeof(record));
+		record.payload_num_elements = i_num_elements;
+		record.next_record_offset = SWEETDataContainer::alignOffset(record.payload_offset + record.payload_size);
+
+		/*
+		 * Write header, payload and padding
+		 */
+		static const char zeros[SWEETDataContainer::alignment] = {0};
+
+		file.seekp(next_offset);
+		file.write((const char*)&record, sizeof(record));
+		file.write(zeros, record.payload_offset - (next_offset + sizeof(record)));
+		file.write((const char*)i_data, record.payload_size);
+		file.write(zeros, record.next_record_offset - (record.payload_offset + record.payload_size));
+
+		if (!file)
+			FatalError("SWEETDataContainerWriter: Error while writing to '"+filename+"'");
+
+		// Make sure that the record is complete on disk before continuing
+		file.flush();
+
+		next_offset = record.next_record_offset;
+	}
+
+
+	void close()
+	{
+		if (file.is_open())
+			file.close();
+	}
+};
+
+
+
+/**
+ * Reader for containers based on mmap.
+ *
+ * The payloads can be directly accessed without any copy operation.
+ */
+class SWEETDataContainerReader
+{
+	int fd;
+	void *mmap_data;
+	std::size_t mmap_size;
+
+public:
+	/// Index of all records in the container
+	std::vector<const SWEETDataContainer::RecordHeader*> records;
+
+
+public:
+	SWEETDataContainerReader()	:
+		fd(-1),
+		mmap_data(nullptr),
+		mmap_size(0)
+	{
+	}
+
+
+	~SWEETDataContainerReader()
+	{
+		close();
+	}
+
+
+	void open(
+			const std::string &i_filename
+	)
+	{
+		close();
+
+		fd = ::open(i_filename.c_str(), O_RDONLY);
+		if (fd < 0)
+			FatalError("SWEETDataContainerReader: Error while opening file '"+i_filename+"'");
+
+		struct stat st;
+		if (fstat(fd, &st) != 0)
+			FatalError("SWEETDataContainerReader: fstat failed for '"+i_filename+"'");
+
+		mmap_size = st.st_size;
+
+		if (mmap_size < sizeof(SWEETDataContainer::FileHeader))
+			FatalError("SWEETDataContainerReader: File '"+i_filename+"' too small");
+
+		mmap_data = mmap(nullptr, mmap_size, PROT_READ, MAP_SHARED, fd, 0);
+		if (mmap_data == MAP_FAILED)
+		{
+			mmap_data = nullptr;
+			FatalError("SWEETDataContainerReader: mmap failed for '"+i_filename+"'");
+		}
+
+		const SWEETDataContainer::FileHeader *header = (const SWEETDataContainer::FileHeader*)mmap_data;
+
+		if (std::memcmp(header->magic, "SWEETDC", sizeof(header->magic)) != 0)
+			FatalError("SWEETDataContainerReader: '"+i_filename+"' is not a SWEET data container");
+
+		if (header->byte_order_mark != SWEETDataContainer::byte_order_mark)
+			FatalError("SWEETDataContainerReader: Byte order of '"+i_filename+"' doesn't match");
+
+		if (header->version != SWEETDataContainer::version)
+			FatalError("SWEETDataContainerReader: Unsupported container version");
+
+		/*
+		 * Setup index of all complete records
+		 */
+		uint64_t offset = header->first_record_offset;
+		while (offset + sizeof(SWEETDataContainer::RecordHeader) <= mmap_size)
+		{
+			const SWEETDataContainer::RecordHeader *record = (const SWEETDataContainer::RecordHeader*)((const char*)mmap_data + offset);
+
+			if (std::memcmp(record->magic, "SWEETRC", sizeof(record->magic)) != 0)
+				break;
+
+			if (record->payload_offset + record->payload_size > mmap_size)
+				break;
+
+			// Corrupt link to next record, treat as incomplete record
+			if (record->next_record_offset <= offset)
+				break;
+
+			records.push_back(record);
+			offset = record->next_record_offset;
+		}
+	}
+
+
+	void close()
+	{
+		records.clear();
+
+		if (mmap_data != nullptr)
+		{
+			munmap(mmap_data, mmap_size);
+			mmap_data = nullptr;
+			mmap_size = 0;
+		}
+
+		if (fd >= 0)
+		{
+			::close(fd);
+			fd = -1;
+		}
+	}
+
+
+	/**
+	 * Return index of record with given field name and time.
+	 *
+	 * Returns -1 if no such record exists.
+	 */
+	int findRecord(
+			const std::string &i_field_name,
+			double i_time,
+			double i_time_eps = 1e-10
+	)	const
+	{
+		for (std::size_t i = 0; i < records.size(); i++)
+		{
+			if (i_field_name != records[i]->field_name)
+				continue;
+
+			if (std::abs(records[i]->time - i_time) > i_time_eps)
+				continue;
+
+			return i;
+		}
+
+		return -1;
+	}
+
+
+	/**
+	 * Return untyped pointer to payload of a record
+	 */
+	const void* getRawPayload(
+			int i_record_id
+	)	const
+	{
+		if (records[i_record_id]->compression != SWEETCompression::CODEC_NONE)
+			FatalError("SWEETDataContainerReader: Payload is compressed, use readPayload()");
+
+		return (const char*)mmap_data + records[i_record_id]->payload_offset;
+	}
+
+
+	/**
+	 * Copy (and decompress) the payload of a record to o_data.
+	 *
+	 * o_data must provide space for payload_num_elements elements.
+	 */
+	void readPayload(
+			int i_record_id,
+			void *o_data
+	)	const
+	{
+		const SWEETDataContainer::RecordHeader *record = records[i_record_id];
+
+		std::size_t raw_size = record->payload_num_elements*SWEETDataContainer::getDataTypeSize(record->data_type);
+
+		SWEETCompression::decompress(
+				record->compression,
+				record->compression_tolerance,
+				(const char*)mmap_data + record->payload_offset,
+				record->payload_size,
+				(double*)o_data,
+				raw_size/sizeof(double)
+			);
+	}
+
+
+	/**
+	 * Return pointer to payload of a record
+	 */
+	template <typename T>
+	const T* getPayload(
+			int i_record_id
+	)	const
+	{
+		const SWEETDataContainer::RecordHeader *record = records[i_record_id];
+
+		if (sizeof(T) != SWEETDataContainer::getDataTypeSize(record->data_type))
+			FatalError("SWEETDataContainerReader: Data type mismatch");
+
+		if (record->compression != SWEETCompression::CODEC_NONE)
+			FatalError("SWEETDataContainerReader: Payload is compressed, use readPayload()");
+
+		return (const T*)((const char*)mmap_data + record->payload_offset);
+	}
+};
+
+
+#endif /* SRC_INCLUDE_SWEET_SWEETDATACONTAINER_HPP_ */
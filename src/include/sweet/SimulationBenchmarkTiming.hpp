@@ -5,6 +5,8 @@
  *      Author: Martin Schreiber
  */
 
+#ifndef SRC_INCLUDE_SWEET_SIMULATIONBENCHMARKTIMING_HPP_
+#define SRC_INCLUDE_SWEET_SIMULATIONBENCHMARKTIMING_HPP_
 
 
 #include <sweet/Stopwatch.hpp>
@@ -99,3 +101,6 @@ public:
 		reset();
 	}
 };
+
+
+#endif /* SRC_INCLUDE_SWEET_SIMULATIONBENCHMARKTIMING_HPP_ */
@@ -0,0 +1,652 @@
+/*
+ * SimulationProfiler.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SIMULATIONPROFILER_HPP_
+#define SRC_INCLUDE_SWEET_SIMULATIONPROFILER_HPP_
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <sweet/FatalError.hpp>
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
+
+
+
+/**
+ * Hierarchical profiler for scoped regions
+ *
+ * Usage:
+ *
+ *   {
+ *       SWEET_PROFILER_REGION("sht_backward");
+ *       ...
+ *   }
+ *
+ * Regions can be nested. The time and the number of calls is accumulated
+ * for each path of nested regions (e.g. "timestep/rexi/rexi_term").
+ *
+ * Each thread has its own tree of regions, hence no synchronization is
+ * required while measuring. Regions entered in OpenMP worker threads
+ * start a new tree in this thread. All trees are merged by their path
+ * for the output.
+ *
+ * The profiler is disabled by default and has to be activated at
+ * runtime (--profiler=1). If disabled, each region only costs a test
+ * of a boolean.
+ *
+ * Optionally, each call is recorded and written to a trace file in the
+ * Chrome trace format (JSON) which can be visualized as a flame chart,
+ * e.g. with chrome://tracing, Perfetto or speedscope.
+ * For MPI parallel runs, each rank writes its own trace file.
+ */
+class SimulationProfiler
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+private:
+	/// Node of region tree
+	struct Node
+	{
+		int region_id;
+		int parent;
+
+		double time;
+		std::size_t calls;
+
+		/// pairs of (region id, node id)
+		std::vector<std::pair<int,int>> children;
+	};
+
+
+	/// Entry of trace
+	struct TraceEvent
+	{
+		int region_id;
+		double start;		///< in microseconds since setup()
+		double duration;	///< in microseconds
+	};
+
+
+public:
+	/// Data of each thread, only accessed by this thread while measuring
+	struct ThreadData
+	{
+		int thread_id;
+		int current_node;
+		std::vector<Node> nodes;
+		std::vector<TraceEvent> events;
+		std::size_t dropped_events;
+	};
+
+
+private:
+	/// Is the profiler active?
+	bool active;
+
+	/// Record each call for the trace file
+	bool trace;
+
+	/// Max. number of trace events per thread
+	std::size_t max_trace_events;
+
+	std::string trace_file_name;
+
+	Clock::time_point time_start;
+
+	std::mutex mutex;
+
+	/// Names of regions
+	std::vector<std::string> region_names;
+
+	/// Data of all threads
+	std::vector<std::unique_ptr<ThreadData>> thread_data;
+
+	/// Generation counter to detect outdated thread-local pointers after reset()
+	int generation;
+
+
+public:
+	SimulationProfiler()	:
+		active(false),
+		trace(false),
+		max_trace_events(1 << 20),
+		time_start(Clock::now()),
+		generation(0)
+	{
+	}
+
+
+	static SimulationProfiler& getInstance()
+	{
+		static SimulationProfiler instance;
+		return instance;
+	}
+
+
+	void setup(
+			bool i_active,
+			const std::string &i_trace_file_name = "",
+			std::size_t i_max_trace_events = 1 << 20
+	)
+	{
+		reset();
+
+		active = i_active;
+		trace_file_name = i_trace_file_name;
+		trace = active && trace_file_name.size() > 0;
+		max_trace_events = i_max_trace_events;
+	}
+
+
+	inline
+	bool isActive()	const
+	{
+		return active;
+	}
+
+
+	/**
+	 * Remove all measurements
+	 *
+	 * This must not be called while regions are active.
+	 */
+	void reset()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		thread_data.clear();
+		generation++;
+		time_start = Clock::now();
+	}
+
+
+	/**
+	 * Return unique id of a region name
+	 *
+	 * This is typically only called once per region (see SWEET_PROFILER_REGION)
+	 */
+	int getRegionId(
+			const std::string &i_name
+	)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		for (std::size_t i = 0; i < region_names.size(); i++)
+			if (region_names[i] == i_name)
+				return i;
+
+		region_names.push_back(i_name);
+		return region_names.size()-1;
+	}
+
+
+	/**
+	 * Enter region in the calling thread
+	 */
+	inline
+	ThreadData* enter(
+			int i_region_id
+	)
+	{
+		ThreadData *td = p_getThreadData();
+
+		Node &current = td->nodes[td->current_node];
+
+		for (const std::pair<int,int> &c : current.children)
+		{
+			if (c.first == i_region_id)
+			{
+				td->current_node = c.second;
+				return td;
+			}
+		}
+
+		int node_id = td->nodes.size();
+		current.children.push_back(std::make_pair(i_region_id, node_id));
+
+		// Don't use 'current' after this line (reallocation)
+		td->nodes.push_back(Node{i_region_id, td->current_node, 0, 0, {}});
+		td->current_node = node_id;
+
+		return td;
+	}
+
+
+	/**
+	 * Leave region which was entered in the calling thread
+	 */
+	inline
+	void leave(
+			ThreadData *i_td,
+			const Clock::time_point &i_start
+	)
+	{
+		Clock::time_point end = Clock::now();
+
+		Node &node = i_td->nodes[i_td->current_node];
+
+		double seconds = std::chrono::duration<double>(end - i_start).count();
+		node.time += seconds;
+		node.calls++;
+
+		if (trace)
+		{
+			if (i_td->events.size() < max_trace_events)
+			{
+				double start = std::chrono::duration<double, std::micro>(i_start - time_start).count();
+				i_td->events.push_back(TraceEvent{node.region_id, start, seconds*1e6});
+			}
+			else
+			{
+				i_td->dropped_events++;
+			}
+		}
+
+		i_td->current_node = node.parent;
+	}
+
+
+
+private:
+	ThreadData* p_getThreadData()
+	{
+		static thread_local ThreadData *td = nullptr;
+		static thread_local int td_generation = -1;
+
+		if (td != nullptr && td_generation == generation)
+			return td;
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		ThreadData *new_td = new ThreadData;
+		new_td->thread_id = thread_data.size();
+		new_td->current_node = 0;
+		new_td->dropped_events = 0;
+
+		// root node
+		new_td->nodes.push_back(Node{-1, -1, 0, 0, {}});
+
+		thread_data.push_back(std::unique_ptr<ThreadData>(new_td));
+
+		td = new_td;
+		td_generation = generation;
+		return td;
+	}
+
+
+
+	static
+	int p_getMPIRank()
+	{
+#if SWEET_MPI
+		int initialized = 0;
+		MPI_Initialized(&initialized);
+
+		if (initialized)
+		{
+			int rank;
+			MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+			return rank;
+		}
+#endif
+		return 0;
+	}
+
+
+
+	static
+	int p_getMPISize()
+	{
+#if SWEET_MPI
+		int initialized = 0;
+		MPI_Initialized(&initialized);
+
+		if (initialized)
+		{
+			int size;
+			MPI_Comm_size(MPI_COMM_WORLD, &size);
+			return size;
+		}
+#endif
+		return 1;
+	}
+
+
+
+	/**
+	 * Accumulated values of all threads for one path
+	 */
+	struct PathValues
+	{
+		double time = 0;
+		double time_max_thread = 0;
+		std::size_t calls = 0;
+	};
+
+
+	void p_mergeThreadTree(
+			const ThreadData &i_td,
+			int i_node_id,
+			const std::string &i_path,
+			std::map<std::string, PathValues> &io_paths
+	)
+	{
+		const Node &node = i_td.nodes[i_node_id];
+
+		for (const std::pair<int,int> &c : node.children)
+		{
+			const Node &child = i_td.nodes[c.second];
+
+			std::string path = i_path.size() == 0 ? region_names[c.first] : i_path + "/" + region_names[c.first];
+
+			PathValues &v = io_paths[path];
+			v.time += child.time;
+			v.time_max_thread = std::max(v.time_max_thread, child.time);
+			v.calls += child.calls;
+
+			p_mergeThreadTree(i_td, c.second, path, io_paths);
+		}
+	}
+
+
+
+	/**
+	 * Values of one path reduced over all ranks
+	 */
+	struct RankValues
+	{
+		double time = 0;
+		double time_min_rank = 0;
+		double time_max_rank = 0;
+		double time_max_thread = 0;
+		std::size_t calls = 0;
+		int num_ranks = 0;		///< number of ranks which entered this path
+	};
+
+
+	/**
+	 * Reduce the values of all paths over all MPI ranks on rank 0
+	 *
+	 * Ranks can have different paths, hence the paths are gathered by
+	 * their names. Ranks without a path contribute a time of 0.
+	 *
+	 * Collective operation with MPI
+	 */
+	void p_reduceRanks(
+			const std::map<std::string, PathValues> &i_paths,
+			std::map<std::string, RankValues> &o_paths
+	)
+	{
+		int mpi_size = p_getMPISize();
+
+		if (mpi_size == 1)
+		{
+			for (std::map<std::string, PathValues>::const_iterator iter = i_paths.begin(); iter != i_paths.end(); iter++)
+			{
+				RankValues &v = o_paths[iter->first];
+				v.time = iter->second.time;
+				v.time_min_rank = iter->second.time;
+				v.time_max_rank = iter->second.time;
+				v.time_max_thread = iter->second.time_max_thread;
+				v.calls = iter->second.calls;
+				v.num_ranks = 1;
+			}
+			return;
+		}
+
+#if SWEET_MPI
+		int mpi_rank = p_getMPIRank();
+
+		/*
+		 * '\0' separated path names and (time, time_max_thread, calls) of each path
+		 */
+		std::vector<char> names;
+		std::vector<double> values;
+
+		for (std::map<std::string, PathValues>::const_iterator iter = i_paths.begin(); iter != i_paths.end(); iter++)
+		{
+			names.insert(names.end(), iter->first.begin(), iter->first.end());
+			names.push_back('\0');
+
+			values.push_back(iter->second.time);
+			values.push_back(iter->second.time_max_thread);
+			values.push_back(iter->second.calls);
+		}
+
+		int num_names = names.size();
+		int num_values = values.size();
+
+		std::vector<int> rank_num_names(mpi_size), rank_num_values(mpi_size);
+		MPI_Gather(&num_names, 1, MPI_INT, rank_num_names.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+		MPI_Gather(&num_values, 1, MPI_INT, rank_num_values.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+		std::vector<int> displ_names(mpi_size+1, 0), displ_values(mpi_size+1, 0);
+		for (int r = 0; r < mpi_size; r++)
+		{
+			displ_names[r+1] = displ_names[r] + rank_num_names[r];
+			displ_values[r+1] = displ_values[r] + rank_num_values[r];
+		}
+
+		std::vector<char> all_names(std::max(displ_names[mpi_size], 1));
+		std::vector<double> all_values(std::max(displ_values[mpi_size], 1));
+
+		MPI_Gatherv(names.data(), num_names, MPI_CHAR, all_names.data(), rank_num_names.data(), displ_names.data(), MPI_CHAR, 0, MPI_COMM_WORLD);
+		MPI_Gatherv(values.data(), num_values, MPI_DOUBLE, all_values.data(), rank_num_values.data(), displ_values.data(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+		if (mpi_rank != 0)
+			return;
+
+		for (int r = 0; r < mpi_size; r++)
+		{
+			const char *name = all_names.data() + displ_names[r];
+			const double *value = all_values.data() + displ_values[r];
+
+			for (int i = 0; i < rank_num_values[r]/3; i++)
+			{
+				std::string path(name);
+				name += path.size()+1;
+
+				double time = value[3*i+0];
+
+				RankValues &v = o_paths[path];
+				v.time_min_rank = (v.num_ranks == 0 ? time : std::min(v.time_min_rank, time));
+				v.time_max_rank = std::max(v.time_max_rank, time);
+				v.time += time;
+				v.time_max_thread = std::max(v.time_max_thread, value[3*i+1]);
+				v.calls += (std::size_t)value[3*i+2];
+				v.num_ranks++;
+			}
+		}
+
+		for (std::map<std::string, RankValues>::iterator iter = o_paths.begin(); iter != o_paths.end(); iter++)
+			if (iter->second.num_ranks < mpi_size)
+				iter->second.time_min_rank = 0;
+#endif
+	}
+
+
+
+public:
+	/**
+	 * Output accumulated values of all regions, reduced over all ranks
+	 *
+	 *   [MULE] profiler.[path].time: accumulated time of all threads and ranks
+	 *   [MULE] profiler.[path].time_min_rank: min. time of one rank
+	 *   [MULE] profiler.[path].time_max_rank: max. time of one rank
+	 *   [MULE] profiler.[path].time_mean_rank: mean time of the ranks
+	 *   [MULE] profiler.[path].time_max_thread: max. time of one thread
+	 *   [MULE] profiler.[path].calls: number of calls of all threads and ranks
+	 *
+	 * The reduced values are written by rank 0.
+	 * The trace file is written on all ranks.
+	 *
+	 * Collective operation with MPI
+	 */
+	void output()
+	{
+		if (!active)
+			return;
+
+		std::map<std::string, PathValues> paths;
+		std::size_t dropped_events = 0;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			for (std::size_t i = 0; i < thread_data.size(); i++)
+			{
+				p_mergeThreadTree(*thread_data[i], 0, "", paths);
+				dropped_events += thread_data[i]->dropped_events;
+			}
+		}
+
+		std::map<std::string, RankValues> rank_paths;
+		p_reduceRanks(paths, rank_paths);
+
+		if (p_getMPIRank() == 0)
+		{
+			int mpi_size = p_getMPISize();
+
+			for (std::map<std::string, RankValues>::const_iterator iter = rank_paths.begin(); iter != rank_paths.end(); iter++)
+			{
+				std::cout << "[MULE] profiler." << iter->first << ".time: " << iter->second.time << std::endl;
+				std::cout << "[MULE] profiler." << iter->first << ".time_min_rank: " << iter->second.time_min_rank << std::endl;
+				std::cout << "[MULE] profiler." << iter->first << ".time_max_rank: " << iter->second.time_max_rank << std::endl;
+				std::cout << "[MULE] profiler." << iter->first << ".time_mean_rank: " << iter->second.time/mpi_size << std::endl;
+				std::cout << "[MULE] profiler." << iter->first << ".time_max_thread: " << iter->second.time_max_thread << std::endl;
+				std::cout << "[MULE] profiler." << iter->first << ".calls: " << iter->second.calls << std::endl;
+			}
+		}
+
+		if (trace)
+		{
+			if (dropped_events > 0)
+				std::cerr << "Warning: Profiler dropped " << dropped_events << " trace events (limit of " << max_trace_events << " events per thread)" << std::endl;
+
+			writeTrace();
+		}
+	}
+
+
+
+	/**
+	 * Write all recorded calls in Chrome trace format
+	 */
+	void writeTrace()
+	{
+		int rank = p_getMPIRank();
+
+		std::string filename = trace_file_name;
+		if (p_getMPISize() > 1)
+		{
+			std::string suffix = "_rank" + std::to_string(rank);
+
+			std::size_t pos = filename.rfind(".json");
+			if (pos != std::string::npos && pos + 5 == filename.size())
+				filename.insert(pos, suffix);
+			else
+				filename += suffix;
+		}
+
+		std::ofstream file(filename);
+		if (!file.is_open())
+			FatalError("SimulationProfiler: Failed to open trace file '"+filename+"'");
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" << std::endl;
+
+		bool first = true;
+		for (std::size_t i = 0; i < thread_data.size(); i++)
+		{
+			const ThreadData &td = *thread_data[i];
+
+			// Sort by start time, so that parents are located before children
+			std::vector<TraceEvent> events = td.events;
+			std::sort(
+					events.begin(), events.end(),
+					[](const TraceEvent &a, const TraceEvent &b)
+					{
+						return a.start < b.start || (a.start == b.start && a.duration > b.duration);
+					}
+				);
+
+			for (const TraceEvent &e : events)
+			{
+				if (!first)
+					file << "," << std::endl;
+				first = false;
+
+				file << "{\"name\": \"" << region_names[e.region_id] << "\", \"ph\": \"X\"";
+				file << ", \"ts\": " << e.start << ", \"dur\": " << e.duration;
+				file << ", \"pid\": " << rank << ", \"tid\": " << td.thread_id << "}";
+			}
+		}
+
+		file << std::endl << "]}" << std::endl;
+	}
+};
+
+
+
+/**
+ * Scoped region of the profiler
+ */
+class SimulationProfilerRegion
+{
+	SimulationProfiler::ThreadData *td;
+	SimulationProfiler::Clock::time_point start;
+
+public:
+	inline
+	SimulationProfilerRegion(
+			int i_region_id
+	)	:
+		td(nullptr)
+	{
+		SimulationProfiler &profiler = SimulationProfiler::getInstance();
+
+		if (!profiler.isActive())
+			return;
+
+		td = profiler.enter(i_region_id);
+		start = SimulationProfiler::Clock::now();
+	}
+
+
+	inline
+	~SimulationProfilerRegion()
+	{
+		if (td != nullptr)
+			SimulationProfiler::getInstance().leave(td, start);
+	}
+};
+
+
+
+#define SWEET_PROFILER_CONCAT_(a, b)	a##b
+#define SWEET_PROFILER_CONCAT(a, b)	SWEET_PROFILER_CONCAT_(a, b)
+
+/**
+ * Measure the time until the end of the current scope
+ */
+#define SWEET_PROFILER_REGION(name)	\
+	static const int SWEET_PROFILER_CONCAT(sweet_profiler_region_id_, __LINE__) = SimulationProfiler::getInstance().getRegionId(name);	\
+	SimulationProfilerRegion SWEET_PROFILER_CONCAT(sweet_profiler_region_, __LINE__)(SWEET_PROFILER_CONCAT(sweet_profiler_region_id_, __LINE__))
+
+
+#endif /* SRC_INCLUDE_SWEET_SIMULATIONPROFILER_HPP_ */
@@ -17,6 +17,7 @@
 #include <sweet/sweetmath.hpp>
 #include <sweet/FatalError.hpp>
 #include <sweet/StringSplit.hpp>
+#include <sweet/SWEETCheckpoint.hpp>
 
 #ifndef SWEET_USE_SPHERE_SPECTRAL_SPACE
 #	define SWEET_USE_SPHERE_SPECTRAL_SPACE 1
@@ -152,9 +153,18 @@ public:
 		/// prefix of filename for outputConfig of data
 		std::string output_file_name = "";
 
-		/// output mode of variables
+		/// output mode of variables ("csv", "bin" or "container" to write all fields and time steps to a single file)
 		std::string output_file_mode = "default";
 
+		/// Max. number of pending output jobs processed by a background I/O thread (0: synchronous output)
+		int output_async_queue_size = 0;
+
+		/// compression of fields in output file mode 'container' ("none", "lossless" or "lossy")
+		std::string output_compression = "none";
+
+		/// max. absolute error of lossy compression (in the space the data is stored in)
+		double output_compression_tolerance = 0;
+
 		/// prefix of filename for outputConfig of data
 		double output_each_sim_seconds = -1;
 
@@ -169,6 +179,26 @@ public:
 		int output_floating_point_precision = -1;
 
 
+		/// filename of time series of in-situ diagnostics (computed each time step)
+		std::string insitu_diagnostics_file_name = "";
+
+		/// comma separated list of in-situ diagnostics
+		std::string insitu_diagnostics = "mass,energy,enstrophy";
+
+
+		/// filename to write checkpoints to
+		std::string checkpoint_file_name = "";
+
+		/// Simulation seconds between checkpoints (-1: only at the end of the simulation)
+		double checkpoint_each_sim_seconds = -1;
+
+		/// Simulation seconds for next checkpoint
+		double checkpoint_next_sim_seconds = 0;
+
+		/// filename of checkpoint to restart the simulation from
+		std::string checkpoint_restart_file_name = "";
+
+
 
 		void setup_initial_condition_filenames(
 				const std::string i_string
@@ -205,10 +235,18 @@ public:
 			std::cout << " + input_data_binary: " << initial_condition_input_data_binary << std::endl;
 			std::cout << " + output_file_name " << output_file_name << std::endl;
 			std::cout << " + output_file_mode " << output_file_mode << std::endl;
+			std::cout << " + output_async_queue_size " << output_async_queue_size << std::endl;
+			std::cout << " + output_compression " << output_compression << std::endl;
+			std::cout << " + output_compression_tolerance " << output_compression_tolerance << std::endl;
 			std::cout << " + output_each_sim_seconds: " << output_each_sim_seconds << std::endl;
 			std::cout << " + output_next_sim_seconds: " << output_next_sim_seconds << std::endl;
 			std::cout << " + output_time_scale: " << output_time_scale << std::endl;
 			std::cout << " + output_floating_point_precision: " << output_floating_point_precision << std::endl;
+			std::cout << " + insitu_diagnostics_file_name: " << insitu_diagnostics_file_name << std::endl;
+			std::cout << " + insitu_diagnostics: " << insitu_diagnostics << std::endl;
+			std::cout << " + checkpoint_file_name: " << checkpoint_file_name << std::endl;
+			std::cout << " + checkpoint_each_sim_seconds: " << checkpoint_each_sim_seconds << std::endl;
+			std::cout << " + checkpoint_restart_file_name: " << checkpoint_restart_file_name << std::endl;
 			std::cout << std::endl;
 		}
 	} iodata;
@@ -240,6 +278,9 @@ public:
 		/// Galewsky-benchmark specific: latitude coordinate
 		double benchmark_galewsky_phi2 = -1;
 
+		/// Directory to cache initial conditions of benchmarks, empty to disable caching
+		std::string initial_condition_cache_dir = "";
+
 
 		/// radius
 		double object_scale = 1;
@@ -291,6 +332,7 @@ public:
 			std::cout << " + benchmark_galewsky_umax: " << benchmark_galewsky_umax << std::endl;
 			std::cout << " + benchmark_galewsky_hamp: " << benchmark_galewsky_hamp << std::endl;
 			std::cout << " + benchmark_galewsky_phi2: " << benchmark_galewsky_phi2 << std::endl;
+			std::cout << " + initial_condition_cache_dir: " << initial_condition_cache_dir << std::endl;
 			std::cout << " + object_scale: " << object_scale << std::endl;
 			std::cout << " + object_coord_x: " << object_coord_x << std::endl;
 			std::cout << " + object_coord_y: " << object_coord_y << std::endl;
@@ -314,6 +356,7 @@ public:
 			std::cout << "	--initial-coord-x [float]		Same as -x" << std::endl;
 			std::cout << "	--initial-coord-y [float]		Same as -y" << std::endl;
 			std::cout << "	--advection-rotation-angle [float]	Rotation angle for e.g. advection test case" << std::endl;
+			std::cout << "	--initial-condition-cache-dir [string]	Directory to cache initial conditions of benchmarks (e.g. for ensembles), default: '' (disabled)" << std::endl;
 
 			std::cout << "" << std::endl;
 		}
@@ -467,6 +510,16 @@ public:
 		 */
 		bool space_grid_use_c_staggering = false;
 
+		/**
+		 * Distribute plane data over all MPI ranks (see PlaneDataConfigDistributed)
+		 */
+		bool space_plane_distributed = false;
+
+		/**
+		 * Distribute sphere data over all MPI ranks (see SphereData_ConfigDistributed)
+		 */
+		bool space_sphere_distributed = false;
+
 
 
 		/// Leapfrog: Robert Asselin filter
@@ -487,6 +540,9 @@ public:
 		/// Order of 2nd time stepping which might be used
 		int timestepping_order2 = -1;
 
+		/// Use low-storage (2N) variants of explicit Runge-Kutta methods
+		bool timestepping_rk_low_storage = false;
+
 
 		void outputConfig()
 		{
@@ -496,9 +552,12 @@ public:
 			std::cout << " + space_res_spectral: " << space_res_spectral[0] << " x " << space_res_spectral[1] << std::endl;
 			std::cout << " + space_use_spectral_basis_diffs: " << space_use_spectral_basis_diffs << std::endl;
 			std::cout << " + space_grid_use_c_staggering: " << space_grid_use_c_staggering << std::endl;
+			std::cout << " + space_plane_distributed: " << space_plane_distributed << std::endl;
+			std::cout << " + space_sphere_distributed: " << space_sphere_distributed << std::endl;
 			std::cout << " + timestepping_method: " << timestepping_method << std::endl;
 			std::cout << " + timestepping_order: " << timestepping_order << std::endl;
 			std::cout << " + timestepping_order2: " << timestepping_order2 << std::endl;
+			std::cout << " + timestepping_rk_low_storage: " << timestepping_rk_low_storage << std::endl;
 			std::cout << " + timestepping_leapfrog_robert_asselin_filter: " << timestepping_leapfrog_robert_asselin_filter << std::endl;
 			std::cout << " + timestepping_crank_nicolson_filter: " << timestepping_crank_nicolson_filter << std::endl;
 			std::cout << " + plane_dealiasing (compile time): " <<
@@ -516,6 +575,8 @@ public:
 			std::cout << "Discretization:" << std::endl;
 			std::cout << "  >Space:" << std::endl;
 			std::cout << "	--space-grid-use-c-staggering [0/1]	Use staggering" << std::endl;
+			std::cout << "	--space-plane-distributed [0/1]	Distribute plane data over all MPI ranks (requires MPI), default=0" << std::endl;
+			std::cout << "	--space-sphere-distributed [0/1]	Distribute sphere data over all MPI ranks (requires MPI), default=0" << std::endl;
 			std::cout << "	-N [res]		resolution in x and y direction, default=0" << std::endl;
 			std::cout << "	-n [resx]		resolution in x direction, default=0" << std::endl;
 			std::cout << "	-m [resy]		resolution in y direction, default=0" << std::endl;
@@ -533,12 +594,17 @@ public:
 			std::cout << "	--timestepping-method [string]	String of time stepping method" << std::endl;
 			std::cout << "	--timestepping-order [int]			Specify the order of the time stepping" << std::endl;
 			std::cout << "	--timestepping-order2 [int]			Specify the order of the time stepping" << std::endl;
+			std::cout << "	--timestepping-rk-low-storage [0/1]	Use low-storage (2N) explicit Runge-Kutta methods, default: 0" << std::endl;
 			std::cout << "	--leapfrog-robert-asselin-filter [0;1]		Damping parameter for Robert-Asselin filter" << std::endl;
 			std::cout << "	--normal-mode-analysis-generation [0;1;2;3]	Generate output data for normal mode analysis" << std::endl;
 			std::cout << "							0: don't generate" << std::endl;
 			std::cout << "							1: generate in physical space" << std::endl;
 			std::cout << "							2: generate in spectral space" << std::endl;
 			std::cout << "							3: generate in spectral space with complex matrix)" << std::endl;
+			std::cout << "	--normal-mode-analysis-batched [0;1;2]	Batched normal mode analysis for linear time steppers (spectral generations only)" << std::endl;
+			std::cout << "							0: one time step run per unit vector" << std::endl;
+			std::cout << "							1: excite decoupled modes at once, write operator blocks in binary format" << std::endl;
+			std::cout << "							2: 1 + compute eigenvalues of blocks (requires Eigen)" << std::endl;
 
 		}
 
@@ -574,6 +640,13 @@ public:
 			std::cout << " + use_nonlinear_only_visc: " << use_nonlinear_only_visc << std::endl;
 			std::cout << " + reuse_spectral_transformation_plans: " << reuse_spectral_transformation_plans << std::endl;
 			std::cout << " + normal_mode_analysis_generation: " << normal_mode_analysis_generation << std::endl;
+			std::cout << " + normal_mode_analysis_batched: " << normal_mode_analysis_batched << std::endl;
+			std::cout << " + implicit_operator_cache_size: " << implicit_operator_cache_size << std::endl;
+			std::cout << " + derived_transform_cache_size: " << derived_transform_cache_size << std::endl;
+			std::cout << " + profiler: " << profiler << std::endl;
+			std::cout << " + profiler_trace_file_name: " << profiler_trace_file_name << std::endl;
+			std::cout << " + ensemble_members: " << ensemble_members << std::endl;
+			std::cout << " + ensemble_perturbation: " << ensemble_perturbation << std::endl;
 			std::cout << std::endl;
 		}
 
@@ -611,6 +684,31 @@ public:
 		 */
 		int normal_mode_analysis_generation = 0;
 
+		/*
+		 * Batched normal mode analysis for linear time steppers:
+		 * Modes which are not coupled by the linear operator are excited at once
+		 * (see NormalModeAnalysisSphere and SWE_Plane_Normal_Modes)
+		 */
+		int normal_mode_analysis_batched = 0;
+
+		/// Max. number of factorized implicit operators (e.g. for different time step sizes) to keep, 0 disables caching
+		int implicit_operator_cache_size = 32;
+
+		/// Max. number of cached physical fields derived from spectral data per discretization (see SphereData_DerivedCache), 0 disables caching
+		int derived_transform_cache_size = 0;
+
+		/// Activate hierarchical profiler (see SimulationProfiler)
+		int profiler = 0;
+
+		/// Write trace of all profiled regions to this file (Chrome trace format)
+		std::string profiler_trace_file_name = "";
+
+		/// Number of ensemble members to run in one process, 0 disables the ensemble mode
+		int ensemble_members = 0;
+
+		/// Relative amplitude of random perturbations of the geopotential of ensemble members (member 0 is not perturbed)
+		double ensemble_perturbation = 0;
+
 	} misc;
 
 
@@ -638,6 +736,22 @@ public:
 		/// maximum simulation time to execute the simulation for
 		double max_simulation_time = std::numeric_limits<double>::infinity();
 
+		/// adaptive time step size control based on embedded Runge-Kutta methods
+		/// (current_timestep_size is used as initial time step size)
+		bool adaptive_timestepping = false;
+
+		/// absolute tolerance of scaled local error estimates
+		double adaptive_tolerance_abs = 1e-12;
+
+		/// relative tolerance of scaled local error estimates
+		double adaptive_tolerance_rel = 1e-6;
+
+		/// minimum time step size for adaptive time stepping
+		double adaptive_min_timestep_size = 0;
+
+		/// maximum time step size for adaptive time stepping
+		double adaptive_max_timestep_size = std::numeric_limits<double>::infinity();
+
 
 		void outputConfig()
 		{
@@ -649,6 +763,11 @@ public:
 			std::cout << " + current_simulation_time: " << current_simulation_time << std::endl;
 			std::cout << " + max_timesteps_nr: " << max_timesteps_nr << std::endl;
 			std::cout << " + max_simulation_time: " << max_simulation_time << std::endl;
+			std::cout << " + adaptive_timestepping: " << adaptive_timestepping << std::endl;
+			std::cout << " + adaptive_tolerance_abs: " << adaptive_tolerance_abs << std::endl;
+			std::cout << " + adaptive_tolerance_rel: " << adaptive_tolerance_rel << std::endl;
+			std::cout << " + adaptive_min_timestep_size: " << adaptive_min_timestep_size << std::endl;
+			std::cout << " + adaptive_max_timestep_size: " << adaptive_max_timestep_size << std::endl;
 			std::cout << std::endl;
 		}
 
@@ -678,6 +797,63 @@ public:
 	}
 
 
+	/**
+	 * Store time control and further state which is required to continue a simulation to checkpoint
+	 */
+	void checkpoint_write(
+			SWEETCheckpoint &io_checkpoint
+	)
+	{
+		io_checkpoint.time = timecontrol.current_simulation_time;
+
+		io_checkpoint.addScalar("timecontrol.current_timestep_nr", timecontrol.current_timestep_nr);
+		io_checkpoint.addScalar("timecontrol.current_timestep_size", timecontrol.current_timestep_size);
+		io_checkpoint.addScalar("timecontrol.current_simulation_time", timecontrol.current_simulation_time);
+
+		io_checkpoint.addScalar("iodata.output_next_sim_seconds", iodata.output_next_sim_seconds);
+		io_checkpoint.addScalar("iodata.checkpoint_next_sim_seconds", iodata.checkpoint_next_sim_seconds);
+
+		io_checkpoint.addScalar("benchmark.random_seed", benchmark.random_seed);
+
+		io_checkpoint.addScalar("diag.ref_total_mass", diag.ref_total_mass);
+		io_checkpoint.addScalar("diag.ref_kinetic_energy", diag.ref_kinetic_energy);
+		io_checkpoint.addScalar("diag.ref_potential_energy", diag.ref_potential_energy);
+		io_checkpoint.addScalar("diag.ref_total_energy", diag.ref_total_energy);
+		io_checkpoint.addScalar("diag.ref_total_potential_enstrophy", diag.ref_total_potential_enstrophy);
+	}
+
+
+
+	/**
+	 * Load time control and further state from checkpoint
+	 */
+	void checkpoint_read(
+			const SWEETCheckpoint &i_checkpoint
+	)
+	{
+		/*
+		 * The random number generator is only used during the setup of the benchmarks.
+		 * Hence, it's sufficient to make sure that the setup was done with the same seed.
+		 */
+		if (i_checkpoint.getScalar("benchmark.random_seed") != benchmark.random_seed)
+			FatalError("Checkpoint: Random seed doesn't match");
+
+		timecontrol.current_timestep_nr = i_checkpoint.getScalar("timecontrol.current_timestep_nr");
+		timecontrol.current_timestep_size = i_checkpoint.getScalar("timecontrol.current_timestep_size");
+		timecontrol.current_simulation_time = i_checkpoint.getScalar("timecontrol.current_simulation_time");
+
+		iodata.output_next_sim_seconds = i_checkpoint.getScalar("iodata.output_next_sim_seconds");
+		iodata.checkpoint_next_sim_seconds = i_checkpoint.getScalar("iodata.checkpoint_next_sim_seconds");
+
+		diag.ref_total_mass = i_checkpoint.getScalar("diag.ref_total_mass");
+		diag.ref_kinetic_energy = i_checkpoint.getScalar("diag.ref_kinetic_energy");
+		diag.ref_potential_energy = i_checkpoint.getScalar("diag.ref_potential_energy");
+		diag.ref_total_energy = i_checkpoint.getScalar("diag.ref_total_energy");
+		diag.ref_total_potential_enstrophy = i_checkpoint.getScalar("diag.ref_total_potential_enstrophy");
+	}
+
+
+
 	/**
 	 * update variables which are based on others
 	 */
@@ -857,6 +1033,9 @@ public:
         long_options[next_free_program_option] = {"benchmark-galewsky-phi2", required_argument, 0, 256+next_free_program_option};
         next_free_program_option++;
 
+        long_options[next_free_program_option] = {"initial-condition-cache-dir", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
 
         // MISC
         long_options[next_free_program_option] = {"output-file-name", required_argument, 0, 256+next_free_program_option};
@@ -865,6 +1044,30 @@ public:
         long_options[next_free_program_option] = {"output-file-mode", required_argument, 0, 256+next_free_program_option};
         next_free_program_option++;
 
+        long_options[next_free_program_option] = {"output-async-queue-size", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"output-compression", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"output-compression-tolerance", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"insitu-diagnostics-file-name", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"insitu-diagnostics", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"checkpoint-file-name", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"checkpoint-each-sim-seconds", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"checkpoint-restart-file-name", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
         long_options[next_free_program_option] = {"compute-errors", required_argument, 0, 256+next_free_program_option};
         next_free_program_option++;
 
@@ -883,6 +1086,27 @@ public:
         long_options[next_free_program_option] = {"normal-mode-analysis-generation", required_argument, 0, 256+next_free_program_option};
         next_free_program_option++;
 
+        long_options[next_free_program_option] = {"normal-mode-analysis-batched", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"implicit-operator-cache-size", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"derived-transform-cache-size", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"profiler", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"profiler-trace-file-name", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"ensemble-members", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"ensemble-perturbation", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
         // DISC
         long_options[next_free_program_option] = {"timestepping-method", required_argument, 0, 256+next_free_program_option};
         next_free_program_option++;
@@ -893,6 +1117,9 @@ public:
         long_options[next_free_program_option] = {"timestepping-order2", required_argument, 0, 256+next_free_program_option};
         next_free_program_option++;
 
+        long_options[next_free_program_option] = {"timestepping-rk-low-storage", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
         long_options[next_free_program_option] = {"leapfrog-robert-asselin-filter", required_argument, 0, 256+next_free_program_option};
         next_free_program_option++;
 
@@ -902,9 +1129,30 @@ public:
         long_options[next_free_program_option] = {"space-grid-use-c-staggering", required_argument, 0, 256+next_free_program_option};
         next_free_program_option++;
 
+        long_options[next_free_program_option] = {"space-plane-distributed", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"space-sphere-distributed", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
         long_options[next_free_program_option] = {"dt", required_argument, 0, 256+next_free_program_option};
         next_free_program_option++;
 
+        long_options[next_free_program_option] = {"adaptive-timestepping", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"adaptive-tolerance-abs", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"adaptive-tolerance-rel", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"adaptive-dt-min", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"adaptive-dt-max", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
 
 
 
@@ -1006,9 +1254,18 @@ public:
 					c++;		if (i == c)	{	benchmark.benchmark_galewsky_umax = atof(optarg);		continue;	}
 					c++;		if (i == c)	{	benchmark.benchmark_galewsky_hamp = atof(optarg);		continue;	}
 					c++;		if (i == c)	{	benchmark.benchmark_galewsky_phi2 = atof(optarg);		continue;	}
+					c++;		if (i == c)	{	benchmark.initial_condition_cache_dir = optarg;		continue;	}
 
 					c++;		if (i == c)	{	iodata.output_file_name = optarg;					continue;	}
 					c++;		if (i == c)	{	iodata.output_file_mode = optarg;					continue;	}
+					c++;		if (i == c)	{	iodata.output_async_queue_size = atoi(optarg);		continue;	}
+					c++;		if (i == c)	{	iodata.output_compression = optarg;					continue;	}
+					c++;		if (i == c)	{	iodata.output_compression_tolerance = atof(optarg);	continue;	}
+					c++;		if (i == c)	{	iodata.insitu_diagnostics_file_name = optarg;		continue;	}
+					c++;		if (i == c)	{	iodata.insitu_diagnostics = optarg;					continue;	}
+					c++;		if (i == c)	{	iodata.checkpoint_file_name = optarg;				continue;	}
+					c++;		if (i == c)	{	iodata.checkpoint_each_sim_seconds = atof(optarg);	continue;	}
+					c++;		if (i == c)	{	iodata.checkpoint_restart_file_name = optarg;		continue;	}
 
 					c++;		if (i == c)	{	misc.compute_errors = atoi(optarg);					continue;	}
 					c++;		if (i == c)	{	misc.instability_checks = atoi(optarg);				continue;	}
@@ -1016,15 +1273,30 @@ public:
 					c++;		if (i == c)	{	misc.use_nonlinear_only_visc = atoi(optarg);			continue;	}
 					c++;		if (i == c)	{	misc.reuse_spectral_transformation_plans = atoi(optarg);			continue;	}
 					c++;		if (i == c)	{	misc.normal_mode_analysis_generation = atoi(optarg);	continue;	}
+					c++;		if (i == c)	{	misc.normal_mode_analysis_batched = atoi(optarg);		continue;	}
+					c++;		if (i == c)	{	misc.implicit_operator_cache_size = atoi(optarg);		continue;	}
+					c++;		if (i == c)	{	misc.derived_transform_cache_size = atoi(optarg);		continue;	}
+					c++;		if (i == c)	{	misc.profiler = atoi(optarg);							continue;	}
+					c++;		if (i == c)	{	misc.profiler_trace_file_name = optarg;				continue;	}
+					c++;		if (i == c)	{	misc.ensemble_members = atoi(optarg);				continue;	}
+					c++;		if (i == c)	{	misc.ensemble_perturbation = atof(optarg);			continue;	}
 
 					c++;		if (i == c)	{	disc.timestepping_method = optarg;					continue;	}
 					c++;		if (i == c)	{	disc.timestepping_order = atoi(optarg);				continue;	}
 					c++;		if (i == c)	{	disc.timestepping_order2 = atoi(optarg);			continue;	}
+					c++;		if (i == c)	{	disc.timestepping_rk_low_storage = atoi(optarg);		continue;	}
 					c++;		if (i == c)	{	disc.timestepping_leapfrog_robert_asselin_filter = atof(optarg);	continue;	}
 					c++;		if (i == c)	{	disc.timestepping_crank_nicolson_filter = atof(optarg);			continue;	}
 					c++;		if (i == c)	{	disc.space_grid_use_c_staggering = atof(optarg);					continue;	}
+					c++;		if (i == c)	{	disc.space_plane_distributed = atoi(optarg);						continue;	}
+					c++;		if (i == c)	{	disc.space_sphere_distributed = atoi(optarg);						continue;	}
 
 					c++;		if (i == c)	{	timecontrol.current_timestep_size = atof(optarg);		continue;	}
+					c++;		if (i == c)	{	timecontrol.adaptive_timestepping = atoi(optarg);		continue;	}
+					c++;		if (i == c)	{	timecontrol.adaptive_tolerance_abs = atof(optarg);		continue;	}
+					c++;		if (i == c)	{	timecontrol.adaptive_tolerance_rel = atof(optarg);		continue;	}
+					c++;		if (i == c)	{	timecontrol.adaptive_min_timestep_size = atof(optarg);	continue;	}
+					c++;		if (i == c)	{	timecontrol.adaptive_max_timestep_size = atof(optarg);	continue;	}
 
 #if SWEET_PARAREAL
 					{
@@ -1232,6 +1504,12 @@ public:
 				std::cout << "Control:" << std::endl;
 				std::cout << "	-t [time]	maximum simulation time, default=-1 (infinity)" << std::endl;
 				std::cout << "	-T [stepnr]	maximum number of time steps, default=-1 (infinity)" << std::endl;
+				std::cout << "	--dt [time]	(initial) time step size" << std::endl;
+				std::cout << "	--adaptive-timestepping [0/1]	adaptive time step size control with embedded Runge-Kutta methods, default=0" << std::endl;
+				std::cout << "	--adaptive-tolerance-abs [float]	absolute tolerance of local error, default=1e-12" << std::endl;
+				std::cout << "	--adaptive-tolerance-rel [float]	relative tolerance of local error, default=1e-6" << std::endl;
+				std::cout << "	--adaptive-dt-min [time]	minimum time step size, default=0" << std::endl;
+				std::cout << "	--adaptive-dt-max [time]	maximum time step size, default=inf" << std::endl;
 				std::cout << "	-o [time]	time interval at which output should be written, (set to 0 for output at every time step), default=-1 (no output) " << std::endl;
 				std::cout << "" << std::endl;
 				std::cout << "Misc options:" << std::endl;
@@ -1240,6 +1518,14 @@ public:
 				std::cout << "	-G [0/1]			graphical user interface" << std::endl;
 				std::cout << "	-O [string]			string prefix for filename of output of simulation data (default output_%s_t%020.8f.csv)" << std::endl;
 				std::cout << "	-d [int]			accuracy of floating point output" << std::endl;
+				std::cout << "	--output-async-queue-size [int]	Max. number of pending output jobs written by background I/O thread, default=0 (synchronous output)" << std::endl;
+				std::cout << "	--output-compression [string]	Compression of fields in output file mode 'container': none, lossless, lossy, default=none" << std::endl;
+				std::cout << "	--output-compression-tolerance [float]	Max. absolute error per value for lossy compression" << std::endl;
+				std::cout << "	--insitu-diagnostics-file-name [string]	Write in-situ diagnostics of each time step to this file, default=\"\" (disabled)" << std::endl;
+				std::cout << "	--insitu-diagnostics [string]	Comma separated list of in-situ diagnostics (mass, energy, enstrophy, minmax, errors, ke_spectrum), default=mass,energy,enstrophy" << std::endl;
+				std::cout << "	--checkpoint-file-name [string]	Write checkpoints to this file, default=\"\" (no checkpoints)" << std::endl;
+				std::cout << "	--checkpoint-each-sim-seconds [float]	Simulation time between checkpoints, default=-1 (only at the end)" << std::endl;
+				std::cout << "	--checkpoint-restart-file-name [string]	Restart simulation from this checkpoint" << std::endl;
 				std::cout << "	-i [file0][;file1][;file3]...	string with filenames for initial conditions" << std::endl;
 				std::cout << "					specify BINARY; as first file name to read files as binary raw data" << std::endl;
 				std::cout << "	--compute-errors [int]          Compute errors when possible [1], default=0	" << std::endl;
@@ -1251,6 +1537,13 @@ public:
 				std::cout << "					1: compute optimized plans, use wisdom if available and store wisdom" << std::endl;
 				std::cout << "					2: use wisdom if available if not, trigger error if wisdom doesn't exist (not yet working for SHTNS)" << std::endl;
 				std::cout << "					default: -1 (quick mode)" << std::endl;
+				std::cout << "	--implicit-operator-cache-size [int]	Max. number of cached factorized implicit operators, default=32, 0: disabled" << std::endl;
+				std::cout << "	--derived-transform-cache-size [int]	Max. number of cached spectral-to-physical transformations per discretization, default=0 (disabled)" << std::endl;
+				std::cout << "	--profiler [int]	Activate hierarchical profiler of hot paths (0: disabled, 1: enabled), default=0" << std::endl;
+				std::cout << "	--profiler-trace-file-name [string]	Write all profiled regions to this file (Chrome trace format), default=\"\" (disabled)" << std::endl;
+				std::cout << "	--ensemble-members [int]	Run this number of ensemble members in one process, default=0 (disabled)" << std::endl;
+				std::cout << "					Output, checkpoint and diagnostics file names get a 'member_[id]_' prefix" << std::endl;
+				std::cout << "	--ensemble-perturbation [float]	Relative amplitude of random perturbations of the geopotential of members > 0, default=0" << std::endl;
 				std::cout << "" << std::endl;
 				rexi.outputProgParams();
 				swe_polvani.outputProgParams();
@@ -1300,6 +1593,8 @@ public:
 						iodata.output_file_name = "output_%s_t%020.8f.csv";
 					else if (iodata.output_file_mode == "bin")
 						iodata.output_file_name = "output_%s_t%020.8f.sweet";
+					else if (iodata.output_file_mode == "container")
+						iodata.output_file_name = "output.sweetdc";
 					else
 						FatalError("Unknown filemode '"+iodata.output_file_mode+"'");
 				}
@@ -0,0 +1,532 @@
+/*
+ * SplitComplex.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SPLITCOMPLEX_HPP_
+#define SRC_INCLUDE_SWEET_SPLITCOMPLEX_HPP_
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <sweet/MemBlockAlloc.hpp>
+#include <sweet/openmp_helper.hpp>
+
+
+
+/**
+ * Vectorizable complex kernels
+ *
+ * Without -ffast-math, the operators of std::complex<double> check for
+ * Inf/NaN results and call library functions (e.g. __muldc3, __divdc3)
+ * which prevents vectorization.
+ * These kernels only use plain real arithmetic on the real and
+ * imaginary parts, either for split arrays (SplitComplexArray) or
+ * directly on the interleaved data of PlaneDataComplex and
+ * SphereData_SpectralComplex.
+ *
+ * All kernels support in-place operations (output identical to an input).
+ * They are not parallelized with threads.
+ */
+class SplitComplexKernels
+{
+	typedef std::complex<double> cplx;
+
+public:
+	/// Number of elements per block of for_blocks()
+	static const std::size_t block_size = 256;
+
+
+	/**
+	 * Call i_lambda(idx, n) for all blocks [idx, idx+n) of an array
+	 * (parallelized over the blocks)
+	 */
+	template <typename T_Lambda>
+	static
+	void for_blocks(
+			std::size_t i_size,
+			T_Lambda i_lambda
+	)
+	{
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (std::size_t idx = 0; idx < i_size; idx += block_size)
+			i_lambda(idx, (i_size-idx < block_size ? i_size-idx : (std::size_t)block_size));
+	}
+
+
+	/*
+	 * Kernels for split data
+	 */
+
+	/**
+	 * o = a*b
+	 */
+	static
+	void mul(
+			std::size_t i_n,
+			const double *i_a_re, const double *i_a_im,
+			const double *i_b_re, const double *i_b_im,
+			double *o_re, double *o_im
+	)
+	{
+		SWEET_OMP_SIMD
+		for (std::size_t i = 0; i < i_n; i++)
+		{
+			double re = i_a_re[i]*i_b_re[i] - i_a_im[i]*i_b_im[i];
+			double im = i_a_re[i]*i_b_im[i] + i_a_im[i]*i_b_re[i];
+			o_re[i] = re;
+			o_im[i] = im;
+		}
+	}
+
+
+	/**
+	 * o = a*s
+	 */
+	static
+	void mul_scalar(
+			std::size_t i_n,
+			const double *i_a_re, const double *i_a_im,
+			const cplx &i_s,
+			double *o_re, double *o_im
+	)
+	{
+		double s_re = i_s.real();
+		double s_im = i_s.imag();
+
+		SWEET_OMP_SIMD
+		for (std::size_t i = 0; i < i_n; i++)
+		{
+			double re = i_a_re[i]*s_re - i_a_im[i]*s_im;
+			double im = i_a_re[i]*s_im + i_a_im[i]*s_re;
+			o_re[i] = re;
+			o_im[i] = im;
+		}
+	}
+
+
+	/**
+	 * o = a/b for a single element
+	 *
+	 * o = 0 for b = 0, which is the convention of the std::complex code
+	 * paths of PlaneDataComplex::spectral_div_element_wise() and
+	 * PlaneOperatorsComplex::helmholtz_inverse().
+	 *
+	 * Smith's algorithm divides by the larger component of b first,
+	 * hence there's no under-/overflow of |b|^2 for tiny or huge b.
+	 * The branches are written as selects which can be vectorized.
+	 * NaN in a or b results in NaN (except for b = 0).
+	 * Unlike std::complex, b with infinite real and imaginary parts
+	 * also results in NaN.
+	 */
+	static inline
+	void div_element(
+			double i_a_re, double i_a_im,
+			double i_b_re, double i_b_im,
+			double &o_re, double &o_im
+	)
+	{
+		bool re_larger = std::abs(i_b_re) >= std::abs(i_b_im);
+
+		double p = (re_larger ? i_b_re : i_b_im);
+		double q = (re_larger ? i_b_im : i_b_re);
+
+		double r = q/p;
+		double inv_den = 1.0/(p + q*r);
+
+		double re = (re_larger ? i_a_re + i_a_im*r : i_a_re*r + i_a_im)*inv_den;
+		double im = (re_larger ? i_a_im - i_a_re*r : i_a_im*r - i_a_re)*inv_den;
+
+		// p is only zero for b = 0
+		re = (p == 0.0 ? 0.0 : re);
+		im = (p == 0.0 ? 0.0 : im);
+
+		o_re = re;
+		o_im = im;
+	}
+
+
+	/**
+	 * o = a/b and o = 0 for b = 0 (see div_element())
+	 */
+	static
+	void div(
+			std::size_t i_n,
+			const double *i_a_re, const double *i_a_im,
+			const double *i_b_re, const double *i_b_im,
+			double *o_re, double *o_im
+	)
+	{
+		SWEET_OMP_SIMD
+		for (std::size_t i = 0; i < i_n; i++)
+			div_element(i_a_re[i], i_a_im[i], i_b_re[i], i_b_im[i], o_re[i], o_im[i]);
+	}
+
+
+	/**
+	 * y += alpha*x
+	 */
+	static
+	void axpy(
+			std::size_t i_n,
+			const cplx &i_alpha,
+			const double *i_x_re, const double *i_x_im,
+			double *io_y_re, double *io_y_im
+	)
+	{
+		double a_re = i_alpha.real();
+		double a_im = i_alpha.imag();
+
+		SWEET_OMP_SIMD
+		for (std::size_t i = 0; i < i_n; i++)
+		{
+			io_y_re[i] += a_re*i_x_re[i] - a_im*i_x_im[i];
+			io_y_im[i] += a_re*i_x_im[i] + a_im*i_x_re[i];
+		}
+	}
+
+
+	/**
+	 * o[i] = 0.5*(a[i] + conj(b[-i]))
+	 *
+	 * With b pointing to the mode -k of a, this computes the Fourier modes
+	 * of the real part of the data. The modes b are accessed in reversed order.
+	 * The output must not overlap with b.
+	 */
+	static
+	void conj_fold(
+			std::size_t i_n,
+			const double *i_a_re, const double *i_a_im,
+			const double *i_b_re, const double *i_b_im,
+			double *o_re, double *o_im
+	)
+	{
+		SWEET_OMP_SIMD
+		for (std::size_t i = 0; i < i_n; i++)
+		{
+			o_re[i] = 0.5*(i_a_re[i] + i_b_re[-(std::ptrdiff_t)i]);
+			o_im[i] = 0.5*(i_a_im[i] - i_b_im[-(std::ptrdiff_t)i]);
+		}
+	}
+
+
+
+	/*
+	 * Kernels for interleaved data
+	 *
+	 * These use the same real arithmetic directly on the interleaved
+	 * real and imaginary parts. Converting blocks of the data to split
+	 * arrays first turned out to be slower than std::complex for mul and
+	 * conj_fold and slower than this for all kernels
+	 * (see test_split_complex).
+	 */
+
+	/**
+	 * o = a*b
+	 */
+	static
+	void mul(
+			std::size_t i_n,
+			const cplx *i_a,
+			const cplx *i_b,
+			cplx *o
+	)
+	{
+		const double *a = reinterpret_cast<const double*>(i_a);
+		const double *b = reinterpret_cast<const double*>(i_b);
+		double *d = reinterpret_cast<double*>(o);
+
+		SWEET_OMP_SIMD
+		for (std::size_t i = 0; i < i_n; i++)
+		{
+			double re = a[2*i]*b[2*i] - a[2*i+1]*b[2*i+1];
+			double im = a[2*i]*b[2*i+1] + a[2*i+1]*b[2*i];
+			d[2*i] = re;
+			d[2*i+1] = im;
+		}
+	}
+
+
+	/**
+	 * o = a*s
+	 */
+	static
+	void mul_scalar(
+			std::size_t i_n,
+			const cplx *i_a,
+			const cplx &i_s,
+			cplx *o
+	)
+	{
+		const double *a = reinterpret_cast<const double*>(i_a);
+		double *d = reinterpret_cast<double*>(o);
+
+		double s_re = i_s.real();
+		double s_im = i_s.imag();
+
+		SWEET_OMP_SIMD
+		for (std::size_t i = 0; i < i_n; i++)
+		{
+			double re = a[2*i]*s_re - a[2*i+1]*s_im;
+			double im = a[2*i]*s_im + a[2*i+1]*s_re;
+			d[2*i] = re;
+			d[2*i+1] = im;
+		}
+	}
+
+
+	/**
+	 * o = a/b and o = 0 for b = 0 (see div_element())
+	 */
+	static
+	void div(
+			std::size_t i_n,
+			const cplx *i_a,
+			const cplx *i_b,
+			cplx *o
+	)
+	{
+		const double *a = reinterpret_cast<const double*>(i_a);
+		const double *b = reinterpret_cast<const double*>(i_b);
+		double *d = reinterpret_cast<double*>(o);
+
+		SWEET_OMP_SIMD
+		for (std::size_t i = 0; i < i_n; i++)
+			div_element(a[2*i], a[2*i+1], b[2*i], b[2*i+1], d[2*i], d[2*i+1]);
+	}
+
+
+	/**
+	 * y += alpha*x
+	 */
+	static
+	void axpy(
+			std::size_t i_n,
+			const cplx &i_alpha,
+			const cplx *i_x,
+			cplx *io_y
+	)
+	{
+		const double *x = reinterpret_cast<const double*>(i_x);
+		double *y = reinterpret_cast<double*>(io_y);
+
+		double a_re = i_alpha.real();
+		double a_im = i_alpha.imag();
+
+		SWEET_OMP_SIMD
+		for (std::size_t i = 0; i < i_n; i++)
+		{
+			double re = y[2*i] + a_re*x[2*i] - a_im*x[2*i+1];
+			double im = y[2*i+1] + a_re*x[2*i+1] + a_im*x[2*i];
+			y[2*i] = re;
+			y[2*i+1] = im;
+		}
+	}
+
+
+	/**
+	 * y += alpha*x with interleaved x and split y
+	 *
+	 * This is the update of sums which are stored in a SplitComplexArray.
+	 */
+	static
+	void axpy(
+			std::size_t i_n,
+			const cplx &i_alpha,
+			const cplx *i_x,
+			double *io_y_re, double *io_y_im
+	)
+	{
+		const double *x = reinterpret_cast<const double*>(i_x);
+
+		double a_re = i_alpha.real();
+		double a_im = i_alpha.imag();
+
+		SWEET_OMP_SIMD
+		for (std::size_t i = 0; i < i_n; i++)
+		{
+			io_y_re[i] += a_re*x[2*i] - a_im*x[2*i+1];
+			io_y_im[i] += a_re*x[2*i+1] + a_im*x[2*i];
+		}
+	}
+
+
+	/**
+	 * o[i] = 0.5*(a[i] + conj(b[-i]))
+	 *
+	 * See conj_fold() for split data
+	 */
+	static
+	void conj_fold(
+			std::size_t i_n,
+			const cplx *i_a,
+			const cplx *i_b,
+			cplx *o
+	)
+	{
+		const double *a = reinterpret_cast<const double*>(i_a);
+		const double *b = reinterpret_cast<const double*>(i_b);
+		double *d = reinterpret_cast<double*>(o);
+
+		SWEET_OMP_SIMD
+		for (std::size_t i = 0; i < i_n; i++)
+		{
+			d[2*i] = 0.5*(a[2*i] + b[-2*(std::ptrdiff_t)i]);
+			d[2*i+1] = 0.5*(a[2*i+1] - b[-2*(std::ptrdiff_t)i+1]);
+		}
+	}
+};
+
+
+/**
+ * Complex-valued array with split real and imaginary parts (SoA layout)
+ *
+ * This is used for sums which are updated many times, e.g. the sum over
+ * the REXI terms. Interleaved data is only converted at the boundaries
+ * with axpy() and storeInterleaved().
+ */
+class SplitComplexArray
+{
+public:
+	std::size_t number_of_elements;
+
+	double *real;
+	double *imag;
+
+
+public:
+	SplitComplexArray()	:
+		number_of_elements(0),
+		real(nullptr),
+		imag(nullptr)
+	{
+	}
+
+
+	SplitComplexArray(
+			std::size_t i_number_of_elements
+	)	:
+		number_of_elements(0),
+		real(nullptr),
+		imag(nullptr)
+	{
+		setup(i_number_of_elements);
+	}
+
+
+	SplitComplexArray(
+			const SplitComplexArray &i_data
+	)	:
+		number_of_elements(0),
+		real(nullptr),
+		imag(nullptr)
+	{
+		setup(i_data.number_of_elements);
+		std::copy(i_data.real, i_data.real+number_of_elements, real);
+		std::copy(i_data.imag, i_data.imag+number_of_elements, imag);
+	}
+
+
+	~SplitComplexArray()
+	{
+		cleanup();
+	}
+
+
+	SplitComplexArray& operator=(
+			const SplitComplexArray &i_data
+	)
+	{
+		if (this == &i_data)
+			return *this;
+
+		setup(i_data.number_of_elements);
+		std::copy(i_data.real, i_data.real+number_of_elements, real);
+		std::copy(i_data.imag, i_data.imag+number_of_elements, imag);
+		return *this;
+	}
+
+
+	void setup(
+			std::size_t i_number_of_elements
+	)
+	{
+		if (number_of_elements == i_number_of_elements)
+			return;
+
+		cleanup();
+
+		number_of_elements = i_number_of_elements;
+		real = MemBlockAlloc::alloc<double>(number_of_elements*sizeof(double));
+		imag = MemBlockAlloc::alloc<double>(number_of_elements*sizeof(double));
+	}
+
+
+	void cleanup()
+	{
+		if (real == nullptr)
+			return;
+
+		MemBlockAlloc::free(real, number_of_elements*sizeof(double));
+		MemBlockAlloc::free(imag, number_of_elements*sizeof(double));
+
+		number_of_elements = 0;
+		real = nullptr;
+		imag = nullptr;
+	}
+
+
+	void set_zero()
+	{
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (std::size_t i = 0; i < number_of_elements; i++)
+		{
+			real[i] = 0;
+			imag[i] = 0;
+		}
+	}
+
+
+	/**
+	 * this += alpha*x with interleaved complex data x
+	 */
+	void axpy(
+			const std::complex<double> &i_alpha,
+			const std::complex<double> *i_x
+	)
+	{
+		SplitComplexKernels::for_blocks(
+			number_of_elements,
+			[&](std::size_t idx, std::size_t n)
+			{
+				SplitComplexKernels::axpy(n, i_alpha, &i_x[idx], &real[idx], &imag[idx]);
+			}
+		);
+	}
+
+
+	/**
+	 * Convert to interleaved complex data
+	 */
+	void storeInterleaved(
+			std::complex<double> *o_data
+	)	const
+	{
+		double *data = reinterpret_cast<double*>(o_data);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (std::size_t i = 0; i < number_of_elements; i++)
+		{
+			data[2*i] = real[i];
+			data[2*i+1] = imag[i];
+		}
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_SPLITCOMPLEX_HPP_ */
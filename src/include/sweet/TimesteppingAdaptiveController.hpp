@@ -0,0 +1,210 @@
+/*
+ * TimesteppingAdaptiveController.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_TIMESTEPPINGADAPTIVECONTROLLER_HPP_
+#define SRC_INCLUDE_SWEET_TIMESTEPPINGADAPTIVECONTROLLER_HPP_
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <sweet/FatalError.hpp>
+#include <sweet/SWEETCheckpoint.hpp>
+
+
+
+/**
+ * PI controller for the time step size based on scaled local error
+ * estimates (error <= 1 means the time step is accepted).
+ *
+ * See Hairer, Wanner: Solving Ordinary Differential Equations II, Sec. IV.2
+ * and Gustafsson (1991), Control theoretic techniques for stepsize selection
+ * in explicit Runge-Kutta methods.
+ */
+class TimesteppingAdaptiveController
+{
+	/// Exponents of integral and proportional part
+	double k_i;
+	double k_p;
+
+	/// Exponent for rejected time steps
+	double k_reject;
+
+	double safety_factor;
+	double min_factor;
+	double max_factor;
+
+	double min_timestep_size;
+	double max_timestep_size;
+
+	/// Error of the last accepted time step
+	double last_error;
+
+	/// Number of consecutive rejected time steps
+	int num_consecutive_rejected;
+
+public:
+	std::size_t num_accepted;
+	std::size_t num_rejected;
+
+
+public:
+	TimesteppingAdaptiveController()	:
+		k_i(0),
+		k_p(0),
+		k_reject(0),
+		safety_factor(0.9),
+		min_factor(0.2),
+		max_factor(5.0),
+		min_timestep_size(0),
+		max_timestep_size(std::numeric_limits<double>::infinity()),
+		last_error(1.0),
+		num_consecutive_rejected(0),
+		num_accepted(0),
+		num_rejected(0)
+	{
+	}
+
+
+	void setup(
+			int i_error_estimator_order,	///< order of the lower order (embedded) solution
+			double i_min_timestep_size,
+			double i_max_timestep_size,
+			double i_safety_factor = 0.9,
+			double i_min_factor = 0.2,
+			double i_max_factor = 5.0
+	)
+	{
+		// The local error behaves like dt^(q+1)
+		double k = i_error_estimator_order+1;
+
+		k_i = 0.7/k;
+		k_p = 0.4/k;
+		k_reject = 1.0/k;
+
+		min_timestep_size = i_min_timestep_size;
+		max_timestep_size = i_max_timestep_size;
+
+		safety_factor = i_safety_factor;
+		min_factor = i_min_factor;
+		max_factor = i_max_factor;
+
+		last_error = 1.0;
+		num_consecutive_rejected = 0;
+		num_accepted = 0;
+		num_rejected = 0;
+	}
+
+
+	/**
+	 * Return the time step size to use for the next (or repeated) time step
+	 */
+	double computeNextTimestepSize(
+			double i_timestep_size,		///< time step size which was tried
+			double i_error				///< scaled error estimate of this time step
+	)
+	{
+		double factor;
+
+		if (std::isnan(i_error) || std::isinf(i_error))
+		{
+			factor = min_factor;
+		}
+		else
+		{
+			// Avoid division by zero for exact solutions
+			double error = std::max(i_error, 1e-10);
+
+			if (error <= 1.0)
+				factor = safety_factor*std::pow(error, -k_i)*std::pow(last_error, k_p);
+			else
+				factor = safety_factor*std::pow(error, -k_reject);
+
+			factor = std::min(max_factor, std::max(min_factor, factor));
+		}
+
+		if (i_error <= 1.0)
+		{
+			num_accepted++;
+
+			// Don't increase the time step size directly after a rejection
+			if (num_consecutive_rejected > 0)
+				factor = std::min(factor, 1.0);
+
+			last_error = std::max(i_error, 1e-4);
+			num_consecutive_rejected = 0;
+		}
+		else
+		{
+			num_rejected++;
+			num_consecutive_rejected++;
+
+			if (num_consecutive_rejected > 100)
+				FatalError("Adaptive time stepping: Too many rejected time steps");
+
+			factor = std::min(factor, 1.0);
+		}
+
+		double dt = i_timestep_size*factor;
+		dt = std::min(dt, max_timestep_size);
+
+		if (dt < min_timestep_size)
+		{
+			if (i_error > 1.0 || std::isnan(i_error))
+				FatalError("Adaptive time stepping: Time step size dropped below the minimum time step size");
+
+			dt = min_timestep_size;
+		}
+
+		return dt;
+	}
+
+
+	/**
+	 * Store state of controller to checkpoint
+	 */
+	void checkpoint_write(
+			SWEETCheckpoint &io_checkpoint,
+			const std::string &i_prefix
+	)	const
+	{
+		io_checkpoint.addScalar(i_prefix+"last_error", last_error);
+		io_checkpoint.addScalar(i_prefix+"num_consecutive_rejected", num_consecutive_rejected);
+		io_checkpoint.addScalar(i_prefix+"num_accepted", num_accepted);
+		io_checkpoint.addScalar(i_prefix+"num_rejected", num_rejected);
+	}
+
+
+
+	/**
+	 * Load state of controller from checkpoint
+	 */
+	void checkpoint_read(
+			const SWEETCheckpoint &i_checkpoint,
+			const std::string &i_prefix
+	)
+	{
+		last_error = i_checkpoint.getScalar(i_prefix+"last_error");
+		num_consecutive_rejected = i_checkpoint.getScalar(i_prefix+"num_consecutive_rejected");
+		num_accepted = i_checkpoint.getScalar(i_prefix+"num_accepted");
+		num_rejected = i_checkpoint.getScalar(i_prefix+"num_rejected");
+	}
+
+
+	void output(
+			const std::string &i_prefix = "adaptive_timestepping"
+	)	const
+	{
+		std::cout << "[MULE] " << i_prefix << ".accepted: " << num_accepted << std::endl;
+		std::cout << "[MULE] " << i_prefix << ".rejected: " << num_rejected << std::endl;
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_TIMESTEPPINGADAPTIVECONTROLLER_HPP_ */
@@ -0,0 +1,344 @@
+/*
+ * TimesteppingExplicitRKTableau.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_TIMESTEPPINGEXPLICITRKTABLEAU_HPP_
+#define SRC_INCLUDE_SWEET_TIMESTEPPINGEXPLICITRKTABLEAU_HPP_
+
+#include <vector>
+#include <sweet/FatalError.hpp>
+
+
+
+/**
+ * Coefficients of explicit Runge-Kutta methods
+ *
+ * Classical methods are given by their Butcher tableau
+ *
+ *   c | a
+ *   --+---
+ *     | b
+ *
+ * Low-storage methods are given in the 2N-storage form of Williamson
+ *
+ *   dU := A[i]*dU + dt*F(U, t + c[i]*dt)
+ *   U  := U + B[i]*dU
+ *
+ * which only requires one additional buffer (plus the one for the
+ * evaluation of F) per variable, independent of the number of stages.
+ *
+ * Embedded methods additionally provide the weights b_embedded of a
+ * lower order solution which is used to estimate the local error
+ * for adaptive time step size control.
+ */
+class TimesteppingExplicitRKTableau
+{
+public:
+	/// Max. number of stages of all supported methods
+	static const int MAX_STAGES = 7;
+
+	int order;
+	int num_stages;
+	bool low_storage;
+	bool embedded;
+
+	/// Order of the embedded solution
+	int embedded_order;
+
+	/// Butcher tableau, a is stored row-major with num_stages x num_stages entries
+	std::vector<double> a;
+	std::vector<double> b;
+	std::vector<double> b_embedded;
+
+	/// Stage times for both types of methods
+	std::vector<double> c;
+
+	/// 2N-storage coefficients
+	std::vector<double> A;
+	std::vector<double> B;
+
+
+	TimesteppingExplicitRKTableau()	:
+		order(-1),
+		num_stages(0),
+		low_storage(false),
+		embedded(false),
+		embedded_order(-1)
+	{
+	}
+
+
+	double get_a(int i, int j)	const
+	{
+		return a[i*num_stages+j];
+	}
+
+
+	void setup(
+			int i_order,
+			bool i_low_storage
+	)
+	{
+		if (i_low_storage)
+			setupLowStorage(i_order);
+		else
+			setupClassical(i_order);
+	}
+
+
+	void setupClassical(
+			int i_order
+	)
+	{
+		order = i_order;
+		low_storage = false;
+		embedded = false;
+		b_embedded.clear();
+		A.clear();
+		B.clear();
+
+		// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
+		// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
+		if (order == 1)
+		{
+			/*
+			 * c     a
+			 * 0   |
+			 * --------------
+			 *     | 1
+			 */
+			num_stages = 1;
+			a = {0};
+			b = {1.0};
+			c = {0};
+		}
+		else if (order == 2)
+		{
+			/*
+			 * c     a
+			 * 0   |
+			 * 1/2 | 1/2
+			 * --------------
+			 *     | 0   1    b
+			 */
+			num_stages = 2;
+			a = {	0,		0,
+					0.5,	0	};
+			b = {0.0, 1.0};
+			c = {0.0, 0.5};
+		}
+		else if (order == 3)
+		{
+			/*
+			 * c     a
+			 * 0   |
+			 * 1/3 | 1/3
+			 * 2/3 | 0    2/3
+			 * --------------
+			 *     | 1/4  0   3/4
+			 */
+			num_stages = 3;
+			a = {	0,			0,			0,
+					1.0/3.0,	0,			0,
+					0,			2.0/3.0,	0	};
+			b = {1.0/4.0, 0.0, 3.0/4.0};
+			c = {0.0, 1.0/3.0, 2.0/3.0};
+		}
+		else if (order == 4)
+		{
+			/*
+			 * c     a
+			 * 0   |
+			 * 1/2 | 1/2
+			 * 1/2 | 0    1/2
+			 * 1   | 0    0    1
+			 * --------------
+			 *     | 1/6  1/3  1/3  1/6
+			 */
+			num_stages = 4;
+			a = {	0,		0,		0,		0,
+					0.5,	0,		0,		0,
+					0,		0.5,	0,		0,
+					0,		0,		1.0,	0	};
+			b = {1.0/6.0, 1.0/3.0, 1.0/3.0, 1.0/6.0};
+			c = {0.0, 0.5, 0.5, 1.0};
+		}
+		else
+		{
+			FatalError("This order of the Runge-Kutta time stepping is not supported!");
+		}
+	}
+
+
+	void setupLowStorage(
+			int i_order
+	)
+	{
+		order = i_order;
+		low_storage = true;
+		embedded = false;
+		a.clear();
+		b.clear();
+		b_embedded.clear();
+
+		if (order == 1)
+		{
+			// Forward Euler
+			num_stages = 1;
+			A = {0.0};
+			B = {1.0};
+			c = {0.0};
+		}
+		else if (order == 2)
+		{
+			// Midpoint rule
+			num_stages = 2;
+			A = {0.0, -0.5};
+			B = {0.5, 1.0};
+			c = {0.0, 0.5};
+		}
+		else if (order == 3)
+		{
+			// Williamson (1980), Low-storage Runge-Kutta schemes, J. Comput. Phys.
+			num_stages = 3;
+			A = {0.0, -5.0/9.0, -153.0/128.0};
+			B = {1.0/3.0, 15.0/16.0, 8.0/15.0};
+			c = {0.0, 1.0/3.0, 3.0/4.0};
+		}
+		else if (order == 4)
+		{
+			// Carpenter & Kennedy (1994), Fourth-order 2N-storage Runge-Kutta schemes, NASA TM-109112
+			num_stages = 5;
+			A = {
+					0.0,
+					-567301805773.0/1357537059087.0,
+					-2404267990393.0/2016746695238.0,
+					-3550918686646.0/2091501179385.0,
+					-1275806237668.0/842570457699.0
+			};
+			B = {
+					1432997174477.0/9575080441755.0,
+					5161836677717.0/13612068292357.0,
+					1720146321549.0/2090206949498.0,
+					3134564353537.0/4481467310338.0,
+					2277821191437.0/14882151754819.0
+			};
+			c = {
+					0.0,
+					1432997174477.0/9575080441755.0,
+					2526269341429.0/6820363266100.0,
+					2006345519317.0/3224310063776.0,
+					2802321613138.0/2924317926251.0
+			};
+		}
+		else
+		{
+			FatalError("This order of the low-storage Runge-Kutta time stepping is not supported!");
+		}
+	}
+
+
+	/**
+	 * Setup embedded Runge-Kutta pair.
+	 *
+	 * The solution is propagated with the higher order.
+	 */
+	void setupEmbedded(
+			int i_order
+	)
+	{
+		order = i_order;
+		low_storage = false;
+		embedded = true;
+		A.clear();
+		B.clear();
+
+		if (order == 2)
+		{
+			/*
+			 * Heun-Euler 2(1)
+			 *
+			 * c     a
+			 * 0   |
+			 * 1   | 1
+			 * --------------
+			 *     | 1/2  1/2    b
+			 *     | 1    0      b_embedded
+			 */
+			num_stages = 2;
+			embedded_order = 1;
+			a = {	0,		0,
+					1.0,	0	};
+			b = {0.5, 0.5};
+			b_embedded = {1.0, 0.0};
+			c = {0.0, 1.0};
+		}
+		else if (order == 3)
+		{
+			/*
+			 * Bogacki-Shampine 3(2)
+			 *
+			 * c     a
+			 * 0   |
+			 * 1/2 | 1/2
+			 * 3/4 | 0     3/4
+			 * 1   | 2/9   1/3   4/9
+			 * --------------
+			 *     | 2/9   1/3   4/9   0      b
+			 *     | 7/24  1/4   1/3   1/8    b_embedded
+			 */
+			num_stages = 4;
+			embedded_order = 2;
+			a = {	0,			0,			0,			0,
+					0.5,		0,			0,			0,
+					0,			0.75,		0,			0,
+					2.0/9.0,	1.0/3.0,	4.0/9.0,	0	};
+			b = {2.0/9.0, 1.0/3.0, 4.0/9.0, 0.0};
+			b_embedded = {7.0/24.0, 1.0/4.0, 1.0/3.0, 1.0/8.0};
+			c = {0.0, 0.5, 0.75, 1.0};
+		}
+		else if (order == 5)
+		{
+			/*
+			 * Dormand-Prince 5(4)
+			 */
+			num_stages = 7;
+			embedded_order = 4;
+			a = {
+					0,					0,					0,					0,				0,					0,				0,
+					1.0/5.0,			0,					0,					0,				0,					0,				0,
+					3.0/40.0,			9.0/40.0,			0,					0,				0,					0,				0,
+					44.0/45.0,			-56.0/15.0,			32.0/9.0,			0,				0,					0,				0,
+					19372.0/6561.0,		-25360.0/2187.0,	64448.0/6561.0,		-212.0/729.0,	0,					0,				0,
+					9017.0/3168.0,		-355.0/33.0,		46732.0/5247.0,		49.0/176.0,		-5103.0/18656.0,	0,				0,
+					35.0/384.0,			0,					500.0/1113.0,		125.0/192.0,	-2187.0/6784.0,		11.0/84.0,		0
+			};
+			b = {35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0, 0.0};
+			b_embedded = {5179.0/57600.0, 0.0, 7571.0/16695.0, 393.0/640.0, -92097.0/339200.0, 187.0/2100.0, 1.0/40.0};
+			c = {0.0, 1.0/5.0, 3.0/10.0, 4.0/5.0, 8.0/9.0, 1.0, 1.0};
+		}
+		else
+		{
+			FatalError("Only orders 2 (Heun-Euler), 3 (Bogacki-Shampine) and 5 (Dormand-Prince) are supported for embedded Runge-Kutta methods");
+		}
+	}
+
+
+	/**
+	 * Number of stage buffers required for each variable
+	 */
+	int getNumBuffers()	const
+	{
+		if (low_storage)
+			return 2;	// dU and F
+
+		return num_stages+1;	// k_i and stage input
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_TIMESTEPPINGEXPLICITRKTABLEAU_HPP_ */
@@ -19,6 +19,7 @@
 
 	#define SWEET_OMP_PARALLEL_FOR_SIMD
 	#define SWEET_OMP_PARALLEL_FOR
+	#define SWEET_OMP_SIMD
 
 	#define SWEET_THREADING_SPACE_PARALLEL_FOR
 	#define SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
@@ -44,8 +45,10 @@
 	#if SWEET_SIMD_ENABLE
 		#define SWEET_OMP_PARALLEL_FOR_SIMD _Pragma("omp parallel for simd")
 		#define SWEET_OMP_PARALLEL_FOR_SIMD_COLLAPSE2 _Pragma("omp parallel for simd collapse(2)")
+		#define SWEET_OMP_SIMD _Pragma("omp simd")
 	#else
 		#define SWEET_OMP_PARALLEL_FOR_SIMD _Pragma("omp parallel for")
+		#define SWEET_OMP_SIMD
 	#endif
 
 	#if SWEET_THREADING_SPACE
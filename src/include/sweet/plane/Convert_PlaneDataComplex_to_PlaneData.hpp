@@ -11,6 +11,7 @@
 #include <sweet/plane/PlaneData.hpp>
 #include <sweet/plane/PlaneDataComplex.hpp>
 #include <sweet/ScalarDataArray.hpp>
+#include <sweet/SplitComplex.hpp>
 
 class Convert_PlaneDataComplex_To_PlaneData
 {
@@ -72,6 +73,52 @@ public:
 
 		return out;
 	}
+
+
+
+	/**
+	 * Real part of the physical data, computed in spectral space without any FFT
+	 *
+	 * The modes of the real part are given by
+	 *
+	 *   R(kx,ky) = 0.5*(C(kx,ky) + conj(C(-kx,-ky)))
+	 *
+	 * This is identical to physical_convert() (up to round-off errors).
+	 */
+public:
+	static
+	PlaneData spectral_convert_real_part(
+			const PlaneDataComplex &i_planeData
+	)
+	{
+		const PlaneDataConfig *planeDataConfig = i_planeData.planeDataConfig;
+		PlaneData out(planeDataConfig);
+
+		i_planeData.request_data_spectral();
+
+		std::size_t size_x = planeDataConfig->spectral_data_size[0];
+		std::size_t complex_size_x = planeDataConfig->spectral_complex_data_size[0];
+		std::size_t complex_size_y = planeDataConfig->spectral_complex_data_size[1];
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (std::size_t j = 0; j < complex_size_y; j++)
+		{
+			const std::complex<double> *row = i_planeData.spectral_space_data + j*complex_size_x;
+			const std::complex<double> *mirror_row = i_planeData.spectral_space_data + ((complex_size_y-j) % complex_size_y)*complex_size_x;
+			std::complex<double> *out_row = out.spectral_space_data + j*size_x;
+
+			// kx = 0
+			SplitComplexKernels::conj_fold(1, row, mirror_row, out_row);
+
+			// kx = 1, ..., nx/2 with the modes -kx stored at nx-1, ..., nx/2
+			SplitComplexKernels::conj_fold(size_x-1, row+1, mirror_row+complex_size_x-1, out_row+1);
+		}
+
+		out.physical_space_data_valid = false;
+		out.spectral_space_data_valid = true;
+
+		return out;
+	}
 #endif
 };
 
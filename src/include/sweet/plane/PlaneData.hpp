@@ -30,6 +30,8 @@
 #include <sweet/openmp_helper.hpp>
 #include <sweet/MemBlockAlloc.hpp>
 #include <sweet/FatalError.hpp>
+#include <sweet/SWEETCheckpoint.hpp>
+#include <sweet/KernelCounters.hpp>
 
 #include <sweet/plane/PlaneDataConfig.hpp>
 #include <sweet/plane/PlaneData_Kernels.hpp>
@@ -160,6 +162,9 @@ public:
 	 */
 	double *physical_space_data;
 
+	/// physical_space_data is not owned by this class (see setup_physical_view())
+	bool physical_space_data_is_view = false;
+
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 	bool physical_space_data_valid;
 
@@ -204,9 +209,10 @@ spectral_space_data_valid(false)
 private:
 	void p_allocate_buffers()
 	{
-		physical_space_data = MemBlockAlloc::alloc<double>(
-				planeDataConfig->physical_array_data_number_of_elements*sizeof(double)
-		);
+		if (!physical_space_data_is_view)
+			physical_space_data = MemBlockAlloc::alloc<double>(
+					planeDataConfig->physical_array_data_number_of_elements*sizeof(double)
+			);
 
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 		spectral_space_data = MemBlockAlloc::alloc< std::complex<double> >(
@@ -300,10 +306,38 @@ spectral_space_data_valid(false)
 
 
 
+	/**
+	 * Setup this object with the physical space data stored in an
+	 * externally owned buffer (e.g. to store several fields contiguously).
+	 *
+	 * The buffer is not released by this object and
+	 * move operations copy the physical data instead of swapping buffers.
+	 *
+	 * Must be called on an object created with the dummy constructor.
+	 */
+public:
+	void setup_physical_view(
+			const PlaneDataConfig *i_planeDataConfig,
+			double *i_physical_space_data
+	)
+	{
+		assert(planeDataConfig == nullptr);
+
+		planeDataConfig = i_planeDataConfig;
+
+		physical_space_data = i_physical_space_data;
+		physical_space_data_is_view = true;
+
+		p_allocate_buffers();
+	}
+
+
+
 public:
 	~PlaneData()
 	{
-		MemBlockAlloc::free(physical_space_data, planeDataConfig->physical_array_data_number_of_elements*sizeof(double));
+		if (!physical_space_data_is_view)
+			MemBlockAlloc::free(physical_space_data, planeDataConfig->physical_array_data_number_of_elements*sizeof(double));
 
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 		MemBlockAlloc::free(spectral_space_data, planeDataConfig->spectral_array_data_number_of_elements*sizeof(std::complex<double>));
@@ -328,8 +362,9 @@ public:
 
 
 
+	template <typename T_Lambda>
 	void physical_update_lambda_array_indices(
-			std::function<void(int,int,double&)> i_lambda,	///< lambda function to return value for lat/mu
+			T_Lambda i_lambda,	///< lambda function to return value for lat/mu
 			bool i_anti_aliasing = true
 	)
 	{
@@ -354,8 +389,9 @@ public:
 
 
 
+	template <typename T_Lambda>
 	void physical_update_lambda_unit_coordinates_corner_centered(
-			std::function<void(double,double,double&)> i_lambda,	///< lambda function to return value for lat/mu
+			T_Lambda i_lambda,	///< lambda function to return value for lat/mu
 			bool i_anti_aliasing = true
 	)
 	{
@@ -386,8 +422,9 @@ public:
 
 
 
+	template <typename T_Lambda>
 	void physical_update_lambda_unit_coordinates_cell_centered(
-			std::function<void(double,double,double&)> i_lambda,	///< lambda function to return value for lat/mu
+			T_Lambda i_lambda,	///< lambda function to return value for lat/mu
 			bool i_anti_aliasing = true
 	)
 	{
@@ -676,8 +713,9 @@ public:
 
 
 
+	template <typename T_Lambda>
 	void spectral_update_lambda_array_indices(
-			std::function<void(int,std::complex<double>&)> i_lambda	///< lambda function to return value for lat/mu
+			T_Lambda i_lambda	///< lambda function to return value for lat/mu
 	)
 	{
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
@@ -698,8 +736,9 @@ public:
 	}
 
 
+	template <typename T_Lambda>
 	void spectral_update_lambda_modes(
-			std::function<void(int,int,std::complex<double>&)> i_lambda	///< lambda function to return value for lat/mu
+			T_Lambda i_lambda	///< lambda function to return value for lat/mu
 	)
 	{
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
@@ -1352,7 +1391,16 @@ public:
 		{
 			physical_space_data_valid = true;
 #endif
-			std::swap(physical_space_data, i_dataArray.physical_space_data);
+			if (physical_space_data_is_view || i_dataArray.physical_space_data_is_view)
+			{
+				PLANE_DATA_PHYSICAL_FOR_IDX(
+						physical_space_data[idx] = i_dataArray.physical_space_data[idx];
+				);
+			}
+			else
+			{
+				std::swap(physical_space_data, i_dataArray.physical_space_data);
+			}
 
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 		}
@@ -1816,6 +1864,65 @@ public:
 
 
 
+	/**
+	 * Compute
+	 *   this = i_beta*i_x + sum_j i_alpha[j]*i_y[j]
+	 * in a single pass without temporaries.
+	 *
+	 * i_x might be this array itself, but none of the i_y.
+	 */
+	PlaneData& set_linear_combination(
+			double i_beta,
+			const PlaneData &i_x,
+			int i_num_y,
+			const double *i_alpha,
+			const PlaneData * const *i_y
+	)
+	{
+#if SWEET_DEBUG
+		for (int j = 0; j < i_num_y; j++)
+			if (i_y[j] == this)
+				FatalError("Output array must not be part of the sum");
+#endif
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+
+		i_x.request_data_spectral();
+		for (int j = 0; j < i_num_y; j++)
+			i_y[j]->request_data_spectral();
+
+		PLANE_DATA_SPECTRAL_FOR_IDX(
+				std::complex<double> v = i_beta*i_x.spectral_space_data[idx];
+				for (int j = 0; j < i_num_y; j++)
+					v += i_alpha[j]*i_y[j]->spectral_space_data[idx];
+				spectral_space_data[idx] = v;
+		);
+
+		spectral_space_data_valid = true;
+		physical_space_data_valid = false;
+
+		spectral_zeroAliasingModes();
+
+#else
+
+		i_x.request_data_physical();
+		for (int j = 0; j < i_num_y; j++)
+			i_y[j]->request_data_physical();
+
+		PLANE_DATA_PHYSICAL_FOR_IDX(
+				double v = i_beta*i_x.physical_space_data[idx];
+				for (int j = 0; j < i_num_y; j++)
+					v += i_alpha[j]*i_y[j]->physical_space_data[idx];
+				physical_space_data[idx] = v;
+		);
+
+#endif
+
+		return *this;
+	}
+
+
+
 	/**
 	 * Compute element-wise addition
 	 */
@@ -2140,9 +2247,18 @@ public:
 		request_data_physical();
 		i_array_data.request_data_physical();
 
-		PLANE_DATA_PHYSICAL_FOR_IDX(
-				out.physical_space_data[idx] = physical_space_data[idx]*i_array_data.physical_space_data[idx];
-		);
+		{
+			// 1 FLOP, 2 loads and 1 store per grid point
+			SWEET_KERNEL_COUNTER_REGION(
+					"plane_mul",
+					planeDataConfig->physical_array_data_number_of_elements,
+					3*sizeof(double)*planeDataConfig->physical_array_data_number_of_elements
+				);
+
+			PLANE_DATA_PHYSICAL_FOR_IDX(
+					out.physical_space_data[idx] = physical_space_data[idx]*i_array_data.physical_space_data[idx];
+			);
+		}
 
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 		out.physical_space_data_valid = true;
@@ -2503,6 +2619,88 @@ public:
 		return o_ostream;
 	}
 
+	/**
+	 * Add a copy of the data to a checkpoint.
+	 *
+	 * The data is stored in the space in which it's currently valid
+	 * to avoid any transformation which would change the data.
+	 */
+	void checkpoint_write(
+			SWEETCheckpoint &io_checkpoint,
+			const std::string &i_name
+	)	const
+	{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		if (spectral_space_data_valid)
+		{
+			int64_t res[4] = {(int64_t)planeDataConfig->spectral_data_size[0], (int64_t)planeDataConfig->spectral_data_size[1], 0, 0};
+
+			io_checkpoint.addData(
+					i_name,
+					SWEETDataContainer::PRIMITIVE_PLANE,
+					SWEETDataContainer::SPACE_SPECTRAL,
+					SWEETDataContainer::DATA_TYPE_COMPLEX128,
+					res,
+					spectral_space_data,
+					planeDataConfig->spectral_array_data_number_of_elements
+				);
+			return;
+		}
+#endif
+
+		int64_t res[4] = {(int64_t)planeDataConfig->physical_data_size[0], (int64_t)planeDataConfig->physical_data_size[1], 0, 0};
+
+		io_checkpoint.addData(
+				i_name,
+				SWEETDataContainer::PRIMITIVE_PLANE,
+				SWEETDataContainer::SPACE_PHYSICAL,
+				SWEETDataContainer::DATA_TYPE_FLOAT64,
+				res,
+				physical_space_data,
+				planeDataConfig->physical_array_data_number_of_elements
+			);
+	}
+
+
+
+	/**
+	 * Load data from a checkpoint
+	 */
+	void checkpoint_read(
+			const SWEETCheckpoint &i_checkpoint,
+			const std::string &i_name
+	)
+	{
+		const SWEETCheckpoint::Entry *e = i_checkpoint.findEntry(i_name);
+
+		if (e == nullptr)
+			FatalError("Checkpoint: Entry '"+i_name+"' not found");
+
+		if (e->space == SWEETDataContainer::SPACE_SPECTRAL)
+		{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+			i_checkpoint.getEntry(i_name, SWEETDataContainer::PRIMITIVE_PLANE, SWEETDataContainer::DATA_TYPE_COMPLEX128, planeDataConfig->spectral_array_data_number_of_elements);
+
+			std::memcpy(spectral_space_data, e->data.data(), e->data.size());
+			spectral_space_data_valid = true;
+			physical_space_data_valid = false;
+#else
+			FatalError("Checkpoint: Spectral data in checkpoint, but spectral space is disabled");
+#endif
+			return;
+		}
+
+		i_checkpoint.getEntry(i_name, SWEETDataContainer::PRIMITIVE_PLANE, SWEETDataContainer::DATA_TYPE_FLOAT64, planeDataConfig->physical_array_data_number_of_elements);
+
+		std::memcpy(physical_space_data, e->data.data(), e->data.size());
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		physical_space_data_valid = true;
+		spectral_space_data_valid = false;
+#endif
+	}
+
+
+
 	/**
 	 * Write data to ASCII file
 	 *
@@ -2518,6 +2716,26 @@ public:
 	{
 		request_data_physical();
 
+		return file_physical_saveData_ascii_data(planeDataConfig, physical_space_data, i_filename, i_separator, i_precision, dimension);
+	}
+
+
+
+	/**
+	 * Write physical data given by a raw array to ASCII file.
+	 *
+	 * This can be also used with snapshots of the data (e.g. for background output).
+	 */
+	static
+	bool file_physical_saveData_ascii_data(
+			const PlaneDataConfig *i_planeDataConfig,
+			const double *i_physical_space_data,
+			const char *i_filename,		///< Name of file to store data to
+			char i_separator = '\t',	///< separator to use for each line
+			int i_precision = 16,		///< number of floating point digits
+			int dimension = 2			///< store 1D or 2D
+	)
+	{
 		std::ofstream file(i_filename, std::ios_base::trunc);
 		file << std::setprecision(i_precision);
 
@@ -2525,8 +2743,8 @@ public:
 		file << "#FORMAT ASCII" << std::endl;
 		file << "#PRIMITIVE PLANE" << std::endl;
 
-		std::size_t resx = planeDataConfig->physical_res[0];
-		std::size_t resy = planeDataConfig->physical_res[1];
+		std::size_t resx = i_planeDataConfig->physical_res[0];
+		std::size_t resy = i_planeDataConfig->physical_res[1];
 
 		file << "#SPACE PHYSICAL" << std::endl;
 		file << "#RESX " << resx << std::endl;
@@ -2536,15 +2754,15 @@ public:
 		if (dimension == 2)
 			ymin = 0;
 		else
-			ymin = planeDataConfig->physical_res[1]-1;
+			ymin = i_planeDataConfig->physical_res[1]-1;
 
 		for (int y = (int) resy-1; y >= (int) ymin; y--)
 		{
 			for (std::size_t x = 0; x < resx; x++)
 			{
-				file << p_physical_get(y, x);
+				file << i_physical_space_data[y*i_planeDataConfig->physical_data_size[0]+x];
 
-				if (x < planeDataConfig->physical_res[0]-1)
+				if (x < i_planeDataConfig->physical_res[0]-1)
 					file << i_separator;
 				else
 					file << std::endl;
@@ -2616,6 +2834,26 @@ public:
 	{
 		request_data_spectral();
 
+		return file_spectral_abs_saveData_ascii_data(planeDataConfig, spectral_space_data, i_filename, i_separator, i_precision, dimension);
+	}
+
+
+
+	/**
+	 * Write amplitude of spectral data given by a raw array to ASCII file
+	 *
+	 * This can be also used with snapshots of the data (e.g. for background output).
+	 */
+	static
+	bool file_spectral_abs_saveData_ascii_data(
+			const PlaneDataConfig *i_planeDataConfig,
+			const std::complex<double> *i_spectral_space_data,
+			const char *i_filename,		///< Name of file to store data to
+			char i_separator = '\t',	///< separator to use for each line
+			int i_precision = 12,		///< number of floating point digits
+			int dimension = 2			///< store 1D or 2D
+	)
+	{
 		std::ofstream file(i_filename, std::ios_base::trunc);
 		file << std::setprecision(i_precision);
 
@@ -2623,17 +2861,19 @@ public:
 
 		size_t ymax = 0;
 		if (dimension == 2)
-			ymax = planeDataConfig->spectral_data_size[1];
+			ymax = i_planeDataConfig->spectral_data_size[1];
 		else
 			ymax = 1;
 
+		double scale = 2.0/(double)i_planeDataConfig->physical_array_data_number_of_elements;
+
 		for (std::size_t y = 0; y < ymax; y++)
 		{
-			for (std::size_t x = 0; x < planeDataConfig->spectral_data_size[0]; x++)
+			for (std::size_t x = 0; x < i_planeDataConfig->spectral_data_size[0]; x++)
 			{
-				file << spectral_return_amplitude(y, x);
+				file << std::abs(i_spectral_space_data[y*i_planeDataConfig->spectral_data_size[0]+x]*scale);
 
-				if (x < planeDataConfig->spectral_data_size[0]-1)
+				if (x < i_planeDataConfig->spectral_data_size[0]-1)
 					file << i_separator;
 				else
 					file << std::endl;
@@ -25,6 +25,7 @@
 #include <sweet/openmp_helper.hpp>
 #include <sweet/MemBlockAlloc.hpp>
 #include <sweet/FatalError.hpp>
+#include <sweet/SplitComplex.hpp>
 
 #include <sweet/plane/PlaneDataConfig.hpp>
 
@@ -225,6 +226,29 @@ private:
 	}
 
 
+#if SWEET_COMPLEX_SPLIT
+	/**
+	 * Call i_lambda(idx, n) for the contiguous rows [idx, idx+n)
+	 * of the spectral iteration ranges (see SplitComplexKernels)
+	 */
+	template <typename T_Lambda>
+	void p_spectral_for_rows(
+			T_Lambda i_lambda
+	)	const
+	{
+		for (int r = 0; r < 4; r++)
+		{
+			std::size_t i_start = planeDataConfig->spectral_complex_ranges[r][0][0];
+			std::size_t n = planeDataConfig->spectral_complex_ranges[r][0][1] - i_start;
+
+			SWEET_THREADING_SPACE_PARALLEL_FOR
+			for (std::size_t jj = planeDataConfig->spectral_complex_ranges[r][1][0]; jj < planeDataConfig->spectral_complex_ranges[r][1][1]; jj++)
+				i_lambda(jj*planeDataConfig->spectral_complex_data_size[0] + i_start, n);
+		}
+	}
+#endif
+
+
 public:
 	/**
 	 * copy constructor, used e.g. in
@@ -1048,6 +1072,14 @@ public:
 		request_data_spectral();
 		rw_array_data.request_data_spectral();
 
+#if SWEET_COMPLEX_SPLIT
+		p_spectral_for_rows(
+			[&](std::size_t idx, std::size_t n)
+			{
+				SplitComplexKernels::div(n, &spectral_space_data[idx], &i_array_data.spectral_space_data[idx], &out.spectral_space_data[idx]);
+			}
+		);
+#else
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 		{
 			if (i_array_data.spectral_space_data[idx] == std::complex<double>(0))
@@ -1056,6 +1088,7 @@ public:
 				out.spectral_space_data[idx] = spectral_space_data[idx] / i_array_data.spectral_space_data[idx];
 		}
 		);
+#endif
 
 
 		out.spectral_space_data_valid = true;
@@ -1086,9 +1119,18 @@ public:
 		request_data_spectral();
 		rw_array_data.request_data_spectral();
 
+#if SWEET_COMPLEX_SPLIT
+		p_spectral_for_rows(
+			[&](std::size_t idx, std::size_t n)
+			{
+				SplitComplexKernels::mul(n, &spectral_space_data[idx], &i_array_data.spectral_space_data[idx], &out.spectral_space_data[idx]);
+			}
+		);
+#else
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 					out.spectral_space_data[idx] = spectral_space_data[idx] * i_array_data.spectral_space_data[idx];
 		);
+#endif
 
 		out.spectral_space_data_valid = true;
 		out.physical_space_data_valid = false;
@@ -1366,6 +1408,56 @@ public:
 
 
 
+	/**
+	 * Add a scaled array
+	 *
+	 *   this += i_alpha*i_x
+	 *
+	 * This avoids the temporary of "this += i_x*i_alpha", e.g. for REXI sums.
+	 */
+	inline
+	PlaneDataComplex& axpy(
+			const std::complex<double> &i_alpha,
+			const PlaneDataComplex &i_x
+	)
+	{
+#if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
+
+		request_data_spectral();
+		i_x.request_data_spectral();
+
+#if SWEET_COMPLEX_SPLIT
+		p_spectral_for_rows(
+			[&](std::size_t idx, std::size_t n)
+			{
+				SplitComplexKernels::axpy(n, i_alpha, &i_x.spectral_space_data[idx], &spectral_space_data[idx]);
+			}
+		);
+#else
+		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
+				spectral_space_data[idx] += i_alpha*i_x.spectral_space_data[idx];
+		);
+#endif
+
+		spectral_space_data_valid = true;
+		physical_space_data_valid = false;
+
+#else
+
+		request_data_physical();
+		i_x.request_data_physical();
+
+		PLANE_DATA_COMPLEX_PHYSICAL_FOR_IDX(
+				physical_space_data[idx] += i_alpha*i_x.physical_space_data[idx];
+			);
+
+#endif
+
+		return *this;
+	}
+
+
+
 	/**
 	 * Compute element-wise addition
 	 */
@@ -1509,9 +1601,18 @@ public:
 
 		request_data_spectral();
 
+#if SWEET_COMPLEX_SPLIT
+		p_spectral_for_rows(
+			[&](std::size_t idx, std::size_t n)
+			{
+				SplitComplexKernels::mul_scalar(n, &spectral_space_data[idx], i_value, &spectral_space_data[idx]);
+			}
+		);
+#else
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				spectral_space_data[idx] *= i_value;
 			);
+#endif
 
 		spectral_space_data_valid = true;
 		physical_space_data_valid = false;
@@ -1577,9 +1678,20 @@ public:
 
 		request_data_spectral();
 
+#if SWEET_COMPLEX_SPLIT
+		std::complex<double> inv_value = 1.0/i_value;
+
+		p_spectral_for_rows(
+			[&](std::size_t idx, std::size_t n)
+			{
+				SplitComplexKernels::mul_scalar(n, &spectral_space_data[idx], inv_value, &spectral_space_data[idx]);
+			}
+		);
+#else
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				spectral_space_data[idx] /= i_value;
 			);
+#endif
 
 		spectral_space_data_valid = true;
 		physical_space_data_valid = false;
@@ -1886,9 +1998,19 @@ public:
 		request_data_physical();
 		i_array_data.request_data_physical();
 
+#if SWEET_COMPLEX_SPLIT
+		SplitComplexKernels::for_blocks(
+			planeDataConfig->physical_array_data_number_of_elements,
+			[&](std::size_t idx, std::size_t n)
+			{
+				SplitComplexKernels::mul(n, &physical_space_data[idx], &i_array_data.physical_space_data[idx], &out.physical_space_data[idx]);
+			}
+		);
+#else
 		PLANE_DATA_COMPLEX_PHYSICAL_FOR_IDX(
 				out.physical_space_data[idx] = physical_space_data[idx]*i_array_data.physical_space_data[idx];
 			);
+#endif
 
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
 		out.physical_space_data_valid = true;
@@ -1997,9 +2119,18 @@ public:
 
 		request_data_spectral();
 
+#if SWEET_COMPLEX_SPLIT
+		p_spectral_for_rows(
+			[&](std::size_t idx, std::size_t n)
+			{
+				SplitComplexKernels::mul_scalar(n, &spectral_space_data[idx], i_value, &out.spectral_space_data[idx]);
+			}
+		);
+#else
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx]*i_value;
 		);
+#endif
 
 		out.spectral_space_data_valid = true;
 		out.physical_space_data_valid = false;
@@ -2066,9 +2197,20 @@ public:
 
 		request_data_spectral();
 
+#if SWEET_COMPLEX_SPLIT
+		std::complex<double> inv_value = 1.0/i_value;
+
+		p_spectral_for_rows(
+			[&](std::size_t idx, std::size_t n)
+			{
+				SplitComplexKernels::mul_scalar(n, &spectral_space_data[idx], inv_value, &out.spectral_space_data[idx]);
+			}
+		);
+#else
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx] / i_value;
 		);
+#endif
 
 		out.spectral_space_data_valid = true;
 		out.physical_space_data_valid = false;
@@ -23,6 +23,7 @@
 #include <iomanip>
 #include <sweet/sweetmath.hpp>
 #include <sweet/FatalError.hpp>
+#include <sweet/SimulationProfiler.hpp>
 
 
 
@@ -714,6 +715,8 @@ public:
 			std::complex<double> *o_spectral_data
 	)	const
 	{
+		SWEET_PROFILER_REGION("fft_forward");
+
 		fftw_execute_dft_r2c(
 				fftw_plan_forward,
 				i_physical_data,
@@ -728,6 +731,8 @@ public:
 			double *o_physical_data
 	)	const
 	{
+		SWEET_PROFILER_REGION("fft_backward");
+
 		fftw_execute_dft_c2r(
 				fftw_plan_backward,
 				(fftw_complex*)i_spectral_data,
@@ -746,6 +751,8 @@ public:
 			std::complex<double> *o_spectral_data
 	)	const
 	{
+		SWEET_PROFILER_REGION("fft_forward");
+
 		fftw_execute_dft(
 				fftw_plan_complex_forward,
 				(fftw_complex*)i_physical_data,
@@ -760,6 +767,8 @@ public:
 			std::complex<double> *o_physical_data
 	)	const
 	{
+		SWEET_PROFILER_REGION("fft_backward");
+
 		fftw_execute_dft(
 				fftw_plan_complex_backward,
 				(fftw_complex*)i_spectral_data,
@@ -0,0 +1,465 @@
+/*
+ * PlaneDataConfigDistributed.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_PLANE_PLANEDATACONFIGDISTRIBUTED_HPP_
+#define SRC_INCLUDE_SWEET_PLANE_PLANEDATACONFIGDISTRIBUTED_HPP_
+
+#include <fftw3.h>
+#include <complex>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <sweet/MemBlockAlloc.hpp>
+#include <sweet/FatalError.hpp>
+#include <sweet/openmp_helper.hpp>
+#include <sweet/GlobalTranspose.hpp>
+
+#if SWEET_THREADING_SPACE
+#	include <omp.h>
+#endif
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
+
+#ifndef SWEET_USE_PLANE_SPECTRAL_DEALIASING
+#	define SWEET_USE_PLANE_SPECTRAL_DEALIASING 1
+#endif
+
+
+
+/**
+ * Configuration of plane data which is distributed over MPI ranks
+ *
+ * For 2D data, a pencil decomposition reduces to a slab decomposition:
+ *
+ * Physical space:
+ *   Each rank stores a contiguous range of rows (y) with all nx values,
+ *   layout [y-y_start][x] (like PlaneData, but only the local rows).
+ *
+ * Spectral space:
+ *   Each rank stores a contiguous range of the nx/2+1 wavenumbers in
+ *   x-direction with all ny wavenumbers in y-direction,
+ *   layout [kx-kx_start][ky] (note the transposed layout compared to PlaneData).
+ *
+ * The transformation to spectral space
+ *   1) computes the real-to-complex FFTs of all local rows,
+ *   2) redistributes the data with a global transpose (MPI_Alltoallv) and
+ *   3) computes the complex FFTs in y-direction of all local columns.
+ * The backward transformation executes these steps in reverse order.
+ *
+ * The max. number of ranks is given by min(ny, nx/2+1).
+ * The transformations are reentrant, all temporary buffers are allocated
+ * with the MemBlockAlloc.
+ */
+class PlaneDataConfigDistributed
+{
+public:
+	/// Global physical resolution
+	std::size_t physical_res[2];
+
+	/// Global size of spectral data (nx/2+1, ny)
+	std::size_t spectral_data_size[2];
+
+	/// iteration ranges of non-aliased modes in global indices (see PlaneDataConfig)
+	/// 1st index (left): the id of the range,
+	/// 2nd index (middle): dimension the range,
+	/// 3rd index (last one): start and end (exclusive) index
+	std::size_t spectral_data_iteration_ranges[2][2][2];
+
+#if SWEET_MPI
+	MPI_Comm mpi_comm;
+#endif
+
+	int mpi_rank;
+	int mpi_size;
+
+	/// Local rows in physical space
+	std::size_t physical_local_y_start;
+	std::size_t physical_local_y_size;
+
+	/// number of local real valued data
+	std::size_t physical_local_array_data_number_of_elements;
+
+	/// Local wavenumbers in x-direction in spectral space
+	std::size_t spectral_local_kx_start;
+	std::size_t spectral_local_kx_size;
+
+	/// number of local complex valued data
+	std::size_t spectral_local_array_data_number_of_elements;
+
+	/// Distribution of the rows and wavenumbers of all ranks
+	std::vector<std::size_t> physical_y_start_ranks;
+	std::vector<std::size_t> physical_y_size_ranks;
+	std::vector<std::size_t> spectral_kx_start_ranks;
+	std::vector<std::size_t> spectral_kx_size_ranks;
+
+private:
+	/// Transpose between local rows (y) and local wavenumbers in x-direction
+	GlobalTranspose transpose;
+
+	/// FFTs of all local rows in x-direction
+	fftw_plan fftw_plan_x_forward;
+	fftw_plan fftw_plan_x_backward;
+
+	/// FFTs of all local columns in y-direction
+	fftw_plan fftw_plan_y_forward;
+	fftw_plan fftw_plan_y_backward;
+
+	/// Only the backward transformation is scaled (see PlaneDataConfig)
+	double fftw_backward_scale_factor;
+
+	bool initialized;
+
+
+public:
+	PlaneDataConfigDistributed()	:
+		mpi_rank(0),
+		mpi_size(1),
+		physical_local_y_start(0),
+		physical_local_y_size(0),
+		physical_local_array_data_number_of_elements(0),
+		spectral_local_kx_start(0),
+		spectral_local_kx_size(0),
+		spectral_local_array_data_number_of_elements(0),
+		fftw_plan_x_forward(nullptr),
+		fftw_plan_x_backward(nullptr),
+		fftw_plan_y_forward(nullptr),
+		fftw_plan_y_backward(nullptr),
+		fftw_backward_scale_factor(1.0),
+		initialized(false)
+	{
+		physical_res[0] = 0;
+		physical_res[1] = 0;
+		spectral_data_size[0] = 0;
+		spectral_data_size[1] = 0;
+
+#if SWEET_MPI
+		mpi_comm = MPI_COMM_WORLD;
+#endif
+	}
+
+
+	~PlaneDataConfigDistributed()
+	{
+		cleanup();
+	}
+
+
+	std::string getUniqueIDString()	const
+	{
+		std::ostringstream buf;
+		buf << "N" << physical_res[0] << "," << physical_res[1] << "_P" << mpi_size;
+		return buf.str();
+	}
+
+
+	void printInformation()	const
+	{
+		std::cout << std::endl;
+		std::cout << "physical_res: " << physical_res[0] << ", " << physical_res[1] << std::endl;
+		std::cout << "spectral_data_size: " << spectral_data_size[0] << ", " << spectral_data_size[1] << std::endl;
+		std::cout << "mpi_rank / mpi_size: " << mpi_rank << " / " << mpi_size << std::endl;
+		std::cout << "physical_local_y: " << physical_local_y_start << " + " << physical_local_y_size << std::endl;
+		std::cout << "spectral_local_kx: " << spectral_local_kx_start << " + " << spectral_local_kx_size << std::endl;
+		std::cout << std::endl;
+	}
+
+
+	/**
+	 * Setup the distribution and the FFT plans
+	 *
+	 * With MPI, this has to be called collectively by all ranks of the communicator.
+	 */
+	void setup(
+			const int i_physical_res[2],	///< global physical resolution
+			int i_reuse_spectral_transformation_plans	///< -1: estimate plans, otherwise measure them
+#if SWEET_MPI
+			, MPI_Comm i_mpi_comm = MPI_COMM_WORLD
+#endif
+	)
+	{
+		cleanup();
+
+		physical_res[0] = i_physical_res[0];
+		physical_res[1] = i_physical_res[1];
+
+		if (physical_res[0] == 0 || physical_res[1] == 0)
+			FatalError("PlaneDataConfigDistributed: Resolution must be > 0");
+
+		if ((physical_res[0] & 1) == 1)
+			FatalError("Unsupported odd resolution in x-direction");
+
+		if ((physical_res[1] & 1) == 1)
+			FatalError("Unsupported odd resolution in y-direction");
+
+		spectral_data_size[0] = physical_res[0]/2+1;
+		spectral_data_size[1] = physical_res[1];
+
+#if SWEET_MPI
+		mpi_comm = i_mpi_comm;
+		MPI_Comm_rank(mpi_comm, &mpi_rank);
+		MPI_Comm_size(mpi_comm, &mpi_size);
+#else
+		mpi_rank = 0;
+		mpi_size = 1;
+#endif
+
+		if ((std::size_t)mpi_size > physical_res[1] || (std::size_t)mpi_size > spectral_data_size[0])
+			FatalError("PlaneDataConfigDistributed: More ranks than rows or wavenumbers in x-direction");
+
+		p_setup_iteration_ranges();
+
+		GlobalTranspose::distributeBlocks(physical_res[1], mpi_size, physical_y_start_ranks, physical_y_size_ranks);
+		GlobalTranspose::distributeBlocks(spectral_data_size[0], mpi_size, spectral_kx_start_ranks, spectral_kx_size_ranks);
+
+		transpose.setup(
+				physical_y_start_ranks, physical_y_size_ranks,
+				spectral_kx_start_ranks, spectral_kx_size_ranks,
+				mpi_rank
+#if SWEET_MPI
+				, mpi_comm
+#endif
+			);
+
+		physical_local_y_start = physical_y_start_ranks[mpi_rank];
+		physical_local_y_size = physical_y_size_ranks[mpi_rank];
+		physical_local_array_data_number_of_elements = physical_local_y_size*physical_res[0];
+
+		spectral_local_kx_start = spectral_kx_start_ranks[mpi_rank];
+		spectral_local_kx_size = spectral_kx_size_ranks[mpi_rank];
+		spectral_local_array_data_number_of_elements = spectral_local_kx_size*spectral_data_size[1];
+
+		p_setup_plans(i_reuse_spectral_transformation_plans);
+
+		fftw_backward_scale_factor = 1.0/((double)(physical_res[0]*physical_res[1]));
+
+		initialized = true;
+	}
+
+
+	void cleanup()
+	{
+		if (!initialized)
+			return;
+
+		fftw_destroy_plan(fftw_plan_x_forward);
+		fftw_destroy_plan(fftw_plan_x_backward);
+		fftw_destroy_plan(fftw_plan_y_forward);
+		fftw_destroy_plan(fftw_plan_y_backward);
+
+		fftw_plan_x_forward = nullptr;
+		fftw_plan_x_backward = nullptr;
+		fftw_plan_y_forward = nullptr;
+		fftw_plan_y_backward = nullptr;
+
+		initialized = false;
+	}
+
+
+
+	/**
+	 * Wavenumber index in y-direction including the sign
+	 */
+	inline
+	int getSpectralWavenumberY(
+			std::size_t i_ky
+	)	const
+	{
+		if (i_ky <= spectral_data_size[1]/2)
+			return (int)i_ky;
+
+		return (int)i_ky - (int)spectral_data_size[1];
+	}
+
+
+	/**
+	 * Return true if the mode (global indices) is not removed by the dealiasing
+	 */
+	inline
+	bool isSpectralModeNonAliased(
+			std::size_t i_kx,
+			std::size_t i_ky
+	)	const
+	{
+		if (i_kx >= spectral_data_iteration_ranges[0][0][1])
+			return false;
+
+		return	i_ky < spectral_data_iteration_ranges[0][1][1] ||
+				i_ky >= spectral_data_iteration_ranges[1][1][0];
+	}
+
+
+
+	/**
+	 * Transform local rows in physical space to local columns in spectral space
+	 *
+	 * Collective operation with MPI
+	 */
+	void fft_physical_to_spectral(
+			const double *i_physical_data,
+			std::complex<double> *o_spectral_data
+	)	const
+	{
+		std::size_t rows_size = physical_local_y_size*spectral_data_size[0];
+		std::complex<double> *rows = MemBlockAlloc::alloc< std::complex<double> >(rows_size*sizeof(std::complex<double>));
+
+		// 1D real-to-complex FFTs preserve the input
+		fftw_execute_dft_r2c(fftw_plan_x_forward, (double*)i_physical_data, (fftw_complex*)rows);
+
+		transpose.rowsToColumns(rows, spectral_data_size[0], o_spectral_data);
+
+		fftw_execute_dft(fftw_plan_y_forward, (fftw_complex*)o_spectral_data, (fftw_complex*)o_spectral_data);
+
+		MemBlockAlloc::free(rows, rows_size*sizeof(std::complex<double>));
+	}
+
+
+	/**
+	 * Transform local columns in spectral space to local rows in physical space
+	 *
+	 * Collective operation with MPI
+	 */
+	void fft_spectral_to_physical(
+			const std::complex<double> *i_spectral_data,
+			double *o_physical_data
+	)	const
+	{
+		std::size_t columns_size = spectral_local_array_data_number_of_elements;
+		std::complex<double> *columns = MemBlockAlloc::alloc< std::complex<double> >(columns_size*sizeof(std::complex<double>));
+
+		std::size_t rows_size = physical_local_y_size*spectral_data_size[0];
+		std::complex<double> *rows = MemBlockAlloc::alloc< std::complex<double> >(rows_size*sizeof(std::complex<double>));
+
+		fftw_execute_dft(fftw_plan_y_backward, (fftw_complex*)i_spectral_data, (fftw_complex*)columns);
+
+		transpose.columnsToRows(columns, rows, spectral_data_size[0]);
+
+		// destroys the rows
+		fftw_execute_dft_c2r(fftw_plan_x_backward, (fftw_complex*)rows, o_physical_data);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (std::size_t i = 0; i < physical_local_array_data_number_of_elements; i++)
+			o_physical_data[i] *= fftw_backward_scale_factor;
+
+		MemBlockAlloc::free(rows, rows_size*sizeof(std::complex<double>));
+		MemBlockAlloc::free(columns, columns_size*sizeof(std::complex<double>));
+	}
+
+
+
+private:
+	/**
+	 * Same ranges as in PlaneDataConfig
+	 */
+	void p_setup_iteration_ranges()
+	{
+#if SWEET_USE_PLANE_SPECTRAL_DEALIASING
+		spectral_data_iteration_ranges[0][0][0] = 0;
+		spectral_data_iteration_ranges[0][0][1] = (physical_res[0]-1)/3;
+		spectral_data_iteration_ranges[0][1][0] = 0;
+		spectral_data_iteration_ranges[0][1][1] = (physical_res[1]-1)/3;
+#else
+		// Remove Shannon-Nyquist modes
+		spectral_data_iteration_ranges[0][0][0] = 0;
+		spectral_data_iteration_ranges[0][0][1] = spectral_data_size[0]-1;
+		spectral_data_iteration_ranges[0][1][0] = 0;
+		spectral_data_iteration_ranges[0][1][1] = spectral_data_size[1]/2;
+#endif
+
+		spectral_data_iteration_ranges[1][0][0] = spectral_data_iteration_ranges[0][0][0];
+		spectral_data_iteration_ranges[1][0][1] = spectral_data_iteration_ranges[0][0][1];
+		spectral_data_iteration_ranges[1][1][0] = spectral_data_size[1] - spectral_data_iteration_ranges[0][1][1] + 1;
+		spectral_data_iteration_ranges[1][1][1] = spectral_data_size[1];
+	}
+
+
+
+	void p_setup_plans(
+			int i_reuse_spectral_transformation_plans
+	)
+	{
+#if SWEET_THREADING_SPACE && !SWEET_THREADING_TIME_REXI
+		static bool fftw_threads_initialized = false;
+
+		if (!fftw_threads_initialized)
+		{
+			if (fftw_init_threads() == 0)
+				FatalError("fftw_init_threads() failed");
+
+			fftw_threads_initialized = true;
+		}
+
+		fftw_plan_with_nthreads(omp_get_max_threads());
+#endif
+
+		unsigned int flags = FFTW_MEASURE;
+		if (i_reuse_spectral_transformation_plans == -1)
+			flags = FFTW_ESTIMATE;
+
+		std::size_t nx = physical_res[0];
+		std::size_t ny = physical_res[1];
+		std::size_t nkx = spectral_data_size[0];
+
+		std::size_t rows_size = physical_local_y_size*nkx;
+		std::size_t columns_size = spectral_local_array_data_number_of_elements;
+
+		// Plans are created with dummy buffers since measuring overwrites them
+		double *data_physical = MemBlockAlloc::alloc<double>(physical_local_array_data_number_of_elements*sizeof(double));
+		std::complex<double> *data_rows = MemBlockAlloc::alloc< std::complex<double> >(rows_size*sizeof(std::complex<double>));
+		std::complex<double> *data_columns = MemBlockAlloc::alloc< std::complex<double> >(columns_size*sizeof(std::complex<double>));
+		std::complex<double> *data_columns2 = MemBlockAlloc::alloc< std::complex<double> >(columns_size*sizeof(std::complex<double>));
+
+		int n_x[1] = {(int)nx};
+		int n_y[1] = {(int)ny};
+
+		fftw_plan_x_forward = fftw_plan_many_dft_r2c(
+				1, n_x, physical_local_y_size,
+				data_physical, nullptr, 1, nx,
+				(fftw_complex*)data_rows, nullptr, 1, nkx,
+				flags | FFTW_PRESERVE_INPUT
+			);
+
+		fftw_plan_x_backward = fftw_plan_many_dft_c2r(
+				1, n_x, physical_local_y_size,
+				(fftw_complex*)data_rows, nullptr, 1, nkx,
+				data_physical, nullptr, 1, nx,
+				flags
+			);
+
+		// in-place
+		fftw_plan_y_forward = fftw_plan_many_dft(
+				1, n_y, spectral_local_kx_size,
+				(fftw_complex*)data_columns, nullptr, 1, ny,
+				(fftw_complex*)data_columns, nullptr, 1, ny,
+				FFTW_FORWARD, flags
+			);
+
+		// out-of-place to preserve the spectral data
+		fftw_plan_y_backward = fftw_plan_many_dft(
+				1, n_y, spectral_local_kx_size,
+				(fftw_complex*)data_columns, nullptr, 1, ny,
+				(fftw_complex*)data_columns2, nullptr, 1, ny,
+				FFTW_BACKWARD, flags | FFTW_PRESERVE_INPUT
+			);
+
+		if (	fftw_plan_x_forward == nullptr || fftw_plan_x_backward == nullptr ||
+				fftw_plan_y_forward == nullptr || fftw_plan_y_backward == nullptr
+		)
+			FatalError("PlaneDataConfigDistributed: Failed to create FFTW plans");
+
+		MemBlockAlloc::free(data_physical, physical_local_array_data_number_of_elements*sizeof(double));
+		MemBlockAlloc::free(data_rows, rows_size*sizeof(std::complex<double>));
+		MemBlockAlloc::free(data_columns, columns_size*sizeof(std::complex<double>));
+		MemBlockAlloc::free(data_columns2, columns_size*sizeof(std::complex<double>));
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_PLANE_PLANEDATACONFIGDISTRIBUTED_HPP_ */
@@ -0,0 +1,679 @@
+/*
+ * PlaneDataDistributed.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_PLANE_PLANEDATADISTRIBUTED_HPP_
+#define SRC_INCLUDE_SWEET_PLANE_PLANEDATADISTRIBUTED_HPP_
+
+#include <complex>
+#include <cmath>
+#include <limits>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <iomanip>
+#include <sweet/MemBlockAlloc.hpp>
+#include <sweet/FatalError.hpp>
+#include <sweet/openmp_helper.hpp>
+#include <sweet/plane/PlaneDataConfigDistributed.hpp>
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
+
+
+
+/*
+ * Loops over the local data, see PLANE_DATA_PHYSICAL_FOR_IDX
+ */
+#define PLANE_DATA_DISTRIBUTED_PHYSICAL_FOR_IDX(CORE)				\
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD			\
+		for (std::size_t idx = 0; idx < planeDataConfig->physical_local_array_data_number_of_elements; idx++)	\
+		{	CORE;	}
+
+#define PLANE_DATA_DISTRIBUTED_SPECTRAL_FOR_IDX(CORE)				\
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD			\
+		for (std::size_t idx = 0; idx < planeDataConfig->spectral_local_array_data_number_of_elements; idx++)	\
+		{	CORE;	}
+
+
+
+/**
+ * Plane data distributed over MPI ranks (see PlaneDataConfigDistributed)
+ *
+ * Only the local rows (physical space) and the local wavenumbers in
+ * x-direction (spectral space) are stored.
+ *
+ * Since the transformations between physical and spectral space
+ * include a global transpose, all operations which might
+ * trigger a transformation and all reductions are collective:
+ * They have to be executed by all ranks in the same order.
+ */
+class PlaneDataDistributed
+{
+public:
+	const PlaneDataConfigDistributed *planeDataConfig;
+
+	double *physical_space_data;
+	bool physical_space_data_valid;
+
+	/// layout [kx-kx_start][ky]
+	std::complex<double> *spectral_space_data;
+	bool spectral_space_data_valid;
+
+
+private:
+	void p_allocate_buffers()
+	{
+		physical_space_data = MemBlockAlloc::alloc<double>(
+				planeDataConfig->physical_local_array_data_number_of_elements*sizeof(double)
+			);
+
+		spectral_space_data = MemBlockAlloc::alloc< std::complex<double> >(
+				planeDataConfig->spectral_local_array_data_number_of_elements*sizeof(std::complex<double>)
+			);
+	}
+
+
+	void p_free_buffers()
+	{
+		if (planeDataConfig == nullptr)
+			return;
+
+		if (physical_space_data != nullptr)
+			MemBlockAlloc::free(physical_space_data, planeDataConfig->physical_local_array_data_number_of_elements*sizeof(double));
+
+		if (spectral_space_data != nullptr)
+			MemBlockAlloc::free(spectral_space_data, planeDataConfig->spectral_local_array_data_number_of_elements*sizeof(std::complex<double>));
+
+		physical_space_data = nullptr;
+		spectral_space_data = nullptr;
+	}
+
+
+public:
+	PlaneDataDistributed(
+			const PlaneDataConfigDistributed *i_planeDataConfig
+	)	:
+		planeDataConfig(i_planeDataConfig),
+		physical_space_data(nullptr),
+		physical_space_data_valid(false),
+		spectral_space_data(nullptr),
+		spectral_space_data_valid(false)
+	{
+		assert(planeDataConfig != nullptr);
+		p_allocate_buffers();
+	}
+
+
+	PlaneDataDistributed(
+			const PlaneDataDistributed &i_data
+	)	:
+		planeDataConfig(i_data.planeDataConfig),
+		physical_space_data(nullptr),
+		physical_space_data_valid(i_data.physical_space_data_valid),
+		spectral_space_data(nullptr),
+		spectral_space_data_valid(i_data.spectral_space_data_valid)
+	{
+		p_allocate_buffers();
+		p_copy_data(i_data);
+	}
+
+
+	PlaneDataDistributed(
+			PlaneDataDistributed &&i_data
+	)	:
+		planeDataConfig(i_data.planeDataConfig),
+		physical_space_data(i_data.physical_space_data),
+		physical_space_data_valid(i_data.physical_space_data_valid),
+		spectral_space_data(i_data.spectral_space_data),
+		spectral_space_data_valid(i_data.spectral_space_data_valid)
+	{
+		i_data.physical_space_data = nullptr;
+		i_data.spectral_space_data = nullptr;
+	}
+
+
+	~PlaneDataDistributed()
+	{
+		p_free_buffers();
+	}
+
+
+	PlaneDataDistributed &operator=(
+			const PlaneDataDistributed &i_data
+	)
+	{
+		if (this == &i_data)
+			return *this;
+
+		if (planeDataConfig != i_data.planeDataConfig)
+			FatalError("PlaneDataDistributed: Assignment between different configurations not supported");
+
+		physical_space_data_valid = i_data.physical_space_data_valid;
+		spectral_space_data_valid = i_data.spectral_space_data_valid;
+		p_copy_data(i_data);
+
+		return *this;
+	}
+
+
+	PlaneDataDistributed &operator=(
+			PlaneDataDistributed &&i_data
+	)
+	{
+		if (planeDataConfig != i_data.planeDataConfig)
+			FatalError("PlaneDataDistributed: Assignment between different configurations not supported");
+
+		std::swap(physical_space_data, i_data.physical_space_data);
+		std::swap(spectral_space_data, i_data.spectral_space_data);
+		physical_space_data_valid = i_data.physical_space_data_valid;
+		spectral_space_data_valid = i_data.spectral_space_data_valid;
+
+		return *this;
+	}
+
+
+private:
+	void p_copy_data(
+			const PlaneDataDistributed &i_data
+	)
+	{
+		if (physical_space_data_valid)
+		{
+			PLANE_DATA_DISTRIBUTED_PHYSICAL_FOR_IDX(
+					physical_space_data[idx] = i_data.physical_space_data[idx];
+			);
+		}
+
+		if (spectral_space_data_valid)
+		{
+			PLANE_DATA_DISTRIBUTED_SPECTRAL_FOR_IDX(
+					spectral_space_data[idx] = i_data.spectral_space_data[idx];
+			);
+		}
+	}
+
+
+
+public:
+	/**
+	 * Collective transformation to spectral space
+	 */
+	void request_data_spectral()	const
+	{
+		if (spectral_space_data_valid)
+			return;
+
+		PlaneDataDistributed *rw_data = (PlaneDataDistributed*)this;
+
+#if SWEET_DEBUG
+		if (!physical_space_data_valid)
+			FatalError("Spectral data not available! Did you set the data to something?");
+#endif
+
+		planeDataConfig->fft_physical_to_spectral(rw_data->physical_space_data, rw_data->spectral_space_data);
+
+		rw_data->spectral_space_data_valid = true;
+		rw_data->physical_space_data_valid = false;
+
+		// ALWAYS zero out aliasing modes after doing transformation to spectral space
+		rw_data->spectral_zeroAliasingModes();
+	}
+
+
+	/**
+	 * Collective transformation to physical space
+	 */
+	void request_data_physical()	const
+	{
+		if (physical_space_data_valid)
+			return;
+
+		PlaneDataDistributed *rw_data = (PlaneDataDistributed*)this;
+
+#if SWEET_DEBUG
+		if (!spectral_space_data_valid)
+			FatalError("Physical data not available and no spectral data!");
+#endif
+
+		planeDataConfig->fft_spectral_to_physical(rw_data->spectral_space_data, rw_data->physical_space_data);
+
+		rw_data->spectral_space_data_valid = false;
+		rw_data->physical_space_data_valid = true;
+	}
+
+
+
+	void spectral_zeroAliasingModes()
+	{
+		assert(spectral_space_data_valid);
+
+		std::size_t ny = planeDataConfig->spectral_data_size[1];
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (std::size_t kx = 0; kx < planeDataConfig->spectral_local_kx_size; kx++)
+		{
+			std::size_t gkx = planeDataConfig->spectral_local_kx_start + kx;
+
+			for (std::size_t ky = 0; ky < ny; ky++)
+				if (!planeDataConfig->isSpectralModeNonAliased(gkx, ky))
+					spectral_space_data[kx*ny + ky] = 0;
+		}
+	}
+
+
+
+	void physical_set_zero()
+	{
+		PLANE_DATA_DISTRIBUTED_PHYSICAL_FOR_IDX(
+				physical_space_data[idx] = 0;
+		);
+
+		physical_space_data_valid = true;
+		spectral_space_data_valid = false;
+	}
+
+
+	void spectral_set_zero()
+	{
+		PLANE_DATA_DISTRIBUTED_SPECTRAL_FOR_IDX(
+				spectral_space_data[idx] = 0;
+		);
+
+		physical_space_data_valid = false;
+		spectral_space_data_valid = true;
+	}
+
+
+
+	/**
+	 * Set the local physical data with global indices (i, j) = (x, y)
+	 *
+	 * Collective if the anti-aliasing rule is applied
+	 */
+	void physical_update_lambda_array_indices(
+			std::function<void(int,int,double&)> i_lambda,
+			bool i_anti_aliasing = true
+	)
+	{
+		if (spectral_space_data_valid)
+			request_data_physical();
+
+		std::size_t nx = planeDataConfig->physical_res[0];
+		std::size_t y_start = planeDataConfig->physical_local_y_start;
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (std::size_t j = 0; j < planeDataConfig->physical_local_y_size; j++)
+			for (std::size_t i = 0; i < nx; i++)
+				i_lambda(i, y_start+j, physical_space_data[j*nx + i]);
+
+		physical_space_data_valid = true;
+		spectral_space_data_valid = false;
+
+		// request data in spectral space automatically leads to applying anti-aliasing rule
+		if (i_anti_aliasing)
+			request_data_spectral();
+	}
+
+
+	/**
+	 * Set the local physical data with global cell centered unit coordinates (x, y) in [0;1[
+	 */
+	void physical_update_lambda_unit_coordinates_cell_centered(
+			std::function<void(double,double,double&)> i_lambda,
+			bool i_anti_aliasing = true
+	)
+	{
+		double nx = planeDataConfig->physical_res[0];
+		double ny = planeDataConfig->physical_res[1];
+
+		physical_update_lambda_array_indices(
+			[&](int i, int j, double &io_data)
+			{
+				i_lambda(((double)i+0.5)/nx, ((double)j+0.5)/ny, io_data);
+			},
+			i_anti_aliasing
+		);
+	}
+
+
+
+	/**
+	 * Compute this + i_scale*i_data, in spectral space if possible
+	 */
+	PlaneDataDistributed p_axpy(
+			const PlaneDataDistributed &i_data,
+			double i_scale
+	)	const
+	{
+		PlaneDataDistributed out(planeDataConfig);
+
+		if (spectral_space_data_valid || i_data.spectral_space_data_valid)
+		{
+			request_data_spectral();
+			i_data.request_data_spectral();
+
+			PLANE_DATA_DISTRIBUTED_SPECTRAL_FOR_IDX(
+					out.spectral_space_data[idx] = spectral_space_data[idx] + i_scale*i_data.spectral_space_data[idx];
+			);
+
+			out.spectral_space_data_valid = true;
+		}
+		else
+		{
+			PLANE_DATA_DISTRIBUTED_PHYSICAL_FOR_IDX(
+					out.physical_space_data[idx] = physical_space_data[idx] + i_scale*i_data.physical_space_data[idx];
+			);
+
+			out.physical_space_data_valid = true;
+		}
+
+		return out;
+	}
+
+
+	PlaneDataDistributed operator+(
+			const PlaneDataDistributed &i_data
+	)	const
+	{
+		return p_axpy(i_data, 1.0);
+	}
+
+
+	PlaneDataDistributed operator-(
+			const PlaneDataDistributed &i_data
+	)	const
+	{
+		return p_axpy(i_data, -1.0);
+	}
+
+
+	PlaneDataDistributed& operator+=(
+			const PlaneDataDistributed &i_data
+	)
+	{
+		*this = *this + i_data;
+		return *this;
+	}
+
+
+	PlaneDataDistributed& operator-=(
+			const PlaneDataDistributed &i_data
+	)
+	{
+		*this = *this - i_data;
+		return *this;
+	}
+
+
+	/**
+	 * Element-wise multiplication in physical space (collective with dealiasing)
+	 */
+	PlaneDataDistributed operator*(
+			const PlaneDataDistributed &i_data
+	)	const
+	{
+		PlaneDataDistributed out(planeDataConfig);
+
+		request_data_physical();
+		i_data.request_data_physical();
+
+		PLANE_DATA_DISTRIBUTED_PHYSICAL_FOR_IDX(
+				out.physical_space_data[idx] = physical_space_data[idx]*i_data.physical_space_data[idx];
+		);
+
+		out.physical_space_data_valid = true;
+
+#if SWEET_USE_PLANE_SPECTRAL_DEALIASING
+		// Zero out modes (collective)
+		out.request_data_spectral();
+#endif
+
+		return out;
+	}
+
+
+	PlaneDataDistributed operator*(
+			double i_value
+	)	const
+	{
+		PlaneDataDistributed out(planeDataConfig);
+
+		if (spectral_space_data_valid)
+		{
+			PLANE_DATA_DISTRIBUTED_SPECTRAL_FOR_IDX(
+					out.spectral_space_data[idx] = spectral_space_data[idx]*i_value;
+			);
+
+			out.spectral_space_data_valid = true;
+		}
+		else
+		{
+			PLANE_DATA_DISTRIBUTED_PHYSICAL_FOR_IDX(
+					out.physical_space_data[idx] = physical_space_data[idx]*i_value;
+			);
+
+			out.physical_space_data_valid = true;
+		}
+
+		return out;
+	}
+
+
+	PlaneDataDistributed operator-()	const
+	{
+		return *this*(-1.0);
+	}
+
+
+	/**
+	 * Add a constant to the mode with wavenumber 0 (stored on the first rank)
+	 */
+	PlaneDataDistributed operator+(
+			double i_value
+	)	const
+	{
+		request_data_spectral();
+
+		PlaneDataDistributed out = *this;
+
+		if (planeDataConfig->spectral_local_kx_start == 0)
+			out.spectral_space_data[0] += i_value*(double)(planeDataConfig->physical_res[0]*planeDataConfig->physical_res[1]);
+
+		return out;
+	}
+
+
+
+	/**
+	 * Compute this = i_beta*i_x + sum_j i_alpha[j]*i_y[j] in spectral space
+	 * (see PlaneData::set_linear_combination)
+	 */
+	PlaneDataDistributed& set_linear_combination(
+			double i_beta,
+			const PlaneDataDistributed &i_x,
+			int i_num_y,
+			const double *i_alpha,
+			const PlaneDataDistributed * const *i_y
+	)
+	{
+#if SWEET_DEBUG
+		for (int j = 0; j < i_num_y; j++)
+			if (i_y[j] == this)
+				FatalError("Output array must not be part of the sum");
+#endif
+
+		i_x.request_data_spectral();
+		for (int j = 0; j < i_num_y; j++)
+			i_y[j]->request_data_spectral();
+
+		PLANE_DATA_DISTRIBUTED_SPECTRAL_FOR_IDX(
+				std::complex<double> v = i_beta*i_x.spectral_space_data[idx];
+				for (int j = 0; j < i_num_y; j++)
+					v += i_alpha[j]*i_y[j]->spectral_space_data[idx];
+				spectral_space_data[idx] = v;
+		);
+
+		spectral_space_data_valid = true;
+		physical_space_data_valid = false;
+
+		spectral_zeroAliasingModes();
+
+		return *this;
+	}
+
+
+
+	/**
+	 * Collective reductions over all ranks
+	 */
+	double reduce_maxAbs()	const
+	{
+		request_data_physical();
+
+		double maxabs = 0;
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for PROC_BIND_CLOSE reduction(max:maxabs)
+#endif
+		for (std::size_t idx = 0; idx < planeDataConfig->physical_local_array_data_number_of_elements; idx++)
+			maxabs = std::max(maxabs, std::abs(physical_space_data[idx]));
+
+		return p_allreduce(maxabs, true);
+	}
+
+
+	double reduce_sum()	const
+	{
+		request_data_physical();
+
+		double sum = 0;
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for PROC_BIND_CLOSE reduction(+:sum)
+#endif
+		for (std::size_t idx = 0; idx < planeDataConfig->physical_local_array_data_number_of_elements; idx++)
+			sum += physical_space_data[idx];
+
+		return p_allreduce(sum, false);
+	}
+
+
+	double reduce_rms()	const
+	{
+		request_data_physical();
+
+		double sum = 0;
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for PROC_BIND_CLOSE reduction(+:sum)
+#endif
+		for (std::size_t idx = 0; idx < planeDataConfig->physical_local_array_data_number_of_elements; idx++)
+			sum += physical_space_data[idx]*physical_space_data[idx];
+
+		sum = p_allreduce(sum, false);
+
+		return std::sqrt(sum/(double)(planeDataConfig->physical_res[0]*planeDataConfig->physical_res[1]));
+	}
+
+
+	/**
+	 * Collective output of the physical data to an ASCII file
+	 * in the same format as PlaneData::file_physical_saveData_ascii().
+	 *
+	 * The rows are written from top to bottom, hence the ranks append
+	 * their local rows one after another starting with the last rank.
+	 * The data is never gathered on a single rank.
+	 */
+	void file_physical_saveData_ascii(
+			const char *i_filename,		///< Name of file to store data to
+			char i_separator = '\t',	///< separator to use for each line
+			int i_precision = 16		///< number of floating point digits
+	)	const
+	{
+		request_data_physical();
+
+		std::size_t nx = planeDataConfig->physical_res[0];
+
+		for (int r = planeDataConfig->mpi_size-1; r >= 0; r--)
+		{
+			if (r == planeDataConfig->mpi_rank)
+			{
+				bool first = (r == planeDataConfig->mpi_size-1);
+
+				std::ofstream file(i_filename, first ? std::ios_base::trunc : std::ios_base::app);
+				file << std::setprecision(i_precision);
+
+				if (first)
+				{
+					file << "#SWEET" << std::endl;
+					file << "#FORMAT ASCII" << std::endl;
+					file << "#PRIMITIVE PLANE" << std::endl;
+					file << "#SPACE PHYSICAL" << std::endl;
+					file << "#RESX " << planeDataConfig->physical_res[0] << std::endl;
+					file << "#RESY " << planeDataConfig->physical_res[1] << std::endl;
+				}
+
+				for (int y = (int)planeDataConfig->physical_local_y_size-1; y >= 0; y--)
+				{
+					for (std::size_t x = 0; x < nx; x++)
+					{
+						file << physical_space_data[y*nx+x];
+
+						if (x < nx-1)
+							file << i_separator;
+						else
+							file << std::endl;
+					}
+				}
+			}
+
+#if SWEET_MPI
+			MPI_Barrier(planeDataConfig->mpi_comm);
+#endif
+		}
+	}
+
+
+
+private:
+	double p_allreduce(
+			double i_value,
+			bool i_max		///< max. instead of sum
+	)	const
+	{
+#if SWEET_MPI
+		MPI_Allreduce(MPI_IN_PLACE, &i_value, 1, MPI_DOUBLE, i_max ? MPI_MAX : MPI_SUM, planeDataConfig->mpi_comm);
+#endif
+		return i_value;
+	}
+};
+
+
+
+inline
+PlaneDataDistributed operator*(
+		double i_value,
+		const PlaneDataDistributed &i_data
+)
+{
+	return i_data*i_value;
+}
+
+
+
+inline
+PlaneDataDistributed operator+(
+		double i_value,
+		const PlaneDataDistributed &i_data
+)
+{
+	return i_data+i_value;
+}
+
+
+
+#endif /* SRC_INCLUDE_SWEET_PLANE_PLANEDATADISTRIBUTED_HPP_ */
@@ -8,6 +8,8 @@
 #define SRC_INCLUDE_SWEET_PLANEDATASAMPLER_HPP_
 
 #include <sweet/ScalarDataArray.hpp>
+#include <sweet/SimulationProfiler.hpp>
+#include <sweet/KernelCounters.hpp>
 //#include "PlaneDataComplex.hpp"
 
 
@@ -147,6 +149,8 @@ public:
 			double i_shift_y = 0.0				///< shift in y for staggered grids
 	)
 	{
+		SWEET_PROFILER_REGION("sl_interpolation");
+
 		assert(res[0] > 0);
 		assert(cached_scale_factor[0] > 0);
 		assert(i_pos_x.number_of_elements == i_pos_y.number_of_elements);
@@ -163,6 +167,16 @@ public:
 #endif
 #endif
 
+		/*
+		 * 5 cubic interpolations (~19 FLOPs each) and position computations per point.
+		 * Compulsory traffic: positions and output per point and the sampled field once.
+		 */
+		SWEET_KERNEL_COUNTER_REGION(
+				"plane_bicubic",
+				100.0*max_pos_idx,
+				3.0*sizeof(double)*max_pos_idx + sizeof(double)*(double)i_data.planeDataConfig->physical_array_data_number_of_elements
+			);
+
 		// iterate over all positions in parallel
 		SWEET_THREADING_SPACE_PARALLEL_FOR
 		for (std::size_t pos_idx = 0; pos_idx < max_pos_idx; pos_idx++)
@@ -312,6 +326,8 @@ public:
 			double i_shift_y = 0.0
 	)
 	{
+		SWEET_PROFILER_REGION("sl_interpolation");
+
 		/*
 		 * SHIFT - important
 		 * for C grid, to interpolate given u data, use i_shift_x = 0.0,  i_shift_y = -0.5
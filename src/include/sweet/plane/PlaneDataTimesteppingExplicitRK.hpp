@@ -1,82 +1,225 @@
-
 #ifndef PLANEDATA_TIMESTEPPING_EXPLICIT_RK_HPP__
 #define PLANEDATA_TIMESTEPPING_EXPLICIT_RK_HPP__
 
+#include <vector>
+#include <sweet/TimesteppingExplicitRKTableau.hpp>
 #include "PlaneData.hpp"
+#include "PlaneDataDistributed.hpp"
+
 
-class PlaneDataTimesteppingExplicitRK
+/**
+ * Explicit Runge-Kutta time stepping
+ *
+ * This is written for arbitrary plane data types (PlaneData, PlaneDataDistributed)
+ * which provide set_linear_combination(). See the typedefs below.
+ */
+template <typename T_PlaneData, typename T_PlaneDataConfig>
+class PlaneDataTimesteppingExplicitRK_Generic
 {
-	// runge kutta data storages
-	PlaneData** RK_h_t;
-	PlaneData** RK_u_t;
-	PlaneData** RK_v_t;
+	/// Max. number of prognostic variables
+	static const int MAX_VARS = 3;
+
+	/*
+	 * Runge-Kutta data storages for each variable
+	 *
+	 * Classical methods:
+	 *   RK_buffers[v][0..num_stages-1]: Stage time tendencies k_i
+	 *   RK_buffers[v][num_stages]: Input of current stage
+	 *
+	 * Low-storage methods:
+	 *   RK_buffers[v][0]: Accumulated update dU
+	 *   RK_buffers[v][1]: Time tendency F
+	 */
+	std::vector<T_PlaneData*> RK_buffers[MAX_VARS];
 
-	int runge_kutta_order;
+	TimesteppingExplicitRKTableau tableau;
+
+	/// Use 2N-storage methods
+	bool use_low_storage;
 
 public:
-	PlaneDataTimesteppingExplicitRK()	:
-		RK_h_t(nullptr),
-		RK_u_t(nullptr),
-		RK_v_t(nullptr),
-		runge_kutta_order(-1)
+	PlaneDataTimesteppingExplicitRK_Generic()	:
+		use_low_storage(false)
 	{
 	}
 
 
 
+	/**
+	 * Use low-storage (2N) Runge-Kutta methods which only require
+	 * two buffers per variable independent of the number of stages
+	 */
+	void setLowStorage(
+			bool i_use_low_storage
+	)
+	{
+		use_low_storage = i_use_low_storage;
+	}
+
+
+
 	void setupBuffers(
-			const PlaneDataConfig *i_planeDataConfig,
+			const T_PlaneDataConfig *i_planeDataConfig,
 			int i_rk_order			///< Order of Runge-Kutta method
 	)
 	{
-		if (RK_h_t != nullptr)	///< already allocated?
-			return;
+		if (RK_buffers[0].size() != 0)	///< already allocated?
+		{
+			if (tableau.order == i_rk_order && tableau.low_storage == use_low_storage)
+				return;
 
-		runge_kutta_order = i_rk_order;
-		int N = i_rk_order;
+			free();
+		}
 
-		if (N <= 0 || N > 4)
+		if (i_rk_order <= 0 || i_rk_order > 4)
 			FatalError("Invalid order for RK time stepping (Please set --timestepping-order and/or --timestepping-order2)");
 
-		RK_h_t = new PlaneData*[N];
-		RK_u_t = new PlaneData*[N];
-		RK_v_t = new PlaneData*[N];
+		tableau.setup(i_rk_order, use_low_storage);
 
-		for (int i = 0; i < N; i++)
+		int N = tableau.getNumBuffers();
+		for (int v = 0; v < MAX_VARS; v++)
 		{
-			RK_h_t[i] = new PlaneData(i_planeDataConfig);
-			RK_u_t[i] = new PlaneData(i_planeDataConfig);
-			RK_v_t[i] = new PlaneData(i_planeDataConfig);
+			RK_buffers[v].resize(N);
+
+			for (int i = 0; i < N; i++)
+				RK_buffers[v][i] = new T_PlaneData(i_planeDataConfig);
 		}
 	}
 
 
 
-	~PlaneDataTimesteppingExplicitRK()
+private:
+	void free()
 	{
-		int N = runge_kutta_order;
+		for (int v = 0; v < MAX_VARS; v++)
+		{
+			for (std::size_t i = 0; i < RK_buffers[v].size(); i++)
+				delete RK_buffers[v][i];
+
+			RK_buffers[v].resize(0);
+		}
+	}
 
-		if (RK_h_t != nullptr)
+
+public:
+	~PlaneDataTimesteppingExplicitRK_Generic()
+	{
+		free();
+	}
+
+
+
+private:
+	/**
+	 * Generic Runge-Kutta time step for i_num_vars variables
+	 *
+	 * i_eval(i_U, o_F, t) computes the time tendencies o_F of the
+	 * prognostic variables i_U (both given as arrays of pointers).
+	 */
+	template <typename T_Eval>
+	void p_run_timestep(
+			int i_num_vars,
+			T_PlaneData **io_U,
+			T_Eval i_eval,
+			double i_dt,
+			double i_simulation_time
+	)
+	{
+		const T_PlaneData *U_stage[MAX_VARS];
+		T_PlaneData *F[MAX_VARS];
+
+		if (tableau.low_storage)
 		{
-			for (int i = 0; i < N; i++)
+			for (int v = 0; v < i_num_vars; v++)
+			{
+				U_stage[v] = io_U[v];
+				F[v] = RK_buffers[v][1];
+			}
+
+			for (int i = 0; i < tableau.num_stages; i++)
+			{
+				i_eval(U_stage, F, i_simulation_time + tableau.c[i]*i_dt);
+
+				for (int v = 0; v < i_num_vars; v++)
+				{
+					T_PlaneData &dU = *RK_buffers[v][0];
+
+					// dU = A[i]*dU + dt*F (dU is not initialized in the first stage)
+					if (tableau.A[i] == 0)
+					{
+						dU.set_linear_combination(i_dt, *F[v], 0, nullptr, nullptr);
+					}
+					else
+					{
+						const T_PlaneData *y[1] = {F[v]};
+						double alpha[1] = {i_dt};
+						dU.set_linear_combination(tableau.A[i], dU, 1, alpha, y);
+					}
+
+					// U = U + B[i]*dU
+					const T_PlaneData *y2[1] = {&dU};
+					double alpha2[1] = {tableau.B[i]};
+					io_U[v]->set_linear_combination(1.0, *io_U[v], 1, alpha2, y2);
+				}
+			}
+			return;
+		}
+
+		const T_PlaneData *y[TimesteppingExplicitRKTableau::MAX_STAGES];
+		double alpha[TimesteppingExplicitRKTableau::MAX_STAGES];
+
+		for (int i = 0; i < tableau.num_stages; i++)
+		{
+			for (int v = 0; v < i_num_vars; v++)
 			{
-				delete RK_h_t[i];
-				delete RK_u_t[i];
-				delete RK_v_t[i];
+				F[v] = RK_buffers[v][i];
+
+				if (i == 0)
+				{
+					U_stage[v] = io_U[v];
+					continue;
+				}
+
+				// Stage input U + dt*sum_j a_ij*k_j, skipping zero coefficients
+				int n = 0;
+				for (int j = 0; j < i; j++)
+				{
+					if (tableau.get_a(i, j) == 0)
+						continue;
+
+					y[n] = RK_buffers[v][j];
+					alpha[n] = i_dt*tableau.get_a(i, j);
+					n++;
+				}
+
+				T_PlaneData *stage = RK_buffers[v][tableau.num_stages];
+				stage->set_linear_combination(1.0, *io_U[v], n, alpha, y);
+				U_stage[v] = stage;
 			}
 
-			delete [] RK_h_t;
-			delete [] RK_u_t;
-			delete [] RK_v_t;
+			i_eval(U_stage, F, i_simulation_time + tableau.c[i]*i_dt);
+		}
 
-			RK_h_t = nullptr;
-			RK_u_t = nullptr;
-			RK_v_t = nullptr;
+		for (int v = 0; v < i_num_vars; v++)
+		{
+			int n = 0;
+			for (int j = 0; j < tableau.num_stages; j++)
+			{
+				if (tableau.b[j] == 0)
+					continue;
+
+				y[n] = RK_buffers[v][j];
+				alpha[n] = i_dt*tableau.b[j];
+				n++;
+			}
+
+			io_U[v]->set_linear_combination(1.0, *io_U[v], n, alpha, y);
 		}
 	}
 
 
 
+public:
 	/**
 	 * execute a Runge-Kutta timestep with the order
 	 * specified in the simulation variables.
@@ -85,20 +228,20 @@ public:
 	void run_timestep(
 			BaseClass *i_baseClass,
 			void (BaseClass::*i_compute_euler_timestep_update)(
-					const PlaneData &i_P,	///< prognostic variables
-					const PlaneData &i_u,	///< prognostic variables
-					const PlaneData &i_v,	///< prognostic variables
+					const T_PlaneData &i_P,	///< prognostic variables
+					const T_PlaneData &i_u,	///< prognostic variables
+					const T_PlaneData &i_v,	///< prognostic variables
 
-					PlaneData &o_P_t,	///< time updates
-					PlaneData &o_u_t,	///< time updates
-					PlaneData &o_v_t,	///< time updates
+					T_PlaneData &o_P_t,	///< time updates
+					T_PlaneData &o_u_t,	///< time updates
+					T_PlaneData &o_v_t,	///< time updates
 
 					double i_simulation_time	///< simulation time, e.g. for tidal waves
 			),
 
-			PlaneData &io_var0,
-			PlaneData &io_var1,
-			PlaneData &io_var2,
+			T_PlaneData &io_var0,
+			T_PlaneData &io_var1,
+			T_PlaneData &io_var2,
 
 			double i_dt = 0,				///< Use this time step size
 			int i_runge_kutta_order = 1,	///< Order of RK time stepping
@@ -108,193 +251,29 @@ public:
 	{
 		setupBuffers(io_var0.planeDataConfig, i_runge_kutta_order);
 
-		if (i_runge_kutta_order == 1)
-		{
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0,	// input
-					io_var1,
-					io_var2,
-					*RK_h_t[0],	// output
-					*RK_u_t[0],
-					*RK_v_t[0],
-					i_simulation_time
-			);
-
-
-			io_var0 += i_dt**RK_h_t[0];
-			io_var1 += i_dt**RK_u_t[0];
-			io_var2 += i_dt**RK_v_t[0];
-
-		}
-		else if (i_runge_kutta_order == 2)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/2 | 1/2
-			 * --------------
-			 *     | 0   1    b
-			 */
-			double a2[1] = {0.5};
-			double b[2] = {0.0, 1.0};
-			double c[1] = {0.5};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0,
-					io_var1,
-					io_var2,
-					*RK_h_t[0],
-					*RK_u_t[0],
-					*RK_v_t[0],
-					i_simulation_time
-			);
-
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0 + ( i_dt*a2[0]*(*RK_h_t[0]) ),
-					io_var1 + ( i_dt*a2[0]*(*RK_u_t[0]) ),
-					io_var2 + ( i_dt*a2[0]*(*RK_v_t[0]) ),
-					*RK_h_t[1],
-					*RK_u_t[1],
-					*RK_v_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
-
-			io_var0 += i_dt*(/* b[0]*(*RK_h_t[0]) +*/ b[1]*(*RK_h_t[1]) );
-			io_var1 += i_dt*(/* b[0]*(*RK_u_t[0]) +*/ b[1]*(*RK_u_t[1]) );
-			io_var2 += i_dt*(/* b[0]*(*RK_v_t[0]) +*/ b[1]*(*RK_v_t[1]) );
-		}
-		else if (i_runge_kutta_order == 3)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/3 | 1/3
-			 * 2/3 | 0    2/3
-			 * --------------
-			 *     | 1/4  0   3/4
-			 */
-			double a2[1] = {1.0/3.0};
-			double a3[2] = {0.0, 2.0/3.0};
-			double b[3] = {1.0/4.0, 0.0, 3.0/4.0};
-			double c[2] = {1.0/3.0, 2.0/3.0};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0,
-					io_var1,
-					io_var2,
-					*RK_h_t[0],
-					*RK_u_t[0],
-					*RK_v_t[0],
-					i_simulation_time
-			);
-
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0	+ i_dt*( a2[0]*(*RK_h_t[0]) ),
-					io_var1	+ i_dt*( a2[0]*(*RK_u_t[0]) ),
-					io_var2	+ i_dt*( a2[0]*(*RK_v_t[0]) ),
-					*RK_h_t[1],
-					*RK_u_t[1],
-					*RK_v_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
-
-			// STAGE 3
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0	+ i_dt*( a3[0]*(*RK_h_t[0]) + a3[1]*(*RK_h_t[1]) ),
-					io_var1	+ i_dt*( a3[0]*(*RK_u_t[0]) + a3[1]*(*RK_u_t[1]) ),
-					io_var2	+ i_dt*( a3[0]*(*RK_v_t[0]) + a3[1]*(*RK_v_t[1]) ),
-					*RK_h_t[2],
-					*RK_u_t[2],
-					*RK_v_t[2],
-					i_simulation_time + c[1]*i_dt
-			);
-
-			io_var0 += i_dt*( (b[0]*(*RK_h_t[0])) + (b[1]*(*RK_h_t[1]))  + (b[2]*(*RK_h_t[2])) );
-			io_var1 += i_dt*( (b[0]*(*RK_u_t[0])) + (b[1]*(*RK_u_t[1]))  + (b[2]*(*RK_u_t[2])) );
-			io_var2 += i_dt*( (b[0]*(*RK_v_t[0])) + (b[1]*(*RK_v_t[1]))  + (b[2]*(*RK_v_t[2])) );
-		}
-		else if (i_runge_kutta_order == 4)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/2 | 1/2
-			 * 1/2 | 0    1/2
-			 * 1   | 0    0    1
-			 * --------------
-			 *     | 1/6  1/3  1/3  1/6
-			 */
-			double a2[1] = {0.5};
-			double a3[2] = {0.0, 0.5};
-			double a4[3] = {0.0, 0.0, 1.0};
-			double b[4] = {1.0/6.0, 1.0/3.0, 1.0/3.0, 1.0/6.0};
-			double c[3] = {0.5, 0.5, 1.0};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0,
-					io_var1,
-					io_var2,
-					*RK_h_t[0],
-					*RK_u_t[0],
-					*RK_v_t[0],
-					i_simulation_time
+		T_PlaneData *U[3] = {&io_var0, &io_var1, &io_var2};
+
+		p_run_timestep(
+				3, U,
+				[&](const T_PlaneData * const *i_U, T_PlaneData * const *o_F, double i_time)
+				{
+					(i_baseClass->*i_compute_euler_timestep_update)(
+							*i_U[0], *i_U[1], *i_U[2],
+							*o_F[0], *o_F[1], *o_F[2],
+							i_time
+					);
+				},
+				i_dt,
+				i_simulation_time
 			);
+	}
+};
 
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0	+ i_dt*( a2[0]*(*RK_h_t[0]) ),
-					io_var1	+ i_dt*( a2[0]*(*RK_u_t[0]) ),
-					io_var2	+ i_dt*( a2[0]*(*RK_v_t[0]) ),
-					*RK_h_t[1],
-					*RK_u_t[1],
-					*RK_v_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
 
-			// STAGE 3
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0	+ i_dt*( /*a3[0]*(*RK_P_t[0]) +*/ a3[1]*(*RK_h_t[1]) ),
-					io_var1	+ i_dt*( /*a3[0]*(*RK_u_t[0]) +*/ a3[1]*(*RK_u_t[1]) ),
-					io_var2	+ i_dt*( /*a3[0]*(*RK_v_t[0]) +*/ a3[1]*(*RK_v_t[1]) ),
-					*RK_h_t[2],
-					*RK_u_t[2],
-					*RK_v_t[2],
-					i_simulation_time + c[1]*i_dt
-			);
 
-			// STAGE 4
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0	+ i_dt*( /*a4[0]*(*RK_P_t[0]) + a4[1]*(*RK_P_t[1]) +*/ a4[2]*(*RK_h_t[2]) ),
-					io_var1	+ i_dt*( /*a4[0]*(*RK_u_t[0]) + a4[1]*(*RK_u_t[1]) +*/ a4[2]*(*RK_u_t[2]) ),
-					io_var2	+ i_dt*( /*a4[0]*(*RK_v_t[0]) + a4[1]*(*RK_v_t[1]) +*/ a4[2]*(*RK_v_t[2]) ),
-					*RK_h_t[3],
-					*RK_u_t[3],
-					*RK_v_t[3],
-					i_simulation_time + c[2]*i_dt
-			);
 
+typedef PlaneDataTimesteppingExplicitRK_Generic<PlaneData, PlaneDataConfig> PlaneDataTimesteppingExplicitRK;
 
-			io_var0 += i_dt*( (b[0]*(*RK_h_t[0])) + (b[1]*(*RK_h_t[1]))  + (b[2]*(*RK_h_t[2])) + (b[3]*(*RK_h_t[3])) );
-			io_var1 += i_dt*( (b[0]*(*RK_u_t[0])) + (b[1]*(*RK_u_t[1]))  + (b[2]*(*RK_u_t[2])) + (b[3]*(*RK_u_t[3])) );
-			io_var2 += i_dt*( (b[0]*(*RK_v_t[0])) + (b[1]*(*RK_v_t[1]))  + (b[2]*(*RK_v_t[2])) + (b[3]*(*RK_v_t[3])) );
-		}
-		else
-		{
-			std::cerr << "This order of the Runge-Kutta time stepping is not supported!" << std::endl;
-			exit(-1);
-		}
-	}
-};
+typedef PlaneDataTimesteppingExplicitRK_Generic<PlaneDataDistributed, PlaneDataConfigDistributed> PlaneDataDistributedTimesteppingExplicitRK;
 
 #endif
@@ -10,9 +10,200 @@
 
 
 
+#include <sweet/openmp_helper.hpp>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/plane/PlaneData.hpp>
+#include <sweet/plane/PlaneOperators.hpp>
+
+
+
 class PlaneDiagnostics
 {
+	/**
+	 * Kahan-compensated sum.
+	 *
+	 * Each thread accumulates its own sum which are then combined
+	 * with add(KahanSum&), hence the compensation is not lost in
+	 * OpenMP reductions.
+	 */
+	struct KahanSum
+	{
+		double sum = 0;
+		double c = 0;
+
+		inline void add(double i_value)
+		{
+			double y = i_value - c;
+			double t = sum + y;
+			c = (t - sum) - y;
+			sum = t;
+		}
+
+		inline void add(const KahanSum &i_kahan)
+		{
+			add(i_kahan.sum);
+			add(-i_kahan.c);
+		}
+
+		inline double get()	const
+		{
+			return sum - c;
+		}
+	};
+
+
+
+	/**
+	 * Compute in a single physical sweep
+	 *
+	 *   o_sum_h = sum(h)
+	 *   o_sum_ke = sum((h+h0)*(u^2+v^2))
+	 *   o_sum_eta2 = sum((vort+f0)^2)		(only if i_vort is given)
+	 */
+	static
+	void p_physical_sweep(
+			const PlaneData &i_h,
+			const PlaneData &i_u,
+			const PlaneData &i_v,
+			const PlaneData *i_vort,
+			double i_h0,
+			double i_f0,
+			double &o_sum_h,
+			double &o_sum_ke,
+			double &o_sum_eta2
+	)
+	{
+		i_h.request_data_physical();
+		i_u.request_data_physical();
+		i_v.request_data_physical();
+		if (i_vort != nullptr)
+			i_vort->request_data_physical();
+
+		const double *h = i_h.physical_space_data;
+		const double *u = i_u.physical_space_data;
+		const double *v = i_v.physical_space_data;
+		const double *vort = (i_vort != nullptr ? i_vort->physical_space_data : nullptr);
+
+		std::size_t n = i_h.planeDataConfig->physical_array_data_number_of_elements;
+
+		KahanSum sum_h, sum_ke, sum_eta2;
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel PROC_BIND_CLOSE
+#endif
+		{
+			KahanSum local_h, local_ke, local_eta2;
+
+#if SWEET_THREADING_SPACE
+#pragma omp for schedule(static) nowait
+#endif
+			for (std::size_t i = 0; i < n; i++)
+			{
+				local_h.add(h[i]);
+				local_ke.add((h[i]+i_h0)*(u[i]*u[i] + v[i]*v[i]));
+
+				if (vort != nullptr)
+				{
+					double eta = vort[i] + i_f0;
+					local_eta2.add(eta*eta);
+				}
+			}
+
+#if SWEET_THREADING_SPACE
+#pragma omp critical
+#endif
+			{
+				sum_h.add(local_h);
+				sum_ke.add(local_ke);
+				sum_eta2.add(local_eta2);
+			}
+		}
+
+		o_sum_h = sum_h.get();
+		o_sum_ke = sum_ke.get();
+		o_sum_eta2 = sum_eta2.get();
+	}
+
+
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+	/**
+	 * Compute sum(vort^2) over the physical grid points with Parseval's theorem
+	 * in a single sweep over the spectral coefficients of u and v.
+	 *
+	 * The forward FFT is not normalized and only the non-negative
+	 * wavenumbers in x direction are stored, hence all modes except
+	 * the ones with i=0 and i=N/2 are counted twice.
+	 */
+	static
+	double p_spectral_sum_vort2(
+			PlaneOperators &op,
+			const PlaneData &i_u,
+			const PlaneData &i_v
+	)
+	{
+		i_u.request_data_spectral();
+		i_v.request_data_spectral();
+
+		const PlaneDataConfig *planeDataConfig = i_u.planeDataConfig;
+
+		const double *kx = op.wavenumbers_x.data();
+		const double *ky = op.wavenumbers_y.data();
+
+		std::size_t nyquist_x = planeDataConfig->physical_data_size[0]/2;
+		if (planeDataConfig->physical_data_size[0] & 1)
+			nyquist_x = 0;	// no Nyquist mode for odd resolutions
+
+		KahanSum sum;
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel PROC_BIND_CLOSE
+#endif
+		{
+			KahanSum local;
+
+			for (int r = 0; r < 2; r++)
+			{
+#if SWEET_THREADING_SPACE
+#pragma omp for schedule(static) nowait
+#endif
+				for (std::size_t jj = planeDataConfig->spectral_data_iteration_ranges[r][1][0]; jj < planeDataConfig->spectral_data_iteration_ranges[r][1][1]; jj++)
+				{
+					for (std::size_t ii = planeDataConfig->spectral_data_iteration_ranges[r][0][0]; ii < planeDataConfig->spectral_data_iteration_ranges[r][0][1]; ii++)
+					{
+						std::size_t idx = jj*planeDataConfig->spectral_data_size[0]+ii;
+
+						// vort = i*(kx*V - ky*U)
+						std::complex<double> d = kx[ii]*i_v.spectral_space_data[idx] - ky[jj]*i_u.spectral_space_data[idx];
+						double weight = (ii == 0 || ii == nyquist_x) ? 1.0 : 2.0;
+
+						local.add(weight*std::norm(d));
+					}
+				}
+			}
+
+#if SWEET_THREADING_SPACE
+#pragma omp critical
+#endif
+			sum.add(local);
+		}
+
+		return sum.get()/(double)(planeDataConfig->physical_array_data_number_of_elements);
+	}
+#endif
+
+
+
 public:
+	/**
+	 * Compute mass, energy and potential enstrophy in a fused way:
+	 *
+	 *  - sum(vort^2) is computed in spectral space with Parseval's theorem
+	 *  - all other quantities are computed in a single physical sweep
+	 *
+	 * The order of both sweeps is chosen to require at most a single
+	 * transformation of each prognostic field.
+	 */
 	static
 	void update_nonstaggered_huv_to_mass_energy_enstrophy(
 			PlaneOperators &op,
@@ -25,27 +216,49 @@ public:
 		double normalization = (io_simVars.sim.plane_domain_size[0]*io_simVars.sim.plane_domain_size[1]) /
 								((double)io_simVars.disc.space_res_physical[0]*(double)io_simVars.disc.space_res_physical[1]);
 
-		//std::cout << "Size x, sixe y" << (io_simVars.sim.domain_size[0]) << (io_simVars.sim.domain_size[1]) << std::endl;
-		//std::cout << "resphysx, resphysy" << (double)io_simVars.disc.res_physical[0] << (double)io_simVars.disc.res_physical[1] << std::endl;
-		//std::cout << "normal" << normalization << std::endl;
+		double num_points = (double)i_prog_h.planeDataConfig->physical_array_data_number_of_elements;
+		double h0 = io_simVars.sim.h0;
+		double f0 = io_simVars.sim.plane_rotating_f0;
+
+		double sum_h, sum_ke, sum_eta2;
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		if (op.spectral_diffs)
+		{
+			double sum_vort2;
+
+			if (i_prog_u.spectral_space_data_valid && i_prog_v.spectral_space_data_valid)
+			{
+				sum_vort2 = p_spectral_sum_vort2(op, i_prog_u, i_prog_v);
+				p_physical_sweep(i_prog_h, i_prog_u, i_prog_v, nullptr, h0, f0, sum_h, sum_ke, sum_eta2);
+			}
+			else
+			{
+				p_physical_sweep(i_prog_h, i_prog_u, i_prog_v, nullptr, h0, f0, sum_h, sum_ke, sum_eta2);
+				sum_vort2 = p_spectral_sum_vort2(op, i_prog_u, i_prog_v);
+			}
+
+			// sum(vort) vanishes since it's given by the mode with wavenumber 0
+			sum_eta2 = sum_vort2 + num_points*f0*f0;
+		}
+		else
+#endif
+		{
+			PlaneData vort = op.vort(i_prog_u, i_prog_v);
+			p_physical_sweep(i_prog_h, i_prog_u, i_prog_v, &vort, h0, f0, sum_h, sum_ke, sum_eta2);
+		}
 
 		// mass (mean depth needs to be added)
-		io_simVars.diag.total_mass = (i_prog_h+ io_simVars.sim.h0).reduce_sum_quad() * normalization;
+		io_simVars.diag.total_mass = (sum_h + num_points*h0) * normalization;
 
 		// energy
-		PlaneData pot_energy = (i_prog_h+ io_simVars.sim.h0)*(io_simVars.sim.gravitation*normalization);
-		PlaneData kin_energy = (i_prog_h+ io_simVars.sim.h0)*(i_prog_u*i_prog_u+i_prog_v*i_prog_v)*(0.5*normalization);
-
-		io_simVars.diag.potential_energy = pot_energy.reduce_sum_quad();
-		io_simVars.diag.kinetic_energy = kin_energy.reduce_sum_quad();
+		io_simVars.diag.potential_energy = io_simVars.diag.total_mass*io_simVars.sim.gravitation;
+		io_simVars.diag.kinetic_energy = 0.5*sum_ke*normalization;
 
 		io_simVars.diag.total_energy = io_simVars.diag.kinetic_energy + io_simVars.diag.potential_energy;
 
-		// absolute vorticity
-		PlaneData eta = (op.diff_c_x(i_prog_v) - op.diff_c_y(i_prog_u) + io_simVars.sim.plane_rotating_f0);
-
-		// enstrophy
-		io_simVars.diag.total_potential_enstrophy = 0.5*(eta*eta).reduce_sum_quad() * normalization;
+		// enstrophy of absolute vorticity
+		io_simVars.diag.total_potential_enstrophy = 0.5*sum_eta2*normalization;
 	}
 
 
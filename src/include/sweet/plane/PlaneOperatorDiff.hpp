@@ -0,0 +1,314 @@
+/*
+ * PlaneOperatorDiff.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+#ifndef SRC_INCLUDE_SWEET_PLANE_PLANEOPERATORDIFF_HPP_
+#define SRC_INCLUDE_SWEET_PLANE_PLANEOPERATORDIFF_HPP_
+
+#include <vector>
+#include <sweet/FatalError.hpp>
+#include <sweet/plane/PlaneData.hpp>
+#include <sweet/plane/PlaneDataConfig.hpp>
+
+
+
+/**
+ * Differential operator in x or y direction (1st or 2nd order)
+ *
+ * Spectral differentiation only depends on the wavenumber in the
+ * direction of the operator. Instead of storing a full-size operator
+ * array, only the 1D vector of wavenumbers is stored and the factor
+ *
+ *   (i*k)^order
+ *
+ * is computed on the fly while applying the operator.
+ *
+ * The full-size array is only created on demand if the operator is
+ * used as data (e.g. to setup the left hand side of implicit solvers).
+ * This is not thread-safe.
+ *
+ * Finite-difference operators are stored as stencils.
+ */
+class PlaneOperatorDiff
+{
+	const PlaneDataConfig *planeDataConfig;
+
+	/// Apply spectral differentiation on the fly
+	bool on_the_fly;
+
+	/// 0: d/dx, 1: d/dy
+	int direction;
+
+	/// Order of differentiation (1 or 2)
+	int diff_order;
+
+	/// Wavenumbers along the direction of this operator
+	std::vector<double> wavenumbers;
+
+	/// Stencil or (on demand) full-size spectral operator
+	mutable PlaneData *op_data;
+
+
+public:
+	PlaneOperatorDiff()	:
+		planeDataConfig(nullptr),
+		on_the_fly(false),
+		direction(0),
+		diff_order(1),
+		op_data(nullptr)
+	{
+	}
+
+
+	~PlaneOperatorDiff()
+	{
+		delete op_data;
+	}
+
+
+	PlaneOperatorDiff(
+			const PlaneOperatorDiff &i_op
+	)	:
+		planeDataConfig(i_op.planeDataConfig),
+		on_the_fly(i_op.on_the_fly),
+		direction(i_op.direction),
+		diff_order(i_op.diff_order),
+		wavenumbers(i_op.wavenumbers),
+		op_data(nullptr)
+	{
+		if (i_op.op_data != nullptr)
+			op_data = new PlaneData(*i_op.op_data);
+	}
+
+
+	PlaneOperatorDiff& operator=(
+			const PlaneOperatorDiff &i_op
+	)
+	{
+		planeDataConfig = i_op.planeDataConfig;
+		on_the_fly = i_op.on_the_fly;
+		direction = i_op.direction;
+		diff_order = i_op.diff_order;
+		wavenumbers = i_op.wavenumbers;
+
+		delete op_data;
+		op_data = nullptr;
+
+		if (i_op.op_data != nullptr)
+			op_data = new PlaneData(*i_op.op_data);
+
+		return *this;
+	}
+
+
+	bool isSetup()	const
+	{
+		return planeDataConfig != nullptr;
+	}
+
+
+	bool isOnTheFly()	const
+	{
+		return on_the_fly;
+	}
+
+
+	const std::vector<double>& getWavenumbers()	const
+	{
+		return wavenumbers;
+	}
+
+
+	/**
+	 * Setup spectral differentiation
+	 */
+	void setup_spectral(
+			const PlaneDataConfig *i_planeDataConfig,
+			int i_direction,					///< 0: x, 1: y
+			int i_diff_order,					///< order of differentiation
+			const std::vector<double> &i_wavenumbers	///< wavenumbers in this direction
+	)
+	{
+#if !SWEET_USE_PLANE_SPECTRAL_SPACE
+		FatalError("Spectral differentiation requires spectral space to be activated");
+#endif
+
+		planeDataConfig = i_planeDataConfig;
+		on_the_fly = true;
+		direction = i_direction;
+		diff_order = i_diff_order;
+		wavenumbers = i_wavenumbers;
+
+		delete op_data;
+		op_data = nullptr;
+	}
+
+
+	/**
+	 * Setup finite-difference stencil
+	 */
+	void setup_stencil(
+			const PlaneDataConfig *i_planeDataConfig,
+			const double i_kernel_array[3][3],
+			double i_scale = 1.0
+	)
+	{
+		planeDataConfig = i_planeDataConfig;
+		on_the_fly = false;
+		wavenumbers.clear();
+
+		delete op_data;
+		op_data = new PlaneData(planeDataConfig);
+		op_data->kernel_stencil_setup(i_kernel_array, i_scale);
+	}
+
+
+	/**
+	 * Apply operator
+	 */
+	PlaneData operator()(
+			const PlaneData &i_data
+	)	const
+	{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		if (on_the_fly)
+		{
+			PlaneData out(planeDataConfig);
+
+			i_data.request_data_spectral();
+
+			const double *k = wavenumbers.data();
+
+			if (diff_order == 1)
+			{
+				if (direction == 0)
+				{
+					PLANE_DATA_SPECTRAL_FOR_IDX(
+							const std::complex<double> &d = i_data.spectral_space_data[idx];
+							out.spectral_space_data[idx] = std::complex<double>(-k[ii]*d.imag(), k[ii]*d.real());
+					);
+				}
+				else
+				{
+					PLANE_DATA_SPECTRAL_FOR_IDX(
+							const std::complex<double> &d = i_data.spectral_space_data[idx];
+							out.spectral_space_data[idx] = std::complex<double>(-k[jj]*d.imag(), k[jj]*d.real());
+					);
+				}
+			}
+			else
+			{
+				if (direction == 0)
+				{
+					PLANE_DATA_SPECTRAL_FOR_IDX(
+							out.spectral_space_data[idx] = (-k[ii]*k[ii])*i_data.spectral_space_data[idx];
+					);
+				}
+				else
+				{
+					PLANE_DATA_SPECTRAL_FOR_IDX(
+							out.spectral_space_data[idx] = (-k[jj]*k[jj])*i_data.spectral_space_data[idx];
+					);
+				}
+			}
+
+			out.spectral_space_data_valid = true;
+			out.physical_space_data_valid = false;
+
+			out.spectral_zeroAliasingModes();
+
+			return out;
+		}
+#endif
+
+		return getOperatorData()(i_data);
+	}
+
+
+	/**
+	 * Return full-size operator, e.g. to setup the left hand side of implicit solvers
+	 */
+	const PlaneData& getOperatorData()	const
+	{
+		if (op_data != nullptr)
+			return *op_data;
+
+		if (planeDataConfig == nullptr)
+			FatalError("PlaneOperatorDiff: Operator not setup");
+
+		op_data = new PlaneData(planeDataConfig);
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		const double *k = wavenumbers.data();
+
+		PLANE_DATA_SPECTRAL_FOR_IDX(
+				double kk = (direction == 0 ? k[ii] : k[jj]);
+
+				if (diff_order == 1)
+					op_data->spectral_space_data[idx] = std::complex<double>(0, kk);
+				else
+					op_data->spectral_space_data[idx] = -kk*kk;
+		);
+
+		op_data->spectral_space_data_valid = true;
+		op_data->physical_space_data_valid = false;
+
+		op_data->spectral_zeroAliasingModes();
+#endif
+
+		return *op_data;
+	}
+
+
+	operator const PlaneData&()	const
+	{
+		return getOperatorData();
+	}
+};
+
+
+
+/*
+ * Operators to use differential operators as data, e.g.
+ *
+ *   PlaneData laplace = op.diff2_c_x + op.diff2_c_y;
+ */
+inline
+PlaneData operator+(
+		const PlaneOperatorDiff &i_a,
+		const PlaneOperatorDiff &i_b
+)
+{
+	return i_a.getOperatorData() + i_b.getOperatorData();
+}
+
+inline
+PlaneData operator-(
+		const PlaneOperatorDiff &i_a,
+		const PlaneOperatorDiff &i_b
+)
+{
+	return i_a.getOperatorData() - i_b.getOperatorData();
+}
+
+inline
+PlaneData operator-(
+		const PlaneOperatorDiff &i_a
+)
+{
+	return -i_a.getOperatorData();
+}
+
+inline
+PlaneData operator*(
+		double i_scalar,
+		const PlaneOperatorDiff &i_a
+)
+{
+	return i_scalar*i_a.getOperatorData();
+}
+
+
+#endif /* SRC_INCLUDE_SWEET_PLANE_PLANEOPERATORDIFF_HPP_ */
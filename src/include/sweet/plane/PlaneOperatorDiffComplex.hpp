@@ -0,0 +1,272 @@
+/*
+ * PlaneOperatorDiffComplex.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+#ifndef SRC_INCLUDE_SWEET_PLANE_PLANEOPERATORDIFFCOMPLEX_HPP_
+#define SRC_INCLUDE_SWEET_PLANE_PLANEOPERATORDIFFCOMPLEX_HPP_
+
+#include <vector>
+#include <sweet/FatalError.hpp>
+#include <sweet/plane/PlaneDataComplex.hpp>
+#include <sweet/plane/PlaneDataConfig.hpp>
+
+
+
+/**
+ * Differential operator in x or y direction (1st or 2nd order)
+ *
+ * Spectral differentiation only depends on the wavenumber in the
+ * direction of the operator. Instead of storing a full-size operator
+ * array, only the 1D vector of wavenumbers is stored and the factor
+ *
+ *   (i*k)^order
+ *
+ * is computed on the fly while applying the operator.
+ *
+ * The full-size array is only created on demand if the operator is
+ * used as data (e.g. to setup the left hand side of implicit solvers).
+ * This is not thread-safe.
+ *
+ * See PlaneOperatorDiff for the real-valued version.
+ */
+class PlaneOperatorDiffComplex
+{
+	const PlaneDataConfig *planeDataConfig;
+
+	/// 0: d/dx, 1: d/dy
+	int direction;
+
+	/// Order of differentiation (1 or 2)
+	int diff_order;
+
+	/// Wavenumbers along the direction of this operator
+	std::vector<double> wavenumbers;
+
+	/// Stencil or (on demand) full-size spectral operator
+	mutable PlaneDataComplex *op_data;
+
+
+public:
+	PlaneOperatorDiffComplex()	:
+		planeDataConfig(nullptr),
+		direction(0),
+		diff_order(1),
+		op_data(nullptr)
+	{
+	}
+
+
+	~PlaneOperatorDiffComplex()
+	{
+		delete op_data;
+	}
+
+
+	PlaneOperatorDiffComplex(
+			const PlaneOperatorDiffComplex &i_op
+	)	:
+		planeDataConfig(i_op.planeDataConfig),
+		direction(i_op.direction),
+		diff_order(i_op.diff_order),
+		wavenumbers(i_op.wavenumbers),
+		op_data(nullptr)
+	{
+		if (i_op.op_data != nullptr)
+			op_data = new PlaneDataComplex(*i_op.op_data);
+	}
+
+
+	PlaneOperatorDiffComplex& operator=(
+			const PlaneOperatorDiffComplex &i_op
+	)
+	{
+		planeDataConfig = i_op.planeDataConfig;
+		direction = i_op.direction;
+		diff_order = i_op.diff_order;
+		wavenumbers = i_op.wavenumbers;
+
+		delete op_data;
+		op_data = nullptr;
+
+		if (i_op.op_data != nullptr)
+			op_data = new PlaneDataComplex(*i_op.op_data);
+
+		return *this;
+	}
+
+
+	bool isSetup()	const
+	{
+		return planeDataConfig != nullptr;
+	}
+
+
+	const std::vector<double>& getWavenumbers()	const
+	{
+		return wavenumbers;
+	}
+
+
+	/**
+	 * Setup spectral differentiation
+	 */
+	void setup_spectral(
+			const PlaneDataConfig *i_planeDataConfig,
+			int i_direction,					///< 0: x, 1: y
+			int i_diff_order,					///< order of differentiation
+			const std::vector<double> &i_wavenumbers	///< wavenumbers in this direction
+	)
+	{
+		planeDataConfig = i_planeDataConfig;
+		direction = i_direction;
+		diff_order = i_diff_order;
+		wavenumbers = i_wavenumbers;
+
+		delete op_data;
+		op_data = nullptr;
+	}
+
+
+	/**
+	 * Apply operator
+	 */
+	PlaneDataComplex operator()(
+			const PlaneDataComplex &i_data
+	)	const
+	{
+		if (planeDataConfig == nullptr)
+			FatalError("PlaneOperatorDiffComplex: Operator not setup");
+
+		PlaneDataComplex out(planeDataConfig);
+
+		i_data.request_data_spectral();
+
+		const double *k = wavenumbers.data();
+
+		if (diff_order == 1)
+		{
+			if (direction == 0)
+			{
+				PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
+						const std::complex<double> &d = i_data.spectral_space_data[idx];
+						out.spectral_space_data[idx] = std::complex<double>(-k[ii]*d.imag(), k[ii]*d.real());
+				);
+			}
+			else
+			{
+				PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
+						const std::complex<double> &d = i_data.spectral_space_data[idx];
+						out.spectral_space_data[idx] = std::complex<double>(-k[jj]*d.imag(), k[jj]*d.real());
+				);
+			}
+		}
+		else
+		{
+			if (direction == 0)
+			{
+				PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
+						out.spectral_space_data[idx] = (-k[ii]*k[ii])*i_data.spectral_space_data[idx];
+				);
+			}
+			else
+			{
+				PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
+						out.spectral_space_data[idx] = (-k[jj]*k[jj])*i_data.spectral_space_data[idx];
+				);
+			}
+		}
+
+		out.spectral_space_data_valid = true;
+		out.physical_space_data_valid = false;
+
+		out.spectral_zeroAliasingModes();
+
+		return out;
+	}
+
+
+	/**
+	 * Return full-size operator, e.g. to setup the left hand side of implicit solvers
+	 */
+	const PlaneDataComplex& getOperatorData()	const
+	{
+		if (op_data != nullptr)
+			return *op_data;
+
+		if (planeDataConfig == nullptr)
+			FatalError("PlaneOperatorDiffComplex: Operator not setup");
+
+		op_data = new PlaneDataComplex(planeDataConfig);
+
+		const double *k = wavenumbers.data();
+
+		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
+				double kk = (direction == 0 ? k[ii] : k[jj]);
+
+				if (diff_order == 1)
+					op_data->spectral_space_data[idx] = std::complex<double>(0, kk);
+				else
+					op_data->spectral_space_data[idx] = -kk*kk;
+		);
+
+		op_data->spectral_space_data_valid = true;
+		op_data->physical_space_data_valid = false;
+
+		op_data->spectral_zeroAliasingModes();
+
+		return *op_data;
+	}
+
+
+	operator const PlaneDataComplex&()	const
+	{
+		return getOperatorData();
+	}
+};
+
+
+
+/*
+ * Operators to use differential operators as data, e.g.
+ *
+ *   PlaneDataComplex laplace = op.diff2_c_x + op.diff2_c_y;
+ */
+inline
+PlaneDataComplex operator+(
+		const PlaneOperatorDiffComplex &i_a,
+		const PlaneOperatorDiffComplex &i_b
+)
+{
+	return i_a.getOperatorData() + i_b.getOperatorData();
+}
+
+inline
+PlaneDataComplex operator-(
+		const PlaneOperatorDiffComplex &i_a,
+		const PlaneOperatorDiffComplex &i_b
+)
+{
+	return i_a.getOperatorData() - i_b.getOperatorData();
+}
+
+inline
+PlaneDataComplex operator-(
+		const PlaneOperatorDiffComplex &i_a
+)
+{
+	return i_a.getOperatorData()*(-1.0);
+}
+
+inline
+PlaneDataComplex operator*(
+		double i_scalar,
+		const PlaneOperatorDiffComplex &i_a
+)
+{
+	return i_scalar*i_a.getOperatorData();
+}
+
+
+#endif /* SRC_INCLUDE_SWEET_PLANE_PLANEOPERATORDIFFCOMPLEX_HPP_ */
@@ -12,8 +12,10 @@
 //	#include <sweet/plane/PlaneDataComplex.hpp>
 #endif
 
+#include <vector>
 #include <sweet/plane/PlaneData.hpp>
 #include <sweet/plane/PlaneDataConfig.hpp>
+#include <sweet/plane/PlaneOperatorDiff.hpp>
 
 
 class PlaneOperators
@@ -23,11 +25,11 @@ public:
 
 public:
 	// differential operators (central / forward / backward)
-	PlaneData diff_c_x, diff_c_y;
+	PlaneOperatorDiff diff_c_x, diff_c_y;
 	PlaneData diff_f_x, diff_f_y;
 	PlaneData diff_b_x, diff_b_y;
 
-	PlaneData diff2_c_x, diff2_c_y;
+	PlaneOperatorDiff diff2_c_x, diff2_c_y;
 
 	PlaneData avg_f_x, avg_f_y;
 	PlaneData avg_b_x, avg_b_y;
@@ -37,6 +39,13 @@ public:
 	PlaneData shift_up;
 	PlaneData shift_down;
 
+	/// Spectral differential operators are computed on the fly
+	bool spectral_diffs;
+
+	/// Wavenumbers in x and y direction for spectral differentiation
+	std::vector<double> wavenumbers_x;
+	std::vector<double> wavenumbers_y;
+
 
 	/**
 	 * D2, e.g. for viscosity
@@ -45,7 +54,7 @@ public:
 			const PlaneData &i_dataArray
 	)
 	{
-		return diff2_c_x(i_dataArray) + diff2_c_y(i_dataArray);
+		return laplace(i_dataArray);
 	}
 
 
@@ -58,6 +67,24 @@ public:
 			const PlaneData &i_a
 	)
 	{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		if (spectral_diffs)
+		{
+			PlaneData out(planeDataConfig);
+			i_a.request_data_spectral();
+
+			const double *kx = wavenumbers_x.data();
+			const double *ky = wavenumbers_y.data();
+
+			PLANE_DATA_SPECTRAL_FOR_IDX(
+					out.spectral_space_data[idx] = -(kx[ii]*kx[ii] + ky[jj]*ky[jj])*i_a.spectral_space_data[idx];
+			);
+
+			p_spectral_finalize(out);
+			return out;
+		}
+#endif
+
 		return diff2_c_x(i_a)+diff2_c_y(i_a);
 	}
 
@@ -73,6 +100,27 @@ public:
 			const PlaneData &b
 	)
 	{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		if (spectral_diffs)
+		{
+			PlaneData out(planeDataConfig);
+			a.request_data_spectral();
+			b.request_data_spectral();
+
+			const double *kx = wavenumbers_x.data();
+			const double *ky = wavenumbers_y.data();
+
+			PLANE_DATA_SPECTRAL_FOR_IDX(
+					// i*(kx*b - ky*a)
+					std::complex<double> d = kx[ii]*b.spectral_space_data[idx] - ky[jj]*a.spectral_space_data[idx];
+					out.spectral_space_data[idx] = std::complex<double>(-d.imag(), d.real());
+			);
+
+			p_spectral_finalize(out);
+			return out;
+		}
+#endif
+
 		return diff_c_x(b) - diff_c_y(a);
 	}
 
@@ -88,9 +136,115 @@ public:
 			const PlaneData &b
 	)
 	{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		if (spectral_diffs)
+		{
+			PlaneData out(planeDataConfig);
+			a.request_data_spectral();
+			b.request_data_spectral();
+
+			const double *kx = wavenumbers_x.data();
+			const double *ky = wavenumbers_y.data();
+
+			PLANE_DATA_SPECTRAL_FOR_IDX(
+					// i*(kx*a + ky*b)
+					std::complex<double> d = kx[ii]*a.spectral_space_data[idx] + ky[jj]*b.spectral_space_data[idx];
+					out.spectral_space_data[idx] = std::complex<double>(-d.imag(), d.real());
+			);
+
+			p_spectral_finalize(out);
+			return out;
+		}
+#endif
+
 		return diff_c_x(a) + diff_c_y(b);
 	}
 
+
+
+	/**
+	 * Gradient
+	 *
+	 * (o_x, o_y) = (da/dx, da/dy)
+	 *
+	 * o_x and o_y need to be setup, a may be one of them
+	 */
+	void grad(
+			const PlaneData &a,
+			PlaneData &o_x,
+			PlaneData &o_y
+	)
+	{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		if (spectral_diffs)
+		{
+			a.request_data_spectral();
+
+			const double *kx = wavenumbers_x.data();
+			const double *ky = wavenumbers_y.data();
+
+			PLANE_DATA_SPECTRAL_FOR_IDX(
+					std::complex<double> d = a.spectral_space_data[idx];
+					o_x.spectral_space_data[idx] = std::complex<double>(-kx[ii]*d.imag(), kx[ii]*d.real());
+					o_y.spectral_space_data[idx] = std::complex<double>(-ky[jj]*d.imag(), ky[jj]*d.real());
+			);
+
+			p_spectral_finalize(o_x);
+			p_spectral_finalize(o_y);
+			return;
+		}
+#endif
+
+		PlaneData tmp_x = diff_c_x(a);
+		o_y = diff_c_y(a);
+		o_x = tmp_x;
+	}
+
+
+
+	/**
+	 * Solve the Helmholtz problem
+	 *
+	 *   (a + b*\nabla^2) x = rhs
+	 *
+	 * Modes with a vanishing operator are set to zero
+	 * (see PlaneData::spectral_div_element_wise)
+	 */
+	PlaneData helmholtz_inverse(
+			const PlaneData &i_rhs,
+			double i_a,
+			double i_b
+	)
+	{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		if (spectral_diffs)
+		{
+			PlaneData out(planeDataConfig);
+			i_rhs.request_data_spectral();
+
+			const double *kx = wavenumbers_x.data();
+			const double *ky = wavenumbers_y.data();
+
+			PLANE_DATA_SPECTRAL_FOR_IDX(
+					double den = i_a - i_b*(kx[ii]*kx[ii] + ky[jj]*ky[jj]);
+					if (den == 0)
+						out.spectral_space_data[idx] = 0;
+					else
+						out.spectral_space_data[idx] = i_rhs.spectral_space_data[idx]/den;
+			);
+
+			p_spectral_finalize(out);
+			return out;
+		}
+
+		PlaneData lhs = (i_b*(diff2_c_x + diff2_c_y)).spectral_addScalarAll(i_a);
+		return i_rhs.spectral_div_element_wise(lhs);
+#else
+		FatalError("Helmholtz inverse requires spectral space to be activated");
+		return i_rhs;
+#endif
+	}
+
 	/**
 	 * kinetic energy
 	 *
@@ -149,7 +303,7 @@ public:
 			const PlaneData &i_a
 	)
 	{
-		return diff_c_x(i_a)+diff_c_y(i_a);
+		return div(i_a, i_a);
 	}
 
 
@@ -220,6 +374,22 @@ public:
 		//Check if even
 		assert( i_order % 2 == 0);
 		assert( i_order > 0);
+
+		if (spectral_diffs)
+		{
+			PlaneData out(planeDataConfig);
+
+			const double *kx = wavenumbers_x.data();
+			const double *ky = wavenumbers_y.data();
+
+			PLANE_DATA_SPECTRAL_FOR_IDX(
+					out.spectral_space_data[idx] = p_diffusion_symbol(kx[ii]*kx[ii] + ky[jj]*ky[jj], i_order);
+			);
+
+			p_spectral_finalize(out);
+			return out;
+		}
+
 		PlaneData out = diff2_c_x+diff2_c_y;
 
 #if 0
@@ -252,6 +422,26 @@ public:
 			int i_order
 	)
 	{
+		if (spectral_diffs)
+		{
+			PlaneData out(planeDataConfig);
+			i_data.request_data_spectral();
+
+			const double *kx = wavenumbers_x.data();
+			const double *ky = wavenumbers_y.data();
+
+			PLANE_DATA_SPECTRAL_FOR_IDX(
+					double den = 1.0 - i_coef*p_diffusion_symbol(kx[ii]*kx[ii] + ky[jj]*ky[jj], i_order);
+					if (den == 0)
+						out.spectral_space_data[idx] = 0;
+					else
+						out.spectral_space_data[idx] = i_data.spectral_space_data[idx]/den;
+			);
+
+			p_spectral_finalize(out);
+			return out;
+		}
+
 		PlaneData out=i_data;
 
 		// Get diffusion coefficients (these are the -mu*dt*D^q, where q is the order
@@ -266,22 +456,50 @@ public:
 		out=diff(out);
 		return out;
 	}
+
+
+private:
+	/**
+	 * Spectral symbol of diffusion_coefficient() for the squared wavenumber kk
+	 */
+	inline static double p_diffusion_symbol(
+			double kk,
+			int i_order
+	)
+	{
+		double d = -kk;
+
+		/*
+		 * Always use negative sign for hyperdiffusion to allow using always positive viscosity
+		 */
+		for (int i = 1; i < i_order/2; i++)
+			d = kk*d;
+
+		return d;
+	}
+
+
+	inline void p_spectral_finalize(
+			PlaneData &io_data
+	)
+	{
+		io_data.spectral_space_data_valid = true;
+		io_data.physical_space_data_valid = false;
+
+		io_data.spectral_zeroAliasingModes();
+	}
+
+public:
 #endif
 
 	PlaneOperators()	:
 		planeDataConfig(nullptr),
 
-		diff_c_x(1),
-		diff_c_y(1),
-
 		diff_f_x(1),
 		diff_f_y(1),
 		diff_b_x(1),
 		diff_b_y(1),
 
-		diff2_c_x(1),
-		diff2_c_y(1),
-
 		avg_f_x(1),
 		avg_f_y(1),
 		avg_b_x(1),
@@ -290,7 +508,9 @@ public:
 		shift_left(1),
 		shift_right(1),
 		shift_up(1),
-		shift_down(1)
+		shift_down(1),
+
+		spectral_diffs(false)
 	{
 
 	}
@@ -304,17 +524,11 @@ public:
 	{
 		planeDataConfig = i_planeDataConfig;
 
-		diff_c_x.setup(i_planeDataConfig);
-		diff_c_y.setup(i_planeDataConfig);
-
 		diff_f_x.setup(i_planeDataConfig);
 		diff_f_y.setup(i_planeDataConfig);
 		diff_b_x.setup(i_planeDataConfig);
 		diff_b_y.setup(i_planeDataConfig);
 
-		diff2_c_x.setup(i_planeDataConfig);
-		diff2_c_y.setup(i_planeDataConfig);
-
 		avg_f_x.setup(i_planeDataConfig);
 		avg_f_y.setup(i_planeDataConfig);
 		avg_b_x.setup(i_planeDataConfig);
@@ -421,50 +635,30 @@ public:
 			 * Note, that there's a last column which is set to 0 (Nyquist freq, noise in signal)
 			 * PXT: removed this setting to zero (changed < to <=), because of 2nd and higher order differentiation
 			 * MaS: changed <= to < for the x-axis because of invalid memory access...
+			 *
+			 * The wavenumbers only depend on one spectral index, hence
+			 * only these 1D vectors are stored instead of full-size
+			 * operator arrays (see PlaneOperatorDiff).
 			 */
-			diff_c_x.spectral_set_zero();
-
-			for (int j = planeDataConfig->spectral_data_iteration_ranges[0][1][0]; j < (int)planeDataConfig->spectral_data_iteration_ranges[0][1][1]; j++)
-			{
-				for (int i = planeDataConfig->spectral_data_iteration_ranges[0][0][0]; i < (int)planeDataConfig->spectral_data_iteration_ranges[0][0][1]; i++)
-				{
-					std::complex<double> data(0.0, ((double)i*2.0*M_PIl/(double)i_domain_size[0]));
-					diff_c_x.p_spectral_set(j, i, data);
-				}
-			}
+			wavenumbers_x.assign(planeDataConfig->spectral_data_size[0], 0);
+			wavenumbers_y.assign(planeDataConfig->spectral_data_size[1], 0);
 
-			for (int j = planeDataConfig->spectral_data_iteration_ranges[1][1][0]; j < (int)planeDataConfig->spectral_data_iteration_ranges[1][1][1]; j++)
+			for (int r = 0; r < 2; r++)
 			{
-				for (int i = planeDataConfig->spectral_data_iteration_ranges[1][0][0]; i < (int)planeDataConfig->spectral_data_iteration_ranges[1][0][1]; i++)
-				{
-					std::complex<double> data(0.0, ((double)i*2.0*M_PIl/(double)i_domain_size[0]));
-					diff_c_x.p_spectral_set(j, i, data);
-				}
+				for (int i = planeDataConfig->spectral_data_iteration_ranges[r][0][0]; i < (int)planeDataConfig->spectral_data_iteration_ranges[r][0][1]; i++)
+					wavenumbers_x[i] = (double)i*2.0*M_PIl/(double)i_domain_size[0];
 			}
 
-			/*
-			 * DIFF operator in y axis
-			 */
-			diff_c_y.spectral_set_zero();
-
 			for (int j = planeDataConfig->spectral_data_iteration_ranges[0][1][0]; j < (int)planeDataConfig->spectral_data_iteration_ranges[0][1][1]; j++)
-			{
-				for (int i = planeDataConfig->spectral_data_iteration_ranges[0][0][0]; i < (int)planeDataConfig->spectral_data_iteration_ranges[0][0][1]; i++)
-				{
-					std::complex<double> data(0, (double)((double)j*2.0*M_PIl/(double)i_domain_size[1]));
-					diff_c_y.p_spectral_set(j, i, data);
-				}
-			}
-
+				wavenumbers_y[j] = (double)j*2.0*M_PIl/(double)i_domain_size[1];
 
 			for (int j = planeDataConfig->spectral_data_iteration_ranges[1][1][0]; j < (int)planeDataConfig->spectral_data_iteration_ranges[1][1][1]; j++)
-			{
-				for (int i = planeDataConfig->spectral_data_iteration_ranges[1][0][0]; i < (int)planeDataConfig->spectral_data_iteration_ranges[1][0][1]; i++)
-				{
-					std::complex<double> data(0, -(double)((double)(planeDataConfig->spectral_data_size[1]-j)*2.0*M_PIl/(double)i_domain_size[1]));
-					diff_c_y.p_spectral_set(j, i, data);
-				}
-			}
+				wavenumbers_y[j] = -(double)(planeDataConfig->spectral_data_size[1]-j)*2.0*M_PIl/(double)i_domain_size[1];
+
+			diff_c_x.setup_spectral(planeDataConfig, 0, 1, wavenumbers_x);
+			diff_c_y.setup_spectral(planeDataConfig, 1, 1, wavenumbers_y);
+
+			spectral_diffs = true;
 
 
 			/**
@@ -504,53 +698,29 @@ public:
 			/*
 			 * 2nd order differential operators
 			 */
-			diff2_c_x.spectral_set_zero();
-			for (int r = 0; r < 2; r++)
-			{
-				for (int j = planeDataConfig->spectral_data_iteration_ranges[r][1][0]; j < (int)planeDataConfig->spectral_data_iteration_ranges[r][1][1]; j++)
-				{
-					for (int i = planeDataConfig->spectral_data_iteration_ranges[r][0][0]; i < (int)planeDataConfig->spectral_data_iteration_ranges[r][0][1]; i++)
-					{
-						std::complex<double> data = diff_c_x.p_spectral_get(j, i);
-						diff2_c_x.p_spectral_set(j, i, data*data);
-					}
-				}
-			}
-
-			diff2_c_y.spectral_set_zero();
-			for (int r = 0; r < 2; r++)
-			{
-				for (int j = planeDataConfig->spectral_data_iteration_ranges[r][1][0]; j < (int)planeDataConfig->spectral_data_iteration_ranges[r][1][1]; j++)
-				{
-					for (int i = planeDataConfig->spectral_data_iteration_ranges[r][0][0]; i < (int)planeDataConfig->spectral_data_iteration_ranges[r][0][1]; i++)
-					{
-						std::complex<double> data = diff_c_y.p_spectral_get(j, i);
-						diff2_c_y.p_spectral_set(j, i, data*data);
-					}
-				}
-			}
-
-			diff_c_x.spectral_debugCheckForZeroAliasingModes();
-			diff_c_y.spectral_debugCheckForZeroAliasingModes();
-			diff2_c_x.spectral_debugCheckForZeroAliasingModes();
-			diff2_c_y.spectral_debugCheckForZeroAliasingModes();
+			diff2_c_x.setup_spectral(planeDataConfig, 0, 2, wavenumbers_x);
+			diff2_c_y.setup_spectral(planeDataConfig, 1, 2, wavenumbers_y);
 #endif
 		}
 		else
 		{
+			spectral_diffs = false;
+			wavenumbers_x.clear();
+			wavenumbers_y.clear();
+
 			double diff1_x_kernel[3][3] = {
 					{0,0,0},
 					{-1.0,0,1.0},
 					{0,0,0}
 			};
-			diff_c_x.kernel_stencil_setup(diff1_x_kernel, 1.0/(2.0*h[0]));
+			diff_c_x.setup_stencil(planeDataConfig, diff1_x_kernel, 1.0/(2.0*h[0]));
 
 			double diff1_y_kernel[3][3] = {
 					{0,1.0,0},	// higher y coordinate
 					{0,0,0},
 					{0,-1.0,0},	// lower y coordinate
 			};
-			diff_c_y.kernel_stencil_setup(diff1_y_kernel, 1.0/(2.0*h[1]));
+			diff_c_y.setup_stencil(planeDataConfig, diff1_y_kernel, 1.0/(2.0*h[1]));
 
 			double d_f_x_kernel[3][3] = {
 					{0,0,0},
@@ -587,14 +757,14 @@ public:
 					{1.0,-2.0,1.0},
 					{0,0,0}
 				};
-			diff2_c_x.kernel_stencil_setup(diff2_x_kernel, 1.0/(h[0]*h[0]));
+			diff2_c_x.setup_stencil(planeDataConfig, diff2_x_kernel, 1.0/(h[0]*h[0]));
 
 			double diff2_y_kernel[3][3] = {
 					{0,1.0,0},
 					{0,-2.0,0},
 					{0,1.0,0}
 			};
-			diff2_c_y.kernel_stencil_setup(diff2_y_kernel, 1.0/(h[1]*h[1]));
+			diff2_c_y.setup_stencil(planeDataConfig, diff2_y_kernel, 1.0/(h[1]*h[1]));
 		}
 	}
 
@@ -605,17 +775,11 @@ public:
 	)	:
 		planeDataConfig(i_planeDataConfig),
 
-		diff_c_x(i_planeDataConfig),
-		diff_c_y(i_planeDataConfig),
-
 		diff_f_x(i_planeDataConfig),
 		diff_f_y(i_planeDataConfig),
 		diff_b_x(i_planeDataConfig),
 		diff_b_y(i_planeDataConfig),
 
-		diff2_c_x(i_planeDataConfig),
-		diff2_c_y(i_planeDataConfig),
-
 		avg_f_x(i_planeDataConfig),
 		avg_f_y(i_planeDataConfig),
 		avg_b_x(i_planeDataConfig),
@@ -624,7 +788,9 @@ public:
 		shift_left(i_planeDataConfig),
 		shift_right(i_planeDataConfig),
 		shift_up(i_planeDataConfig),
-		shift_down(i_planeDataConfig)
+		shift_down(i_planeDataConfig),
+
+		spectral_diffs(false)
 	{
 		setup(i_domain_size, i_use_spectral_basis_diffs);
 	}
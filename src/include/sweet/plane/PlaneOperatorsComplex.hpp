@@ -8,8 +8,11 @@
 #define SRC_INCLUDE_SWEET_PLANE_OPERATORS_COMPLEX_HPP_
 
 
+#include <vector>
+#include <complex>
 #include <sweet/plane/PlaneDataComplex.hpp>
 #include <sweet/plane/PlaneDataConfig.hpp>
+#include <sweet/plane/PlaneOperatorDiffComplex.hpp>
 
 
 class PlaneOperatorsComplex
@@ -18,8 +21,13 @@ class PlaneOperatorsComplex
 
 public:
 	// differential operators
-	PlaneDataComplex diff_c_x, diff_c_y;
-	PlaneDataComplex diff2_c_x, diff2_c_y;
+	PlaneOperatorDiffComplex diff_c_x, diff_c_y;
+	PlaneOperatorDiffComplex diff2_c_x, diff2_c_y;
+
+	/// Wavenumbers in x and y direction for spectral differentiation
+	std::vector<double> wavenumbers_x;
+	std::vector<double> wavenumbers_y;
+
 
 	/**
 	 * D2, e.g. for viscosity
@@ -28,7 +36,7 @@ public:
 			const PlaneDataComplex &i_dataArray
 	)
 	{
-		return diff2_c_x(i_dataArray) + diff2_c_y(i_dataArray);
+		return laplace(i_dataArray);
 	}
 
 
@@ -41,7 +49,18 @@ public:
 			const PlaneDataComplex &i_a
 	)
 	{
-		return diff2_c_x(i_a)+diff2_c_y(i_a);
+		PlaneDataComplex out(planeDataConfig);
+		i_a.request_data_spectral();
+
+		const double *kx = wavenumbers_x.data();
+		const double *ky = wavenumbers_y.data();
+
+		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
+				out.spectral_space_data[idx] = -(kx[ii]*kx[ii] + ky[jj]*ky[jj])*i_a.spectral_space_data[idx];
+		);
+
+		p_spectral_finalize(out);
+		return out;
 	}
 
 
@@ -53,7 +72,147 @@ public:
 			const PlaneDataComplex &i_a
 	)
 	{
-		return diff_c_x(i_a)+diff_c_y(i_a);
+		return div(i_a, i_a);
+	}
+
+
+
+	/**
+	 * Vorticity
+	 *
+	 * vort(a,b) = db/dx - da/dy
+	 */
+	PlaneDataComplex vort(
+			const PlaneDataComplex &a,
+			const PlaneDataComplex &b
+	)
+	{
+		PlaneDataComplex out(planeDataConfig);
+		a.request_data_spectral();
+		b.request_data_spectral();
+
+		const double *kx = wavenumbers_x.data();
+		const double *ky = wavenumbers_y.data();
+
+		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
+				// i*(kx*b - ky*a)
+				std::complex<double> d = kx[ii]*b.spectral_space_data[idx] - ky[jj]*a.spectral_space_data[idx];
+				out.spectral_space_data[idx] = std::complex<double>(-d.imag(), d.real());
+		);
+
+		p_spectral_finalize(out);
+		return out;
+	}
+
+
+
+	/**
+	 * Divergence
+	 *
+	 * div(a,b) = da/dx + db/dy
+	 */
+	PlaneDataComplex div(
+			const PlaneDataComplex &a,
+			const PlaneDataComplex &b
+	)
+	{
+		PlaneDataComplex out(planeDataConfig);
+		a.request_data_spectral();
+		b.request_data_spectral();
+
+		const double *kx = wavenumbers_x.data();
+		const double *ky = wavenumbers_y.data();
+
+		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
+				// i*(kx*a + ky*b)
+				std::complex<double> d = kx[ii]*a.spectral_space_data[idx] + ky[jj]*b.spectral_space_data[idx];
+				out.spectral_space_data[idx] = std::complex<double>(-d.imag(), d.real());
+		);
+
+		p_spectral_finalize(out);
+		return out;
+	}
+
+
+
+	/**
+	 * Gradient
+	 *
+	 * (o_x, o_y) = (da/dx, da/dy)
+	 *
+	 * o_x and o_y need to be setup, a may be one of them
+	 */
+	void grad(
+			const PlaneDataComplex &a,
+			PlaneDataComplex &o_x,
+			PlaneDataComplex &o_y
+	)
+	{
+		a.request_data_spectral();
+
+		const double *kx = wavenumbers_x.data();
+		const double *ky = wavenumbers_y.data();
+
+		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
+				std::complex<double> d = a.spectral_space_data[idx];
+				o_x.spectral_space_data[idx] = std::complex<double>(-kx[ii]*d.imag(), kx[ii]*d.real());
+				o_y.spectral_space_data[idx] = std::complex<double>(-ky[jj]*d.imag(), ky[jj]*d.real());
+		);
+
+		p_spectral_finalize(o_x);
+		p_spectral_finalize(o_y);
+	}
+
+
+
+	/**
+	 * Solve the Helmholtz problem
+	 *
+	 *   (a + b*\nabla^2) x = rhs
+	 *
+	 * Modes with a vanishing operator are set to zero
+	 * (see PlaneDataComplex::spectral_div_element_wise)
+	 */
+	PlaneDataComplex helmholtz_inverse(
+			const PlaneDataComplex &i_rhs,
+			const std::complex<double> &i_a,
+			double i_b
+	)
+	{
+		PlaneDataComplex out(planeDataConfig);
+		i_rhs.request_data_spectral();
+
+		const double *kx = wavenumbers_x.data();
+		const double *ky = wavenumbers_y.data();
+
+#if SWEET_COMPLEX_SPLIT
+		/*
+		 * Division with real arithmetic on the real and imaginary parts
+		 * which can be vectorized (see SplitComplexKernels::div_element)
+		 */
+		double a_re = i_a.real();
+		double a_im = i_a.imag();
+
+		const double *rhs = reinterpret_cast<const double*>(i_rhs.spectral_space_data);
+		double *o = reinterpret_cast<double*>(out.spectral_space_data);
+
+		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
+				double den_re = a_re - i_b*(kx[ii]*kx[ii] + ky[jj]*ky[jj]);
+
+				SplitComplexKernels::div_element(rhs[2*idx], rhs[2*idx+1], den_re, a_im, o[2*idx], o[2*idx+1]);
+		);
+#else
+		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
+				std::complex<double> den = i_a - i_b*(kx[ii]*kx[ii] + ky[jj]*ky[jj]);
+				if (den == 0.0)
+					out.spectral_space_data[idx] = 0;
+				else
+					out.spectral_space_data[idx] = i_rhs.spectral_space_data[idx]/den;
+		);
+#endif
+
+		p_spectral_finalize(out);
+		return out;
 	}
 
 
@@ -124,11 +283,17 @@ public:
 		//Check if even
 		assert( i_order % 2 == 0);
 		assert( i_order > 0);
-		PlaneDataComplex out = diff2_c_x+diff2_c_y;
 
-		for (int i = 1; i < i_order/2; i++)
-			out = pow(-1, i)*(diff2_c_x(out)+diff2_c_y(out));
+		PlaneDataComplex out(planeDataConfig);
+
+		const double *kx = wavenumbers_x.data();
+		const double *ky = wavenumbers_y.data();
 
+		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
+				out.spectral_space_data[idx] = p_diffusion_symbol(kx[ii]*kx[ii] + ky[jj]*ky[jj], i_order);
+		);
+
+		p_spectral_finalize(out);
 		return out;
 	}
 
@@ -148,21 +313,57 @@ public:
 			int i_order
 	)
 	{
-		PlaneDataComplex out=i_data;
+		PlaneDataComplex out(planeDataConfig);
+		i_data.request_data_spectral();
+
+		const double *kx = wavenumbers_x.data();
+		const double *ky = wavenumbers_y.data();
+
+		// Apply 1/(1-mu*dt*D^q)
+		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
+				double den = 1.0 - i_coef*p_diffusion_symbol(kx[ii]*kx[ii] + ky[jj]*ky[jj], i_order);
+				if (den == 0)
+					out.spectral_space_data[idx] = 0;
+				else
+					out.spectral_space_data[idx] = i_data.spectral_space_data[idx]/den;
+		);
+
+		p_spectral_finalize(out);
+		return out;
+	}
+#endif
 
-		// Get diffusion coefficients (these are the -mu*dt*D^q, where q is the order
-		PlaneDataComplex diff = -i_coef*diffusion_coefficient(i_order);
 
-		// Add 1 to get denominator
-		diff = diff.spectral_addScalarAll(1.0);
+private:
+	/**
+	 * Spectral symbol of diffusion_coefficient() for the squared wavenumber kk
+	 */
+	inline static double p_diffusion_symbol(
+			double kk,
+			int i_order
+	)
+	{
+		double d = -kk;
+
+		for (int i = 1; i < i_order/2; i++)
+			d = pow(-1, i)*(-kk)*d;
 
-		// Invert
-		diff = diff.spectral_invert();
-		// apply to data
-		out=diff(out);
-		return out;
+		return d;
 	}
-#endif
+
+
+	inline void p_spectral_finalize(
+			PlaneDataComplex &io_data
+	)
+	{
+		io_data.spectral_space_data_valid = true;
+		io_data.physical_space_data_valid = false;
+
+		io_data.spectral_zeroAliasingModes();
+	}
+
+
+public:
 
 
 	void setup(
@@ -171,12 +372,6 @@ public:
 	)
 	{
 		planeDataConfig = i_planeDataConfig;
-		
-		diff_c_x.setup(i_planeDataConfig);
-		diff_c_y.setup(i_planeDataConfig);
-		diff2_c_x.setup(i_planeDataConfig);
-		diff2_c_y.setup(i_planeDataConfig);
-
 
 		/*
 		 * setup spectral differential operators
@@ -189,144 +384,52 @@ public:
 #endif
 
 		/*
-		 * DIFF X
+		 * The wavenumbers only depend on one spectral index, hence
+		 * only these 1D vectors are stored instead of full-size
+		 * operator arrays (see PlaneOperatorDiffComplex).
+		 *
+		 * Quadrants: 0: left bottom, 1: left top, 2: right bottom, 3: right top
 		 */
-		{
-			diff_c_x.spectral_set_zero();
-			double scale_x = 2.0*M_PIl/i_domain_size[0];
-
-#if 1
-			/*
-			 * left bottom
-			 */
-			SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
-			for (std::size_t j = planeDataConfig->spectral_complex_ranges[0][1][0]; j < planeDataConfig->spectral_complex_ranges[0][1][1]; j++)
-				for (std::size_t i = planeDataConfig->spectral_complex_ranges[0][0][0]; i < planeDataConfig->spectral_complex_ranges[0][0][1]; i++)
-					diff_c_x.p_spectral_set(j, i, 0, (double)i*scale_x);
-#endif
-
+		double scale_x = 2.0*M_PIl/i_domain_size[0];
+		double scale_y = 2.0*M_PIl/i_domain_size[1];
 
-#if 1
-			/*
-			 * left top
-			 */
-			SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
-			for (std::size_t j = planeDataConfig->spectral_complex_ranges[1][1][0]; j < planeDataConfig->spectral_complex_ranges[1][1][1]; j++)
-				for (std::size_t i = planeDataConfig->spectral_complex_ranges[1][0][0]; i < planeDataConfig->spectral_complex_ranges[1][0][1]; i++)
-					diff_c_x.p_spectral_set(j, i, 0, (double)i*scale_x);
-#endif
-
-#if 1
-			/*
-			 * right bottom
-			 */
-			SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
-			for (std::size_t j = planeDataConfig->spectral_complex_ranges[2][1][0]; j < planeDataConfig->spectral_complex_ranges[2][1][1]; j++)
-				for (std::size_t i = planeDataConfig->spectral_complex_ranges[2][0][0]; i < planeDataConfig->spectral_complex_ranges[2][0][1]; i++)
-					diff_c_x.p_spectral_set(j, i, 0, -(double)(planeDataConfig->spectral_complex_ranges[2][0][1]-i)*scale_x);
-#endif
+		wavenumbers_x.assign(planeDataConfig->spectral_complex_data_size[0], 0);
+		wavenumbers_y.assign(planeDataConfig->spectral_complex_data_size[1], 0);
 
-#if 1
-			/*
-			 * right top
-			 */
-			SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
-			for (std::size_t j = planeDataConfig->spectral_complex_ranges[3][1][0]; j < planeDataConfig->spectral_complex_ranges[3][1][1]; j++)
-				for (std::size_t i = planeDataConfig->spectral_complex_ranges[3][0][0]; i < planeDataConfig->spectral_complex_ranges[3][0][1]; i++)
-					diff_c_x.p_spectral_set(j, i, 0, -(double)(planeDataConfig->spectral_complex_ranges[3][0][1]-i)*scale_x);
-#endif
-
-			diff_c_x.physical_space_data_valid = false;
-			diff_c_x.spectral_space_data_valid = true;
-		}
-
-		/*
-		 * DIFF Y
-		 */
-		{
-			diff_c_y.spectral_set_zero();
-			double scale_y = 2.0*M_PIl/i_domain_size[1];
-
-
-#if 1
-			/*
-			 * left bottom
-			 */
-			SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
-			for (std::size_t j = planeDataConfig->spectral_complex_ranges[0][1][0]; j < planeDataConfig->spectral_complex_ranges[0][1][1]; j++)
-				for (std::size_t i = planeDataConfig->spectral_complex_ranges[0][0][0]; i < planeDataConfig->spectral_complex_ranges[0][0][1]; i++)
-					diff_c_y.p_spectral_set(j, i, 0, (double)j*scale_y);
-#endif
-
-
-#if 1
-			/*
-			 * left top
-			 */
-			SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
-			for (std::size_t j = planeDataConfig->spectral_complex_ranges[1][1][0]; j < planeDataConfig->spectral_complex_ranges[1][1][1]; j++)
-				for (std::size_t i = planeDataConfig->spectral_complex_ranges[1][0][0]; i < planeDataConfig->spectral_complex_ranges[1][0][1]; i++)
-					diff_c_y.p_spectral_set(j, i, 0, -(double)(planeDataConfig->spectral_complex_ranges[1][1][1]-j)*scale_y);
-#endif
-
-#if 1
-			/*
-			 * right bottom
-			 */
-			SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
-			for (std::size_t j = planeDataConfig->spectral_complex_ranges[2][1][0]; j < planeDataConfig->spectral_complex_ranges[2][1][1]; j++)
-				for (std::size_t i = planeDataConfig->spectral_complex_ranges[2][0][0]; i < planeDataConfig->spectral_complex_ranges[2][0][1]; i++)
-					diff_c_y.p_spectral_set(j, i, 0, (double)(j)*scale_y);
-#endif
-
-
-#if 1
-			/*
-			 * right top
-			 */
-			SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
-			for (std::size_t j = planeDataConfig->spectral_complex_ranges[3][1][0]; j < planeDataConfig->spectral_complex_ranges[3][1][1]; j++)
-				for (std::size_t i = planeDataConfig->spectral_complex_ranges[3][0][0]; i < planeDataConfig->spectral_complex_ranges[3][0][1]; i++)
-					diff_c_y.p_spectral_set(j, i, 0, -(double)(planeDataConfig->spectral_complex_ranges[3][1][1]-j)*scale_y);
-#endif
-
-			diff_c_y.physical_space_data_valid = false;
-			diff_c_y.spectral_space_data_valid = true;
-		}
-
-		/*
-		 * 2nd order differential operators
-		 */
-		/*
-		 * DIFF2 X
-		 */
+		for (int r = 0; r < 4; r++)
 		{
-			SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
-			for (std::size_t i = 0; i < planeDataConfig->spectral_complex_array_data_number_of_elements; i++)
-				diff2_c_x.spectral_space_data[i] = diff_c_x.spectral_space_data[i]*diff_c_x.spectral_space_data[i];
-
-			diff2_c_x.physical_space_data_valid = false;
-			diff2_c_x.spectral_space_data_valid = true;
+			for (std::size_t i = planeDataConfig->spectral_complex_ranges[r][0][0]; i < planeDataConfig->spectral_complex_ranges[r][0][1]; i++)
+			{
+				if (r < 2)
+					wavenumbers_x[i] = (double)i*scale_x;
+				else
+					wavenumbers_x[i] = -(double)(planeDataConfig->spectral_complex_ranges[r][0][1]-i)*scale_x;
+			}
+
+			for (std::size_t j = planeDataConfig->spectral_complex_ranges[r][1][0]; j < planeDataConfig->spectral_complex_ranges[r][1][1]; j++)
+			{
+				if ((r & 1) == 0)
+					wavenumbers_y[j] = (double)j*scale_y;
+				else
+					wavenumbers_y[j] = -(double)(planeDataConfig->spectral_complex_ranges[r][1][1]-j)*scale_y;
+			}
 		}
 
+		diff_c_x.setup_spectral(planeDataConfig, 0, 1, wavenumbers_x);
+		diff_c_y.setup_spectral(planeDataConfig, 1, 1, wavenumbers_y);
 
 		/*
-		 * DIFF2 X
+		 * 2nd order differential operators
 		 */
-		{
-			SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
-			for (std::size_t i = 0; i < planeDataConfig->spectral_complex_array_data_number_of_elements; i++)
-				diff2_c_y.spectral_space_data[i] = diff_c_y.spectral_space_data[i]*diff_c_y.spectral_space_data[i];
-
-			diff2_c_y.physical_space_data_valid = false;
-			diff2_c_y.spectral_space_data_valid = true;
-		}
+		diff2_c_x.setup_spectral(planeDataConfig, 0, 2, wavenumbers_x);
+		diff2_c_y.setup_spectral(planeDataConfig, 1, 2, wavenumbers_y);
 	}
 
 
 
 public:
-	PlaneOperatorsComplex()
+	PlaneOperatorsComplex()	:
+		planeDataConfig(nullptr)
 	{
 	}
 
@@ -337,12 +440,7 @@ public:
 		PlaneDataConfig *i_planeDataConfig,
 		const double i_domain_size[2]	///< domain size
 	)	:
-		planeDataConfig(i_planeDataConfig),
-
-		diff_c_x(i_planeDataConfig),
-		diff_c_y(i_planeDataConfig),
-		diff2_c_x(i_planeDataConfig),
-		diff2_c_y(i_planeDataConfig)
+		planeDataConfig(i_planeDataConfig)
 	{
 		setup(i_planeDataConfig, i_domain_size);
 	}
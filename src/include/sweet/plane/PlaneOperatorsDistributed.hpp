@@ -0,0 +1,271 @@
+/*
+ * PlaneOperatorsDistributed.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_PLANE_PLANEOPERATORSDISTRIBUTED_HPP_
+#define SRC_INCLUDE_SWEET_PLANE_PLANEOPERATORSDISTRIBUTED_HPP_
+
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <sweet/sweetmath.hpp>
+#include <sweet/plane/PlaneDataConfigDistributed.hpp>
+#include <sweet/plane/PlaneDataDistributed.hpp>
+
+
+
+/*
+ * Loop over the local spectral data with the local index ii of the
+ * wavenumber in x-direction and the index jj of the wavenumber in y-direction
+ */
+#define PLANE_DATA_DISTRIBUTED_SPECTRAL_FOR_2D_IDX(CORE)				\
+		SWEET_THREADING_SPACE_PARALLEL_FOR			\
+		for (std::size_t ii = 0; ii < planeDataConfig->spectral_local_kx_size; ii++)	\
+		{				\
+			for (std::size_t jj = 0; jj < planeDataConfig->spectral_data_size[1]; jj++)	\
+			{			\
+				std::size_t idx = ii*planeDataConfig->spectral_data_size[1]+jj;	\
+				CORE	\
+			}			\
+		}
+
+
+
+/**
+ * Spectral differential operators for distributed plane data
+ *
+ * Same as the spectral operators in PlaneOperators, but they work
+ * on the local range of wavenumbers in x-direction.
+ * None of the operators requires communication.
+ */
+class PlaneOperatorsDistributed
+{
+public:
+	const PlaneDataConfigDistributed *planeDataConfig;
+
+	/// Wavenumbers of the local range in x-direction (zero for aliased modes)
+	std::vector<double> wavenumbers_x;
+
+	/// Wavenumbers in y-direction (zero for aliased modes)
+	std::vector<double> wavenumbers_y;
+
+
+public:
+	PlaneOperatorsDistributed()	:
+		planeDataConfig(nullptr)
+	{
+	}
+
+
+	PlaneOperatorsDistributed(
+			const PlaneDataConfigDistributed *i_planeDataConfig,
+			const double i_domain_size[2]
+	)
+	{
+		setup(i_planeDataConfig, i_domain_size);
+	}
+
+
+	void setup(
+			const PlaneDataConfigDistributed *i_planeDataConfig,
+			const double i_domain_size[2]
+	)
+	{
+		planeDataConfig = i_planeDataConfig;
+
+		const std::size_t (&ranges)[2][2][2] = planeDataConfig->spectral_data_iteration_ranges;
+
+		wavenumbers_x.assign(planeDataConfig->spectral_local_kx_size, 0);
+		for (std::size_t ii = 0; ii < planeDataConfig->spectral_local_kx_size; ii++)
+		{
+			std::size_t i = planeDataConfig->spectral_local_kx_start + ii;
+
+			if (i >= ranges[0][0][0] && i < ranges[0][0][1])
+				wavenumbers_x[ii] = (double)i*2.0*M_PIl/(double)i_domain_size[0];
+		}
+
+		wavenumbers_y.assign(planeDataConfig->spectral_data_size[1], 0);
+		for (std::size_t j = ranges[0][1][0]; j < ranges[0][1][1]; j++)
+			wavenumbers_y[j] = (double)j*2.0*M_PIl/(double)i_domain_size[1];
+
+		for (std::size_t j = ranges[1][1][0]; j < ranges[1][1][1]; j++)
+			wavenumbers_y[j] = -(double)(planeDataConfig->spectral_data_size[1]-j)*2.0*M_PIl/(double)i_domain_size[1];
+	}
+
+
+
+private:
+	void p_spectral_finalize(
+			PlaneDataDistributed &io_data
+	)	const
+	{
+		io_data.spectral_space_data_valid = true;
+		io_data.physical_space_data_valid = false;
+		io_data.spectral_zeroAliasingModes();
+	}
+
+
+public:
+	PlaneDataDistributed diff_c_x(
+			const PlaneDataDistributed &i_data
+	)	const
+	{
+		PlaneDataDistributed out(planeDataConfig);
+		i_data.request_data_spectral();
+
+		const double *kx = wavenumbers_x.data();
+
+		PLANE_DATA_DISTRIBUTED_SPECTRAL_FOR_2D_IDX(
+				const std::complex<double> &d = i_data.spectral_space_data[idx];
+				out.spectral_space_data[idx] = std::complex<double>(-kx[ii]*d.imag(), kx[ii]*d.real());
+		);
+
+		p_spectral_finalize(out);
+		return out;
+	}
+
+
+	PlaneDataDistributed diff_c_y(
+			const PlaneDataDistributed &i_data
+	)	const
+	{
+		PlaneDataDistributed out(planeDataConfig);
+		i_data.request_data_spectral();
+
+		const double *ky = wavenumbers_y.data();
+
+		PLANE_DATA_DISTRIBUTED_SPECTRAL_FOR_2D_IDX(
+				const std::complex<double> &d = i_data.spectral_space_data[idx];
+				out.spectral_space_data[idx] = std::complex<double>(-ky[jj]*d.imag(), ky[jj]*d.real());
+		);
+
+		p_spectral_finalize(out);
+		return out;
+	}
+
+
+	PlaneDataDistributed laplace(
+			const PlaneDataDistributed &i_data
+	)	const
+	{
+		PlaneDataDistributed out(planeDataConfig);
+		i_data.request_data_spectral();
+
+		const double *kx = wavenumbers_x.data();
+		const double *ky = wavenumbers_y.data();
+
+		PLANE_DATA_DISTRIBUTED_SPECTRAL_FOR_2D_IDX(
+				out.spectral_space_data[idx] = -(kx[ii]*kx[ii] + ky[jj]*ky[jj])*i_data.spectral_space_data[idx];
+		);
+
+		p_spectral_finalize(out);
+		return out;
+	}
+
+
+	/**
+	 * Compute vorticity
+	 *
+	 * \eta = div_x(v) - div_y(u)
+	 */
+	PlaneDataDistributed vort(
+			const PlaneDataDistributed &a,
+			const PlaneDataDistributed &b
+	)	const
+	{
+		PlaneDataDistributed out(planeDataConfig);
+		a.request_data_spectral();
+		b.request_data_spectral();
+
+		const double *kx = wavenumbers_x.data();
+		const double *ky = wavenumbers_y.data();
+
+		PLANE_DATA_DISTRIBUTED_SPECTRAL_FOR_2D_IDX(
+				// i*(kx*b - ky*a)
+				std::complex<double> d = kx[ii]*b.spectral_space_data[idx] - ky[jj]*a.spectral_space_data[idx];
+				out.spectral_space_data[idx] = std::complex<double>(-d.imag(), d.real());
+		);
+
+		p_spectral_finalize(out);
+		return out;
+	}
+
+
+	/**
+	 * Compute divergence
+	 *
+	 * \delta = div_x(u) + div_y(v)
+	 */
+	PlaneDataDistributed div(
+			const PlaneDataDistributed &a,
+			const PlaneDataDistributed &b
+	)	const
+	{
+		PlaneDataDistributed out(planeDataConfig);
+		a.request_data_spectral();
+		b.request_data_spectral();
+
+		const double *kx = wavenumbers_x.data();
+		const double *ky = wavenumbers_y.data();
+
+		PLANE_DATA_DISTRIBUTED_SPECTRAL_FOR_2D_IDX(
+				// i*(kx*a + ky*b)
+				std::complex<double> d = kx[ii]*a.spectral_space_data[idx] + ky[jj]*b.spectral_space_data[idx];
+				out.spectral_space_data[idx] = std::complex<double>(-d.imag(), d.real());
+		);
+
+		p_spectral_finalize(out);
+		return out;
+	}
+
+
+	/**
+	 * Compute kinetic energy
+	 */
+	PlaneDataDistributed ke(
+			const PlaneDataDistributed &a,
+			const PlaneDataDistributed &b
+	)	const
+	{
+		return 0.5*(a*a+b*b);
+	}
+
+
+	/**
+	 * Solve the Helmholtz problem
+	 *
+	 *   (a + b*\nabla^2) x = rhs
+	 *
+	 * Modes with a vanishing operator are set to zero
+	 */
+	PlaneDataDistributed helmholtz_inverse(
+			const PlaneDataDistributed &i_rhs,
+			double i_a,
+			double i_b
+	)	const
+	{
+		PlaneDataDistributed out(planeDataConfig);
+		i_rhs.request_data_spectral();
+
+		const double *kx = wavenumbers_x.data();
+		const double *ky = wavenumbers_y.data();
+
+		PLANE_DATA_DISTRIBUTED_SPECTRAL_FOR_2D_IDX(
+				double den = i_a - i_b*(kx[ii]*kx[ii] + ky[jj]*ky[jj]);
+				if (den == 0)
+					out.spectral_space_data[idx] = 0;
+				else
+					out.spectral_space_data[idx] = i_rhs.spectral_space_data[idx]/den;
+		);
+
+		p_spectral_finalize(out);
+		return out;
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_PLANE_PLANEOPERATORSDISTRIBUTED_HPP_ */
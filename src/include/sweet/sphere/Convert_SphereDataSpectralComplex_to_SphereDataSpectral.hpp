@@ -47,6 +47,51 @@ public:
 
 		return SphereData_Spectral(tmp);
 	}
+
+
+
+	/**
+	 * Real part of the data, computed in spectral space
+	 *
+	 * With the SHTNS convention Y_n^{-m} = (-1)^m conj(Y_n^m), the modes of
+	 * the real part are 0.5*(a_n^m + (-1)^m conj(a_n^{-m})) for m >= 0.
+	 *
+	 * This is identical to physical_convert_real() (up to round-off errors),
+	 * but avoids the two SH transformations.
+	 */
+public:
+	static
+	SphereData_Spectral spectral_convert_real_part(
+			const SphereData_SpectralComplex &i_sphereData
+	)
+	{
+		const SphereData_Config *sphereDataConfig = i_sphereData.sphereDataConfig;
+		SphereData_Spectral out(sphereDataConfig);
+
+		i_sphereData.request_data_spectral();
+
+		const double *in = reinterpret_cast<const double*>(i_sphereData.spectral_space_data);
+		double *o = reinterpret_cast<double*>(out.spectral_space_data);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (int m = 0; m <= sphereDataConfig->spectral_modes_m_max; m++)
+		{
+			double sign = ((m & 1) ? -1.0 : 1.0);
+			std::size_t idx = sphereDataConfig->getArrayIndexByModes(m, m);
+
+			SWEET_OMP_SIMD
+			for (int n = m; n <= sphereDataConfig->spectral_modes_n_max; n++)
+			{
+				std::size_t idx_pos = sphereDataConfig->getArrayIndexByModes_Complex(n, m);
+				std::size_t idx_neg = sphereDataConfig->getArrayIndexByModes_Complex(n, -m);
+
+				o[2*(idx+n-m)] = 0.5*(in[2*idx_pos] + sign*in[2*idx_neg]);
+				o[2*(idx+n-m)+1] = 0.5*(in[2*idx_pos+1] - sign*in[2*idx_neg+1]);
+			}
+		}
+
+		return out;
+	}
 };
 
 
@@ -39,8 +39,24 @@ class SphereData_Config
 public:
 	shtns_cfg shtns;
 
+	/**
+	 * Handle without Robert formulation for vector transformations
+	 *
+	 * This shares the grid with 'shtns' (which uses the Robert formulation).
+	 * Using a separate handle instead of toggling shtns_robert_form()
+	 * makes all operators reentrant, e.g. for concurrent REXI terms.
+	 */
+public:
+	shtns_cfg shtns_nonrobert;
+
+	/**
+	 * Number of threads for the SHTNS transformations of this configuration
+	 * (0: automatically chosen based on the number of OpenMP threads)
+	 *
+	 * This has to be set before the setup.
+	 */
 public:
-	shtns_cfg shtns_robert;
+	int shtns_num_threads;
 
 	/**
 	 * Number of longitudes
@@ -110,6 +126,8 @@ public:
 public:
 	SphereData_Config()	:
 		shtns(nullptr),
+		shtns_nonrobert(nullptr),
+		shtns_num_threads(0),
 		physical_num_lon(-1),
 		physical_num_lat(-1),
 		physical_array_data_number_of_elements(-1),
@@ -202,6 +220,12 @@ private:
 		shtns_print_cfg(shtns);
 #endif
 
+		if (shtns_nonrobert != nullptr)
+			shtns_destroy(shtns_nonrobert);
+
+		shtns_nonrobert = shtns_create_with_grid(shtns, shtns->lmax, shtns->mmax);
+		shtns_robert_form(shtns_nonrobert, 0);
+
 		physical_num_lat = shtns->nlat;
 		physical_num_lon = shtns->nphi;
 		physical_array_data_number_of_elements = shtns->nspat;
@@ -377,6 +401,23 @@ private:
 
 
 
+	/**
+	 * Enable multi-threaded transforms (if supported).
+	 *
+	 * This is a global setting in SHTNS which is used for all
+	 * subsequently created configurations.
+	 */
+	void p_setup_shtns_threads()
+	{
+#if SWEET_THREADING_SPACE
+		shtns_use_threads(shtns_num_threads);	// 0: automatically choose number of threads
+#else
+		shtns_use_threads(1);	// value of 1 disables threading
+#endif
+	}
+
+
+
 	int getFlags(
 			int i_reuse_spectral_transformation_plans
 	)
@@ -428,12 +469,7 @@ public:
 #endif
 		shtns_verbose(0);			// displays informations during initialization.
 
-		// enable multi-threaded transforms (if supported).
-#if SWEET_THREADING_SPACE
-		shtns_use_threads(0);	// automatically choose number of threads
-#else
-		shtns_use_threads(1);	// value of 1 disables threading
-#endif
+		p_setup_shtns_threads();
 
 		if (shtns != nullptr)
 			shtns_destroy(shtns);
@@ -493,11 +529,7 @@ public:
 
 		shtns_verbose(1);			// displays informations during initialization.
 
-#if SWEET_THREADING_SPACE
-		shtns_use_threads(0);	// automatically choose number of threads based on omp_num_threads
-#else
-		shtns_use_threads(1);	// value of 1 disables threading
-#endif
+		p_setup_shtns_threads();
 
 
 		if (shtns != nullptr)
@@ -559,11 +591,7 @@ public:
 		cleanup(false);
 
 		shtns_verbose(0);			// displays informations during initialization.
-#if SWEET_THREADING_SPACE
-		shtns_use_threads(0);	// automatically choose number of threads
-#else
-		shtns_use_threads(1);	// value of 1 disables threading
-#endif
+		p_setup_shtns_threads();
 
 
 		if (shtns != nullptr)
@@ -692,6 +720,32 @@ public:
 
 
 
+	/**
+	 * Setup with the same grid and modes as the given configuration,
+	 * but with a particular number of threads for SHTNS.
+	 *
+	 * This is used for thread groups which execute transformations
+	 * concurrently, each one with a team of threads.
+	 */
+	void setupSameResolution(
+			const SphereData_Config *i_sphereDataConfig,
+			int i_shtns_num_threads,
+			int i_reuse_transformation_plans
+	)
+	{
+		shtns_num_threads = i_shtns_num_threads;
+
+		setup(
+				i_sphereDataConfig->physical_num_lon,
+				i_sphereDataConfig->physical_num_lat,
+				i_sphereDataConfig->spectral_modes_m_max+1,
+				i_sphereDataConfig->spectral_modes_n_max+1,
+				i_reuse_transformation_plans
+			);
+	}
+
+
+
 	void cleanup(
 		bool i_full_reset = true
 	)
@@ -709,6 +763,12 @@ public:
 		fftw_free(lat_cogaussian);
 		lat_cogaussian = nullptr;
 
+		if (shtns_nonrobert != nullptr)
+		{
+			shtns_destroy(shtns_nonrobert);
+			shtns_nonrobert = nullptr;
+		}
+
 		shtns_destroy(shtns);
 		shtns = nullptr;
 
@@ -0,0 +1,787 @@
+/*
+ * SphereData_ConfigDistributed.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SPHERE_SPHEREDATA_CONFIGDISTRIBUTED_HPP_
+#define SRC_INCLUDE_SWEET_SPHERE_SPHEREDATA_CONFIGDISTRIBUTED_HPP_
+
+#include <fftw3.h>
+#include <complex>
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+#include <sweet/MemBlockAlloc.hpp>
+#include <sweet/FatalError.hpp>
+#include <sweet/openmp_helper.hpp>
+#include <sweet/GlobalTranspose.hpp>
+
+#if SWEET_THREADING_SPACE
+#	include <omp.h>
+#endif
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
+
+
+
+/**
+ * Configuration of sphere data which is distributed over MPI ranks
+ *
+ * Physical space:
+ *   Each rank stores a contiguous range of latitudes with all longitudes,
+ *   layout [lat-lat_start][lon] (like SphereData_Physical, but only the local latitudes).
+ *
+ * Spectral space:
+ *   Each rank stores a contiguous range of the zonal wavenumbers m with all n.
+ *   Since the modes are stored m-major, the local modes are a contiguous
+ *   part of the global array (see getLocalArrayIndexByModes()).
+ *
+ * The spherical harmonics transformation to spectral space
+ *   1) computes the real-to-complex FFTs along all local latitudes,
+ *   2) redistributes the Fourier coefficients m <= m_max with a global
+ *      transpose (MPI_Alltoallv), so that each rank gets all latitudes
+ *      for its local m and
+ *   3) computes the Legendre transformation for each local m.
+ * The backward transformation executes these steps in reverse order.
+ *
+ * The zonal wavenumbers are distributed such that the number of modes
+ * (and hence the Legendre transformation costs) is balanced.
+ *
+ * This doesn't require SHTNS and no rank stores any data of the full
+ * spectral space: The Gaussian grid only has O(num_lat) values and the
+ * associated Legendre functions are computed on the fly with recurrence
+ * coefficients for the local modes only. The normalization is the same
+ * as for SphereData_Config (orthonormal without Condon-Shortley phase),
+ * hence the modes match those of SphereData_Spectral.
+ */
+class SphereData_ConfigDistributed
+{
+public:
+	int physical_num_lon;
+	int physical_num_lat;
+
+	/// Max. modes (inclusive), same as for SphereData_Config
+	int spectral_modes_m_max;
+	int spectral_modes_n_max;
+
+	/// number of modes of the (not stored) global spectral data
+	int spectral_array_data_number_of_elements;
+
+	/// Gaussian latitudes of all latitudes (north to south), same as SphereData_Config::lat
+	std::vector<double> lat;
+
+	/// mu = sin(phi) of all latitudes
+	std::vector<double> lat_gaussian;
+
+	/// comu = cos(phi) of all latitudes
+	std::vector<double> lat_cogaussian;
+
+#if SWEET_MPI
+	MPI_Comm mpi_comm;
+#endif
+
+	int mpi_rank;
+	int mpi_size;
+
+	/// Local latitudes in physical space
+	int physical_local_lat_start;
+	int physical_local_lat_size;
+
+	/// number of local real valued data
+	int physical_local_array_data_number_of_elements;
+
+	/// Local zonal wavenumbers m in spectral space
+	int spectral_local_m_start;
+	int spectral_local_m_size;
+
+	/// Global array index of the first local mode
+	std::size_t spectral_local_array_data_offset;
+
+	/// number of local complex valued modes
+	int spectral_local_array_data_number_of_elements;
+
+	/// Distribution of the latitudes and zonal wavenumbers of all ranks
+	std::vector<std::size_t> physical_lat_start_ranks;
+	std::vector<std::size_t> physical_lat_size_ranks;
+	std::vector<std::size_t> spectral_m_start_ranks;
+	std::vector<std::size_t> spectral_m_size_ranks;
+
+private:
+	/// Gaussian quadrature weights of all latitudes (sum up to 2)
+	std::vector<double> gauss_weights;
+
+	/**
+	 * Recurrence coefficients of the associated Legendre functions
+	 * for the local modes, stored like the local spectral data:
+	 *
+	 *   y_mm = legendre_a[idx(m,m)]*cos(phi)^m
+	 *   y_(m+1)m = legendre_a[idx(m+1,m)]*mu*y_mm
+	 *   y_nm = legendre_a[idx(n,m)]*(mu*y_(n-1)m - legendre_b[idx(n,m)]*y_(n-2)m)
+	 */
+	std::vector<double> legendre_a;
+	std::vector<double> legendre_b;
+
+	/// Transpose between local latitudes and local zonal wavenumbers
+	GlobalTranspose transpose;
+
+	/// Number of Fourier coefficients of a real-to-complex FFT along a latitude
+	std::size_t fourier_data_size;
+
+	/// FFTs along all local latitudes
+	fftw_plan fftw_plan_forward;
+	fftw_plan fftw_plan_backward;
+
+	bool initialized;
+
+
+public:
+	SphereData_ConfigDistributed()	:
+		physical_num_lon(-1),
+		physical_num_lat(-1),
+		spectral_modes_m_max(-1),
+		spectral_modes_n_max(-1),
+		spectral_array_data_number_of_elements(0),
+		mpi_rank(0),
+		mpi_size(1),
+		physical_local_lat_start(0),
+		physical_local_lat_size(0),
+		physical_local_array_data_number_of_elements(0),
+		spectral_local_m_start(0),
+		spectral_local_m_size(0),
+		spectral_local_array_data_offset(0),
+		spectral_local_array_data_number_of_elements(0),
+		fourier_data_size(0),
+		fftw_plan_forward(nullptr),
+		fftw_plan_backward(nullptr),
+		initialized(false)
+	{
+#if SWEET_MPI
+		mpi_comm = MPI_COMM_WORLD;
+#endif
+	}
+
+
+	~SphereData_ConfigDistributed()
+	{
+		cleanup();
+	}
+
+
+	const
+	std::string getConfigInformationString()	const
+	{
+		std::ostringstream buf;
+		buf << "M" << spectral_modes_m_max << "," << spectral_modes_n_max << "_N" << physical_num_lon << "," << physical_num_lat;
+		buf << " total_spec_modes: " << spectral_array_data_number_of_elements;
+		return buf.str();
+	}
+
+
+	void printInformation()	const
+	{
+		std::cout << std::endl;
+		std::cout << getConfigInformationString() << std::endl;
+		std::cout << "mpi_rank / mpi_size: " << mpi_rank << " / " << mpi_size << std::endl;
+		std::cout << "physical_local_lat: " << physical_local_lat_start << " + " << physical_local_lat_size << std::endl;
+		std::cout << "spectral_local_m: " << spectral_local_m_start << " + " << spectral_local_m_size << std::endl;
+		std::cout << "spectral_local_array_data_number_of_elements: " << spectral_local_array_data_number_of_elements << std::endl;
+		std::cout << std::endl;
+	}
+
+
+	/**
+	 * Setup the distribution
+	 *
+	 * With MPI, this has to be called collectively by all ranks of the communicator.
+	 */
+	void setup(
+			int i_num_lon,		///< number of longitudes
+			int i_num_lat,		///< number of Gaussian latitudes
+			int i_m_max,		///< max. zonal wavenumber (inclusive)
+			int i_n_max,		///< max. total wavenumber (inclusive)
+			int i_reuse_spectral_transformation_plans	///< -1: estimate FFT plans, otherwise measure them
+#if SWEET_MPI
+			, MPI_Comm i_mpi_comm = MPI_COMM_WORLD
+#endif
+	)
+	{
+		cleanup();
+
+#if SWEET_MPI
+		mpi_comm = i_mpi_comm;
+		MPI_Comm_rank(mpi_comm, &mpi_rank);
+		MPI_Comm_size(mpi_comm, &mpi_size);
+#else
+		mpi_rank = 0;
+		mpi_size = 1;
+#endif
+
+		physical_num_lon = i_num_lon;
+		physical_num_lat = i_num_lat;
+		spectral_modes_m_max = i_m_max;
+		spectral_modes_n_max = i_n_max;
+
+		int num_lat = physical_num_lat;
+		int num_lon = physical_num_lon;
+		int m_max = spectral_modes_m_max;
+		int n_max = spectral_modes_n_max;
+
+		if (m_max > n_max)
+			FatalError("SphereData_ConfigDistributed: m_max must not be larger than n_max");
+
+		if (mpi_size > num_lat || mpi_size > m_max+1)
+			FatalError("SphereData_ConfigDistributed: More ranks than latitudes or zonal wavenumbers");
+
+		fourier_data_size = num_lon/2+1;
+
+		if ((int)fourier_data_size < m_max+1)
+			FatalError("SphereData_ConfigDistributed: Not enough longitudes for the zonal wavenumbers");
+
+		spectral_array_data_number_of_elements = getArrayIndexByModes(m_max, m_max)+1;
+
+		GlobalTranspose::distributeBlocks(num_lat, mpi_size, physical_lat_start_ranks, physical_lat_size_ranks);
+
+		// Costs of the Legendre transformation for each m
+		std::vector<double> m_costs(m_max+1);
+		for (int m = 0; m <= m_max; m++)
+			m_costs[m] = n_max-m+1;
+
+		GlobalTranspose::distributeCosts(m_costs, mpi_size, spectral_m_start_ranks, spectral_m_size_ranks);
+
+		transpose.setup(
+				physical_lat_start_ranks, physical_lat_size_ranks,
+				spectral_m_start_ranks, spectral_m_size_ranks,
+				mpi_rank
+#if SWEET_MPI
+				, mpi_comm
+#endif
+			);
+
+		physical_local_lat_start = physical_lat_start_ranks[mpi_rank];
+		physical_local_lat_size = physical_lat_size_ranks[mpi_rank];
+		physical_local_array_data_number_of_elements = physical_local_lat_size*num_lon;
+
+		spectral_local_m_start = spectral_m_start_ranks[mpi_rank];
+		spectral_local_m_size = spectral_m_size_ranks[mpi_rank];
+
+		int m_end = spectral_local_m_start + spectral_local_m_size;
+		spectral_local_array_data_offset = getArrayIndexByModes(spectral_local_m_start, spectral_local_m_start);
+
+		if (m_end <= m_max)
+			spectral_local_array_data_number_of_elements = getArrayIndexByModes(m_end, m_end) - spectral_local_array_data_offset;
+		else
+			spectral_local_array_data_number_of_elements = spectral_array_data_number_of_elements - spectral_local_array_data_offset;
+
+		p_setup_gaussian_grid();
+		p_setup_legendre_coefficients();
+		p_setup_plans(i_reuse_spectral_transformation_plans);
+
+		initialized = true;
+	}
+
+
+
+	/**
+	 * Setup with the number of modes and an optional physical resolution
+	 * (same parameters as SphereData_Config::setupAuto())
+	 *
+	 * Without a given physical resolution, the grid avoids aliasing
+	 * for quadratic terms: num_lon >= 3*m_max+1 (with a size which is
+	 * efficient for FFTs) and an even num_lat >= (3*n_max+1)/2.
+	 */
+	void setupAuto(
+			int io_physical_res[2],
+			const int i_spectral_modes[2],	///< number of modes (max. modes + 1)
+			int i_reuse_spectral_transformation_plans
+#if SWEET_MPI
+			, MPI_Comm i_mpi_comm = MPI_COMM_WORLD
+#endif
+	)
+	{
+		if (i_spectral_modes[0] <= 0 || i_spectral_modes[1] <= 0)
+			FatalError("SphereData_ConfigDistributed: Number of spectral modes required");
+
+		int m_max = i_spectral_modes[0]-1;
+		int n_max = i_spectral_modes[1]-1;
+
+		if (io_physical_res[0] <= 0 || io_physical_res[1] <= 0)
+		{
+			io_physical_res[0] = p_fft_size(3*m_max+1);
+			io_physical_res[1] = (3*n_max+2)/2;
+			io_physical_res[1] += io_physical_res[1] & 1;
+		}
+
+		setup(
+				io_physical_res[0], io_physical_res[1],
+				m_max, n_max,
+				i_reuse_spectral_transformation_plans
+#if SWEET_MPI
+				, i_mpi_comm
+#endif
+			);
+	}
+
+
+
+	void cleanup()
+	{
+		if (!initialized)
+			return;
+
+		fftw_destroy_plan(fftw_plan_forward);
+		fftw_destroy_plan(fftw_plan_backward);
+
+		fftw_plan_forward = nullptr;
+		fftw_plan_backward = nullptr;
+
+		legendre_a.clear();
+		legendre_b.clear();
+
+		initialized = false;
+	}
+
+
+
+	/**
+	 * Index of the mode (n,m) in the (not stored) global spectral data,
+	 * same as SphereData_Config::getArrayIndexByModes()
+	 */
+	inline
+	std::size_t getArrayIndexByModes(
+			int n,
+			int m
+	)	const
+	{
+		assert(n >= 0);
+		assert(n >= m);
+
+		return (m*(2*spectral_modes_n_max-m+1)>>1)+n;
+	}
+
+
+	/**
+	 * Index of the mode (n,m) in the local spectral data
+	 *
+	 * m has to be in the local range
+	 */
+	inline
+	std::size_t getLocalArrayIndexByModes(
+			int n,
+			int m
+	)	const
+	{
+		assert(isLocalM(m));
+		return getArrayIndexByModes(n, m) - spectral_local_array_data_offset;
+	}
+
+
+	inline
+	bool isLocalM(
+			int m
+	)	const
+	{
+		return m >= spectral_local_m_start && m < spectral_local_m_start + spectral_local_m_size;
+	}
+
+
+
+	/**
+	 * Spherical harmonics transformation of the local latitudes to the local modes
+	 *
+	 * Collective operation with MPI
+	 */
+	void sph_physical_to_spectral(
+			const double *i_physical_data,
+			std::complex<double> *o_spectral_data
+	)	const
+	{
+		int num_lat = physical_num_lat;
+
+		std::size_t rows_size = physical_local_lat_size*fourier_data_size;
+		std::complex<double> *rows = MemBlockAlloc::alloc< std::complex<double> >(rows_size*sizeof(std::complex<double>));
+
+		std::size_t columns_size = (std::size_t)spectral_local_m_size*num_lat;
+		std::complex<double> *columns = MemBlockAlloc::alloc< std::complex<double> >(columns_size*sizeof(std::complex<double>));
+
+		// 1D real-to-complex FFTs preserve the input
+		fftw_execute_dft_r2c(fftw_plan_forward, (double*)i_physical_data, (fftw_complex*)rows);
+
+		// Fourier coefficients m > m_max are dropped here
+		transpose.rowsToColumns(rows, fourier_data_size, columns);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (int m = spectral_local_m_start; m < spectral_local_m_start + spectral_local_m_size; m++)
+		{
+			p_legendre_analysis(
+					m,
+					columns + (std::size_t)(m-spectral_local_m_start)*num_lat,
+					o_spectral_data + getLocalArrayIndexByModes(m, m)
+				);
+		}
+
+		MemBlockAlloc::free(columns, columns_size*sizeof(std::complex<double>));
+		MemBlockAlloc::free(rows, rows_size*sizeof(std::complex<double>));
+	}
+
+
+	/**
+	 * Spherical harmonics transformation of the local modes to the local latitudes
+	 *
+	 * Collective operation with MPI
+	 */
+	void sph_spectral_to_physical(
+			const std::complex<double> *i_spectral_data,
+			double *o_physical_data
+	)	const
+	{
+		int num_lat = physical_num_lat;
+		int m_max = spectral_modes_m_max;
+
+		std::size_t columns_size = (std::size_t)spectral_local_m_size*num_lat;
+		std::complex<double> *columns = MemBlockAlloc::alloc< std::complex<double> >(columns_size*sizeof(std::complex<double>));
+
+		std::size_t rows_size = physical_local_lat_size*fourier_data_size;
+		std::complex<double> *rows = MemBlockAlloc::alloc< std::complex<double> >(rows_size*sizeof(std::complex<double>));
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (int m = spectral_local_m_start; m < spectral_local_m_start + spectral_local_m_size; m++)
+		{
+			p_legendre_synthesis(
+					m,
+					i_spectral_data + getLocalArrayIndexByModes(m, m),
+					columns + (std::size_t)(m-spectral_local_m_start)*num_lat
+				);
+		}
+
+		transpose.columnsToRows(columns, rows, fourier_data_size);
+
+		// Fourier coefficients m > m_max are not set by the transpose
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (int j = 0; j < physical_local_lat_size; j++)
+			for (std::size_t m = m_max+1; m < fourier_data_size; m++)
+				rows[j*fourier_data_size + m] = 0;
+
+		// destroys the rows
+		fftw_execute_dft_c2r(fftw_plan_backward, (fftw_complex*)rows, o_physical_data);
+
+		MemBlockAlloc::free(rows, rows_size*sizeof(std::complex<double>));
+		MemBlockAlloc::free(columns, columns_size*sizeof(std::complex<double>));
+	}
+
+
+
+private:
+	/**
+	 * Legendre transformation of the Fourier coefficients of mode m
+	 * along all latitudes to the modes (m,m) ... (n_max,m)
+	 *
+	 * The latitudes are symmetric to the equator, hence the functions
+	 * are only evaluated for the northern latitudes with
+	 * y_nm(-mu) = (-1)^(n-m) y_nm(mu).
+	 */
+	void p_legendre_analysis(
+			int m,
+			const std::complex<double> *i_fourier,	///< Fourier coefficients of all latitudes
+			std::complex<double> *o_modes			///< modes (m,m) ... (n_max,m)
+	)	const
+	{
+		int num_lat = physical_num_lat;
+		int num_modes = spectral_modes_n_max-m+1;
+
+		const double *a = &legendre_a[getLocalArrayIndexByModes(m, m)];
+		const double *b = &legendre_b[getLocalArrayIndexByModes(m, m)];
+
+		for (int k = 0; k < num_modes; k++)
+			o_modes[k] = 0;
+
+		// normalization of the FFT and integration along the longitudes
+		double scale = 2.0*M_PI/(double)physical_num_lon;
+
+		for (int j = 0; j < (num_lat+1)/2; j++)
+		{
+			int js = num_lat-1-j;
+			double mu = lat_gaussian[j];
+			double w = gauss_weights[j]*scale;
+
+			// Sum and difference of the northern and southern latitude
+			std::complex<double> fs, fd;
+			if (j == js)
+			{
+				fs = w*i_fourier[j];
+				fd = fs;
+			}
+			else
+			{
+				fs = w*(i_fourier[j] + i_fourier[js]);
+				fd = w*(i_fourier[j] - i_fourier[js]);
+			}
+
+			double y0 = a[0]*std::pow(lat_cogaussian[j], m);
+			o_modes[0] += y0*fs;
+
+			if (num_modes == 1)
+				continue;
+
+			double y1 = a[1]*mu*y0;
+			o_modes[1] += y1*fd;
+
+			for (int k = 2; k < num_modes; k++)
+			{
+				double y2 = a[k]*(mu*y1 - b[k]*y0);
+				o_modes[k] += y2*((k & 1) ? fd : fs);
+				y0 = y1;
+				y1 = y2;
+			}
+		}
+	}
+
+
+
+	/**
+	 * Legendre transformation of the modes (m,m) ... (n_max,m)
+	 * to the Fourier coefficients of mode m along all latitudes
+	 */
+	void p_legendre_synthesis(
+			int m,
+			const std::complex<double> *i_modes,	///< modes (m,m) ... (n_max,m)
+			std::complex<double> *o_fourier			///< Fourier coefficients of all latitudes
+	)	const
+	{
+		int num_lat = physical_num_lat;
+		int num_modes = spectral_modes_n_max-m+1;
+
+		const double *a = &legendre_a[getLocalArrayIndexByModes(m, m)];
+		const double *b = &legendre_b[getLocalArrayIndexByModes(m, m)];
+
+		for (int j = 0; j < (num_lat+1)/2; j++)
+		{
+			int js = num_lat-1-j;
+			double mu = lat_gaussian[j];
+
+			// Contributions of the modes which are symmetric and antisymmetric to the equator
+			std::complex<double> fs = 0, fd = 0;
+
+			double y0 = a[0]*std::pow(lat_cogaussian[j], m);
+			fs += y0*i_modes[0];
+
+			if (num_modes > 1)
+			{
+				double y1 = a[1]*mu*y0;
+				fd += y1*i_modes[1];
+
+				for (int k = 2; k < num_modes; k++)
+				{
+					double y2 = a[k]*(mu*y1 - b[k]*y0);
+
+					if (k & 1)
+						fd += y2*i_modes[k];
+					else
+						fs += y2*i_modes[k];
+
+					y0 = y1;
+					y1 = y2;
+				}
+			}
+
+			o_fourier[j] = fs + fd;
+			o_fourier[js] = fs - fd;
+		}
+	}
+
+
+
+	/**
+	 * Gaussian latitudes and weights with Newton iterations
+	 * for the roots of the Legendre polynomial of degree num_lat
+	 */
+	void p_setup_gaussian_grid()
+	{
+		int n = physical_num_lat;
+
+		lat.resize(n);
+		lat_gaussian.resize(n);
+		lat_cogaussian.resize(n);
+		gauss_weights.resize(n);
+
+		for (int j = 0; j < (n+1)/2; j++)
+		{
+			// Initial guess of the j-th root from the north pole
+			double x = std::cos(M_PI*((double)j+0.75)/((double)n+0.5));
+			double dp = 0;
+
+			for (int iter = 0; iter < 100; iter++)
+			{
+				double p0 = 1;
+				double p1 = x;
+				for (int k = 2; k <= n; k++)
+				{
+					double p2 = ((2.0*k-1.0)*x*p1 - (k-1.0)*p0)/(double)k;
+					p0 = p1;
+					p1 = p2;
+				}
+
+				dp = (double)n*(x*p1 - p0)/(x*x - 1.0);
+
+				double dx = p1/dp;
+				x -= dx;
+
+				if (std::abs(dx) <= 1e-15)
+					break;
+			}
+
+			if (2*j+1 == n)
+				x = 0;
+
+			double w = 2.0/((1.0 - x*x)*dp*dp);
+
+			lat_gaussian[j] = x;
+			lat_gaussian[n-1-j] = -x;
+			gauss_weights[j] = w;
+			gauss_weights[n-1-j] = w;
+		}
+
+		for (int j = 0; j < n; j++)
+		{
+			// Same as SphereData_Config
+			lat[j] = M_PI_2 - std::acos(lat_gaussian[j]);
+			lat_cogaussian[j] = std::sqrt((1.0 - lat_gaussian[j])*(1.0 + lat_gaussian[j]));
+		}
+	}
+
+
+
+	/**
+	 * Recurrence coefficients of the orthonormal associated Legendre
+	 * functions for the local modes
+	 */
+	void p_setup_legendre_coefficients()
+	{
+		legendre_a.resize(spectral_local_array_data_number_of_elements);
+		legendre_b.resize(spectral_local_array_data_number_of_elements);
+
+		// y_00 = 1/sqrt(4*pi), y_mm = y_(m-1)(m-1)*sqrt((2m+1)/(2m))*cos(phi)
+		double a_mm = std::sqrt(0.25/M_PI);
+		for (int m = 1; m < spectral_local_m_start; m++)
+			a_mm *= std::sqrt((2.0*m+1.0)/(2.0*m));
+
+		for (int m = spectral_local_m_start; m < spectral_local_m_start + spectral_local_m_size; m++)
+		{
+			if (m > 0)
+				a_mm *= std::sqrt((2.0*m+1.0)/(2.0*m));
+
+			std::size_t idx = getLocalArrayIndexByModes(m, m);
+
+			legendre_a[idx] = a_mm;
+			legendre_b[idx] = 0;
+
+			if (m == spectral_modes_n_max)
+				continue;
+
+			legendre_a[idx+1] = std::sqrt(2.0*m+3.0);
+			legendre_b[idx+1] = 0;
+
+			for (int n = m+2; n <= spectral_modes_n_max; n++)
+			{
+				double nn = (double)n*(double)n;
+				double n1 = (double)(n-1)*(double)(n-1);
+				double mm = (double)m*(double)m;
+
+				legendre_a[idx+n-m] = std::sqrt((4.0*nn-1.0)/(nn-mm));
+				legendre_b[idx+n-m] = std::sqrt((n1-mm)/(4.0*n1-1.0));
+			}
+		}
+	}
+
+
+
+	/**
+	 * Smallest size >= i_min_size with only the prime factors 2, 3 and 5
+	 */
+	static
+	int p_fft_size(
+			int i_min_size
+	)
+	{
+		for (int n = std::max(i_min_size, 1); ; n++)
+		{
+			int r = n;
+			while (r % 2 == 0)	r /= 2;
+			while (r % 3 == 0)	r /= 3;
+			while (r % 5 == 0)	r /= 5;
+
+			if (r == 1)
+				return n;
+		}
+	}
+
+
+
+	/**
+	 * Setup FFTs along the local latitudes
+	 *
+	 * Like SHTNS, the forward FFT isn't normalized (the normalization is
+	 * part of the Legendre transformation) and the backward FFT isn't scaled.
+	 */
+	void p_setup_plans(
+			int i_reuse_spectral_transformation_plans
+	)
+	{
+#if SWEET_THREADING_SPACE && !SWEET_THREADING_TIME_REXI
+		static bool fftw_threads_initialized = false;
+
+		if (!fftw_threads_initialized)
+		{
+			if (fftw_init_threads() == 0)
+				FatalError("fftw_init_threads() failed");
+
+			fftw_threads_initialized = true;
+		}
+
+		fftw_plan_with_nthreads(omp_get_max_threads());
+#endif
+
+		unsigned int flags = FFTW_MEASURE;
+		if (i_reuse_spectral_transformation_plans == -1)
+			flags = FFTW_ESTIMATE;
+
+		int num_lon = physical_num_lon;
+		std::size_t rows_size = physical_local_lat_size*fourier_data_size;
+
+		// Plans are created with dummy buffers since measuring overwrites them
+		double *data_physical = MemBlockAlloc::alloc<double>(physical_local_array_data_number_of_elements*sizeof(double));
+		std::complex<double> *data_rows = MemBlockAlloc::alloc< std::complex<double> >(rows_size*sizeof(std::complex<double>));
+
+		int n[1] = {num_lon};
+
+		fftw_plan_forward = fftw_plan_many_dft_r2c(
+				1, n, physical_local_lat_size,
+				data_physical, nullptr, 1, num_lon,
+				(fftw_complex*)data_rows, nullptr, 1, fourier_data_size,
+				flags | FFTW_PRESERVE_INPUT
+			);
+
+		fftw_plan_backward = fftw_plan_many_dft_c2r(
+				1, n, physical_local_lat_size,
+				(fftw_complex*)data_rows, nullptr, 1, fourier_data_size,
+				data_physical, nullptr, 1, num_lon,
+				flags
+			);
+
+		if (fftw_plan_forward == nullptr || fftw_plan_backward == nullptr)
+			FatalError("SphereData_ConfigDistributed: Failed to create FFTW plans");
+
+		MemBlockAlloc::free(data_physical, physical_local_array_data_number_of_elements*sizeof(double));
+		MemBlockAlloc::free(data_rows, rows_size*sizeof(std::complex<double>));
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_SPHERE_SPHEREDATA_CONFIGDISTRIBUTED_HPP_ */
@@ -0,0 +1,246 @@
+/*
+ * SphereData_DerivedCache.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SPHERE_SPHEREDATA_DERIVEDCACHE_HPP_
+#define SRC_INCLUDE_SWEET_SPHERE_SPHEREDATA_DERIVEDCACHE_HPP_
+
+#include <list>
+#include <map>
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <iostream>
+#include <sweet/openmp_helper.hpp>
+#include <sweet/sphere/SphereData_Config.hpp>
+#include <sweet/sphere/SphereData_Physical.hpp>
+
+
+
+/**
+ * Cache of physical fields which are derived from spectral data
+ * (e.g. the physical representation of a field or the velocities
+ * computed from vorticity/divergence).
+ *
+ * Each SphereData_Spectral carries a version which is unique over
+ * the whole program run and which is updated whenever the data is
+ * modified by one of its member functions. Results are cached for
+ * the versions of their input data.
+ *
+ * Code writing directly to spectral_space_data of an existing field
+ * which might have been transformed before must call
+ * spectral_data_modified(). With SWEET_DEBUG enabled, each cache hit
+ * is validated against a recomputation.
+ *
+ * The cache is deactivated by default (max. size of 0).
+ * The hit/miss counters are intended to find redundant transformations.
+ */
+class SphereData_DerivedCache
+{
+public:
+	enum Operation
+	{
+		OP_SPECTRAL_TO_PHYSICAL = 0,
+		OP_ROBERT_VORTDIV_TO_UV = 1,
+		OP_VORTDIV_TO_UV = 2,
+
+		OP_NUM = 3
+	};
+
+private:
+	struct Entry
+	{
+		int operation;
+		std::uint64_t version0;
+		std::uint64_t version1;
+
+		SphereData_Physical out0;
+		SphereData_Physical out1;
+	};
+
+	/// LRU list of entries for each configuration
+	std::map<const SphereData_Config*, std::list<Entry> > entries;
+
+	std::size_t max_size_per_config;
+
+	std::size_t hits[OP_NUM];
+	std::size_t misses[OP_NUM];
+
+	/// Last version which was handed out
+	std::atomic<std::uint64_t> version_counter;
+
+
+private:
+	SphereData_DerivedCache()	:
+		max_size_per_config(0),
+		version_counter(0)
+	{
+		for (int i = 0; i < OP_NUM; i++)
+		{
+			hits[i] = 0;
+			misses[i] = 0;
+		}
+	}
+
+
+public:
+	static SphereData_DerivedCache& getInstance()
+	{
+		static SphereData_DerivedCache cache;
+		return cache;
+	}
+
+
+	/**
+	 * Return a new unique version for modified data
+	 */
+	std::uint64_t getNewVersion()
+	{
+		return ++version_counter;
+	}
+
+
+	/**
+	 * Set max. number of cached results per configuration (0 deactivates caching)
+	 */
+	void setup(
+			std::size_t i_max_size_per_config
+	)
+	{
+		max_size_per_config = i_max_size_per_config;
+
+		if (max_size_per_config == 0)
+			entries.clear();
+	}
+
+
+	/**
+	 * The cache is only used outside of parallel regions since the
+	 * buffers of SphereData_Physical are allocated per thread.
+	 */
+	bool isActive()	const
+	{
+		if (max_size_per_config == 0)
+			return false;
+
+#if SWEET_THREADING_SPACE || SWEET_THREADING_TIME_REXI
+		if (omp_in_parallel())
+			return false;
+#endif
+		return true;
+	}
+
+
+	/**
+	 * Search for cached results and copy them to the output fields
+	 *
+	 * \return true if results were found
+	 */
+	bool lookup(
+			const SphereData_Config *i_sphereDataConfig,
+			int i_operation,
+			std::uint64_t i_version0,
+			std::uint64_t i_version1,
+			SphereData_Physical &o_out0,
+			SphereData_Physical *o_out1 = nullptr
+	)
+	{
+		std::list<Entry> &list = entries[i_sphereDataConfig];
+
+		for (auto iter = list.begin(); iter != list.end(); iter++)
+		{
+			if (iter->operation != i_operation || iter->version0 != i_version0 || iter->version1 != i_version1)
+				continue;
+
+			hits[i_operation]++;
+
+			o_out0 = iter->out0;
+			if (o_out1 != nullptr)
+				*o_out1 = iter->out1;
+
+			// Move to front
+			list.splice(list.begin(), list, iter);
+			return true;
+		}
+
+		misses[i_operation]++;
+		return false;
+	}
+
+
+	/**
+	 * Store results
+	 */
+	void insert(
+			const SphereData_Config *i_sphereDataConfig,
+			int i_operation,
+			std::uint64_t i_version0,
+			std::uint64_t i_version1,
+			const SphereData_Physical &i_out0,
+			const SphereData_Physical *i_out1 = nullptr
+	)
+	{
+		std::list<Entry> &list = entries[i_sphereDataConfig];
+
+		// Construct in place since empty SphereData_Physical can't be copied
+		list.emplace_front();
+
+		Entry &entry = list.front();
+		entry.operation = i_operation;
+		entry.version0 = i_version0;
+		entry.version1 = i_version1;
+		entry.out0 = i_out0;
+		if (i_out1 != nullptr)
+			entry.out1 = *i_out1;
+
+		while (list.size() > max_size_per_config)
+			list.pop_back();
+	}
+
+
+	/**
+	 * Validate results from the cache (only used with SWEET_DEBUG)
+	 */
+	static void validate(
+			const SphereData_Physical &i_cached,
+			const SphereData_Physical &i_computed
+	)
+	{
+		if ((i_cached-i_computed).physical_reduce_max_abs() != 0)
+			FatalError("SphereData_DerivedCache: Stale cache entry (missing spectral_data_modified() after writing to spectral data?)");
+	}
+
+
+	void clear()
+	{
+		entries.clear();
+	}
+
+
+	void output(
+			const std::string &i_prefix = "derived_transform_cache"
+	)	const
+	{
+		static const char *op_names[OP_NUM] = {
+				"spectral_to_physical",
+				"robert_vortdiv_to_uv",
+				"vortdiv_to_uv"
+		};
+
+		for (int i = 0; i < OP_NUM; i++)
+		{
+			if (hits[i] == 0 && misses[i] == 0)
+				continue;
+
+			std::cout << "[MULE] " << i_prefix << "." << op_names[i] << ".hits: " << hits[i] << std::endl;
+			std::cout << "[MULE] " << i_prefix << "." << op_names[i] << ".misses: " << misses[i] << std::endl;
+		}
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_SPHERE_SPHEREDATA_DERIVEDCACHE_HPP_ */
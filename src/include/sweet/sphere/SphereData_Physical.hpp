@@ -383,8 +383,9 @@ public:
 	 *
 	 * lambda function parameters: (longitude \in [0;2*pi], Gaussian latitude \in [-M_PI/2;M_PI/2])
 	 */
+	template <typename T_Lambda>
 	void physical_update_lambda(
-			std::function<void(double,double,double&)> i_lambda	///< lambda function to return value for lat/mu
+			T_Lambda i_lambda	///< lambda function to return value for lat/mu
 	)
 	{
 		SWEET_THREADING_SPACE_PARALLEL_FOR
@@ -438,8 +439,9 @@ public:
 	}
 
 
+	template <typename T_Lambda>
 	void physical_update_lambda_array(
-			std::function<void(int,int,double&)> i_lambda	///< lambda function to return value for lat/mu
+			T_Lambda i_lambda	///< lambda function to return value for lat/mu
 	)
 	{
 
@@ -474,8 +476,9 @@ public:
 	 *
 	 * lambda function parameters: (longitude \in [0;2*pi], Gaussian latitude sin(phi) \in [-1;1])
 	 */
+	template <typename T_Lambda>
 	void physical_update_lambda_gaussian_grid(
-			std::function<void(double,double,double&)> i_lambda	///< lambda function to return value for lat/mu
+			T_Lambda i_lambda	///< lambda function to return value for lat/mu
 	)
 	{
 		SWEET_THREADING_SPACE_PARALLEL_FOR
@@ -518,8 +521,9 @@ public:
 	 * lambda function parameters:
 	 *   (longitude \in [0;2*pi], Cogaussian latitude cos(phi) \in [0;1])
 	 */
+	template <typename T_Lambda>
 	void physical_update_lambda_cogaussian_grid(
-			std::function<void(double,double,double&)> i_lambda	///< lambda function to return value for lat/mu
+			T_Lambda i_lambda	///< lambda function to return value for lat/mu
 	)
 	{
 
@@ -567,15 +571,17 @@ public:
 	}
 
 
+	template <typename T_Lambda>
 	void physical_update_lambda_sinphi_grid(
-			std::function<void(double,double,double&)> i_lambda	///< lambda function to return value for lat/mu
+			T_Lambda i_lambda	///< lambda function to return value for lat/mu
 	)
 	{
 		physical_update_lambda_gaussian_grid(i_lambda);
 	}
 
+	template <typename T_Lambda>
 	void physical_update_lambda_cosphi_grid(
-			std::function<void(double,double,double&)> i_lambda	///< lambda function to return value for lat/mu
+			T_Lambda i_lambda	///< lambda function to return value for lat/mu
 	)
 	{
 		physical_update_lambda_cogaussian_grid(i_lambda);
@@ -886,52 +892,7 @@ public:
 			int i_precision = 20
 	)	const
 	{
-		std::ofstream file(i_filename, std::ios_base::trunc);
-
-		if (i_precision >= 0)
-			file << std::setprecision(i_precision);
-
-		file << "#TI " << i_title << std::endl;
-		file << "#TX Longitude" << std::endl;
-		file << "#TY Latitude" << std::endl;
-
-		//file << "lat\\lon\t";
-		// Use 0 to make it processable by python
-		file << "0\t";
-
-		for (int i = 0; i < sphereDataConfig->physical_num_lon; i++)
-		{
-//			double lon_degree = ((double)i/(double)sphereDataConfig->spat_num_lon)*2.0*M_PI;
-			double lon_degree = ((double)i/(double)sphereDataConfig->physical_num_lon)*2.0*M_PI;
-			lon_degree = lon_degree/M_PI*180.0;
-
-			file << lon_degree;
-			if (i < sphereDataConfig->physical_num_lon-1)
-				file << "\t";
-		}
-		file << std::endl;
-
-        for (int j = sphereDataConfig->physical_num_lat-1; j >= 0; j--)
-        {
-//        		double lat_degree =  M_PI*0.5 - acos(shtns->ct[j]);
-        		double lat_degree = sphereDataConfig->lat[j];
-        		lat_degree = lat_degree/M_PI*180.0;
-
-        		file << lat_degree << "\t";
-
-        		for (int i = 0; i < sphereDataConfig->physical_num_lon; i++)
-        		{
-#if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
-        			file << physical_space_data[i*sphereDataConfig->physical_num_lat+j];
-#else
-        			file << physical_space_data[j*sphereDataConfig->physical_num_lon+i];
-#endif
-        			if (i < sphereDataConfig->physical_num_lon-1)
-        				file << "\t";
-        		}
-        		file << std::endl;
-        }
-        file.close();
+		physical_file_write_data(sphereDataConfig, physical_space_data, i_filename, i_title, i_precision, false);
 	}
 
 
@@ -941,10 +902,33 @@ public:
 			std::string i_title = "",
 			int i_precision = 20
 	)	const
+	{
+		physical_file_write_data(sphereDataConfig, physical_space_data, i_filename, i_title.c_str(), i_precision, true);
+	}
+
+
+
+	/**
+	 * Write physical data given by a raw array to an ASCII file.
+	 *
+	 * This doesn't require any SphereData_Physical and can be also
+	 * used with snapshots of the data (e.g. for background output).
+	 */
+	static
+	void physical_file_write_data(
+			const SphereData_Config *i_sphereDataConfig,
+			const double *i_physical_space_data,
+			const std::string &i_filename,
+			const char *i_title = "",
+			int i_precision = 20,
+			bool i_lon_pi_shifted = false
+	)
 	{
 		std::ofstream file(i_filename, std::ios_base::trunc);
 
-		file << std::setprecision(i_precision);
+		if (i_precision >= 0)
+			file << std::setprecision(i_precision);
+
 		file << "#TI " << i_title << std::endl;
 		file << "#TX Longitude" << std::endl;
 		file << "#TY Latitude" << std::endl;
@@ -953,38 +937,47 @@ public:
 		// Use 0 to make it processable by python
 		file << "0\t";
 
-		for (int i = 0; i < sphereDataConfig->physical_num_lon; i++)
+		for (int i = 0; i < i_sphereDataConfig->physical_num_lon; i++)
 		{
 //			double lon_degree = ((double)i/(double)sphereDataConfig->spat_num_lon)*2.0*M_PI;
-			double lon_degree = ((double)i/(double)sphereDataConfig->physical_num_lon)*2.0*M_PI;
-			lon_degree = (lon_degree-M_PI)/M_PI*180.0;
+			double lon_degree = ((double)i/(double)i_sphereDataConfig->physical_num_lon)*2.0*M_PI;
+
+			if (i_lon_pi_shifted)
+				lon_degree = (lon_degree-M_PI)/M_PI*180.0;
+			else
+				lon_degree = lon_degree/M_PI*180.0;
 
 			file << lon_degree;
-			if (i < sphereDataConfig->physical_num_lon-1)
+			if (i < i_sphereDataConfig->physical_num_lon-1)
 				file << "\t";
 		}
 		file << std::endl;
 
-        for (int j = sphereDataConfig->physical_num_lat-1; j >= 0; j--)
+        for (int j = i_sphereDataConfig->physical_num_lat-1; j >= 0; j--)
         {
 //        		double lat_degree =  M_PI*0.5 - acos(shtns->ct[j]);
-        		double lat_degree = sphereDataConfig->lat[j];
+        		double lat_degree = i_sphereDataConfig->lat[j];
         		lat_degree = lat_degree/M_PI*180.0;
 
         		file << lat_degree << "\t";
 
-        		for (int i = 0; i < sphereDataConfig->physical_num_lon; i++)
+        		for (int i = 0; i < i_sphereDataConfig->physical_num_lon; i++)
         		{
-        			int ia = i+sphereDataConfig->physical_num_lon/2;
-        			if (ia >= sphereDataConfig->physical_num_lon)
-        				ia -= sphereDataConfig->physical_num_lon;
+        			int ia = i;
+
+        			if (i_lon_pi_shifted)
+        			{
+        				ia += i_sphereDataConfig->physical_num_lon/2;
+        				if (ia >= i_sphereDataConfig->physical_num_lon)
+        					ia -= i_sphereDataConfig->physical_num_lon;
+        			}
 
 #if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
-        			file << physical_space_data[ia*sphereDataConfig->physical_num_lat+j];
+        			file << i_physical_space_data[ia*i_sphereDataConfig->physical_num_lat+j];
 #else
-        			file << physical_space_data[j*sphereDataConfig->physical_num_lon+ia];
+        			file << i_physical_space_data[j*i_sphereDataConfig->physical_num_lon+ia];
 #endif
-        			if (i < sphereDataConfig->physical_num_lon-1)
+        			if (i < i_sphereDataConfig->physical_num_lon-1)
         				file << "\t";
         		}
         		file << std::endl;
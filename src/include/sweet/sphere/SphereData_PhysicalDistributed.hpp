@@ -0,0 +1,422 @@
+/*
+ * SphereData_PhysicalDistributed.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SPHERE_SPHEREDATA_PHYSICALDISTRIBUTED_HPP_
+#define SRC_INCLUDE_SWEET_SPHERE_SPHEREDATA_PHYSICALDISTRIBUTED_HPP_
+
+#include <cmath>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <fstream>
+#include <iomanip>
+#include <sweet/MemBlockAlloc.hpp>
+#include <sweet/FatalError.hpp>
+#include <sweet/openmp_helper.hpp>
+#include <sweet/sphere/SphereData_ConfigDistributed.hpp>
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
+
+
+
+/**
+ * Physical sphere data of the local latitudes (see SphereData_ConfigDistributed)
+ */
+class SphereData_PhysicalDistributed
+{
+public:
+	const SphereData_ConfigDistributed *sphereDataConfig;
+
+	/// layout [lat-lat_start][lon]
+	double *physical_space_data;
+
+
+private:
+	void p_allocate_buffers()
+	{
+		physical_space_data = MemBlockAlloc::alloc<double>(
+				sphereDataConfig->physical_local_array_data_number_of_elements*sizeof(double)
+			);
+	}
+
+
+public:
+	SphereData_PhysicalDistributed(
+			const SphereData_ConfigDistributed *i_sphereDataConfig
+	)	:
+		sphereDataConfig(i_sphereDataConfig),
+		physical_space_data(nullptr)
+	{
+		assert(sphereDataConfig != nullptr);
+		p_allocate_buffers();
+	}
+
+
+	SphereData_PhysicalDistributed(
+			const SphereData_PhysicalDistributed &i_data
+	)	:
+		sphereDataConfig(i_data.sphereDataConfig),
+		physical_space_data(nullptr)
+	{
+		p_allocate_buffers();
+		std::copy(i_data.physical_space_data, i_data.physical_space_data + sphereDataConfig->physical_local_array_data_number_of_elements, physical_space_data);
+	}
+
+
+	SphereData_PhysicalDistributed(
+			SphereData_PhysicalDistributed &&i_data
+	)	:
+		sphereDataConfig(i_data.sphereDataConfig),
+		physical_space_data(i_data.physical_space_data)
+	{
+		i_data.physical_space_data = nullptr;
+	}
+
+
+	~SphereData_PhysicalDistributed()
+	{
+		if (physical_space_data != nullptr)
+			MemBlockAlloc::free(physical_space_data, sphereDataConfig->physical_local_array_data_number_of_elements*sizeof(double));
+	}
+
+
+	SphereData_PhysicalDistributed& operator=(
+			const SphereData_PhysicalDistributed &i_data
+	)
+	{
+		if (sphereDataConfig != i_data.sphereDataConfig)
+			FatalError("SphereData_PhysicalDistributed: Assignment between different configurations not supported");
+
+		if (this != &i_data)
+			std::copy(i_data.physical_space_data, i_data.physical_space_data + sphereDataConfig->physical_local_array_data_number_of_elements, physical_space_data);
+
+		return *this;
+	}
+
+
+	SphereData_PhysicalDistributed& operator=(
+			SphereData_PhysicalDistributed &&i_data
+	)
+	{
+		if (sphereDataConfig != i_data.sphereDataConfig)
+			FatalError("SphereData_PhysicalDistributed: Assignment between different configurations not supported");
+
+		std::swap(physical_space_data, i_data.physical_space_data);
+		return *this;
+	}
+
+
+
+	void physical_set_zero()
+	{
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->physical_local_array_data_number_of_elements; i++)
+			physical_space_data[i] = 0;
+	}
+
+
+	/*
+	 * Set values for all local latitudes and all longitudes
+	 *
+	 * lambda function parameters: (longitude \in [0;2*pi], Gaussian latitude \in [-M_PI/2;M_PI/2])
+	 */
+	template <typename T_Lambda>
+	void physical_update_lambda(
+			T_Lambda i_lambda
+	)
+	{
+		int num_lon = sphereDataConfig->physical_num_lon;
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (int j = 0; j < sphereDataConfig->physical_local_lat_size; j++)
+		{
+			double lat_degree = sphereDataConfig->lat[sphereDataConfig->physical_local_lat_start + j];
+
+			for (int i = 0; i < num_lon; i++)
+			{
+				double lon_degree = ((double)i/(double)num_lon)*2.0*M_PI;
+
+				i_lambda(lon_degree, lat_degree, physical_space_data[j*num_lon + i]);
+			}
+		}
+	}
+
+
+
+	/*
+	 * Set values for all local latitudes and all longitudes
+	 *
+	 * lambda function parameters: (longitude \in [0;2*pi], mu = sin(latitude) \in [-1;1])
+	 */
+	template <typename T_Lambda>
+	void physical_update_lambda_gaussian_grid(
+			T_Lambda i_lambda
+	)
+	{
+		int num_lon = sphereDataConfig->physical_num_lon;
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (int j = 0; j < sphereDataConfig->physical_local_lat_size; j++)
+		{
+			double sin_phi = sphereDataConfig->lat_gaussian[sphereDataConfig->physical_local_lat_start + j];
+
+			for (int i = 0; i < num_lon; i++)
+			{
+				double lon_degree = ((double)i/(double)num_lon)*2.0*M_PI;
+
+				i_lambda(lon_degree, sin_phi, physical_space_data[j*num_lon + i]);
+			}
+		}
+	}
+
+
+
+	void physical_set_all_value(
+			double i_value
+	)
+	{
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->physical_local_array_data_number_of_elements; i++)
+			physical_space_data[i] = i_value;
+	}
+
+
+
+	SphereData_PhysicalDistributed operator+(
+			const SphereData_PhysicalDistributed &i_data
+	)	const
+	{
+		SphereData_PhysicalDistributed out(sphereDataConfig);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->physical_local_array_data_number_of_elements; i++)
+			out.physical_space_data[i] = physical_space_data[i] + i_data.physical_space_data[i];
+
+		return out;
+	}
+
+
+	SphereData_PhysicalDistributed operator-(
+			const SphereData_PhysicalDistributed &i_data
+	)	const
+	{
+		SphereData_PhysicalDistributed out(sphereDataConfig);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->physical_local_array_data_number_of_elements; i++)
+			out.physical_space_data[i] = physical_space_data[i] - i_data.physical_space_data[i];
+
+		return out;
+	}
+
+
+	SphereData_PhysicalDistributed operator*(
+			const SphereData_PhysicalDistributed &i_data
+	)	const
+	{
+		SphereData_PhysicalDistributed out(sphereDataConfig);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->physical_local_array_data_number_of_elements; i++)
+			out.physical_space_data[i] = physical_space_data[i]*i_data.physical_space_data[i];
+
+		return out;
+	}
+
+
+	SphereData_PhysicalDistributed operator*(
+			double i_value
+	)	const
+	{
+		SphereData_PhysicalDistributed out(sphereDataConfig);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->physical_local_array_data_number_of_elements; i++)
+			out.physical_space_data[i] = physical_space_data[i]*i_value;
+
+		return out;
+	}
+
+
+	SphereData_PhysicalDistributed operator-(
+			double i_value
+	)	const
+	{
+		SphereData_PhysicalDistributed out(sphereDataConfig);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->physical_local_array_data_number_of_elements; i++)
+			out.physical_space_data[i] = physical_space_data[i] - i_value;
+
+		return out;
+	}
+
+
+	SphereData_PhysicalDistributed& operator+=(
+			const SphereData_PhysicalDistributed &i_data
+	)
+	{
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->physical_local_array_data_number_of_elements; i++)
+			physical_space_data[i] += i_data.physical_space_data[i];
+
+		return *this;
+	}
+
+
+
+	/**
+	 * Return the max. absolute value over all ranks
+	 *
+	 * Collective operation with MPI
+	 */
+	double physical_reduce_max_abs()	const
+	{
+		double maxabs = 0;
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for PROC_BIND_CLOSE reduction(max:maxabs)
+#endif
+		for (int i = 0; i < sphereDataConfig->physical_local_array_data_number_of_elements; i++)
+			maxabs = std::max(maxabs, std::abs(physical_space_data[i]));
+
+#if SWEET_MPI
+		MPI_Allreduce(MPI_IN_PLACE, &maxabs, 1, MPI_DOUBLE, MPI_MAX, sphereDataConfig->mpi_comm);
+#endif
+
+		return maxabs;
+	}
+
+
+
+	/**
+	 * Return the minimum value over all ranks
+	 *
+	 * Collective operation with MPI
+	 */
+	double physical_reduce_min()	const
+	{
+		double minvalue = std::numeric_limits<double>::infinity();
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for PROC_BIND_CLOSE reduction(min:minvalue)
+#endif
+		for (int i = 0; i < sphereDataConfig->physical_local_array_data_number_of_elements; i++)
+			minvalue = std::min(minvalue, physical_space_data[i]);
+
+#if SWEET_MPI
+		MPI_Allreduce(MPI_IN_PLACE, &minvalue, 1, MPI_DOUBLE, MPI_MIN, sphereDataConfig->mpi_comm);
+#endif
+
+		return minvalue;
+	}
+
+
+
+	/**
+	 * Return the maximum value over all ranks
+	 *
+	 * Collective operation with MPI
+	 */
+	double physical_reduce_max()	const
+	{
+		double maxvalue = -std::numeric_limits<double>::infinity();
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for PROC_BIND_CLOSE reduction(max:maxvalue)
+#endif
+		for (int i = 0; i < sphereDataConfig->physical_local_array_data_number_of_elements; i++)
+			maxvalue = std::max(maxvalue, physical_space_data[i]);
+
+#if SWEET_MPI
+		MPI_Allreduce(MPI_IN_PLACE, &maxvalue, 1, MPI_DOUBLE, MPI_MAX, sphereDataConfig->mpi_comm);
+#endif
+
+		return maxvalue;
+	}
+
+
+
+	/**
+	 * Collective output of all latitudes to an ASCII file
+	 * in the same format as SphereData_Physical::physical_file_write_data().
+	 *
+	 * The latitudes are written from south to north, hence the ranks
+	 * append their local latitudes one after another starting with the
+	 * last rank. The data is never gathered on a single rank.
+	 */
+	void physical_file_write(
+			const std::string &i_filename,
+			const char *i_title = "",
+			int i_precision = 20
+	)	const
+	{
+		int num_lon = sphereDataConfig->physical_num_lon;
+
+		for (int r = sphereDataConfig->mpi_size-1; r >= 0; r--)
+		{
+			if (r == sphereDataConfig->mpi_rank)
+			{
+				bool first = (r == sphereDataConfig->mpi_size-1);
+
+				std::ofstream file(i_filename, first ? std::ios_base::trunc : std::ios_base::app);
+
+				if (i_precision >= 0)
+					file << std::setprecision(i_precision);
+
+				if (first)
+				{
+					file << "#TI " << i_title << std::endl;
+					file << "#TX Longitude" << std::endl;
+					file << "#TY Latitude" << std::endl;
+
+					// Use 0 to make it processable by python
+					file << "0\t";
+
+					for (int i = 0; i < num_lon; i++)
+					{
+						double lon_degree = ((double)i/(double)num_lon)*2.0*M_PI;
+						lon_degree = lon_degree/M_PI*180.0;
+
+						file << lon_degree;
+						if (i < num_lon-1)
+							file << "\t";
+					}
+					file << std::endl;
+				}
+
+				for (int j = sphereDataConfig->physical_local_lat_size-1; j >= 0; j--)
+				{
+					double lat_degree = sphereDataConfig->lat[sphereDataConfig->physical_local_lat_start + j];
+					lat_degree = lat_degree/M_PI*180.0;
+
+					file << lat_degree << "\t";
+
+					for (int i = 0; i < num_lon; i++)
+					{
+						file << physical_space_data[j*num_lon + i];
+						if (i < num_lon-1)
+							file << "\t";
+					}
+					file << std::endl;
+				}
+			}
+
+#if SWEET_MPI
+			MPI_Barrier(sphereDataConfig->mpi_comm);
+#endif
+		}
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_SPHERE_SPHEREDATA_PHYSICALDISTRIBUTED_HPP_ */
@@ -11,6 +11,7 @@
 #include <complex>
 #include <functional>
 #include <array>
+#include <vector>
 #include <cstring>
 #include <iostream>
 #include <fstream>
@@ -18,6 +19,7 @@
 #include <cassert>
 #include <limits>
 #include <utility>
+#include <algorithm>
 #include <functional>
 #include <cmath>
 
@@ -26,9 +28,13 @@
 #include <sweet/MemBlockAlloc.hpp>
 #include <sweet/FatalError.hpp>
 #include <sweet/openmp_helper.hpp>
+#include <sweet/SWEETCheckpoint.hpp>
 #include <sweet/sphere/SphereData_Config.hpp>
 #include <sweet/sphere/SphereData_Physical.hpp>
 #include <sweet/sphere/SphereData_PhysicalComplex.hpp>
+#include <sweet/sphere/SphereData_DerivedCache.hpp>
+#include <sweet/SimulationProfiler.hpp>
+#include <sweet/KernelCounters.hpp>
 
 
 
@@ -42,13 +48,45 @@ public:
 public:
 	std::complex<double> *spectral_space_data = nullptr;
 
+	/// spectral_space_data is not owned by this class (see setup_view())
+	bool spectral_space_data_is_view = false;
+
+	/// unique version of the data (see SphereData_DerivedCache)
+	mutable std::uint64_t version = 0;
+
+	/**
+	 * Update the version of the data.
+	 *
+	 * This must be called after writing directly to spectral_space_data
+	 * of an existing field which might have been transformed before.
+	 */
+	void spectral_data_modified()	const
+	{
+		version = SphereData_DerivedCache::getInstance().getNewVersion();
+	}
+
 	void swap(
 			SphereData_Spectral &i_sphereData
 	)
 	{
 		assert(sphereDataConfig == i_sphereData.sphereDataConfig);
 
-		std::swap(spectral_space_data, i_sphereData.spectral_space_data);
+		if (spectral_space_data_is_view || i_sphereData.spectral_space_data_is_view)
+		{
+			// Views have to stay attached to their buffers
+			std::swap_ranges(
+					spectral_space_data,
+					spectral_space_data + sphereDataConfig->spectral_array_data_number_of_elements,
+					i_sphereData.spectral_space_data
+				);
+		}
+		else
+		{
+			std::swap(spectral_space_data, i_sphereData.spectral_space_data);
+		}
+
+		spectral_data_modified();
+		i_sphereData.spectral_data_modified();
 	}
 
 
@@ -102,7 +140,15 @@ public:
 	{
 		setup(i_sph_data.sphereDataConfig);
 
-		std::swap(spectral_space_data, i_sph_data.spectral_space_data);
+		if (i_sph_data.spectral_space_data_is_view)
+		{
+			operator=(i_sph_data);
+		}
+		else
+		{
+			std::swap(spectral_space_data, i_sph_data.spectral_space_data);
+			i_sph_data.spectral_data_modified();
+		}
 	}
 
 
@@ -133,6 +179,7 @@ public:
 			setup(i_sph_data.sphereDataConfig);
 
 		parmemcpy(spectral_space_data, i_sph_data.spectral_space_data, sizeof(cplx)*sphereDataConfig->spectral_array_data_number_of_elements);
+		spectral_data_modified();
 
 		return *this;
 	}
@@ -154,6 +201,7 @@ public:
 			FatalError("sphereDataConfig not initialized");
 
 		parmemcpy(spectral_space_data, i_sph_data.spectral_space_data, sizeof(cplx)*sphereDataConfig->spectral_array_data_number_of_elements);
+		spectral_data_modified();
 
 		return *this;
 	}
@@ -167,7 +215,17 @@ public:
 		if (sphereDataConfig == nullptr)
 			setup(i_sph_data.sphereDataConfig);
 
-		std::swap(spectral_space_data, i_sph_data.spectral_space_data);
+		if (spectral_space_data_is_view || i_sph_data.spectral_space_data_is_view)
+		{
+			parmemcpy(spectral_space_data, i_sph_data.spectral_space_data, sizeof(cplx)*sphereDataConfig->spectral_array_data_number_of_elements);
+		}
+		else
+		{
+			std::swap(spectral_space_data, i_sph_data.spectral_space_data);
+			i_sph_data.spectral_data_modified();
+		}
+
+		spectral_data_modified();
 
 		return *this;
 	}
@@ -255,6 +313,36 @@ public:
 
 
 
+#if SWEET_KERNEL_COUNTERS
+private:
+	/*
+	 * Analytical models of a scalar SH transformation for the kernel counters
+	 *
+	 * Legendre transformation: 1 complex multiply-add (4 FLOPs) per mode and latitude
+	 * FFT: 2.5*N*log2(N) FLOPs per latitude
+	 */
+	double p_sht_flops()	const
+	{
+		double num_lat = sphereDataConfig->physical_num_lat;
+		double num_lon = sphereDataConfig->physical_num_lon;
+
+		return 4.0*sphereDataConfig->spectral_array_data_number_of_elements*num_lat
+				+ 2.5*num_lon*std::log2(num_lon)*num_lat;
+	}
+
+	/*
+	 * Spectral coefficients and physical data are loaded/stored once
+	 */
+	double p_sht_bytes()	const
+	{
+		return sizeof(std::complex<double>)*(double)sphereDataConfig->spectral_array_data_number_of_elements
+				+ sizeof(double)*(double)sphereDataConfig->physical_array_data_number_of_elements;
+	}
+
+public:
+#endif
+
+
 	void loadSphereDataPhysical(
 			const SphereData_Physical &i_sphereDataPhysical
 	)
@@ -263,8 +351,15 @@ public:
 		 * Warning: This is an in-situ operation.
 		 * Therefore, the data in the source array will be destroyed.
 		 */
+		SWEET_PROFILER_REGION("sht_forward");
+
 		SphereData_Physical tmp(i_sphereDataPhysical);
-		spat_to_SH(sphereDataConfig->shtns, tmp.physical_space_data, spectral_space_data);
+
+		{
+			SWEET_KERNEL_COUNTER_REGION("sht_forward", p_sht_flops(), p_sht_bytes());
+			spat_to_SH(sphereDataConfig->shtns, tmp.physical_space_data, spectral_space_data);
+		}
+		spectral_data_modified();
 
 //		SphereDataSpectral *this_var = (SphereDataSpectral*)this;
 	}
@@ -276,9 +371,36 @@ public:
 		 * Warning: This is an in-situ operation.
 		 * Therefore, the data in the source array will be destroyed.
 		 */
-		SphereData_Spectral tmp(*this);
+		SphereData_DerivedCache &cache = SphereData_DerivedCache::getInstance();
+		bool use_cache = cache.isActive();
+
 		SphereData_Physical retval(sphereDataConfig);
-		SH_to_spat(sphereDataConfig->shtns, tmp.spectral_space_data, retval.physical_space_data);
+
+		if (use_cache)
+		{
+			if (cache.lookup(sphereDataConfig, SphereData_DerivedCache::OP_SPECTRAL_TO_PHYSICAL, version, 0, retval))
+			{
+#if SWEET_DEBUG
+				SphereData_Spectral tmp(*this);
+				SphereData_Physical computed(sphereDataConfig);
+				SH_to_spat(sphereDataConfig->shtns, tmp.spectral_space_data, computed.physical_space_data);
+				SphereData_DerivedCache::validate(retval, computed);
+#endif
+				return retval;
+			}
+		}
+
+		SWEET_PROFILER_REGION("sht_backward");
+
+		SphereData_Spectral tmp(*this);
+
+		{
+			SWEET_KERNEL_COUNTER_REGION("sht_backward", p_sht_flops(), p_sht_bytes());
+			SH_to_spat(sphereDataConfig->shtns, tmp.spectral_space_data, retval.physical_space_data);
+		}
+
+		if (use_cache)
+			cache.insert(sphereDataConfig, SphereData_DerivedCache::OP_SPECTRAL_TO_PHYSICAL, version, 0, retval);
 
 		return retval;
 	}
@@ -286,6 +408,8 @@ public:
 
 	SphereData_PhysicalComplex getSphereDataPhysicalComplex()	const
 	{
+		SWEET_PROFILER_REGION("sht_backward");
+
 		SphereData_PhysicalComplex out(sphereDataConfig);
 
 		/*
@@ -393,6 +517,8 @@ public:
 		for (int idx = 0; idx < sphereDataConfig->spectral_array_data_number_of_elements; idx++)
 			spectral_space_data[idx] += i_sph_data.spectral_space_data[idx];
 
+		spectral_data_modified();
+
 		return *this;
 	}
 
@@ -407,6 +533,52 @@ public:
 		for (int idx = 0; idx < sphereDataConfig->spectral_array_data_number_of_elements; idx++)
 			spectral_space_data[idx] -= i_sph_data.spectral_space_data[idx];
 
+		spectral_data_modified();
+
+		return *this;
+	}
+
+
+
+	/**
+	 * Compute
+	 *   this = i_beta*i_x + sum_j i_alpha[j]*i_y[j]
+	 * in a single pass without temporaries.
+	 *
+	 * i_x might be this field itself, but none of the i_y.
+	 */
+	SphereData_Spectral& spectral_set_linear_combination(
+			double i_beta,
+			const SphereData_Spectral &i_x,
+			int i_num_y,
+			const double *i_alpha,
+			const SphereData_Spectral * const *i_y
+	)
+	{
+		check(i_x.sphereDataConfig);
+
+#if SWEET_DEBUG
+		for (int j = 0; j < i_num_y; j++)
+		{
+			check(i_y[j]->sphereDataConfig);
+			if (i_y[j] == this)
+				FatalError("Output field must not be part of the sum");
+		}
+#endif
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int idx = 0; idx < sphereDataConfig->spectral_array_data_number_of_elements; idx++)
+		{
+			std::complex<double> v = i_beta*i_x.spectral_space_data[idx];
+
+			for (int j = 0; j < i_num_y; j++)
+				v += i_alpha[j]*i_y[j]->spectral_space_data[idx];
+
+			spectral_space_data[idx] = v;
+		}
+
+		spectral_data_modified();
+
 		return *this;
 	}
 
@@ -510,6 +682,8 @@ public:
 		for (int idx = 0; idx < sphereDataConfig->spectral_array_data_number_of_elements; idx++)
 			spectral_space_data[idx] *= i_value;
 
+		spectral_data_modified();
+
 		return *this;
 	}
 
@@ -525,6 +699,8 @@ public:
 		for (int idx = 0; idx < sphereDataConfig->spectral_array_data_number_of_elements; idx++)
 			spectral_space_data[idx] *= i_value;
 
+		spectral_data_modified();
+
 		return *this;
 	}
 
@@ -560,6 +736,7 @@ public:
 	)	const
 	{
 		spectral_space_data[0] += i_value*std::sqrt(4.0*M_PI);
+		spectral_data_modified();
 		return *this;
 	}
 
@@ -585,6 +762,32 @@ public:
 	{
 		sphereDataConfig = i_sphereDataConfig;
 		spectral_space_data = MemBlockAlloc::alloc<cplx>(sphereDataConfig->spectral_array_data_number_of_elements * sizeof(cplx));
+		spectral_data_modified();
+	}
+
+
+
+	/**
+	 * Setup this object as a view on an externally owned buffer
+	 * with at least spectral_array_data_number_of_elements values.
+	 *
+	 * This allows storing several fields in one contiguous buffer.
+	 * The buffer is not released by this object and
+	 * move operations copy the data instead of swapping buffers.
+	 */
+public:
+	void setup_view(
+		const SphereData_Config *i_sphereDataConfig,
+		std::complex<double> *i_spectral_space_data
+	)
+	{
+		if (spectral_space_data != nullptr && !spectral_space_data_is_view)
+			MemBlockAlloc::free(spectral_space_data, sphereDataConfig->spectral_array_data_number_of_elements * sizeof(cplx));
+
+		sphereDataConfig = i_sphereDataConfig;
+		spectral_space_data = i_spectral_space_data;
+		spectral_space_data_is_view = true;
+		spectral_data_modified();
 	}
 
 
@@ -592,7 +795,7 @@ public:
 public:
 	~SphereData_Spectral()
 	{
-		if (spectral_space_data != nullptr)
+		if (spectral_space_data != nullptr && !spectral_space_data_is_view)
 			MemBlockAlloc::free(spectral_space_data, sphereDataConfig->spectral_array_data_number_of_elements * sizeof(cplx));
 	}
 
@@ -615,13 +818,10 @@ public:
 		const double a = i_a;
 		const double b = i_b/(r*r);
 
-		out.spectral_update_lambda(
-			[&](
-				int n, int m,
-				std::complex<double> &io_data
-			)
+		out.spectral_update_lambda_n(
+			[&](int n) -> double
 			{
-				io_data /= (a + (-b*(double)n*((double)n+1.0)));
+				return 1.0/(a + (-b*(double)n*((double)n+1.0)));
 			}
 		);
 
@@ -644,16 +844,13 @@ public:
 
 		const double b = 1.0/(r*r);
 
-		out.spectral_update_lambda(
-			[&](
-				int n, int m,
-				std::complex<double> &io_data
-			)
+		out.spectral_update_lambda_n(
+			[&](int n) -> double
 			{
 				if (n == 0)
-					io_data = 0;
-				else
-					io_data /= (-b*(double)n*((double)n+1.0));
+					return 0;
+
+				return 1.0/(-b*(double)n*((double)n+1.0));
 			}
 		);
 
@@ -671,6 +868,7 @@ public:
 
 		SH_to_spat(sphereDataConfig->shtns, spectral_space_data, tmp.physical_space_data);
 		spat_to_SH(sphereDataConfig->shtns, tmp.physical_space_data, spectral_space_data);
+		spectral_data_modified();
 
 		return *this;
 	}
@@ -678,8 +876,9 @@ public:
 
 
 
+	template <typename T_Lambda>
 	void spectral_update_lambda(
-			std::function<void(int,int,cplx&)> i_lambda
+			T_Lambda i_lambda
 	)
 	{
 		SWEET_THREADING_SPACE_PARALLEL_FOR
@@ -692,6 +891,42 @@ public:
 				idx++;
 			}
 		}
+
+		spectral_data_modified();
+	}
+
+
+
+	/**
+	 * Multiply each mode (n,m) with a factor which only depends on n
+	 *
+	 * The lambda function (int n -> double) is only evaluated once per n
+	 * to setup a table of factors. The update itself is a tight loop over
+	 * the contiguous n-range of each m which can be vectorized.
+	 */
+	template <typename T_Lambda>
+	void spectral_update_lambda_n(
+			T_Lambda i_lambda
+	)
+	{
+		const int n_max = sphereDataConfig->spectral_modes_n_max;
+
+		std::vector<double> factors(n_max+1);
+		for (int n = 0; n <= n_max; n++)
+			factors[n] = i_lambda(n);
+
+		const double *f = factors.data();
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (int m = 0; m <= sphereDataConfig->spectral_modes_m_max; m++)
+		{
+			cplx *data = spectral_space_data + sphereDataConfig->getArrayIndexByModes(m, m) - m;
+
+			for (int n = m; n <= n_max; n++)
+				data[n] *= f[n];
+		}
+
+		spectral_data_modified();
 	}
 
 
@@ -744,6 +979,7 @@ public:
 #endif
 
 		spectral_space_data[sphereDataConfig->getArrayIndexByModes(i_n, i_m)] = i_data;
+		spectral_data_modified();
 	}
 
 
@@ -755,6 +991,8 @@ public:
 		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
 		for (int i = 0; i < sphereDataConfig->spectral_array_data_number_of_elements; i++)
 			spectral_space_data[i] = {0,0};
+
+		spectral_data_modified();
 	}
 
 
@@ -770,6 +1008,8 @@ public:
 		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
 		for (int i = 0; i < sphereDataConfig->spectral_array_data_number_of_elements; i++)
 			spectral_space_data[i] = i_value;
+
+		spectral_data_modified();
 	}
 
 
@@ -782,6 +1022,7 @@ public:
 	)	const
 	{
 		this->spectral_space_data[0] += i_value*std::sqrt(4.0*M_PI);
+		spectral_data_modified();
 	}
 
 
@@ -874,6 +1115,26 @@ public:
 	}
 
 
+	/**
+	 * Return the maximum absolute value of all spectral coefficients
+	 * (NaN if any coefficient is NaN)
+	 */
+	double spectral_reduce_max_abs()	const
+	{
+		double error = 0;
+
+		for (int j = 0; j < sphereDataConfig->spectral_array_data_number_of_elements; j++)
+		{
+			double value = std::abs(spectral_space_data[j]);
+
+			if (value > error || std::isnan(value))
+				error = value;
+		}
+
+		return error;
+	}
+
+
 
 	void spectral_print(
 			int i_precision = 16
@@ -948,6 +1209,23 @@ public:
   	void file_write_binary_spectral(
 			const std::string &i_filename
 	)	const
+	{
+  		file_write_binary_spectral_data(sphereDataConfig, spectral_space_data, i_filename);
+	}
+
+
+
+  	/**
+  	 * Write spectral data given by a raw array to a file in binary format
+  	 *
+  	 * This can be also used with snapshots of the data (e.g. for background output).
+  	 */
+  	static
+  	void file_write_binary_spectral_data(
+			const SphereData_Config *i_sphereDataConfig,
+			const std::complex<double> *i_spectral_space_data,
+			const std::string &i_filename
+	)
 	{
   		std::ofstream file(i_filename, std::ios_base::trunc | std::ios_base::binary);
 
@@ -956,18 +1234,64 @@ public:
 
   		file << "SWEET" << std::endl;
   		file << "DATA_TYPE SH_DATA" << std::endl;
-  		file << "NUM_LON " << sphereDataConfig->spectral_modes_m_max << std::endl;
-  		file << "NUM_LAT " << sphereDataConfig->spectral_modes_n_max << std::endl;
-  		file << "SIZE " << sphereDataConfig->spectral_array_data_number_of_elements << std::endl;
+  		file << "NUM_LON " << i_sphereDataConfig->spectral_modes_m_max << std::endl;
+  		file << "NUM_LAT " << i_sphereDataConfig->spectral_modes_n_max << std::endl;
+  		file << "SIZE " << i_sphereDataConfig->spectral_array_data_number_of_elements << std::endl;
   		file << "FIN" << std::endl;
-  		std::cout << file.tellp() << std::endl;
 
-  		file.write((const char*)spectral_space_data, sizeof(std::complex<double>)*sphereDataConfig->spectral_array_data_number_of_elements);
+  		file.write((const char*)i_spectral_space_data, sizeof(std::complex<double>)*i_sphereDataConfig->spectral_array_data_number_of_elements);
 
   		file.close();
 	}
 
 
+  	/**
+  	 * Add a copy of the spectral data to a checkpoint
+  	 */
+  	void checkpoint_write(
+  			SWEETCheckpoint &io_checkpoint,
+			const std::string &i_name
+	)	const
+	{
+  		int64_t res[4] = {sphereDataConfig->spectral_modes_n_max, sphereDataConfig->spectral_modes_m_max, 0, 0};
+
+  		io_checkpoint.addData(
+  				i_name,
+				SWEETDataContainer::PRIMITIVE_SPHERE,
+				SWEETDataContainer::SPACE_SPECTRAL,
+				SWEETDataContainer::DATA_TYPE_COMPLEX128,
+				res,
+				spectral_space_data,
+				sphereDataConfig->spectral_array_data_number_of_elements
+			);
+	}
+
+
+
+  	/**
+  	 * Load the spectral data from a checkpoint
+  	 */
+  	void checkpoint_read(
+  			const SWEETCheckpoint &i_checkpoint,
+			const std::string &i_name
+	)
+	{
+  		const SWEETCheckpoint::Entry &e = i_checkpoint.getEntry(
+  				i_name,
+				SWEETDataContainer::PRIMITIVE_SPHERE,
+				SWEETDataContainer::DATA_TYPE_COMPLEX128,
+				sphereDataConfig->spectral_array_data_number_of_elements
+			);
+
+  		if (e.resolution[0] != sphereDataConfig->spectral_modes_n_max || e.resolution[1] != sphereDataConfig->spectral_modes_m_max)
+  			FatalError("Checkpoint: Spectral resolution of '"+i_name+"' doesn't match");
+
+  		std::memcpy(spectral_space_data, e.data.data(), e.data.size());
+  		spectral_data_modified();
+	}
+
+
+
   	void file_read_binary_spectral(
 			const std::string &i_filename
 	)
@@ -1046,6 +1370,7 @@ public:
   			FatalError("NUM_LAT "+std::to_string(num_lat)+" doesn't match SphereDataConfig");
 
   		file.read((char*)spectral_space_data, sizeof(std::complex<double>)*sphereDataConfig->spectral_array_data_number_of_elements);
+  		spectral_data_modified();
 
   		file.close();
 	}
@@ -11,6 +11,7 @@
 #include <complex>
 #include <functional>
 #include <array>
+#include <vector>
 #include <string.h>
 #include <iostream>
 #include <fstream>
@@ -21,6 +22,7 @@
 
 #include <sweet/MemBlockAlloc.hpp>
 #include <sweet/parmemcpy.hpp>
+#include <sweet/SplitComplex.hpp>
 #include <sweet/sphere/SphereData_Config.hpp>
 #include <sweet/sphere/SphereData_PhysicalComplex.hpp>
 #include <sweet/sphere/SphereData_Spectral.hpp>
@@ -491,9 +493,19 @@ public:
 		SphereData_SpectralComplex out_sph_data(sphereDataConfig);
 
 
+#if SWEET_COMPLEX_SPLIT
+		SplitComplexKernels::for_blocks(
+			sphereDataConfig->physical_array_data_number_of_elements,
+			[&](std::size_t idx, std::size_t n)
+			{
+				SplitComplexKernels::mul(n, &physical_space_data[idx], &i_sph_data.physical_space_data[idx], &out_sph_data.physical_space_data[idx]);
+			}
+		);
+#else
 	SWEET_THREADING_SPACE_PARALLEL_FOR
 		for (int i = 0; i < sphereDataConfig->physical_array_data_number_of_elements; i++)
 			out_sph_data.physical_space_data[i] = i_sph_data.physical_space_data[i]*physical_space_data[i];
+#endif
 
 		out_sph_data.spectral_space_data_valid = false;
 		out_sph_data.physical_space_data_valid = true;
@@ -569,9 +581,19 @@ public:
 		request_data_spectral();
 
 
+#if SWEET_COMPLEX_SPLIT
+		SplitComplexKernels::for_blocks(
+			sphereDataConfig->spectral_complex_array_data_number_of_elements,
+			[&](std::size_t idx, std::size_t n)
+			{
+				SplitComplexKernels::mul_scalar(n, &spectral_space_data[idx], i_value, &spectral_space_data[idx]);
+			}
+		);
+#else
 	SWEET_THREADING_SPACE_PARALLEL_FOR
 		for (int idx = 0; idx < sphereDataConfig->spectral_complex_array_data_number_of_elements; idx++)
 			spectral_space_data[idx] *= i_value;
+#endif
 
 		return *this;
 	}
@@ -604,9 +626,21 @@ public:
 		request_data_spectral();
 
 
+#if SWEET_COMPLEX_SPLIT
+		std::complex<double> inv_value = 1.0/i_value;
+
+		SplitComplexKernels::for_blocks(
+			sphereDataConfig->spectral_complex_array_data_number_of_elements,
+			[&](std::size_t idx, std::size_t n)
+			{
+				SplitComplexKernels::mul_scalar(n, &spectral_space_data[idx], inv_value, &spectral_space_data[idx]);
+			}
+		);
+#else
 	SWEET_THREADING_SPACE_PARALLEL_FOR
 		for (int idx = 0; idx < sphereDataConfig->spectral_complex_array_data_number_of_elements; idx++)
 			spectral_space_data[idx] /= i_value;
+#endif
 
 		return *this;
 	}
@@ -689,9 +723,19 @@ public:
 		SphereData_SpectralComplex out_sph_data(sphereDataConfig);
 
 
+#if SWEET_COMPLEX_SPLIT
+		SplitComplexKernels::for_blocks(
+			sphereDataConfig->spectral_complex_array_data_number_of_elements,
+			[&](std::size_t idx, std::size_t n)
+			{
+				SplitComplexKernels::mul_scalar(n, &spectral_space_data[idx], i_value, &out_sph_data.spectral_space_data[idx]);
+			}
+		);
+#else
 	SWEET_THREADING_SPACE_PARALLEL_FOR
 		for (int idx = 0; idx < sphereDataConfig->spectral_complex_array_data_number_of_elements; idx++)
 			out_sph_data.spectral_space_data[idx] = spectral_space_data[idx]*i_value;
+#endif
 
 		out_sph_data.physical_space_data_valid = false;
 		out_sph_data.spectral_space_data_valid = true;
@@ -746,13 +790,10 @@ public:
 		const std::complex<double> a = i_a;
 		const std::complex<double> b = i_b/(r*r);
 
-		out.spectral_update_lambda(
-			[&](
-				int n, int m,
-				std::complex<double> &io_data
-			)
+		out.spectral_update_lambda_n(
+			[&](int n) -> std::complex<double>
 			{
-				io_data /= (a + (-b*(double)n*((double)n+1.0)));
+				return 1.0/(a + (-b*(double)n*((double)n+1.0)));
 			}
 		);
 
@@ -797,9 +838,10 @@ public:
 	}
 
 
+	template <typename T_Lambda>
 	inline
 	void spectral_update_lambda(
-			std::function<void(int,int,cplx&)> i_lambda
+			T_Lambda i_lambda
 	)
 	{
 		if (physical_space_data_valid)
@@ -822,6 +864,44 @@ public:
 
 
 
+	/**
+	 * Multiply each mode (n,m) with a factor which only depends on n
+	 *
+	 * The lambda function (int n -> complex) is only evaluated once per n.
+	 */
+	template <typename T_Lambda>
+	void spectral_update_lambda_n(
+			T_Lambda i_lambda
+	)
+	{
+		if (physical_space_data_valid)
+			request_data_spectral();
+
+		assert(spectral_space_data_valid);
+
+		const int n_max = sphereDataConfig->spectral_modes_n_max;
+
+		std::vector<cplx> factors(n_max+1);
+		for (int n = 0; n <= n_max; n++)
+			factors[n] = i_lambda(n);
+
+		const cplx *f = factors.data();
+
+	SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (int n = 0; n <= n_max; n++)
+		{
+			cplx *data = spectral_space_data + sphereDataConfig->getArrayIndexByModes_Complex(n, -n);
+			const cplx fn = f[n];
+
+			for (int i = 0; i <= 2*n; i++)
+				data[i] *= fn;
+		}
+
+		physical_space_data_valid = false;
+	}
+
+
+
 	void physical_update_lambda_sinphi_grid(
 			std::function< void(double,double,std::complex<double>&) > i_lambda	///< lambda function to return value for lat/mu
 	)
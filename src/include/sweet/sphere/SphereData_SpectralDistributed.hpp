@@ -0,0 +1,395 @@
+/*
+ * SphereData_SpectralDistributed.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SPHERE_SPHEREDATA_SPECTRALDISTRIBUTED_HPP_
+#define SRC_INCLUDE_SWEET_SPHERE_SPHEREDATA_SPECTRALDISTRIBUTED_HPP_
+
+#include <complex>
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include <sweet/MemBlockAlloc.hpp>
+#include <sweet/FatalError.hpp>
+#include <sweet/openmp_helper.hpp>
+#include <sweet/sphere/SphereData_ConfigDistributed.hpp>
+#include <sweet/sphere/SphereData_PhysicalDistributed.hpp>
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
+
+
+
+/**
+ * Spectral sphere data of the local zonal wavenumbers m (see SphereData_ConfigDistributed)
+ *
+ * All spectral operations only work on the local modes and don't require
+ * any communication. Only the transformations to and from physical space
+ * and the reductions are collective operations.
+ */
+class SphereData_SpectralDistributed
+{
+	typedef std::complex<double> cplx;
+
+public:
+	const SphereData_ConfigDistributed *sphereDataConfig;
+
+	/// local modes, layout like SphereData_Spectral (see getLocalArrayIndexByModes)
+	cplx *spectral_space_data;
+
+
+private:
+	void p_allocate_buffers()
+	{
+		spectral_space_data = MemBlockAlloc::alloc<cplx>(
+				sphereDataConfig->spectral_local_array_data_number_of_elements*sizeof(cplx)
+			);
+	}
+
+
+public:
+	SphereData_SpectralDistributed(
+			const SphereData_ConfigDistributed *i_sphereDataConfig
+	)	:
+		sphereDataConfig(i_sphereDataConfig),
+		spectral_space_data(nullptr)
+	{
+		assert(sphereDataConfig != nullptr);
+		p_allocate_buffers();
+	}
+
+
+	SphereData_SpectralDistributed(
+			const SphereData_SpectralDistributed &i_data
+	)	:
+		sphereDataConfig(i_data.sphereDataConfig),
+		spectral_space_data(nullptr)
+	{
+		p_allocate_buffers();
+		std::copy(i_data.spectral_space_data, i_data.spectral_space_data + sphereDataConfig->spectral_local_array_data_number_of_elements, spectral_space_data);
+	}
+
+
+	SphereData_SpectralDistributed(
+			SphereData_SpectralDistributed &&i_data
+	)	:
+		sphereDataConfig(i_data.sphereDataConfig),
+		spectral_space_data(i_data.spectral_space_data)
+	{
+		i_data.spectral_space_data = nullptr;
+	}
+
+
+	/**
+	 * Transformation from physical space
+	 *
+	 * Collective operation with MPI
+	 */
+	SphereData_SpectralDistributed(
+			const SphereData_PhysicalDistributed &i_data
+	)	:
+		sphereDataConfig(i_data.sphereDataConfig),
+		spectral_space_data(nullptr)
+	{
+		p_allocate_buffers();
+		sphereDataConfig->sph_physical_to_spectral(i_data.physical_space_data, spectral_space_data);
+	}
+
+
+	~SphereData_SpectralDistributed()
+	{
+		if (spectral_space_data != nullptr)
+			MemBlockAlloc::free(spectral_space_data, sphereDataConfig->spectral_local_array_data_number_of_elements*sizeof(cplx));
+	}
+
+
+	SphereData_SpectralDistributed& operator=(
+			const SphereData_SpectralDistributed &i_data
+	)
+	{
+		if (sphereDataConfig != i_data.sphereDataConfig)
+			FatalError("SphereData_SpectralDistributed: Assignment between different configurations not supported");
+
+		if (this != &i_data)
+			std::copy(i_data.spectral_space_data, i_data.spectral_space_data + sphereDataConfig->spectral_local_array_data_number_of_elements, spectral_space_data);
+
+		return *this;
+	}
+
+
+	SphereData_SpectralDistributed& operator=(
+			SphereData_SpectralDistributed &&i_data
+	)
+	{
+		if (sphereDataConfig != i_data.sphereDataConfig)
+			FatalError("SphereData_SpectralDistributed: Assignment between different configurations not supported");
+
+		std::swap(spectral_space_data, i_data.spectral_space_data);
+		return *this;
+	}
+
+
+
+	/**
+	 * Transformation to physical space
+	 *
+	 * Collective operation with MPI
+	 */
+	SphereData_PhysicalDistributed getSphereDataPhysical()	const
+	{
+		SphereData_PhysicalDistributed out(sphereDataConfig);
+		sphereDataConfig->sph_spectral_to_physical(spectral_space_data, out.physical_space_data);
+		return out;
+	}
+
+
+	/**
+	 * Setup the local modes from the corresponding part of global spectral data
+	 */
+	void loadGlobalSpectralData(
+			const cplx *i_global_data
+	)
+	{
+		std::copy(
+				i_global_data + sphereDataConfig->spectral_local_array_data_offset,
+				i_global_data + sphereDataConfig->spectral_local_array_data_offset + sphereDataConfig->spectral_local_array_data_number_of_elements,
+				spectral_space_data
+			);
+	}
+
+
+
+	void spectral_set_zero()
+	{
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->spectral_local_array_data_number_of_elements; i++)
+			spectral_space_data[i] = 0;
+	}
+
+
+	/**
+	 * Update all local modes (n,m)
+	 */
+	template <typename T_Lambda>
+	void spectral_update_lambda(
+			T_Lambda i_lambda
+	)
+	{
+		int m_start = sphereDataConfig->spectral_local_m_start;
+		int m_end = m_start + sphereDataConfig->spectral_local_m_size;
+		int n_max = sphereDataConfig->spectral_modes_n_max;
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (int m = m_start; m < m_end; m++)
+		{
+			std::size_t idx = sphereDataConfig->getLocalArrayIndexByModes(m, m);
+			for (int n = m; n <= n_max; n++)
+			{
+				i_lambda(n, m, spectral_space_data[idx]);
+				idx++;
+			}
+		}
+	}
+
+
+	/**
+	 * Multiply each local mode (n,m) with a factor which only depends on n
+	 * (see SphereData_Spectral::spectral_update_lambda_n)
+	 */
+	template <typename T_Lambda>
+	void spectral_update_lambda_n(
+			T_Lambda i_lambda
+	)
+	{
+		int m_start = sphereDataConfig->spectral_local_m_start;
+		int m_end = m_start + sphereDataConfig->spectral_local_m_size;
+		int n_max = sphereDataConfig->spectral_modes_n_max;
+
+		std::vector<double> factors(n_max+1);
+		for (int n = 0; n <= n_max; n++)
+			factors[n] = i_lambda(n);
+
+		const double *f = factors.data();
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (int m = m_start; m < m_end; m++)
+		{
+			cplx *data = spectral_space_data + sphereDataConfig->getLocalArrayIndexByModes(m, m) - m;
+
+			for (int n = m; n <= n_max; n++)
+				data[n] *= f[n];
+		}
+	}
+
+
+	/**
+	 * Return mode (n,m) which has to be local
+	 */
+	const cplx& spectral_get(
+			int i_n,
+			int i_m
+	)	const
+	{
+		return spectral_space_data[sphereDataConfig->getLocalArrayIndexByModes(i_n, i_m)];
+	}
+
+
+
+	SphereData_SpectralDistributed operator+(
+			const SphereData_SpectralDistributed &i_data
+	)	const
+	{
+		SphereData_SpectralDistributed out(sphereDataConfig);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->spectral_local_array_data_number_of_elements; i++)
+			out.spectral_space_data[i] = spectral_space_data[i] + i_data.spectral_space_data[i];
+
+		return out;
+	}
+
+
+	SphereData_SpectralDistributed operator-(
+			const SphereData_SpectralDistributed &i_data
+	)	const
+	{
+		SphereData_SpectralDistributed out(sphereDataConfig);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->spectral_local_array_data_number_of_elements; i++)
+			out.spectral_space_data[i] = spectral_space_data[i] - i_data.spectral_space_data[i];
+
+		return out;
+	}
+
+
+	SphereData_SpectralDistributed& operator+=(
+			const SphereData_SpectralDistributed &i_data
+	)
+	{
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->spectral_local_array_data_number_of_elements; i++)
+			spectral_space_data[i] += i_data.spectral_space_data[i];
+
+		return *this;
+	}
+
+
+	SphereData_SpectralDistributed& operator-=(
+			const SphereData_SpectralDistributed &i_data
+	)
+	{
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->spectral_local_array_data_number_of_elements; i++)
+			spectral_space_data[i] -= i_data.spectral_space_data[i];
+
+		return *this;
+	}
+
+
+	SphereData_SpectralDistributed& operator*=(
+			double i_value
+	)
+	{
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->spectral_local_array_data_number_of_elements; i++)
+			spectral_space_data[i] *= i_value;
+
+		return *this;
+	}
+
+
+	/**
+	 * Set this to i_beta*i_x + sum_j i_alpha[j]*i_y[j]
+	 * (see SphereData_Spectral::spectral_set_linear_combination)
+	 *
+	 * i_x may be this, none of the i_y must be this.
+	 */
+	SphereData_SpectralDistributed& spectral_set_linear_combination(
+			double i_beta,
+			const SphereData_SpectralDistributed &i_x,
+			int i_num_y,
+			const double *i_alpha,
+			const SphereData_SpectralDistributed * const *i_y
+	)
+	{
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int idx = 0; idx < sphereDataConfig->spectral_local_array_data_number_of_elements; idx++)
+		{
+			cplx v = i_beta*i_x.spectral_space_data[idx];
+
+			for (int j = 0; j < i_num_y; j++)
+				v += i_alpha[j]*i_y[j]->spectral_space_data[idx];
+
+			spectral_space_data[idx] = v;
+		}
+
+		return *this;
+	}
+
+
+
+	SphereData_SpectralDistributed operator*(
+			double i_value
+	)	const
+	{
+		SphereData_SpectralDistributed out(sphereDataConfig);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int i = 0; i < sphereDataConfig->spectral_local_array_data_number_of_elements; i++)
+			out.spectral_space_data[i] = spectral_space_data[i]*i_value;
+
+		return out;
+	}
+
+
+	SphereData_SpectralDistributed operator-()	const
+	{
+		return *this*(-1.0);
+	}
+
+
+
+	/**
+	 * Return the max. absolute value of all modes over all ranks
+	 *
+	 * Collective operation with MPI
+	 */
+	double spectral_reduce_max_abs()	const
+	{
+		double maxabs = 0;
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for PROC_BIND_CLOSE reduction(max:maxabs)
+#endif
+		for (int i = 0; i < sphereDataConfig->spectral_local_array_data_number_of_elements; i++)
+			maxabs = std::max(maxabs, std::abs(spectral_space_data[i]));
+
+#if SWEET_MPI
+		MPI_Allreduce(MPI_IN_PLACE, &maxabs, 1, MPI_DOUBLE, MPI_MAX, sphereDataConfig->mpi_comm);
+#endif
+
+		return maxabs;
+	}
+};
+
+
+
+inline
+SphereData_SpectralDistributed operator*(
+		double i_value,
+		const SphereData_SpectralDistributed &i_data
+)
+{
+	return i_data*i_value;
+}
+
+
+
+#endif /* SRC_INCLUDE_SWEET_SPHERE_SPHEREDATA_SPECTRALDISTRIBUTED_HPP_ */
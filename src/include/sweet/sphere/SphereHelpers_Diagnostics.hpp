@@ -8,6 +8,9 @@
 #ifndef SRC_INCLUDE_SWEET_PLANE_SPHEREDIAGNOSTICS_HPP_
 #define SRC_INCLUDE_SWEET_PLANE_SPHEREDIAGNOSTICS_HPP_
 
+#include <cmath>
+#include <vector>
+#include <sweet/openmp_helper.hpp>
 #include <sweet/sphere/SphereData_Config.hpp>
 #include <sweet/SimulationVariables.hpp>
 #include <sweet/sphere/SphereOperators_SphereData.hpp>
@@ -18,7 +21,10 @@ class SphereHelpers_Diagnostics
 	SphereData_Config *sphereDataConfig;
 	SphereData_Spectral modeIntegralValues;
 
-	SphereData_Physical fg;
+	/*
+	 * Coriolis parameter for each latitude
+	 */
+	std::vector<double> coriolis;
 
 	/*
 	 * Gaussian quadrature weights
@@ -33,8 +39,7 @@ public:
 			int i_verbose = 1
 	)	:
 		sphereDataConfig(i_sphereDataConfig),
-		modeIntegralValues(sphereDataConfig),
-		fg(sphereDataConfig)
+		modeIntegralValues(sphereDataConfig)
 	{
 		gauss_weights.resize(sphereDataConfig->physical_num_lat);
 
@@ -95,12 +100,9 @@ public:
 		}
 #endif
 
-		fg.physical_update_lambda_gaussian_grid(
-			[&](double lon, double mu, double &o_data)
-			{
-				o_data = mu*2.0*i_simVars.sim.sphere_rotating_coriolis_omega;
-			}
-		);
+		coriolis.resize(sphereDataConfig->physical_num_lat);
+		for (int jlat = 0; jlat < sphereDataConfig->physical_num_lat; jlat++)
+			coriolis[jlat] = sphereDataConfig->lat_gaussian[jlat]*2.0*i_simVars.sim.sphere_rotating_coriolis_omega;
 
 		/*
 		 * Test Gaussian quadrature
@@ -170,26 +172,31 @@ public:
 public:
 	/*
 	 * The integral similar to the zylinder is used because of the lat-related scaling factor.
+	 *
+	 * Integrating 1 yields 4*pi (area of the unit sphere).
 	 */
 	double compute_zylinder_integral(
-			const SphereData_Spectral &i_data
+			const SphereData_Physical &i_data
 	)	const
 	{
-		SphereData_Physical data = i_data.getSphereDataPhysical();
-
 		double sum = 0;
 
 #if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
 #error "TODO"
 #else
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for PROC_BIND_CLOSE reduction(+:sum)
+#endif
 		for (int jlat = 0; jlat < sphereDataConfig->physical_num_lat; jlat++)
 		{
+			const double *data = i_data.physical_space_data + jlat*sphereDataConfig->physical_num_lon;
+
+			double lat_sum = 0;
 			for (int ilon = 0; ilon < sphereDataConfig->physical_num_lon; ilon++)
-			{
-				double value = data.physical_space_data[jlat*sphereDataConfig->physical_num_lon + ilon];
+				lat_sum += data[ilon];
 
-				sum += value*gauss_weights[jlat];
-			}
+			sum += lat_sum*gauss_weights[jlat];
 		}
 #endif
 		sum /= (double)sphereDataConfig->physical_num_lon;
@@ -203,6 +210,135 @@ public:
 
 
 
+	/*
+	 * Integral of spectral data over the unit sphere.
+	 *
+	 * Only the (n=0,m=0) mode contributes. With the orthonormal
+	 * spherical harmonics, Y_0^0 = 1/sqrt(4*pi).
+	 */
+	double compute_zylinder_integral(
+			const SphereData_Spectral &i_data
+	)	const
+	{
+		return i_data.spectral_space_data[sphereDataConfig->getArrayIndexByModes(0, 0)].real()*std::sqrt(4.0*M_PI);
+	}
+
+
+
+	/*
+	 * Integral of the product of two fields over the unit sphere
+	 * directly computed from the spectral coefficients (Parseval).
+	 *
+	 * Only modes with m >= 0 are stored, hence modes with m > 0
+	 * are counted twice.
+	 */
+	double compute_zylinder_integral_product(
+			const SphereData_Spectral &i_a,
+			const SphereData_Spectral &i_b
+	)	const
+	{
+		double sum = 0;
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for PROC_BIND_CLOSE reduction(+:sum) schedule(dynamic)
+#endif
+		for (int m = 0; m <= sphereDataConfig->spectral_modes_m_max; m++)
+		{
+			double cm = (m == 0 ? 1.0 : 2.0);
+
+			std::size_t idx = sphereDataConfig->getArrayIndexByModes(m, m);
+
+			double m_sum = 0;
+			for (int n = m; n <= sphereDataConfig->spectral_modes_n_max; n++)
+			{
+				const std::complex<double> &a = i_a.spectral_space_data[idx];
+				const std::complex<double> &b = i_b.spectral_space_data[idx];
+
+				m_sum += a.real()*b.real() + a.imag()*b.imag();
+				idx++;
+			}
+
+			sum += cm*m_sum;
+		}
+
+		return sum;
+	}
+
+
+
+private:
+	/*
+	 * Compute in one fused Gaussian quadrature pass over the unit sphere
+	 *
+	 *   o_kin_energy = \int 0.5*h*(u^2+v^2)
+	 *   o_enstrophy = \int 0.5*(vort+vort_offset+f)^2 / h	(i_div_by_h == true)
+	 *   o_enstrophy = \int 0.5*(vort+vort_offset+f)^2		(i_div_by_h == false)
+	 *
+	 * with h given by i_h*i_h_scale.
+	 */
+	void p_fused_kin_energy_enstrophy(
+			const SphereData_Physical &i_h,
+			double i_h_scale,
+			const SphereData_Physical &i_u,
+			const SphereData_Physical &i_v,
+			const SphereData_Physical &i_vort,
+			double i_vort_offset,
+			bool i_div_by_h,
+			double &o_kin_energy,
+			double &o_enstrophy
+	)	const
+	{
+		double kin_energy = 0;
+		double enstrophy = 0;
+
+		int num_lon = sphereDataConfig->physical_num_lon;
+
+#if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
+#error "TODO"
+#else
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for PROC_BIND_CLOSE reduction(+:kin_energy,enstrophy)
+#endif
+		for (int jlat = 0; jlat < sphereDataConfig->physical_num_lat; jlat++)
+		{
+			double f = coriolis[jlat] + i_vort_offset;
+
+			std::size_t offset = jlat*num_lon;
+			const double *h = i_h.physical_space_data + offset;
+			const double *u = i_u.physical_space_data + offset;
+			const double *v = i_v.physical_space_data + offset;
+			const double *vort = i_vort.physical_space_data + offset;
+
+			double lat_kin_energy = 0;
+			double lat_enstrophy = 0;
+
+			for (int ilon = 0; ilon < num_lon; ilon++)
+			{
+				double hh = h[ilon]*i_h_scale;
+				double eta = vort[ilon] + f;
+
+				lat_kin_energy += hh*(u[ilon]*u[ilon] + v[ilon]*v[ilon]);
+
+				if (i_div_by_h)
+					lat_enstrophy += eta*eta/hh;
+				else
+					lat_enstrophy += eta*eta;
+			}
+
+			kin_energy += lat_kin_energy*gauss_weights[jlat];
+			enstrophy += lat_enstrophy*gauss_weights[jlat];
+		}
+#endif
+
+		double scale = 0.5*2.0*M_PI/(double)num_lon;
+
+		o_kin_energy = kin_energy*scale;
+		o_enstrophy = enstrophy*scale;
+	}
+
+
+
 public:
 	void update_h_u_v_2_mass_energy_enstrophy_4_zylinder(
 			const SphereOperators_SphereData &op,
@@ -224,35 +360,37 @@ public:
 
 		double normalization = 4.0*M_PI*(io_simVars.sim.sphere_radius*io_simVars.sim.sphere_radius);
 
-		// mass
-		io_simVars.diag.total_mass = compute_zylinder_integral(h) * normalization;
+		// mass (spectral)
+		io_simVars.diag.total_mass = compute_zylinder_integral(i_prog_h) * normalization;
 
 		// energy
-		SphereData_Physical pot_energy = h*(io_simVars.sim.gravitation*normalization);
-		SphereData_Physical kin_energy = h*(u*u+v*v)*(0.5*normalization);
-
-		io_simVars.diag.potential_energy = compute_zylinder_integral(pot_energy);
-		io_simVars.diag.kinetic_energy = compute_zylinder_integral(kin_energy);
-
-		io_simVars.diag.total_energy = io_simVars.diag.kinetic_energy + io_simVars.diag.potential_energy;
+		io_simVars.diag.potential_energy = io_simVars.diag.total_mass*io_simVars.sim.gravitation;
 
 		// total vorticity
-		SphereData_Physical eta(i_prog_h.sphereDataConfig);
-//		if (io_simVars.misc.sphere_use_robert_functions)
-//			eta = op.robert_uv_to_vort(u, v).getSphereDataPhysical();
-//		else
-			eta = op.uv_to_vort(u, v).getSphereDataPhysical();
+		SphereData_Physical vort = op.uv_to_vort(u, v).getSphereDataPhysical();
 
-		eta += fg;
+		// kinetic energy and enstrophy in one quadrature pass
+		double kin_energy, enstrophy;
+		p_fused_kin_energy_enstrophy(h, 1.0, u, v, vort, 0, false, kin_energy, enstrophy);
+
+		io_simVars.diag.kinetic_energy = kin_energy*normalization;
+		io_simVars.diag.total_energy = io_simVars.diag.kinetic_energy + io_simVars.diag.potential_energy;
 
 		// enstrophy
-		io_simVars.diag.total_potential_enstrophy = 0.5*compute_zylinder_integral(eta*eta) * normalization;
+		io_simVars.diag.total_potential_enstrophy = enstrophy*normalization;
 	}
 
 
 
 
 public:
+	/*
+	 * Mass and potential energy are directly computed from the
+	 * spectral coefficients of phi.
+	 *
+	 * Kinetic energy and potential enstrophy are computed in one
+	 * fused Gaussian quadrature pass.
+	 */
 	void update_phi_vort_div_2_mass_energy_enstrophy(
 			const SphereOperators_SphereData &op,
 			const SphereData_Spectral &i_prog_phi,
@@ -262,28 +400,39 @@ public:
 			SimulationVariables &io_simVars
 	)
 	{
-		SphereData_Physical h(sphereDataConfig);
+		double inv_g = 1.0/io_simVars.sim.gravitation;
+		double normalization = (io_simVars.sim.sphere_radius*io_simVars.sim.sphere_radius);
+
+		// mass
+		io_simVars.diag.total_mass = compute_zylinder_integral(i_prog_phi)*inv_g * normalization;
+
+		// energy
+		io_simVars.diag.potential_energy = 0.5*compute_zylinder_integral_product(i_prog_phi, i_prog_phi)*(inv_g*inv_g) * normalization;
+
 		SphereData_Physical u(sphereDataConfig);
 		SphereData_Physical v(sphereDataConfig);
 
-		h = i_prog_phi.getSphereDataPhysical()*(1.0/io_simVars.sim.gravitation);
 		if (io_simVars.misc.sphere_use_robert_functions)
 			op.robert_vortdiv_to_uv(i_prog_vort, i_prog_div, u, v);
 		else
 			op.vortdiv_to_uv(i_prog_vort, i_prog_div, u, v);
 
-		double normalization = (io_simVars.sim.sphere_radius*io_simVars.sim.sphere_radius);
+		SphereData_Physical phi = i_prog_phi.getSphereDataPhysical();
 
-		// mass
-		io_simVars.diag.total_mass = compute_zylinder_integral(h) * normalization;
+		/*
+		 * The relative vorticity is directly taken from i_prog_vort.
+		 *
+		 * Computing it from the velocity (as done before) removes the
+		 * (n=0,m=0) mode which is not representable by the velocity.
+		 * This mode is subtracted here to get identical results.
+		 */
+		SphereData_Physical vort = i_prog_vort.getSphereDataPhysical();
+		double vort_offset = -compute_zylinder_integral(i_prog_vort)/(4.0*M_PI);
 
-		// energy
-		//SphereDataPhysical pot_energy = h*(io_simVars.sim.gravitation*normalization);
-		SphereData_Physical pot_energy = h*h*0.5*normalization;
-		SphereData_Physical kin_energy = h*(u*u+v*v)*(0.5*normalization);
+		double kin_energy, enstrophy;
+		p_fused_kin_energy_enstrophy(phi, inv_g, u, v, vort, vort_offset, true, kin_energy, enstrophy);
 
-		io_simVars.diag.potential_energy = compute_zylinder_integral(pot_energy);
-		io_simVars.diag.kinetic_energy = compute_zylinder_integral(kin_energy);
+		io_simVars.diag.kinetic_energy = kin_energy*normalization;
 
 		/*
 		 * We follow the Williamson et al. equation (137) here
@@ -296,18 +445,8 @@ public:
 		 */
 		io_simVars.diag.total_energy = io_simVars.diag.kinetic_energy + io_simVars.diag.potential_energy;
 
-		// total vorticity
-		// TODO: maybe replace this with the i_vort parameter
-		SphereData_Physical eta(h.sphereDataConfig);
-		if (io_simVars.misc.sphere_use_robert_functions)
-			eta = op.robert_uv_to_vort(u, v).getSphereDataPhysical();
-		else
-			eta = op.uv_to_vort(u, v).getSphereDataPhysical();
-
-		eta += fg;
-
 		// enstrophy (Williamson paper, equation 138)
-		io_simVars.diag.total_potential_enstrophy = 0.5*compute_zylinder_integral(eta*eta/h) * normalization;
+		io_simVars.diag.total_potential_enstrophy = enstrophy * normalization;
 	}
 
 
@@ -0,0 +1,512 @@
+/*
+ * SphereHelpers_InSituDiagnostics.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SPHERE_SPHEREHELPERS_INSITUDIAGNOSTICS_HPP_
+#define SRC_INCLUDE_SWEET_SPHERE_SPHEREHELPERS_INSITUDIAGNOSTICS_HPP_
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <cmath>
+#include <sweet/sphere/SphereData_Config.hpp>
+#include <sweet/sphere/SphereData_Spectral.hpp>
+#include <sweet/sphere/SphereData_Physical.hpp>
+#include <sweet/sphere/SphereOperators_SphereData.hpp>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/FatalError.hpp>
+
+
+
+/**
+ * In-situ diagnostics for the SWE on the sphere in phi/vort/div formulation.
+ *
+ * All registered reductions are computed together with one transformation
+ * per prognostic field and a single fused loop over the physical grid.
+ * The kinetic energy spectrum is directly computed in spectral space.
+ *
+ * One line per call of compute() is appended to a time series file:
+ *
+ *   #SWEET_SPHERE_INSITU_DIAGNOSTICS
+ *   #TI [title]
+ *   time	[column 1]	[column 2]	...
+ *   [values]
+ *
+ * Available reductions:
+ *   mass:          total mass
+ *   energy:        potential, kinetic and total energy
+ *   enstrophy:     total potential enstrophy
+ *   minmax:        min/max of phi, u, v and vorticity in physical space
+ *   errors:        max and RMS errors of phi, vort, div w.r.t. reference fields
+ *   ke_spectrum:   kinetic energy for each total wavenumber n
+ */
+class SphereHelpers_InSituDiagnostics
+{
+	const SphereData_Config *sphereDataConfig;
+	const SphereOperators_SphereData *op;
+	SimulationVariables *simVars;
+
+	/// Gaussian quadrature weights for each latitude
+	std::vector<double> gauss_weights;
+
+	/// Coriolis parameter for each latitude
+	std::vector<double> coriolis;
+
+	bool reduction_mass;
+	bool reduction_energy;
+	bool reduction_enstrophy;
+	bool reduction_minmax;
+	bool reduction_errors;
+	bool reduction_ke_spectrum;
+
+	/// Reference solution in physical space for error norms
+	std::vector<double> ref_phi;
+	std::vector<double> ref_vort;
+	std::vector<double> ref_div;
+
+	std::ofstream file;
+
+	/// Column names of time series
+	std::vector<std::string> columns;
+
+	/// Values of the last call to compute()
+	std::vector<double> values;
+
+
+public:
+	SphereHelpers_InSituDiagnostics()	:
+		sphereDataConfig(nullptr),
+		op(nullptr),
+		simVars(nullptr),
+		reduction_mass(false),
+		reduction_energy(false),
+		reduction_enstrophy(false),
+		reduction_minmax(false),
+		reduction_errors(false),
+		reduction_ke_spectrum(false)
+	{
+	}
+
+
+
+	bool isActive()
+	{
+		return file.is_open();
+	}
+
+
+
+	/**
+	 * Setup diagnostics and open time series file
+	 */
+	void setup(
+			const SphereData_Config *i_sphereDataConfig,
+			const SphereOperators_SphereData *i_op,
+			SimulationVariables *i_simVars,
+			const std::string &i_reductions,	///< comma separated list of reductions
+			const std::string &i_filename,
+			bool i_append = false				///< append to existing file, e.g. after restart
+	)
+	{
+		sphereDataConfig = i_sphereDataConfig;
+		op = i_op;
+		simVars = i_simVars;
+
+		reduction_mass = false;
+		reduction_energy = false;
+		reduction_enstrophy = false;
+		reduction_minmax = false;
+		reduction_errors = false;
+		reduction_ke_spectrum = false;
+
+		columns.clear();
+
+		std::size_t last_pos = 0;
+		for (std::size_t pos = 0; pos <= i_reductions.size(); pos++)
+		{
+			if (pos < i_reductions.size() && i_reductions[pos] != ',')
+				continue;
+
+			std::string r = i_reductions.substr(last_pos, pos-last_pos);
+			last_pos = pos+1;
+
+			if (r == "")
+				continue;
+
+			if (r == "mass")
+			{
+				reduction_mass = true;
+				columns.push_back("total_mass");
+			}
+			else if (r == "energy")
+			{
+				reduction_energy = true;
+				columns.push_back("potential_energy");
+				columns.push_back("kinetic_energy");
+				columns.push_back("total_energy");
+			}
+			else if (r == "enstrophy")
+			{
+				reduction_enstrophy = true;
+				columns.push_back("total_potential_enstrophy");
+			}
+			else if (r == "minmax")
+			{
+				reduction_minmax = true;
+				const char *fields[] = {"phi", "u", "v", "vort"};
+				for (int i = 0; i < 4; i++)
+				{
+					columns.push_back(std::string(fields[i])+"_min");
+					columns.push_back(std::string(fields[i])+"_max");
+				}
+			}
+			else if (r == "errors")
+			{
+				reduction_errors = true;
+				const char *fields[] = {"phi", "vort", "div"};
+				for (int i = 0; i < 3; i++)
+				{
+					columns.push_back(std::string("error_linf_")+fields[i]);
+					columns.push_back(std::string("error_rms_")+fields[i]);
+				}
+			}
+			else if (r == "ke_spectrum")
+			{
+				reduction_ke_spectrum = true;
+				for (int n = 0; n <= sphereDataConfig->spectral_modes_n_max; n++)
+					columns.push_back("ke_n"+std::to_string(n));
+			}
+			else
+			{
+				FatalError("SphereHelpers_InSituDiagnostics: Unknown reduction '"+r+"'");
+			}
+		}
+
+		/*
+		 * Setup quadrature
+		 */
+		gauss_weights.resize(sphereDataConfig->physical_num_lat);
+
+		int n = shtns_gauss_wts(sphereDataConfig->shtns, gauss_weights.data());
+		if (n*2 != sphereDataConfig->physical_num_lat)
+			FatalError("Wrong number of Gaussian quadrature points given!");
+
+		for (int i = 0; i < sphereDataConfig->physical_num_lat/2; i++)
+			gauss_weights[sphereDataConfig->physical_num_lat-i-1] = gauss_weights[i];
+
+		coriolis.resize(sphereDataConfig->physical_num_lat);
+		for (int jlat = 0; jlat < sphereDataConfig->physical_num_lat; jlat++)
+			coriolis[jlat] = sphereDataConfig->lat_gaussian[jlat]*2.0*simVars->sim.sphere_rotating_coriolis_omega;
+
+		/*
+		 * Open time series file
+		 */
+		if (file.is_open())
+			file.close();
+
+		bool write_header = true;
+		if (i_append)
+		{
+			std::ifstream test(i_filename);
+			write_header = !test.good() || test.peek() == std::ifstream::traits_type::eof();
+			file.open(i_filename, std::ios_base::app);
+		}
+		else
+		{
+			file.open(i_filename, std::ios_base::trunc);
+		}
+
+		if (!file.is_open())
+			FatalError("SphereHelpers_InSituDiagnostics: Error while opening file '"+i_filename+"'");
+
+		int precision = simVars->iodata.output_floating_point_precision > 0 ? simVars->iodata.output_floating_point_precision : 16;
+		file << std::setprecision(precision);
+
+		if (write_header)
+		{
+			file << "#SWEET_SPHERE_INSITU_DIAGNOSTICS" << std::endl;
+			file << "#TI " << simVars->benchmark.benchmark_name << std::endl;
+			file << "time";
+			for (std::size_t i = 0; i < columns.size(); i++)
+				file << "\t" << columns[i];
+			file << std::endl;
+		}
+
+		values.resize(columns.size());
+	}
+
+
+
+	/**
+	 * Set reference solution for error norms
+	 */
+	void setReference(
+			const SphereData_Spectral &i_phi,
+			const SphereData_Spectral &i_vort,
+			const SphereData_Spectral &i_div
+	)
+	{
+		SphereData_Physical phi = i_phi.getSphereDataPhysical();
+		SphereData_Physical vort = i_vort.getSphereDataPhysical();
+		SphereData_Physical div = i_div.getSphereDataPhysical();
+
+		std::size_t N = sphereDataConfig->physical_array_data_number_of_elements;
+		ref_phi.assign(phi.physical_space_data, phi.physical_space_data+N);
+		ref_vort.assign(vort.physical_space_data, vort.physical_space_data+N);
+		ref_div.assign(div.physical_space_data, div.physical_space_data+N);
+	}
+
+
+
+	/**
+	 * Return values of last call to compute() in the order of getColumns()
+	 */
+	const std::vector<double>& getValues()	const
+	{
+		return values;
+	}
+
+	const std::vector<std::string>& getColumns()	const
+	{
+		return columns;
+	}
+
+
+
+	/**
+	 * Compute all registered reductions and append them to the time series
+	 */
+	void compute(
+			const SphereData_Spectral &i_phi,
+			const SphereData_Spectral &i_vort,
+			const SphereData_Spectral &i_div,
+			double i_time
+	)
+	{
+		if (!file.is_open())
+			return;
+
+		if (reduction_errors && ref_phi.size() == 0)
+			FatalError("SphereHelpers_InSituDiagnostics: No reference solution set for error norms");
+
+		bool need_uv = reduction_energy || reduction_minmax;
+		bool need_vort = reduction_enstrophy || reduction_minmax || reduction_errors;
+		bool need_div = reduction_errors;
+		bool need_grid = reduction_mass || reduction_energy || need_vort;
+
+		/*
+		 * One transformation for each required field
+		 */
+		SphereData_Physical phi(sphereDataConfig);
+		SphereData_Physical u(sphereDataConfig);
+		SphereData_Physical v(sphereDataConfig);
+		SphereData_Physical vort(sphereDataConfig);
+		SphereData_Physical div(sphereDataConfig);
+
+		if (need_grid)
+			phi = i_phi.getSphereDataPhysical();
+
+		if (need_uv)
+			op->vortdiv_to_uv(i_vort, i_div, u, v);
+
+		if (need_vort)
+			vort = i_vort.getSphereDataPhysical();
+
+		if (need_div)
+			div = i_div.getSphereDataPhysical();
+
+		/*
+		 * Fused reductions over physical grid
+		 */
+		double inv_g = 1.0/simVars->sim.gravitation;
+
+		double mass = 0, pot_energy = 0, kin_energy = 0, enstrophy = 0;
+		double phi_min = std::numeric_limits<double>::infinity(), phi_max = -std::numeric_limits<double>::infinity();
+		double u_min = phi_min, u_max = phi_max;
+		double v_min = phi_min, v_max = phi_max;
+		double vort_min = phi_min, vort_max = phi_max;
+		double err_linf_phi = 0, err_linf_vort = 0, err_linf_div = 0;
+		double err_l2_phi = 0, err_l2_vort = 0, err_l2_div = 0;
+
+		if (need_grid)
+		{
+			int num_lon = sphereDataConfig->physical_num_lon;
+
+#if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
+#error "TODO"
+#else
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for PROC_BIND_CLOSE reduction(+:mass,pot_energy,kin_energy,enstrophy,err_l2_phi,err_l2_vort,err_l2_div) reduction(min:phi_min,u_min,v_min,vort_min) reduction(max:phi_max,u_max,v_max,vort_max,err_linf_phi,err_linf_vort,err_linf_div)
+#endif
+			for (int jlat = 0; jlat < sphereDataConfig->physical_num_lat; jlat++)
+			{
+				double w = gauss_weights[jlat];
+				double f = coriolis[jlat];
+
+				for (int ilon = 0; ilon < num_lon; ilon++)
+				{
+					std::size_t idx = jlat*num_lon + ilon;
+
+					double h = phi.physical_space_data[idx]*inv_g;
+
+					if (reduction_mass)
+						mass += h*w;
+
+					if (reduction_energy)
+					{
+						double uu = u.physical_space_data[idx];
+						double vv = v.physical_space_data[idx];
+
+						pot_energy += 0.5*h*h*w;
+						kin_energy += 0.5*h*(uu*uu+vv*vv)*w;
+					}
+
+					if (reduction_enstrophy)
+					{
+						double eta = vort.physical_space_data[idx] + f;
+						enstrophy += 0.5*eta*eta/h*w;
+					}
+
+					if (reduction_minmax)
+					{
+						phi_min = std::min(phi_min, phi.physical_space_data[idx]);
+						phi_max = std::max(phi_max, phi.physical_space_data[idx]);
+						u_min = std::min(u_min, u.physical_space_data[idx]);
+						u_max = std::max(u_max, u.physical_space_data[idx]);
+						v_min = std::min(v_min, v.physical_space_data[idx]);
+						v_max = std::max(v_max, v.physical_space_data[idx]);
+						vort_min = std::min(vort_min, vort.physical_space_data[idx]);
+						vort_max = std::max(vort_max, vort.physical_space_data[idx]);
+					}
+
+					if (reduction_errors)
+					{
+						double e_phi = phi.physical_space_data[idx] - ref_phi[idx];
+						double e_vort = vort.physical_space_data[idx] - ref_vort[idx];
+						double e_div = div.physical_space_data[idx] - ref_div[idx];
+
+						err_linf_phi = std::max(err_linf_phi, std::abs(e_phi));
+						err_linf_vort = std::max(err_linf_vort, std::abs(e_vort));
+						err_linf_div = std::max(err_linf_div, std::abs(e_div));
+
+						err_l2_phi += e_phi*e_phi*w;
+						err_l2_vort += e_vort*e_vort*w;
+						err_l2_div += e_div*e_div*w;
+					}
+				}
+			}
+#endif
+		}
+
+		/*
+		 * Same scaling as SphereHelpers_Diagnostics::compute_zylinder_integral()
+		 */
+		double r = simVars->sim.sphere_radius;
+		double integral_scale = 2.0*M_PI/(double)sphereDataConfig->physical_num_lon;
+		double normalization = r*r;
+
+		// Integrating 1 with this scaling yields 4*pi (area of the unit sphere)
+		double rms_scale = integral_scale/(4.0*M_PI);
+
+		std::size_t c = 0;
+
+		if (reduction_mass)
+			values[c++] = mass*integral_scale*normalization;
+
+		if (reduction_energy)
+		{
+			values[c++] = pot_energy*integral_scale*normalization;
+			values[c++] = kin_energy*integral_scale*normalization;
+			values[c++] = (pot_energy + kin_energy)*integral_scale*normalization;
+		}
+
+		if (reduction_enstrophy)
+			values[c++] = enstrophy*integral_scale*normalization;
+
+		if (reduction_minmax)
+		{
+			values[c++] = phi_min;		values[c++] = phi_max;
+			values[c++] = u_min;		values[c++] = u_max;
+			values[c++] = v_min;		values[c++] = v_max;
+			values[c++] = vort_min;		values[c++] = vort_max;
+		}
+
+		if (reduction_errors)
+		{
+			values[c++] = err_linf_phi;		values[c++] = std::sqrt(err_l2_phi*rms_scale);
+			values[c++] = err_linf_vort;	values[c++] = std::sqrt(err_l2_vort*rms_scale);
+			values[c++] = err_linf_div;		values[c++] = std::sqrt(err_l2_div*rms_scale);
+		}
+
+		if (reduction_ke_spectrum)
+		{
+			/*
+			 * Kinetic energy (without layer depth) for each total wavenumber n
+			 *
+			 * With orthonormal spherical harmonics and psi_n = -r^2/(n(n+1)) vort_n (chi accordingly):
+			 *   KE_n = 0.5 * r^4/(n(n+1)) * sum_m c_m (|vort_nm|^2 + |div_nm|^2)
+			 * with c_0 = 1 and c_m = 2 for m > 0 (coefficients of negative m are not stored)
+			 */
+			int n_max = sphereDataConfig->spectral_modes_n_max;
+			double *ke = &values[c];
+
+			for (int n = 0; n <= n_max; n++)
+				ke[n] = 0;
+
+			for (int m = 0; m <= sphereDataConfig->spectral_modes_m_max; m++)
+			{
+				double cm = (m == 0 ? 1.0 : 2.0);
+
+				std::size_t idx = sphereDataConfig->getArrayIndexByModes(m, m);
+				for (int n = m; n <= n_max; n++)
+				{
+					ke[n] += cm*(std::norm(i_vort.spectral_space_data[idx]) + std::norm(i_div.spectral_space_data[idx]));
+					idx++;
+				}
+			}
+
+			ke[0] = 0;
+			for (int n = 1; n <= n_max; n++)
+				ke[n] *= 0.5*r*r*r*r/(double)(n*(n+1));
+
+			c += n_max+1;
+		}
+
+		/*
+		 * Append to time series
+		 */
+		file << i_time;
+		for (std::size_t i = 0; i < values.size(); i++)
+			file << "\t" << values[i];
+		file << "\n";
+	}
+
+
+
+	/**
+	 * Write buffered data to disk
+	 */
+	void flush()
+	{
+		if (file.is_open())
+			file.flush();
+	}
+
+
+
+	void close()
+	{
+		if (file.is_open())
+			file.close();
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_SPHERE_SPHEREHELPERS_INSITUDIAGNOSTICS_HPP_ */
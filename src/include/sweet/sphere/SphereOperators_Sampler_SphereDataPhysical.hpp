@@ -11,6 +11,8 @@
 #include <sweet/sphere/SphereData_Config.hpp>
 #include <sweet/sphere/SphereData_Physical.hpp>
 #include <sweet/ScalarDataArray.hpp>
+#include <sweet/SimulationProfiler.hpp>
+#include <sweet/KernelCounters.hpp>
 
 
 /**
@@ -380,6 +382,8 @@ public:
 			bool i_velocity_sampling
 	)
 	{
+		SWEET_PROFILER_REGION("sl_interpolation");
+
 		assert(res[0] > 0);
 		assert(i_pos_x.number_of_elements == i_pos_y.number_of_elements);
 
@@ -388,6 +392,16 @@ public:
 		int num_lon = sphereDataConfig->physical_num_lon;
 		int num_lat = sphereDataConfig->physical_num_lat;
 
+		/*
+		 * 5 cubic interpolations (~19 FLOPs each) and position computations per point.
+		 * Compulsory traffic: positions and output per point and the sampled field once.
+		 */
+		SWEET_KERNEL_COUNTER_REGION(
+				"sphere_bicubic",
+				100.0*i_pos_x.number_of_elements,
+				3.0*sizeof(double)*i_pos_x.number_of_elements + sizeof(double)*(double)num_lon*num_lat
+			);
+
 		double s_lon = (double)i_data.sphereDataConfig->physical_num_lon / (2.0*M_PI);
 
 		double L = -(-M_PI*0.5 - M_PI/ext_lat_M*1.5);
@@ -654,6 +668,8 @@ public:
 			bool i_velocity_sampling	///< swap sign for velocities
 	)
 	{
+		SWEET_PROFILER_REGION("sl_interpolation");
+
 		assert(res[0] > 0);
 		assert(i_pos_x.number_of_elements == i_pos_y.number_of_elements);
 
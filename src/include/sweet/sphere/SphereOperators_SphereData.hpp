@@ -10,6 +10,8 @@
 
 #include <sweet/MemBlockAlloc.hpp>
 #include <sweet/sphere/SphereData_Spectral.hpp>
+#include <sweet/sphere/SphereData_DerivedCache.hpp>
+#include <sweet/SimulationProfiler.hpp>
 #include <sweet/sphere/app_swe/SWESphBandedMatrixPhysicalReal.hpp>
 #include <sweet/sphere/SphereHelpers_SPHIdentities.hpp>
 
@@ -143,6 +145,40 @@ public:
 
 	)	const
 	{
+		SphereData_DerivedCache &cache = SphereData_DerivedCache::getInstance();
+		bool use_cache = cache.isActive();
+
+		if (use_cache)
+		{
+			if (cache.lookup(sphereDataConfig, SphereData_DerivedCache::OP_ROBERT_VORTDIV_TO_UV, i_vrt.version, i_div.version, o_u, &o_v))
+			{
+#if SWEET_DEBUG
+				SphereData_Physical u(sphereDataConfig), v(sphereDataConfig);
+				p_robert_vortdiv_to_uv(i_vrt, i_div, u, v);
+				SphereData_DerivedCache::validate(o_u, u);
+				SphereData_DerivedCache::validate(o_v, v);
+#endif
+				return;
+			}
+		}
+
+		p_robert_vortdiv_to_uv(i_vrt, i_div, o_u, o_v);
+
+		if (use_cache)
+			cache.insert(sphereDataConfig, SphereData_DerivedCache::OP_ROBERT_VORTDIV_TO_UV, i_vrt.version, i_div.version, o_u, &o_v);
+	}
+
+
+private:
+	void p_robert_vortdiv_to_uv(
+			const SphereData_Spectral &i_vrt,
+			const SphereData_Spectral &i_div,
+			SphereData_Physical &o_u,
+			SphereData_Physical &o_v
+	)	const
+	{
+		SWEET_PROFILER_REGION("sht_vector_backward");
+
 		SphereData_Spectral psi = inv_laplace(i_vrt)*ir;
 		SphereData_Spectral chi = inv_laplace(i_div)*ir;
 
@@ -156,6 +192,9 @@ public:
 	}
 
 
+public:
+
+
 	/**
 	 * Convert vorticity/divergence field to u,v velocity field
 	 */
@@ -167,6 +206,8 @@ public:
 
 	)	const
 	{
+		SWEET_PROFILER_REGION("sht_vector_backward");
+
 		double ir = 1.0/i_radius;
 
 		SphereData_Spectral psi(sphereDataConfig);
@@ -200,42 +241,69 @@ public:
 
 	)	const
 	{
+		SphereData_DerivedCache &cache = SphereData_DerivedCache::getInstance();
+		bool use_cache = cache.isActive();
+
+		if (use_cache)
+		{
+			if (cache.lookup(sphereDataConfig, SphereData_DerivedCache::OP_VORTDIV_TO_UV, i_vrt.version, i_div.version, o_u, &o_v))
+			{
+#if SWEET_DEBUG
+				SphereData_Physical u(sphereDataConfig), v(sphereDataConfig);
+				p_vortdiv_to_uv(i_vrt, i_div, u, v);
+				SphereData_DerivedCache::validate(o_u, u);
+				SphereData_DerivedCache::validate(o_v, v);
+#endif
+				return;
+			}
+		}
+
+		p_vortdiv_to_uv(i_vrt, i_div, o_u, o_v);
+
+		if (use_cache)
+			cache.insert(sphereDataConfig, SphereData_DerivedCache::OP_VORTDIV_TO_UV, i_vrt.version, i_div.version, o_u, &o_v);
+	}
+
+
+private:
+	void p_vortdiv_to_uv(
+			const SphereData_Spectral &i_vrt,
+			const SphereData_Spectral &i_div,
+			SphereData_Physical &o_u,
+			SphereData_Physical &o_v
+	)	const
+	{
+		SWEET_PROFILER_REGION("sht_vector_backward");
+
 		SphereData_Spectral psi = inv_laplace(i_vrt)*ir;
 		SphereData_Spectral chi = inv_laplace(i_div)*ir;
 
-		#if SWEET_DEBUG
-			#if SWEET_THREADING_SPACE || SWEET_THREADING_TIME_REXI
-				if (omp_in_parallel())
-					FatalError("IN PARALLEL REGION!!!");
-			#endif
-		#endif
-
-		shtns_robert_form(sphereDataConfig->shtns, 0);
 		SHsphtor_to_spat(
-				sphereDataConfig->shtns,
+				sphereDataConfig->shtns_nonrobert,
 				psi.spectral_space_data,
 				chi.spectral_space_data,
 				o_u.physical_space_data,
 				o_v.physical_space_data
 		);
-		shtns_robert_form(sphereDataConfig->shtns, 1);
 	}
 
 
 
+public:
 	SphereData_Spectral robert_uv_to_vort(
 			const SphereData_Physical &i_u,
 			const SphereData_Physical &i_v
 
 	)	const
 	{
+		SWEET_PROFILER_REGION("sht_vector_forward");
+
 		SphereData_Spectral tmp(sphereDataConfig);
 		SphereData_Spectral vort(sphereDataConfig);
 
 		SphereData_Physical ug = i_u;
 		SphereData_Physical vg = i_v;
 
-		shtns_robert_form(sphereDataConfig->shtns, 1);
 		spat_to_SHsphtor(
 				sphereDataConfig->shtns,
 				ug.physical_space_data,
@@ -255,25 +323,18 @@ public:
 
 	)	const
 	{
+		SWEET_PROFILER_REGION("sht_vector_forward");
+
 		SphereData_Spectral tmp(sphereDataConfig);
 		SphereData_Spectral vort(sphereDataConfig);
 
-		#if SWEET_DEBUG
-			#if SWEET_THREADING_SPACE || SWEET_THREADING_TIME_REXI
-				if (omp_in_parallel())
-					FatalError("IN PARALLEL REGION!!!");
-			#endif
-		#endif
-
-		shtns_robert_form(sphereDataConfig->shtns, 0);
 		spat_to_SHsphtor(
-				sphereDataConfig->shtns,
+				sphereDataConfig->shtns_nonrobert,
 				i_u.physical_space_data,
 				i_v.physical_space_data,
 				vort.spectral_space_data,
 				tmp.spectral_space_data
 		);
-		shtns_robert_form(sphereDataConfig->shtns, 1);
 
 		return laplace(vort)*r;
 	}
@@ -288,6 +349,8 @@ public:
 
 	)	const
 	{
+		SWEET_PROFILER_REGION("sht_vector_forward");
+
 		SphereData_Physical ug = i_u;
 		SphereData_Physical vg = i_v;
 
@@ -314,23 +377,15 @@ public:
 
 	)	const
 	{
+		SWEET_PROFILER_REGION("sht_vector_forward");
 
-		#if SWEET_DEBUG
-			#if SWEET_THREADING_SPACE || SWEET_THREADING_TIME_REXI
-				if (omp_in_parallel())
-					FatalError("IN PARALLEL REGION!!!");
-			#endif
-		#endif
-
-		shtns_robert_form(sphereDataConfig->shtns, 0);
 		spat_to_SHsphtor(
-				sphereDataConfig->shtns,
+				sphereDataConfig->shtns_nonrobert,
 				i_u.physical_space_data,
 				i_v.physical_space_data,
 				o_stream.spectral_space_data,
 				o_potential.spectral_space_data
 		);
-		shtns_robert_form(sphereDataConfig->shtns, 1);
 
 		o_stream = laplace(o_stream)*r;
 		o_potential = laplace(o_potential)*r;
@@ -462,10 +517,10 @@ public:
 	{
 		SphereData_Spectral out_sph_data(i_sph_data);
 
-		out_sph_data.spectral_update_lambda(
-				[&](int n, int m, std::complex<double> &o_data)
+		out_sph_data.spectral_update_lambda_n(
+				[&](int n) -> double
 				{
-					o_data *= -(double)n*((double)n+1.0)*ir*ir;
+					return -(double)n*((double)n+1.0)*ir*ir;
 				}
 			);
 
@@ -483,13 +538,13 @@ public:
 	{
 		SphereData_Spectral out(i_sph_data);
 
-		out.spectral_update_lambda(
-				[&](int n, int m, std::complex<double> &o_data)
+		out.spectral_update_lambda_n(
+				[&](int n) -> double
 				{
 					if (n != 0)
-						o_data /= -(double)n*((double)n+1.0)*ir*ir;
-					else
-						o_data = 0;
+						return 1.0/(-(double)n*((double)n+1.0)*ir*ir);
+
+					return 0;
 				}
 			);
 
@@ -669,15 +669,13 @@ public:
 		SphereData_PhysicalComplex ug = i_u;
 		SphereData_PhysicalComplex vg = i_v;
 
-		shtns_robert_form(sphereDataConfig->shtns, 0);
 		spat_cplx_to_SHsphtor(
-				sphereDataConfig->shtns,
+				sphereDataConfig->shtns_nonrobert,
 				ug.physical_space_data,
 				vg.physical_space_data,
 				o_vort.spectral_space_data,
 				o_div.spectral_space_data
 		);
-		shtns_robert_form(sphereDataConfig->shtns, 1);
 		o_vort.spectral_space_data_valid = true;
 		o_vort.physical_space_data_valid = false;
 		o_div.spectral_space_data_valid = true;
@@ -0,0 +1,109 @@
+/*
+ * SphereOperators_SphereDataDistributed.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SPHERE_SPHEREOPERATORS_SPHEREDATADISTRIBUTED_HPP_
+#define SRC_INCLUDE_SWEET_SPHERE_SPHEREOPERATORS_SPHEREDATADISTRIBUTED_HPP_
+
+#include <sweet/sphere/SphereData_ConfigDistributed.hpp>
+#include <sweet/sphere/SphereData_SpectralDistributed.hpp>
+
+
+
+/**
+ * Spectral operators for distributed sphere data
+ *
+ * Same as the corresponding operators in SphereOperators_SphereData,
+ * but they work on the local zonal wavenumbers.
+ * None of the operators requires communication.
+ */
+class SphereOperators_SphereDataDistributed
+{
+public:
+	const SphereData_ConfigDistributed *sphereDataConfig;
+
+	double r;
+	double ir;
+
+
+public:
+	SphereOperators_SphereDataDistributed()	:
+		sphereDataConfig(nullptr),
+		r(-1),
+		ir(-1)
+	{
+	}
+
+
+	SphereOperators_SphereDataDistributed(
+			const SphereData_ConfigDistributed *i_sphereDataConfig,
+			double i_earth_radius
+	)
+	{
+		setup(i_sphereDataConfig, i_earth_radius);
+	}
+
+
+	void setup(
+			const SphereData_ConfigDistributed *i_sphereDataConfig,
+			double i_earth_radius
+	)
+	{
+		sphereDataConfig = i_sphereDataConfig;
+
+		r = i_earth_radius;
+		ir = 1.0/r;
+	}
+
+
+
+	/**
+	 * Laplace operator
+	 */
+	SphereData_SpectralDistributed laplace(
+			const SphereData_SpectralDistributed &i_sph_data
+	)	const
+	{
+		SphereData_SpectralDistributed out(i_sph_data);
+
+		out.spectral_update_lambda_n(
+				[&](int n) -> double
+				{
+					return -(double)n*((double)n+1.0)*ir*ir;
+				}
+			);
+
+		return out;
+	}
+
+
+
+	/**
+	 * Inverse Laplace operator, the mean (n=0) is set to zero
+	 */
+	SphereData_SpectralDistributed inv_laplace(
+			const SphereData_SpectralDistributed &i_sph_data
+	)	const
+	{
+		SphereData_SpectralDistributed out(i_sph_data);
+
+		out.spectral_update_lambda_n(
+				[&](int n) -> double
+				{
+					if (n != 0)
+						return 1.0/(-(double)n*((double)n+1.0)*ir*ir);
+
+					return 0;
+				}
+			);
+
+		return out;
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_SPHERE_SPHEREOPERATORS_SPHEREDATADISTRIBUTED_HPP_ */
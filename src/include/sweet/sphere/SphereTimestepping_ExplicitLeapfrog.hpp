@@ -77,6 +77,40 @@ public:
 
 
 
+	/**
+	 * Store data of previous time step to checkpoint
+	 */
+	void checkpoint_write(
+			SWEETCheckpoint &io_checkpoint,
+			const std::string &i_prefix
+	)	const
+	{
+		io_checkpoint.addScalar(i_prefix+"timestep_id", timestep_id);
+
+		RK_h_prev.checkpoint_write(io_checkpoint, i_prefix+"h_prev");
+		RK_u_prev.checkpoint_write(io_checkpoint, i_prefix+"u_prev");
+		RK_v_prev.checkpoint_write(io_checkpoint, i_prefix+"v_prev");
+	}
+
+
+
+	/**
+	 * Load data of previous time step from checkpoint
+	 */
+	void checkpoint_read(
+			const SWEETCheckpoint &i_checkpoint,
+			const std::string &i_prefix
+	)
+	{
+		timestep_id = i_checkpoint.getScalar(i_prefix+"timestep_id");
+
+		RK_h_prev.checkpoint_read(i_checkpoint, i_prefix+"h_prev");
+		RK_u_prev.checkpoint_read(i_checkpoint, i_prefix+"u_prev");
+		RK_v_prev.checkpoint_read(i_checkpoint, i_prefix+"v_prev");
+	}
+
+
+
 	/**
 	 * Execute a Runge-Kutta timestep with the order
 	 * specified in the simulation variables.
@@ -1,76 +1,342 @@
-
 #ifndef SPHEREDATA_TIMESTEPPING_EXPLICITRK_HPP__
 #define SPHEREDATA_TIMESTEPPING_EXPLICITRK_HPP__
 
 #include <sweet/sphere/SphereData_Spectral.hpp>
+#include <sweet/sphere/SphereData_SpectralDistributed.hpp>
+#include <sweet/TimesteppingExplicitRKTableau.hpp>
+#include <sweet/SimulationProfiler.hpp>
+#include <cmath>
 #include <limits>
-
-class SphereTimestepping_ExplicitRK
+#include <vector>
+
+
+/**
+ * Explicit Runge-Kutta time stepping
+ *
+ * This is written for arbitrary spectral sphere data types (SphereData_Spectral,
+ * SphereData_SpectralDistributed) which provide spectral_set_linear_combination()
+ * and spectral_reduce_max_abs(). See the typedefs below.
+ */
+template <typename T_SphereData, typename T_SphereDataConfig>
+class SphereTimestepping_ExplicitRK_Generic
 {
-	// Runge-Kutta data storages
-	std::vector<SphereData_Spectral*> RK_h_t;
-	std::vector<SphereData_Spectral*> RK_u_t;
-	std::vector<SphereData_Spectral*> RK_v_t;
+	/// Max. number of prognostic variables
+	static const int MAX_VARS = 3;
+
+	/*
+	 * Runge-Kutta data storages for each variable
+	 *
+	 * Classical methods:
+	 *   RK_buffers[v][0..num_stages-1]: Stage time tendencies k_i
+	 *   RK_buffers[v][num_stages]: Input of current stage
+	 *
+	 * Low-storage methods:
+	 *   RK_buffers[v][0]: Accumulated update dU
+	 *   RK_buffers[v][1]: Time tendency F
+	 */
+	std::vector<T_SphereData*> RK_buffers[MAX_VARS];
 
-	int runge_kutta_order;
+	TimesteppingExplicitRKTableau tableau;
+
+	/// Use 2N-storage methods
+	bool use_low_storage;
 
 public:
-	SphereTimestepping_ExplicitRK()	:
-		runge_kutta_order(-1)
+	SphereTimestepping_ExplicitRK_Generic()	:
+		use_low_storage(false)
+	{
+	}
+
+
+
+	/**
+	 * Use low-storage (2N) Runge-Kutta methods which only require
+	 * two buffers per variable independent of the number of stages
+	 */
+	void setLowStorage(
+			bool i_use_low_storage
+	)
 	{
+		use_low_storage = i_use_low_storage;
 	}
 
 
 
 	void resetAndSetup(
-			const SphereData_Config *i_sphereDataConfig,
-			int i_rk_order			///< Order of Runge-Kutta method
+			const T_SphereDataConfig *i_sphereDataConfig,
+			int i_rk_order,			///< Order of Runge-Kutta method
+			bool i_embedded = false	///< Use embedded Runge-Kutta pair
+	)
+	{
+		if (RK_buffers[0].size() != 0)	///< already allocated?
+		{
+			if (	tableau.order == i_rk_order &&
+					tableau.embedded == i_embedded &&
+					tableau.low_storage == (use_low_storage && !i_embedded)
+			)
+				return;
+
+			free();
+		}
+
+		if (i_embedded)
+		{
+			tableau.setupEmbedded(i_rk_order);
+		}
+		else
+		{
+			if (i_rk_order <= 0 || i_rk_order > 4)
+				FatalError("Invalid order for RK time stepping");
+
+			tableau.setup(i_rk_order, use_low_storage);
+		}
+
+		int N = tableau.getNumBuffers();
+		for (int v = 0; v < MAX_VARS; v++)
+		{
+			RK_buffers[v].resize(N);
+
+			for (int i = 0; i < N; i++)
+				RK_buffers[v][i] = new T_SphereData(i_sphereDataConfig);
+		}
+	}
+
+
+
+private:
+	void free()
+	{
+		for (int v = 0; v < MAX_VARS; v++)
+		{
+			for (std::size_t i = 0; i < RK_buffers[v].size(); i++)
+				delete RK_buffers[v][i];
+
+			RK_buffers[v].resize(0);
+		}
+	}
+
+
+public:
+	~SphereTimestepping_ExplicitRK_Generic()
+	{
+		free();
+	}
+
+
+
+private:
+	/**
+	 * Generic Runge-Kutta time step for i_num_vars variables
+	 *
+	 * i_eval(i_U, o_F, t) computes the time tendencies o_F of the
+	 * prognostic variables i_U (both given as arrays of pointers).
+	 */
+	template <typename T_Eval>
+	void p_run_timestep(
+			int i_num_vars,
+			T_SphereData **io_U,
+			T_Eval i_eval,
+			double i_dt,
+			double i_simulation_time
 	)
 	{
-		if (RK_h_t.size() != 0)	///< already allocated?
+		const T_SphereData *U_stage[MAX_VARS];
+		T_SphereData *F[MAX_VARS];
+
+		if (tableau.low_storage)
+		{
+			for (int v = 0; v < i_num_vars; v++)
+			{
+				U_stage[v] = io_U[v];
+				F[v] = RK_buffers[v][1];
+			}
+
+			for (int i = 0; i < tableau.num_stages; i++)
+			{
+				SWEET_PROFILER_REGION("rk_stage");
+
+				i_eval(U_stage, F, i_simulation_time + tableau.c[i]*i_dt);
+
+				for (int v = 0; v < i_num_vars; v++)
+				{
+					T_SphereData &dU = *RK_buffers[v][0];
+
+					// dU = A[i]*dU + dt*F (dU is not initialized in the first stage)
+					if (tableau.A[i] == 0)
+					{
+						dU.spectral_set_linear_combination(i_dt, *F[v], 0, nullptr, nullptr);
+					}
+					else
+					{
+						const T_SphereData *y[1] = {F[v]};
+						double alpha[1] = {i_dt};
+						dU.spectral_set_linear_combination(tableau.A[i], dU, 1, alpha, y);
+					}
+
+					// U = U + B[i]*dU
+					const T_SphereData *y2[1] = {&dU};
+					double alpha2[1] = {tableau.B[i]};
+					io_U[v]->spectral_set_linear_combination(1.0, *io_U[v], 1, alpha2, y2);
+				}
+			}
 			return;
+		}
+
+		p_compute_stages(i_num_vars, io_U, i_eval, i_dt, i_simulation_time);
+		p_update_solution(i_num_vars, io_U, i_dt);
+	}
+
 
-		runge_kutta_order = i_rk_order;
-		int N = runge_kutta_order;
 
-		if (N <= 0 || N > 4)
-			FatalError("Invalid order for RK time stepping");
+	/**
+	 * Compute the time tendencies k_i of all stages of the Butcher tableau
+	 */
+	template <typename T_Eval>
+	void p_compute_stages(
+			int i_num_vars,
+			T_SphereData **io_U,
+			T_Eval i_eval,
+			double i_dt,
+			double i_simulation_time
+	)
+	{
+		const T_SphereData *U_stage[MAX_VARS];
+		T_SphereData *F[MAX_VARS];
 
-		RK_h_t.resize(N);
-		RK_u_t.resize(N);
-		RK_v_t.resize(N);
+		const T_SphereData *y[TimesteppingExplicitRKTableau::MAX_STAGES];
+		double alpha[TimesteppingExplicitRKTableau::MAX_STAGES];
 
-		for (int i = 0; i < N; i++)
+		for (int i = 0; i < tableau.num_stages; i++)
 		{
-			RK_h_t[i] = new SphereData_Spectral(i_sphereDataConfig);
-			RK_u_t[i] = new SphereData_Spectral(i_sphereDataConfig);
-			RK_v_t[i] = new SphereData_Spectral(i_sphereDataConfig);
+			SWEET_PROFILER_REGION("rk_stage");
+
+			for (int v = 0; v < i_num_vars; v++)
+			{
+				F[v] = RK_buffers[v][i];
+
+				if (i == 0)
+				{
+					U_stage[v] = io_U[v];
+					continue;
+				}
+
+				// Stage input U + dt*sum_j a_ij*k_j, skipping zero coefficients
+				int n = 0;
+				for (int j = 0; j < i; j++)
+				{
+					if (tableau.get_a(i, j) == 0)
+						continue;
+
+					y[n] = RK_buffers[v][j];
+					alpha[n] = i_dt*tableau.get_a(i, j);
+					n++;
+				}
+
+				T_SphereData *stage = RK_buffers[v][tableau.num_stages];
+				stage->spectral_set_linear_combination(1.0, *io_U[v], n, alpha, y);
+				U_stage[v] = stage;
+			}
+
+			i_eval(U_stage, F, i_simulation_time + tableau.c[i]*i_dt);
 		}
 	}
 
 
 
-	~SphereTimestepping_ExplicitRK()
+	/**
+	 * U = U + dt*sum_j b_j*k_j
+	 */
+	void p_update_solution(
+			int i_num_vars,
+			T_SphereData **io_U,
+			double i_dt
+	)
 	{
-		int N = runge_kutta_order;
+		const T_SphereData *y[TimesteppingExplicitRKTableau::MAX_STAGES];
+		double alpha[TimesteppingExplicitRKTableau::MAX_STAGES];
 
-		if (RK_h_t.size() != 0)
+		for (int v = 0; v < i_num_vars; v++)
 		{
-			for (int i = 0; i < N; i++)
+			int n = 0;
+			for (int j = 0; j < tableau.num_stages; j++)
+			{
+				if (tableau.b[j] == 0)
+					continue;
+
+				y[n] = RK_buffers[v][j];
+				alpha[n] = i_dt*tableau.b[j];
+				n++;
+			}
+
+			io_U[v]->spectral_set_linear_combination(1.0, *io_U[v], n, alpha, y);
+		}
+	}
+
+
+
+	/**
+	 * Runge-Kutta time step with an embedded error estimate
+	 *
+	 * The local error is estimated for each variable relative to
+	 * i_atol + i_rtol*max|U| (using the max. norm over all spectral
+	 * coefficients) and the maximum over all variables is returned.
+	 *
+	 * The variables are only updated if the error is <= 1.
+	 */
+	template <typename T_Eval>
+	double p_run_timestep_embedded(
+			int i_num_vars,
+			T_SphereData **io_U,
+			T_Eval i_eval,
+			double i_dt,
+			double i_simulation_time,
+			double i_atol,
+			double i_rtol
+	)
+	{
+		p_compute_stages(i_num_vars, io_U, i_eval, i_dt, i_simulation_time);
+
+		const T_SphereData *y[TimesteppingExplicitRKTableau::MAX_STAGES];
+		double alpha[TimesteppingExplicitRKTableau::MAX_STAGES];
+
+		/*
+		 * Error estimate dt*sum_j (b_j - b_embedded_j)*k_j
+		 */
+		double error = 0;
+		for (int v = 0; v < i_num_vars; v++)
+		{
+			int n = 0;
+			for (int j = 0; j < tableau.num_stages; j++)
 			{
-				delete RK_h_t[i];
-				delete RK_u_t[i];
-				delete RK_v_t[i];
+				double d = tableau.b[j] - tableau.b_embedded[j];
+				if (d == 0)
+					continue;
+
+				y[n] = RK_buffers[v][j];
+				alpha[n] = i_dt*d;
+				n++;
 			}
 
-			RK_h_t.resize(0);
-			RK_u_t.resize(0);
-			RK_v_t.resize(0);
+			T_SphereData &err = *RK_buffers[v][tableau.num_stages];
+			err.spectral_set_linear_combination(0.0, *io_U[v], n, alpha, y);
+
+			double scale = i_atol + i_rtol*io_U[v]->spectral_reduce_max_abs();
+			double e = err.spectral_reduce_max_abs()/scale;
+
+			// Also propagate NaN
+			if (e > error || std::isnan(e))
+				error = e;
 		}
+
+		if (error <= 1.0)
+			p_update_solution(i_num_vars, io_U, i_dt);
+
+		return error;
 	}
 
 
 
+public:
 	/**
 	 * Execute a Runge-Kutta timestep with the order
 	 * specified in the simulation variables.
@@ -79,20 +345,20 @@ public:
 	void run_timestep(
 			BaseClass *i_baseClass,
 			void (BaseClass::*i_compute_euler_timestep_update)(
-					const SphereData_Spectral &i_P,	///< prognostic variables
-					const SphereData_Spectral &i_u,	///< prognostic variables
-					const SphereData_Spectral &i_v,	///< prognostic variables
+					const T_SphereData &i_P,	///< prognostic variables
+					const T_SphereData &i_u,	///< prognostic variables
+					const T_SphereData &i_v,	///< prognostic variables
 
-					SphereData_Spectral &o_P_t,		///< time updates
-					SphereData_Spectral &o_u_t,		///< time updates
-					SphereData_Spectral &o_v_t,		///< time updates
+					T_SphereData &o_P_t,		///< time updates
+					T_SphereData &o_u_t,		///< time updates
+					T_SphereData &o_v_t,		///< time updates
 
 					double i_simulation_time	///< simulation time, e.g. for tidal waves
 			),
 
-			SphereData_Spectral &io_h,
-			SphereData_Spectral &io_u,
-			SphereData_Spectral &io_v,
+			T_SphereData &io_h,
+			T_SphereData &io_u,
+			T_SphereData &io_v,
 
 			double i_dt,	///< If this value is not equal to 0,
 					///< Use this time step size instead of computing one
@@ -106,195 +372,84 @@ public:
 	{
 		resetAndSetup(io_h.sphereDataConfig, i_runge_kutta_order);
 
-		if (i_runge_kutta_order == 1)
-		{
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,	// input
-					io_u,
-					io_v,
-					*RK_h_t[0],	// output
-					*RK_u_t[0],
-					*RK_v_t[0],
-					i_simulation_time
-			);
-
-			io_h += i_dt**RK_h_t[0];
-			io_u += i_dt**RK_u_t[0];
-			io_v += i_dt**RK_v_t[0];
-		}
-		else if (i_runge_kutta_order == 2)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/2 | 1/2
-			 * --------------
-			 *     | 0   1    b
-			 */
-			double a2[1] = {0.5};
-			double b[2] = {0.0, 1.0};
-			double c[1] = {0.5};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,
-					io_u,
-					io_v,
-					*RK_h_t[0],
-					*RK_u_t[0],
-					*RK_v_t[0],
-					i_simulation_time
+		T_SphereData *U[3] = {&io_h, &io_u, &io_v};
+
+		p_run_timestep(
+				3, U,
+				[&](const T_SphereData * const *i_U, T_SphereData * const *o_F, double i_time)
+				{
+					(i_baseClass->*i_compute_euler_timestep_update)(
+							*i_U[0], *i_U[1], *i_U[2],
+							*o_F[0], *o_F[1], *o_F[2],
+							i_time
+					);
+				},
+				i_dt,
+				i_simulation_time
 			);
+	}
 
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h + ( i_dt*a2[0]*(*RK_h_t[0]) ),
-					io_u + ( i_dt*a2[0]*(*RK_u_t[0]) ),
-					io_v + ( i_dt*a2[0]*(*RK_v_t[0]) ),
-					*RK_h_t[1],
-					*RK_u_t[1],
-					*RK_v_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
 
-			io_h += i_dt*(/* b[0]*(*RK_h_t[0]) +*/ b[1]*(*RK_h_t[1]) );
-			io_u += i_dt*(/* b[0]*(*RK_u_t[0]) +*/ b[1]*(*RK_u_t[1]) );
-			io_v += i_dt*(/* b[0]*(*RK_v_t[0]) +*/ b[1]*(*RK_v_t[1]) );
-		}
-		else if (i_runge_kutta_order == 3)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/3 | 1/3
-			 * 2/3 | 0    2/3
-			 * --------------
-			 *     | 1/4  0   3/4
-			 */
-			double a2[1] = {1.0/3.0};
-			double a3[2] = {0.0, 2.0/3.0};
-			double b[3] = {1.0/4.0, 0.0, 3.0/4.0};
-			double c[2] = {1.0/3.0, 2.0/3.0};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,
-					io_u,
-					io_v,
-					*RK_h_t[0],
-					*RK_u_t[0],
-					*RK_v_t[0],
-					i_simulation_time
-			);
 
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( a2[0]*(*RK_h_t[0]) ),
-					io_u	+ i_dt*( a2[0]*(*RK_u_t[0]) ),
-					io_v	+ i_dt*( a2[0]*(*RK_v_t[0]) ),
-					*RK_h_t[1],
-					*RK_u_t[1],
-					*RK_v_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
 
-			// STAGE 3
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( a3[0]*(*RK_h_t[0]) + a3[1]*(*RK_h_t[1]) ),
-					io_u	+ i_dt*( a3[0]*(*RK_u_t[0]) + a3[1]*(*RK_u_t[1]) ),
-					io_v	+ i_dt*( a3[0]*(*RK_v_t[0]) + a3[1]*(*RK_v_t[1]) ),
-					*RK_h_t[2],
-					*RK_u_t[2],
-					*RK_v_t[2],
-					i_simulation_time + c[1]*i_dt
-			);
+	/**
+	 * Execute a time step with an embedded Runge-Kutta pair
+	 * (see TimesteppingExplicitRKTableau::setupEmbedded).
+	 *
+	 * The prognostic variables are only updated if the time step is
+	 * accepted, i.e. if the scaled error estimate is <= 1.
+	 *
+	 * \return scaled error estimate
+	 */
+	template <class BaseClass>
+	double run_timestep_embedded(
+			BaseClass *i_baseClass,
+			void (BaseClass::*i_compute_euler_timestep_update)(
+					const T_SphereData &i_P,	///< prognostic variables
+					const T_SphereData &i_u,	///< prognostic variables
+					const T_SphereData &i_v,	///< prognostic variables
 
-			io_h += i_dt*( (b[0]*(*RK_h_t[0])) + (b[1]*(*RK_h_t[1]))  + (b[2]*(*RK_h_t[2])) );
-			io_u += i_dt*( (b[0]*(*RK_u_t[0])) + (b[1]*(*RK_u_t[1]))  + (b[2]*(*RK_u_t[2])) );
-			io_v += i_dt*( (b[0]*(*RK_v_t[0])) + (b[1]*(*RK_v_t[1]))  + (b[2]*(*RK_v_t[2])) );
-		}
-		else if (i_runge_kutta_order == 4)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/2 | 1/2
-			 * 1/2 | 0    1/2
-			 * 1   | 0    0    1
-			 * --------------
-			 *     | 1/6  1/3  1/3  1/6
-			 */
-			double a2[1] = {0.5};
-			double a3[2] = {0.0, 0.5};
-			double a4[3] = {0.0, 0.0, 1.0};
-			double b[4] = {1.0/6.0, 1.0/3.0, 1.0/3.0, 1.0/6.0};
-			double c[3] = {0.5, 0.5, 1.0};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,
-					io_u,
-					io_v,
-					*RK_h_t[0],
-					*RK_u_t[0],
-					*RK_v_t[0],
-					i_simulation_time
-			);
+					T_SphereData &o_P_t,		///< time updates
+					T_SphereData &o_u_t,		///< time updates
+					T_SphereData &o_v_t,		///< time updates
 
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( a2[0]*(*RK_h_t[0]) ),
-					io_u	+ i_dt*( a2[0]*(*RK_u_t[0]) ),
-					io_v	+ i_dt*( a2[0]*(*RK_v_t[0]) ),
-					*RK_h_t[1],
-					*RK_u_t[1],
-					*RK_v_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
+					double i_simulation_time	///< simulation time, e.g. for tidal waves
+			),
 
-			// STAGE 3
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( /*a3[0]*(*RK_P_t[0]) +*/ a3[1]*(*RK_h_t[1]) ),
-					io_u	+ i_dt*( /*a3[0]*(*RK_u_t[0]) +*/ a3[1]*(*RK_u_t[1]) ),
-					io_v	+ i_dt*( /*a3[0]*(*RK_v_t[0]) +*/ a3[1]*(*RK_v_t[1]) ),
-					*RK_h_t[2],
-					*RK_u_t[2],
-					*RK_v_t[2],
-					i_simulation_time + c[1]*i_dt
-			);
+			T_SphereData &io_h,
+			T_SphereData &io_u,
+			T_SphereData &io_v,
 
-			// STAGE 4
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( /*a4[0]*(*RK_P_t[0]) + a4[1]*(*RK_P_t[1]) +*/ a4[2]*(*RK_h_t[2]) ),
-					io_u	+ i_dt*( /*a4[0]*(*RK_u_t[0]) + a4[1]*(*RK_u_t[1]) +*/ a4[2]*(*RK_u_t[2]) ),
-					io_v	+ i_dt*( /*a4[0]*(*RK_v_t[0]) + a4[1]*(*RK_v_t[1]) +*/ a4[2]*(*RK_v_t[2]) ),
-					*RK_h_t[3],
-					*RK_u_t[3],
-					*RK_v_t[3],
-					i_simulation_time + c[2]*i_dt
+			double i_dt,				///< Time step size to try
+			int i_runge_kutta_order,	///< Order of embedded RK pair
+			double i_simulation_time,	///< Current simulation time
+			double i_atol,				///< Absolute error tolerance
+			double i_rtol				///< Relative error tolerance
+	)
+	{
+		resetAndSetup(io_h.sphereDataConfig, i_runge_kutta_order, true);
+
+		T_SphereData *U[3] = {&io_h, &io_u, &io_v};
+
+		return p_run_timestep_embedded(
+				3, U,
+				[&](const T_SphereData * const *i_U, T_SphereData * const *o_F, double i_time)
+				{
+					(i_baseClass->*i_compute_euler_timestep_update)(
+							*i_U[0], *i_U[1], *i_U[2],
+							*o_F[0], *o_F[1], *o_F[2],
+							i_time
+					);
+				},
+				i_dt,
+				i_simulation_time,
+				i_atol,
+				i_rtol
 			);
-
-
-			io_h += i_dt*( (b[0]*(*RK_h_t[0])) + (b[1]*(*RK_h_t[1]))  + (b[2]*(*RK_h_t[2])) + (b[3]*(*RK_h_t[3])) );
-			io_u += i_dt*( (b[0]*(*RK_u_t[0])) + (b[1]*(*RK_u_t[1]))  + (b[2]*(*RK_u_t[2])) + (b[3]*(*RK_u_t[3])) );
-			io_v += i_dt*( (b[0]*(*RK_v_t[0])) + (b[1]*(*RK_v_t[1]))  + (b[2]*(*RK_v_t[2])) + (b[3]*(*RK_v_t[3])) );
-		}
-		else
-		{
-			std::cerr << "This order of the Runge-Kutta time stepping is not supported!" << std::endl;
-			exit(-1);
-		}
 	}
 
 
 
-
 	/**
 	 * execute a Runge-Kutta timestep with the order
 	 * specified in the simulation variables.
@@ -304,17 +459,17 @@ public:
 	void run_timestep(
 			BaseClass *i_baseClass,
 			void (BaseClass::*i_compute_euler_timestep_update)(
-					const SphereData_Spectral &i_u,	///< prognostic variables
-					const SphereData_Spectral &i_v,	///< prognostic variables
+					const T_SphereData &i_u,	///< prognostic variables
+					const T_SphereData &i_v,	///< prognostic variables
 
-					SphereData_Spectral &o_u_t,	///< time updates
-					SphereData_Spectral &o_v_t,	///< time updates
+					T_SphereData &o_u_t,	///< time updates
+					T_SphereData &o_v_t,	///< time updates
 
 					double i_simulation_time	///< simulation time, e.g. for tidal waves
 			),
 
-			SphereData_Spectral &io_u,
-			SphereData_Spectral &io_v,
+			T_SphereData &io_u,
+			T_SphereData &io_v,
 
 			double i_dt = 0,	///< If this value is not equal to 0,
 						///< Use this time step size instead of computing one
@@ -326,166 +481,23 @@ public:
 											///< This gets e.g. important for tidal waves
 	)
 	{
-		if (i_runge_kutta_order == 1)
-		{
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_u,	// input
-					io_v,
-					*RK_u_t[0],	// output
-					*RK_v_t[0],
-					i_simulation_time
-			);
-
-			io_u += i_dt**RK_u_t[0];
-			io_v += i_dt**RK_v_t[0];
-
-		}
-		else if (i_runge_kutta_order == 2)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/2 | 1/2
-			 * --------------
-			 *     | 0   1    b
-			 */
-			double a2[1] = {0.5};
-			double b[2] = {0.0, 1.0};
-			double c[1] = {0.5};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_u,
-					io_v,
-					*RK_u_t[0],
-					*RK_v_t[0],
-					i_simulation_time
-			);
-
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_u + ( i_dt*a2[0]*(*RK_u_t[0]) ),
-					io_v + ( i_dt*a2[0]*(*RK_v_t[0]) ),
-					*RK_u_t[1],
-					*RK_v_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
-
-			io_u += i_dt*(/* b[0]*(*RK_u_t[0]) +*/ b[1]*(*RK_u_t[1]) );
-			io_v += i_dt*(/* b[0]*(*RK_v_t[0]) +*/ b[1]*(*RK_v_t[1]) );
-		}
-		else if (i_runge_kutta_order == 3)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/3 | 1/3
-			 * 2/3 | 0    2/3
-			 * --------------
-			 *     | 1/4  0   3/4
-			 */
-			double a2[1] = {1.0/3.0};
-			double a3[2] = {0.0, 2.0/3.0};
-			double b[3] = {1.0/4.0, 0.0, 3.0/4.0};
-			double c[2] = {1.0/3.0, 2.0/3.0};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_u,
-					io_v,
-					*RK_u_t[0],
-					*RK_v_t[0],
-					i_simulation_time
-			);
-
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_u	+ i_dt*( a2[0]*(*RK_u_t[0]) ),
-					io_v	+ i_dt*( a2[0]*(*RK_v_t[0]) ),
-					*RK_u_t[1],
-					*RK_v_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
-
-			// STAGE 3
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_u	+ i_dt*( a3[0]*(*RK_u_t[0]) + a3[1]*(*RK_u_t[1]) ),
-					io_v	+ i_dt*( a3[0]*(*RK_v_t[0]) + a3[1]*(*RK_v_t[1]) ),
-					*RK_u_t[2],
-					*RK_v_t[2],
-					i_simulation_time + c[1]*i_dt
-			);
-
-			io_u += i_dt*( (b[0]*(*RK_u_t[0])) + (b[1]*(*RK_u_t[1]))  + (b[2]*(*RK_u_t[2])) );
-			io_v += i_dt*( (b[0]*(*RK_v_t[0])) + (b[1]*(*RK_v_t[1]))  + (b[2]*(*RK_v_t[2])) );
-		}
-		else if (i_runge_kutta_order == 4)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/2 | 1/2
-			 * 1/2 | 0    1/2
-			 * 1   | 0    0    1
-			 * --------------
-			 *     | 1/6  1/3  1/3  1/6
-			 */
-			double a2[1] = {0.5};
-			double a3[2] = {0.0, 0.5};
-			double a4[3] = {0.0, 0.0, 1.0};
-			double b[4] = {1.0/6.0, 1.0/3.0, 1.0/3.0, 1.0/6.0};
-			double c[3] = {0.5, 0.5, 1.0};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_u,
-					io_v,
-					*RK_u_t[0],
-					*RK_v_t[0],
-					i_simulation_time
-			);
-
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_u	+ i_dt*( a2[0]*(*RK_u_t[0]) ),
-					io_v	+ i_dt*( a2[0]*(*RK_v_t[0]) ),
-					*RK_u_t[1],
-					*RK_v_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
-
-			// STAGE 3
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_u	+ i_dt*( /*a3[0]*(*RK_u_t[0]) +*/ a3[1]*(*RK_u_t[1]) ),
-					io_v	+ i_dt*( /*a3[0]*(*RK_v_t[0]) +*/ a3[1]*(*RK_v_t[1]) ),
-					*RK_u_t[2],
-					*RK_v_t[2],
-					i_simulation_time + c[1]*i_dt
+		resetAndSetup(io_u.sphereDataConfig, i_runge_kutta_order);
+
+		T_SphereData *U[2] = {&io_u, &io_v};
+
+		p_run_timestep(
+				2, U,
+				[&](const T_SphereData * const *i_U, T_SphereData * const *o_F, double i_time)
+				{
+					(i_baseClass->*i_compute_euler_timestep_update)(
+							*i_U[0], *i_U[1],
+							*o_F[0], *o_F[1],
+							i_time
+					);
+				},
+				i_dt,
+				i_simulation_time
 			);
-
-			// STAGE 4
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_u	+ i_dt*( /*a4[0]*(*RK_u_t[0]) + a4[1]*(*RK_u_t[1]) +*/ a4[2]*(*RK_u_t[2]) ),
-					io_v	+ i_dt*( /*a4[0]*(*RK_v_t[0]) + a4[1]*(*RK_v_t[1]) +*/ a4[2]*(*RK_v_t[2]) ),
-					*RK_u_t[3],
-					*RK_v_t[3],
-					i_simulation_time + c[2]*i_dt
-			);
-
-
-			io_u += i_dt*( (b[0]*(*RK_u_t[0])) + (b[1]*(*RK_u_t[1]))  + (b[2]*(*RK_u_t[2])) + (b[3]*(*RK_u_t[3])) );
-			io_v += i_dt*( (b[0]*(*RK_v_t[0])) + (b[1]*(*RK_v_t[1]))  + (b[2]*(*RK_v_t[2])) + (b[3]*(*RK_v_t[3])) );
-		}
-		else
-		{
-			FatalError("This order of the Runge-Kutta time stepping is not supported!");
-		}
 	}
 
 
@@ -498,13 +510,13 @@ public:
 	void run_timestep(
 			BaseClass *i_baseClass,
 			void (BaseClass::*i_compute_euler_timestep_update)(
-					const SphereData_Spectral &i_h,		///< prognostic variables
-					SphereData_Spectral &o_h_t,			///< time updates
+					const T_SphereData &i_h,		///< prognostic variables
+					T_SphereData &o_h_t,			///< time updates
 
 					double i_simulation_time	///< simulation time, e.g. for tidal waves
 			),
 
-			SphereData_Spectral &io_h,
+			T_SphereData &io_h,
 
 			double i_dt,		///< If this value is not equal to 0,
 											///< Use this time step size instead of computing one
@@ -516,161 +528,31 @@ public:
 											///< This gets e.g. important for tidal waves
 	)
 	{
-//		resetAndSetup(io_h, i_runge_kutta_order);
-
-		if (i_runge_kutta_order == 1)
-		{
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,	// input
-					*RK_h_t[0],	// output
-					i_dt,
-					i_simulation_time
-			);
-
-			io_h += i_dt**RK_h_t[0];
-
-		}
-		else if (i_runge_kutta_order == 2)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/2 | 1/2
-			 * --------------
-			 *     | 0   1    b
-			 */
-			double a2[1] = {0.5};
-			double b[2] = {0.0, 1.0};
-			double c[1] = {0.5};
-
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,
-					*RK_h_t[0],
-					i_dt,
-					i_simulation_time
-			);
-
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h + ( i_dt*a2[0]*(*RK_h_t[0]) ),
-					*RK_h_t[1],
-					i_dt,
-					i_simulation_time + c[0]*i_dt
-			);
-
-			io_h += i_dt*(/* b[0]*(*RK_h_t[0]) +*/ b[1]*(*RK_h_t[1]) );
-		}
-		else if (i_runge_kutta_order == 3)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/3 | 1/3
-			 * 2/3 | 0    2/3
-			 * --------------
-			 *     | 1/4  0   3/4
-			 */
-			double a2[1] = {1.0/3.0};
-			double a3[2] = {0.0, 2.0/3.0};
-			double b[3] = {1.0/4.0, 0.0, 3.0/4.0};
-			double c[2] = {1.0/3.0, 2.0/3.0};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,
-					*RK_h_t[0],
-					i_dt,
-					i_simulation_time
-			);
-
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( a2[0]*(*RK_h_t[0]) ),
-					*RK_h_t[1],
-					i_dt,
-					i_simulation_time + c[0]*i_dt
-			);
-
-			// STAGE 3
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( a3[0]*(*RK_h_t[0]) + a3[1]*(*RK_h_t[1]) ),
-					*RK_h_t[2],
-					i_dt,
-					i_simulation_time + c[1]*i_dt
-			);
-
-			io_h += i_dt*( (b[0]*(*RK_h_t[0])) + (b[1]*(*RK_h_t[1]))  + (b[2]*(*RK_h_t[2])) );
-		}
-		else if (i_runge_kutta_order == 4)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/2 | 1/2
-			 * 1/2 | 0    1/2
-			 * 1   | 0    0    1
-			 * --------------
-			 *     | 1/6  1/3  1/3  1/6
-			 */
-			double a2[1] = {0.5};
-			double a3[2] = {0.0, 0.5};
-			double a4[3] = {0.0, 0.0, 1.0};
-			double b[4] = {1.0/6.0, 1.0/3.0, 1.0/3.0, 1.0/6.0};
-			double c[3] = {0.5, 0.5, 1.0};
-
-			double dummy_dt;
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,
-					*RK_h_t[0],
-					i_dt,
-					i_simulation_time
-			);
-
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( a2[0]*(*RK_h_t[0]) ),
-					*RK_h_t[1],
-					i_dt,
-					i_simulation_time + c[0]*i_dt
-			);
+		resetAndSetup(io_h.sphereDataConfig, i_runge_kutta_order);
 
-			// STAGE 3
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( /*a3[0]*(*RK_P_t[0]) +*/ a3[1]*(*RK_h_t[1]) ),
-					*RK_h_t[2],
-					i_dt,
-					i_simulation_time + c[1]*i_dt
+		T_SphereData *U[1] = {&io_h};
+
+		p_run_timestep(
+				1, U,
+				[&](const T_SphereData * const *i_U, T_SphereData * const *o_F, double i_time)
+				{
+					(i_baseClass->*i_compute_euler_timestep_update)(
+							*i_U[0],
+							*o_F[0],
+							i_time
+					);
+				},
+				i_dt,
+				i_simulation_time
 			);
+	}
 
-			// STAGE 4
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( /*a4[0]*(*RK_P_t[0]) + a4[1]*(*RK_P_t[1]) +*/ a4[2]*(*RK_h_t[2]) ),
-					*RK_h_t[3],
-					i_dt,
-					i_simulation_time + c[2]*i_dt
-			);
 
+};
 
-			io_h += i_dt*( (b[0]*(*RK_h_t[0])) + (b[1]*(*RK_h_t[1]))  + (b[2]*(*RK_h_t[2])) + (b[3]*(*RK_h_t[3])) );
-		}
-		else
-		{
-			std::cerr << "This order of the Runge-Kutta time stepping is not supported!" << std::endl;
-			exit(-1);
-		}
-	}
 
+typedef SphereTimestepping_ExplicitRK_Generic<SphereData_Spectral, SphereData_Config> SphereTimestepping_ExplicitRK;
 
-};
+typedef SphereTimestepping_ExplicitRK_Generic<SphereData_SpectralDistributed, SphereData_ConfigDistributed> SphereDistributedTimestepping_ExplicitRK;
 
 #endif
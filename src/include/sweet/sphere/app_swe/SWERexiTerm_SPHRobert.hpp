@@ -9,7 +9,9 @@
 #define SRC_SWEREXI_SPHROBERT_HPP_
 
 #include <complex>
+#include <memory>
 #include <sweet/sphere/app_swe/SWESphBandedMatrixPhysicalComplex.hpp>
+#include <sweet/sphere/app_swe/SWESphImplicitOperatorCache.hpp>
 #include <sweet/sphere/Convert_SphereDataSpectral_to_SphereDataSpectralComplex.hpp>
 #include <sweet/sphere/Convert_SphereDataSpectralComplex_to_SphereDataSpectral.hpp>
 #include <sweet/sphere/SphereData_Config.hpp>
@@ -32,8 +34,8 @@ class SWERexiTerm_SPHRobert
 	/// SPH configuration
 	const SphereData_Config *sphereDataConfigSolver;
 
-	/// Solver for given alpha
-	SphBandedMatrixPhysicalComplex< std::complex<double> > sphSolverPhi;
+	/// Solver for given alpha (shared via SWESphImplicitOperatorCache)
+	std::shared_ptr< SphBandedMatrixPhysicalComplex< std::complex<double> > > sphSolverPhi;
 	SphBandedMatrixPhysicalComplex< std::complex<double> > sphSolverVel;
 
 	SphereOperators_SphereData op;
@@ -128,15 +130,33 @@ public:
 
 		if (!use_f_sphere)
 		{
-			sphSolverPhi.setup(sphereDataConfigSolver, 4);
-			sphSolverPhi.solver_component_rexi_z1(	(alpha*alpha)*(alpha*alpha), r);
-			sphSolverPhi.solver_component_rexi_z2(	2.0*two_coriolis_omega*two_coriolis_omega*alpha*alpha, r);
-			sphSolverPhi.solver_component_rexi_z3(	(two_coriolis_omega*two_coriolis_omega)*(two_coriolis_omega*two_coriolis_omega), r);
-			sphSolverPhi.solver_component_rexi_z4robert(	-gh*alpha*two_coriolis_omega, r);
-			sphSolverPhi.solver_component_rexi_z5robert(	gh/alpha*two_coriolis_omega*two_coriolis_omega*two_coriolis_omega, r);
-			sphSolverPhi.solver_component_rexi_z6robert(	gh*2.0*two_coriolis_omega*two_coriolis_omega, r);
-			sphSolverPhi.solver_component_rexi_z7(	-gh*alpha*alpha, r);
-			sphSolverPhi.solver_component_rexi_z8(	-gh*two_coriolis_omega*two_coriolis_omega, r);
+			typedef SphBandedMatrixPhysicalComplex< std::complex<double> > Matrix;
+			typedef SWESphImplicitOperatorCache<Matrix> Cache;
+
+			Cache::Key key = Cache::createKey(
+					sphereDataConfigSolver,
+					timestep_size,
+					(no_coriolis ? Cache::CORIOLIS_NONE : Cache::CORIOLIS_FULL),
+					alpha, beta, r, two_coriolis_omega, gh
+				);
+
+			sphSolverPhi = Cache::getInstance().get(
+					key,
+					[&](Matrix &o_solver)
+					{
+						o_solver.setup(sphereDataConfigSolver, 4);
+						o_solver.solver_component_rexi_z1(	(alpha*alpha)*(alpha*alpha), r);
+						o_solver.solver_component_rexi_z2(	2.0*two_coriolis_omega*two_coriolis_omega*alpha*alpha, r);
+						o_solver.solver_component_rexi_z3(	(two_coriolis_omega*two_coriolis_omega)*(two_coriolis_omega*two_coriolis_omega), r);
+						o_solver.solver_component_rexi_z4robert(	-gh*alpha*two_coriolis_omega, r);
+						o_solver.solver_component_rexi_z5robert(	gh/alpha*two_coriolis_omega*two_coriolis_omega*two_coriolis_omega, r);
+						o_solver.solver_component_rexi_z6robert(	gh*2.0*two_coriolis_omega*two_coriolis_omega, r);
+						o_solver.solver_component_rexi_z7(	-gh*alpha*alpha, r);
+						o_solver.solver_component_rexi_z8(	-gh*two_coriolis_omega*two_coriolis_omega, r);
+
+						o_solver.factorize();
+					}
+				);
 
 			mug.setup(sphereDataConfigSolver);
 			mug.physical_update_lambda_gaussian_grid(
@@ -218,7 +238,7 @@ public:
 			rhs = rhsg;
 
 
-			phi = sphSolverPhi.solve(rhs);
+			phi = sphSolverPhi->solve(rhs);
 
 			/*
 			 * Solve without inverting a matrix
@@ -258,9 +278,15 @@ public:
 
 		}
 
+#if SWEET_COMPLEX_SPLIT
+		o_phi = Convert_SphereDataSpectralComplex_To_SphereDataSpectral::spectral_convert_real_part(phi * beta);
+		o_vort = Convert_SphereDataSpectralComplex_To_SphereDataSpectral::spectral_convert_real_part(vort * beta);
+		o_div = Convert_SphereDataSpectralComplex_To_SphereDataSpectral::spectral_convert_real_part(div * beta);
+#else
 		o_phi = Convert_SphereDataSpectralComplex_To_SphereDataSpectral::physical_convert_real(phi * beta);
 		o_vort = Convert_SphereDataSpectralComplex_To_SphereDataSpectral::physical_convert_real(vort * beta);
 		o_div = Convert_SphereDataSpectralComplex_To_SphereDataSpectral::physical_convert_real(div * beta);
+#endif
 	}
 
 
@@ -8,10 +8,12 @@
 #ifndef SRC_INCLUDE_SPH_BANDED_MATRIX_COMPLEX_HPP_
 #define SRC_INCLUDE_SPH_BANDED_MATRIX_COMPLEX_HPP_
 
+#include <vector>
 #include <libmath/BandedMatrixPhysicalComplex.hpp>
 #include <libmath/LapackBandedMatrixSolver.hpp>
 #include <sweet/sphere/SphereData_SpectralComplex.hpp>
 #include <sweet/sphere/SphereHelpers_SPHIdentities.hpp>
+#include <sweet/KernelCounters.hpp>
 
 
 
@@ -48,6 +50,20 @@ public:
 	 */
 	std::complex<double> *buffer_in, *buffer_out;
 
+	/**
+	 * LU factorization of the blocks for each m (see factorize())
+	 */
+	std::vector< std::complex<double> > lu_data;
+	std::vector<int> lu_pivots;
+
+	/// Offsets of the blocks in lu_pivots (block sizes differ for each m)
+	std::vector<std::size_t> lu_block_offsets;
+	bool factorized;
+
+	/// Range [lu_m_start, lu_m_end) of |m| of the factorized blocks
+	int lu_m_start;
+	int lu_m_end;
+
 	/**
 	 * Setup the SPH solver
 	 */
@@ -58,6 +74,7 @@ public:
 	)
 	{
 		sphereDataConfig = i_sphereDataConfig;
+		factorized = false;
 
 		lhs.setup(sphereDataConfig, i_halosize_offdiagonal);
 
@@ -74,7 +91,10 @@ public:
 		sphereDataConfig(nullptr),
 		buffer_size(0),
 		buffer_in(nullptr),
-		buffer_out(nullptr)
+		buffer_out(nullptr),
+		factorized(false),
+		lu_m_start(0),
+		lu_m_end(0)
 	{
 	}
 
@@ -533,6 +553,123 @@ public:
 		return solve(tmp);
 	}
 
+	/**
+	 * Compute the LU factorization of the matrix.
+	 *
+	 * This has to be called after all solver components were added.
+	 * Afterwards, solve() only does the forward/backward substitution and
+	 * doesn't modify any member variables. Hence, it can be
+	 * called concurrently.
+	 *
+	 * Only the blocks for m and -m with m in [i_m_start, i_m_end) are
+	 * factorized, e.g. the local zonal wavenumbers of distributed sphere data.
+	 */
+	void factorize(
+			int i_m_start = 0,		///< first zonal wavenumber
+			int i_m_end = -1		///< last zonal wavenumber (exclusive), -1: all
+	)
+	{
+		if (i_m_end < 0)
+			i_m_end = sphereDataConfig->spectral_modes_m_max+1;
+
+		lu_m_start = i_m_start;
+		lu_m_end = i_m_end;
+
+		int max_N = sphereDataConfig->spectral_modes_n_max+1;
+		int LDAB = bandedMatrixSolver.LDAB;
+		int num_m = 2*sphereDataConfig->spectral_modes_m_max+1;
+
+		// Blocks which are not factorized have size 0
+		lu_block_offsets.resize(num_m+1);
+		lu_block_offsets[0] = 0;
+		for (int block_id = 0; block_id < num_m; block_id++)
+		{
+			int m = block_id-sphereDataConfig->spectral_modes_m_max;
+			lu_block_offsets[block_id+1] = lu_block_offsets[block_id] + (p_isFactorizedM(m) ? max_N-std::abs(m) : 0);
+		}
+
+		lu_data.resize(lu_block_offsets.back()*LDAB);
+		lu_pivots.resize(lu_block_offsets.back());
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (int m = -sphereDataConfig->spectral_modes_m_max; m <= sphereDataConfig->spectral_modes_m_max; m++)
+		{
+			if (!p_isFactorizedM(m))
+				continue;
+
+			int idx = sphereDataConfig->getArrayIndexByModes_Complex_NCompact(std::abs(m),m);
+			int block_id = m+sphereDataConfig->spectral_modes_m_max;
+
+			bandedMatrixSolver.factorize_Carray(
+							&lhs.data[idx*lhs.num_diagonals],
+							&lu_data[lu_block_offsets[block_id]*LDAB],
+							&lu_pivots[lu_block_offsets[block_id]],
+							max_N-std::abs(m)	// size of block
+					);
+		}
+
+		factorized = true;
+	}
+
+
+
+private:
+	bool p_isFactorizedM(
+			int m
+	)	const
+	{
+		return std::abs(m) >= lu_m_start && std::abs(m) < lu_m_end;
+	}
+
+
+
+public:
+	/**
+	 * Solve the block for a single m (which may be negative)
+	 *
+	 * Without factorization, this uses scratch buffers of the banded
+	 * solver and must not be called concurrently.
+	 */
+	void solve_m(
+			int m,
+			const std::complex<double> *i_rhs,	///< rhs modes (|m|,m) ... (n_max,m)
+			std::complex<double> *o_x			///< solution modes (|m|,m) ... (n_max,m)
+	)	const
+	{
+		int max_N = sphereDataConfig->spectral_modes_n_max+1;
+		int block_size = max_N-std::abs(m);
+
+		if (factorized)
+		{
+			if (!p_isFactorizedM(m))
+				FatalError("SphBandedMatrixPhysicalComplex: Block of this m is not factorized");
+
+			int LDAB = bandedMatrixSolver.LDAB;
+			int block_id = m+sphereDataConfig->spectral_modes_m_max;
+
+			std::copy(i_rhs, i_rhs+block_size, o_x);
+
+			bandedMatrixSolver.solve_factorized(
+							&lu_data[lu_block_offsets[block_id]*LDAB],
+							&lu_pivots[lu_block_offsets[block_id]],
+							o_x,
+							block_size
+					);
+			return;
+		}
+
+		int idx = sphereDataConfig->getArrayIndexByModes_Complex_NCompact(std::abs(m),m);
+
+		bandedMatrixSolver.solve_diagBandedInverse_Carray(
+						&lhs.data[idx*lhs.num_diagonals],
+						i_rhs,
+						o_x,
+						block_size
+				);
+	}
+
+
+
 	SphereData_SpectralComplex solve(
 			const SphereData_SpectralComplex &i_rhs
 	)
@@ -543,6 +680,54 @@ public:
 
 		i_rhs.request_data_spectral();
 
+		if (factorized && (lu_m_start != 0 || lu_m_end != sphereDataConfig->spectral_modes_m_max+1))
+			FatalError("SphBandedMatrixPhysicalComplex: Not all modes are factorized");
+
+		if (factorized)
+		{
+			int max_N = sphereDataConfig->spectral_modes_n_max+1;
+			int LDAB = bandedMatrixSolver.LDAB;
+
+			/*
+			 * Forward/backward substitution with KL=KU=h off-diagonals (U has 2h
+			 * off-diagonals after pivoting): 3h complex multiply-adds per unknown.
+			 * The LU factors, pivots and RHS/solution are loaded/stored once.
+			 */
+			SWEET_KERNEL_COUNTER_REGION(
+					"sph_banded_solve",
+					8.0*3.0*bandedMatrixSolver.num_halo_size_diagonals*sphereDataConfig->spectral_complex_array_data_number_of_elements,
+					(LDAB*sizeof(std::complex<double>) + 2*sizeof(std::complex<double>) + sizeof(int))*(double)sphereDataConfig->spectral_complex_array_data_number_of_elements
+				);
+
+			// Local buffer to allow concurrent solves with the same matrix
+			std::vector< std::complex<double> > buffer(max_N);
+
+			for (int m = -sphereDataConfig->spectral_modes_m_max; m <= sphereDataConfig->spectral_modes_m_max; m++)
+			{
+				int block_id = m+sphereDataConfig->spectral_modes_m_max;
+
+				int buffer_idx = 0;
+				for (int n = std::abs(m); n <= sphereDataConfig->spectral_modes_n_max; n++)
+					buffer[buffer_idx++] = i_rhs.spectral_space_data[sphereDataConfig->getArrayIndexByModes_Complex(n,m)];
+
+				bandedMatrixSolver.solve_factorized(
+								&lu_data[lu_block_offsets[block_id]*LDAB],
+								&lu_pivots[lu_block_offsets[block_id]],
+								buffer.data(),
+								max_N-std::abs(m)	// size of block
+						);
+
+				buffer_idx = 0;
+				for (int n = std::abs(m); n <= sphereDataConfig->spectral_modes_n_max; n++)
+					out.spectral_space_data[sphereDataConfig->getArrayIndexByModes_Complex(n,m)] = buffer[buffer_idx++];
+			}
+
+			out.physical_space_data_valid = false;
+			out.spectral_space_data_valid = true;
+
+			return out;
+		}
+
 
 		for (int m = -sphereDataConfig->spectral_modes_m_max; m <= sphereDataConfig->spectral_modes_m_max; m++)
 		{
@@ -8,9 +8,12 @@
 #ifndef SRC_INCLUDE_SPH_BANDED_MATRIX_REAL_HPP_
 #define SRC_INCLUDE_SPH_BANDED_MATRIX_REAL_HPP_
 
+#include <vector>
+#include <algorithm>
 #include <libmath/BandedMatrixPhysicalReal.hpp>
 #include <libmath/LapackBandedMatrixSolver.hpp>
 #include <sweet/sphere/SphereData_Spectral.hpp>
+#include <sweet/sphere/SphereData_SpectralDistributed.hpp>
 #include <sweet/sphere/SphereHelpers_SPHIdentities.hpp>
 
 
@@ -40,6 +43,20 @@ public:
 	 */
 	LapackBandedMatrixSolver< std::complex<double> > bandedMatrixSolver;
 
+	/**
+	 * LU factorization of the blocks for each m (see factorize())
+	 */
+	std::vector< std::complex<double> > lu_data;
+	std::vector<int> lu_pivots;
+
+	/// Offsets of the blocks in lu_pivots (block sizes differ for each m)
+	std::vector<std::size_t> lu_block_offsets;
+	bool factorized;
+
+	/// Range [lu_m_start, lu_m_end) of the factorized blocks
+	int lu_m_start;
+	int lu_m_end;
+
 	/**
 	 * Setup the SPH solver
 	 */
@@ -50,6 +67,7 @@ public:
 	)
 	{
 		sphereDataConfig = i_sphereConfig;
+		factorized = false;
 
 		lhs.setup(sphereDataConfig, i_halosize_offdiagonal);
 
@@ -58,7 +76,10 @@ public:
 
 
 	SphBandedMatrixPhysicalReal()	:
-		sphereDataConfig(nullptr)
+		sphereDataConfig(nullptr),
+		factorized(false),
+		lu_m_start(0),
+		lu_m_end(0)
 	{
 	}
 
@@ -477,22 +498,164 @@ public:
 	}
 
 
+	/**
+	 * Compute the LU factorization of the matrix.
+	 *
+	 * This has to be called after all solver components were added.
+	 * Afterwards, solve() only does the forward/backward substitution and
+	 * doesn't modify any member variables. Hence, it can be
+	 * called concurrently.
+	 *
+	 * Only the blocks for m in [i_m_start, i_m_end) are factorized,
+	 * e.g. the local modes of distributed sphere data.
+	 */
+	void factorize(
+			int i_m_start = 0,		///< first zonal wavenumber
+			int i_m_end = -1		///< last zonal wavenumber (exclusive), -1: all
+	)
+	{
+		if (i_m_end < 0)
+			i_m_end = sphereDataConfig->spectral_modes_m_max+1;
+
+		int max_N = sphereDataConfig->spectral_modes_n_max+1;
+		int LDAB = bandedMatrixSolver.LDAB;
+
+		lu_m_start = i_m_start;
+		lu_m_end = i_m_end;
+
+		lu_block_offsets.resize(lu_m_end-lu_m_start+1);
+		lu_block_offsets[0] = 0;
+		for (int m = lu_m_start; m < lu_m_end; m++)
+			lu_block_offsets[m-lu_m_start+1] = lu_block_offsets[m-lu_m_start] + (max_N-m);
+
+		lu_data.resize(lu_block_offsets.back()*LDAB);
+		lu_pivots.resize(lu_block_offsets.back());
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (int m = lu_m_start; m < lu_m_end; m++)
+		{
+			int idx = sphereDataConfig->getArrayIndexByModes(m,m);
+
+			bandedMatrixSolver.factorize_Carray(
+							&lhs.data[idx*lhs.num_diagonals],
+							&lu_data[lu_block_offsets[m-lu_m_start]*LDAB],
+							&lu_pivots[lu_block_offsets[m-lu_m_start]],
+							max_N-m	// size of block
+					);
+		}
+
+		factorized = true;
+	}
+
+
+
+	/**
+	 * Solve the block for a single m
+	 */
+	void solve_m(
+			int m,
+			const std::complex<double> *i_rhs,	///< rhs modes (m,m) ... (n_max,m)
+			std::complex<double> *o_x			///< solution modes (m,m) ... (n_max,m)
+	)	const
+	{
+		int max_N = sphereDataConfig->spectral_modes_n_max+1;
+
+		if (factorized)
+		{
+			assert(m >= lu_m_start && m < lu_m_end);
+
+			int LDAB = bandedMatrixSolver.LDAB;
+
+			std::copy(i_rhs, i_rhs+max_N-m, o_x);
+
+			bandedMatrixSolver.solve_factorized(
+							&lu_data[lu_block_offsets[m-lu_m_start]*LDAB],
+							&lu_pivots[lu_block_offsets[m-lu_m_start]],
+							o_x,
+							max_N-m	// size of block
+					);
+			return;
+		}
+
+		int idx = sphereDataConfig->getArrayIndexByModes(m,m);
+
+		bandedMatrixSolver.solve_diagBandedInverse_Carray(
+						&lhs.data[idx*lhs.num_diagonals],
+						i_rhs,
+						o_x,
+						max_N-m	// size of block
+				);
+	}
+
+
+
+	/**
+	 * Solve for the local modes of distributed sphere data
+	 *
+	 * If factorized, the factorization has to include the local modes.
+	 */
+	SphereData_SpectralDistributed solve(
+			const SphereData_SpectralDistributed &i_rhs
+	)	const
+	{
+		const SphereData_ConfigDistributed *config = i_rhs.sphereDataConfig;
+		SphereData_SpectralDistributed out(config);
+
+		int m_start = config->spectral_local_m_start;
+		int m_end = m_start + config->spectral_local_m_size;
+
+		if (factorized && (m_start < lu_m_start || m_end > lu_m_end))
+			FatalError("SphBandedMatrixPhysicalReal: Local modes are not factorized");
+
+		if (factorized)
+		{
+			SWEET_THREADING_SPACE_PARALLEL_FOR
+			for (int m = m_start; m < m_end; m++)
+			{
+				std::size_t idx = config->getLocalArrayIndexByModes(m, m);
+				solve_m(m, &i_rhs.spectral_space_data[idx], &out.spectral_space_data[idx]);
+			}
+
+			return out;
+		}
+
+		// The solver without factorization uses shared scratch buffers
+		for (int m = m_start; m < m_end; m++)
+		{
+			std::size_t idx = config->getLocalArrayIndexByModes(m, m);
+			solve_m(m, &i_rhs.spectral_space_data[idx], &out.spectral_space_data[idx]);
+		}
+
+		return out;
+	}
+
+
+
 	SphereData_Spectral solve(
 			const SphereData_Spectral &i_rhs
 	)	const
 	{
 		SphereData_Spectral out(sphereDataConfig);
 
+		if (factorized && (lu_m_start != 0 || lu_m_end != sphereDataConfig->spectral_modes_m_max+1))
+			FatalError("SphBandedMatrixPhysicalReal: Not all modes are factorized");
+
+		if (factorized)
+		{
+			SWEET_THREADING_SPACE_PARALLEL_FOR
+			for (int m = 0; m <= sphereDataConfig->spectral_modes_m_max; m++)
+			{
+				int idx = sphereDataConfig->getArrayIndexByModes(m,m);
+				solve_m(m, &i_rhs.spectral_space_data[idx], &out.spectral_space_data[idx]);
+			}
+
+			return out;
+		}
+
 		for (int m = 0; m <= sphereDataConfig->spectral_modes_m_max; m++)
 		{
 			int idx = sphereDataConfig->getArrayIndexByModes(m,m);
-
-			bandedMatrixSolver.solve_diagBandedInverse_Carray(
-							&lhs.data[idx*lhs.num_diagonals],
-							&i_rhs.spectral_space_data[idx],
-							&out.spectral_space_data[idx],
-							sphereDataConfig->spectral_modes_n_max+1-m	// size of block
-					);
+			solve_m(m, &i_rhs.spectral_space_data[idx], &out.spectral_space_data[idx]);
 		}
 
 		return out;
@@ -0,0 +1,228 @@
+/*
+ * SWESphImplicitOperatorCache.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SPHERE_APP_SWE_SWESPHIMPLICITOPERATORCACHE_HPP_
+#define SRC_INCLUDE_SWEET_SPHERE_APP_SWE_SWESPHIMPLICITOPERATORCACHE_HPP_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <complex>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <sweet/sphere/SphereData_Config.hpp>
+
+
+
+/**
+ * LRU cache of assembled and factorized implicit operators
+ * (SphBandedMatrixPhysicalReal / SphBandedMatrixPhysicalComplex)
+ *
+ * Time steppers which are called with varying time step sizes
+ * (e.g. for the different SDC nodes in PFASST) would otherwise
+ * rebuild their operators each time the time step size changes.
+ *
+ * There's one cache for each matrix type which is shared by
+ * all time steppers and REXI terms.
+ */
+template <typename T_Matrix>
+class SWESphImplicitOperatorCache
+{
+public:
+	/**
+	 * Key to identify an operator.
+	 *
+	 * All values are compared bitwise identical.
+	 */
+	struct Key
+	{
+		const SphereData_Config *sphereDataConfig;	///< level of discretization
+		int spectral_modes_n_max;
+		int spectral_modes_m_max;
+		double timestep_size;
+		int coriolis_mode;							///< see CORIOLIS_*
+		std::complex<double> alpha;					///< e.g. REXI alpha
+		std::complex<double> beta;					///< e.g. REXI beta
+		double sphere_radius;
+		double coriolis;							///< rotational speed or f0
+		double gh;									///< average geopotential
+
+		bool operator==(const Key &i_key)	const
+		{
+			return	sphereDataConfig == i_key.sphereDataConfig &&
+					spectral_modes_n_max == i_key.spectral_modes_n_max &&
+					spectral_modes_m_max == i_key.spectral_modes_m_max &&
+					timestep_size == i_key.timestep_size &&
+					coriolis_mode == i_key.coriolis_mode &&
+					alpha == i_key.alpha &&
+					beta == i_key.beta &&
+					sphere_radius == i_key.sphere_radius &&
+					coriolis == i_key.coriolis &&
+					gh == i_key.gh;
+		}
+	};
+
+	enum
+	{
+		CORIOLIS_NONE = 0,
+		CORIOLIS_FSPHERE = 1,
+		CORIOLIS_FULL = 2,
+	};
+
+
+private:
+	/// Entries with the most recently used one at the front
+	std::list< std::pair< Key, std::shared_ptr<T_Matrix> > > entries;
+
+	std::size_t max_size;
+
+	std::mutex mutex;
+
+public:
+	std::size_t hits;
+	std::size_t misses;
+
+
+private:
+	SWESphImplicitOperatorCache()	:
+		max_size(32),
+		hits(0),
+		misses(0)
+	{
+	}
+
+
+public:
+	static SWESphImplicitOperatorCache& getInstance()
+	{
+		static SWESphImplicitOperatorCache cache;
+		return cache;
+	}
+
+
+
+	static Key createKey(
+			const SphereData_Config *i_sphereDataConfig,
+			double i_timestep_size,
+			int i_coriolis_mode,
+			const std::complex<double> &i_alpha,
+			const std::complex<double> &i_beta,
+			double i_sphere_radius,
+			double i_coriolis,
+			double i_gh
+	)
+	{
+		Key key;
+		key.sphereDataConfig = i_sphereDataConfig;
+		key.spectral_modes_n_max = i_sphereDataConfig->spectral_modes_n_max;
+		key.spectral_modes_m_max = i_sphereDataConfig->spectral_modes_m_max;
+		key.timestep_size = i_timestep_size;
+		key.coriolis_mode = i_coriolis_mode;
+		key.alpha = i_alpha;
+		key.beta = i_beta;
+		key.sphere_radius = i_sphere_radius;
+		key.coriolis = i_coriolis;
+		key.gh = i_gh;
+		return key;
+	}
+
+
+
+	/**
+	 * Set max. number of cached operators (0 deactivates caching)
+	 */
+	void setMaxSize(
+			std::size_t i_max_size
+	)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		max_size = i_max_size;
+
+		while (entries.size() > max_size)
+			entries.pop_back();
+	}
+
+
+
+	/**
+	 * Return the operator for the given key.
+	 *
+	 * If it's not cached, a new operator is created with i_setup
+	 * (which has to assemble and factorize the operator).
+	 *
+	 * The setup is executed without holding the lock, hence operators
+	 * can be set up concurrently, e.g. by different REXI threads.
+	 */
+	std::shared_ptr<T_Matrix> get(
+			const Key &i_key,
+			const std::function<void(T_Matrix&)> &i_setup
+	)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			for (auto iter = entries.begin(); iter != entries.end(); iter++)
+			{
+				if (!(iter->first == i_key))
+					continue;
+
+				hits++;
+
+				// Move to front
+				entries.splice(entries.begin(), entries, iter);
+				return entries.front().second;
+			}
+
+			misses++;
+		}
+
+		std::shared_ptr<T_Matrix> op(new T_Matrix);
+		i_setup(*op);
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (max_size == 0)
+			return op;
+
+		entries.push_front(std::make_pair(i_key, op));
+
+		/*
+		 * Evicted operators are only freed once they are not used anymore
+		 */
+		while (entries.size() > max_size)
+			entries.pop_back();
+
+		return op;
+	}
+
+
+
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		entries.clear();
+	}
+
+
+
+	void output(
+			const std::string &i_prefix
+	)
+	{
+		if (hits == 0 && misses == 0)
+			return;
+
+		std::cout << "[MULE] " << i_prefix << ".hits: " << hits << std::endl;
+		std::cout << "[MULE] " << i_prefix << ".misses: " << misses << std::endl;
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_SPHERE_APP_SWE_SWESPHIMPLICITOPERATORCACHE_HPP_ */
@@ -0,0 +1,174 @@
+/*
+ * benchmark_output_compression.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ *
+ * Compare compression ratio, throughput and errors of the output
+ * compression codecs (see SWEETCompression) for the fields of the
+ * Galewsky benchmark (unstable jet with perturbation) and the
+ * unperturbed (balanced) jet.
+ *
+ * Example:
+ *   ./build/benchmark_output_compression_... -M 128
+ */
+
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/SWEETCompression.hpp>
+#include <sweet/Stopwatch.hpp>
+#include <sweet/sphere/SphereData_Config.hpp>
+#include <sweet/sphere/SphereData_Spectral.hpp>
+#include <sweet/sphere/SphereData_Physical.hpp>
+#include <sweet/sphere/SphereOperators_SphereData.hpp>
+#include <benchmarks_sphere/SWESphereBenchmarksCombined.hpp>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <algorithm>
+
+
+
+SimulationVariables simVars;
+
+
+/**
+ * Compress and decompress one field and output statistics
+ */
+void benchmark_field(
+		const std::string &i_name,
+		const double *i_data,
+		std::size_t i_num_values,
+		SWEETCompression::Codec i_codec,
+		double i_rel_tolerance
+)
+{
+	double max_abs = 0;
+	for (std::size_t i = 0; i < i_num_values; i++)
+		max_abs = std::max(max_abs, std::abs(i_data[i]));
+
+	double tol = i_rel_tolerance*max_abs;
+
+	std::vector<char> compressed;
+	std::vector<double> decompressed(i_num_values);
+
+	/*
+	 * Repeat to get reliable timings also for small resolutions
+	 */
+	int num_repetitions = 10;
+
+	Stopwatch stopwatch_compress;
+	Stopwatch stopwatch_decompress;
+
+	for (int r = 0; r < num_repetitions; r++)
+	{
+		stopwatch_compress.start();
+		SWEETCompression::compress(i_codec, tol, i_data, i_num_values, compressed);
+		stopwatch_compress.stop();
+
+		stopwatch_decompress.start();
+		SWEETCompression::decompress(i_codec, tol, compressed.data(), compressed.size(), decompressed.data(), i_num_values);
+		stopwatch_decompress.stop();
+	}
+
+	double max_error = 0;
+	for (std::size_t i = 0; i < i_num_values; i++)
+		max_error = std::max(max_error, std::abs(i_data[i] - decompressed[i]));
+
+	if (!SWEETCompression::isLossy(i_codec) && max_error != 0)
+		FatalError("Lossless compression is not lossless");
+
+	if (SWEETCompression::isLossy(i_codec) && max_error > tol*(1.0+1e-12))
+		FatalError("Error bound of lossy compression violated");
+
+	double size_mb = (double)(i_num_values*sizeof(double))/(1024.0*1024.0);
+
+	std::string prefix = "[MULE] compression." + i_name + ".codec" + std::to_string((int)i_codec);
+	if (SWEETCompression::isLossy(i_codec))
+	{
+		char buffer[64];
+		sprintf(buffer, ".reltol%g", i_rel_tolerance);
+		prefix += buffer;
+	}
+
+	std::cout << prefix << ".ratio: " << (double)(i_num_values*sizeof(double))/(double)compressed.size() << std::endl;
+	std::cout << prefix << ".compress_mb_per_sec: " << size_mb*num_repetitions/stopwatch_compress() << std::endl;
+	std::cout << prefix << ".decompress_mb_per_sec: " << size_mb*num_repetitions/stopwatch_decompress() << std::endl;
+	std::cout << prefix << ".max_error: " << max_error << std::endl;
+}
+
+
+
+void benchmark_codecs(
+		const std::string &i_name,
+		const double *i_data,
+		std::size_t i_num_values
+)
+{
+	benchmark_field(i_name, i_data, i_num_values, SWEETCompression::CODEC_NONE, 0);
+
+#if SWEET_ZLIB
+	benchmark_field(i_name, i_data, i_num_values, SWEETCompression::CODEC_SHUFFLE_DEFLATE, 0);
+#endif
+
+	double rel_tolerances[] = {1e-4, 1e-7, 1e-10};
+
+	for (double rel_tol : rel_tolerances)
+	{
+		benchmark_field(i_name, i_data, i_num_values, SWEETCompression::CODEC_QUANTIZE_VARINT, rel_tol);
+#if SWEET_ZLIB
+		benchmark_field(i_name, i_data, i_num_values, SWEETCompression::CODEC_QUANTIZE_VARINT_DEFLATE, rel_tol);
+#endif
+	}
+}
+
+
+
+int main(int i_argc, char *i_argv[])
+{
+	MemBlockAlloc::setup();
+
+	//input parameter names (specific ones for this program)
+	const char *bogus_var_names[] = {
+			nullptr
+	};
+
+	if (!simVars.setupFromMainParameters(i_argc, i_argv, bogus_var_names))
+		return -1;
+
+	SphereData_Config sphereDataConfig;
+	sphereDataConfig.setupAuto(simVars.disc.space_res_physical, simVars.disc.space_res_spectral, simVars.misc.reuse_spectral_transformation_plans);
+
+	const char *benchmark_names[] = {
+			"galewsky",				///< unstable jet with perturbation
+			"galewsky_nobump",		///< unperturbed jet
+			nullptr
+	};
+
+	for (int b = 0; benchmark_names[b] != nullptr; b++)
+	{
+		simVars.benchmark.benchmark_name = benchmark_names[b];
+
+		SphereOperators_SphereData op(&sphereDataConfig, simVars.sim.sphere_radius);
+
+		SphereData_Spectral phi(&sphereDataConfig);
+		SphereData_Spectral vort(&sphereDataConfig);
+		SphereData_Spectral div(&sphereDataConfig);
+
+		SWESphereBenchmarksCombined sphereBenchmarks;
+		sphereBenchmarks.setup(simVars, op);
+		sphereBenchmarks.setupInitialConditions(phi, vort, div);
+
+		SphereData_Physical phi_phys = phi.getSphereDataPhysical();
+		SphereData_Physical vort_phys = vort.getSphereDataPhysical();
+
+		std::string prefix = benchmark_names[b];
+
+		benchmark_codecs(prefix+".phi_physical", phi_phys.physical_space_data, sphereDataConfig.physical_array_data_number_of_elements);
+		benchmark_codecs(prefix+".vort_physical", vort_phys.physical_space_data, sphereDataConfig.physical_array_data_number_of_elements);
+
+		benchmark_codecs(prefix+".phi_spectral", (const double*)phi.spectral_space_data, 2*sphereDataConfig.spectral_array_data_number_of_elements);
+		benchmark_codecs(prefix+".vort_spectral", (const double*)vort.spectral_space_data, 2*sphereDataConfig.spectral_array_data_number_of_elements);
+	}
+
+	return 0;
+}
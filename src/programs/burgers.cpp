@@ -16,6 +16,7 @@
 
 #include <sweet/Stopwatch.hpp>
 #include <sweet/FatalError.hpp>
+#include <sweet/BackgroundOutputWriter.hpp>
 #include <ostream>
 #include <algorithm>
 #include <sstream>
@@ -110,6 +111,9 @@ public:
 	// Diagnostic measures at initial stage, Initialize with 0
 	double diagnostics_energy_start = 0;
 
+	// Asynchronous output of snapshots
+	BackgroundOutputWriter outputWriter;
+
 public:
 	SimulationInstance()	:
 		// Constructor to initialize the class - all variables in the SW are setup
@@ -274,6 +278,8 @@ public:
 			simVars
 		);
 
+		outputWriter.setup(simVars.iodata.output_async_queue_size);
+
 		update_diagnostics();
 		diagnostics_energy_start = simVars.diag.total_energy;
 
@@ -378,13 +384,73 @@ public:
 
 		const char* filename_template = simVars.iodata.output_file_name.c_str();
 		sprintf(buffer, filename_template, i_name, simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale);
-		i_planeData.file_physical_saveData_ascii(buffer, '\n', 12, 1);
+
+		/*
+		 * Create snapshot of data and write it with the background writer
+		 */
+		i_planeData.request_data_physical();
+
+		std::shared_ptr< std::vector<double> > staging = BackgroundOutputWriter::createStagingBuffer(
+				i_planeData.physical_space_data,
+				planeDataConfig->physical_array_data_number_of_elements
+			);
+
+		std::string filename = buffer;
+		const PlaneDataConfig *config = planeDataConfig;
+
+		outputWriter.enqueue(
+				[staging, filename, config]()
+				{
+					PlaneData::file_physical_saveData_ascii_data(config, staging->data(), filename.c_str(), '\n', 12, 1);
+				}
+			);
 
 		return buffer;
 	}
 
 
 
+	/**
+	 * Write amplitude and phase of the first row of spectral modes to file
+	 */
+	void write_file_amp_phase(
+			const PlaneData &i_planeData,
+			const char* i_name	///< name of output variable
+		)
+	{
+		char buffer[1024];
+
+		const char* filename_template = simVars.iodata.output_file_name.c_str();
+		sprintf(buffer, filename_template, i_name, simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale);
+
+		/*
+		 * Only the amplitudes and phases are stored in the snapshot
+		 */
+		std::size_t size = planeDataConfig->spectral_data_size[0];
+		std::shared_ptr< std::vector<double> > staging = std::make_shared< std::vector<double> >(2*size);
+
+		for (std::size_t x = 0; x < size; x++)
+		{
+			(*staging)[2*x+0] = i_planeData.spectral_return_amplitude(0,x);
+			(*staging)[2*x+1] = i_planeData.spectral_return_phase(0,x);
+		}
+
+		std::string filename = buffer;
+
+		outputWriter.enqueue(
+				[staging, filename, size]()
+				{
+					std::ofstream file(filename.c_str(), std::ios_base::trunc);
+					file << std::setprecision(12);
+
+					for (std::size_t x = 0; x < size; x++)
+						file << x << ", " << (*staging)[2*x+0] << ", " << (*staging)[2*x+1] << std::endl;
+				}
+			);
+	}
+
+
+
 	std::string output_filenames;
 
 public:
@@ -409,20 +475,7 @@ public:
 			output_filenames += write_file(tmp_u, "prog_u");
 			//write_file(tmp_v, "prog_v");
 
-			tmp_u.request_data_spectral();
-
-			char buffer[1024];
-			const char* filename_template = simVars.iodata.output_file_name.c_str();
-			sprintf(buffer,filename_template,"prog_u_amp_phase",simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale);
-
-			std::ofstream file(buffer, std::ios_base::trunc);
-			file << std::setprecision(12);
-
-			for (std::size_t x = 0; x < planeDataConfig->spectral_data_size[0]; x++)
-			{
-				file << x << ", " << tmp_u.spectral_return_amplitude(0,x) << ", " << tmp_u.spectral_return_phase(0,x) << std::endl;
-			}
-			file.close();
+			write_file_amp_phase(tmp_u, "prog_u_amp_phase");
 		}
 
 		if (simVars.misc.verbosity > 0)
@@ -435,19 +488,7 @@ public:
 
 				write_file(tmp, "analytical");
 
-				tmp.request_data_spectral();
-
-				char buffer[1024];
-				const char* filename_template = simVars.iodata.output_file_name.c_str();
-				sprintf(buffer,filename_template,"analytical_amp_phase",simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale);
-
-				std::ofstream file(buffer, std::ios_base::trunc);
-				file << std::setprecision(12);
-				for (std::size_t x = 0; x < planeDataConfig->spectral_data_size[0]; x++)
-				{
-					file << x << ", " << tmp.spectral_return_amplitude(0,x) << ", " << tmp.spectral_return_phase(0,x) << std::endl;
-				}
-				file.close();
+				write_file_amp_phase(tmp, "analytical_amp_phase");
 			}
 
 			std::stringstream header;
@@ -1233,6 +1274,42 @@ public:
 	}
 
 
+	/**
+	 * Store all Parareal data of this time slice to checkpoint
+	 */
+	void checkpoint_write(
+			SWEETCheckpoint &io_checkpoint,
+			const std::string &i_prefix
+	)
+	{
+		io_checkpoint.addScalar(i_prefix+"output_data_valid", output_data_valid);
+
+		parareal_data_start.checkpoint_write(io_checkpoint, i_prefix+"start");
+		parareal_data_fine.checkpoint_write(io_checkpoint, i_prefix+"fine");
+		parareal_data_coarse.checkpoint_write(io_checkpoint, i_prefix+"coarse");
+		parareal_data_output.checkpoint_write(io_checkpoint, i_prefix+"output");
+		parareal_data_error.checkpoint_write(io_checkpoint, i_prefix+"error");
+	}
+
+
+	/**
+	 * Load all Parareal data of this time slice from checkpoint
+	 */
+	void checkpoint_read(
+			const SWEETCheckpoint &i_checkpoint,
+			const std::string &i_prefix
+	)
+	{
+		output_data_valid = i_checkpoint.getScalar(i_prefix+"output_data_valid");
+
+		parareal_data_start.checkpoint_read(i_checkpoint, i_prefix+"start");
+		parareal_data_fine.checkpoint_read(i_checkpoint, i_prefix+"fine");
+		parareal_data_coarse.checkpoint_read(i_checkpoint, i_prefix+"coarse");
+		parareal_data_output.checkpoint_read(i_checkpoint, i_prefix+"output");
+		parareal_data_error.checkpoint_read(i_checkpoint, i_prefix+"error");
+	}
+
+
 	/**
 	 * Write file to data and return string of file name
 	 */
@@ -1428,6 +1505,9 @@ int main(int i_argc, char *i_argv[])
 			// setup controller. This initializes several simulation instances
 			parareal_Controller_Serial.setup(&simVars.parareal);
 
+			// write checkpoint after each iteration and/or restart from checkpoint
+			parareal_Controller_Serial.setup_checkpointing(simVars.iodata.checkpoint_file_name, simVars.iodata.checkpoint_restart_file_name);
+
 			// execute the simulation
 			parareal_Controller_Serial.run();
 		}
@@ -1478,6 +1558,10 @@ int main(int i_argc, char *i_argv[])
 
 			double seconds = time();
 
+			// Finish writing all pending output files
+			simulationBurgers->outputWriter.shutdown();
+			simulationBurgers->outputWriter.output();
+
 			if (simVars.iodata.output_file_name.size() > 0)
 				std::cout << "[MULE] reference_filenames: " << simulationBurgers->output_filenames << std::endl;
 
@@ -24,12 +24,11 @@ void Burgers_Plane_TS_l_cn::run_timestep(
 
 	double dt = i_fixed_dt;
 
-	PlaneData rhs_u = io_u + 0.5*dt*simVars.sim.viscosity*(op.diff2_c_x(io_u) + op.diff2_c_y(io_u));
-	PlaneData rhs_v = io_v + 0.5*dt*simVars.sim.viscosity*(op.diff2_c_x(io_v) + op.diff2_c_y(io_v));
-	PlaneData lhs = ((-0.5*dt)*simVars.sim.viscosity*(op.diff2_c_x + op.diff2_c_y)).spectral_addScalarAll(1.0);
+	PlaneData rhs_u = io_u + 0.5*dt*simVars.sim.viscosity*op.laplace(io_u);
+	PlaneData rhs_v = io_v + 0.5*dt*simVars.sim.viscosity*op.laplace(io_v);
 
-	io_u = rhs_u.spectral_div_element_wise(lhs);
-	io_v = rhs_v.spectral_div_element_wise(lhs);
+	io_u = op.helmholtz_inverse(rhs_u, 1.0, -0.5*dt*simVars.sim.viscosity);
+	io_v = op.helmholtz_inverse(rhs_v, 1.0, -0.5*dt*simVars.sim.viscosity);
 
 }
 
@@ -37,23 +37,18 @@ void Burgers_Plane_TS_l_irk::run_timestep(
 
 	if (simVars.disc.space_use_spectral_basis_diffs) //spectral
 	{
-		PlaneData lhs = io_u;
-
 		if (timestepping_order == 1)
 		{
-			lhs = ((-i_fixed_dt)*simVars.sim.viscosity*(op.diff2_c_x + op.diff2_c_y)).spectral_addScalarAll(1.0);
-
-			io_u = rhs_u.spectral_div_element_wise(lhs);
-			io_v = rhs_v.spectral_div_element_wise(lhs);
+			io_u = op.helmholtz_inverse(rhs_u, 1.0, -i_fixed_dt*simVars.sim.viscosity);
+			io_v = op.helmholtz_inverse(rhs_v, 1.0, -i_fixed_dt*simVars.sim.viscosity);
 		}
 		else if (timestepping_order ==2)
 		{
-			rhs_u = simVars.sim.viscosity*(op.diff2_c_x(rhs_u) + op.diff2_c_y(rhs_u));
-			rhs_v = simVars.sim.viscosity*(op.diff2_c_x(rhs_v) + op.diff2_c_y(rhs_v));
-			lhs = ((-0.5*i_fixed_dt)*simVars.sim.viscosity*(op.diff2_c_x + op.diff2_c_y)).spectral_addScalarAll(1.0);
+			rhs_u = simVars.sim.viscosity*op.laplace(rhs_u);
+			rhs_v = simVars.sim.viscosity*op.laplace(rhs_v);
 
-			PlaneData k1_u = rhs_u.spectral_div_element_wise(lhs);
-			PlaneData k1_v = rhs_v.spectral_div_element_wise(lhs);
+			PlaneData k1_u = op.helmholtz_inverse(rhs_u, 1.0, -0.5*i_fixed_dt*simVars.sim.viscosity);
+			PlaneData k1_v = op.helmholtz_inverse(rhs_v, 1.0, -0.5*i_fixed_dt*simVars.sim.viscosity);
 
 			io_u = io_u + i_fixed_dt*k1_u;
 			io_v = io_v + i_fixed_dt*k1_v;
@@ -85,11 +85,8 @@ void Burgers_Plane_TS_l_irk_n_sl_forcing::run_timestep(
 
 	if (simVars.disc.space_use_spectral_basis_diffs) //spectral
 	{
-		PlaneData lhs = u;
-
-		lhs = ((-i_fixed_dt)*simVars.sim.viscosity*(op.diff2_c_x + op.diff2_c_y)).spectral_addScalarAll(1.0);
-		io_u = rhs_u.spectral_div_element_wise(lhs);
-		io_v = rhs_v.spectral_div_element_wise(lhs);
+		io_u = op.helmholtz_inverse(rhs_u, 1.0, -i_fixed_dt*simVars.sim.viscosity);
+		io_v = op.helmholtz_inverse(rhs_v, 1.0, -i_fixed_dt*simVars.sim.viscosity);
 
 	} else { //Jacobi
 		FatalError("NOT available");
@@ -47,17 +47,17 @@ void Burgers_Plane_TS_ln_imex::run_timestep(
 	if (simVars.disc.space_use_spectral_basis_diffs) //spectral
 	{
 
-		PlaneData lhs = u;
+		double lhs_b;
 		if (timestepping_order == 1)
 		{
-			lhs = ((-t)*simVars.sim.viscosity*(op.diff2_c_x + op.diff2_c_y)).spectral_addScalarAll(1.0);
+			lhs_b = (-t)*simVars.sim.viscosity;
 		}
 		else
 		{
-			lhs = ((-t*0.5)*simVars.sim.viscosity*(op.diff2_c_x + op.diff2_c_y)).spectral_addScalarAll(1.0);
+			lhs_b = (-t*0.5)*simVars.sim.viscosity;
 		}
-		PlaneData u1 = rhs_u.spectral_div_element_wise(lhs);
-		PlaneData v1 = rhs_v.spectral_div_element_wise(lhs);
+		PlaneData u1 = op.helmholtz_inverse(rhs_u, 1.0, lhs_b);
+		PlaneData v1 = op.helmholtz_inverse(rhs_v, 1.0, lhs_b);
 
 		io_u = u + t*simVars.sim.viscosity*(op.diff2_c_x(u1)+op.diff2_c_y(u1))
 			  - t*(u1*op.diff_c_x(u1)+v1*op.diff_c_y(u1));
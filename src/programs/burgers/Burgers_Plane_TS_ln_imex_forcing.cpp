@@ -48,10 +48,8 @@ void Burgers_Plane_TS_ln_imex_forcing::run_timestep(
 	if (simVars.disc.space_use_spectral_basis_diffs) //spectral
 	{
 
-		PlaneData lhs = u;
-		lhs = ((-dt)*simVars.sim.viscosity*(op.diff2_c_x + op.diff2_c_y)).spectral_addScalarAll(1.0);
-        PlaneData u1 = rhs_u.spectral_div_element_wise(lhs);
-        PlaneData v1 = rhs_v.spectral_div_element_wise(lhs);
+        PlaneData u1 = op.helmholtz_inverse(rhs_u, 1.0, -dt*simVars.sim.viscosity);
+        PlaneData v1 = op.helmholtz_inverse(rhs_v, 1.0, -dt*simVars.sim.viscosity);
 
         //std::cout << std::endl << std::endl << "u1" << std::endl;
         //u1.print_physicalArrayData();
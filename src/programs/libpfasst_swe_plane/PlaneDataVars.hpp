@@ -1,10 +1,15 @@
 #ifndef _PLANE_DATA_VARS_HPP_
 #define _PLANE_DATA_VARS_HPP_
 
+#include <sweet/MemBlockAlloc.hpp>
 #include <sweet/plane/PlaneData.hpp>
 #include <sweet/plane/PlaneDataConfig.hpp>
 
 // Class containing the prognotic PlaneData variables h, vort, and div
+//
+// The physical space data of all variables is stored in one contiguous
+// buffer [h, vort, div] which is directly handed over to LibPFASST
+// as flat data array.
 
 class PlaneDataVars {
 
@@ -16,39 +21,33 @@ public:
 		int i_level
 		)
 
-    : prog_h(planeDataConfig),
-      prog_vort(planeDataConfig),
-      prog_div(planeDataConfig),
-      flat_data_array(nullptr),
-      flat_data_array_size(0),
+    : prog_h(0),
+      prog_vort(0),
+      prog_div(0),
+      data(nullptr),
+      num_elems_per_var(planeDataConfig->physical_array_data_number_of_elements),
       level(i_level)
-  {}
-  
-  // Destructor
-  ~PlaneDataVars()
   {
-    if (flat_data_array != nullptr) 
-      {
-	// release the memory
-	MemBlockAlloc::free(
-			    flat_data_array,
-			    flat_data_array_size*sizeof(double)
-			    );
-      }
+    // allocate the memory for all variables
+    data = MemBlockAlloc::alloc<double>(
+					3*num_elems_per_var*sizeof(double)
+					);
+
+    prog_h.setup_physical_view(planeDataConfig, data);
+    prog_vort.setup_physical_view(planeDataConfig, data + num_elems_per_var);
+    prog_div.setup_physical_view(planeDataConfig, data + 2*num_elems_per_var);
   }
 
-  void allocate_flat_data_array(int i_n_elems) 
+  // Destructor
+  ~PlaneDataVars()
   {
-    if (flat_data_array == nullptr) 
-      {
-	// allocate the memory
-	flat_data_array_size = i_n_elems;
-	flat_data_array      = MemBlockAlloc::alloc<double>(
-							    i_n_elems*sizeof(double)
-							    );
-      }						   
+    // release the memory
+    MemBlockAlloc::free(
+			data,
+			3*num_elems_per_var*sizeof(double)
+			);
   }
-  
+
   // getters for the PlaneData variables
   const PlaneData& get_h() const    {return prog_h;}
   PlaneData&       get_h()          {return prog_h;}
@@ -57,24 +56,24 @@ public:
   const PlaneData& get_div() const  {return prog_div;}
   PlaneData&       get_div()        {return prog_div;}
 
-  // getters for the flat data array
-  double*&         get_flat_data_array()            {return flat_data_array;}
-  const int&       get_flat_data_array_size() const {return flat_data_array_size;}
-  int&             get_flat_data_array_size()       {return flat_data_array_size;}
+  // getters for the flat data array (aliasing the physical space data of all variables)
+  double*          get_flat_data_array()            {return data;}
+  const double*    get_flat_data_array() const      {return data;}
+  int              get_flat_data_array_size() const {return 3*num_elems_per_var;}
 
-  // getters for the level 
+  // getters for the level
   const int&       get_level() const {return level;};
 
 protected:
-  
+
   PlaneData prog_h;
   PlaneData prog_vort;
   PlaneData prog_div;
 
-  // flat data array vector (currently used to pack and unpack)
-  double *flat_data_array;
-  int     flat_data_array_size;
-  
+  // contiguous buffer for the physical space data of all variables
+  double *data;
+  int     num_elems_per_var;
+
   // pfasst level
   const int level;
 
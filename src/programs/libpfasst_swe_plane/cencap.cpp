@@ -1,7 +1,53 @@
 #include <iomanip>
 #include <cstddef>
+#include <cassert>
+#include <sweet/parmemcpy.hpp>
+#include <sweet/openmp_helper.hpp>
 #include "cencap.hpp"
 
+namespace
+{
+  // computes io_y = i_a * i_x + io_y in place
+  // (in spectral space if both are available there, otherwise in physical space)
+  void saxpy_inplace(
+		     double i_a,
+		     const PlaneData &i_x,
+		     PlaneData &io_y
+		     )
+  {
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+    if (i_x.spectral_space_data_valid && io_y.spectral_space_data_valid)
+      {
+	const std::complex<double> *x = i_x.spectral_space_data;
+	std::complex<double> *y = io_y.spectral_space_data;
+	const std::size_t n_elems = io_y.planeDataConfig->spectral_array_data_number_of_elements;
+
+	SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+	for (std::size_t i = 0; i < n_elems; ++i)
+	  y[i] += i_a*x[i];
+
+	io_y.physical_space_data_valid = false;
+	return;
+      }
+#endif
+
+    i_x.request_data_physical();
+    io_y.request_data_physical();
+
+    const double *x = i_x.physical_space_data;
+    double *y = io_y.physical_space_data;
+    const std::size_t n_elems = io_y.planeDataConfig->physical_array_data_number_of_elements;
+
+    SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+    for (std::size_t i = 0; i < n_elems; ++i)
+      y[i] += i_a*x[i];
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+    io_y.spectral_space_data_valid = false;
+#endif
+  }
+}
+
 extern "C"
 {
   /*
@@ -116,29 +162,8 @@ extern "C"
     vort.request_data_physical();  
     div.request_data_physical();  
 
-    // allocate the flat data array
-    const int n_elems = (h.planeDataConfig->physical_array_data_number_of_elements 
-		      +  vort.planeDataConfig->physical_array_data_number_of_elements
-		      +  div.planeDataConfig->physical_array_data_number_of_elements);
-    io_Y->allocate_flat_data_array(n_elems);
-    double*& flat_data_array = io_Y->get_flat_data_array();
-    
-    int j = 0;
-
-    // h
-    for (int i = 0; i < h.planeDataConfig->physical_array_data_number_of_elements; ++i) 
-      flat_data_array[j++] = h.physical_space_data[i];
-
-    // vort
-    for (int i = 0; i < vort.planeDataConfig->physical_array_data_number_of_elements; ++i)
-      flat_data_array[j++] = vort.physical_space_data[i];
-
-    // div
-    for (int i = 0; i < div.planeDataConfig->physical_array_data_number_of_elements; ++i)
-      flat_data_array[j++] = div.physical_space_data[i]; 
-
-    // return the pointer to the array
-    *o_flat_data_ptr = flat_data_array;
+    // the physical data is already stored in a flat array
+    *o_flat_data_ptr = io_Y->get_flat_data_array();
   } 
 
   // unpacks the flat array into the sweet data object 
@@ -147,26 +172,18 @@ extern "C"
 			   PlaneDataVars *o_Y
 			   ) 
   {
-    int j = 0;
-
-    // copy the values into physical_space_data array
-
-    // h
-    PlaneData& h = o_Y->get_h();
-    for (int i = 0; i < h.planeDataConfig->physical_array_data_number_of_elements; ++i) 
-      h.physical_space_data[i] = i_flat_data_ptr[0][j++]; 
-
-    // vort
+    // copy the values into the physical_space_data arrays
+    // (nothing to do if the data was packed by this object)
+    if (i_flat_data_ptr[0] != o_Y->get_flat_data_array())
+      parmemcpy(
+		o_Y->get_flat_data_array(),
+		i_flat_data_ptr[0],
+		o_Y->get_flat_data_array_size()*sizeof(double)
+		);
+
+    PlaneData& h    = o_Y->get_h();
     PlaneData& vort = o_Y->get_vort();
-    for (int i = 0; i < vort.planeDataConfig->physical_array_data_number_of_elements; ++i) {
-      vort.physical_space_data[i] = i_flat_data_ptr[0][j++]; 
-    }
-
-    // v
-    PlaneData& div = o_Y->get_div();
-    for (int i = 0; i < div.planeDataConfig->physical_array_data_number_of_elements; ++i) {
-      div.physical_space_data[i] = i_flat_data_ptr[0][j++]; 
-    }
+    PlaneData& div  = o_Y->get_div();
 
     // tell sweet that the physical data is up to date
     h.physical_space_data_valid    = true;
@@ -177,12 +194,6 @@ extern "C"
     h.spectral_space_data_valid    = false;
     vort.spectral_space_data_valid = false;
     div.spectral_space_data_valid  = false;
-
-    // make sure that the spectral data is up to date
-    //h.request_data_spectral();  
-    //vort.request_data_spectral();  
-    //div.request_data_spectral();  
-    
   }
 
   // computes io_Y = i_a * i_X + io_Y
@@ -200,9 +211,9 @@ extern "C"
     PlaneData&       vort_y = io_Y->get_vort();
     PlaneData&       div_y  = io_Y->get_div();
     
-    h_y  = i_a * h_x  + h_y;
-    vort_y = i_a * vort_x + vort_y;
-    div_y  = i_a * div_x  + div_y;
+    saxpy_inplace(i_a, h_x, h_y);
+    saxpy_inplace(i_a, vort_x, vort_y);
+    saxpy_inplace(i_a, div_x, div_y);
 
   }
 
@@ -14,6 +14,9 @@
 #include <sweet/sphere/SphereHelpers_Diagnostics.hpp>
 #include <sweet/sphere/SphereOperators_SphereData.hpp>
 #include <sweet/SimulationVariables.hpp>
+#include <sweet/sphere/app_swe/SWESphBandedMatrixPhysicalReal.hpp>
+#include <sweet/sphere/app_swe/SWESphBandedMatrixPhysicalComplex.hpp>
+#include <sweet/sphere/app_swe/SWESphImplicitOperatorCache.hpp>
 #include "libpfasst_swe_sphere/LevelSingleton.hpp"
 #include "libpfasst_swe_sphere/SphereDataCtx.hpp"
 #include <mpi.h>
@@ -67,6 +70,10 @@ int main(int i_argc, char *i_argv[])
 		return -1;
 	}
 
+	// implicit operators are reused for the different time step sizes of the SDC nodes
+	SWESphImplicitOperatorCache< SphBandedMatrixPhysicalReal< std::complex<double> > >::getInstance().setMaxSize(simVars.misc.implicit_operator_cache_size);
+	SWESphImplicitOperatorCache< SphBandedMatrixPhysicalComplex< std::complex<double> > >::getInstance().setMaxSize(simVars.misc.implicit_operator_cache_size);
+
 	// define the number of levels and SDC nodes for each level
 	// note: level #nlevels-1 is the finest, level #0 is the coarsest
 
@@ -231,6 +238,9 @@ int main(int i_argc, char *i_argv[])
 			&(simVars.timecontrol.current_timestep_size)  // time step size
 	);
 
+	SWESphImplicitOperatorCache< SphBandedMatrixPhysicalReal< std::complex<double> > >::getInstance().output("implicit_operator_cache.irk");
+	SWESphImplicitOperatorCache< SphBandedMatrixPhysicalComplex< std::complex<double> > >::getInstance().output("implicit_operator_cache.rexi");
+
 	// release the memory
 	delete pd_ctx;
 
@@ -10,6 +10,7 @@
 
 
 #include <complex>
+#include <memory>
 #include <sweet/sphere/app_swe/SWESphBandedMatrixPhysicalReal.hpp>
 #include <sweet/sphere/SphereData_Spectral.hpp>
 #include <sweet/sphere/SphereOperators_SphereData.hpp>
@@ -40,7 +41,7 @@ class SWE_Sphere_TS_l_irk	: public SWE_Sphere_TS_interface
 	/// Solvers for alpha=Identity
 	/// Template parameter is still complex-valued!!!
 	/// This is because the spectral space is complex valued
-	SphBandedMatrixPhysicalReal< std::complex<double> > sphSolverPhi;
+	std::shared_ptr< SphBandedMatrixPhysicalReal< std::complex<double> > > sphSolverPhi;
 	SphBandedMatrixPhysicalReal< std::complex<double> > sphSolverVel;
 
 	bool use_extended_modes;
@@ -1,10 +1,16 @@
 #ifndef _SPHERE_DATA_VARS_HPP_
 #define _SPHERE_DATA_VARS_HPP_
 
+#include <complex>
+#include <sweet/MemBlockAlloc.hpp>
 #include <sweet/sphere/SphereData_Config.hpp>
 #include <sweet/sphere/SphereData_Spectral.hpp>
 
 // Class containing the prognotic SphereDataSpectral variables phi, vort, and div
+//
+// All variables are stored in one contiguous buffer [phi, vort, div]
+// which is directly handed over to LibPFASST as flat data array
+// (real and imaginary parts of the spectral coefficients).
 
 class SphereDataVars {
 
@@ -16,39 +22,30 @@ public:
 		int i_level
 		)
 
-    : prog_phi(sphereDataConfig),
-      prog_vort(sphereDataConfig),
-      prog_div(sphereDataConfig),
-      flat_data_array(nullptr),
-      flat_data_array_size(0),
+    : data(nullptr),
+      num_elems_per_var(sphereDataConfig->spectral_array_data_number_of_elements),
       level(i_level)
-  {}
-  
-  // Destructor
-  ~SphereDataVars()
   {
-    if (flat_data_array != nullptr) 
-      {
-	// release the memory
-	MemBlockAlloc::free(
-			    flat_data_array,
-			    flat_data_array_size*sizeof(double)
-			    );
-      }
+    // allocate the memory for all variables
+    data = MemBlockAlloc::alloc< std::complex<double> >(
+							3*num_elems_per_var*sizeof(std::complex<double>)
+							);
+
+    prog_phi.setup_view(sphereDataConfig, data);
+    prog_vort.setup_view(sphereDataConfig, data + num_elems_per_var);
+    prog_div.setup_view(sphereDataConfig, data + 2*num_elems_per_var);
   }
 
-  void allocate_flat_data_array(int i_n_elems) 
+  // Destructor
+  ~SphereDataVars()
   {
-    if (flat_data_array == nullptr) 
-      {
-	// allocate the memory
-	flat_data_array_size = i_n_elems;
-	flat_data_array      = MemBlockAlloc::alloc<double>(
-							    i_n_elems*sizeof(double)
-							    );
-      }						   
+    // release the memory
+    MemBlockAlloc::free(
+			data,
+			3*num_elems_per_var*sizeof(std::complex<double>)
+			);
   }
-  
+
   // getters for the SphereDataSpectral variables
   const SphereData_Spectral& get_phi() const  {return prog_phi;}
   SphereData_Spectral&       get_phi()        {return prog_phi;}
@@ -57,24 +54,32 @@ public:
   const SphereData_Spectral& get_div() const  {return prog_div;}
   SphereData_Spectral&       get_div()        {return prog_div;}
 
-  // getters for the flat data array
-  double*&         get_flat_data_array()            {return flat_data_array;}
-  const int&       get_flat_data_array_size() const {return flat_data_array_size;}
-  int&             get_flat_data_array_size()       {return flat_data_array_size;}
+  // to be called after writing to the flat data array
+  void data_modified()
+  {
+    prog_phi.spectral_data_modified();
+    prog_vort.spectral_data_modified();
+    prog_div.spectral_data_modified();
+  }
+
+  // getters for the flat data array (aliasing all variables)
+  double*          get_flat_data_array()            {return (double*)data;}
+  const double*    get_flat_data_array() const      {return (const double*)data;}
+  int              get_flat_data_array_size() const {return 3*2*num_elems_per_var;}
 
-  // getters for the level 
+  // getters for the level
   const int&       get_level() const {return level;};
 
 protected:
-  
+
   SphereData_Spectral prog_phi;
   SphereData_Spectral prog_vort;
   SphereData_Spectral prog_div;
 
-  // flat data array vector (currently used to pack and unpack)
-  double *flat_data_array;
-  int     flat_data_array_size;
-  
+  // contiguous buffer for all variables
+  std::complex<double> *data;
+  int                   num_elems_per_var;
+
   // pfasst level
   const int level;
 
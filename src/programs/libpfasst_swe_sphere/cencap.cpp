@@ -1,5 +1,8 @@
 #include <iomanip>
 #include <cstddef>
+#include <cassert>
+#include <sweet/parmemcpy.hpp>
+#include <sweet/openmp_helper.hpp>
 #include "cencap.hpp"
 
 extern "C"
@@ -24,19 +27,18 @@ void c_sweet_data_create(
 			i_level
 	);
 
-	SphereData_Spectral& phi  = (*o_Y)->get_phi();
-	SphereData_Spectral& vort = (*o_Y)->get_vort();
-	SphereData_Spectral& div  = (*o_Y)->get_div();
-
 	// initialize the SphereDataSpectral vectors
-	phi.spectral_set_zero();
-	vort.spectral_set_zero();
-	div.spectral_set_zero();
+	double *data = (*o_Y)->get_flat_data_array();
+	const int n_elems = (*o_Y)->get_flat_data_array_size();
+
+	SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+	for (int i = 0; i < n_elems; ++i)
+		data[i] = 0;
+
+	(*o_Y)->data_modified();
 
 	// return the size of the number of elements
-	*o_size = 2*(phi.sphereDataConfig->spectral_array_data_number_of_elements
-			+ vort.sphereDataConfig->spectral_array_data_number_of_elements
-			+ div.sphereDataConfig->spectral_array_data_number_of_elements);
+	*o_size = n_elems;
 }
 
 // calls the destructor of the sweet data encapsulated object
@@ -80,17 +82,16 @@ void c_sweet_data_setval(
 void c_sweet_data_copy(SphereDataVars *i_src,
 		SphereDataVars *o_dst)
 {
-	const SphereData_Spectral& phi_src  = i_src->get_phi();
-	const SphereData_Spectral& vort_src = i_src->get_vort();
-	const SphereData_Spectral& div_src  = i_src->get_div();
+	assert(i_src->get_flat_data_array_size() == o_dst->get_flat_data_array_size());
 
-	SphereData_Spectral&       phi_dst  = o_dst->get_phi();
-	SphereData_Spectral&       vort_dst = o_dst->get_vort();
-	SphereData_Spectral&       div_dst  = o_dst->get_div();
+	// all variables are stored contiguously
+	parmemcpy(
+			o_dst->get_flat_data_array(),
+			i_src->get_flat_data_array(),
+			i_src->get_flat_data_array_size()*sizeof(double)
+	);
 
-	phi_dst  = phi_src;
-	vort_dst = vort_src;
-	div_dst  = div_src;
+	o_dst->data_modified();
 }
 
 // computes the norm of the sweet data encapsulated object
@@ -160,45 +161,9 @@ void c_sweet_data_pack(
 		double **o_flat_data_ptr
 )
 {
-	SphereData_Spectral& phi  = io_Y->get_phi();
-	SphereData_Spectral& vort = io_Y->get_vort();
-	SphereData_Spectral& div  = io_Y->get_div();
-
-
-	// allocate the flat data array
-	const int n_elems = 2*(phi.sphereDataConfig->spectral_array_data_number_of_elements
-			+  vort.sphereDataConfig->spectral_array_data_number_of_elements
-			+   div.sphereDataConfig->spectral_array_data_number_of_elements);
-	io_Y->allocate_flat_data_array(n_elems);
-	double*& flat_data_array = io_Y->get_flat_data_array();
-
-	int j = 0;
-
-	// real and imaginary parts
-
-	// phi
-	for (int i = 0; i < phi.sphereDataConfig->spectral_array_data_number_of_elements; ++i)
-	{
-		flat_data_array[j++] = phi.spectral_space_data[i].imag();
-		flat_data_array[j++] = phi.spectral_space_data[i].real();
-	}
-
-	// vort
-	for (int i = 0; i < vort.sphereDataConfig->spectral_array_data_number_of_elements; ++i)
-	{
-		flat_data_array[j++] = vort.spectral_space_data[i].imag();
-		flat_data_array[j++] = vort.spectral_space_data[i].real();
-	}
-
-	// div
-	for (int i = 0; i < div.sphereDataConfig->spectral_array_data_number_of_elements; ++i)
-	{
-		flat_data_array[j++] = div.spectral_space_data[i].imag();
-		flat_data_array[j++] = div.spectral_space_data[i].real();
-	}
-
-	// return the pointer to the array
-	*o_flat_data_ptr = flat_data_array;
+	// the variables are already stored in a flat array
+	// (real and imaginary parts of the spectral coefficients of phi, vort, div)
+	*o_flat_data_ptr = io_Y->get_flat_data_array();
 }
 
 // // unpacks the flat array into the sweet data object
@@ -251,40 +216,19 @@ void c_sweet_data_unpack(
 		SphereDataVars *o_Y
 )
 {
-	int j = 0;
-
-	// copy the values into physical_space_data array
+	double *flat_data_array = o_Y->get_flat_data_array();
 
-	// phi
-	SphereData_Spectral& phi = o_Y->get_phi();
-	for (int i = 0; i < phi.sphereDataConfig->spectral_array_data_number_of_elements; ++i)
-	{
-		phi.spectral_space_data[i] = std::complex<double>(
-				i_flat_data_ptr[0][j++],
-				i_flat_data_ptr[0][j++]
-		);
-	}
-
-	// vort
-	SphereData_Spectral& vort = o_Y->get_vort();
-	for (int i = 0; i < vort.sphereDataConfig->spectral_array_data_number_of_elements; ++i)
-	{
-		vort.spectral_space_data[i] = std::complex<double>(
-				i_flat_data_ptr[0][j++],
-				i_flat_data_ptr[0][j++]
-		);
-	}
+	// nothing to do if the data was packed by this object
+	if (i_flat_data_ptr[0] == flat_data_array)
+		return;
 
-	// v
-	SphereData_Spectral& div = o_Y->get_div();
-	for (int i = 0; i < div.sphereDataConfig->spectral_array_data_number_of_elements; ++i)
-	{
-		div.spectral_space_data[i] = std::complex<double>(
-				i_flat_data_ptr[0][j++],
-				i_flat_data_ptr[0][j++]
-		);
+	parmemcpy(
+			flat_data_array,
+			i_flat_data_ptr[0],
+			o_Y->get_flat_data_array_size()*sizeof(double)
+	);
 
-	}
+	o_Y->data_modified();
 }
 
 
@@ -295,18 +239,18 @@ void c_sweet_data_saxpy(
 		SphereDataVars *io_Y
 )
 {
-	const SphereData_Spectral& phi_x  = i_X->get_phi();
-	const SphereData_Spectral& vort_x = i_X->get_vort();
-	const SphereData_Spectral& div_x  = i_X->get_div();
+	assert(i_X->get_flat_data_array_size() == io_Y->get_flat_data_array_size());
 
-	SphereData_Spectral&       phi_y  = io_Y->get_phi();
-	SphereData_Spectral&       vort_y = io_Y->get_vort();
-	SphereData_Spectral&       div_y  = io_Y->get_div();
+	// in-place update of all variables at once
+	const double *x = i_X->get_flat_data_array();
+	double *y = io_Y->get_flat_data_array();
+	const int n_elems = io_Y->get_flat_data_array_size();
 
-	phi_y  = i_a * phi_x  + phi_y;
-	vort_y = i_a * vort_x + vort_y;
-	div_y  = i_a * div_x  + div_y;
+	SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+	for (int i = 0; i < n_elems; ++i)
+		y[i] += i_a*x[i];
 
+	io_Y->data_modified();
 }
 
 // prints the data to the terminal
@@ -17,6 +17,8 @@
 #include <sweet/plane/PlaneData.hpp>
 
 #include <sweet/plane/PlaneOperators.hpp>
+#include <sweet/plane/PlaneDataDistributed.hpp>
+#include <sweet/plane/PlaneOperatorsDistributed.hpp>
 #include <sweet/plane/PlaneDataSampler.hpp>
 #include <sweet/plane/PlaneDataGridMapping.hpp>
 #include <sweet/plane/PlaneDiagnostics.hpp>
@@ -24,6 +26,11 @@
 #include <sweet/plane/Convert_PlaneData_to_PlaneDataComplex.hpp>
 #include <sweet/Stopwatch.hpp>
 #include <sweet/FatalError.hpp>
+#include <sweet/BackgroundOutputWriter.hpp>
+#include <sweet/SWEETDataContainer.hpp>
+#include <sweet/SWEETCheckpoint.hpp>
+#include <sweet/SimulationProfiler.hpp>
+#include <sweet/KernelCounters.hpp>
 #include <benchmarks_plane/SWEPlaneBenchmarksCombined.hpp>
 #include <ostream>
 #include <algorithm>
@@ -79,6 +86,12 @@ public:
 	// v: velocity in y-direction
 	PlaneData prog_h_pert, prog_u, prog_v;
 
+	// Write output files in background
+	BackgroundOutputWriter outputWriter;
+
+	// Single file container for output file mode 'container'
+	SWEETDataContainerWriter containerWriter;
+
 
 #if SWEET_GUI
 	//visualization variable
@@ -386,6 +399,14 @@ public:
 				simVars
 			);
 
+		outputWriter.setup(simVars.iodata.output_async_queue_size);
+
+		bool restart = simVars.iodata.checkpoint_restart_file_name.length() > 0;
+
+		// Keep the output written before the checkpoint
+		if (simVars.iodata.output_file_mode == "container" && simVars.iodata.output_file_name.length() > 0)
+			containerWriter.open(simVars.iodata.output_file_name, restart);
+
 		if (simVars.misc.compute_errors)
 		{
 			//Compute difference to initial condition (makes more sense in steady state cases, but useful in others too)
@@ -403,6 +424,11 @@ public:
 			compute_error_to_analytical_solution = false;
 		}
 
+		simVars.iodata.checkpoint_next_sim_seconds = simVars.iodata.checkpoint_each_sim_seconds;
+
+		if (restart)
+			checkpoint_read(simVars.iodata.checkpoint_restart_file_name);
+
 		update_diagnostics();
 
 		diagnostics_energy_start = simVars.diag.total_energy;
@@ -469,6 +495,8 @@ public:
 	 */
 	void run_timestep()
 	{
+		SWEET_PROFILER_REGION("timestep");
+
 		if (simVars.timecontrol.current_simulation_time + simVars.timecontrol.current_timestep_size > simVars.timecontrol.max_simulation_time)
 			simVars.timecontrol.current_timestep_size = simVars.timecontrol.max_simulation_time - simVars.timecontrol.current_simulation_time;
 
@@ -507,6 +535,91 @@ public:
 			FatalError("Max simulation time exceeded!");
 
 		timestep_do_output();
+
+		timestep_check_checkpoint();
+	}
+
+
+
+	/**
+	 * Write checkpoint with the full simulation state
+	 *
+	 * The checkpoint is written by the background output writer.
+	 */
+	void checkpoint_write(
+			const std::string &i_filename
+	)
+	{
+		std::shared_ptr<SWEETCheckpoint> checkpoint(new SWEETCheckpoint);
+
+		simVars.checkpoint_write(*checkpoint);
+
+		prog_h_pert.checkpoint_write(*checkpoint, "prog_h_pert");
+		prog_u.checkpoint_write(*checkpoint, "prog_u");
+		prog_v.checkpoint_write(*checkpoint, "prog_v");
+
+		timeSteppers.master->checkpoint_write(*checkpoint, "timestepper.");
+
+		if (simVars.misc.verbosity > 0)
+			std::cout << "Writing checkpoint '" << i_filename << "' at simulation time " << simVars.timecontrol.current_simulation_time << std::endl;
+
+		std::string filename = i_filename;
+		outputWriter.enqueue(
+				[checkpoint, filename]()
+				{
+					checkpoint->writeFile(filename);
+				}
+			);
+	}
+
+
+
+	/**
+	 * Restore full simulation state from checkpoint
+	 */
+	void checkpoint_read(
+			const std::string &i_filename
+	)
+	{
+		std::cout << "Restarting from checkpoint '" << i_filename << "'" << std::endl;
+
+		SWEETCheckpoint checkpoint;
+		checkpoint.readFile(i_filename);
+
+		simVars.checkpoint_read(checkpoint);
+
+		prog_h_pert.checkpoint_read(checkpoint, "prog_h_pert");
+		prog_u.checkpoint_read(checkpoint, "prog_u");
+		prog_v.checkpoint_read(checkpoint, "prog_v");
+
+		timeSteppers.master->checkpoint_read(checkpoint, "timestepper.");
+
+		last_timestep_nr_update_diagnostics = -1;
+	}
+
+
+
+	/**
+	 * Write checkpoint if requested for current simulation time
+	 */
+	void timestep_check_checkpoint()
+	{
+		if (simVars.iodata.checkpoint_file_name.length() == 0)
+			return;
+
+		if (simVars.iodata.checkpoint_each_sim_seconds <= 0)
+			return;
+
+		if (simVars.misc.normal_mode_analysis_generation > 0)
+			return;
+
+		if (simVars.iodata.checkpoint_next_sim_seconds > simVars.timecontrol.current_simulation_time)
+			return;
+
+		while (simVars.iodata.checkpoint_next_sim_seconds <= simVars.timecontrol.current_simulation_time)
+			simVars.iodata.checkpoint_next_sim_seconds += simVars.iodata.checkpoint_each_sim_seconds;
+
+		checkpoint_write(simVars.iodata.checkpoint_file_name);
 	}
 
 
@@ -518,11 +631,33 @@ public:
 			const char* i_name	///< name of output variable
 		)
 	{
+		SWEET_PROFILER_REGION("output");
+
 		char buffer[1024];
 
 		const char* filename_template = simVars.iodata.output_file_name.c_str();
 		sprintf(buffer, filename_template, i_name, simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale);
-		i_planeData.file_physical_saveData_ascii(buffer);
+
+		/*
+		 * Create snapshot of data and write it with the background writer
+		 */
+		i_planeData.request_data_physical();
+
+		std::shared_ptr< std::vector<double> > staging = BackgroundOutputWriter::createStagingBuffer(
+				i_planeData.physical_space_data,
+				planeDataConfig->physical_array_data_number_of_elements
+			);
+
+		std::string filename = buffer;
+		const PlaneDataConfig *config = planeDataConfig;
+
+		outputWriter.enqueue(
+				[staging, filename, config]()
+				{
+					PlaneData::file_physical_saveData_ascii_data(config, staging->data(), filename.c_str());
+				}
+			);
+
 		return buffer;
 	}
 
@@ -540,13 +675,71 @@ public:
 
 		const char* filename_template = simVars.iodata.output_file_name.c_str();
 		sprintf(buffer, filename_template, i_name, simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale);
-		i_planeData.file_spectral_abs_saveData_ascii(buffer);
+
+		/*
+		 * Create snapshot of data and write it with the background writer
+		 */
+		i_planeData.request_data_spectral();
+
+		std::shared_ptr< std::vector<std::complex<double>> > staging = BackgroundOutputWriter::createStagingBuffer(
+				i_planeData.spectral_space_data,
+				planeDataConfig->spectral_array_data_number_of_elements
+			);
+
+		std::string filename = buffer;
+		const PlaneDataConfig *config = planeDataConfig;
+
+		outputWriter.enqueue(
+				[staging, filename, config]()
+				{
+					PlaneData::file_spectral_abs_saveData_ascii_data(config, staging->data(), filename.c_str());
+				}
+			);
+
 		//i_planeData.file_spectral_saveData_ascii(buffer);
 		return buffer;
 	}
 #endif
 
 
+	/**
+	 * Append data to container and return file name of container
+	 */
+	std::string write_file_container(
+			const PlaneData &i_planeData,
+			const char* i_name	///< name of output variable
+		)
+	{
+		i_planeData.request_data_physical();
+
+		/*
+		 * Create snapshot of data and write it with the background writer
+		 */
+		std::shared_ptr< std::vector<double> > staging = BackgroundOutputWriter::createStagingBuffer(
+				i_planeData.physical_space_data,
+				planeDataConfig->physical_array_data_number_of_elements
+			);
+
+		std::string name = i_name;
+		const PlaneDataConfig *config = planeDataConfig;
+		SWEETDataContainerWriter *writer = &containerWriter;
+		double time = simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale;
+		SWEETCompression::Codec codec = SWEETCompression::getCodecFromString(simVars.iodata.output_compression);
+		double tol = simVars.iodata.output_compression_tolerance;
+
+		outputWriter.enqueue(
+				[staging, name, config, writer, time, codec, tol]()
+				{
+					int64_t res[4] = {(int64_t)config->physical_res[0], (int64_t)config->physical_res[1], 0, 0};
+
+					writer->appendRecord(name, time, SWEETDataContainer::PRIMITIVE_PLANE, SWEETDataContainer::SPACE_PHYSICAL, SWEETDataContainer::DATA_TYPE_FLOAT64, res, staging->data(), staging->size(), codec, tol);
+				}
+			);
+
+		return containerWriter.getFilename();
+	}
+
+
 	std::string output_filenames;
 
 
@@ -592,7 +785,13 @@ public:
 			//std::cout << simVars.inputoutput.output_next_sim_seconds << "\t" << simVars.timecontrol.current_simulation_time << std::endl;
 
 			// Dump  data in csv, if output filename is not empty
-			if (simVars.iodata.output_file_name.size() > 0)
+			if (simVars.iodata.output_file_name.size() > 0 && simVars.iodata.output_file_mode == "container")
+			{
+				write_file_container(t_h, "prog_h_pert");
+				write_file_container(t_u, "prog_u");
+				output_filenames = write_file_container(t_v, "prog_v");
+			}
+			else if (simVars.iodata.output_file_name.size() > 0)
 			{
 				output_filenames = "";
 
@@ -1330,6 +1529,460 @@ public:
 
 
 
+#if SWEET_MPI && SWEET_USE_PLANE_SPECTRAL_SPACE
+
+/**
+ * Simulation with the plane data distributed over all MPI ranks
+ * (see --space-plane-distributed)
+ *
+ * All ranks execute the time steps. Only the A-grid with spectral
+ * derivatives and the time steppers with support for
+ * PlaneDataDistributed are available.
+ */
+class SimulationInstanceDistributed
+{
+public:
+	const PlaneDataConfigDistributed *planeDataConfigDistributed;
+
+	// Prognostic variables
+	PlaneDataDistributed prog_h_pert, prog_u, prog_v;
+
+	// Initial values for comparison with analytical solution
+	PlaneDataDistributed t0_prog_h_pert, t0_prog_u, t0_prog_v;
+
+	// Operators without serial plane data, only required to setup the time steppers
+	PlaneOperators op;
+
+	PlaneOperatorsDistributed opDistributed;
+
+	// implementation of different time steppers
+	SWE_Plane_TimeSteppers timeSteppers;
+
+	SWEPlaneBenchmarksCombined swePlaneBenchmarks;
+
+	// Error measures max norm
+	double t0_error_max_abs_h_pert = -1;
+	double t0_error_max_abs_u = -1;
+	double t0_error_max_abs_v = -1;
+
+	double analytical_error_maxabs_h = -1;
+	double analytical_error_maxabs_u = -1;
+	double analytical_error_maxabs_v = -1;
+
+	/// Diagnostic measures at initial stage
+	double diagnostics_energy_start = 0;
+	double diagnostics_mass_start = 0;
+	double diagnostics_potential_entrophy_start = 0;
+
+	bool compute_error_to_analytical_solution = false;
+
+	std::string output_filenames;
+
+
+public:
+	SimulationInstanceDistributed(
+			const PlaneDataConfigDistributed *i_planeDataConfigDistributed
+	)	:
+		planeDataConfigDistributed(i_planeDataConfigDistributed),
+
+		prog_h_pert(i_planeDataConfigDistributed),
+		prog_u(i_planeDataConfigDistributed),
+		prog_v(i_planeDataConfigDistributed),
+
+		t0_prog_h_pert(i_planeDataConfigDistributed),
+		t0_prog_u(i_planeDataConfigDistributed),
+		t0_prog_v(i_planeDataConfigDistributed),
+
+		opDistributed(i_planeDataConfigDistributed, simVars.sim.plane_domain_size)
+	{
+		reset();
+	}
+
+
+
+	void reset()
+	{
+		simVars.reset();
+
+		if (simVars.benchmark.benchmark_name == "")
+		{
+			std::cout << "Benchmark scenario not selected (option --benchmark-name [string])" << std::endl;
+			swePlaneBenchmarks.printBenchmarkInformation();
+			FatalError("Benchmark name not given");
+		}
+
+		// Check if input parameters are supported with distributed plane data
+		if (simVars.disc.space_grid_use_c_staggering || !simVars.disc.space_use_spectral_basis_diffs)
+			FatalError("Distributed plane data requires the A-grid with spectral derivatives");
+
+		if (simVars.timecontrol.current_timestep_size <= 0)
+			FatalError("Distributed plane data requires a constant time step size (please set --dt)");
+
+		if (simVars.sim.viscosity != 0)
+			FatalError("Viscosity not supported for distributed plane data");
+
+		if (simVars.iodata.output_file_mode == "container")
+			FatalError("Output file mode 'container' not supported for distributed plane data");
+
+		if (simVars.iodata.checkpoint_file_name.length() > 0 || simVars.iodata.checkpoint_restart_file_name.length() > 0)
+			FatalError("Checkpoints not supported for distributed plane data");
+
+		if (simVars.iodata.initial_condition_data_filenames.size() > 0)
+			FatalError("Loading initial conditions from files not supported for distributed plane data");
+
+		if (simVars.misc.normal_mode_analysis_generation > 0)
+			FatalError("Normal mode analysis not supported for distributed plane data");
+
+		t0_error_max_abs_h_pert = -1;
+		t0_error_max_abs_u = -1;
+		t0_error_max_abs_v = -1;
+
+		analytical_error_maxabs_h = -1;
+		analytical_error_maxabs_u = -1;
+		analytical_error_maxabs_v = -1;
+
+		simVars.timecontrol.current_timestep_nr = 0;
+		simVars.timecontrol.current_simulation_time = 0;
+
+		swePlaneBenchmarks.setupInitialConditions(t0_prog_h_pert, t0_prog_u, t0_prog_v, simVars);
+
+		prog_h_pert = t0_prog_h_pert;
+		prog_u = t0_prog_u;
+		prog_v = t0_prog_v;
+
+		timeSteppers.setup(
+				simVars.disc.timestepping_method,
+				simVars.disc.timestepping_order,
+				simVars.disc.timestepping_order2,
+				op,
+				simVars
+			);
+
+		if (!timeSteppers.supports_distributed)
+			FatalError("Time stepping method '"+simVars.disc.timestepping_method+"' not supported for distributed plane data");
+
+		compute_error_to_analytical_solution = simVars.misc.compute_errors && timeSteppers.linear_only;
+
+		update_diagnostics();
+
+		diagnostics_energy_start = simVars.diag.total_energy;
+		diagnostics_mass_start = simVars.diag.total_mass;
+		diagnostics_potential_entrophy_start = simVars.diag.total_potential_enstrophy;
+
+		timestep_do_output();
+	}
+
+
+
+	/**
+	 * Collective computation of the diagnostics
+	 * (see PlaneDiagnostics::update_nonstaggered_huv_to_mass_energy_enstrophy)
+	 */
+	void update_diagnostics()
+	{
+		double normalization = (simVars.sim.plane_domain_size[0]*simVars.sim.plane_domain_size[1]) /
+								((double)simVars.disc.space_res_physical[0]*(double)simVars.disc.space_res_physical[1]);
+
+		double num_points = (double)simVars.disc.space_res_physical[0]*(double)simVars.disc.space_res_physical[1];
+		double h0 = simVars.sim.h0;
+		double f0 = simVars.sim.plane_rotating_f0;
+
+		double sum_h = prog_h_pert.reduce_sum();
+		double sum_ke = ((prog_h_pert + h0)*(prog_u*prog_u + prog_v*prog_v)).reduce_sum();
+
+		PlaneDataDistributed eta = opDistributed.vort(prog_u, prog_v) + f0;
+		double sum_eta2 = (eta*eta).reduce_sum();
+
+		// mass (mean depth needs to be added)
+		simVars.diag.total_mass = (sum_h + num_points*h0) * normalization;
+
+		// energy
+		simVars.diag.potential_energy = simVars.diag.total_mass*simVars.sim.gravitation;
+		simVars.diag.kinetic_energy = 0.5*sum_ke*normalization;
+
+		simVars.diag.total_energy = simVars.diag.kinetic_energy + simVars.diag.potential_energy;
+
+		// enstrophy of absolute vorticity
+		simVars.diag.total_potential_enstrophy = 0.5*sum_eta2*normalization;
+	}
+
+
+
+	/**
+	 * Execute a single simulation time step
+	 */
+	void run_timestep()
+	{
+		SWEET_PROFILER_REGION("timestep");
+
+		if (simVars.timecontrol.current_simulation_time + simVars.timecontrol.current_timestep_size > simVars.timecontrol.max_simulation_time)
+			simVars.timecontrol.current_timestep_size = simVars.timecontrol.max_simulation_time - simVars.timecontrol.current_simulation_time;
+
+		timeSteppers.master->run_timestep(
+				prog_h_pert, prog_u, prog_v,
+				simVars.timecontrol.current_timestep_size,
+				simVars.timecontrol.current_simulation_time
+			);
+
+		// advance time step and provide information to parameters
+		simVars.timecontrol.current_simulation_time += simVars.timecontrol.current_timestep_size;
+		simVars.timecontrol.current_timestep_nr++;
+
+		if (simVars.timecontrol.current_simulation_time > simVars.timecontrol.max_simulation_time)
+			FatalError("Max simulation time exceeded!");
+
+		timestep_do_output();
+	}
+
+
+
+	/**
+	 * Collective output of the data to a file and return string of file name
+	 */
+	std::string write_file(
+			const PlaneDataDistributed &i_planeData,
+			const char* i_name	///< name of output variable
+		)
+	{
+		SWEET_PROFILER_REGION("output");
+
+		char buffer[1024];
+
+		const char* filename_template = simVars.iodata.output_file_name.c_str();
+		sprintf(buffer, filename_template, i_name, simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale);
+
+		i_planeData.file_physical_saveData_ascii(buffer);
+
+		return buffer;
+	}
+
+
+
+	void compute_errors()
+	{
+		if (!simVars.misc.compute_errors)
+			return;
+
+		t0_error_max_abs_h_pert = (prog_h_pert - t0_prog_h_pert).reduce_maxAbs();
+		t0_error_max_abs_u = (prog_u - t0_prog_u).reduce_maxAbs();
+		t0_error_max_abs_v = (prog_v - t0_prog_v).reduce_maxAbs();
+
+		if (compute_error_to_analytical_solution)
+		{
+			// Analytical solution at specific time on A-grid
+			PlaneDataDistributed ts_h_pert = t0_prog_h_pert;
+			PlaneDataDistributed ts_u = t0_prog_u;
+			PlaneDataDistributed ts_v = t0_prog_v;
+
+			timeSteppers.l_direct->run_timestep(
+					ts_h_pert, ts_u, ts_v,
+					simVars.timecontrol.current_simulation_time,	// time step size
+					0				// initial condition given at time 0
+			);
+
+			analytical_error_maxabs_h = (ts_h_pert-prog_h_pert).reduce_maxAbs();
+			analytical_error_maxabs_u = (ts_u-prog_u).reduce_maxAbs();
+			analytical_error_maxabs_v = (ts_v-prog_v).reduce_maxAbs();
+		}
+	}
+
+
+
+	/**
+	 * Collective output, the diagnostics are only written by the first rank
+	 */
+	bool timestep_do_output(
+			std::ostream &o_ostream = std::cout
+	)
+	{
+		if (simVars.iodata.output_each_sim_seconds < 0)
+			return false;
+
+		if (simVars.iodata.output_next_sim_seconds-simVars.iodata.output_next_sim_seconds*(1e-12) > simVars.timecontrol.current_simulation_time)
+			return false;
+
+		// Dump  data in csv, if output filename is not empty
+		if (simVars.iodata.output_file_name.size() > 0)
+		{
+			output_filenames = write_file(prog_h_pert, "prog_h_pert");
+			output_filenames += ";" + write_file(prog_u, "prog_u");
+			output_filenames += ";" + write_file(prog_v, "prog_v");
+
+			output_filenames += ";" + write_file(opDistributed.ke(prog_u, prog_v), "diag_ke");
+			output_filenames += ";" + write_file(opDistributed.vort(prog_u, prog_v), "diag_vort");
+			output_filenames += ";" + write_file(opDistributed.div(prog_u, prog_v), "diag_div");
+		}
+
+		if (simVars.misc.verbosity > 0)
+		{
+			update_diagnostics();
+			compute_errors();
+
+			if (planeDataConfigDistributed->mpi_rank == 0)
+			{
+				std::stringstream header;
+				std::stringstream rows;
+
+				rows << std::setprecision(16);
+
+				// Prefix
+				if (simVars.timecontrol.current_timestep_nr == 0)
+					header << "DATA";
+				rows << "DATA";
+
+				// Time
+				if (simVars.timecontrol.current_timestep_nr == 0)
+					header << "\tT";
+				rows << "\t" << simVars.timecontrol.current_simulation_time;
+
+				// Mass, Energy, Enstrophy
+				header << "\tTOTAL_MASS\tTOTAL_ENERGY\tPOT_ENSTROPHY";
+				rows << "\t" << simVars.diag.total_mass;
+				rows << "\t" << simVars.diag.total_energy;
+				rows << "\t" << simVars.diag.total_potential_enstrophy;
+
+				header << "\tTOTAL_MASS_REL_ERROR\tTOTAL_ENERGY_REL_ERROR\tPOT_ENSTROPHY_REL_ERROR";
+				rows << "\t" << std::abs((simVars.diag.total_mass-diagnostics_mass_start)/diagnostics_mass_start);
+				rows << "\t" << std::abs((simVars.diag.total_energy-diagnostics_energy_start)/diagnostics_energy_start);
+				rows << "\t" << std::abs((simVars.diag.total_potential_enstrophy-diagnostics_potential_entrophy_start)/diagnostics_potential_entrophy_start);
+
+				if (simVars.misc.compute_errors)
+				{
+					// Difference to initial condition
+					if (simVars.timecontrol.current_timestep_nr == 0)
+						header << "\tDIFF_MAXABS_H0\tDIFF_MAXABS_U0\tDIFF_MAXABS_V0";
+
+					rows << "\t" << t0_error_max_abs_h_pert << "\t" << t0_error_max_abs_u << "\t" << t0_error_max_abs_v;
+				}
+
+				if (compute_error_to_analytical_solution)
+				{
+					if (simVars.timecontrol.current_timestep_nr == 0)
+						header << "\tREF_DIFF_MAX_H\tREF_DIFF_MAX_U\tREF_DIFF_MAX_V";
+
+					rows << "\t" << analytical_error_maxabs_h << "\t" << analytical_error_maxabs_u << "\t" << analytical_error_maxabs_v;
+				}
+
+				if (simVars.timecontrol.current_timestep_nr == 0)
+					o_ostream << header.str() << std::endl;
+
+				o_ostream << rows.str() << std::endl;
+			}
+		}
+
+		if (simVars.iodata.output_next_sim_seconds == simVars.timecontrol.max_simulation_time)
+		{
+			simVars.iodata.output_next_sim_seconds = std::numeric_limits<double>::infinity();
+		}
+		else
+		{
+			while (simVars.iodata.output_next_sim_seconds-simVars.iodata.output_next_sim_seconds*(1e-12) <= simVars.timecontrol.current_simulation_time)
+				simVars.iodata.output_next_sim_seconds += simVars.iodata.output_each_sim_seconds;
+
+			if (simVars.iodata.output_next_sim_seconds > simVars.timecontrol.max_simulation_time)
+				simVars.iodata.output_next_sim_seconds = simVars.timecontrol.max_simulation_time;
+		}
+
+		return true;
+	}
+
+
+
+	bool should_quit()
+	{
+		if (
+				simVars.timecontrol.max_timesteps_nr != -1 &&
+				simVars.timecontrol.max_timesteps_nr <= simVars.timecontrol.current_timestep_nr
+		)
+			return true;
+
+		if (!std::isinf(simVars.timecontrol.max_simulation_time))
+			if (simVars.timecontrol.max_simulation_time <= simVars.timecontrol.current_simulation_time+simVars.timecontrol.max_simulation_time*1e-10)	// care about roundoff errors with 1e-10
+				return true;
+
+		return false;
+	}
+};
+
+
+
+/**
+ * Run the simulation with the plane data distributed over all ranks
+ */
+void run_distributed()
+{
+	PlaneDataConfigDistributed planeDataConfigDistributed;
+	planeDataConfigDistributed.setup(simVars.disc.space_res_physical, simVars.misc.reuse_spectral_transformation_plans);
+
+	int mpi_rank = planeDataConfigDistributed.mpi_rank;
+
+	if (mpi_rank == 0)
+	{
+		planeDataConfigDistributed.printInformation();
+
+		// Print header
+		std::cout << std::endl;
+		simVars.outputConfig();
+		std::cout << "Computing error: " << simVars.misc.compute_errors << std::endl;
+		std::cout << std::endl;
+	}
+
+	SimulationInstanceDistributed *simulationSWE = new SimulationInstanceDistributed(&planeDataConfigDistributed);
+
+	//Time counter
+	Stopwatch time;
+
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	// Start counting time
+	time.reset();
+	time.start();
+
+	// Main time loop
+	while (!simulationSWE->should_quit())
+		simulationSWE->run_timestep();
+
+	// Stop counting time
+	time.stop();
+
+	double wallclock_time = time();
+
+	simulationSWE->compute_errors();
+
+	if (mpi_rank == 0)
+	{
+		if (simVars.iodata.output_file_name.size() > 0)
+			std::cout << "[MULE] reference_filenames: " << simulationSWE->output_filenames << std::endl;
+
+		// End of run output results
+		std::cout << "***************************************************" << std::endl;
+		std::cout << "Wallclock time (seconds): " << wallclock_time << std::endl;
+		std::cout << "Number of time steps: " << simVars.timecontrol.current_timestep_nr << std::endl;
+		std::cout << "Time per time step: " << wallclock_time/(double)simVars.timecontrol.current_timestep_nr << " sec/ts" << std::endl;
+		std::cout << "Last time step size: " << simVars.timecontrol.current_timestep_size << std::endl;
+
+		if (simVars.misc.compute_errors)
+		{
+			std::cout << "[MULE] error_end_linf_h_pert: " << simulationSWE->t0_error_max_abs_h_pert << std::endl;
+			std::cout << "[MULE] error_end_linf_u: " << simulationSWE->t0_error_max_abs_u << std::endl;
+			std::cout << "[MULE] error_end_linf_v: " << simulationSWE->t0_error_max_abs_v << std::endl;
+		}
+
+		if (simulationSWE->compute_error_to_analytical_solution)
+		{
+			std::cout << "DIAGNOSTICS ANALYTICAL MAXABS H:\t" << simulationSWE->analytical_error_maxabs_h << std::endl;
+			std::cout << "DIAGNOSTICS ANALYTICAL MAXABS U:\t" << simulationSWE->analytical_error_maxabs_u << std::endl;
+			std::cout << "DIAGNOSTICS ANALYTICAL MAXABS V:\t" << simulationSWE->analytical_error_maxabs_v << std::endl;
+		}
+	}
+
+	delete simulationSWE;
+}
+
+#endif
+
+
+
 int main(int i_argc, char *i_argv[])
 {
 #if __MIC__
@@ -1388,10 +2041,28 @@ int main(int i_argc, char *i_argv[])
 	if (simVars.bogus.var[1] != "")
 		param_initial_freq_y_mul = atof(simVars.bogus.var[1].c_str());
 
+	if (simVars.disc.space_plane_distributed)
+	{
+#if SWEET_MPI && SWEET_USE_PLANE_SPECTRAL_SPACE
+		SimulationProfiler::getInstance().setup(simVars.misc.profiler, simVars.misc.profiler_trace_file_name);
+
+		run_distributed();
+
+		SimulationProfiler::getInstance().output();
+
+		MPI_Finalize();
+		return 0;
+#else
+		FatalError("Distributed plane data requires MPI and spectral space support");
+#endif
+	}
+
 	if (simVars.misc.verbosity > 5)
 		std::cout << " + Setting up FFT plans..." << std::flush;
 
 	planeDataConfigInstance.setupAuto(simVars.disc.space_res_physical, simVars.disc.space_res_spectral, simVars.misc.reuse_spectral_transformation_plans);
+	SimulationProfiler::getInstance().setup(simVars.misc.profiler, simVars.misc.profiler_trace_file_name);
+	KernelCounters::getInstance().setup();
 
 	if (simVars.misc.verbosity > 5)
 		std::cout << " done" << std::endl;
@@ -1498,6 +2169,15 @@ int main(int i_argc, char *i_argv[])
 
 			double wallclock_time = time();
 
+			// Write checkpoint of final state to allow continuing the simulation
+			if (simVars.iodata.checkpoint_file_name.length() > 0 && simVars.misc.normal_mode_analysis_generation == 0)
+				simulationSWE->checkpoint_write(simVars.iodata.checkpoint_file_name);
+
+			// Finish writing all pending output files
+			simulationSWE->outputWriter.shutdown();
+			simulationSWE->outputWriter.output();
+			simulationSWE->containerWriter.close();
+
 			if (simVars.iodata.output_file_name.size() > 0)
 				std::cout << "[MULE] reference_filenames: " << simulationSWE->output_filenames << std::endl;
 
@@ -1594,7 +2274,17 @@ int main(int i_argc, char *i_argv[])
 		if (mpi_rank == 0)
 			SWE_Plane_TS_l_rexi::MPI_quitWorkers(planeDataConfig);
 	}
+#endif
 
+	// Output of profiler reduced over all ranks on rank 0, trace files on all ranks
+	SimulationProfiler::getInstance().output();
+
+#if SWEET_MPI
+	if (mpi_rank == 0)
+#endif
+		KernelCounters::getInstance().output();
+
+#if SWEET_MPI
 	MPI_Finalize();
 #endif
 
@@ -15,6 +15,7 @@
 #include <sweet/SimulationVariables.hpp>
 #include <sweet/plane/PlaneOperators.hpp>
 #include <functional>
+#include <vector>
 #if SWEET_EIGEN
 #include <Eigen/Eigenvalues>
 #endif
@@ -43,6 +44,9 @@ public:
 		if (i_simVars.timecontrol.current_timestep_size <= 0)
 			FatalError("Normal mode analysis requires setting fixed time step size");
 
+		if (i_simVars.misc.normal_mode_analysis_batched > 0 && i_simVars.misc.normal_mode_analysis_generation != 4)
+			FatalError("Batched normal mode analysis on the plane is only supported for generation 4");
+
 		/*
 		 *
 		 * Mode-wise normal mode analysis
@@ -145,6 +149,51 @@ public:
 			//{
 			int r = 0;
 
+			/*
+			 * Batched mode: The linear operator doesn't couple different
+			 * wavenumbers. Hence, all modes are excited at once for each
+			 * prognostic variable and only 3 time steps are required.
+			 *
+			 * response[inner][outer] is the response of variable 'inner'
+			 * to the excitation of variable 'outer'.
+			 */
+			std::vector<std::vector<PlaneData>> response;
+
+			if (i_simVars.misc.normal_mode_analysis_batched > 0)
+			{
+				response.resize(number_of_prognostic_variables);
+
+				for (int outer_prog_id = 0; outer_prog_id < number_of_prognostic_variables; outer_prog_id++)
+				{
+					// reset time control
+					i_simVars.timecontrol.current_timestep_nr = 0;
+					i_simVars.timecontrol.current_simulation_time = 0;
+
+					for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
+						prog[inner_prog_id]->spectral_set_zero();
+
+					// activate all modes via real coefficient
+					for (std::size_t i = planeDataConfig->spectral_data_iteration_ranges[r][0][0]; i < planeDataConfig->spectral_data_iteration_ranges[r][0][1]; i++)
+					{
+						for (std::size_t j = planeDataConfig->spectral_data_iteration_ranges[r][1][0]; j < planeDataConfig->spectral_data_iteration_ranges[r][1][1]; j++)
+						{
+							prog[outer_prog_id]->p_spectral_set(j, i, 1.0);
+							if (j > 0)
+								prog[outer_prog_id]->p_spectral_set(planeDataConfig->spectral_data_size[1]-j, i, 1.0);
+						}
+					}
+
+					prog[outer_prog_id]->request_data_physical();
+					(i_class->*i_run_timestep_method)();
+
+					for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
+					{
+						prog[inner_prog_id]->request_data_spectral();
+						response[inner_prog_id].push_back(*prog[inner_prog_id]);
+					}
+				}
+			}
+
 			for (std::size_t i = planeDataConfig->spectral_data_iteration_ranges[r][0][0]; i < planeDataConfig->spectral_data_iteration_ranges[r][0][1]; i++)
 			{
 				std::cout << "." << std::flush;
@@ -154,46 +203,68 @@ public:
 					//std::cout << "Mode (i,j)= (" << i << " , " << j <<")"<< std::endl;
 
 
-					for (int outer_prog_id = 0; outer_prog_id < number_of_prognostic_variables; outer_prog_id++)
+					if (i_simVars.misc.normal_mode_analysis_batched > 0)
 					{
+						/*
+						 * compute
+						 * 1/dt * (U(t+1) - U(t))
+						 */
+						for (int outer_prog_id = 0; outer_prog_id < number_of_prognostic_variables; outer_prog_id++)
+						{
+							for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
+							{
+								std::complex<double> val = response[inner_prog_id][outer_prog_id].p_spectral_get(j, i);
 
-						// reset time control
-						i_simVars.timecontrol.current_timestep_nr = 0;
-						i_simVars.timecontrol.current_simulation_time = 0;
+								if (inner_prog_id == outer_prog_id)
+									val = val - 1.0;
 
-						for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
-							prog[inner_prog_id]->spectral_set_zero();
+								A(inner_prog_id,outer_prog_id) = val/eps;
+							}
+						}
+					}
+					else
+					{
+						for (int outer_prog_id = 0; outer_prog_id < number_of_prognostic_variables; outer_prog_id++)
+						{
 
-						// activate mode via real coefficient
-						prog[outer_prog_id]->p_spectral_set(j, i, 1.0);
-						//Activate the symetric couterpart of the mode (only needed if j>0 )
-						if (j > 0)
-							prog[outer_prog_id]->p_spectral_set(planeDataConfig->spectral_data_size[1]-j, i, 1.0);
+							// reset time control
+							i_simVars.timecontrol.current_timestep_nr = 0;
+							i_simVars.timecontrol.current_simulation_time = 0;
 
-						/*
-						 * RUN timestep
-						 */
-						prog[outer_prog_id]->request_data_physical();
-						(i_class->*i_run_timestep_method)();
+							for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
+								prog[inner_prog_id]->spectral_set_zero();
 
-						/*
-						 * compute
-						 * 1/dt * (U(t+1) - U(t))
-						 */
-						prog[outer_prog_id]->request_data_spectral();
+							// activate mode via real coefficient
+							prog[outer_prog_id]->p_spectral_set(j, i, 1.0);
+							//Activate the symetric couterpart of the mode (only needed if j>0 )
+							if (j > 0)
+								prog[outer_prog_id]->p_spectral_set(planeDataConfig->spectral_data_size[1]-j, i, 1.0);
+
+							/*
+							 * RUN timestep
+							 */
+							prog[outer_prog_id]->request_data_physical();
+							(i_class->*i_run_timestep_method)();
 
-						std::complex<double> val = prog[outer_prog_id]->p_spectral_get(j, i);
-						val = val - 1.0; //subtract U(0) from mode
-						prog[outer_prog_id]->p_spectral_set(j, i, val);
+							/*
+							 * compute
+							 * 1/dt * (U(t+1) - U(t))
+							 */
+							prog[outer_prog_id]->request_data_spectral();
 
-						for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
-							(*prog[inner_prog_id]) /= eps;
+							std::complex<double> val = prog[outer_prog_id]->p_spectral_get(j, i);
+							val = val - 1.0; //subtract U(0) from mode
+							prog[outer_prog_id]->p_spectral_set(j, i, val);
 
-						for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
-						{
-							A(inner_prog_id,outer_prog_id)=prog[inner_prog_id]->p_spectral_get(j, i);;
-						}
+							for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
+								(*prog[inner_prog_id]) /= eps;
+
+							for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
+							{
+								A(inner_prog_id,outer_prog_id)=prog[inner_prog_id]->p_spectral_get(j, i);;
+							}
 
+						}
 					}
 
 					//std::cout << "Lik matrix" << std::endl;
@@ -10,8 +10,11 @@
 
 #include <limits>
 #include <sweet/plane/PlaneData.hpp>
+#include <sweet/plane/PlaneDataDistributed.hpp>
+#include <sweet/FatalError.hpp>
 #include <sweet/plane/PlaneOperators.hpp>
 #include <sweet/SimulationVariables.hpp>
+#include <sweet/SWEETCheckpoint.hpp>
 
 
 class SWE_Plane_TS_interface
@@ -25,6 +28,50 @@ public:
 			double i_dt,		///< time step size
 			double i_sim_timestamp
 	) = 0;
+
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+	/**
+	 * Time step for plane data distributed over MPI ranks (see --space-plane-distributed).
+	 *
+	 * This has to be called by all ranks.
+	 */
+	virtual void run_timestep(
+			PlaneDataDistributed &io_h_pert,	///< prognostic variables
+			PlaneDataDistributed &io_u,	///< prognostic variables
+			PlaneDataDistributed &io_v,	///< prognostic variables
+
+			double i_dt,		///< time step size
+			double i_sim_timestamp
+	)
+	{
+		FatalError("This time stepper does not support distributed plane data");
+	}
+#endif
+
+
+	/**
+	 * Store internal state of time stepper (e.g. data of previous time steps) to checkpoint.
+	 *
+	 * Nothing needs to be done for single-step methods.
+	 */
+	virtual void checkpoint_write(
+			SWEETCheckpoint &io_checkpoint,
+			const std::string &i_prefix		///< prefix for names of checkpoint entries
+	)
+	{
+	}
+
+
+	/**
+	 * Load internal state of time stepper from checkpoint
+	 */
+	virtual void checkpoint_read(
+			const SWEETCheckpoint &i_checkpoint,
+			const std::string &i_prefix		///< prefix for names of checkpoint entries
+	)
+	{
+	}
 };
 
 #endif /* SRC_PROGRAMS_SWE_PLANE_REXI_SWE_PLANE_TS_INTERFACE_HPP_ */
@@ -72,16 +72,24 @@ public:
 	)
 	{
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
-		PlaneData laplacian = -i_gh0*op.diff2_c_x -i_gh0*op.diff2_c_y;
-		PlaneData lhs = laplacian.spectral_addScalarAll(i_kappa);
-
-		io_x = i_rhs.spectral_div_element_wise(lhs);
+		io_x = op.helmholtz_inverse(i_rhs, i_kappa, -i_gh0);
 #else
 		FatalError("Cannot use helmholtz_spectral_solver if spectral space not enable in compilation time");
 #endif
 	}
 
 
+	void checkpoint_write(
+			SWEETCheckpoint &io_checkpoint,
+			const std::string &i_prefix
+	);
+
+	void checkpoint_read(
+			const SWEETCheckpoint &i_checkpoint,
+			const std::string &i_prefix
+	);
+
+
 	virtual ~SWE_Plane_TS_l_cn_na_sl_nd_settls();
 };
 
@@ -98,48 +98,24 @@ void SWE_Plane_TS_l_direct::run_timestep_agrid(
 }
 
 
-#if SWEET_USE_PLANE_SPECTRAL_SPACE
-
 /**
- * This method computes the analytical solution based on the given initial values.
+ * Analytical solution of the linear SWE for a single spectral mode
  *
- * See Embid/Madja/1996, Terry/Beth/2014, page 16
- * and
- * 		doc/swe_solution_for_L/sympy_L_spec_decomposition.py
- * for the dimension full formulation.
+ * The wavenumbers k0 and k1 include the sign.
  */
-void SWE_Plane_TS_l_direct::run_timestep_agrid_planedata(
-		PlaneData &io_h_pert,	///< prognostic variables
-		PlaneData &io_u,	///< prognostic variables
-		PlaneData &io_v,	///< prognostic variables
-
-		double i_dt,		///< if this value is not equal to 0, use this time step size instead of computing one
-		double i_simulation_timestamp
+void SWE_Plane_TS_l_direct::p_solve_mode(
+		T k0,
+		T k1,
+		T dt,
+		std::complex<T> io_U[3]
 )
 {
-	if (simVars.disc.space_grid_use_c_staggering)
-		FatalError("Staggering not supported");
-
-	//if (i_dt < 0)
-	//	FatalError("SWE_Plane_TS_l_direct: Only constant time step size allowed (please set --dt )");
-
-
 	typedef std::complex<T> complex;
 	complex I(0.0, 1.0);
 
-	T dt = i_dt;
-
-
-	/*
-	 * This implementation works directly on PlaneData
-	 */
 	T s0 = simVars.sim.plane_domain_size[0];
 	T s1 = simVars.sim.plane_domain_size[1];
 
-	io_h_pert.request_data_spectral();
-	io_u.request_data_spectral();
-	io_v.request_data_spectral();
-
 	T f = simVars.sim.plane_rotating_f0;
 	T h = simVars.sim.h0;
 	T g = simVars.sim.gravitation;
@@ -147,265 +123,308 @@ void SWE_Plane_TS_l_direct::run_timestep_agrid_planedata(
 	T sqrt_h = rexiFunctions.l_sqrt(h);
 	T sqrt_g = rexiFunctions.l_sqrt(g);
 
+	complex b = -k0*I;	// d/dx exp(I*k0*x) = I*k0 exp(I*k0*x)
+	complex c = -k1*I;
 
-#if SWEET_THREADING_SPACE
-	SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD_COLLAPSE2
-#endif
-	for (std::size_t ik1 = 0; ik1 < io_h_pert.planeDataConfig->spectral_data_size[1]; ik1++)
+	b = b*rexiFunctions.pi2/s0;
+	c = c*rexiFunctions.pi2/s1;
+
+	/*
+	 * Matrix with Eigenvectors (column-wise)
+	 */
+	complex v[3][3];
+
+	/*
+	 * Eigenvalues
+	 */
+	complex lambda[3];
+
+	if (simVars.sim.plane_rotating_f0 == 0)
 	{
-		for (std::size_t ik0 = 0; ik0 < io_h_pert.planeDataConfig->spectral_data_size[0]; ik0++)
+		/*
+		 * http://www.wolframalpha.com/input/?i=eigenvector%7B%7B0,h*b,h*c%7D,%7Bg*b,0,0%7D,%7Bg*c,0,0%7D%7D
+		 */
+		if (k0 == 0 && k1 == 0)
 		{
-			T k1;
-			if (ik1 < io_h_pert.planeDataConfig->spectral_data_size[1]/2)
-				k1 = (T)ik1;
-			else
-				k1 = (T)((int)ik1-(int)io_h_pert.planeDataConfig->spectral_data_size[1]);
+			v[0][0] = 1;
+			v[1][0] = 0;
+			v[2][0] = 0;
 
-			T k0 = (T)ik0;
+			v[0][1] = 0;
+			v[1][1] = 1;
+			v[2][1] = 0;
 
-			complex U[3];
-			U[0] = io_h_pert.spectral_get(ik1, ik0);
-			U[1] = io_u.spectral_get(ik1, ik0);
-			U[2] = io_v.spectral_get(ik1, ik0);
+			v[0][2] = 0;
+			v[1][2] = 0;
+			v[2][2] = 1;
 
-			complex b = -k0*I;	// d/dx exp(I*k0*x) = I*k0 exp(I*k0*x)
-			complex c = -k1*I;
+			lambda[0] = 0;
+			lambda[1] = 0;
+			lambda[2] = 0;
+		}
+		else if (k0 == 0)
+		{
+			v[0][0] = 0;
+			v[1][0] = 1;
+			v[2][0] = 0;
 
-			b = b*rexiFunctions.pi2/s0;
-			c = c*rexiFunctions.pi2/s1;
+			v[0][1] = -sqrt_h/sqrt_g;
+			v[1][1] = 0;
+			v[2][1] = 1;
+
+			v[0][2] = sqrt_h/sqrt_g;
+			v[1][2] = 0;
+			v[2][2] = 1;
 
+			lambda[0] = 0;
+			lambda[1] = -c*sqrt_g*sqrt_h;
+			lambda[2] = c*sqrt_g*sqrt_h;;
+		}
+		else if (k1 == 0)
+		{
 			/*
-			 * Matrix with Eigenvectors (column-wise)
+			 * http://www.wolframalpha.com/input/?i=eigenvector%7B%7B0,h*b,h*c*0%7D,%7Bg*b,0,0%7D,%7Bg*c*0,0,0%7D%7D
 			 */
-			complex v[3][3];
 
+			v[0][0] = 0;
+			v[1][0] = 0;
+			v[2][0] = 1;
+
+			v[0][1] = -sqrt_h/sqrt_g;
+			v[1][1] = 1;
+			v[2][1] = 0;
+
+			v[0][2] = sqrt_h/sqrt_g;
+			v[1][2] = 1;
+			v[2][2] = 0;
+
+			lambda[0] = 0;
+			lambda[1] = -b*sqrt_g*sqrt_h;
+			lambda[2] = b*sqrt_g*sqrt_h;
+		}
+		else
+		{
+			v[0][0] = 0;
+			v[1][0] = -c/b;
+			v[2][0] = 1.0;
+
+			v[0][1] = -(sqrt_h*rexiFunctions.l_sqrtcplx(b*b + c*c))/(c*sqrt_g);
+			v[1][1] = b/c;
+			v[2][1] = 1.0;
+
+			v[0][2] = (sqrt_h*rexiFunctions.l_sqrtcplx(b*b + c*c))/(c*sqrt_g);
+			v[1][2] = b/c;
+			v[2][2] = 1.0;
+
+			lambda[0] = 0.0;
+			lambda[1] = -rexiFunctions.l_sqrtcplx(b*b + c*c)*sqrt_h*sqrt_g;
+			lambda[2] = rexiFunctions.l_sqrtcplx(b*b + c*c)*sqrt_h*sqrt_g;
+		}
+	}
+	else
+	{
+		if (k0 == 0 && k1 == 0)
+		{
 			/*
-			 * Eigenvalues
+			 * http://www.wolframalpha.com/input/?i=eigenvector%7B%7B0,0,0%7D,%7B0,0,f%7D,%7B0,-f,0%7D%7D
 			 */
-			complex lambda[3];
+			v[0][0] = 0;
+			v[1][0] = -I;
+			v[2][0] = 1;
 
-			if (simVars.sim.plane_rotating_f0 == 0)
-			{
-				/*
-				 * http://www.wolframalpha.com/input/?i=eigenvector%7B%7B0,h*b,h*c%7D,%7Bg*b,0,0%7D,%7Bg*c,0,0%7D%7D
-				 */
-				if (k0 == 0 && k1 == 0)
-				{
-					v[0][0] = 1;
-					v[1][0] = 0;
-					v[2][0] = 0;
+			v[0][1] = 0;
+			v[1][1] = I;
+			v[2][1] = 1;
 
-					v[0][1] = 0;
-					v[1][1] = 1;
-					v[2][1] = 0;
+			v[0][2] = 1;
+			v[1][2] = 0;
+			v[2][2] = 0;
 
-					v[0][2] = 0;
-					v[1][2] = 0;
-					v[2][2] = 1;
+			lambda[0] = I*f;
+			lambda[1] = -I*f;
+			lambda[2] = 0;
+		}
+		else if (k0 == 0)
+		{
+			/*
+			 * http://www.wolframalpha.com/input/?i=eigenvector%7B%7B0,h*b*0,h*c%7D,%7Bg*b*0,0,f%7D,%7Bg*c,-f,0%7D%7D
+			 */
+			v[0][0] = f/(c*g);
+			v[1][0] = 1;
+			v[2][0] = 0;
 
-					lambda[0] = 0;
-					lambda[1] = 0;
-					lambda[2] = 0;
-				}
-				else if (k0 == 0)
-				{
-					v[0][0] = 0;
-					v[1][0] = 1;
-					v[2][0] = 0;
+			v[0][1] = -(c*h)/rexiFunctions.l_sqrtcplx(-f*f + c*c*g*h);
+			v[1][1] =  -f/rexiFunctions.l_sqrtcplx(-f*f + c*c*g*h);
+			v[2][1] = 1;
 
-					v[0][1] = -sqrt_h/sqrt_g;
-					v[1][1] = 0;
-					v[2][1] = 1;
+			v[0][2] = (c*h)/rexiFunctions.l_sqrtcplx(-f*f + c*c*g*h);
+			v[1][2] = f/rexiFunctions.l_sqrtcplx(-f*f + c*c*g*h);
+			v[2][2] = 1;
 
-					v[0][2] = sqrt_h/sqrt_g;
-					v[1][2] = 0;
-					v[2][2] = 1;
+			lambda[0] = 0;
+			lambda[1] = -rexiFunctions.l_sqrtcplx(c*c*g*h-f*f);
+			lambda[2] = rexiFunctions.l_sqrtcplx(c*c*g*h-f*f);
+		}
+		else if (k1 == 0)
+		{
+			/*
+			 * http://www.wolframalpha.com/input/?i=eigenvector%7B%7B0,h*b,h*c*0%7D,%7Bg*b,0,f%7D,%7Bg*c*0,-f,0%7D%7D
+			 */
+			v[0][0] = -f/(b*g);
+			v[1][0] = 0;
+			v[2][0] = 1;
 
-					lambda[0] = 0;
-					lambda[1] = -c*sqrt_g*sqrt_h;
-					lambda[2] = c*sqrt_g*sqrt_h;;
-				}
-				else if (k1 == 0)
-				{
-					/*
-					 * http://www.wolframalpha.com/input/?i=eigenvector%7B%7B0,h*b,h*c*0%7D,%7Bg*b,0,0%7D,%7Bg*c*0,0,0%7D%7D
-					 */
+			v[0][1] = -(b*h)/f;
+			v[1][1] = rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h)/f;
+			v[2][1] = 1;
 
-					v[0][0] = 0;
-					v[1][0] = 0;
-					v[2][0] = 1;
+			v[0][2] = -(b*h)/f;
+			v[1][2] = -rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h)/f;
+			v[2][2] = 1;
 
-					v[0][1] = -sqrt_h/sqrt_g;
-					v[1][1] = 1;
-					v[2][1] = 0;
+			lambda[0] = 0;
+			lambda[1] = -rexiFunctions.l_sqrtcplx(b*b*g*h-f*f);
+			lambda[2] = rexiFunctions.l_sqrtcplx(b*b*g*h-f*f);
+		}
+		else
+		{
+			/*
+			 * Compute EV's of
+			 * Linear operator
+			 *
+			 * [ 0  hb  hc ]
+			 * [ gb  0   f ]
+			 * [ gc -f   0 ]
+			 *
+			 * http://www.wolframalpha.com/input/?i=eigenvector%7B%7B0,h*b,h*c%7D,%7Bg*b,0,f%7D,%7Bg*c,-f,0%7D%7D
+			 */
 
-					v[0][2] = sqrt_h/sqrt_g;
-					v[1][2] = 1;
-					v[2][2] = 0;
+			v[0][0] = -f/(b*g);
+			v[1][0] = -c/b;
+			v[2][0] = 1.0;
 
-					lambda[0] = 0;
-					lambda[1] = -b*sqrt_g*sqrt_h;
-					lambda[2] = b*sqrt_g*sqrt_h;
-				}
-				else
-				{
-					v[0][0] = 0;
-					v[1][0] = -c/b;
-					v[2][0] = 1.0;
+			v[0][1] = -(c*f*h + b*h*rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h + c*c*g*h))/(b*c*g*h + f*rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h + c*c*g*h));
+			v[1][1] = -(f*f - b*b*g*h)/(b*c*g*h + f*rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h + c*c*g*h));
+			v[2][1] = 1.0;
 
-					v[0][1] = -(sqrt_h*rexiFunctions.l_sqrtcplx(b*b + c*c))/(c*sqrt_g);
-					v[1][1] = b/c;
-					v[2][1] = 1.0;
+			v[0][2] = -(-c*f*h + b*h*rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h + c*c*g*h))/(-b*c*g*h + f*rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h + c*c*g*h));
+			v[1][2] =  -(-f*f + b*b*g*h)/(-b*c*g*h + f*rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h + c*c*g*h));
+			v[2][2] = 1.0;
 
-					v[0][2] = (sqrt_h*rexiFunctions.l_sqrtcplx(b*b + c*c))/(c*sqrt_g);
-					v[1][2] = b/c;
-					v[2][2] = 1.0;
+			lambda[0] = 0.0;
+			lambda[1] = -rexiFunctions.l_sqrtcplx(b*b*g*h + c*c*g*h - f*f);
+			lambda[2] =  rexiFunctions.l_sqrtcplx(b*b*g*h + c*c*g*h - f*f);
+		}
+	}
 
-					lambda[0] = 0.0;
-					lambda[1] = -rexiFunctions.l_sqrtcplx(b*b + c*c)*sqrt_h*sqrt_g;
-					lambda[2] = rexiFunctions.l_sqrtcplx(b*b + c*c)*sqrt_h*sqrt_g;
-				}
-			}
-			else
-			{
-				if (k0 == 0 && k1 == 0)
-				{
-					/*
-					 * http://www.wolframalpha.com/input/?i=eigenvector%7B%7B0,0,0%7D,%7B0,0,f%7D,%7B0,-f,0%7D%7D
-					 */
-					v[0][0] = 0;
-					v[1][0] = -I;
-					v[2][0] = 1;
+	/*
+	 * Invert Eigenvalue matrix
+	 */
+	complex v_inv[3][3];
 
-					v[0][1] = 0;
-					v[1][1] = I;
-					v[2][1] = 1;
+	v_inv[0][0] =  (v[1][1]*v[2][2] - v[1][2]*v[2][1]);
+	v_inv[0][1] = -(v[0][1]*v[2][2] - v[0][2]*v[2][1]);
+	v_inv[0][2] =  (v[0][1]*v[1][2] - v[0][2]*v[1][1]);
 
-					v[0][2] = 1;
-					v[1][2] = 0;
-					v[2][2] = 0;
+	v_inv[1][0] = -(v[1][0]*v[2][2] - v[1][2]*v[2][0]);
+	v_inv[1][1] =  (v[0][0]*v[2][2] - v[0][2]*v[2][0]);
+	v_inv[1][2] = -(v[0][0]*v[1][2] - v[0][2]*v[1][0]);
 
-					lambda[0] = I*f;
-					lambda[1] = -I*f;
-					lambda[2] = 0;
-				}
-				else if (k0 == 0)
-				{
-					/*
-					 * http://www.wolframalpha.com/input/?i=eigenvector%7B%7B0,h*b*0,h*c%7D,%7Bg*b*0,0,f%7D,%7Bg*c,-f,0%7D%7D
-					 */
-					v[0][0] = f/(c*g);
-					v[1][0] = 1;
-					v[2][0] = 0;
+	v_inv[2][0] =  (v[1][0]*v[2][1] - v[1][1]*v[2][0]);
+	v_inv[2][1] = -(v[0][0]*v[2][1] - v[0][1]*v[2][0]);
+	v_inv[2][2] =  (v[0][0]*v[1][1] - v[0][1]*v[1][0]);
 
-					v[0][1] = -(c*h)/rexiFunctions.l_sqrtcplx(-f*f + c*c*g*h);
-					v[1][1] =  -f/rexiFunctions.l_sqrtcplx(-f*f + c*c*g*h);
-					v[2][1] = 1;
+	complex s = v[0][0]*v_inv[0][0] + v[0][1]*v_inv[1][0] + v[0][2]*v_inv[2][0];
 
-					v[0][2] = (c*h)/rexiFunctions.l_sqrtcplx(-f*f + c*c*g*h);
-					v[1][2] = f/rexiFunctions.l_sqrtcplx(-f*f + c*c*g*h);
-					v[2][2] = 1;
+	for (int j = 0; j < 3; j++)
+		for (int i = 0; i < 3; i++)
+			v_inv[j][i] /= s;
 
-					lambda[0] = 0;
-					lambda[1] = -rexiFunctions.l_sqrtcplx(c*c*g*h-f*f);
-					lambda[2] = rexiFunctions.l_sqrtcplx(c*c*g*h-f*f);
-				}
-				else if (k1 == 0)
-				{
-					/*
-					 * http://www.wolframalpha.com/input/?i=eigenvector%7B%7B0,h*b,h*c*0%7D,%7Bg*b,0,f%7D,%7Bg*c*0,-f,0%7D%7D
-					 */
-					v[0][0] = -f/(b*g);
-					v[1][0] = 0;
-					v[2][0] = 1;
+	complex UEV[3] = {0.0, 0.0, 0.0};
+	for (int k = 0; k < 3; k++)
+		for (int j = 0; j < 3; j++)
+			UEV[k] += v_inv[k][j] * io_U[j];
 
-					v[0][1] = -(b*h)/f;
-					v[1][1] = rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h)/f;
-					v[2][1] = 1;
 
-					v[0][2] = -(b*h)/f;
-					v[1][2] = -rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h)/f;
-					v[2][2] = 1;
+	for (int k = 0; k < 3; k++)
+	{
+		std::complex<T> &lam = lambda[k];
 
-					lambda[0] = 0;
-					lambda[1] = -rexiFunctions.l_sqrtcplx(b*b*g*h-f*f);
-					lambda[2] = rexiFunctions.l_sqrtcplx(b*b*g*h-f*f);
-				}
-				else
-				{
-					/*
-					 * Compute EV's of
-					 * Linear operator
-					 *
-					 * [ 0  hb  hc ]
-					 * [ gb  0   f ]
-					 * [ gc -f   0 ]
-					 *
-					 * http://www.wolframalpha.com/input/?i=eigenvector%7B%7B0,h*b,h*c%7D,%7Bg*b,0,f%7D,%7Bg*c,-f,0%7D%7D
-					 */
+		std::complex<T> K = rexiFunctions.eval(lam*dt);
 
-					v[0][0] = -f/(b*g);
-					v[1][0] = -c/b;
-					v[2][0] = 1.0;
+		UEV[k] = K*UEV[k];
+	}
 
-					v[0][1] = -(c*f*h + b*h*rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h + c*c*g*h))/(b*c*g*h + f*rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h + c*c*g*h));
-					v[1][1] = -(f*f - b*b*g*h)/(b*c*g*h + f*rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h + c*c*g*h));
-					v[2][1] = 1.0;
+	for (int k = 0; k < 3; k++)
+		io_U[k] = 0.0;
 
-					v[0][2] = -(-c*f*h + b*h*rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h + c*c*g*h))/(-b*c*g*h + f*rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h + c*c*g*h));
-					v[1][2] =  -(-f*f + b*b*g*h)/(-b*c*g*h + f*rexiFunctions.l_sqrtcplx(-f*f + b*b*g*h + c*c*g*h));
-					v[2][2] = 1.0;
+	for (int k = 0; k < 3; k++)
+		for (int j = 0; j < 3; j++)
+			io_U[k] += v[k][j] * UEV[j];
+}
 
-					lambda[0] = 0.0;
-					lambda[1] = -rexiFunctions.l_sqrtcplx(b*b*g*h + c*c*g*h - f*f);
-					lambda[2] =  rexiFunctions.l_sqrtcplx(b*b*g*h + c*c*g*h - f*f);
-				}
-			}
 
-			/*
-			 * Invert Eigenvalue matrix
-			 */
-			complex v_inv[3][3];
 
-			v_inv[0][0] =  (v[1][1]*v[2][2] - v[1][2]*v[2][1]);
-			v_inv[0][1] = -(v[0][1]*v[2][2] - v[0][2]*v[2][1]);
-			v_inv[0][2] =  (v[0][1]*v[1][2] - v[0][2]*v[1][1]);
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
 
-			v_inv[1][0] = -(v[1][0]*v[2][2] - v[1][2]*v[2][0]);
-			v_inv[1][1] =  (v[0][0]*v[2][2] - v[0][2]*v[2][0]);
-			v_inv[1][2] = -(v[0][0]*v[1][2] - v[0][2]*v[1][0]);
+/**
+ * This method computes the analytical solution based on the given initial values.
+ *
+ * See Embid/Madja/1996, Terry/Beth/2014, page 16
+ * and
+ * 		doc/swe_solution_for_L/sympy_L_spec_decomposition.py
+ * for the dimension full formulation.
+ */
+void SWE_Plane_TS_l_direct::run_timestep_agrid_planedata(
+		PlaneData &io_h_pert,	///< prognostic variables
+		PlaneData &io_u,	///< prognostic variables
+		PlaneData &io_v,	///< prognostic variables
 
-			v_inv[2][0] =  (v[1][0]*v[2][1] - v[1][1]*v[2][0]);
-			v_inv[2][1] = -(v[0][0]*v[2][1] - v[0][1]*v[2][0]);
-			v_inv[2][2] =  (v[0][0]*v[1][1] - v[0][1]*v[1][0]);
+		double i_dt,		///< if this value is not equal to 0, use this time step size instead of computing one
+		double i_simulation_timestamp
+)
+{
+	if (simVars.disc.space_grid_use_c_staggering)
+		FatalError("Staggering not supported");
 
-			complex s = v[0][0]*v_inv[0][0] + v[0][1]*v_inv[1][0] + v[0][2]*v_inv[2][0];
+	//if (i_dt < 0)
+	//	FatalError("SWE_Plane_TS_l_direct: Only constant time step size allowed (please set --dt )");
 
-			for (int j = 0; j < 3; j++)
-				for (int i = 0; i < 3; i++)
-					v_inv[j][i] /= s;
 
-			complex UEV[3] = {0.0, 0.0, 0.0};
-			for (int k = 0; k < 3; k++)
-				for (int j = 0; j < 3; j++)
-					UEV[k] += v_inv[k][j] * U[j];
+	typedef std::complex<T> complex;
 
+	T dt = i_dt;
 
-			for (int k = 0; k < 3; k++)
-			{
-				std::complex<T> &lam = lambda[k];
 
-				std::complex<T> K = rexiFunctions.eval(lam*dt);
+	/*
+	 * This implementation works directly on PlaneData
+	 */
+	io_h_pert.request_data_spectral();
+	io_u.request_data_spectral();
+	io_v.request_data_spectral();
 
-				UEV[k] = K*UEV[k];
-			}
 
-			for (int k = 0; k < 3; k++)
-				U[k] = 0.0;
+#if SWEET_THREADING_SPACE
+	SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD_COLLAPSE2
+#endif
+	for (std::size_t ik1 = 0; ik1 < io_h_pert.planeDataConfig->spectral_data_size[1]; ik1++)
+	{
+		for (std::size_t ik0 = 0; ik0 < io_h_pert.planeDataConfig->spectral_data_size[0]; ik0++)
+		{
+			T k1;
+			if (ik1 < io_h_pert.planeDataConfig->spectral_data_size[1]/2)
+				k1 = (T)ik1;
+			else
+				k1 = (T)((int)ik1-(int)io_h_pert.planeDataConfig->spectral_data_size[1]);
 
-			for (int k = 0; k < 3; k++)
-				for (int j = 0; j < 3; j++)
-					U[k] += v[k][j] * UEV[j];
+			T k0 = (T)ik0;
+
+			complex U[3];
+			U[0] = io_h_pert.spectral_get(ik1, ik0);
+			U[1] = io_u.spectral_get(ik1, ik0);
+			U[2] = io_v.spectral_get(ik1, ik0);
+
+			p_solve_mode(k0, k1, dt, U);
 
 
 #if SWEET_QUADMATH
@@ -430,6 +449,81 @@ void SWE_Plane_TS_l_direct::run_timestep_agrid_planedata(
 	io_v.spectral_zeroAliasingModes();
 }
 
+
+
+/**
+ * Analytical solution on MPI distributed data
+ *
+ * Each rank only processes its local block of wavenumbers in x-direction.
+ */
+void SWE_Plane_TS_l_direct::run_timestep(
+		PlaneDataDistributed &io_h_pert,	///< prognostic variables
+		PlaneDataDistributed &io_u,	///< prognostic variables
+		PlaneDataDistributed &io_v,	///< prognostic variables
+
+		double i_dt,
+		double i_simulation_timestamp
+)
+{
+	if (simVars.disc.space_grid_use_c_staggering)
+		FatalError("Staggering not supported");
+
+	typedef std::complex<T> complex;
+
+	T dt = i_dt;
+
+	io_h_pert.request_data_spectral();
+	io_u.request_data_spectral();
+	io_v.request_data_spectral();
+
+	const PlaneDataConfigDistributed *config = io_h_pert.planeDataConfig;
+	std::size_t ny = config->spectral_data_size[1];
+
+#if SWEET_THREADING_SPACE
+	SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD_COLLAPSE2
+#endif
+	for (std::size_t ikx = 0; ikx < config->spectral_local_kx_size; ikx++)
+	{
+		for (std::size_t ik1 = 0; ik1 < ny; ik1++)
+		{
+			T k1;
+			if (ik1 < ny/2)
+				k1 = (T)ik1;
+			else
+				k1 = (T)((int)ik1-(int)ny);
+
+			T k0 = (T)(config->spectral_local_kx_start + ikx);
+
+			std::size_t idx = ikx*ny + ik1;
+
+			complex U[3];
+			U[0] = io_h_pert.spectral_space_data[idx];
+			U[1] = io_u.spectral_space_data[idx];
+			U[2] = io_v.spectral_space_data[idx];
+
+			p_solve_mode(k0, k1, dt, U);
+
+#if SWEET_QUADMATH
+			io_h_pert.spectral_space_data[idx] = std::complex<double>(U[0].real(), U[0].imag());
+			io_u.spectral_space_data[idx] = std::complex<double>(U[1].real(), U[1].imag());
+			io_v.spectral_space_data[idx] = std::complex<double>(U[2].real(), U[2].imag());
+#else
+			io_h_pert.spectral_space_data[idx] = U[0];
+			io_u.spectral_space_data[idx] = U[1];
+			io_v.spectral_space_data[idx] = U[2];
+#endif
+		}
+	}
+
+	io_h_pert.physical_space_data_valid = false;
+	io_u.physical_space_data_valid = false;
+	io_v.physical_space_data_valid = false;
+
+	io_h_pert.spectral_zeroAliasingModes();
+	io_u.spectral_zeroAliasingModes();
+	io_v.spectral_zeroAliasingModes();
+}
+
 #endif
 
 
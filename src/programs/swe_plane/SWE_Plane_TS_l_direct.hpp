@@ -10,6 +10,7 @@
 
 #include <limits>
 #include <sweet/plane/PlaneData.hpp>
+#include <sweet/plane/PlaneDataDistributed.hpp>
 #include <sweet/plane/PlaneDataSampler.hpp>
 #include <sweet/SimulationVariables.hpp>
 #include <sweet/plane/PlaneOperators.hpp>
@@ -42,6 +43,13 @@ class SWE_Plane_TS_l_direct	: public SWE_Plane_TS_interface
 
 	PlaneDataGridMapping planeDataGridMapping;
 
+	void p_solve_mode(
+			T k0,
+			T k1,
+			T dt,
+			std::complex<T> io_U[3]
+	);
+
 #if 0
 
 #if SWEET_QUADMATH
@@ -187,6 +195,18 @@ public:
 
 
 
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+	void run_timestep(
+			PlaneDataDistributed &io_h,	///< prognostic variables
+			PlaneDataDistributed &io_u,	///< prognostic variables
+			PlaneDataDistributed &io_v,	///< prognostic variables
+
+			double i_dt,
+			double i_simulation_timestamp = -1
+	);
+#endif
+
+
 	void run_timestep_agrid_planedatacomplex(
 			PlaneData &io_h,	///< prognostic variables
 			PlaneData &io_u,	///< prognostic variables
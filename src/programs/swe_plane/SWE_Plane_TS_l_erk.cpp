@@ -12,6 +12,36 @@
 #include "SWE_Plane_TS_l_erk.hpp"
 
 
+
+template <typename T_PlaneData, typename T_PlaneOperators>
+void SWE_Plane_TS_l_erk::p_euler_timestep_update_agrid(
+		const T_PlaneOperators &i_op,
+
+		const T_PlaneData &i_h,	///< prognostic variables
+		const T_PlaneData &i_u,	///< prognostic variables
+		const T_PlaneData &i_v,	///< prognostic variables
+
+		T_PlaneData &o_h_t,	///< time updates
+		T_PlaneData &o_u_t,	///< time updates
+		T_PlaneData &o_v_t	///< time updates
+)
+{
+	/*
+	 * linearized non-conservative (advective) formulation:
+	 *
+	 * h_t = -h0*u_x - h0*v_ym
+	 * u_t = -g * h_x + f*v
+	 * v_t = -g * h_y - f*u
+	 */
+
+	o_u_t = -simVars.sim.gravitation*i_op.diff_c_x(i_h) + simVars.sim.plane_rotating_f0*i_v;
+	o_v_t = -simVars.sim.gravitation*i_op.diff_c_y(i_h) - simVars.sim.plane_rotating_f0*i_u;
+
+	// standard update
+	o_h_t = -(i_op.diff_c_x(i_u) + i_op.diff_c_y(i_v))*simVars.sim.h0;
+}
+
+
 /*
  * Main routine for method to be used in case of finite differences
  */
@@ -30,20 +60,8 @@ void SWE_Plane_TS_l_erk::euler_timestep_update(
 	// A- grid method
 	if (!simVars.disc.space_grid_use_c_staggering)
 	{
-		/*
-		 * linearized non-conservative (advective) formulation:
-		 *
-		 * h_t = -h0*u_x - h0*v_ym
-		 * u_t = -g * h_x + f*v
-		 * v_t = -g * h_y - f*u
-		 */
-
 #if 1
-		o_u_t = -simVars.sim.gravitation*op.diff_c_x(i_h) + simVars.sim.plane_rotating_f0*i_v;
-		o_v_t = -simVars.sim.gravitation*op.diff_c_y(i_h) - simVars.sim.plane_rotating_f0*i_u;
-
-		// standard update
-		o_h_t = -(op.diff_c_x(i_u) + op.diff_c_y(i_v))*simVars.sim.h0;
+		p_euler_timestep_update_agrid(op, i_h, i_u, i_v, o_h_t, o_u_t, o_v_t);
 #else
 
 	#if 0
@@ -142,6 +160,57 @@ void SWE_Plane_TS_l_erk::run_timestep(
 
 
 
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+
+void SWE_Plane_TS_l_erk::euler_timestep_update(
+		const PlaneDataDistributed &i_h,	///< prognostic variables
+		const PlaneDataDistributed &i_u,	///< prognostic variables
+		const PlaneDataDistributed &i_v,	///< prognostic variables
+
+		PlaneDataDistributed &o_h_t,	///< time updates
+		PlaneDataDistributed &o_u_t,	///< time updates
+		PlaneDataDistributed &o_v_t,	///< time updates
+
+		double i_simulation_timestamp
+)
+{
+	p_euler_timestep_update_agrid(opDistributed, i_h, i_u, i_v, o_h_t, o_u_t, o_v_t);
+}
+
+
+
+void SWE_Plane_TS_l_erk::run_timestep(
+		PlaneDataDistributed &io_h,	///< prognostic variables
+		PlaneDataDistributed &io_u,	///< prognostic variables
+		PlaneDataDistributed &io_v,	///< prognostic variables
+
+		double i_dt,
+		double i_simulation_timestamp
+)
+{
+	if (i_dt <= 0)
+		FatalError("SWE_Plane_TS_l_erk: Only constant time step size allowed (please set --dt)");
+
+	if (simVars.disc.space_grid_use_c_staggering)
+		FatalError("SWE_Plane_TS_l_erk: Staggering not supported for distributed plane data");
+
+	if (opDistributed.planeDataConfig != io_h.planeDataConfig)
+		opDistributed.setup(io_h.planeDataConfig, simVars.sim.plane_domain_size);
+
+	timestepping_rk_distributed.run_timestep(
+			this,
+			&SWE_Plane_TS_l_erk::euler_timestep_update,	///< pointer to function to compute euler time step updates
+			io_h, io_u, io_v,
+			i_dt,
+			timestepping_order,
+			i_simulation_timestamp
+		);
+}
+
+#endif
+
+
+
 /*
  * Setup
  */
@@ -150,7 +219,15 @@ void SWE_Plane_TS_l_erk::setup(
 )
 {
 	timestepping_order = i_order;
-	timestepping_rk.setupBuffers(op.planeDataConfig, timestepping_order);
+	timestepping_rk.setLowStorage(simVars.disc.timestepping_rk_low_storage);
+
+	// No serial plane data is used for distributed plane data
+	if (op.planeDataConfig != nullptr)
+		timestepping_rk.setupBuffers(op.planeDataConfig, timestepping_order);
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+	timestepping_rk_distributed.setLowStorage(simVars.disc.timestepping_rk_low_storage);
+#endif
 
 	//if (simVars.disc.use_staggering)
 	//	FatalError("Staggering not supported for l_erk");
@@ -172,6 +172,8 @@ void SWE_Plane_TS_l_erk_n_erk::setup(
 {
 	timestepping_order = i_order;
 	timestepping_order2 = i_order2;
+	timestepping_rk_linear.setLowStorage(simVars.disc.timestepping_rk_low_storage);
+	timestepping_rk_nonlinear.setLowStorage(simVars.disc.timestepping_rk_low_storage);
 	use_only_linear_divergence = i_use_only_linear_divergence;
 
 	if (timestepping_order != timestepping_order2)
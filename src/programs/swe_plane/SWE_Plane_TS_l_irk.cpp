@@ -61,12 +61,11 @@ void SWE_Plane_TS_l_irk::run_timestep(
 
 	PlaneData rhs =
 			(kappa/alpha) * eta0
-			- eta_bar*(op.diff_c_x(u0) + op.diff_c_y(v0))
-			- (simVars.sim.plane_rotating_f0*eta_bar/alpha) * (op.diff_c_x(v0) - op.diff_c_y(u0))
+			- eta_bar*op.div(u0, v0)
+			- (simVars.sim.plane_rotating_f0*eta_bar/alpha) * op.vort(u0, v0)
 		;
 
-	PlaneData lhs = (-g*eta_bar*(op.diff2_c_x + op.diff2_c_y)).spectral_addScalarAll(kappa);
-	io_h = rhs.spectral_div_element_wise(lhs);
+	io_h = op.helmholtz_inverse(rhs, kappa, -g*eta_bar);
 
 	PlaneData uh = u0 - g*op.diff_c_x(io_h);
 	PlaneData vh = v0 - g*op.diff_c_y(io_h);
@@ -94,12 +93,11 @@ void SWE_Plane_TS_l_irk::run_timestep(
 
 	PlaneDataComplex rhs =
 			(kappa/alpha) * eta0
-			- eta_bar*(opComplex.diff_c_x(u0) + opComplex.diff_c_y(v0))
-			- (simVars.sim.plane_rotating_f0*eta_bar/alpha) * (opComplex.diff_c_x(v0) - opComplex.diff_c_y(u0))
+			- eta_bar*opComplex.div(u0, v0)
+			- (simVars.sim.plane_rotating_f0*eta_bar/alpha) * opComplex.vort(u0, v0)
 		;
 
-	PlaneDataComplex lhs = (-g*eta_bar*(opComplex.diff2_c_x + opComplex.diff2_c_y)).spectral_addScalarAll(kappa);
-	PlaneDataComplex eta = rhs.spectral_div_element_wise(lhs);
+	PlaneDataComplex eta = opComplex.helmholtz_inverse(rhs, kappa, -g*eta_bar);
 
 	PlaneDataComplex uh = u0 - g*opComplex.diff_c_x(eta);
 	PlaneDataComplex vh = v0 - g*opComplex.diff_c_y(eta);
@@ -14,6 +14,7 @@
 
 #include <sweet/plane/Convert_PlaneData_to_PlaneDataComplex.hpp>
 #include <sweet/plane/Convert_PlaneDataComplex_to_PlaneData.hpp>
+#include <sweet/SimulationProfiler.hpp>
 
 
 #if SWEET_THREADING_SPACE || SWEET_THREADING_TIME_REXI
@@ -56,6 +57,30 @@ void SWE_Plane_TS_l_rexi::setup(
 
 	std::cout << "Number of total REXI coefficients N = " << rexi_alpha.size() << std::endl;
 
+	std::size_t N = rexi_alpha.size();
+
+	threadGroups.setup(rexiSimVars->thread_groups, (N + num_mpi_ranks - 1)/num_mpi_ranks);
+
+	p_setup_thread_groups();
+
+#if SWEET_REXI_TIMINGS
+	stopwatch_preprocessing.reset();
+	stopwatch_broadcast.reset();
+	stopwatch_reduce.reset();
+	stopwatch_solve_rexi_terms.reset();
+#endif
+}
+
+
+
+/**
+ * Setup the per-thread-group data for the current split of threads
+ */
+void SWE_Plane_TS_l_rexi::p_setup_thread_groups()
+{
+	num_local_rexi_par_threads = threadGroups.num_groups;
+	num_global_threads = num_local_rexi_par_threads * num_mpi_ranks;
+
 	std::size_t N = rexi_alpha.size();
 	block_size = N/num_global_threads;
 	if (block_size*num_global_threads != N)
@@ -91,7 +116,7 @@ void SWE_Plane_TS_l_rexi::setup(
 	for (int j = 0; j < num_local_rexi_par_threads; j++)
 	{
 #if SWEET_THREADING_TIME_REXI
-#	pragma omp parallel for schedule(static,1) default(none) shared(planeDataConfig_local, std::cout,j)
+#	pragma omp parallel for schedule(static,1) default(none) shared(planeDataConfig_local, std::cout,j) num_threads(num_local_rexi_par_threads)
 #endif
 		for (int i = 0; i < num_local_rexi_par_threads; i++)
 		{
@@ -118,6 +143,12 @@ void SWE_Plane_TS_l_rexi::setup(
 			perThreadVars[i]->h_sum.setup(planeDataConfig_local);
 			perThreadVars[i]->u_sum.setup(planeDataConfig_local);
 			perThreadVars[i]->v_sum.setup(planeDataConfig_local);
+
+#if SWEET_COMPLEX_SPLIT
+			perThreadVars[i]->h_sum_split.setup(planeDataConfig_local->spectral_complex_array_data_number_of_elements);
+			perThreadVars[i]->u_sum_split.setup(planeDataConfig_local->spectral_complex_array_data_number_of_elements);
+			perThreadVars[i]->v_sum_split.setup(planeDataConfig_local->spectral_complex_array_data_number_of_elements);
+#endif
 		}
 	}
 
@@ -129,7 +160,7 @@ void SWE_Plane_TS_l_rexi::setup(
 
 	for (int i = 0; i < num_local_rexi_par_threads; i++)
 	{
-		if (perThreadVars[i]->op.diff_c_x.physical_space_data == nullptr)
+		if (!perThreadVars[i]->op.diff_c_x.isSetup())
 		{
 			std::cerr << "ARRAY NOT INITIALIZED!!!!" << std::endl;
 			exit(-1);
@@ -137,7 +168,7 @@ void SWE_Plane_TS_l_rexi::setup(
 	}
 
 #if SWEET_THREADING_TIME_REXI
-#	pragma omp parallel for schedule(static,1) default(none)  shared(planeDataConfig_local, std::cout)
+#	pragma omp parallel for schedule(static,1) default(none)  shared(planeDataConfig_local, std::cout) num_threads(num_local_rexi_par_threads)
 #endif
 	for (int i = 0; i < num_local_rexi_par_threads; i++)
 	{
@@ -171,15 +202,47 @@ void SWE_Plane_TS_l_rexi::setup(
 		perThreadVars[i]->u_sum.spectral_set_all(0, 0);
 		perThreadVars[i]->v_sum.spectral_set_all(0, 0);
 
+#if SWEET_COMPLEX_SPLIT
+		perThreadVars[i]->h_sum_split.set_zero();
+		perThreadVars[i]->u_sum_split.set_zero();
+		perThreadVars[i]->v_sum_split.set_zero();
+#endif
 	}
+}
 
 
-#if SWEET_REXI_TIMINGS
-	stopwatch_preprocessing.reset();
-	stopwatch_broadcast.reset();
-	stopwatch_reduce.reset();
-	stopwatch_solve_rexi_terms.reset();
-#endif
+
+/**
+ * Determine the split of threads into groups by running REXI time steps
+ */
+void SWE_Plane_TS_l_rexi::p_calibrate_thread_groups(
+		const PlaneData &i_h_pert,
+		const PlaneData &i_u,
+		const PlaneData &i_v,
+		double i_dt,
+		double i_simulation_timestamp
+)
+{
+	PlaneData h_pert = i_h_pert;
+	PlaneData u = i_u;
+	PlaneData v = i_v;
+
+	PlaneData o_h_pert(i_h_pert.planeDataConfig);
+	PlaneData o_u(i_u.planeDataConfig);
+	PlaneData o_v(i_v.planeDataConfig);
+
+	threadGroups.calibrate(
+			"rexi",
+			[&]()
+			{
+				p_setup_thread_groups();
+			},
+			[&]()
+			{
+				run_timestep_real(h_pert, u, v, o_h_pert, o_u, o_v, i_dt, i_simulation_timestamp);
+			},
+			simVars.misc.verbosity
+		);
 }
 
 
@@ -218,6 +281,8 @@ void SWE_Plane_TS_l_rexi::run_timestep_real(
 {
 	final_timestep = false;
 
+	SWEET_PROFILER_REGION("rexi");
+
 	if (rexi_use_direct_solution)
 	{
 		o_h_pert = i_h_pert;
@@ -230,6 +295,9 @@ void SWE_Plane_TS_l_rexi::run_timestep_real(
 	if (i_dt <= 0)
 		FatalError("Only constant time step size allowed");
 
+	if (threadGroups.isCalibrationPending())
+		p_calibrate_thread_groups(i_h_pert, i_u, i_v, i_dt, i_simulation_timestamp);
+
 
 	typedef std::complex<double> complex;
 
@@ -278,11 +346,15 @@ void SWE_Plane_TS_l_rexi::run_timestep_real(
 
 
 
+	REXI_ThreadGroupPlanner::NestedRegion nested(threadGroups);
+
 #if SWEET_THREADING_TIME_REXI
-#	pragma omp parallel for schedule(static,1) default(none) shared(i_dt, i_h_pert, i_u, i_v, max_N, std::cout, std::cerr)
+#	pragma omp parallel for schedule(static,1) default(none) shared(i_dt, i_h_pert, i_u, i_v, max_N, std::cout, std::cerr) num_threads(num_local_rexi_par_threads)
 #endif
 	for (int i = 0; i < num_local_rexi_par_threads; i++)
 	{
+		threadGroups.setupGroupThread();
+
 #if SWEET_REXI_TIMINGS
 		bool stopwatch_measure = false;
 	#if SWEET_THREADING_TIME_REXI
@@ -313,9 +385,19 @@ void SWE_Plane_TS_l_rexi::run_timestep_real(
 		PlaneDataComplex &eta = perThreadVars[i]->eta;
 
 
+#if SWEET_COMPLEX_SPLIT
+		SplitComplexArray &h_sum_split = perThreadVars[i]->h_sum_split;
+		SplitComplexArray &u_sum_split = perThreadVars[i]->u_sum_split;
+		SplitComplexArray &v_sum_split = perThreadVars[i]->v_sum_split;
+
+		h_sum_split.set_zero();
+		u_sum_split.set_zero();
+		v_sum_split.set_zero();
+#else
 		h_sum.spectral_set_zero();
 		u_sum.spectral_set_zero();
 		v_sum.spectral_set_zero();
+#endif
 
 
 #if !SWEET_USE_PLANE_SPECTRAL_SPACE
@@ -381,10 +463,8 @@ void SWE_Plane_TS_l_rexi::run_timestep_real(
 		//
 		// (kappa + lhs_a)\eta = kappa/alpha*\eta_0 - (i_parameters.sim.f0*eta_bar/alpha) * rhs_b + rhs_a
 		//
-		PlaneDataComplex rhs_a = eta_bar*(opc.diff_c_x(u0) + opc.diff_c_y(v0));
-		PlaneDataComplex rhs_b = (opc.diff_c_x(v0) - opc.diff_c_y(u0));
-
-		PlaneDataComplex lhs_a = (-g*eta_bar)*(perThreadVars[i]->op.diff2_c_x + perThreadVars[i]->op.diff2_c_y);
+		PlaneDataComplex rhs_a = eta_bar*opc.div(u0, v0);
+		PlaneDataComplex rhs_b = opc.vort(u0, v0);
 
 #if SWEET_REXI_TIMINGS
 		if (stopwatch_measure)
@@ -398,6 +478,8 @@ void SWE_Plane_TS_l_rexi::run_timestep_real(
 
 		for (std::size_t n = start; n < end; n++)
 		{
+			SWEET_PROFILER_REGION("rexi_term");
+
 			// load alpha (a) and scale by inverse of tau
 			complex alpha = rexi_alpha[n]/i_dt;
 			complex beta = rexi_beta[n];
@@ -410,20 +492,27 @@ void SWE_Plane_TS_l_rexi::run_timestep_real(
 				 */
 				PlaneDataComplex rhs =
 						eta0*alpha
-						+ eta_bar*(opc.diff_c_x(u0) + opc.diff_c_y(v0))
+						+ rhs_a
 					;
 
-				PlaneDataComplex lhs_a = (-g*eta_bar)*(perThreadVars[i]->op.diff2_c_x + perThreadVars[i]->op.diff2_c_y);
-				PlaneDataComplex lhs = lhs_a.spectral_addScalarAll(alpha*alpha);
-
-				eta = rhs.spectral_div_element_wise(lhs);
+				eta = opc.helmholtz_inverse(rhs, alpha*alpha, -g*eta_bar);
 
 				PlaneDataComplex u1 = (u0 + g*opc.diff_c_x(eta))*(1.0/alpha);
 				PlaneDataComplex v1 = (v0 + g*opc.diff_c_y(eta))*(1.0/alpha);
 
+#if SWEET_COMPLEX_SPLIT
+				eta.request_data_spectral();
+				u1.request_data_spectral();
+				v1.request_data_spectral();
+
+				h_sum_split.axpy(beta, eta.spectral_space_data);
+				u_sum_split.axpy(beta, u1.spectral_space_data);
+				v_sum_split.axpy(beta, v1.spectral_space_data);
+#else
 				h_sum += eta*beta;
 				u_sum += u1*beta;
 				v_sum += v1*beta;
+#endif
 			}
 			else
 			{
@@ -440,8 +529,7 @@ void SWE_Plane_TS_l_rexi::run_timestep_real(
 						+ rhs_a
 					;
 
-				PlaneDataComplex lhs = lhs_a.spectral_addScalarAll(kappa);
-				eta = rhs.spectral_div_element_wise(lhs);
+				eta = opc.helmholtz_inverse(rhs, kappa, -g*eta_bar);
 
 				PlaneDataComplex uh = u0 + g*opc.diff_c_x(eta);
 				PlaneDataComplex vh = v0 + g*opc.diff_c_y(eta);
@@ -451,12 +539,40 @@ void SWE_Plane_TS_l_rexi::run_timestep_real(
 
 				PlaneData tmp(h_sum.planeDataConfig);
 
+#if SWEET_COMPLEX_SPLIT
+				eta.request_data_spectral();
+				u1.request_data_spectral();
+				v1.request_data_spectral();
+
+				h_sum_split.axpy(beta, eta.spectral_space_data);
+				u_sum_split.axpy(beta, u1.spectral_space_data);
+				v_sum_split.axpy(beta, v1.spectral_space_data);
+#else
 				h_sum += eta*beta;
 				u_sum += u1*beta;
 				v_sum += v1*beta;
+#endif
 			}
 		}
 
+#if SWEET_COMPLEX_SPLIT
+		/*
+		 * Convert the sums back to interleaved spectral data
+		 */
+		h_sum_split.storeInterleaved(h_sum.spectral_space_data);
+		u_sum_split.storeInterleaved(u_sum.spectral_space_data);
+		v_sum_split.storeInterleaved(v_sum.spectral_space_data);
+
+		for (PlaneDataComplex *sum : {&h_sum, &u_sum, &v_sum})
+		{
+			sum->spectral_space_data_valid = true;
+			sum->physical_space_data_valid = false;
+
+			// the sums include all modes of the REXI terms
+			sum->spectral_zeroAliasingModes();
+		}
+#endif
+
 #if SWEET_REXI_TIMINGS
 		if (stopwatch_measure)
 			stopwatch_solve_rexi_terms.stop();
@@ -512,9 +628,16 @@ void SWE_Plane_TS_l_rexi::run_timestep_real(
 
 		PlaneData tmp(planeDataConfig);
 
+#if SWEET_COMPLEX_SPLIT
+		// Same conversion as without threading over the REXI terms
+		o_h_pert = o_h_pert + Convert_PlaneDataComplex_To_PlaneData::spectral_convert_real_part(perThreadVars[n]->h_sum);
+		o_u = o_u + Convert_PlaneDataComplex_To_PlaneData::spectral_convert_real_part(perThreadVars[n]->u_sum);
+		o_v = o_v + Convert_PlaneDataComplex_To_PlaneData::spectral_convert_real_part(perThreadVars[n]->v_sum);
+#else
 		o_h_pert = o_h_pert + Convert_PlaneDataComplex_To_PlaneData::spectral_convert_physical_real_only(perThreadVars[n]->h_sum);
 		o_u = o_u + Convert_PlaneDataComplex_To_PlaneData::spectral_convert_physical_real_only(perThreadVars[n]->u_sum);
 		o_v = o_v + Convert_PlaneDataComplex_To_PlaneData::spectral_convert_physical_real_only(perThreadVars[n]->v_sum);
+#endif
 	}
 #endif
 
@@ -528,6 +651,14 @@ void SWE_Plane_TS_l_rexi::run_timestep_real(
 
 #else
 
+#if SWEET_COMPLEX_SPLIT
+	/*
+	 * Real part of the sums in spectral space (also for half poles)
+	 */
+	o_h_pert = Convert_PlaneDataComplex_To_PlaneData::spectral_convert_real_part(perThreadVars[0]->h_sum);
+	o_u = Convert_PlaneDataComplex_To_PlaneData::spectral_convert_real_part(perThreadVars[0]->u_sum);
+	o_v = Convert_PlaneDataComplex_To_PlaneData::spectral_convert_real_part(perThreadVars[0]->v_sum);
+#else
 // TODO: find a nice solution for this
 //		if (simVars.rexi.use_half_poles)
 	if (true)
@@ -543,6 +674,7 @@ void SWE_Plane_TS_l_rexi::run_timestep_real(
 		o_v = Convert_PlaneDataComplex_To_PlaneData::spectral_convert_physical_real_only(perThreadVars[0]->v_sum);
 	}
 #endif
+#endif
 
 
 	if (rexi_gamma.real() != 0)
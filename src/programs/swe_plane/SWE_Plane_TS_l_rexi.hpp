@@ -16,6 +16,7 @@
 #include <sweet/plane/PlaneDataComplex.hpp>
 #include <sweet/plane/PlaneOperatorsComplex.hpp>
 #include <sweet/plane/PlaneOperators.hpp>
+#include <rexi/REXI_ThreadGroupPlanner.hpp>
 #include "SWE_Plane_TS_interface.hpp"
 #include "SWE_Plane_TS_l_direct.hpp"
 
@@ -72,12 +73,22 @@ class SWE_Plane_TS_l_rexi	: public SWE_Plane_TS_interface
 		PlaneDataComplex h_sum;
 		PlaneDataComplex u_sum;
 		PlaneDataComplex v_sum;
+
+#if SWEET_COMPLEX_SPLIT
+		/// Sums over the REXI terms with split real and imaginary parts
+		SplitComplexArray h_sum_split;
+		SplitComplexArray u_sum_split;
+		SplitComplexArray v_sum_split;
+#endif
 	};
 
 	/// per-thread allocated variables to avoid NUMA domain effects
 	std::vector<PerThreadVars*> perThreadVars;
 
-	/// number of threads to be used
+	/// split of threads into groups of REXI terms with a team of threads each
+	REXI_ThreadGroupPlanner threadGroups;
+
+	/// number of thread groups to be used
 	int num_local_rexi_par_threads;
 
 	/// number of mpi ranks to be used
@@ -163,6 +174,17 @@ public:
 
 	void cleanup();
 
+private:
+	void p_setup_thread_groups();
+
+	void p_calibrate_thread_groups(
+			const PlaneData &i_h_pert,
+			const PlaneData &i_u,
+			const PlaneData &i_v,
+			double i_dt,
+			double i_simulation_timestamp
+	);
+
 
 
 public:
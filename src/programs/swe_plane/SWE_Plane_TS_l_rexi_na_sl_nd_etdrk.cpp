@@ -433,6 +433,33 @@ SWE_Plane_TS_l_rexi_na_sl_nd_etdrk::SWE_Plane_TS_l_rexi_na_sl_nd_etdrk(
 
 
 
+/*
+ * Store data of previous time step which is required for the extrapolation
+ */
+void SWE_Plane_TS_l_rexi_na_sl_nd_etdrk::checkpoint_write(
+		SWEETCheckpoint &io_checkpoint,
+		const std::string &i_prefix
+)
+{
+	h_prev.checkpoint_write(io_checkpoint, i_prefix+"h_prev");
+	u_prev.checkpoint_write(io_checkpoint, i_prefix+"u_prev");
+	v_prev.checkpoint_write(io_checkpoint, i_prefix+"v_prev");
+}
+
+
+
+void SWE_Plane_TS_l_rexi_na_sl_nd_etdrk::checkpoint_read(
+		const SWEETCheckpoint &i_checkpoint,
+		const std::string &i_prefix
+)
+{
+	h_prev.checkpoint_read(i_checkpoint, i_prefix+"h_prev");
+	u_prev.checkpoint_read(i_checkpoint, i_prefix+"u_prev");
+	v_prev.checkpoint_read(i_checkpoint, i_prefix+"v_prev");
+}
+
+
+
 SWE_Plane_TS_l_rexi_na_sl_nd_etdrk::~SWE_Plane_TS_l_rexi_na_sl_nd_etdrk()
 {
 }
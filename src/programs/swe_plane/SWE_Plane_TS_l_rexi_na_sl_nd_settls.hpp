@@ -72,6 +72,17 @@ public:
 
 
 
+	void checkpoint_write(
+			SWEETCheckpoint &io_checkpoint,
+			const std::string &i_prefix
+	);
+
+	void checkpoint_read(
+			const SWEETCheckpoint &i_checkpoint,
+			const std::string &i_prefix
+	);
+
+
 	virtual ~SWE_Plane_TS_l_rexi_na_sl_nd_settls();
 };
 
@@ -14,6 +14,54 @@
 #include "../swe_plane/SWE_Plane_TS_ln_erk.hpp"
 
 
+
+template <typename T_PlaneData, typename T_PlaneOperators>
+void SWE_Plane_TS_ln_erk::p_euler_timestep_update_agrid(
+		const T_PlaneOperators &i_op,
+
+		const T_PlaneData &i_h,	///< prognostic variables (perturbed part of height)
+		const T_PlaneData &i_u,	///< prognostic variables
+		const T_PlaneData &i_v,	///< prognostic variables
+
+		T_PlaneData &o_h_t,	///< time updates
+		T_PlaneData &o_u_t,	///< time updates
+		T_PlaneData &o_v_t	///< time updates
+)
+{
+	/*
+	 * non-conservative (advective) formulation:
+	 *
+	 *	h_t = -(u*h)_x - (v*h)_y
+	 *	u_t = -g * h_x - u * u_x - v * u_y + f*v
+	 *	v_t = -g * h_y - u * v_x - v * v_y - f*u
+	 */
+
+	T_PlaneData total_h = i_h + simVars.sim.h0;
+
+	o_u_t = -simVars.sim.gravitation*i_op.diff_c_x(total_h) - i_u*i_op.diff_c_x(i_u) - i_v*i_op.diff_c_y(i_u);
+	o_v_t = -simVars.sim.gravitation*i_op.diff_c_y(total_h) - i_u*i_op.diff_c_x(i_v) - i_v*i_op.diff_c_y(i_v);
+
+	o_u_t += simVars.sim.plane_rotating_f0*i_v;
+	o_v_t -= simVars.sim.plane_rotating_f0*i_u;
+
+	// standard update
+	/*
+	 * P UPDATE
+	 */
+	if (!use_only_linear_divergence){ //full nonlinear divergence
+		// standard update
+		//o_h_t = -op.diff_f_x(U) - op.diff_f_y(V);
+		o_h_t = -i_op.diff_c_x(i_u*total_h) - i_op.diff_c_y(i_v*total_h);
+	}
+	else // use linear divergence
+	{
+		//o_h_t = -op.diff_f_x(simVars.sim.h0*i_u) - op.diff_f_y(simVars.sim.h0*i_v);
+		o_h_t = -i_u*i_op.diff_c_x(total_h) - i_v*i_op.diff_c_y(total_h) + //nonlinear adv
+				-i_op.diff_c_x(i_u*simVars.sim.h0) - i_op.diff_c_y(i_v*simVars.sim.h0); //linear div
+	}
+}
+
+
 /*
  * Main routine for method to be used in case of finite differences
  *
@@ -36,38 +84,7 @@ void SWE_Plane_TS_ln_erk::euler_timestep_update(
 	// A-grid method
 	if (!simVars.disc.space_grid_use_c_staggering)
 	{
-		/*
-		 * non-conservative (advective) formulation:
-		 *
-		 *	h_t = -(u*h)_x - (v*h)_y
-		 *	u_t = -g * h_x - u * u_x - v * u_y + f*v
-		 *	v_t = -g * h_y - u * v_x - v * v_y - f*u
-		 */
-
-		PlaneData total_h = i_h + simVars.sim.h0;
-
-		o_u_t = -simVars.sim.gravitation*op.diff_c_x(total_h) - i_u*op.diff_c_x(i_u) - i_v*op.diff_c_y(i_u);
-		o_v_t = -simVars.sim.gravitation*op.diff_c_y(total_h) - i_u*op.diff_c_x(i_v) - i_v*op.diff_c_y(i_v);
-
-		o_u_t += simVars.sim.plane_rotating_f0*i_v;
-		o_v_t -= simVars.sim.plane_rotating_f0*i_u;
-
-		// standard update
-		/*
-		 * P UPDATE
-		 */
-		if (!use_only_linear_divergence){ //full nonlinear divergence
-			// standard update
-			//o_h_t = -op.diff_f_x(U) - op.diff_f_y(V);
-			o_h_t = -op.diff_c_x(i_u*total_h) - op.diff_c_y(i_v*total_h);
-		}
-		else // use linear divergence
-		{
-			//o_h_t = -op.diff_f_x(simVars.sim.h0*i_u) - op.diff_f_y(simVars.sim.h0*i_v);
-			o_h_t = -i_u*op.diff_c_x(total_h) - i_v*op.diff_c_y(total_h) + //nonlinear adv
-					-op.diff_c_x(i_u*simVars.sim.h0) - op.diff_c_y(i_v*simVars.sim.h0); //linear div
-		}
-
+		p_euler_timestep_update_agrid(op, i_h, i_u, i_v, o_h_t, o_u_t, o_v_t);
 	}
 	else // simVars.disc.use_staggering = true
 	{
@@ -177,6 +194,57 @@ void SWE_Plane_TS_ln_erk::run_timestep(
 
 
 
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+
+void SWE_Plane_TS_ln_erk::euler_timestep_update(
+		const PlaneDataDistributed &i_h,	///< prognostic variables
+		const PlaneDataDistributed &i_u,	///< prognostic variables
+		const PlaneDataDistributed &i_v,	///< prognostic variables
+
+		PlaneDataDistributed &o_h_t,	///< time updates
+		PlaneDataDistributed &o_u_t,	///< time updates
+		PlaneDataDistributed &o_v_t,	///< time updates
+
+		double i_simulation_timestamp
+)
+{
+	p_euler_timestep_update_agrid(opDistributed, i_h, i_u, i_v, o_h_t, o_u_t, o_v_t);
+}
+
+
+
+void SWE_Plane_TS_ln_erk::run_timestep(
+		PlaneDataDistributed &io_h,	///< prognostic variables
+		PlaneDataDistributed &io_u,	///< prognostic variables
+		PlaneDataDistributed &io_v,	///< prognostic variables
+
+		double i_dt,
+		double i_simulation_timestamp
+)
+{
+	if (i_dt <= 0)
+		FatalError("SWE_Plane_TS_ln_erk: Only constant time step size allowed");
+
+	if (simVars.disc.space_grid_use_c_staggering)
+		FatalError("SWE_Plane_TS_ln_erk: Staggering not supported for distributed plane data");
+
+	if (opDistributed.planeDataConfig != io_h.planeDataConfig)
+		opDistributed.setup(io_h.planeDataConfig, simVars.sim.plane_domain_size);
+
+	timestepping_rk_distributed.run_timestep(
+			this,
+			&SWE_Plane_TS_ln_erk::euler_timestep_update,	///< pointer to function to compute euler time step updates
+			io_h, io_u, io_v,
+			i_dt,
+			timestepping_order,
+			i_simulation_timestamp
+		);
+}
+
+#endif
+
+
+
 /*
  * Setup
  */
@@ -186,6 +254,10 @@ void SWE_Plane_TS_ln_erk::setup(
 )
 {
 	timestepping_order = i_order;
+	timestepping_rk.setLowStorage(simVars.disc.timestepping_rk_low_storage);
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+	timestepping_rk_distributed.setLowStorage(simVars.disc.timestepping_rk_low_storage);
+#endif
 	use_only_linear_divergence = i_use_only_linear_divergence;
 }
 
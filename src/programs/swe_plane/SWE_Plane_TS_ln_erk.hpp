@@ -13,6 +13,8 @@
 #include <sweet/plane/PlaneDataTimesteppingExplicitRK.hpp>
 #include <sweet/SimulationVariables.hpp>
 #include <sweet/plane/PlaneOperators.hpp>
+#include <sweet/plane/PlaneDataDistributed.hpp>
+#include <sweet/plane/PlaneOperatorsDistributed.hpp>
 
 #include "../swe_plane/SWE_Plane_TS_interface.hpp"
 
@@ -28,7 +30,29 @@ class SWE_Plane_TS_ln_erk	: public SWE_Plane_TS_interface
 
 	bool use_only_linear_divergence;
 
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+	// Operators and RK buffers for distributed plane data, set up with the first time step
+	PlaneOperatorsDistributed opDistributed;
+	PlaneDataDistributedTimesteppingExplicitRK timestepping_rk_distributed;
+#endif
+
 private:
+	/**
+	 * Time tendencies on the A-grid, shared by PlaneData and PlaneDataDistributed
+	 */
+	template <typename T_PlaneData, typename T_PlaneOperators>
+	void p_euler_timestep_update_agrid(
+			const T_PlaneOperators &i_op,
+
+			const T_PlaneData &i_h,	///< prognostic variables
+			const T_PlaneData &i_u,	///< prognostic variables
+			const T_PlaneData &i_v,	///< prognostic variables
+
+			T_PlaneData &o_h_t,	///< time updates
+			T_PlaneData &o_u_t,	///< time updates
+			T_PlaneData &o_v_t	///< time updates
+	);
+
 	void euler_timestep_update(
 			const PlaneData &i_h,	///< prognostic variables
 			const PlaneData &i_u,	///< prognostic variables
@@ -41,6 +65,20 @@ private:
 			double i_simulation_timestamp = -1
 	);
 
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+	void euler_timestep_update(
+			const PlaneDataDistributed &i_h,	///< prognostic variables
+			const PlaneDataDistributed &i_u,	///< prognostic variables
+			const PlaneDataDistributed &i_v,	///< prognostic variables
+
+			PlaneDataDistributed &o_h_t,	///< time updates
+			PlaneDataDistributed &o_u_t,	///< time updates
+			PlaneDataDistributed &o_v_t,	///< time updates
+
+			double i_simulation_timestamp = -1
+	);
+#endif
+
 public:
 	SWE_Plane_TS_ln_erk(
 			SimulationVariables &i_simVars,
@@ -61,6 +99,17 @@ public:
 			double i_simulation_timestamp = -1
 	);
 
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+	void run_timestep(
+			PlaneDataDistributed &io_h,	///< prognostic variables
+			PlaneDataDistributed &io_u,	///< prognostic variables
+			PlaneDataDistributed &io_v,	///< prognostic variables
+
+			double i_dt,
+			double i_simulation_timestamp = -1
+	);
+#endif
+
 
 
 	virtual ~SWE_Plane_TS_ln_erk();
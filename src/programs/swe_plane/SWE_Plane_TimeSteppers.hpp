@@ -52,6 +52,9 @@ public:
 
 	bool linear_only = false;
 
+	/// Time stepper also supports PlaneDataDistributed (see --space-plane-distributed)
+	bool supports_distributed = false;
+
 	SWE_Plane_TimeSteppers()
 	{
 	}
@@ -154,6 +157,8 @@ public:
 	{
 		reset();
 
+		supports_distributed = false;
+
 		/// Always allocate analytical solution
 		l_direct = new SWE_Plane_TS_l_direct(i_simVars, i_op);
 
@@ -165,6 +170,7 @@ public:
 			master = &(SWE_Plane_TS_interface&)*ln_erk;
 
 			linear_only = false;
+			supports_distributed = true;
 		}
 		if (i_timestepping_method == "ln_erk")
 		{
@@ -174,6 +180,7 @@ public:
 			master = &(SWE_Plane_TS_interface&)*ln_erk;
 
 			linear_only = false;
+			supports_distributed = true;
 		}
 		else if (i_timestepping_method == "l_rexi_ld_na_etdrk")
 		{
@@ -221,6 +228,7 @@ public:
 			master = &(SWE_Plane_TS_interface&)*l_erk;
 
 			linear_only = true;
+			supports_distributed = true;
 		}
 		else if (i_timestepping_method == "l_erk_na_nd2_erk")
 		{
@@ -422,6 +430,7 @@ public:
 			master = &(SWE_Plane_TS_interface&)*l_direct;
 
 			linear_only = true;
+			supports_distributed = true;
 		}
 		else //Help menu with list of schemes
 		{
@@ -17,18 +17,35 @@
 #include <sweet/sphere/SphereData_Spectral.hpp>
 #include <sweet/sphere/SphereData_Physical.hpp>
 #include <sweet/sphere/SphereHelpers_Diagnostics.hpp>
+#include <sweet/sphere/SphereHelpers_InSituDiagnostics.hpp>
 
 
 #include <sweet/sphere/SphereOperators_SphereData.hpp>
 #include <sweet/sphere/SphereOperators_SphereDataComplex.hpp>
 #include <sweet/sphere/SphereData_SpectralComplex.hpp>
+#include <sweet/sphere/SphereData_ConfigDistributed.hpp>
+#include <sweet/sphere/SphereData_SpectralDistributed.hpp>
+#include <sweet/sphere/SphereOperators_SphereDataDistributed.hpp>
 #include <sweet/Stopwatch.hpp>
 #include <sweet/FatalError.hpp>
 
 #include "swe_sphere/SWE_Sphere_TimeSteppers.hpp"
 #include "swe_sphere/SWE_Sphere_NormalModeAnalysis.hpp"
+#include "swe_sphere/SWE_Sphere_Ensemble.hpp"
 
 #include <sweet/SimulationBenchmarkTiming.hpp>
+#include <sweet/BackgroundOutputWriter.hpp>
+#include <sweet/SWEETDataContainer.hpp>
+#include <sweet/SWEETCheckpoint.hpp>
+#include <sweet/TimesteppingAdaptiveController.hpp>
+#include <sweet/TimesteppingExplicitRKTableau.hpp>
+#include <sweet/SimulationProfiler.hpp>
+#include <sweet/KernelCounters.hpp>
+#include <sweet/sphere/app_swe/SWESphBandedMatrixPhysicalReal.hpp>
+#include <sweet/sphere/app_swe/SWESphBandedMatrixPhysicalComplex.hpp>
+#include <sweet/sphere/app_swe/SWESphImplicitOperatorCache.hpp>
+
+#include <random>
 
 
 
@@ -80,6 +97,15 @@ public:
 
 	SphereHelpers_Diagnostics sphereDiagnostics;
 
+	// Diagnostics computed in each time step
+	SphereHelpers_InSituDiagnostics insituDiagnostics;
+
+	// Adaptive time step size control
+	TimesteppingAdaptiveController adaptiveTimestepController;
+
+	// Time step size proposed by the adaptive time step size control
+	double adaptive_next_timestep_size;
+
 #if SWEET_MPI
 	int mpi_rank;
 #endif
@@ -89,8 +115,19 @@ public:
 
 	SWESphereBenchmarksCombined sphereBenchmarks;
 
+	// Write output files in background
+	BackgroundOutputWriter outputWriter;
+
+	// Single file container for output file mode 'container'
+	SWEETDataContainerWriter containerWriter;
+
+	// Id of ensemble member (see SWE_Sphere_Ensemble), -1 if not running an ensemble
+	int ensemble_member_id;
+
 public:
-	SimulationInstance()	:
+	SimulationInstance(
+			int i_ensemble_member_id = -1
+	)	:
 		op(sphereDataConfig, simVars.sim.sphere_radius),
 		op_nodealiasing(sphereDataConfig_nodealiasing, simVars.sim.sphere_radius),
 		prog_phi(sphereDataConfig),
@@ -104,7 +141,9 @@ public:
 				sphereDataConfig,
 				simVars,
 				simVars.misc.verbosity
-		)
+		),
+		adaptive_next_timestep_size(-1),
+		ensemble_member_id(i_ensemble_member_id)
 	{
 #if SWEET_MPI
 		MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
@@ -114,6 +153,31 @@ public:
 
 
 
+	/**
+	 * Add random perturbation to geopotential of ensemble members
+	 *
+	 * The random numbers only depend on the random seed and the member id,
+	 * hence each member is reproducible. Member 0 is the unperturbed control run.
+	 */
+	void ensemble_perturb_initial_conditions()
+	{
+		if (ensemble_member_id <= 0 || simVars.misc.ensemble_perturbation == 0)
+			return;
+
+		std::mt19937_64 generator((std::uint64_t)simVars.benchmark.random_seed*1000003ull + (std::uint64_t)ensemble_member_id);
+		std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+		double amplitude = simVars.misc.ensemble_perturbation*simVars.sim.gravitation*simVars.sim.h0;
+
+		SphereData_Physical phi_perturbation(sphereDataConfig);
+		for (int i = 0; i < sphereDataConfig->physical_array_data_number_of_elements; i++)
+			phi_perturbation.physical_space_data[i] = amplitude*distribution(generator);
+
+		prog_phi += SphereData_Spectral(phi_perturbation);
+	}
+
+
+
 	void update_diagnostics()
 	{
 		// assure, that the diagnostics are only updated for new time steps
@@ -167,16 +231,62 @@ public:
 			prog_div.load_nodealiasing(prog_div_nodealiasing);
 		}
 
+		ensemble_perturb_initial_conditions();
+
 
 		/*
 		 * SETUP time steppers
 		 */
 		timeSteppers.setup(simVars.disc.timestepping_method, op, simVars);
 
+		outputWriter.setup(simVars.iodata.output_async_queue_size);
+
+		bool restart = simVars.iodata.checkpoint_restart_file_name.length() > 0;
+
+		// Keep the output written before the checkpoint
+		if (simVars.iodata.output_file_mode == "container" && simVars.iodata.output_file_name.length() > 0)
+			containerWriter.open(simVars.iodata.output_file_name, restart);
+
 		update_diagnostics();
 
 		simVars.diag.backup_reference();
 
+#if SWEET_MPI
+		if (mpi_rank == 0)
+#endif
+		if (simVars.iodata.insitu_diagnostics_file_name.length() > 0)
+		{
+			insituDiagnostics.setup(sphereDataConfig, &op, &simVars, simVars.iodata.insitu_diagnostics, simVars.iodata.insitu_diagnostics_file_name, restart);
+
+			// Initial conditions are the reference for the error norms (analytical solution of stationary benchmarks)
+			insituDiagnostics.setReference(prog_phi, prog_vort, prog_div);
+		}
+
+		simVars.iodata.checkpoint_next_sim_seconds = simVars.iodata.checkpoint_each_sim_seconds;
+
+		if (simVars.timecontrol.adaptive_timestepping)
+		{
+			// Order of the error estimator of the embedded Runge-Kutta pair
+			TimesteppingExplicitRKTableau tableau;
+			tableau.setupEmbedded(simVars.disc.timestepping_order);
+
+			adaptiveTimestepController.setup(
+					tableau.embedded_order,
+					simVars.timecontrol.adaptive_min_timestep_size,
+					simVars.timecontrol.adaptive_max_timestep_size
+				);
+
+			// Use time step size as initial guess (overwritten by a restart)
+			adaptive_next_timestep_size = simVars.timecontrol.current_timestep_size;
+		}
+
+		if (restart)
+			checkpoint_read(simVars.iodata.checkpoint_restart_file_name);
+
+		// After a restart, the diagnostics for the current time were already written
+		if (insituDiagnostics.isActive() && !restart)
+			insituDiagnostics.compute(prog_phi, prog_vort, prog_div, simVars.timecontrol.current_simulation_time);
+
 		SimulationBenchmarkTimings::getInstance().main_setup.stop();
 
 		// start at one second in the past to ensure output at t=0
@@ -212,10 +322,26 @@ public:
 		const char* filename_template = simVars.iodata.output_file_name.c_str();
 		sprintf(buffer, filename_template, i_name, simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale);
 
-		if (i_phi_shifted)
-			sphereData.physical_file_write_lon_pi_shifted(buffer, "vorticity, lon pi shifted");
-		else
-			sphereData.physical_file_write(buffer);
+		/*
+		 * Create snapshot of data and write it with the background writer
+		 */
+		std::shared_ptr< std::vector<double> > staging = BackgroundOutputWriter::createStagingBuffer(
+				sphereData.physical_space_data,
+				sphereDataConfig->physical_array_data_number_of_elements
+			);
+
+		std::string filename = buffer;
+		const SphereData_Config *config = sphereDataConfig;
+
+		outputWriter.enqueue(
+				[staging, filename, config, i_phi_shifted]()
+				{
+					if (i_phi_shifted)
+						SphereData_Physical::physical_file_write_data(config, staging->data(), filename, "vorticity, lon pi shifted", 20, true);
+					else
+						SphereData_Physical::physical_file_write_data(config, staging->data(), filename);
+				}
+			);
 
 		return buffer;
 	}
@@ -232,15 +358,64 @@ public:
 	{
 		char buffer[1024];
 
-		SphereData_Spectral sphereData(i_sphereData);
 		const char* filename_template = simVars.iodata.output_file_name.c_str();
 		sprintf(buffer, filename_template, i_name, simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale);
-		sphereData.file_write_binary_spectral(buffer);
+
+		/*
+		 * Create snapshot of data and write it with the background writer
+		 */
+		std::shared_ptr< std::vector<std::complex<double>> > staging = BackgroundOutputWriter::createStagingBuffer(
+				i_sphereData.spectral_space_data,
+				sphereDataConfig->spectral_array_data_number_of_elements
+			);
+
+		std::string filename = buffer;
+		const SphereData_Config *config = sphereDataConfig;
+
+		outputWriter.enqueue(
+				[staging, filename, config]()
+				{
+					SphereData_Spectral::file_write_binary_spectral_data(config, staging->data(), filename);
+				}
+			);
 
 		return buffer;
 	}
 
 
+	/**
+	 * Append prognostic variables to container and return file name of container
+	 */
+	std::string write_file_container()
+	{
+		const SphereData_Config *config = sphereDataConfig;
+		SWEETDataContainerWriter *writer = &containerWriter;
+		double time = simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale;
+		SWEETCompression::Codec codec = SWEETCompression::getCodecFromString(simVars.iodata.output_compression);
+		double tol = simVars.iodata.output_compression_tolerance;
+
+		/*
+		 * Create snapshot of data and write it with the background writer
+		 */
+		std::shared_ptr< std::vector<std::complex<double>> > staging_phi = BackgroundOutputWriter::createStagingBuffer(prog_phi.spectral_space_data, config->spectral_array_data_number_of_elements);
+		std::shared_ptr< std::vector<std::complex<double>> > staging_vort = BackgroundOutputWriter::createStagingBuffer(prog_vort.spectral_space_data, config->spectral_array_data_number_of_elements);
+		std::shared_ptr< std::vector<std::complex<double>> > staging_div = BackgroundOutputWriter::createStagingBuffer(prog_div.spectral_space_data, config->spectral_array_data_number_of_elements);
+
+		outputWriter.enqueue(
+				[staging_phi, staging_vort, staging_div, config, writer, time, codec, tol]()
+				{
+					int64_t res[4] = {config->spectral_modes_n_max, config->spectral_modes_m_max, 0, 0};
+
+					writer->appendRecord("prog_phi", time, SWEETDataContainer::PRIMITIVE_SPHERE, SWEETDataContainer::SPACE_SPECTRAL, SWEETDataContainer::DATA_TYPE_COMPLEX128, res, staging_phi->data(), staging_phi->size(), codec, tol);
+					writer->appendRecord("prog_vort", time, SWEETDataContainer::PRIMITIVE_SPHERE, SWEETDataContainer::SPACE_SPECTRAL, SWEETDataContainer::DATA_TYPE_COMPLEX128, res, staging_vort->data(), staging_vort->size(), codec, tol);
+					writer->appendRecord("prog_div", time, SWEETDataContainer::PRIMITIVE_SPHERE, SWEETDataContainer::SPACE_SPECTRAL, SWEETDataContainer::DATA_TYPE_COMPLEX128, res, staging_div->data(), staging_div->size(), codec, tol);
+				}
+			);
+
+		return containerWriter.getFilename();
+	}
+
+
 	std::string output_reference_filenames;
 
 	void write_file_output()
@@ -250,6 +425,8 @@ public:
 			return;
 #endif
 
+		SWEET_PROFILER_REGION("output");
+
 		if (simVars.iodata.output_file_name.length() == 0)
 			return;
 
@@ -312,6 +489,11 @@ public:
 			output_reference_filenames += ";"+output_filename;
 			std::cout << " + " << output_filename << std::endl;
 		}
+		else if (simVars.iodata.output_file_mode == "container")
+		{
+			output_reference_filenames = write_file_container();
+			std::cout << " + " << output_reference_filenames << std::endl;
+		}
 		else
 		{
 			FatalError("Unknown output file mode '"+simVars.iodata.output_file_mode+"'");
@@ -375,6 +557,8 @@ public:
 
 		write_file_output();
 
+		insituDiagnostics.flush();
+
 		if (simVars.misc.verbosity > 1)
 		{
 			update_diagnostics();
@@ -463,6 +647,105 @@ public:
 
 
 
+public:
+	/**
+	 * Write checkpoint with the full simulation state
+	 *
+	 * The checkpoint is written by the background output writer.
+	 */
+	void checkpoint_write(
+			const std::string &i_filename
+	)
+	{
+#if SWEET_MPI
+		if (mpi_rank > 0)
+			return;
+#endif
+
+		std::shared_ptr<SWEETCheckpoint> checkpoint(new SWEETCheckpoint);
+
+		simVars.checkpoint_write(*checkpoint);
+
+		prog_phi.checkpoint_write(*checkpoint, "prog_phi");
+		prog_vort.checkpoint_write(*checkpoint, "prog_vort");
+		prog_div.checkpoint_write(*checkpoint, "prog_div");
+
+		timeSteppers.master->checkpoint_write(*checkpoint, "timestepper.");
+
+		if (simVars.timecontrol.adaptive_timestepping)
+		{
+			checkpoint->addScalar("adaptive.next_timestep_size", adaptive_next_timestep_size);
+			adaptiveTimestepController.checkpoint_write(*checkpoint, "adaptive.");
+		}
+
+		if (simVars.misc.verbosity > 0)
+			std::cout << "Writing checkpoint '" << i_filename << "' at simulation time " << simVars.timecontrol.current_simulation_time << std::endl;
+
+		std::string filename = i_filename;
+		outputWriter.enqueue(
+				[checkpoint, filename]()
+				{
+					checkpoint->writeFile(filename);
+				}
+			);
+	}
+
+
+
+	/**
+	 * Restore full simulation state from checkpoint
+	 */
+	void checkpoint_read(
+			const std::string &i_filename
+	)
+	{
+		std::cout << "Restarting from checkpoint '" << i_filename << "'" << std::endl;
+
+		SWEETCheckpoint checkpoint;
+		checkpoint.readFile(i_filename);
+
+		simVars.checkpoint_read(checkpoint);
+
+		prog_phi.checkpoint_read(checkpoint, "prog_phi");
+		prog_vort.checkpoint_read(checkpoint, "prog_vort");
+		prog_div.checkpoint_read(checkpoint, "prog_div");
+
+		timeSteppers.master->checkpoint_read(checkpoint, "timestepper.");
+
+		// Checkpoints without adaptive time stepping start with the restored time step size
+		if (simVars.timecontrol.adaptive_timestepping && checkpoint.hasEntry("adaptive.next_timestep_size"))
+		{
+			adaptive_next_timestep_size = checkpoint.getScalar("adaptive.next_timestep_size");
+			adaptiveTimestepController.checkpoint_read(checkpoint, "adaptive.");
+		}
+
+		last_timestep_nr_update_diagnostics = -1;
+	}
+
+
+
+	/**
+	 * Write checkpoint if requested for current simulation time
+	 */
+	void timestep_check_checkpoint()
+	{
+		if (simVars.iodata.checkpoint_file_name.length() == 0)
+			return;
+
+		if (simVars.iodata.checkpoint_each_sim_seconds <= 0)
+			return;
+
+		if (simVars.iodata.checkpoint_next_sim_seconds > simVars.timecontrol.current_simulation_time)
+			return;
+
+		while (simVars.iodata.checkpoint_next_sim_seconds <= simVars.timecontrol.current_simulation_time)
+			simVars.iodata.checkpoint_next_sim_seconds += simVars.iodata.checkpoint_each_sim_seconds;
+
+		checkpoint_write(simVars.iodata.checkpoint_file_name);
+	}
+
+
+
 public:
 	bool should_quit()
 	{
@@ -512,19 +795,28 @@ public:
 
 	void run_timestep()
 	{
+		SWEET_PROFILER_REGION("timestep");
+
 #if SWEET_GUI
 		if (simVars.misc.gui_enabled && simVars.misc.normal_mode_analysis_generation == 0)
 			timestep_check_output();
 #endif
 
-		if (simVars.timecontrol.current_simulation_time + simVars.timecontrol.current_timestep_size > simVars.timecontrol.max_simulation_time)
-			simVars.timecontrol.current_timestep_size = simVars.timecontrol.max_simulation_time - simVars.timecontrol.current_simulation_time;
-
-		timeSteppers.master->run_timestep(
-				prog_phi, prog_vort, prog_div,
-				simVars.timecontrol.current_timestep_size,
-				simVars.timecontrol.current_simulation_time
-			);
+		if (simVars.timecontrol.adaptive_timestepping)
+		{
+			run_timestep_adaptive();
+		}
+		else
+		{
+			if (simVars.timecontrol.current_simulation_time + simVars.timecontrol.current_timestep_size > simVars.timecontrol.max_simulation_time)
+				simVars.timecontrol.current_timestep_size = simVars.timecontrol.max_simulation_time - simVars.timecontrol.current_simulation_time;
+
+			timeSteppers.master->run_timestep(
+					prog_phi, prog_vort, prog_div,
+					simVars.timecontrol.current_timestep_size,
+					simVars.timecontrol.current_simulation_time
+				);
+		}
 
 
 		/*
@@ -547,12 +839,76 @@ public:
 		simVars.timecontrol.current_simulation_time += simVars.timecontrol.current_timestep_size;
 		simVars.timecontrol.current_timestep_nr++;
 
+		if (insituDiagnostics.isActive())
+			insituDiagnostics.compute(prog_phi, prog_vort, prog_div, simVars.timecontrol.current_simulation_time);
+
 #if SWEET_GUI
 		timestep_check_output();
 #endif
 	}
 
 
+	/**
+	 * Run a time step with adaptive time step size control.
+	 *
+	 * The time step is repeated with smaller time step sizes until the
+	 * local error estimate is accepted. current_timestep_size is set to
+	 * the size of the accepted time step.
+	 */
+	void run_timestep_adaptive()
+	{
+		double t = simVars.timecontrol.current_simulation_time;
+		double dt = adaptive_next_timestep_size;
+
+		// Hit the end of the simulation and output times exactly
+		bool clamped = false;
+		if (t + dt > simVars.timecontrol.max_simulation_time)
+		{
+			dt = simVars.timecontrol.max_simulation_time - t;
+			clamped = true;
+		}
+
+		if (	simVars.iodata.output_each_sim_seconds > 0 &&
+				simVars.iodata.output_next_sim_seconds > t &&
+				t + dt > simVars.iodata.output_next_sim_seconds
+		)
+		{
+			dt = simVars.iodata.output_next_sim_seconds - t;
+			clamped = true;
+		}
+
+		while (true)
+		{
+			double error = timeSteppers.master->run_timestep_adaptive(
+					prog_phi, prog_vort, prog_div,
+					dt,
+					t
+				);
+
+			double dt_next = adaptiveTimestepController.computeNextTimestepSize(dt, error);
+
+			if (error <= 1.0)
+			{
+				simVars.timecontrol.current_timestep_size = dt;
+
+				// Time steps shortened to hit output times shouldn't reduce the next ones
+				if (!clamped || dt_next > adaptive_next_timestep_size)
+					adaptive_next_timestep_size = dt_next;
+
+				return;
+			}
+
+			if (simVars.misc.verbosity > 2)
+				std::cout << "Rejected time step size " << dt << " at time " << t << " (error estimate: " << error << ")" << std::endl;
+
+			dt = dt_next;
+			adaptive_next_timestep_size = dt_next;
+			clamped = false;
+		}
+	}
+
+
+
 	void normalmode_analysis()
 	{
 		NormalModeAnalysisSphere::normal_mode_analysis(
@@ -561,7 +917,8 @@ public:
 				prog_div,
 				simVars,
 				this,
-				&SimulationInstance::run_timestep
+				&SimulationInstance::run_timestep,
+				timeSteppers.linear_only
 			);
 	}
 
@@ -760,6 +1117,286 @@ case 'C':
 
 
 
+#if SWEET_MPI
+
+/**
+ * Simulation with the sphere data distributed over all MPI ranks
+ * (see --space-sphere-distributed)
+ *
+ * All ranks execute the time steps. No serial sphere data and hence
+ * no SHTNS setup is required. Only the time steppers with support for
+ * SphereData_SpectralDistributed and the benchmarks which are given
+ * point-wise in physical space are available.
+ */
+class SimulationInstanceDistributed
+{
+public:
+	const SphereData_ConfigDistributed *sphereDataConfigDistributed;
+
+	SphereData_SpectralDistributed prog_phi;
+	SphereData_SpectralDistributed prog_vort;
+	SphereData_SpectralDistributed prog_div;
+
+	// Operators without serial sphere data, only required to setup the time steppers
+	SphereOperators_SphereData op;
+
+	SWE_Sphere_TimeSteppers timeSteppers;
+
+	SWESphereBenchmarksCombined sphereBenchmarks;
+
+	std::string output_reference_filenames;
+
+
+public:
+	SimulationInstanceDistributed(
+			const SphereData_ConfigDistributed *i_sphereDataConfigDistributed
+	)	:
+		sphereDataConfigDistributed(i_sphereDataConfigDistributed),
+		prog_phi(i_sphereDataConfigDistributed),
+		prog_vort(i_sphereDataConfigDistributed),
+		prog_div(i_sphereDataConfigDistributed)
+	{
+		reset();
+	}
+
+
+
+	void reset()
+	{
+		simVars.reset();
+
+		simVars.iodata.output_next_sim_seconds = 0;
+
+		// Check if input parameters are supported with distributed sphere data
+		if (simVars.timecontrol.current_timestep_size <= 0)
+			FatalError("Only fixed time step size supported");
+
+		if (simVars.timecontrol.adaptive_timestepping)
+			FatalError("Adaptive time stepping not supported for distributed sphere data");
+
+		if (simVars.sim.viscosity != 0)
+			FatalError("Viscosity not supported for distributed sphere data");
+
+		if (simVars.iodata.output_file_mode != "csv")
+			FatalError("Only output file mode 'csv' supported for distributed sphere data");
+
+		if (simVars.iodata.checkpoint_file_name.length() > 0 || simVars.iodata.checkpoint_restart_file_name.length() > 0)
+			FatalError("Checkpoints not supported for distributed sphere data");
+
+		if (simVars.iodata.insitu_diagnostics_file_name.length() > 0)
+			FatalError("In-situ diagnostics not supported for distributed sphere data");
+
+		if (simVars.misc.ensemble_members > 0 || simVars.misc.normal_mode_analysis_generation > 0)
+			FatalError("Ensembles and normal mode analysis not supported for distributed sphere data");
+
+		if (!simVars.benchmark.setup_dealiased)
+			FatalError("Benchmark setup without dealiasing not supported for distributed sphere data");
+
+		if (!SWE_Sphere_TimeSteppers::supportsDistributed(simVars.disc.timestepping_method))
+			FatalError("Time stepping method '"+simVars.disc.timestepping_method+"' not supported for distributed sphere data");
+
+		sphereBenchmarks.setupInitialConditions(prog_phi, prog_vort, prog_div, simVars);
+
+		timeSteppers.setup(simVars.disc.timestepping_method, op, simVars);
+
+		if (sphereDataConfigDistributed->mpi_rank == 0)
+			simVars.outputConfig();
+	}
+
+
+
+	/**
+	 * Collective output of the data to a file and return string of file name
+	 */
+	std::string write_file_csv(
+			const SphereData_SpectralDistributed &i_sphereData,
+			const char* i_name		///< name of output variable
+	)
+	{
+		char buffer[1024];
+
+		const char* filename_template = simVars.iodata.output_file_name.c_str();
+		sprintf(buffer, filename_template, i_name, simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale);
+
+		i_sphereData.getSphereDataPhysical().physical_file_write(buffer);
+
+		return buffer;
+	}
+
+
+
+	/**
+	 * Collective output, only the first rank writes to stdout
+	 *
+	 * The velocities and the potential vorticity are not written
+	 * since these require operators which are not available
+	 * for distributed sphere data.
+	 */
+	void timestep_do_output()
+	{
+		SWEET_PROFILER_REGION("output");
+
+		int mpi_rank = sphereDataConfigDistributed->mpi_rank;
+
+		SphereData_PhysicalDistributed phi = prog_phi.getSphereDataPhysical();
+		double phi_min = phi.physical_reduce_min();
+		double phi_max = phi.physical_reduce_max();
+
+		if (simVars.iodata.output_file_name.length() > 0)
+		{
+			if (mpi_rank == 0)
+				std::cout << "Writing output files as simulation time: " << simVars.timecontrol.current_simulation_time << std::endl;
+
+			std::string output_filename;
+			SphereData_SpectralDistributed h = prog_phi*(1.0/simVars.sim.gravitation);
+
+			output_filename = write_file_csv(prog_phi, "prog_phi");
+			output_reference_filenames = output_filename;
+			if (mpi_rank == 0)
+				std::cout << " + " << output_filename << std::endl;
+
+			output_filename = write_file_csv(h, "prog_h");
+			output_reference_filenames += ";"+output_filename;
+			if (mpi_rank == 0)
+				std::cout << " + " << output_filename << " (min: " << phi_min/simVars.sim.gravitation << ", max: " << phi_max/simVars.sim.gravitation << ")" << std::endl;
+
+			output_filename = write_file_csv(prog_vort, "prog_vort");
+			output_reference_filenames += ";"+output_filename;
+			if (mpi_rank == 0)
+				std::cout << " + " << output_filename << std::endl;
+
+			output_filename = write_file_csv(prog_div, "prog_div");
+			output_reference_filenames += ";"+output_filename;
+			if (mpi_rank == 0)
+				std::cout << " + " << output_filename << std::endl;
+		}
+
+		if (simVars.misc.verbosity > 0 && mpi_rank == 0)
+			std::cout << "prog_phi min/max:\t" << phi_min << ", " << phi_max << std::endl;
+
+		if (simVars.iodata.output_each_sim_seconds > 0)
+			while (simVars.iodata.output_next_sim_seconds <= simVars.timecontrol.current_simulation_time)
+				simVars.iodata.output_next_sim_seconds += simVars.iodata.output_each_sim_seconds;
+	}
+
+
+
+	/**
+	 * Collective check for output (see SimulationInstance::timestep_check_output)
+	 */
+	void timestep_check_output(
+			bool i_force = false	///< output independent of the output interval
+	)
+	{
+		if (simVars.iodata.output_each_sim_seconds < 0)
+			return;
+
+		if (!i_force && simVars.timecontrol.current_simulation_time < simVars.timecontrol.max_simulation_time - simVars.iodata.output_each_sim_seconds*1e-10)
+		{
+			if (simVars.iodata.output_next_sim_seconds > simVars.timecontrol.current_simulation_time)
+				return;
+		}
+
+		timestep_do_output();
+	}
+
+
+
+	bool should_quit()
+	{
+		if (simVars.timecontrol.max_timesteps_nr != -1 && simVars.timecontrol.max_timesteps_nr <= simVars.timecontrol.current_timestep_nr)
+			return true;
+
+		double diff = std::abs(simVars.timecontrol.max_simulation_time - simVars.timecontrol.current_simulation_time);
+
+		if (	simVars.timecontrol.max_simulation_time != -1 &&
+				(
+						simVars.timecontrol.max_simulation_time <= simVars.timecontrol.current_simulation_time	||
+						diff/simVars.timecontrol.max_simulation_time < 1e-11	// avoid numerical issues in time stepping if current time step is 1e-14 smaller than max time step
+				)
+			)
+			return true;
+
+		return false;
+	}
+
+
+
+	void run_timestep()
+	{
+		SWEET_PROFILER_REGION("timestep");
+
+		if (simVars.timecontrol.current_simulation_time + simVars.timecontrol.current_timestep_size > simVars.timecontrol.max_simulation_time)
+			simVars.timecontrol.current_timestep_size = simVars.timecontrol.max_simulation_time - simVars.timecontrol.current_simulation_time;
+
+		timeSteppers.master->run_timestep(
+				prog_phi, prog_vort, prog_div,
+				simVars.timecontrol.current_timestep_size,
+				simVars.timecontrol.current_simulation_time
+			);
+
+		// advance time step and provide information to parameters
+		simVars.timecontrol.current_simulation_time += simVars.timecontrol.current_timestep_size;
+		simVars.timecontrol.current_timestep_nr++;
+	}
+};
+
+
+
+/**
+ * Run the simulation with the sphere data distributed over all ranks
+ */
+void run_distributed()
+{
+	SphereData_ConfigDistributed sphereDataConfigDistributed;
+	sphereDataConfigDistributed.setupAuto(simVars.disc.space_res_physical, simVars.disc.space_res_spectral, simVars.misc.reuse_spectral_transformation_plans);
+
+	int mpi_rank = sphereDataConfigDistributed.mpi_rank;
+
+	if (mpi_rank == 0)
+	{
+		sphereDataConfigDistributed.printInformation();
+		std::cout << "SPH config string: " << sphereDataConfigDistributed.getConfigInformationString() << std::endl;
+	}
+
+	SimulationInstanceDistributed *simulationSWE = new SimulationInstanceDistributed(&sphereDataConfigDistributed);
+
+	// Do first output before starting timer
+	simulationSWE->timestep_check_output(true);
+
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	SimulationBenchmarkTimings::getInstance().main_timestepping.start();
+
+	// Main time loop
+	while (!simulationSWE->should_quit())
+	{
+		simulationSWE->run_timestep();
+		simulationSWE->timestep_check_output();
+	}
+
+	SimulationBenchmarkTimings::getInstance().main_timestepping.stop();
+
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	if (mpi_rank == 0)
+	{
+		if (simVars.iodata.output_file_name.size() > 0)
+			std::cout << "[MULE] reference_filenames: " << simulationSWE->output_reference_filenames << std::endl;
+
+		std::cout << "***************************************************" << std::endl;
+		std::cout << "[MULE] simVars.timecontrol.current_timestep_nr: " << simVars.timecontrol.current_timestep_nr << std::endl;
+		std::cout << "[MULE] simVars.timecontrol.current_timestep_size: " << simVars.timecontrol.current_timestep_size << std::endl;
+		std::cout << "[MULE] simulation_benchmark_timings.time_per_time_step (secs/ts): " << SimulationBenchmarkTimings::getInstance().main_timestepping()/(double)simVars.timecontrol.current_timestep_nr << std::endl;
+	}
+
+	delete simulationSWE;
+}
+
+#endif
+
+
+
 int main(int i_argc, char *i_argv[])
 {
 	// Time counter
@@ -805,6 +1442,26 @@ int main(int i_argc, char *i_argv[])
 		return -1;
 	}
 
+	SWESphImplicitOperatorCache< SphBandedMatrixPhysicalReal< std::complex<double> > >::getInstance().setMaxSize(simVars.misc.implicit_operator_cache_size);
+	SWESphImplicitOperatorCache< SphBandedMatrixPhysicalComplex< std::complex<double> > >::getInstance().setMaxSize(simVars.misc.implicit_operator_cache_size);
+	SphereData_DerivedCache::getInstance().setup(simVars.misc.derived_transform_cache_size);
+	SimulationProfiler::getInstance().setup(simVars.misc.profiler, simVars.misc.profiler_trace_file_name);
+	KernelCounters::getInstance().setup();
+
+	if (simVars.disc.space_sphere_distributed)
+	{
+#if SWEET_MPI
+		run_distributed();
+
+		SimulationProfiler::getInstance().output();
+
+		MPI_Finalize();
+		return 0;
+#else
+		FatalError("Distributed sphere data requires MPI");
+#endif
+	}
+
 	if (simVars.misc.verbosity > 3)
 		std::cout << " + setup SH sphere transformations..." << std::endl;
 
@@ -883,6 +1540,18 @@ int main(int i_argc, char *i_argv[])
 		}
 		else
 #endif
+		if (simVars.misc.ensemble_members > 0)
+		{
+			SWE_Sphere_Ensemble<SimulationInstance> ensemble(simVars);
+
+			ensemble.setup();
+			ensemble.run();
+			ensemble.finish();
+
+			// Release cached fields before the discretization is shut down
+			SphereData_DerivedCache::getInstance().clear();
+		}
+		else
 		{
 			SimulationInstance *simulationSWE = new SimulationInstance;
 
@@ -919,6 +1588,9 @@ int main(int i_argc, char *i_argv[])
 					// Test for some output to be done
 					simulationSWE->timestep_check_output();
 
+					// Write checkpoint if requested
+					simulationSWE->timestep_check_checkpoint();
+
 					// Main call for timestep run
 					simulationSWE->run_timestep();
 
@@ -964,9 +1636,25 @@ int main(int i_argc, char *i_argv[])
 				simulationSWE->timestep_check_output();
 			}
 
+			// Write checkpoint of final state to allow continuing the simulation
+			if (simVars.iodata.checkpoint_file_name.length() > 0 && simVars.misc.normal_mode_analysis_generation == 0)
+				simulationSWE->checkpoint_write(simVars.iodata.checkpoint_file_name);
+
+			// Finish writing all pending output files
+			simulationSWE->outputWriter.shutdown();
+			simulationSWE->outputWriter.output();
+			simulationSWE->containerWriter.close();
+			simulationSWE->insituDiagnostics.close();
+
+			// Release cached fields before the discretization is shut down
+			SphereData_DerivedCache::getInstance().clear();
+
 			if (simVars.iodata.output_file_name.size() > 0)
 				std::cout << "[MULE] reference_filenames: " << simulationSWE->output_reference_filenames << std::endl;
 
+			if (simVars.timecontrol.adaptive_timestepping)
+				simulationSWE->adaptiveTimestepController.output();
+
 			delete simulationSWE;
 		}
 
@@ -987,6 +1675,10 @@ int main(int i_argc, char *i_argv[])
 		std::cout << "***************************************************" << std::endl;
 		std::cout << "[MULE] simVars.timecontrol.current_timestep_nr: " << simVars.timecontrol.current_timestep_nr << std::endl;
 		std::cout << "[MULE] simVars.timecontrol.current_timestep_size: " << simVars.timecontrol.current_timestep_size << std::endl;
+		SWESphImplicitOperatorCache< SphBandedMatrixPhysicalReal< std::complex<double> > >::getInstance().output("implicit_operator_cache.irk");
+		SWESphImplicitOperatorCache< SphBandedMatrixPhysicalComplex< std::complex<double> > >::getInstance().output("implicit_operator_cache.rexi");
+		SphereData_DerivedCache::getInstance().output();
+		KernelCounters::getInstance().output();
 		std::cout << std::endl;
 		std::cout << "***************************************************" << std::endl;
 		std::cout << "* Other timing information (derived)" << std::endl;
@@ -994,6 +1686,9 @@ int main(int i_argc, char *i_argv[])
 		std::cout << "[MULE] simulation_benchmark_timings.time_per_time_step (secs/ts): " << SimulationBenchmarkTimings::getInstance().main_timestepping()/(double)simVars.timecontrol.current_timestep_nr << std::endl;
 	}
 
+	// Output of profiler reduced over all ranks on rank 0, trace files on all ranks
+	SimulationProfiler::getInstance().output();
+
 
 #if SWEET_MPI
 	MPI_Finalize();
@@ -0,0 +1,395 @@
+/*
+ * SWE_Sphere_Ensemble.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_PROGRAMS_SWE_SPHERE_SWE_SPHERE_ENSEMBLE_HPP_
+#define SRC_PROGRAMS_SWE_SPHERE_SWE_SPHERE_ENSEMBLE_HPP_
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <utility>
+#include <sweet/sphere/SphereData_Spectral.hpp>
+#include <sweet/sphere/SphereData_Physical.hpp>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/SimulationBenchmarkTiming.hpp>
+#include <sweet/FatalError.hpp>
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
+
+
+
+/**
+ * Run several ensemble members in one process
+ *
+ * All members share the read-only setup state of the process:
+ * the SphereData_Config with its SHTNS plans, the REXI coefficients
+ * (see REXI::load), the factorized implicit operators
+ * (see SWESphImplicitOperatorCache) and the benchmark initial conditions
+ * if --initial-condition-cache-dir is used.
+ *
+ * The prognostic fields are stored in the simulation instance of each
+ * member. The simulation instances access the global simulation variables
+ * and only modify the time control, I/O and diagnostics state.
+ * Each member therefore only keeps its own copy of these parts (see
+ * MemberState) which is swapped with the global one while this member is
+ * processed.
+ * The members are advanced time step by time step in a round-robin way,
+ * each time step itself is parallelized in space.
+ *
+ * Members > 0 get a different random perturbation of the geopotential
+ * (see --ensemble-perturbation), member 0 is the control run.
+ */
+template <typename T_SimulationInstance>
+class SWE_Sphere_Ensemble
+{
+	/**
+	 * Parts of the simulation variables which are modified by a simulation instance
+	 */
+	struct MemberState
+	{
+		SimulationVariables::TimestepControl timecontrol;
+		SimulationVariables::IOData iodata;
+		SimulationVariables::Diagnostics diag;
+
+		MemberState(
+				const SimulationVariables &i_simVars
+		)	:
+			timecontrol(i_simVars.timecontrol),
+			iodata(i_simVars.iodata),
+			diag(i_simVars.diag)
+		{
+		}
+
+		void swap(
+				SimulationVariables &io_simVars
+		)
+		{
+			std::swap(timecontrol, io_simVars.timecontrol);
+			std::swap(iodata, io_simVars.iodata);
+			std::swap(diag, io_simVars.diag);
+		}
+	};
+
+
+	struct Member
+	{
+		int id;
+
+		/// State of this member if it's not the current one
+		MemberState state;
+
+		T_SimulationInstance *simulation;
+
+		/// Is this member still running?
+		bool active;
+
+		/// Was this member stopped since it became unstable?
+		bool unstable;
+
+		Member(
+				int i_id,
+				const MemberState &i_state
+		)	:
+			id(i_id),
+			state(i_state),
+			simulation(nullptr),
+			active(true),
+			unstable(false)
+		{
+		}
+	};
+
+
+	/**
+	 * Make a member the current one until the end of the scope
+	 */
+	class MemberScope
+	{
+		SimulationVariables &simVars;
+		Member &member;
+
+	public:
+		MemberScope(
+				SimulationVariables &io_simVars,
+				Member &io_member
+		)	:
+			simVars(io_simVars),
+			member(io_member)
+		{
+			member.state.swap(simVars);
+		}
+
+		~MemberScope()
+		{
+			member.state.swap(simVars);
+		}
+	};
+
+
+	/// Global simulation variables which are used by the simulation instances
+	SimulationVariables &simVars;
+
+	std::vector<Member*> members;
+
+
+public:
+	SWE_Sphere_Ensemble(
+			SimulationVariables &io_simVars
+	)	:
+		simVars(io_simVars)
+	{
+	}
+
+
+	~SWE_Sphere_Ensemble()
+	{
+		for (std::size_t i = 0; i < members.size(); i++)
+		{
+			delete members[i]->simulation;
+			delete members[i];
+		}
+	}
+
+
+	/**
+	 * Return file name with the prefix 'member_[id]_' in front of the base name
+	 */
+	static
+	std::string getMemberFilename(
+			const std::string &i_filename,
+			int i_member_id
+	)
+	{
+		if (i_filename.length() == 0)
+			return i_filename;
+
+		std::ostringstream prefix;
+		prefix << "member_" << std::setw(4) << std::setfill('0') << i_member_id << "_";
+
+		std::size_t pos = i_filename.rfind('/');
+		if (pos == std::string::npos)
+			return prefix.str() + i_filename;
+
+		return i_filename.substr(0, pos+1) + prefix.str() + i_filename.substr(pos+1);
+	}
+
+
+	/**
+	 * Setup all members with the current simulation variables
+	 */
+	void setup()
+	{
+		int num_members = simVars.misc.ensemble_members;
+
+		if (num_members <= 0)
+			FatalError("SWE_Sphere_Ensemble: Number of ensemble members must be > 0");
+
+		if (simVars.misc.normal_mode_analysis_generation > 0)
+			FatalError("SWE_Sphere_Ensemble: Normal mode analysis not supported in ensemble mode");
+
+#if SWEET_MPI
+		int mpi_size;
+		MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+		if (mpi_size > 1)
+			FatalError("SWE_Sphere_Ensemble: Ensemble mode is only supported for a single MPI rank");
+#endif
+
+		MemberState base_state(simVars);
+
+		members.resize(num_members);
+		for (int i = 0; i < num_members; i++)
+		{
+			Member *m = new Member(i, base_state);
+			members[i] = m;
+
+			m->state.iodata.output_file_name = getMemberFilename(base_state.iodata.output_file_name, i);
+			m->state.iodata.insitu_diagnostics_file_name = getMemberFilename(base_state.iodata.insitu_diagnostics_file_name, i);
+			m->state.iodata.checkpoint_file_name = getMemberFilename(base_state.iodata.checkpoint_file_name, i);
+			m->state.iodata.checkpoint_restart_file_name = getMemberFilename(base_state.iodata.checkpoint_restart_file_name, i);
+
+			if (simVars.misc.verbosity > 0)
+				std::cout << " + setup ensemble member " << i << std::endl;
+
+			MemberScope scope(simVars, *m);
+			m->simulation = new T_SimulationInstance(i);
+		}
+	}
+
+
+
+	/**
+	 * Run time stepping of all members
+	 */
+	void run()
+	{
+		// Do first output before starting timer
+		for (std::size_t i = 0; i < members.size(); i++)
+		{
+			MemberScope scope(simVars, *members[i]);
+			members[i]->simulation->timestep_check_output();
+		}
+
+		SimulationBenchmarkTimings::getInstance().main_timestepping.start();
+
+		while (true)
+		{
+			int num_active = 0;
+
+			for (std::size_t i = 0; i < members.size(); i++)
+			{
+				Member &m = *members[i];
+
+				if (!m.active)
+					continue;
+
+				MemberScope scope(simVars, m);
+
+				if (m.simulation->should_quit())
+				{
+					m.active = false;
+					continue;
+				}
+
+				m.simulation->timestep_check_output();
+				m.simulation->timestep_check_checkpoint();
+				m.simulation->run_timestep();
+
+				// Only stop the unstable member, the others continue
+				if (simVars.misc.instability_checks && m.simulation->detect_instability())
+				{
+					std::cout << "INSTABILITY DETECTED in ensemble member " << m.id << std::endl;
+					std::cerr << "INSTABILITY DETECTED in ensemble member " << m.id << std::endl;
+					m.active = false;
+					m.unstable = true;
+					continue;
+				}
+
+				num_active++;
+			}
+
+			if (num_active == 0)
+				break;
+		}
+
+		SimulationBenchmarkTimings::getInstance().main_timestepping.stop();
+
+		if (simVars.misc.verbosity > 0)
+			std::cout << std::endl;
+	}
+
+
+
+	/**
+	 * Write final output, checkpoints and diagnostics of all members
+	 */
+	void finish()
+	{
+		for (std::size_t i = 0; i < members.size(); i++)
+		{
+			Member &m = *members[i];
+			MemberScope scope(simVars, m);
+
+			T_SimulationInstance *s = m.simulation;
+
+			if (!m.unstable)
+			{
+				s->timestep_check_output();
+
+				if (simVars.iodata.checkpoint_file_name.length() > 0)
+					s->checkpoint_write(simVars.iodata.checkpoint_file_name);
+			}
+
+			s->outputWriter.shutdown();
+			s->outputWriter.output();
+			s->containerWriter.close();
+			s->insituDiagnostics.close();
+
+			std::string prefix = "[MULE] ensemble.member_" + p_getMemberIdString(m.id) + ".";
+
+			std::cout << prefix << "unstable: " << (m.unstable ? 1 : 0) << std::endl;
+			std::cout << prefix << "current_timestep_nr: " << simVars.timecontrol.current_timestep_nr << std::endl;
+			std::cout << prefix << "current_simulation_time: " << simVars.timecontrol.current_simulation_time << std::endl;
+
+			if (!m.unstable)
+			{
+				s->update_diagnostics();
+
+				std::cout << prefix << "total_mass: " << simVars.diag.total_mass << std::endl;
+				std::cout << prefix << "total_energy: " << simVars.diag.total_energy << std::endl;
+				std::cout << prefix << "total_potential_enstrophy: " << simVars.diag.total_potential_enstrophy << std::endl;
+			}
+
+			if (simVars.iodata.output_file_name.size() > 0)
+				std::cout << prefix << "reference_filenames: " << s->output_reference_filenames << std::endl;
+		}
+
+		p_outputSpread();
+
+		// Keep the state of the control run for the remaining output of the program
+		simVars.timecontrol = members[0]->state.timecontrol;
+	}
+
+
+
+private:
+	static
+	std::string p_getMemberIdString(
+			int i_member_id
+	)
+	{
+		std::ostringstream s;
+		s << std::setw(4) << std::setfill('0') << i_member_id;
+		return s.str();
+	}
+
+
+
+	/**
+	 * Output RMS spread of the geopotential of all stable members
+	 */
+	void p_outputSpread()
+	{
+		std::vector<Member*> stable;
+		for (std::size_t i = 0; i < members.size(); i++)
+			if (!members[i]->unstable)
+				stable.push_back(members[i]);
+
+		std::cout << "[MULE] ensemble.num_members: " << members.size() << std::endl;
+		std::cout << "[MULE] ensemble.num_stable_members: " << stable.size() << std::endl;
+
+		if (stable.size() < 2)
+			return;
+
+		SphereData_Spectral mean(stable[0]->simulation->prog_phi.sphereDataConfig);
+		mean.spectral_set_zero();
+
+		for (std::size_t i = 0; i < stable.size(); i++)
+			mean += stable[i]->simulation->prog_phi;
+
+		mean = mean*(1.0/(double)stable.size());
+
+		double variance = 0;
+		for (std::size_t i = 0; i < stable.size(); i++)
+		{
+			SphereData_Physical diff = (stable[i]->simulation->prog_phi - mean).getSphereDataPhysical();
+			double rms = diff.physical_reduce_rms();
+			variance += rms*rms;
+		}
+		variance /= (double)(stable.size()-1);
+
+		std::cout << "[MULE] ensemble.spread_phi_rms: " << std::sqrt(variance) << std::endl;
+	}
+};
+
+
+
+#endif /* SRC_PROGRAMS_SWE_SPHERE_SWE_SPHERE_ENSEMBLE_HPP_ */
@@ -8,7 +8,19 @@
 #ifndef SRC_PROGRAMS_SWE_SPHERE_SWE_SPHERE_NORMALMODEANALYSIS_HPP_
 #define SRC_PROGRAMS_SWE_SPHERE_SWE_SPHERE_NORMALMODEANALYSIS_HPP_
 
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
 #include <sweet/sphere/SphereData_Config.hpp>
+#include <sweet/sphere/SphereData_Spectral.hpp>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/FatalError.hpp>
+#include <sweet/openmp_helper.hpp>
+
+#if SWEET_EIGEN
+#	include <Eigen/Eigenvalues>
+#endif
 
 
 
@@ -26,9 +38,20 @@ public:
 			SimulationVariables &i_simVars,
 
 			TCallbackClass *i_class,
-			void(TCallbackClass::* const i_run_timestep_method)(void)
+			void(TCallbackClass::* const i_run_timestep_method)(void),
+
+			bool i_linear_only	///< time stepper only includes linear terms
 	)
 	{
+		if (i_simVars.misc.normal_mode_analysis_batched > 0)
+		{
+			if (!i_linear_only)
+				FatalError("Batched normal mode analysis requires a linear time stepper");
+
+			normal_mode_analysis_batched(io_prog_phi, io_prog_vort, io_prog_div, i_simVars, i_class, i_run_timestep_method);
+			return;
+		}
+
 		const SphereData_Config *sphereDataConfig = io_prog_phi.sphereDataConfig;
 
 		/*
@@ -349,6 +372,323 @@ public:
 			}
 		}
 	}
+
+
+
+	/**
+	 * Batched normal mode analysis for linear time steppers
+	 *
+	 * Linear operators with coefficients only depending on the latitude
+	 * (e.g. Coriolis effect, Robert formulation) only couple modes with
+	 * the same zonal wavenumber m. Hence, the operator consists of one
+	 * block per m and unit vectors of different m can be propagated at
+	 * once: In each run, one unit vector is excited for each m. This
+	 * reduces the number of runs from 2*3*(number of modes) to
+	 * 2*3*(n_max+1).
+	 *
+	 * This relies on the superposition principle and is therefore only
+	 * valid for linear (or linearized around a zero state) time steppers.
+	 *
+	 * Each block is indexed by
+	 *   (prog_id*(n_max-m+1) + (n-m))*num_parts + part
+	 * with prog_id in (phi, vort, div) and part in (real, imag).
+	 * For generation 2/12, the real and imaginary parts are treated
+	 * separately (num_parts=2) and the blocks are real.
+	 * Generation 3/13 only excites real parts (num_parts=1), but keeps the
+	 * complex response. Since the operator is linear for complex spectral
+	 * coefficients, this gives complex blocks including the couplings with
+	 * i*m of the derivatives in longitude.
+	 *
+	 * Binary output (native endianness):
+	 *   char[8] "SWEETNMB", int32 version (2),
+	 *   int32 n_max, int32 m_max, int32 num_prog (3), int32 num_parts,
+	 *   double t, g, h, r, f,
+	 *   for each m: int32 m, int32 size, size*size values (column major),
+	 *   doubles for num_parts=2 and complex values (real, imag) for num_parts=1
+	 *
+	 * With --normal-mode-analysis-batched=2, the eigenvalues of each block
+	 * are computed and written to a text file (m, real, imag per line).
+	 */
+	template <typename TCallbackClass>
+	static
+	void normal_mode_analysis_batched(
+			SphereData_Spectral &io_prog_phi,
+			SphereData_Spectral &io_prog_vort,
+			SphereData_Spectral &io_prog_div,
+
+			SimulationVariables &i_simVars,
+
+			TCallbackClass *i_class,
+			void(TCallbackClass::* const i_run_timestep_method)(void)
+	)
+	{
+		const SphereData_Config *sphereDataConfig = io_prog_phi.sphereDataConfig;
+
+		int generation = i_simVars.misc.normal_mode_analysis_generation;
+
+		if (generation != 2 && generation != 12 && generation != 3 && generation != 13)
+			FatalError("Batched normal mode analysis is only supported for generation 2, 3, 12 and 13");
+
+		if (i_simVars.disc.timestepping_method.find("_lf") != std::string::npos)
+			FatalError("Batched normal mode analysis is not supported for Leapfrog time stepping");
+
+#if !SWEET_EIGEN
+		if (i_simVars.misc.normal_mode_analysis_batched >= 2)
+			FatalError("Computing eigenvalues requires Eigen, please compile with --eigen=enable");
+#endif
+
+		const int n_max = sphereDataConfig->spectral_modes_n_max;
+		const int m_max = sphereDataConfig->spectral_modes_m_max;
+		const int num_prog = 3;
+		const bool complex_blocks = (generation % 10 == 3);
+		const int num_parts = complex_blocks ? 1 : 2;
+
+		int num_timesteps = 1;
+		if (generation >= 10)
+		{
+			if (i_simVars.timecontrol.max_timesteps_nr > 0)
+				num_timesteps = i_simVars.timecontrol.max_timesteps_nr;
+		}
+
+		double t;
+		if (i_simVars.timecontrol.max_simulation_time > 0)
+			t = i_simVars.timecontrol.max_simulation_time;
+		else
+			t = num_timesteps*i_simVars.timecontrol.current_timestep_size;
+
+		SphereData_Spectral* prog[3] = {&io_prog_phi, &io_prog_vort, &io_prog_div};
+
+		/*
+		 * Size of the block for each m
+		 */
+		std::vector<int> block_size(m_max+1);
+		int num_runs = 0;
+		for (int m = 0; m <= m_max; m++)
+		{
+			block_size[m] = num_prog*(n_max-m+1)*num_parts;
+			num_runs = std::max(num_runs, block_size[m]);
+		}
+
+		// operator blocks, column major (imaginary parts only used for complex blocks)
+		std::vector<std::vector<std::complex<double>>> blocks(m_max+1);
+		for (int m = 0; m <= m_max; m++)
+			blocks[m].resize((std::size_t)block_size[m]*block_size[m]);
+
+		std::cout << "Batched normal mode analysis: " << num_runs << " runs" << std::endl;
+
+		for (int run = 0; run < num_runs; run++)
+		{
+			std::cout << "." << std::flush;
+
+			// reset time control
+			i_simVars.timecontrol.current_timestep_nr = 0;
+			i_simVars.timecontrol.current_simulation_time = 0;
+
+			for (int prog_id = 0; prog_id < num_prog; prog_id++)
+				prog[prog_id]->spectral_set_zero();
+
+			// activate one unit vector for each m
+			for (int m = 0; m <= m_max; m++)
+			{
+				if (run >= block_size[m])
+					continue;
+
+				std::complex<double> &d = prog[p_block_prog_id(run, m, n_max, num_parts)]->spectral_space_data[p_block_array_index(sphereDataConfig, run, m, n_max, num_parts)];
+
+				if (run % num_parts == 1)
+					d.imag(1);
+				else
+					d.real(1);
+			}
+
+			for (int prog_id = 0; prog_id < num_prog; prog_id++)
+				prog[prog_id]->spectral_data_modified();
+
+			for (int i = 0; i < num_timesteps; i++)
+				(i_class->*i_run_timestep_method)();
+
+			SWEET_THREADING_SPACE_PARALLEL_FOR
+			for (int m = 0; m <= m_max; m++)
+			{
+				if (run >= block_size[m])
+					continue;
+
+				std::complex<double> *column = &blocks[m][(std::size_t)run*block_size[m]];
+
+				for (int row = 0; row < block_size[m]; row++)
+				{
+					const std::complex<double> &d = prog[p_block_prog_id(row, m, n_max, num_parts)]->spectral_space_data[p_block_array_index(sphereDataConfig, row, m, n_max, num_parts)];
+
+					if (complex_blocks)
+						column[row] = d;
+					else
+						column[row] = (row % num_parts == 1) ? d.imag() : d.real();
+				}
+
+				if (generation < 10)
+				{
+					/*
+					 * compute
+					 * 1/dt * (U(t+1) - U(t))
+					 */
+					column[run] -= 1.0;
+
+					for (int row = 0; row < block_size[m]; row++)
+						column[row] /= i_simVars.timecontrol.current_timestep_size;
+				}
+			}
+		}
+
+		std::cout << std::endl;
+
+		/*
+		 * Write blocks
+		 */
+		std::string filename = p_get_output_filename(i_simVars, "normal_modes_blocks", ".bin");
+		std::cout << "Writing normal mode operator blocks to file '" << filename << "'" << std::endl;
+
+		std::ofstream file(filename, std::ios_base::trunc | std::ios_base::binary);
+		if (!file.is_open())
+			FatalError("Failed to open file '"+filename+"'");
+
+		file.write("SWEETNMB", 8);
+
+		std::int32_t header[5] = {2, n_max, m_max, num_prog, num_parts};
+		file.write((const char*)header, sizeof(header));
+
+		double params[5] = {
+				t,
+				i_simVars.sim.gravitation,
+				i_simVars.sim.h0,
+				i_simVars.sim.sphere_radius,
+				i_simVars.sim.sphere_rotating_coriolis_omega
+		};
+		file.write((const char*)params, sizeof(params));
+
+		for (int m = 0; m <= m_max; m++)
+		{
+			std::int32_t block_header[2] = {m, block_size[m]};
+			file.write((const char*)block_header, sizeof(block_header));
+
+			if (complex_blocks)
+			{
+				file.write((const char*)blocks[m].data(), sizeof(std::complex<double>)*blocks[m].size());
+			}
+			else
+			{
+				std::vector<double> real_block(blocks[m].size());
+				for (std::size_t i = 0; i < blocks[m].size(); i++)
+					real_block[i] = blocks[m][i].real();
+
+				file.write((const char*)real_block.data(), sizeof(double)*real_block.size());
+			}
+		}
+
+#if SWEET_EIGEN
+		if (i_simVars.misc.normal_mode_analysis_batched >= 2)
+		{
+			std::vector<std::vector<std::complex<double>>> eigenvalues(m_max+1);
+
+			// Blocks have different sizes
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for schedule(dynamic)
+#endif
+			for (int m = 0; m <= m_max; m++)
+			{
+				Eigen::Map<const Eigen::MatrixXcd> A(blocks[m].data(), block_size[m], block_size[m]);
+				eigenvalues[m].resize(block_size[m]);
+
+				if (complex_blocks)
+				{
+					Eigen::ComplexEigenSolver<Eigen::MatrixXcd> es(A, false);
+
+					for (int i = 0; i < block_size[m]; i++)
+						eigenvalues[m][i] = es.eigenvalues()[i];
+				}
+				else
+				{
+					Eigen::MatrixXd A_real = A.real();
+					Eigen::EigenSolver<Eigen::MatrixXd> es(A_real, false);
+
+					for (int i = 0; i < block_size[m]; i++)
+						eigenvalues[m][i] = es.eigenvalues()[i];
+				}
+			}
+
+			std::string filename_ev = p_get_output_filename(i_simVars, "normal_modes_eigenvalues", ".csv");
+			std::cout << "Writing eigenvalues to file '" << filename_ev << "'" << std::endl;
+
+			std::ofstream file_ev(filename_ev, std::ios_base::trunc);
+			file_ev << std::setprecision(20);
+			file_ev << "# t " << t << std::endl;
+			file_ev << "# m\treal\timag" << std::endl;
+
+			for (int m = 0; m <= m_max; m++)
+				for (std::size_t i = 0; i < eigenvalues[m].size(); i++)
+					file_ev << m << "\t" << eigenvalues[m][i].real() << "\t" << eigenvalues[m][i].imag() << std::endl;
+		}
+#endif
+	}
+
+
+
+private:
+	/**
+	 * Prognostic variable of the given index in the block of mode m
+	 */
+	static
+	int p_block_prog_id(
+			int i_index,
+			int i_m,
+			int i_n_max,
+			int i_num_parts
+	)
+	{
+		return (i_index/i_num_parts)/(i_n_max-i_m+1);
+	}
+
+
+	/**
+	 * Index in the spectral array of the given index in the block of mode m
+	 */
+	static
+	std::size_t p_block_array_index(
+			const SphereData_Config *i_sphereDataConfig,
+			int i_index,
+			int i_m,
+			int i_n_max,
+			int i_num_parts
+	)
+	{
+		int n = i_m + (i_index/i_num_parts) % (i_n_max-i_m+1);
+		return i_sphereDataConfig->getArrayIndexByModes(n, i_m);
+	}
+
+
+	/**
+	 * Output file name based on the output file name pattern with a new extension
+	 */
+	static
+	std::string p_get_output_filename(
+			SimulationVariables &i_simVars,
+			const char *i_name,
+			const char *i_extension
+	)
+	{
+		std::string pattern = i_simVars.iodata.output_file_name;
+		if (pattern == "")
+			pattern = "output_%s_t%020.8f.csv";
+
+		char buffer[1024];
+		sprintf(buffer, pattern.c_str(), i_name, i_simVars.timecontrol.current_timestep_size*i_simVars.iodata.output_time_scale);
+
+		std::string filename = buffer;
+		std::size_t pos = filename.rfind('.');
+		if (pos != std::string::npos && filename.find('/', pos) == std::string::npos)
+			filename = filename.substr(0, pos);
+
+		return filename + i_extension;
+	}
 };
 
 
@@ -9,9 +9,12 @@
 #define SRC_PROGRAMS_SWE_SPHERE_TS_INTERFACE_HPP_
 
 #include <sweet/sphere/SphereData_Spectral.hpp>
+#include <sweet/sphere/SphereData_SpectralDistributed.hpp>
 #include <sweet/sphere/SphereOperators_SphereData.hpp>
+#include <sweet/FatalError.hpp>
 #include <limits>
 #include <sweet/SimulationVariables.hpp>
+#include <sweet/SWEETCheckpoint.hpp>
 
 
 class SWE_Sphere_TS_interface
@@ -25,6 +28,68 @@ public:
 			double i_fixed_dt,		///< if this value is not equal to 0, use this time step size instead of computing one
 			double i_simulation_timestamp
 	) = 0;
+
+
+	/**
+	 * Time step for sphere data distributed over MPI ranks (see --space-sphere-distributed).
+	 *
+	 * This has to be called by all ranks.
+	 */
+	virtual void run_timestep(
+			SphereData_SpectralDistributed &io_h,	///< prognostic variables
+			SphereData_SpectralDistributed &io_u,	///< prognostic variables
+			SphereData_SpectralDistributed &io_v,	///< prognostic variables
+
+			double i_dt,		///< time step size
+			double i_simulation_timestamp
+	)
+	{
+		FatalError("This time stepper does not support distributed sphere data");
+	}
+
+
+	/**
+	 * Run a time step with a local error estimate for adaptive time step size control.
+	 *
+	 * The prognostic variables are only updated if the time step is accepted,
+	 * i.e. if the returned scaled error is <= 1.
+	 */
+	virtual double run_timestep_adaptive(
+			SphereData_Spectral &io_h,	///< prognostic variables
+			SphereData_Spectral &io_u,	///< prognostic variables
+			SphereData_Spectral &io_v,	///< prognostic variables
+
+			double i_dt,				///< time step size to try
+			double i_simulation_timestamp
+	)
+	{
+		FatalError("Adaptive time stepping is not supported by this time stepper");
+		return 0;
+	}
+
+
+	/**
+	 * Store internal state of time stepper (e.g. data of previous time steps) to checkpoint.
+	 *
+	 * Nothing needs to be done for single-step methods.
+	 */
+	virtual void checkpoint_write(
+			SWEETCheckpoint &io_checkpoint,
+			const std::string &i_prefix		///< prefix for names of checkpoint entries
+	)
+	{
+	}
+
+
+	/**
+	 * Load internal state of time stepper from checkpoint
+	 */
+	virtual void checkpoint_read(
+			const SWEETCheckpoint &i_checkpoint,
+			const std::string &i_prefix		///< prefix for names of checkpoint entries
+	)
+	{
+	}
 };
 
 #endif /* SRC_PROGRAMS_SWE_PLANE_REXI_SWE_PLANE_TS_LN_ERK_HPP_ */
@@ -9,6 +9,7 @@
 #include "SWE_Sphere_TS_l_irk.hpp"
 #include <complex>
 #include <sweet/sphere/app_swe/SWESphBandedMatrixPhysicalReal.hpp>
+#include <sweet/sphere/app_swe/SWESphImplicitOperatorCache.hpp>
 #include <sweet/sphere/SphereData_Config.hpp>
 #include <sweet/sphere/SphereOperators_SphereData.hpp>
 
@@ -85,23 +86,43 @@ void SWE_Sphere_TS_l_irk::update_coefficients()
 {
 	if (!use_f_sphere)
 	{
-		sphSolverPhi.setup(sphereDataConfigSolver, 4);
-		sphSolverPhi.solver_component_rexi_z1(	(alpha*alpha)*(alpha*alpha), r);
-		sphSolverPhi.solver_component_rexi_z2(	2.0*two_coriolis*two_coriolis*alpha*alpha, r);
-		sphSolverPhi.solver_component_rexi_z3(	(two_coriolis*two_coriolis)*(two_coriolis*two_coriolis), r);
-		sphSolverPhi.solver_component_rexi_z4robert(	-gh*alpha*two_coriolis, r);
-		sphSolverPhi.solver_component_rexi_z5robert(	gh/alpha*two_coriolis*two_coriolis*two_coriolis, r);
-		sphSolverPhi.solver_component_rexi_z6robert(	gh*2.0*two_coriolis*two_coriolis, r);
-		sphSolverPhi.solver_component_rexi_z7(	-gh*alpha*alpha, r);
-		sphSolverPhi.solver_component_rexi_z8(	-gh*two_coriolis*two_coriolis, r);
-
-		mug.setup(sphereDataConfig);
-		mug.physical_update_lambda_gaussian_grid(
-			[&](double lon, double mu, double &o_data)
-			{
-				o_data = mu;
-			}
-		);
+		typedef SphBandedMatrixPhysicalReal< std::complex<double> > Matrix;
+		typedef SWESphImplicitOperatorCache<Matrix> Cache;
+
+		/*
+		 * Reuse the factorized operator if it was already set up for this time step size
+		 */
+		Cache::Key key = Cache::createKey(sphereDataConfigSolver, timestep_size, Cache::CORIOLIS_FULL, alpha, beta, r, two_coriolis, gh);
+
+		sphSolverPhi = Cache::getInstance().get(
+				key,
+				[&](Matrix &o_solver)
+				{
+					o_solver.setup(sphereDataConfigSolver, 4);
+					o_solver.solver_component_rexi_z1(	(alpha*alpha)*(alpha*alpha), r);
+					o_solver.solver_component_rexi_z2(	2.0*two_coriolis*two_coriolis*alpha*alpha, r);
+					o_solver.solver_component_rexi_z3(	(two_coriolis*two_coriolis)*(two_coriolis*two_coriolis), r);
+					o_solver.solver_component_rexi_z4robert(	-gh*alpha*two_coriolis, r);
+					o_solver.solver_component_rexi_z5robert(	gh/alpha*two_coriolis*two_coriolis*two_coriolis, r);
+					o_solver.solver_component_rexi_z6robert(	gh*2.0*two_coriolis*two_coriolis, r);
+					o_solver.solver_component_rexi_z7(	-gh*alpha*alpha, r);
+					o_solver.solver_component_rexi_z8(	-gh*two_coriolis*two_coriolis, r);
+
+					o_solver.factorize();
+				}
+			);
+
+		// Independent of the time step size
+		if (mug.sphereDataConfig != sphereDataConfig)
+		{
+			mug.setup(sphereDataConfig);
+			mug.physical_update_lambda_gaussian_grid(
+				[&](double lon, double mu, double &o_data)
+				{
+					o_data = mu;
+				}
+			);
+		}
 	}
 }
 
@@ -124,7 +145,9 @@ void SWE_Sphere_TS_l_irk::run_timestep(
 
 	if (std::abs(timestep_size - i_fixed_dt)/std::max(timestep_size, i_fixed_dt) > 1e-10)
 	{
-	        std::cout << "Warning: Reducing time step size from " << i_fixed_dt << " to " << timestep_size << std::endl;
+	        // Changes of the time step size are expected with the implicit operator cache
+	        if (simVars.misc.verbosity > 1)
+	        	std::cout << "Changing time step size from " << timestep_size << " to " << i_fixed_dt << std::endl;
 
 	        timestep_size = i_fixed_dt;
 
@@ -180,20 +203,16 @@ void SWE_Sphere_TS_l_irk::run_timestep(
 
 		rhs = rhsg;
 
-		phi = sphSolverPhi.solve(rhs.spectral_returnWithDifferentModes(sphereDataConfigSolver)).spectral_returnWithDifferentModes(sphereDataConfig);
-
-
-		SphereData_Physical u0(sphereDataConfig);
-		SphereData_Physical v0(sphereDataConfig);
+		phi = sphSolverPhi->solve(rhs.spectral_returnWithDifferentModes(sphereDataConfigSolver)).spectral_returnWithDifferentModes(sphereDataConfig);
 
-		op.robert_vortdiv_to_uv(vort0, div0, u0, v0);
 
 		SphereData_Physical gradu(sphereDataConfig);
 		SphereData_Physical gradv(sphereDataConfig);
 		op.robert_grad_to_vec(phi, gradu, gradv, r);
 
-		SphereData_Physical a = u0 + gradu;
-		SphereData_Physical b = v0 + gradv;
+		// Reuse velocities computed for the RHS
+		SphereData_Physical a = u0g + gradu;
+		SphereData_Physical b = v0g + gradv;
 
 		SphereData_Physical k = (two_coriolis*two_coriolis*mug*mug+alpha*alpha);
 		SphereData_Physical u = (alpha*a - two_coriolis*mug*(b))/k;
@@ -160,6 +160,26 @@ SWE_Sphere_TS_l_lf::SWE_Sphere_TS_l_lf(
 
 
 
+void SWE_Sphere_TS_l_lf::checkpoint_write(
+		SWEETCheckpoint &io_checkpoint,
+		const std::string &i_prefix
+)
+{
+	timestepping_lf.checkpoint_write(io_checkpoint, i_prefix+"lf_");
+}
+
+
+
+void SWE_Sphere_TS_l_lf::checkpoint_read(
+		const SWEETCheckpoint &i_checkpoint,
+		const std::string &i_prefix
+)
+{
+	timestepping_lf.checkpoint_read(i_checkpoint, i_prefix+"lf_");
+}
+
+
+
 SWE_Sphere_TS_l_lf::~SWE_Sphere_TS_l_lf()
 {
 }
@@ -68,6 +68,18 @@ public:
 
 
 
+	void checkpoint_write(
+			SWEETCheckpoint &io_checkpoint,
+			const std::string &i_prefix
+	);
+
+	void checkpoint_read(
+			const SWEETCheckpoint &i_checkpoint,
+			const std::string &i_prefix
+	);
+
+
+
 	virtual ~SWE_Sphere_TS_l_lf();
 };
 
@@ -10,10 +10,12 @@
 #include <iostream>
 #include <cassert>
 #include <utility>
+#include <chrono>
 #include <rexi/REXI.hpp>
 #include <sweet/sphere/Convert_SphereDataSpectralComplex_to_SphereDataSpectral.hpp>
 #include <sweet/sphere/Convert_SphereDataSpectral_to_SphereDataSpectralComplex.hpp>
 #include <sweet/SimulationBenchmarkTiming.hpp>
+#include <sweet/SimulationProfiler.hpp>
 
 #ifndef SWEET_THREADING_TIME_REXI
 #	define SWEET_THREADING_TIME_REXI 1
@@ -50,6 +52,8 @@ SWE_Sphere_TS_l_rexi::SWE_Sphere_TS_l_rexi(
 	sphereDataConfig(i_op.sphereDataConfig),
 	sphereDataConfigSolver(nullptr)
 {
+	num_timesteps = 0;
+	thread_groups_calibration_active = false;
 
 	#if SWEET_REXI_TIMINGS
 		SimulationBenchmarkTimings::getInstance().rexi.start();
@@ -165,38 +169,8 @@ SWE_Sphere_TS_l_rexi::~SWE_Sphere_TS_l_rexi()
 		SimulationBenchmarkTimings::getInstance().rexi_shutdown.stop();
 		SimulationBenchmarkTimings::getInstance().rexi.stop();
 	#endif
-}
-
-
-
-void SWE_Sphere_TS_l_rexi::p_get_workload_start_end(
-		std::size_t &o_start,
-		std::size_t &o_end,
-		int i_local_thread_id
-)
-{
-	std::size_t max_N = rexi_alpha.size();
-
-	#if SWEET_THREADING_TIME_REXI || SWEET_MPI
 
-		#if SWEET_MPI
-			int global_thread_id = i_local_thread_id + num_local_rexi_par_threads*mpi_rank;
-		#else
-			int global_thread_id = i_local_thread_id;
-		#endif
-
-		assert(block_size >= 0);
-		assert(global_thread_id >= 0);
-
-		o_start = std::min(max_N, block_size*global_thread_id);
-		o_end = std::min(max_N, o_start+block_size);
-
-	#else
-
-		o_start = 0;
-		o_end = max_N;
-
-	#endif
+	p_output_load_imbalance();
 }
 
 
@@ -267,95 +241,328 @@ void SWE_Sphere_TS_l_rexi::setup(
 		}
 
 		std::size_t N = rexi_alpha.size();
-		block_size = N/num_global_threads;
-		if (block_size*num_global_threads != N)
-			block_size++;
 
-		perThreadVars.resize(num_local_rexi_par_threads);
+		#if SWEET_MPI
+			int max_groups = (N + num_mpi_ranks - 1)/num_mpi_ranks;
+		#else
+			int max_groups = N;
+		#endif
 
+		threadGroups.setup(rexiSimVars->thread_groups, max_groups);
 
-		/**
-		 * We split the setup from the utilization here.
-		 *
-		 * This is necessary, since it has to be assured that
-		 * the FFTW plans are initialized before using them.
-		 */
-		if (num_local_rexi_par_threads == 0)
+		// Start with equal costs for all terms
+		rexi_term_costs.clear();
+		num_timesteps = 0;
+
+		p_setup_thread_groups();
+	}	// rexi_use_direct_solution
+
+	#if SWEET_REXI_TIMINGS
+		SimulationBenchmarkTimings::getInstance().rexi_setup.stop();
+		SimulationBenchmarkTimings::getInstance().rexi.stop();
+	#endif
+}
+
+
+
+/**
+ * Setup the per-thread-group data for the current split of threads
+ */
+void SWE_Sphere_TS_l_rexi::p_setup_thread_groups()
+{
+	for (std::vector<PerThreadVars*>::iterator iter = perThreadVars.begin(); iter != perThreadVars.end(); iter++)
+	{
+		PerThreadVars* p = *iter;
+		delete p;
+	}
+
+	num_local_rexi_par_threads = threadGroups.num_groups;
+
+	#if SWEET_MPI
+		num_global_threads = num_local_rexi_par_threads * num_mpi_ranks;
+	#else
+		num_global_threads = num_local_rexi_par_threads;
+	#endif
+
+	perThreadVars.resize(num_local_rexi_par_threads);
+
+	/*
+	 * Each group gets its own SHTNS plans with the number of threads of the
+	 * group. Otherwise, the transformations of all groups would use all threads.
+	 */
+	bool use_group_configs = (threadGroups.num_groups > 1 && threadGroups.num_threads_per_group > 1);
+
+	/**
+	 * We split the setup from the utilization here.
+	 *
+	 * This is necessary, since it has to be assured that
+	 * the FFTW plans are initialized before using them.
+	 */
+	if (num_local_rexi_par_threads == 0)
+	{
+		std::cerr << "FATAL ERROR B: omp_get_max_threads == 0" << std::endl;
+		exit(-1);
+	}
+
+	#if SWEET_THREADING_SPACE || SWEET_THREADING_TIME_REXI
+		if (omp_in_parallel())
 		{
-			std::cerr << "FATAL ERROR B: omp_get_max_threads == 0" << std::endl;
+			std::cerr << "FATAL ERROR X: in parallel region" << std::endl;
 			exit(-1);
 		}
+	#endif
 
-		#if SWEET_THREADING_SPACE || SWEET_THREADING_TIME_REXI
-			if (omp_in_parallel())
-			{
-				std::cerr << "FATAL ERROR X: in parallel region" << std::endl;
-				exit(-1);
-			}
+	// use a kind of serialization of the input to avoid threading conflicts in the ComplexFFT generation
+	for (int j = 0; j < num_local_rexi_par_threads; j++)
+	{
+		#if SWEET_THREADING_TIME_REXI
+		#pragma omp parallel for schedule(static,1) default(none) shared(std::cout,j,use_group_configs) num_threads(num_local_rexi_par_threads)
 		#endif
-
-		// use a kind of serialization of the input to avoid threading conflicts in the ComplexFFT generation
-		for (int j = 0; j < num_local_rexi_par_threads; j++)
+		for (int local_thread_id = 0; local_thread_id < num_local_rexi_par_threads; local_thread_id++)
 		{
-			#if SWEET_THREADING_TIME_REXI
-			#pragma omp parallel for schedule(static,1) default(none) shared(std::cout,j)
+			if (local_thread_id != j)
+				continue;
+
+			#if SWEET_DEBUG && SWEET_THREADING_TIME_REXI
+				if (omp_get_thread_num() != local_thread_id)
+				{
+					// leave this dummy std::cout in it to avoid the intel compiler removing this part
+					std::cout << "ERROR: thread " << omp_get_thread_num() << " number mismatch " << local_thread_id << std::endl;
+					exit(-1);
+				}
 			#endif
-			for (int local_thread_id = 0; local_thread_id < num_local_rexi_par_threads; local_thread_id++)
+
+			PerThreadVars *p = new PerThreadVars;
+			perThreadVars[local_thread_id] = p;
+
+			if (use_group_configs)
 			{
-				if (local_thread_id != j)
-					continue;
+				p->sphereDataConfigInstance.setupSameResolution(
+						sphereDataConfigSolver,
+						threadGroups.num_threads_per_group,
+						simVars.misc.reuse_spectral_transformation_plans
+					);
 
-				#if SWEET_DEBUG && SWEET_THREADING_TIME_REXI
-					if (omp_get_thread_num() != local_thread_id)
-					{
-						// leave this dummy std::cout in it to avoid the intel compiler removing this part
-						std::cout << "ERROR: thread " << omp_get_thread_num() << " number mismatch " << local_thread_id << std::endl;
-						exit(-1);
-					}
-				#endif
+				p->sphereDataConfig = &p->sphereDataConfigInstance;
+			}
+			else
+			{
+				p->sphereDataConfig = sphereDataConfigSolver;
+			}
 
-				perThreadVars[local_thread_id] = new PerThreadVars;
+			p->accum_phi.setup(p->sphereDataConfig);
+			p->accum_vort.setup(p->sphereDataConfig);
+			p->accum_div.setup(p->sphereDataConfig);
 
-				std::size_t start, end;
-				p_get_workload_start_end(start, end, local_thread_id);
-				int local_size = (int)end-(int)start;
+			p->busy_seconds = 0;
+		}
+	}
 
-				#if SWEET_DEBUG
-					if (local_size < 0)
-						FatalError("local_size < 0");
-				#endif
+	p_setup_workload();
 
-				perThreadVars[local_thread_id]->alpha.resize(local_size);
-				perThreadVars[local_thread_id]->beta_re.resize(local_size);
+	if (num_local_rexi_par_threads == 0)
+	{
+		std::cerr << "FATAL ERROR C: omp_get_max_threads == 0" << std::endl;
+		exit(-1);
+	}
+}
 
-				perThreadVars[local_thread_id]->accum_phi.setup(sphereDataConfigSolver);
-				perThreadVars[local_thread_id]->accum_vort.setup(sphereDataConfigSolver);
-				perThreadVars[local_thread_id]->accum_div.setup(sphereDataConfigSolver);
 
-				for (std::size_t n = start; n < end; n++)
-				{
-					int thread_local_idx = n-start;
 
-					perThreadVars[local_thread_id]->alpha[thread_local_idx] = rexi_alpha[n];
-					perThreadVars[local_thread_id]->beta_re[thread_local_idx] = rexi_beta[n];
-				}
-			}
-		}
+/**
+ * Distribute the REXI terms to the thread groups of all ranks
+ */
+void SWE_Sphere_TS_l_rexi::p_setup_workload()
+{
+	std::vector< std::vector<std::size_t> > parts;
 
-		p_update_coefficients(false);
+	if (rexi_term_costs.size() == rexi_alpha.size())
+		REXI_WorkloadPartitioner::partitionCosts(rexi_term_costs, num_global_threads, parts);
+	else
+		REXI_WorkloadPartitioner::partitionBlocks(rexi_alpha.size(), num_global_threads, parts);
 
-		if (num_local_rexi_par_threads == 0)
+	#if SWEET_MPI
+		int first_part = num_local_rexi_par_threads*mpi_rank;
+	#else
+		int first_part = 0;
+	#endif
+
+	std::vector<std::size_t> queue_sizes(num_local_rexi_par_threads);
+
+	for (int local_thread_id = 0; local_thread_id < num_local_rexi_par_threads; local_thread_id++)
+	{
+		PerThreadVars *p = perThreadVars[local_thread_id];
+
+		p->term_ids = parts[first_part + local_thread_id];
+
+		std::size_t local_size = p->term_ids.size();
+		p->alpha.resize(local_size);
+		p->beta_re.resize(local_size);
+
+		for (std::size_t i = 0; i < local_size; i++)
 		{
-			std::cerr << "FATAL ERROR C: omp_get_max_threads == 0" << std::endl;
-			exit(-1);
+			p->alpha[i] = rexi_alpha[p->term_ids[i]];
+			p->beta_re[i] = rexi_beta[p->term_ids[i]];
 		}
 
-	}	// rexi_use_direct_solution
+		queue_sizes[local_thread_id] = local_size;
+	}
 
-	#if SWEET_REXI_TIMINGS
-		SimulationBenchmarkTimings::getInstance().rexi_setup.stop();
-		SimulationBenchmarkTimings::getInstance().rexi.stop();
+	/*
+	 * The solvers of a term are set up with the config of the owning group.
+	 * With group configs, a stealing group would mix its data with the
+	 * config (and threaded SHTNS plans) of another group.
+	 */
+	bool use_group_configs = (num_local_rexi_par_threads > 0 && perThreadVars[0]->sphereDataConfig != sphereDataConfigSolver);
+
+	bool work_stealing = (rexiSimVars->load_balancing == 2);
+	if (work_stealing && use_group_configs)
+	{
+		if (simVars.misc.verbosity > 0)
+			std::cout << "REXI: Work stealing disabled since thread groups use their own configurations" << std::endl;
+
+		work_stealing = false;
+	}
+
+	workQueues.setup(queue_sizes, work_stealing);
+
+	rexi_term_seconds.assign(rexi_alpha.size(), 0);
+
+	p_update_coefficients(false);
+}
+
+
+
+/**
+ * Update statistics of the load imbalance of the last time step and
+ * redistribute the REXI terms based on their measured costs
+ */
+void SWE_Sphere_TS_l_rexi::p_update_load_balancing()
+{
+	if (thread_groups_calibration_active)
+		return;
+
+	double max_load = 0;
+	double sum_loads = 0;
+
+	for (int local_thread_id = 0; local_thread_id < num_local_rexi_par_threads; local_thread_id++)
+	{
+		max_load = std::max(max_load, perThreadVars[local_thread_id]->busy_seconds);
+		sum_loads += perThreadVars[local_thread_id]->busy_seconds;
+	}
+
+	load_max_timesteps.push_back(max_load);
+	load_sum_timesteps.push_back(sum_loads);
+
+	if (simVars.misc.verbosity > 2)
+	{
+		// Only reduce the loads of each time step for this output
+		#if SWEET_MPI
+			MPI_Allreduce(MPI_IN_PLACE, &max_load, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+			MPI_Allreduce(MPI_IN_PLACE, &sum_loads, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+			if (mpi_rank == 0)
+		#endif
+			std::cout << "REXI load imbalance (max/avg): " << REXI_WorkloadPartitioner::getImbalance(max_load, sum_loads, num_global_threads) << std::endl;
+	}
+
+	num_timesteps++;
+
+	/*
+	 * Use the measurements of the 2nd time step since the 1st one includes first-touch effects
+	 */
+	if (rexiSimVars->load_balancing > 0 && num_timesteps == 2)
+	{
+		// Each term was only processed by one rank
+		rexi_term_costs = rexi_term_seconds;
+
+		#if SWEET_MPI
+			MPI_Allreduce(MPI_IN_PLACE, rexi_term_costs.data(), rexi_term_costs.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+		#endif
+
+		p_setup_workload();
+	}
+}
+
+
+
+/**
+ * Output average and max. load imbalance of all time steps
+ *
+ * The loads of all time steps are reduced over all ranks at once.
+ * Collective operation with MPI
+ */
+void SWE_Sphere_TS_l_rexi::p_output_load_imbalance()
+{
+	if (load_max_timesteps.size() == 0)
+		return;
+
+	#if SWEET_MPI
+		if (mpi_rank == 0)
+		{
+			MPI_Reduce(MPI_IN_PLACE, load_max_timesteps.data(), load_max_timesteps.size(), MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+			MPI_Reduce(MPI_IN_PLACE, load_sum_timesteps.data(), load_sum_timesteps.size(), MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+		}
+		else
+		{
+			MPI_Reduce(load_max_timesteps.data(), nullptr, load_max_timesteps.size(), MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+			MPI_Reduce(load_sum_timesteps.data(), nullptr, load_sum_timesteps.size(), MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+			return;
+		}
 	#endif
+
+	double load_imbalance_sum = 0;
+	double load_imbalance_max = 0;
+
+	for (std::size_t i = 0; i < load_max_timesteps.size(); i++)
+	{
+		double load_imbalance = REXI_WorkloadPartitioner::getImbalance(load_max_timesteps[i], load_sum_timesteps[i], num_global_threads);
+
+		load_imbalance_sum += load_imbalance;
+		load_imbalance_max = std::max(load_imbalance_max, load_imbalance);
+	}
+
+	std::cout << "[MULE] rexi.load_imbalance_avg: " << load_imbalance_sum/(double)load_max_timesteps.size() << std::endl;
+	std::cout << "[MULE] rexi.load_imbalance_max: " << load_imbalance_max << std::endl;
+}
+
+
+
+/**
+ * Determine the split of threads into groups by running REXI time steps
+ */
+void SWE_Sphere_TS_l_rexi::p_calibrate_thread_groups(
+		const SphereData_Spectral &i_prog_phi0,
+		const SphereData_Spectral &i_prog_vort0,
+		const SphereData_Spectral &i_prog_div0,
+		double i_fixed_dt,
+		double i_simulation_timestamp
+)
+{
+	SphereData_Spectral phi(i_prog_phi0.sphereDataConfig);
+	SphereData_Spectral vort(i_prog_vort0.sphereDataConfig);
+	SphereData_Spectral div(i_prog_div0.sphereDataConfig);
+
+	thread_groups_calibration_active = true;
+
+	threadGroups.calibrate(
+			"rexi",
+			[&]()
+			{
+				p_setup_thread_groups();
+			},
+			[&]()
+			{
+				phi = i_prog_phi0;
+				vort = i_prog_vort0;
+				div = i_prog_div0;
+
+				run_timestep(phi, vort, div, i_fixed_dt, i_simulation_timestamp);
+			},
+			simVars.misc.verbosity
+		);
+
+	thread_groups_calibration_active = false;
 }
 
 
@@ -376,25 +583,25 @@ void SWE_Sphere_TS_l_rexi::p_update_coefficients(
 		);
 	}
 
+	REXI_ThreadGroupPlanner::NestedRegion nested(threadGroups);
+
 	#if SWEET_THREADING_TIME_REXI
-	#pragma omp parallel for schedule(static,1) default(none) shared(std::cout)
+	#pragma omp parallel for schedule(static,1) default(none) shared(std::cout) num_threads(num_local_rexi_par_threads)
 	#endif
 	for (int local_thread_id = 0; local_thread_id < num_local_rexi_par_threads; local_thread_id++)
 	{
-		std::size_t start, end;
-		p_get_workload_start_end(start, end, local_thread_id);
-		int local_size = (int)end-(int)start;
+		threadGroups.setupGroupThread();
+
+		std::size_t local_size = perThreadVars[local_thread_id]->alpha.size();
 
 		if (use_rexi_sphere_solver_preallocation)
 		{
 			perThreadVars[local_thread_id]->rexiSPHRobert_vector.resize(local_size);
 
-			for (std::size_t n = start; n < end; n++)
+			for (std::size_t thread_local_idx = 0; thread_local_idx < local_size; thread_local_idx++)
 			{
-				int thread_local_idx = n-start;
-
 				perThreadVars[local_thread_id]->rexiSPHRobert_vector[thread_local_idx].setup_vectorinvariant_progphivortdiv(
-						sphereDataConfigSolver,
+						perThreadVars[local_thread_id]->sphereDataConfig,
 						perThreadVars[local_thread_id]->alpha[thread_local_idx],
 						perThreadVars[local_thread_id]->beta_re[thread_local_idx],
 						simCoeffs.sphere_radius,
@@ -463,6 +670,11 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 	double i_simulation_timestamp
 )
 {
+	SWEET_PROFILER_REGION("rexi");
+
+	if (threadGroups.isCalibrationPending())
+		p_calibrate_thread_groups(io_prog_phi0, io_prog_vort0, io_prog_div0, i_fixed_dt, i_simulation_timestamp);
+
 	#if SWEET_REXI_TIMINGS
 		SimulationBenchmarkTimings::getInstance().rexi.start();
 		SimulationBenchmarkTimings::getInstance().rexi_timestepping.start();
@@ -606,8 +818,9 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 			SimulationBenchmarkTimings::getInstance().rexi_timestepping_solver.start();
 		#endif
 
-			std::size_t start, end;
-			p_get_workload_start_end(start, end, 0);
+			workQueues.reset();
+
+			std::chrono::steady_clock::time_point group_start = std::chrono::steady_clock::now();
 
 			perThreadVars[0]->accum_phi.spectral_set_zero();
 			perThreadVars[0]->accum_vort.spectral_set_zero();
@@ -624,13 +837,18 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 				SphereData_Spectral tmp_prog_vort(sphereDataConfigSolver);
 				SphereData_Spectral tmp_prog_div(sphereDataConfigSolver);
 
-				for (std::size_t workload_idx = start; workload_idx < end; workload_idx++)
+				int owner_id;
+				std::size_t local_idx;
+				while (workQueues.getNext(0, owner_id, local_idx))
 				{
-					int local_idx = workload_idx-start;
+					SWEET_PROFILER_REGION("rexi_term");
+
+					PerThreadVars *owner = perThreadVars[owner_id];
+					std::chrono::steady_clock::time_point term_start = std::chrono::steady_clock::now();
 
 					if (use_rexi_sphere_solver_preallocation)
 					{
-						perThreadVars[0]->rexiSPHRobert_vector[local_idx].solve_vectorinvariant_progphivortdiv(
+						owner->rexiSPHRobert_vector[local_idx].solve_vectorinvariant_progphivortdiv(
 								io_prog_phi0, io_prog_vort0, io_prog_div0,
 								tmp_prog_phi, tmp_prog_vort, tmp_prog_div
 							);
@@ -639,8 +857,8 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 					{
 						SWERexiTerm_SPHRobert rexiSPHRobert;
 
-						std::complex<double> &alpha = perThreadVars[0]->alpha[local_idx];
-						std::complex<double> &beta_re = perThreadVars[0]->beta_re[local_idx];
+						std::complex<double> &alpha = owner->alpha[local_idx];
+						std::complex<double> &beta_re = owner->beta_re[local_idx];
 
 						rexiSPHRobert.setup_vectorinvariant_progphivortdiv(
 								sphereDataConfigSolver,	///< sphere data for input data
@@ -666,6 +884,8 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 					perThreadVars[0]->accum_phi += tmp_prog_phi;
 					perThreadVars[0]->accum_vort += tmp_prog_vort;
 					perThreadVars[0]->accum_div += tmp_prog_div;
+
+					rexi_term_seconds[owner->term_ids[local_idx]] = std::chrono::duration<double>(std::chrono::steady_clock::now() - term_start).count();
 				}
 
 
@@ -688,13 +908,18 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 				SphereData_Spectral tmp_prog_vort(sphereDataConfigSolver);
 				SphereData_Spectral tmp_prog_div(sphereDataConfigSolver);
 
-				for (std::size_t workload_idx = start; workload_idx < end; workload_idx++)
+				int owner_id;
+				std::size_t local_idx;
+				while (workQueues.getNext(0, owner_id, local_idx))
 				{
-					int local_idx = workload_idx-start;
+					SWEET_PROFILER_REGION("rexi_term");
+
+					PerThreadVars *owner = perThreadVars[owner_id];
+					std::chrono::steady_clock::time_point term_start = std::chrono::steady_clock::now();
 
 					if (use_rexi_sphere_solver_preallocation)
 					{
-						perThreadVars[0]->rexiSPHRobert_vector[local_idx].solve_vectorinvariant_progphivortdiv(
+						owner->rexiSPHRobert_vector[local_idx].solve_vectorinvariant_progphivortdiv(
 								thread_prog_phi0, thread_prog_vort0, thread_prog_div0,
 								tmp_prog_phi, tmp_prog_vort, tmp_prog_div
 							);
@@ -703,8 +928,8 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 					{
 						SWERexiTerm_SPHRobert rexiSPHRobert;
 
-						std::complex<double> &alpha = perThreadVars[0]->alpha[local_idx];
-						std::complex<double> &beta_re = perThreadVars[0]->beta_re[local_idx];
+						std::complex<double> &alpha = owner->alpha[local_idx];
+						std::complex<double> &beta_re = owner->beta_re[local_idx];
 
 						rexiSPHRobert.setup_vectorinvariant_progphivortdiv(
 								sphereDataConfigSolver,	///< sphere data for input data
@@ -730,6 +955,8 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 					perThreadVars[0]->accum_phi += tmp_prog_phi;
 					perThreadVars[0]->accum_vort += tmp_prog_vort;
 					perThreadVars[0]->accum_div += tmp_prog_div;
+
+					rexi_term_seconds[owner->term_ids[local_idx]] = std::chrono::duration<double>(std::chrono::steady_clock::now() - term_start).count();
 				}
 
 				io_prog_phi0 = perThreadVars[0]->accum_phi.spectral_returnWithDifferentModes(io_prog_phi0.sphereDataConfig);
@@ -737,6 +964,8 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 				io_prog_div0 = perThreadVars[0]->accum_div.spectral_returnWithDifferentModes(io_prog_phi0.sphereDataConfig);
 			}
 
+			perThreadVars[0]->busy_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - group_start).count();
+
 		#if SWEET_REXI_TIMINGS
 			SimulationBenchmarkTimings::getInstance().rexi_timestepping_solver.stop();
 		#endif
@@ -751,35 +980,51 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 				SimulationBenchmarkTimings::getInstance().rexi_timestepping_solver.start();
 			#endif
 
-				#pragma omp parallel for schedule(static,1) default(none) shared(i_fixed_dt, io_prog_phi0, io_prog_vort0, io_prog_div0, std::cout, std::cerr)
+				workQueues.reset();
+
+				REXI_ThreadGroupPlanner::NestedRegion nested(threadGroups);
+
+				#pragma omp parallel for schedule(static,1) default(none) shared(i_fixed_dt, io_prog_phi0, io_prog_vort0, io_prog_div0, std::cout, std::cerr) num_threads(num_local_rexi_par_threads)
 				for (int local_thread_id = 0; local_thread_id < num_local_rexi_par_threads; local_thread_id++)
 				{
-					std::size_t start, end;
-					p_get_workload_start_end(start, end, local_thread_id);
+					threadGroups.setupGroupThread();
+
+					const SphereData_Config *sphereDataConfigGroup = perThreadVars[local_thread_id]->sphereDataConfig;
+
+					std::chrono::steady_clock::time_point group_start = std::chrono::steady_clock::now();
 
 					/*
 					* Make a copy to ensure that there are no race conditions by converting to physical space
 					*/
-					SphereData_Spectral thread_io_prog_phi0 = io_prog_phi0;
-					SphereData_Spectral thread_io_prog_vort0 = io_prog_vort0;
-					SphereData_Spectral thread_io_prog_div0 = io_prog_div0;
+					SphereData_Spectral thread_io_prog_phi0(sphereDataConfigGroup);
+					SphereData_Spectral thread_io_prog_vort0(sphereDataConfigGroup);
+					SphereData_Spectral thread_io_prog_div0(sphereDataConfigGroup);
+
+					thread_io_prog_phi0 = io_prog_phi0;
+					thread_io_prog_vort0 = io_prog_vort0;
+					thread_io_prog_div0 = io_prog_div0;
 
-					SphereData_Spectral tmp_prog_phi(sphereDataConfigSolver);
-					SphereData_Spectral tmp_prog_vort(sphereDataConfigSolver);
-					SphereData_Spectral tmp_prog_div(sphereDataConfigSolver);
+					SphereData_Spectral tmp_prog_phi(sphereDataConfigGroup);
+					SphereData_Spectral tmp_prog_vort(sphereDataConfigGroup);
+					SphereData_Spectral tmp_prog_div(sphereDataConfigGroup);
 
 					perThreadVars[local_thread_id]->accum_phi.spectral_set_zero();
 					perThreadVars[local_thread_id]->accum_vort.spectral_set_zero();
 					perThreadVars[local_thread_id]->accum_div.spectral_set_zero();
 
 
-					for (std::size_t workload_idx = start; workload_idx < end; workload_idx++)
+					int owner_id;
+					std::size_t local_idx;
+					while (workQueues.getNext(local_thread_id, owner_id, local_idx))
 					{
-						int local_idx = workload_idx-start;
+						SWEET_PROFILER_REGION("rexi_term");
+
+						PerThreadVars *owner = perThreadVars[owner_id];
+						std::chrono::steady_clock::time_point term_start = std::chrono::steady_clock::now();
 
 						if (use_rexi_sphere_solver_preallocation)
 						{
-							perThreadVars[local_thread_id]->rexiSPHRobert_vector[local_idx].solve_vectorinvariant_progphivortdiv(
+							owner->rexiSPHRobert_vector[local_idx].solve_vectorinvariant_progphivortdiv(
 									thread_io_prog_phi0, thread_io_prog_vort0, thread_io_prog_div0,
 									tmp_prog_phi, tmp_prog_vort, tmp_prog_div
 								);
@@ -788,11 +1033,11 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 						{
 							SWERexiTerm_SPHRobert rexiSPHRobert;
 
-							std::complex<double> &alpha = perThreadVars[local_thread_id]->alpha[local_idx];
-							std::complex<double> &beta_re = perThreadVars[local_thread_id]->beta_re[local_idx];
+							std::complex<double> &alpha = owner->alpha[local_idx];
+							std::complex<double> &beta_re = owner->beta_re[local_idx];
 
 							rexiSPHRobert.setup_vectorinvariant_progphivortdiv(
-									sphereDataConfigSolver,	///< sphere data for input data
+									sphereDataConfigGroup,	///< sphere data for input data
 									alpha,
 									beta_re,
 
@@ -807,7 +1052,7 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 							);
 
 							rexiSPHRobert.solve_vectorinvariant_progphivortdiv(
-									io_prog_phi0, io_prog_vort0, io_prog_div0,
+									thread_io_prog_phi0, thread_io_prog_vort0, thread_io_prog_div0,
 									tmp_prog_phi, tmp_prog_vort, tmp_prog_div
 								);
 						}
@@ -815,7 +1060,11 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 						perThreadVars[local_thread_id]->accum_phi += tmp_prog_phi;
 						perThreadVars[local_thread_id]->accum_vort += tmp_prog_vort;
 						perThreadVars[local_thread_id]->accum_div += tmp_prog_div;
+
+						rexi_term_seconds[owner->term_ids[local_idx]] = std::chrono::duration<double>(std::chrono::steady_clock::now() - term_start).count();
 					}
+
+					perThreadVars[local_thread_id]->busy_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - group_start).count();
 				}
 
 			#if SWEET_REXI_TIMINGS
@@ -862,6 +1111,11 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 #endif
 				}
 
+				// data was updated directly
+				io_prog_phi0.spectral_data_modified();
+				io_prog_vort0.spectral_data_modified();
+				io_prog_div0.spectral_data_modified();
+
 			#if SWEET_REXI_TIMINGS
 				SimulationBenchmarkTimings::getInstance().rexi_timestepping_reduce.stop();
 			#endif
@@ -873,39 +1127,51 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 				SimulationBenchmarkTimings::getInstance().rexi_timestepping_solver.start();
 			#endif
 
-				#pragma omp parallel for schedule(static,1) default(none) shared(i_fixed_dt, io_prog_phi0, io_prog_vort0, io_prog_div0, std::cout, std::cerr)
+				workQueues.reset();
+
+				REXI_ThreadGroupPlanner::NestedRegion nested(threadGroups);
+
+				#pragma omp parallel for schedule(static,1) default(none) shared(i_fixed_dt, io_prog_phi0, io_prog_vort0, io_prog_div0, std::cout, std::cerr) num_threads(num_local_rexi_par_threads)
 				for (int local_thread_id = 0; local_thread_id < num_local_rexi_par_threads; local_thread_id++)
 				{
-					std::size_t start, end;
-					p_get_workload_start_end(start, end, local_thread_id);
+					threadGroups.setupGroupThread();
+
+					const SphereData_Config *sphereDataConfigGroup = perThreadVars[local_thread_id]->sphereDataConfig;
+
+					std::chrono::steady_clock::time_point group_start = std::chrono::steady_clock::now();
 
 					/*
 					 * threaded rexi sum 
 					 * extended modes
 					 */
-					SphereData_Spectral thread_prog_phi0(sphereDataConfigSolver);
-					SphereData_Spectral thread_prog_vort0(sphereDataConfigSolver);
-					SphereData_Spectral thread_prog_div0(sphereDataConfigSolver);
+					SphereData_Spectral thread_prog_phi0(sphereDataConfigGroup);
+					SphereData_Spectral thread_prog_vort0(sphereDataConfigGroup);
+					SphereData_Spectral thread_prog_div0(sphereDataConfigGroup);
 
-					thread_prog_phi0 = io_prog_phi0.spectral_returnWithDifferentModes(sphereDataConfigSolver);
-					thread_prog_vort0 = io_prog_vort0.spectral_returnWithDifferentModes(sphereDataConfigSolver);
-					thread_prog_div0 = io_prog_div0.spectral_returnWithDifferentModes(sphereDataConfigSolver);
+					thread_prog_phi0 = io_prog_phi0.spectral_returnWithDifferentModes(sphereDataConfigGroup);
+					thread_prog_vort0 = io_prog_vort0.spectral_returnWithDifferentModes(sphereDataConfigGroup);
+					thread_prog_div0 = io_prog_div0.spectral_returnWithDifferentModes(sphereDataConfigGroup);
 
-					SphereData_Spectral tmp_prog_phi(sphereDataConfigSolver);
-					SphereData_Spectral tmp_prog_vort(sphereDataConfigSolver);
-					SphereData_Spectral tmp_prog_div(sphereDataConfigSolver);
+					SphereData_Spectral tmp_prog_phi(sphereDataConfigGroup);
+					SphereData_Spectral tmp_prog_vort(sphereDataConfigGroup);
+					SphereData_Spectral tmp_prog_div(sphereDataConfigGroup);
 
 					perThreadVars[local_thread_id]->accum_phi.spectral_set_zero();
 					perThreadVars[local_thread_id]->accum_vort.spectral_set_zero();
 					perThreadVars[local_thread_id]->accum_div.spectral_set_zero();
 
-					for (std::size_t workload_idx = start; workload_idx < end; workload_idx++)
+					int owner_id;
+					std::size_t local_idx;
+					while (workQueues.getNext(local_thread_id, owner_id, local_idx))
 					{
-						int local_idx = workload_idx-start;
+						SWEET_PROFILER_REGION("rexi_term");
+
+						PerThreadVars *owner = perThreadVars[owner_id];
+						std::chrono::steady_clock::time_point term_start = std::chrono::steady_clock::now();
 
 						if (use_rexi_sphere_solver_preallocation)
 						{
-							perThreadVars[local_thread_id]->rexiSPHRobert_vector[local_idx].solve_vectorinvariant_progphivortdiv(
+							owner->rexiSPHRobert_vector[local_idx].solve_vectorinvariant_progphivortdiv(
 									thread_prog_phi0, thread_prog_vort0, thread_prog_div0,
 									tmp_prog_phi, tmp_prog_vort, tmp_prog_div
 								);
@@ -914,11 +1180,11 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 						{
 							SWERexiTerm_SPHRobert rexiSPHRobert;
 
-							std::complex<double> &alpha = perThreadVars[local_thread_id]->alpha[local_idx];
-							std::complex<double> &beta_re = perThreadVars[local_thread_id]->beta_re[local_idx];
+							std::complex<double> &alpha = owner->alpha[local_idx];
+							std::complex<double> &beta_re = owner->beta_re[local_idx];
 
 							rexiSPHRobert.setup_vectorinvariant_progphivortdiv(
-									sphereDataConfigSolver,	///< sphere data for input data
+									sphereDataConfigGroup,	///< sphere data for input data
 									alpha,
 									beta_re,
 
@@ -941,7 +1207,11 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 						perThreadVars[local_thread_id]->accum_phi += tmp_prog_phi;
 						perThreadVars[local_thread_id]->accum_vort += tmp_prog_vort;
 						perThreadVars[local_thread_id]->accum_div += tmp_prog_div;
+
+						rexi_term_seconds[owner->term_ids[local_idx]] = std::chrono::duration<double>(std::chrono::steady_clock::now() - term_start).count();
 					}
+
+					perThreadVars[local_thread_id]->busy_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - group_start).count();
 				}
 
 				assert(io_prog_phi0.sphereDataConfig->spectral_array_data_number_of_elements == sphereDataConfig->spectral_array_data_number_of_elements);
@@ -1009,6 +1279,8 @@ void SWE_Sphere_TS_l_rexi::run_timestep(
 
 	#endif	// END SWEET_THREADING_TIME_REXI
 
+	p_update_load_balancing();
+
 	#if SWEET_REXI_TIMINGS_ADDITIONAL_BARRIERS && SWEET_MPI
 		#if SWEET_REXI_TIMINGS
 			SimulationBenchmarkTimings::getInstance().rexi_timestepping_miscprocessing.start();
@@ -16,6 +16,8 @@
 
 #include <complex>
 #include <rexi/REXI_Terry.hpp>
+#include <rexi/REXI_ThreadGroupPlanner.hpp>
+#include <rexi/REXI_WorkloadPartitioner.hpp>
 #include <sweet/SimulationVariables.hpp>
 #include <string.h>
 #include <sweet/sphere/SphereData_Config.hpp>
@@ -117,16 +119,26 @@ private:
 
 	bool use_rexi_sphere_solver_preallocation;
 
-	std::size_t block_size;
-
 	class PerThreadVars
 	{
 	public:
+		/// Configuration with SHTNS plans for the team of threads of this group (if required)
+		SphereData_Config sphereDataConfigInstance;
+
+		/// Configuration to be used by this group
+		const SphereData_Config *sphereDataConfig;
+
 		std::vector<SWERexiTerm_SPHRobert> rexiSPHRobert_vector;
 
+		/// Indices of REXI terms assigned to this group
+		std::vector<std::size_t> term_ids;
+
 		std::vector< std::complex<double> > alpha;
 		std::vector< std::complex<double> > beta_re;
 
+		/// Wallclock time of this group for the REXI terms of the last time step
+		double busy_seconds;
+
 		SphereData_Spectral accum_phi;
 		SphereData_Spectral accum_vort;
 		SphereData_Spectral accum_div;
@@ -135,9 +147,32 @@ private:
 	// per-thread allocated variables to avoid NUMA domain effects
 	std::vector<PerThreadVars*> perThreadVars;
 
-	// number of threads to be used
+	// split of threads into groups of REXI terms with a team of threads each
+	REXI_ThreadGroupPlanner threadGroups;
+
+	// number of thread groups to be used
 	int num_local_rexi_par_threads;
 
+	// queues of REXI terms of all thread groups of this rank
+	REXI_WorkStealingQueues workQueues;
+
+	// costs of all REXI terms for the load balancing (empty: equal costs)
+	std::vector<double> rexi_term_costs;
+
+	// wallclock time of the REXI terms of this rank in the last time step
+	std::vector<double> rexi_term_seconds;
+
+	// number of time steps since the setup
+	int num_timesteps;
+
+	// max. and sum of the busy time of the thread groups of this rank for each time step,
+	// only reduced over all ranks for the output of the load imbalance (max/avg. load)
+	std::vector<double> load_max_timesteps;
+	std::vector<double> load_sum_timesteps;
+
+	// true while the thread groups are calibrated
+	bool thread_groups_calibration_active;
+
 	// number of threads to be used
 	int num_global_threads;
 
@@ -164,12 +199,22 @@ public:
 private:
 	void p_update_coefficients(bool i_update_rexi);
 
-	void p_get_workload_start_end(
-			std::size_t &o_start,
-			std::size_t &o_end,
-			int i_local_thread_id
+	void p_setup_thread_groups();
+
+	void p_calibrate_thread_groups(
+			const SphereData_Spectral &i_prog_phi0,
+			const SphereData_Spectral &i_prog_vort0,
+			const SphereData_Spectral &i_prog_div0,
+			double i_fixed_dt,
+			double i_simulation_timestamp
 	);
 
+	void p_setup_workload();
+
+	void p_update_load_balancing();
+
+	void p_output_load_imbalance();
+
 
 	/**
 	 * setup the REXI
@@ -9,6 +9,31 @@
 
 
 
+template <typename T_SphereData, typename T_SphereOperators>
+void SWE_Sphere_TS_lg_erk::p_euler_timestep_update(
+		const T_SphereOperators &i_op,
+
+		const T_SphereData &i_phi,	///< prognostic variables
+		const T_SphereData &i_vort,	///< prognostic variables
+		const T_SphereData &i_div,	///< prognostic variables
+
+		T_SphereData &o_phi_t,	///< time updates
+		T_SphereData &o_vort_t,	///< time updates
+		T_SphereData &o_div_t	///< time updates
+)
+{
+	/*
+	 * LINEAR
+	 */
+	double gh = simVars.sim.gravitation * simVars.sim.h0;
+
+	o_phi_t = -gh*i_div;
+	o_div_t = -i_op.laplace(i_phi);
+	o_vort_t.spectral_set_zero();
+}
+
+
+
 /*
  * Main routine for method to be used in case of finite differences
  */
@@ -24,14 +49,24 @@ void SWE_Sphere_TS_lg_erk::euler_timestep_update(
 		double i_simulation_timestamp
 )
 {
-	/*
-	 * LINEAR
-	 */
-	double gh = simVars.sim.gravitation * simVars.sim.h0;
+	p_euler_timestep_update(op, i_phi, i_vort, i_div, o_phi_t, o_vort_t, o_div_t);
+}
 
-	o_phi_t = -gh*i_div;
-	o_div_t = -op.laplace(i_phi);
-	o_vort_t.spectral_set_zero();
+
+
+void SWE_Sphere_TS_lg_erk::euler_timestep_update(
+		const SphereData_SpectralDistributed &i_phi,	///< prognostic variables
+		const SphereData_SpectralDistributed &i_vort,	///< prognostic variables
+		const SphereData_SpectralDistributed &i_div,	///< prognostic variables
+
+		SphereData_SpectralDistributed &o_phi_t,	///< time updates
+		SphereData_SpectralDistributed &o_vort_t,	///< time updates
+		SphereData_SpectralDistributed &o_div_t,	///< time updates
+
+		double i_simulation_timestamp
+)
+{
+	p_euler_timestep_update(opDistributed, i_phi, i_vort, i_div, o_phi_t, o_vort_t, o_div_t);
 }
 
 
@@ -61,6 +96,33 @@ void SWE_Sphere_TS_lg_erk::run_timestep(
 
 
 
+void SWE_Sphere_TS_lg_erk::run_timestep(
+		SphereData_SpectralDistributed &io_phi,	///< prognostic variables
+		SphereData_SpectralDistributed &io_vort,	///< prognostic variables
+		SphereData_SpectralDistributed &io_div,	///< prognostic variables
+
+		double i_dt,
+		double i_simulation_timestamp
+)
+{
+	if (i_dt <= 0)
+		FatalError("Only constant time step size allowed");
+
+	if (opDistributed.sphereDataConfig != io_phi.sphereDataConfig)
+		opDistributed.setup(io_phi.sphereDataConfig, simVars.sim.sphere_radius);
+
+	timestepping_rk_distributed.run_timestep(
+			this,
+			&SWE_Sphere_TS_lg_erk::euler_timestep_update,	///< pointer to function to compute euler time step updates
+			io_phi, io_vort, io_div,
+			i_dt,
+			timestepping_order,
+			i_simulation_timestamp
+		);
+}
+
+
+
 /*
  * Setup
  */
@@ -12,6 +12,8 @@
 #include <sweet/sphere/SphereData_Spectral.hpp>
 #include <sweet/sphere/SphereOperators_SphereData.hpp>
 #include <sweet/sphere/SphereTimestepping_ExplicitRK.hpp>
+#include <sweet/sphere/SphereData_SpectralDistributed.hpp>
+#include <sweet/sphere/SphereOperators_SphereDataDistributed.hpp>
 #include <limits>
 #include <sweet/SimulationVariables.hpp>
 
@@ -29,7 +31,27 @@ class SWE_Sphere_TS_lg_erk	: public SWE_Sphere_TS_interface
 	// Sampler
 	SphereTimestepping_ExplicitRK timestepping_rk;
 
+	// Operators and RK buffers for distributed sphere data, set up with the first time step
+	SphereOperators_SphereDataDistributed opDistributed;
+	SphereDistributedTimestepping_ExplicitRK timestepping_rk_distributed;
+
 private:
+	/**
+	 * Time tendencies, shared by SphereData_Spectral and SphereData_SpectralDistributed
+	 */
+	template <typename T_SphereData, typename T_SphereOperators>
+	void p_euler_timestep_update(
+			const T_SphereOperators &i_op,
+
+			const T_SphereData &i_phi,	///< prognostic variables
+			const T_SphereData &i_vort,	///< prognostic variables
+			const T_SphereData &i_div,	///< prognostic variables
+
+			T_SphereData &o_phi_t,	///< time updates
+			T_SphereData &o_vort_t,	///< time updates
+			T_SphereData &o_div_t	///< time updates
+	);
+
 	void euler_timestep_update(
 			const SphereData_Spectral &i_phi,	///< prognostic variables
 			const SphereData_Spectral &i_vort,	///< prognostic variables
@@ -42,6 +64,18 @@ private:
 			double i_simulation_timestamp = -1
 	);
 
+	void euler_timestep_update(
+			const SphereData_SpectralDistributed &i_phi,	///< prognostic variables
+			const SphereData_SpectralDistributed &i_vort,	///< prognostic variables
+			const SphereData_SpectralDistributed &i_div,	///< prognostic variables
+
+			SphereData_SpectralDistributed &o_phi_t,	///< time updates
+			SphereData_SpectralDistributed &o_vort_t,	///< time updates
+			SphereData_SpectralDistributed &o_div_t,	///< time updates
+
+			double i_simulation_timestamp = -1
+	);
+
 public:
 	SWE_Sphere_TS_lg_erk(
 			SimulationVariables &i_simVars,
@@ -61,6 +95,15 @@ public:
 			double i_simulation_timestamp = -1
 	);
 
+	void run_timestep(
+			SphereData_SpectralDistributed &io_phi,	///< prognostic variables
+			SphereData_SpectralDistributed &io_vort,	///< prognostic variables
+			SphereData_SpectralDistributed &io_div,	///< prognostic variables
+
+			double i_dt,
+			double i_simulation_timestamp = -1
+	);
+
 
 
 	virtual ~SWE_Sphere_TS_lg_erk();
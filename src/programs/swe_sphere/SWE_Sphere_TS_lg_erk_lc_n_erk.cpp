@@ -312,6 +312,8 @@ void SWE_Sphere_TS_lg_erk_lc_n_erk::setup(
 )
 {
 	timestepping_order = i_order;
+	timestepping_rk_linear.setLowStorage(simVars.disc.timestepping_rk_low_storage);
+	timestepping_rk_nonlinear.setLowStorage(simVars.disc.timestepping_rk_low_storage);
 
 	version_id = i_version_id;
 
@@ -109,6 +109,30 @@ void SWE_Sphere_TS_ln_erk::run_timestep(
 
 
 
+double SWE_Sphere_TS_ln_erk::run_timestep_adaptive(
+		SphereData_Spectral &io_phi,		///< prognostic variables
+		SphereData_Spectral &io_vort,	///< prognostic variables
+		SphereData_Spectral &io_div,		///< prognostic variables
+
+		double i_dt,
+		double i_simulation_timestamp
+)
+{
+	// embedded Runge-Kutta pair with error estimate
+	return timestepping_rk.run_timestep_embedded(
+			this,
+			&SWE_Sphere_TS_ln_erk::euler_timestep_update,	///< pointer to function to compute euler time step updates
+			io_phi, io_vort, io_div,
+			i_dt,
+			timestepping_order,
+			i_simulation_timestamp,
+			simVars.timecontrol.adaptive_tolerance_abs,
+			simVars.timecontrol.adaptive_tolerance_rel
+		);
+}
+
+
+
 /*
  * Setup
  */
@@ -117,6 +141,7 @@ void SWE_Sphere_TS_ln_erk::setup(
 )
 {
 	timestepping_order = i_order;
+	timestepping_rk.setLowStorage(simVars.disc.timestepping_rk_low_storage);
 
 	if (simVars.sim.sphere_use_fsphere)
 	{
@@ -62,6 +62,15 @@ public:
 			double i_simulation_timestamp = -1
 	);
 
+	double run_timestep_adaptive(
+			SphereData_Spectral &io_phi,	///< prognostic variables
+			SphereData_Spectral &io_vort,	///< prognostic variables
+			SphereData_Spectral &io_div,	///< prognostic variables
+
+			double i_dt,
+			double i_simulation_timestamp
+	);
+
 
 
 	virtual ~SWE_Sphere_TS_ln_erk();
@@ -74,12 +74,31 @@ public:
 
 	SWE_Sphere_TS_interface *master = nullptr;
 
+	/// Time stepper only includes linear terms
+	bool linear_only = false;
+
 
 
 	SWE_Sphere_TimeSteppers()
 	{
 	}
 
+
+	/**
+	 * Return true if the time stepper also supports SphereData_SpectralDistributed
+	 * (see --space-sphere-distributed)
+	 *
+	 * This has to be checked before setup() since the other time steppers
+	 * require the serial sphere data configuration for their setup.
+	 */
+	static bool supportsDistributed(
+			const std::string &i_timestepping_method
+	)
+	{
+		return i_timestepping_method == "lg_erk";
+	}
+
+
 	void reset()
 	{
 		if (l_erk != nullptr)
@@ -207,12 +226,16 @@ public:
 			SimulationVariables &i_simVars
 	)
 	{
+		linear_only = false;
+
 		if (i_timestepping_method == "l_erk")
 		{
 			l_erk = new SWE_Sphere_TS_l_erk(i_simVars, i_op);
 			l_erk->setup(i_simVars.disc.timestepping_order);
 
 			master = &(SWE_Sphere_TS_interface&)*l_erk;
+
+			linear_only = true;
 		}
 		else if (i_timestepping_method == "l_erk_pvd")
 		{
@@ -220,6 +243,8 @@ public:
 			l_erk_pvd->setup(i_simVars.disc.timestepping_order);
 
 			master = &(SWE_Sphere_TS_interface&)*l_erk_pvd;
+
+			linear_only = true;
 		}
 		else if (i_timestepping_method == "l_erk_n_erk")
 		{
@@ -234,6 +259,8 @@ public:
 			lg_erk_lc_erk->setup(i_simVars.disc.timestepping_order);
 
 			master = &(SWE_Sphere_TS_interface&)*lg_erk_lc_erk;
+
+			linear_only = true;
 		}
 		else if (i_timestepping_method == "lg_irk_lc_erk" || i_timestepping_method == "lg_irk_lc_erk_ver0")
 		{
@@ -241,6 +268,8 @@ public:
 			lg_irk_lc_erk->setup(i_simVars.disc.timestepping_order, 0);
 
 			master = &(SWE_Sphere_TS_interface&)*lg_irk_lc_erk;
+
+			linear_only = true;
 		}
 		else if (i_timestepping_method == "lg_irk_lc_erk_ver1")
 		{
@@ -248,6 +277,8 @@ public:
 			lg_irk_lc_erk->setup(i_simVars.disc.timestepping_order, 1);
 
 			master = &(SWE_Sphere_TS_interface&)*lg_irk_lc_erk;
+
+			linear_only = true;
 		}
 		else if (i_timestepping_method == "l_irk_n_erk" || i_timestepping_method == "l_irk_n_erk_ver0")
 		{
@@ -369,6 +400,8 @@ public:
 				);
 
 			master = &(SWE_Sphere_TS_interface&)*lg_erk;
+
+			linear_only = true;
 		}
 		else if (i_timestepping_method == "ln_erk")
 		{
@@ -420,6 +453,8 @@ public:
 			l_irk->setup(i_simVars.disc.timestepping_order, i_simVars.timecontrol.current_timestep_size, i_simVars.rexi.use_sphere_extended_modes);
 
 			master = &(SWE_Sphere_TS_interface&)*l_irk;
+
+			linear_only = true;
 		}
 		else if (i_timestepping_method == "lg_irk")
 		{
@@ -427,6 +462,8 @@ public:
 			lg_irk->setup(i_simVars.disc.timestepping_order, i_simVars.timecontrol.current_timestep_size);
 
 			master = &(SWE_Sphere_TS_interface&)*lg_irk;
+
+			linear_only = true;
 		}
 		else if (i_timestepping_method == "l_lf")
 		{
@@ -434,6 +471,8 @@ public:
 			l_leapfrog->setup(i_simVars.disc.timestepping_order, i_simVars.disc.timestepping_leapfrog_robert_asselin_filter);
 
 			master = &(SWE_Sphere_TS_interface&)*l_leapfrog;
+
+			linear_only = true;
 		}
 		else if (i_timestepping_method == "l_cn")
 		{
@@ -441,6 +480,8 @@ public:
 			l_cn->setup(i_simVars.disc.timestepping_crank_nicolson_filter, i_simVars.timecontrol.current_timestep_size, i_simVars.rexi.use_sphere_extended_modes);
 
 			master = &(SWE_Sphere_TS_interface&)*l_cn;
+
+			linear_only = true;
 		}
 		else if (i_timestepping_method == "lg_cn")
 		{
@@ -448,6 +489,8 @@ public:
 			lg_cn->setup(i_simVars.disc.timestepping_crank_nicolson_filter, i_simVars.timecontrol.current_timestep_size);
 
 			master = &(SWE_Sphere_TS_interface&)*lg_cn;
+
+			linear_only = true;
 		}
 		else if (i_timestepping_method == "l_rexi")
 		{
@@ -472,6 +515,8 @@ public:
 			}
 #endif
 			master = &(SWE_Sphere_TS_interface&)*l_rexi;
+
+			linear_only = true;
 		}
 		else if (i_timestepping_method == "lg_rexi")
 		{
@@ -499,6 +544,8 @@ public:
 			}
 
 			master = &(SWE_Sphere_TS_interface&)*lg_rexi;
+
+			linear_only = true;
 		}
 		else
 		{
@@ -444,12 +444,82 @@ public:
 		}
 	}
 
+	void test_planedatacomplex_planedata_spectral_real_part()
+	{
+		PlaneDataComplex testcplx(planeDataConfig);
+
+		for (std::size_t y = 0; y < planeDataConfig->physical_data_size[1]; y++)
+		{
+			for (std::size_t x = 0; x < planeDataConfig->physical_data_size[0]; x++)
+			{
+				std::cout << "test_planedatacomplex_planedata_spectral_real_part: Testing physical value 1.0+2.0i at (" << y << ", " << x << ") with spectral real part" << std::endl;
+				testcplx.physical_set_zero();
+				testcplx.p_physical_set(y, x, 1.0, 2.0);
+
+				testcplx.request_data_spectral();
+				testcplx.spectral_zeroAliasingModes();
+
+				PlaneData tmp_spec = Convert_PlaneDataComplex_To_PlaneData::spectral_convert_real_part(testcplx);
+				PlaneData tmp_phys = Convert_PlaneDataComplex_To_PlaneData::physical_convert(testcplx);
+
+				double error = (tmp_spec-tmp_phys).reduce_maxAbs();
+
+				if (error > 1e-8)
+				{
+					std::cout << std::endl;
+					std::cout << "Original complex" << std::endl;
+					testcplx.print_spectralData_zeroNumZero();
+
+					std::cout << std::endl;
+					std::cout << "Spectral real part" << std::endl;
+					tmp_spec.print_spectralData_zeroNumZero();
+
+					std::cout << std::endl;
+					std::cout << "Physical real part" << std::endl;
+					tmp_phys.print_spectralData_zeroNumZero();
+
+					FatalError("Inconsistency detected m");
+				}
+			}
+		}
+	}
+
+
+	void test_planedatacomplex_axpy()
+	{
+		std::cout << "test_planedatacomplex_axpy: Testing y += alpha*x" << std::endl;
+
+		PlaneDataComplex x(planeDataConfig);
+		PlaneDataComplex y(planeDataConfig);
+
+		for (std::size_t j = 0; j < planeDataConfig->physical_data_size[1]; j++)
+			for (std::size_t i = 0; i < planeDataConfig->physical_data_size[0]; i++)
+			{
+				x.p_physical_set(j, i, std::sin((double)(i+2*j)), std::cos((double)(3*i+j)));
+				y.p_physical_set(j, i, std::cos((double)(2*i+j)), std::sin((double)(i*j)));
+			}
+
+		std::complex<double> alpha(0.3, -1.7);
+
+		PlaneDataComplex ref = y + x*alpha;
+		y.axpy(alpha, x);
+
+		PlaneDataComplex diff = y-ref;
+		double error = std::max(diff.reduce_maxAbs_real(), (diff*std::complex<double>(0, -1)).reduce_maxAbs_real());
+
+		if (error > 1e-10)
+			FatalError("Inconsistency detected n");
+	}
+
+
 	PlaneDataModes()	:
 		op(planeDataConfig, simVars.sim.plane_domain_size, simVars.disc.space_use_spectral_basis_diffs)
 	{
 		test_planedata_planedatacomplex_physicalphysical_convert();
 		test_planedata_planedatacomplex_physicalspectral_convert();
 		test_planedata_planedatacomplex_spectralphysical_convert();
+		test_planedatacomplex_planedata_spectral_real_part();
+		test_planedatacomplex_axpy();
 	}
 };
 
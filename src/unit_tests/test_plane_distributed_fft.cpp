@@ -0,0 +1,167 @@
+/*
+ * test_plane_distributed_fft.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ *
+ * Test transformations and spectral operators of the MPI distributed plane data.
+ * This test can be executed with an arbitrary number of ranks
+ * (up to the number of rows of the lowest resolution).
+ */
+
+#include <iostream>
+#include <cmath>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/FatalError.hpp>
+#include <sweet/plane/PlaneDataConfigDistributed.hpp>
+#include <sweet/plane/PlaneDataDistributed.hpp>
+#include <sweet/plane/PlaneOperatorsDistributed.hpp>
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
+
+
+
+int main(int i_argc, char *i_argv[])
+{
+#if SWEET_MPI
+	MPI_Init(&i_argc, &i_argv);
+#endif
+
+	SimulationVariables simVars;
+
+	if (!simVars.setupFromMainParameters(i_argc, i_argv))
+		return -1;
+
+	int res_start = simVars.disc.space_res_physical[0];
+	if (res_start <= 0)
+		res_start = 16;
+
+	const double *domain_size = simVars.sim.plane_domain_size;
+
+	double eps = 1e-10;
+
+	for (int res_x = res_start; res_x <= 256; res_x *= 2)
+	{
+		int res[2] = {res_x, res_x*2};
+
+		PlaneDataConfigDistributed planeDataConfig;
+		planeDataConfig.setup(res, simVars.misc.reuse_spectral_transformation_plans);
+
+		if (planeDataConfig.mpi_rank == 0)
+		{
+			std::cout << "*************************************************************" << std::endl;
+			std::cout << "Testing distributed FFT with resolution " << res[0] << " x " << res[1] << " on " << planeDataConfig.mpi_size << " ranks" << std::endl;
+			std::cout << "*************************************************************" << std::endl;
+		}
+
+		if (simVars.misc.verbosity > 2)
+			planeDataConfig.printInformation();
+
+		PlaneOperatorsDistributed op(&planeDataConfig, domain_size);
+
+		double kx = 2.0*M_PI/domain_size[0];
+		double ky = 4.0*M_PI/domain_size[1];
+
+		PlaneDataDistributed f(&planeDataConfig);
+		f.physical_update_lambda_unit_coordinates_cell_centered(
+			[&](double x, double y, double &o_data)
+			{
+				o_data = std::sin(2.0*M_PI*x)*std::cos(4.0*M_PI*y) + 0.5;
+			}
+		);
+
+		PlaneDataDistributed f_diff_x(&planeDataConfig);
+		f_diff_x.physical_update_lambda_unit_coordinates_cell_centered(
+			[&](double x, double y, double &o_data)
+			{
+				o_data = kx*std::cos(2.0*M_PI*x)*std::cos(4.0*M_PI*y);
+			}
+		);
+
+		PlaneDataDistributed f_diff_y(&planeDataConfig);
+		f_diff_y.physical_update_lambda_unit_coordinates_cell_centered(
+			[&](double x, double y, double &o_data)
+			{
+				o_data = -ky*std::sin(2.0*M_PI*x)*std::sin(4.0*M_PI*y);
+			}
+		);
+
+		/*
+		 * Forward and backward transformation
+		 */
+		{
+			PlaneDataDistributed g = f;
+			g.request_data_spectral();
+			g.request_data_physical();
+
+			double error = (g-f).reduce_maxAbs();
+
+			if (planeDataConfig.mpi_rank == 0)
+				std::cout << " + error transformations: " << error << std::endl;
+
+			if (error > eps)
+				FatalError("Error in transformations too high");
+		}
+
+		/*
+		 * Average
+		 */
+		{
+			double average = f.reduce_sum()/(double)(res[0]*res[1]);
+
+			if (planeDataConfig.mpi_rank == 0)
+				std::cout << " + average: " << average << std::endl;
+
+			if (std::abs(average-0.5) > eps)
+				FatalError("Error in average too high");
+		}
+
+		/*
+		 * Differential operators
+		 */
+		{
+			double error_x = (op.diff_c_x(f)-f_diff_x).reduce_maxAbs()/kx;
+			double error_y = (op.diff_c_y(f)-f_diff_y).reduce_maxAbs()/ky;
+
+			if (planeDataConfig.mpi_rank == 0)
+			{
+				std::cout << " + error diff_c_x: " << error_x << std::endl;
+				std::cout << " + error diff_c_y: " << error_y << std::endl;
+			}
+
+			if (error_x > eps || error_y > eps)
+				FatalError("Error in differential operators too high");
+		}
+
+		/*
+		 * Helmholtz solver
+		 *
+		 * (a + b*\nabla^2) f = rhs
+		 */
+		{
+			double a = 1.0;
+			double b = -0.1*domain_size[0]*domain_size[0];
+
+			PlaneDataDistributed rhs = f*a + op.laplace(f)*b;
+			PlaneDataDistributed g = op.helmholtz_inverse(rhs, a, b);
+
+			double error = (g-f).reduce_maxAbs();
+
+			if (planeDataConfig.mpi_rank == 0)
+				std::cout << " + error helmholtz_inverse: " << error << std::endl;
+
+			if (error > eps)
+				FatalError("Error in Helmholtz solver too high");
+		}
+	}
+
+	std::cout << "Test successful" << std::endl;
+
+#if SWEET_MPI
+	MPI_Finalize();
+#endif
+
+	return 0;
+}
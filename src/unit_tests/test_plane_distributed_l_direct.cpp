@@ -0,0 +1,160 @@
+/*
+ * test_plane_distributed_l_direct.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ *
+ * Compare the analytical solution of the linear SWE computed on
+ * MPI distributed plane data with the one computed on PlaneData.
+ * This test can be executed with an arbitrary number of ranks
+ * (up to the number of rows of the lowest resolution).
+ */
+
+#include <iostream>
+#include <cmath>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/FatalError.hpp>
+#include <sweet/plane/PlaneData.hpp>
+#include <sweet/plane/PlaneOperators.hpp>
+#include <sweet/plane/PlaneDataConfigDistributed.hpp>
+#include <sweet/plane/PlaneDataDistributed.hpp>
+
+#include "../programs/swe_plane/SWE_Plane_TS_l_direct.hpp"
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
+
+
+
+/*
+ * Initial conditions in unit coordinates
+ */
+void initial_h(double x, double y, double &o_data)
+{
+	o_data = std::sin(2.0*M_PI*x)*std::cos(4.0*M_PI*y) + 0.1*std::cos(6.0*M_PI*x);
+}
+
+void initial_u(double x, double y, double &o_data)
+{
+	o_data = std::cos(2.0*M_PI*x)*std::sin(2.0*M_PI*y);
+}
+
+void initial_v(double x, double y, double &o_data)
+{
+	o_data = 0.5*std::sin(4.0*M_PI*x)*std::cos(6.0*M_PI*y);
+}
+
+
+
+/*
+ * Max. difference of the distributed data to the corresponding rows of the PlaneData
+ */
+double diff_maxAbs(
+		const PlaneDataDistributed &i_distributed,
+		const PlaneData &i_serial
+)
+{
+	i_distributed.request_data_physical();
+	i_serial.request_data_physical();
+
+	PlaneDataDistributed serial_rows(i_distributed.planeDataConfig);
+	serial_rows.physical_update_lambda_array_indices(
+		[&](int i, int j, double &o_data)
+		{
+			o_data = i_serial.p_physical_get(j, i);
+		}
+	);
+
+	return (i_distributed-serial_rows).reduce_maxAbs();
+}
+
+
+
+int main(int i_argc, char *i_argv[])
+{
+#if SWEET_MPI
+	MPI_Init(&i_argc, &i_argv);
+#endif
+
+	SimulationVariables simVars;
+
+	if (!simVars.setupFromMainParameters(i_argc, i_argv))
+		return -1;
+
+	int res_start = simVars.disc.space_res_physical[0];
+	if (res_start <= 0)
+		res_start = 16;
+
+	double eps = 1e-10;
+
+	for (int res_x = res_start; res_x <= 128; res_x *= 2)
+	{
+		int res[2] = {res_x, res_x*2};
+
+		PlaneDataConfigDistributed planeDataConfigDistributed;
+		planeDataConfigDistributed.setup(res, simVars.misc.reuse_spectral_transformation_plans);
+
+		PlaneDataConfig planeDataConfig;
+		planeDataConfig.setupAutoSpectralSpace(res, simVars.misc.reuse_spectral_transformation_plans);
+
+		PlaneOperators op(&planeDataConfig, simVars.sim.plane_domain_size);
+
+		int mpi_rank = planeDataConfigDistributed.mpi_rank;
+
+		if (mpi_rank == 0)
+		{
+			std::cout << "*************************************************************" << std::endl;
+			std::cout << "Testing distributed l_direct with resolution " << res[0] << " x " << res[1] << " on " << planeDataConfigDistributed.mpi_size << " ranks" << std::endl;
+			std::cout << "*************************************************************" << std::endl;
+		}
+
+		double f0_values[2] = {0, 10.0};
+
+		for (int fi = 0; fi < 2; fi++)
+		{
+			simVars.sim.plane_rotating_f0 = f0_values[fi];
+
+			SWE_Plane_TS_l_direct l_direct(simVars, op);
+			l_direct.setup();
+
+			double dt = 10.0*simVars.sim.plane_domain_size[0]/std::sqrt(simVars.sim.gravitation*simVars.sim.h0);
+
+			PlaneData h(&planeDataConfig), u(&planeDataConfig), v(&planeDataConfig);
+			h.physical_update_lambda_unit_coordinates_cell_centered(initial_h);
+			u.physical_update_lambda_unit_coordinates_cell_centered(initial_u);
+			v.physical_update_lambda_unit_coordinates_cell_centered(initial_v);
+
+			PlaneDataDistributed dh(&planeDataConfigDistributed), du(&planeDataConfigDistributed), dv(&planeDataConfigDistributed);
+			dh.physical_update_lambda_unit_coordinates_cell_centered(initial_h);
+			du.physical_update_lambda_unit_coordinates_cell_centered(initial_u);
+			dv.physical_update_lambda_unit_coordinates_cell_centered(initial_v);
+
+			l_direct.run_timestep(h, u, v, dt, 0);
+			l_direct.run_timestep(dh, du, dv, dt, 0);
+
+			double error_h = diff_maxAbs(dh, h);
+			double error_u = diff_maxAbs(du, u);
+			double error_v = diff_maxAbs(dv, v);
+
+			if (mpi_rank == 0)
+			{
+				std::cout << " + f0: " << simVars.sim.plane_rotating_f0 << std::endl;
+				std::cout << " + error h: " << error_h << std::endl;
+				std::cout << " + error u: " << error_u << std::endl;
+				std::cout << " + error v: " << error_v << std::endl;
+			}
+
+			if (error_h > eps || error_u > eps || error_v > eps)
+				FatalError("Distributed l_direct differs from l_direct on PlaneData");
+		}
+	}
+
+	std::cout << "Test successful" << std::endl;
+
+#if SWEET_MPI
+	MPI_Finalize();
+#endif
+
+	return 0;
+}
@@ -0,0 +1,10 @@
+/*
+ * SWE_Plane_TS_l_direct.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ *
+ * Use the time stepper of the swe_plane program without duplicating it
+ */
+
+#include "../../programs/swe_plane/SWE_Plane_TS_l_direct.cpp"
@@ -365,7 +365,7 @@ int main(int i_argc, char *i_argv[])
 			double err3_laplace_check =
 				(
 						h_cart-
-							((op.diff_c_x.spectral_mul_element_wise(op.diff_c_x)+op.diff_c_y.spectral_mul_element_wise(op.diff_c_y))(h_cart)).
+							((op.diff_c_x.getOperatorData().spectral_mul_element_wise(op.diff_c_x)+op.diff_c_y.getOperatorData().spectral_mul_element_wise(op.diff_c_y))(h_cart)).
 							spectral_div_element_wise(op.diff2_c_x+op.diff2_c_y)
 				).reduce_rms_quad();
 
@@ -164,17 +164,17 @@ int main(int i_argc, char *i_argv[])
 #if 0
 			std::cout << std::endl;
 			std::cout << "op.diff_c_x" << std::endl;
-			op.diff_c_x.print_spectralData_zeroNumZero();
+			op.diff_c_x.getOperatorData().print_spectralData_zeroNumZero();
 			std::cout << std::endl;
 			std::cout << "op.diff_c_y" << std::endl;
-			op.diff_c_y.print_spectralData_zeroNumZero();
+			op.diff_c_y.getOperatorData().print_spectralData_zeroNumZero();
 
 			std::cout << std::endl;
 			std::cout << "op.diff2_c_x" << std::endl;
-			op.diff2_c_x.print_spectralData_zeroNumZero();
+			op.diff2_c_x.getOperatorData().print_spectralData_zeroNumZero();
 			std::cout << std::endl;
 			std::cout << "op.diff2_c_y" << std::endl;
-			op.diff2_c_y.print_spectralData_zeroNumZero();
+			op.diff2_c_y.getOperatorData().print_spectralData_zeroNumZero();
 			exit(1);
 #endif
 
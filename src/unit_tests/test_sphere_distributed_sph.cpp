@@ -0,0 +1,329 @@
+/*
+ * test_sphere_distributed_sph.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ *
+ * Compare the MPI distributed spherical harmonics transformations and
+ * the banded solver on the local zonal wavenumbers with the serial ones.
+ * The distributed transformations don't use SHTNS, hence this also
+ * compares their Gaussian grid and Legendre functions with the ones of SHTNS.
+ * This test can be executed with an arbitrary number of ranks
+ * (up to the number of zonal wavenumbers).
+ */
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/FatalError.hpp>
+#include <sweet/sphere/SphereData_Config.hpp>
+#include <sweet/sphere/SphereData_Physical.hpp>
+#include <sweet/sphere/SphereData_Spectral.hpp>
+#include <sweet/sphere/SphereData_ConfigDistributed.hpp>
+#include <sweet/sphere/SphereData_PhysicalDistributed.hpp>
+#include <sweet/sphere/SphereData_SpectralDistributed.hpp>
+#include <sweet/sphere/Convert_SphereDataSpectral_to_SphereDataSpectralComplex.hpp>
+#include <sweet/sphere/app_swe/SWESphBandedMatrixPhysicalReal.hpp>
+#include <sweet/sphere/app_swe/SWESphBandedMatrixPhysicalComplex.hpp>
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
+
+
+
+/*
+ * Max. abs. difference between the local latitudes and the serial physical data
+ *
+ * Collective operation with MPI
+ */
+double diff_physical(
+		const SphereData_PhysicalDistributed &i_dist,
+		const SphereData_Physical &i_serial
+)
+{
+	const SphereData_ConfigDistributed *config = i_dist.sphereDataConfig;
+	const double *serial = i_serial.physical_space_data + (std::size_t)config->physical_local_lat_start*config->physical_num_lon;
+
+	double maxabs = 0;
+	for (int i = 0; i < config->physical_local_array_data_number_of_elements; i++)
+		maxabs = std::max(maxabs, std::abs(i_dist.physical_space_data[i] - serial[i]));
+
+#if SWEET_MPI
+	MPI_Allreduce(MPI_IN_PLACE, &maxabs, 1, MPI_DOUBLE, MPI_MAX, config->mpi_comm);
+#endif
+
+	return maxabs;
+}
+
+
+
+/*
+ * Max. abs. difference between the local modes and the serial spectral data
+ *
+ * Collective operation with MPI
+ */
+double diff_spectral(
+		const SphereData_SpectralDistributed &i_dist,
+		const SphereData_Spectral &i_serial
+)
+{
+	const SphereData_ConfigDistributed *config = i_dist.sphereDataConfig;
+	const std::complex<double> *serial = i_serial.spectral_space_data + config->spectral_local_array_data_offset;
+
+	double maxabs = 0;
+	for (int i = 0; i < config->spectral_local_array_data_number_of_elements; i++)
+		maxabs = std::max(maxabs, std::abs(i_dist.spectral_space_data[i] - serial[i]));
+
+#if SWEET_MPI
+	MPI_Allreduce(MPI_IN_PLACE, &maxabs, 1, MPI_DOUBLE, MPI_MAX, config->mpi_comm);
+#endif
+
+	return maxabs;
+}
+
+
+
+int main(
+		int i_argc,
+		char *i_argv[]
+)
+{
+#if SWEET_MPI
+	MPI_Init(&i_argc, &i_argv);
+#endif
+
+	MemBlockAlloc numaBlockAlloc;
+
+	SimulationVariables simVars;
+
+	if (!simVars.setupFromMainParameters(i_argc, i_argv))
+		return -1;
+
+	if (simVars.disc.space_res_spectral[0] == 0)
+		FatalError("Set number of spectral modes to use SPH!");
+
+	SphereData_Config sphereDataConfig;
+	sphereDataConfig.setupAutoPhysicalSpace(
+					simVars.disc.space_res_spectral[0],
+					simVars.disc.space_res_spectral[1],
+					&simVars.disc.space_res_physical[0],
+					&simVars.disc.space_res_physical[1],
+					simVars.misc.reuse_spectral_transformation_plans
+			);
+
+	SphereData_ConfigDistributed sphereDataConfigDistributed;
+	sphereDataConfigDistributed.setup(
+			sphereDataConfig.physical_num_lon,
+			sphereDataConfig.physical_num_lat,
+			sphereDataConfig.spectral_modes_m_max,
+			sphereDataConfig.spectral_modes_n_max,
+			simVars.misc.reuse_spectral_transformation_plans
+		);
+
+	bool output = (sphereDataConfigDistributed.mpi_rank == 0);
+
+	if (output)
+	{
+		std::cout << "*************************************************************" << std::endl;
+		std::cout << "Testing distributed SPH with " << sphereDataConfigDistributed.mpi_size << " ranks" << std::endl;
+		std::cout << "*************************************************************" << std::endl;
+	}
+
+	if (simVars.misc.verbosity > 2)
+		sphereDataConfigDistributed.printInformation();
+
+	double eps = 1e-10;
+
+	/*
+	 * Test function with contributions of all zonal wavenumbers
+	 */
+	auto test_function = [](double lon, double lat, double &o_data)
+	{
+		double mu = std::sin(lat);
+		o_data = std::exp(-4.0*(1.0-std::cos(lat)*std::cos(lon-1.0)))*(1.0+0.5*mu) + 0.1*mu*mu;
+	};
+
+	SphereData_Physical f_phys(&sphereDataConfig);
+	f_phys.physical_update_lambda(test_function);
+	SphereData_Spectral f(f_phys);
+
+	SphereData_PhysicalDistributed f_phys_dist(&sphereDataConfigDistributed);
+	f_phys_dist.physical_update_lambda(test_function);
+
+	double f_max = f_phys.physical_reduce_max_abs();
+
+	/*
+	 * Physical setup
+	 */
+	{
+		double error = diff_physical(f_phys_dist, f_phys)/f_max;
+
+		if (output)
+			std::cout << " + error physical setup: " << error << std::endl;
+
+		if (error > eps)
+			FatalError("Error in physical setup too high");
+	}
+
+	/*
+	 * Physical to spectral space
+	 */
+	SphereData_SpectralDistributed f_dist(f_phys_dist);
+	{
+		double error = diff_spectral(f_dist, f)/f_max;
+
+		if (output)
+			std::cout << " + error physical to spectral: " << error << std::endl;
+
+		if (error > eps)
+			FatalError("Error in physical to spectral transformation too high");
+	}
+
+	/*
+	 * Spectral to physical space
+	 */
+	{
+		SphereData_SpectralDistributed g_dist(&sphereDataConfigDistributed);
+		g_dist.loadGlobalSpectralData(f.spectral_space_data);
+
+		double error = diff_physical(g_dist.getSphereDataPhysical(), f.getSphereDataPhysical())/f_max;
+
+		if (output)
+			std::cout << " + error spectral to physical: " << error << std::endl;
+
+		if (error > eps)
+			FatalError("Error in spectral to physical transformation too high");
+	}
+
+	/*
+	 * Forward and backward transformation
+	 */
+	{
+		double error = (f_dist.getSphereDataPhysical() - f_phys_dist).physical_reduce_max_abs()/f_max;
+
+		if (output)
+			std::cout << " + error transformations: " << error << std::endl;
+
+		if (error > eps)
+			FatalError("Error in transformations too high");
+	}
+
+	/*
+	 * Banded solver on the local zonal wavenumbers
+	 *
+	 * (mu + alpha)*x = rhs
+	 */
+	{
+		double alpha = 3.0;
+
+		SphBandedMatrixPhysicalReal< std::complex<double> > sphSolver;
+		sphSolver.setup(&sphereDataConfig, 2);
+		sphSolver.solver_component_scalar_phi(alpha);
+		sphSolver.solver_component_mu_phi();
+
+		SphereData_Spectral x = sphSolver.solve(f);
+
+		SphBandedMatrixPhysicalReal< std::complex<double> > sphSolverLocal;
+		sphSolverLocal.setup(&sphereDataConfig, 2);
+		sphSolverLocal.solver_component_scalar_phi(alpha);
+		sphSolverLocal.solver_component_mu_phi();
+
+		double error_inverse = diff_spectral(sphSolverLocal.solve(f_dist), x)/f_max;
+
+		sphSolverLocal.factorize(
+				sphereDataConfigDistributed.spectral_local_m_start,
+				sphereDataConfigDistributed.spectral_local_m_start + sphereDataConfigDistributed.spectral_local_m_size
+			);
+
+		double error_factorized = diff_spectral(sphSolverLocal.solve(f_dist), x)/f_max;
+
+		if (output)
+		{
+			std::cout << " + error banded solver: " << error_inverse << std::endl;
+			std::cout << " + error banded solver (factorized): " << error_factorized << std::endl;
+		}
+
+		if (error_inverse > eps || error_factorized > eps)
+			FatalError("Error in banded solver too high");
+	}
+
+	/*
+	 * Complex banded solver (REXI) on the blocks of the local zonal wavenumbers m and -m
+	 *
+	 * (mu + alpha)*x = rhs
+	 */
+	{
+		std::complex<double> alpha(3.0, 1.0);
+
+		SphereData_SpectralComplex rhs = Convert_SphereDataSpectral_To_SphereDataSpectralComplex::physical_convert(f);
+
+		SphBandedMatrixPhysicalComplex< std::complex<double> > sphSolver;
+		sphSolver.setup(&sphereDataConfig, 2);
+		sphSolver.solver_component_scalar_phi(alpha);
+		sphSolver.solver_component_mu_phi();
+
+		SphereData_SpectralComplex x = sphSolver.solve(rhs);
+
+		SphBandedMatrixPhysicalComplex< std::complex<double> > sphSolverLocal;
+		sphSolverLocal.setup(&sphereDataConfig, 2);
+		sphSolverLocal.solver_component_scalar_phi(alpha);
+		sphSolverLocal.solver_component_mu_phi();
+
+		rhs.request_data_spectral();
+		x.request_data_spectral();
+
+		int m_start = sphereDataConfigDistributed.spectral_local_m_start;
+		int m_end = m_start + sphereDataConfigDistributed.spectral_local_m_size;
+
+		std::vector< std::complex<double> > x_m(sphereDataConfig.spectral_modes_n_max+1);
+
+		double error[2] = {0, 0};
+		for (int k = 0; k < 2; k++)
+		{
+			// Use the inverse of the banded matrix first, then the factorization
+			if (k == 1)
+				sphSolverLocal.factorize(m_start, m_end);
+
+			for (int m_abs = m_start; m_abs < m_end; m_abs++)
+			{
+				for (int m = -m_abs; m <= m_abs; m += std::max(1, 2*m_abs))
+				{
+					std::size_t idx = sphereDataConfig.getArrayIndexByModes_Complex_NCompact(std::abs(m), m);
+					int block_size = sphereDataConfig.spectral_modes_n_max+1-std::abs(m);
+
+					sphSolverLocal.solve_m(m, &rhs.spectral_space_data[idx], x_m.data());
+
+					for (int i = 0; i < block_size; i++)
+						error[k] = std::max(error[k], std::abs(x_m[i] - x.spectral_space_data[idx+i]));
+				}
+			}
+		}
+
+#if SWEET_MPI
+		MPI_Allreduce(MPI_IN_PLACE, error, 2, MPI_DOUBLE, MPI_MAX, sphereDataConfigDistributed.mpi_comm);
+#endif
+
+		error[0] /= f_max;
+		error[1] /= f_max;
+
+		if (output)
+		{
+			std::cout << " + error complex banded solver: " << error[0] << std::endl;
+			std::cout << " + error complex banded solver (factorized): " << error[1] << std::endl;
+		}
+
+		if (error[0] > eps || error[1] > eps)
+			FatalError("Error in complex banded solver too high");
+	}
+
+	if (output)
+		std::cout << "Test successful" << std::endl;
+
+#if SWEET_MPI
+	MPI_Finalize();
+#endif
+
+	return 0;
+}
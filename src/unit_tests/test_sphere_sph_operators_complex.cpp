@@ -12,6 +12,7 @@
 #include <sweet/sphere/SphereData_Config.hpp>
 #include <sweet/sphere/SphereData_SpectralComplex.hpp>
 #include <sweet/sphere/SphereOperators_SphereDataComplex.hpp>
+#include <sweet/sphere/Convert_SphereDataSpectralComplex_to_SphereDataSpectral.hpp>
 
 
 
@@ -383,6 +384,31 @@ void run_tests()
 			if (div_max_error > eps)
 				FatalError(" + ERROR! max error exceeds threshold");
 		}
+
+		if (true)
+		{
+			test_header("Testing real part in spectral space");
+
+			// modes with positive and negative m in the real and imaginary part
+			SphereData_SpectralComplex data(sphereDataConfig);
+			data.physical_update_lambda(
+					[&](double x, double y, std::complex<double> &io_data)
+					{
+						io_data = std::exp(std::complex<double>(0, x))*std::cos(y)
+								+ 0.3*std::exp(std::complex<double>(0, -3*x))*std::cos(y)*std::cos(y)*std::cos(y)
+								+ std::complex<double>(0, std::sin(y)*std::cos(2*x));
+					}
+			);
+
+			SphereData_Spectral real_spectral = Convert_SphereDataSpectralComplex_To_SphereDataSpectral::spectral_convert_real_part(data);
+			SphereData_Spectral real_physical = Convert_SphereDataSpectralComplex_To_SphereDataSpectral::physical_convert_real(data);
+
+			double max_error = (real_spectral-real_physical).spectral_reduce_max_abs();
+			std::cout << " + max_error: " << max_error << std::endl;
+
+			if (max_error > eps)
+				FatalError(" + ERROR! max error exceeds threshold");
+		}
 	}
 };
 
@@ -0,0 +1,260 @@
+/*
+ * test_split_complex.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <complex>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <functional>
+#include <sweet/FatalError.hpp>
+#include <sweet/Stopwatch.hpp>
+#include <sweet/SplitComplex.hpp>
+
+
+typedef std::complex<double> cplx;
+
+
+/*
+ * Deterministic pseudo-random values with a varying magnitude
+ */
+void setup_data(
+		std::vector<cplx> &o_data,
+		int i_seed
+)
+{
+	for (std::size_t i = 0; i < o_data.size(); i++)
+	{
+		double x = std::sin(0.37*(double)(i+1) + i_seed);
+		double y = std::cos(0.91*(double)(i+3) - i_seed);
+		o_data[i] = cplx(x, y)*std::pow(10.0, (double)((i*7+i_seed) % 9) - 4.0);
+	}
+}
+
+
+double max_rel_error(
+		const std::vector<cplx> &i_a,
+		const std::vector<cplx> &i_b
+)
+{
+	double err = 0;
+	for (std::size_t i = 0; i < i_a.size(); i++)
+		err = std::max(err, std::abs(i_a[i]-i_b[i])/std::max(std::abs(i_b[i]), std::numeric_limits<double>::min()));
+	return err;
+}
+
+
+void check(
+		const std::string &i_name,
+		double i_error,
+		double i_eps
+)
+{
+	std::cout << " + " << i_name << ": " << i_error << std::endl;
+
+	if (!(i_error <= i_eps))
+		FatalError(i_name+": error too high");
+}
+
+
+/*
+ * Compare one element of div() with the expected value, NaN matches NaN
+ */
+void check_div(
+		const std::string &i_name,
+		const cplx &i_a,
+		const cplx &i_b,
+		const cplx &i_expected
+)
+{
+	cplx o;
+	SplitComplexKernels::div(1, &i_a, &i_b, &o);
+
+	std::cout << " + div " << i_name << ": " << i_a << "/" << i_b << " = " << o << std::endl;
+
+	auto same = [](double x, double y) -> bool
+	{
+		if (std::isnan(x) || std::isnan(y))
+			return std::isnan(x) && std::isnan(y);
+
+		if (x == y)
+			return true;
+
+		return std::abs(x-y) <= 1e-15*std::abs(y);
+	};
+
+	if (!same(o.real(), i_expected.real()) || !same(o.imag(), i_expected.imag()))
+		FatalError(std::string("div ")+i_name+": unexpected result");
+}
+
+
+
+int main(int i_argc, char *i_argv[])
+{
+	double eps = 1e-15;
+	double nan = std::numeric_limits<double>::quiet_NaN();
+	double inf = std::numeric_limits<double>::infinity();
+
+	/*
+	 * Odd size to also test the remainder block
+	 */
+	std::size_t N = 3*SplitComplexKernels::block_size+17;
+
+	std::vector<cplx> a(N), b(N), out(N), ref(N);
+	setup_data(a, 1);
+	setup_data(b, 2);
+	cplx s(0.3, -1.7);
+
+	std::cout << "Comparing split kernels with std::complex" << std::endl;
+
+	SplitComplexKernels::mul(N, a.data(), b.data(), out.data());
+	for (std::size_t i = 0; i < N; i++)
+		ref[i] = a[i]*b[i];
+	check("mul", max_rel_error(out, ref), eps);
+
+	SplitComplexKernels::mul_scalar(N, a.data(), s, out.data());
+	for (std::size_t i = 0; i < N; i++)
+		ref[i] = a[i]*s;
+	check("mul_scalar", max_rel_error(out, ref), eps);
+
+	SplitComplexKernels::div(N, a.data(), b.data(), out.data());
+	for (std::size_t i = 0; i < N; i++)
+		ref[i] = a[i]/b[i];
+	check("div", max_rel_error(out, ref), 2*eps);
+
+	out = b;
+	SplitComplexKernels::axpy(N, s, a.data(), out.data());
+	for (std::size_t i = 0; i < N; i++)
+		ref[i] = b[i] + s*a[i];
+	check("axpy", max_rel_error(out, ref), 4*eps);
+
+	// b accessed in reversed order, starting with the last element
+	SplitComplexKernels::conj_fold(N, a.data(), &b[N-1], out.data());
+	for (std::size_t i = 0; i < N; i++)
+		ref[i] = 0.5*(a[i] + std::conj(b[N-1-i]));
+	check("conj_fold", max_rel_error(out, ref), eps);
+
+	// sum with split real and imaginary parts
+	SplitComplexArray sum(N);
+	sum.set_zero();
+	sum.axpy(s, a.data());
+	sum.axpy(cplx(-2.0, 0.5), b.data());
+	sum.storeInterleaved(out.data());
+	for (std::size_t i = 0; i < N; i++)
+		ref[i] = s*a[i] + cplx(-2.0, 0.5)*b[i];
+	check("SplitComplexArray::axpy", max_rel_error(out, ref), 1e-12);
+
+	// in-place
+	out = a;
+	SplitComplexKernels::div(N, out.data(), b.data(), out.data());
+	for (std::size_t i = 0; i < N; i++)
+		ref[i] = a[i]/b[i];
+	check("div (in-place)", max_rel_error(out, ref), 2*eps);
+
+
+	std::cout << "Special values for div" << std::endl;
+
+	// no underflow/overflow of |b|^2
+	check_div("tiny b", cplx(1e-160, 3e-160), cplx(2e-160, 1e-160), cplx(1e-160, 3e-160)/cplx(2e-160, 1e-160));
+	check_div("tiny b (imag)", cplx(1, 2), cplx(1e-170, 4e-170), cplx(1, 2)/cplx(1e-170, 4e-170));
+	check_div("huge b", cplx(1e160, -2e160), cplx(3e160, 1e160), cplx(1e160, -2e160)/cplx(3e160, 1e160));
+	check_div("huge b (imag)", cplx(1, 1), cplx(1e200, 5e200), cplx(1, 1)/cplx(1e200, 5e200));
+
+	// zero denominator: same as the std::complex code path of spectral_div_element_wise()
+	check_div("zero b", cplx(1, 2), cplx(0, 0), cplx(0, 0));
+	check_div("zero b, NaN a", cplx(nan, 2), cplx(0, 0), cplx(0, 0));
+
+	// NaN/Inf
+	check_div("NaN a", cplx(nan, 2), cplx(1, 2), cplx(nan, nan));
+	check_div("NaN b", cplx(1, 2), cplx(nan, 2), cplx(nan, nan));
+	check_div("Inf a", cplx(inf, 0), cplx(2, 0), cplx(inf, nan));
+	check_div("Inf b", cplx(1, 2), cplx(inf, 0), cplx(0, 0));
+
+
+	/*
+	 * Compare the run time with the std::complex loops which are used
+	 * without --complex-split.
+	 * "axpy (sum)" is the update of a REXI sum in a SplitComplexArray.
+	 */
+	std::cout << "Timings (split kernels vs. std::complex)" << std::endl;
+
+	std::size_t M = 1 << 16;
+	int iters = 200;
+
+	std::vector<cplx> x(M), y(M), z(M);
+	setup_data(x, 3);
+	setup_data(y, 4);
+
+	auto bench = [&](const std::string &i_name, std::function<void()> i_split, std::function<void()> i_std)
+	{
+		Stopwatch t_split, t_std;
+
+		// warmup
+		i_split();
+		i_std();
+
+		for (int k = 0; k < iters; k++)
+		{
+			t_split.start();
+			i_split();
+			t_split.stop();
+
+			t_std.start();
+			i_std();
+			t_std.stop();
+		}
+
+		std::cout << " + " << std::setw(12) << std::left << i_name
+				<< "split: " << t_split() << " s, std::complex: " << t_std() << " s, speedup: " << t_std()/t_split() << std::endl;
+	};
+
+	bench("mul",
+			[&]{ SplitComplexKernels::mul(M, x.data(), y.data(), z.data()); },
+			[&]{ for (std::size_t i = 0; i < M; i++) z[i] = x[i]*y[i]; }
+		);
+
+	bench("mul_scalar",
+			[&]{ SplitComplexKernels::mul_scalar(M, x.data(), s, z.data()); },
+			[&]{ for (std::size_t i = 0; i < M; i++) z[i] = x[i]*s; }
+		);
+
+	bench("div",
+			[&]{ SplitComplexKernels::div(M, x.data(), y.data(), z.data()); },
+			[&]{
+				for (std::size_t i = 0; i < M; i++)
+				{
+					if (y[i] == cplx(0))
+						z[i] = 0;
+					else
+						z[i] = x[i]/y[i];
+				}
+			}
+		);
+
+	bench("axpy",
+			[&]{ SplitComplexKernels::axpy(M, s, x.data(), z.data()); },
+			[&]{ for (std::size_t i = 0; i < M; i++) z[i] += x[i]*s; }
+		);
+
+	SplitComplexArray z_split(M);
+	z_split.set_zero();
+
+	bench("axpy (sum)",
+			[&]{ z_split.axpy(s, x.data()); },
+			[&]{ for (std::size_t i = 0; i < M; i++) z[i] += x[i]*s; }
+		);
+
+	bench("conj_fold",
+			[&]{ SplitComplexKernels::conj_fold(M/2, x.data(), &x[M-1], z.data()); },
+			[&]{ for (std::size_t i = 0; i < M/2; i++) z[i] = 0.5*(x[i] + std::conj(x[M-1-i])); }
+		);
+
+	std::cout << "SUCCESS" << std::endl;
+
+	return 0;
+}
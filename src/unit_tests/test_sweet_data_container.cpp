@@ -0,0 +1,245 @@
+/*
+ * test_sweet_data_container.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#include <iostream>
+#include <complex>
+#include <vector>
+#include <fstream>
+#include <sweet/FatalError.hpp>
+#include <sweet/SWEETDataContainer.hpp>
+#include <sweet/SWEETCheckpoint.hpp>
+
+
+
+int main(int i_argc, char *i_argv[])
+{
+	std::string filename = "test_sweet_data_container.sweetdc";
+
+	std::size_t N = 123;
+
+	std::vector<double> data_physical(N);
+	std::vector<std::complex<double>> data_spectral(N);
+
+	int64_t res[4] = {(int64_t)N, 1, 0, 0};
+
+	auto setup_data = [&](int i_timestep)
+	{
+		for (std::size_t i = 0; i < N; i++)
+		{
+			data_physical[i] = i*1.5 + i_timestep;
+			data_spectral[i] = std::complex<double>(i, -(double)i_timestep);
+		}
+	};
+
+	/*
+	 * Write 2 time steps, reopen container and append 3rd time step
+	 */
+	{
+		SWEETDataContainerWriter writer;
+		writer.open(filename);
+
+		for (int t = 0; t < 2; t++)
+		{
+			setup_data(t);
+			writer.appendRecord("phys", t, SWEETDataContainer::PRIMITIVE_PLANE, SWEETDataContainer::SPACE_PHYSICAL, SWEETDataContainer::DATA_TYPE_FLOAT64, res, data_physical.data(), N);
+			writer.appendRecord("spec", t, SWEETDataContainer::PRIMITIVE_PLANE, SWEETDataContainer::SPACE_SPECTRAL, SWEETDataContainer::DATA_TYPE_COMPLEX128, res, data_spectral.data(), N);
+		}
+	}
+
+	{
+		SWEETDataContainerWriter writer;
+		writer.open(filename, true);
+
+		setup_data(2);
+		writer.appendRecord("phys", 2, SWEETDataContainer::PRIMITIVE_PLANE, SWEETDataContainer::SPACE_PHYSICAL, SWEETDataContainer::DATA_TYPE_FLOAT64, res, data_physical.data(), N);
+		writer.appendRecord("spec", 2, SWEETDataContainer::PRIMITIVE_PLANE, SWEETDataContainer::SPACE_SPECTRAL, SWEETDataContainer::DATA_TYPE_COMPLEX128, res, data_spectral.data(), N);
+	}
+
+	/*
+	 * Read back data
+	 */
+	SWEETDataContainerReader reader;
+	reader.open(filename);
+
+	std::cout << "Number of records: " << reader.records.size() << std::endl;
+	if (reader.records.size() != 6)
+		FatalError("Wrong number of records");
+
+	for (int t = 0; t < 3; t++)
+	{
+		setup_data(t);
+
+		int id_phys = reader.findRecord("phys", t);
+		int id_spec = reader.findRecord("spec", t);
+
+		if (id_phys < 0 || id_spec < 0)
+			FatalError("Record not found");
+
+		const double *phys = reader.getPayload<double>(id_phys);
+		const std::complex<double> *spec = reader.getPayload<std::complex<double>>(id_spec);
+
+		if ((std::size_t)phys % SWEETDataContainer::alignment != 0 || (std::size_t)spec % SWEETDataContainer::alignment != 0)
+			FatalError("Payload not aligned");
+
+		for (std::size_t i = 0; i < N; i++)
+		{
+			if (phys[i] != data_physical[i])
+				FatalError("Mismatch of physical data");
+
+			if (spec[i] != data_spectral[i])
+				FatalError("Mismatch of spectral data");
+		}
+	}
+
+	if (reader.findRecord("phys", 3) != -1)
+		FatalError("Non-existing record found");
+
+	reader.close();
+
+	std::remove(filename.c_str());
+
+
+	/*
+	 * Checkpoint roundtrip
+	 */
+	{
+		std::string checkpoint_filename = "test_sweet_checkpoint.sweetdc";
+
+		setup_data(7);
+
+		SWEETCheckpoint checkpoint;
+		checkpoint.time = 1.0/3.0;
+		checkpoint.addScalar("timestep_nr", 12345);
+		checkpoint.addScalar("dt", 1.0/7.0);
+		checkpoint.addData("spec", SWEETDataContainer::PRIMITIVE_PLANE, SWEETDataContainer::SPACE_SPECTRAL, SWEETDataContainer::DATA_TYPE_COMPLEX128, res, data_spectral.data(), N);
+		checkpoint.writeFile(checkpoint_filename);
+
+		SWEETCheckpoint checkpoint2;
+		checkpoint2.readFile(checkpoint_filename);
+
+		if (checkpoint2.time != checkpoint.time)
+			FatalError("Mismatch of checkpoint time");
+
+		if (checkpoint2.getScalar("timestep_nr") != 12345 || checkpoint2.getScalar("dt") != 1.0/7.0)
+			FatalError("Mismatch of checkpoint scalars");
+
+		const SWEETCheckpoint::Entry &e = checkpoint2.getEntry("spec", SWEETDataContainer::PRIMITIVE_PLANE, SWEETDataContainer::DATA_TYPE_COMPLEX128, N);
+		if (std::memcmp(e.data.data(), data_spectral.data(), N*sizeof(std::complex<double>)) != 0)
+			FatalError("Mismatch of checkpoint data");
+
+		std::remove(checkpoint_filename.c_str());
+	}
+
+
+	/*
+	 * Compressed records
+	 */
+	{
+		std::vector<SWEETCompression::Codec> codecs = {SWEETCompression::CODEC_QUANTIZE_VARINT};
+#if SWEET_ZLIB
+		codecs.push_back(SWEETCompression::CODEC_SHUFFLE_DEFLATE);
+		codecs.push_back(SWEETCompression::CODEC_QUANTIZE_VARINT_DEFLATE);
+#endif
+
+		double tol = 1e-3;
+		setup_data(5);
+
+		{
+			SWEETDataContainerWriter writer;
+			writer.open(filename);
+
+			for (std::size_t c = 0; c < codecs.size(); c++)
+			{
+				writer.appendRecord("phys", c, SWEETDataContainer::PRIMITIVE_PLANE, SWEETDataContainer::SPACE_PHYSICAL, SWEETDataContainer::DATA_TYPE_FLOAT64, res, data_physical.data(), N, codecs[c], tol);
+				writer.appendRecord("spec", c, SWEETDataContainer::PRIMITIVE_PLANE, SWEETDataContainer::SPACE_SPECTRAL, SWEETDataContainer::DATA_TYPE_COMPLEX128, res, data_spectral.data(), N, codecs[c], tol);
+			}
+		}
+
+		reader.open(filename);
+
+		for (std::size_t c = 0; c < codecs.size(); c++)
+		{
+			// Lossless codecs have to reproduce the data exactly
+			double max_error = SWEETCompression::isLossy(codecs[c]) ? tol : 0;
+
+			std::vector<double> phys(N);
+			std::vector<std::complex<double>> spec(N);
+
+			reader.readPayload(reader.findRecord("phys", c), phys.data());
+			reader.readPayload(reader.findRecord("spec", c), spec.data());
+
+			for (std::size_t i = 0; i < N; i++)
+			{
+				if (std::abs(phys[i] - data_physical[i]) > max_error)
+					FatalError("Mismatch of compressed physical data");
+
+				if (std::abs(spec[i].real() - data_spectral[i].real()) > max_error || std::abs(spec[i].imag() - data_spectral[i].imag()) > max_error)
+					FatalError("Mismatch of compressed spectral data");
+			}
+		}
+
+		reader.close();
+
+		std::remove(filename.c_str());
+	}
+
+	/*
+	 * Corrupt link to next record (must not loop forever)
+	 */
+	{
+		setup_data(3);
+
+		{
+			SWEETDataContainerWriter writer;
+			writer.open(filename);
+			writer.appendRecord("phys", 0, SWEETDataContainer::PRIMITIVE_PLANE, SWEETDataContainer::SPACE_PHYSICAL, SWEETDataContainer::DATA_TYPE_FLOAT64, res, data_physical.data(), N);
+			writer.appendRecord("phys", 1, SWEETDataContainer::PRIMITIVE_PLANE, SWEETDataContainer::SPACE_PHYSICAL, SWEETDataContainer::DATA_TYPE_FLOAT64, res, data_physical.data(), N);
+		}
+
+		{
+			// Set link of 2nd record to 0
+			std::fstream file(filename, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+
+			SWEETDataContainer::FileHeader header;
+			file.read((char*)&header, sizeof(header));
+
+			SWEETDataContainer::RecordHeader record;
+			file.seekg(header.first_record_offset);
+			file.read((char*)&record, sizeof(record));
+
+			uint64_t second_record_offset = record.next_record_offset;
+			file.seekg(second_record_offset);
+			file.read((char*)&record, sizeof(record));
+
+			record.next_record_offset = 0;
+			file.seekp(second_record_offset);
+			file.write((const char*)&record, sizeof(record));
+		}
+
+		reader.open(filename);
+		if (reader.records.size() != 1)
+			FatalError("Wrong number of records with corrupt link");
+		reader.close();
+
+		{
+			SWEETDataContainerWriter writer;
+			writer.open(filename, true);
+			writer.appendRecord("phys", 2, SWEETDataContainer::PRIMITIVE_PLANE, SWEETDataContainer::SPACE_PHYSICAL, SWEETDataContainer::DATA_TYPE_FLOAT64, res, data_physical.data(), N);
+		}
+
+		reader.open(filename);
+		if (reader.records.size() != 2 || reader.findRecord("phys", 1) != -1 || reader.findRecord("phys", 2) != 1)
+			FatalError("Corrupt record not overwritten");
+		reader.close();
+
+		std::remove(filename.c_str());
+	}
+
+	std::cout << "Tests passed" << std::endl;
+
+	return 0;
+}
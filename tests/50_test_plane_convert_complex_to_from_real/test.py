@@ -19,6 +19,7 @@ jg.compile.plane_spectral_space="enable"
 
 params_compile_mode = ['release', 'debug']
 params_compile_plane_spectral_dealiasing = ['enable', 'disable']
+params_compile_complex_split = ['enable', 'disable']
 
 #params_runtime_spectral_derivs = [0, 1]
 
@@ -39,10 +40,12 @@ for (phys_res_x, phys_res_y, mode_res_x, mode_res_y) in product(params_runtime_p
 		for (
 			jg.compile.mode,
 			jg.compile.plane_spectral_dealiasing,
+			jg.compile.complex_split,
 #			jg.runtime.space_use_spectral_basis_diffs,
 		) in product(
 			params_compile_mode,
 			params_compile_plane_spectral_dealiasing,
+			params_compile_complex_split,
 #			params_runtime_spectral_derivs
 		):
 			jg.gen_jobscript_directory()
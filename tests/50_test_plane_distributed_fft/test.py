@@ -0,0 +1,36 @@
+#! /usr/bin/env python3
+
+import sys
+import os
+os.chdir(os.path.dirname(sys.argv[0]))
+
+from mule_local.JobMule import *
+from mule.exec_program import *
+
+exec_program('mule.benchmark.cleanup_all', catch_output=False)
+
+jg = JobGeneration()
+jg.compile.unit_test="test_plane_distributed_fft"
+jg.compile.plane_spectral_space="enable"
+jg.compile.plane_spectral_dealiasing="enable"
+jg.compile.sweet_mpi="enable"
+
+jg.runtime.verbosity = 5
+jg.runtime.space_res_physical = 16
+
+for num_ranks in [1, 2, 3]:
+	pspace = JobParallelizationDimOptions('space')
+	pspace.num_cores_per_rank = 1
+	pspace.num_threads_per_rank = 1
+	pspace.num_ranks = num_ranks
+
+	jg.setup_parallelization([pspace])
+	jg.gen_jobscript_directory()
+
+exitcode = exec_program('mule.benchmark.jobs_run_directly', catch_output=False)
+if exitcode != 0:
+	sys.exit(exitcode)
+
+print("Benchmarks successfully finished")
+
+exec_program('mule.benchmark.cleanup_all', catch_output=False)
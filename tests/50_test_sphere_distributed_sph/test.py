@@ -0,0 +1,39 @@
+#! /usr/bin/env python3
+
+import sys
+import os
+os.chdir(os.path.dirname(sys.argv[0]))
+
+from mule_local.JobMule import *
+from mule.exec_program import *
+
+exec_program('mule.benchmark.cleanup_all', catch_output=False)
+
+jg = JobGeneration()
+jg.compile.unit_test="test_sphere_distributed_sph"
+jg.compile.plane_spectral_space="disable"
+jg.compile.sphere_spectral_space="enable"
+jg.compile.sweet_mpi="enable"
+jg.compile.threading="omp"
+
+jg.runtime.verbosity = 5
+
+for jg.runtime.space_res_spectral in [32, 64, 128]:
+	for num_ranks in [1, 2, 3]:
+		# Also run the solvers multi-threaded
+		for num_threads in [1, 4]:
+			pspace = JobParallelizationDimOptions('space')
+			pspace.num_cores_per_rank = num_threads
+			pspace.num_threads_per_rank = num_threads
+			pspace.num_ranks = num_ranks
+
+			jg.setup_parallelization([pspace])
+			jg.gen_jobscript_directory()
+
+exitcode = exec_program('mule.benchmark.jobs_run_directly', catch_output=False)
+if exitcode != 0:
+	sys.exit(exitcode)
+
+print("Benchmarks successfully finished")
+
+exec_program('mule.benchmark.cleanup_all', catch_output=False)
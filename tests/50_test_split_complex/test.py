@@ -0,0 +1,29 @@
+#! /usr/bin/env python3
+
+import sys
+import os
+os.chdir(os.path.dirname(sys.argv[0]))
+
+from mule_local.JobMule import *
+from itertools import product
+from mule.exec_program import *
+
+exec_program('mule.benchmark.cleanup_all', catch_output=False)
+
+jg = JobGeneration()
+jg.compile.unit_test="test_split_complex"
+jg.compile.complex_split = "enable"
+jg.runtime.verbosity = 5
+
+params_compile_mode = ['release', 'debug']
+
+for jg.compile.mode in params_compile_mode:
+	jg.gen_jobscript_directory()
+
+exitcode = exec_program('mule.benchmark.jobs_run_directly', catch_output=False)
+if exitcode != 0:
+	sys.exit(exitcode)
+
+print("Benchmarks successfully finished")
+
+exec_program('mule.benchmark.cleanup_all', catch_output=False)
@@ -0,0 +1,99 @@
+#! /usr/bin/env python3
+
+import sys
+import os
+os.chdir(os.path.dirname(sys.argv[0]))
+
+from mule_local.JobMule import *
+from mule.exec_program import *
+from mule.postprocessing.JobsData import *
+from mule_local.postprocessing.pickle_PlaneDataPhysicalDiff import *
+
+exec_program('mule.benchmark.cleanup_all', catch_output=False)
+
+jg = JobGeneration()
+jg.compile.program = "swe_plane"
+jg.compile.plane_spectral_space = "enable"
+jg.compile.plane_spectral_dealiasing = "enable"
+jg.compile.sweet_mpi = "enable"
+
+jg.runtime.verbosity = 2
+jg.runtime.space_res_physical = 32
+jg.runtime.benchmark_name = "radial_gaussian_bump"
+
+jg.runtime.gravitation = 1
+jg.runtime.h0 = 1
+jg.runtime.plane_domain_size = 1
+jg.runtime.viscosity = 0.0
+
+jg.runtime.timestepping_method = "ln_erk"
+jg.runtime.timestepping_order = 4
+jg.runtime.timestep_size = 0.0001
+jg.runtime.max_simulation_time = jg.runtime.timestep_size*50
+jg.runtime.output_timestep_size = jg.runtime.max_simulation_time
+
+jg.unique_id_filter = ['compile']
+
+
+def setup_ranks(num_ranks):
+	pspace = JobParallelizationDimOptions('space')
+	pspace.num_cores_per_rank = 1
+	pspace.num_threads_per_rank = 1
+	pspace.num_ranks = num_ranks
+
+	jg.setup_parallelization([pspace])
+
+
+#
+# Reference solution with PlaneData on a single rank
+#
+setup_ranks(1)
+jg.runtime.space_plane_distributed = 0
+
+jg.reference_job = True
+jg.gen_jobscript_directory()
+jg.reference_job = False
+
+jg.reference_job_unique_id = jg.job_unique_id
+
+
+#
+# Same time stepper with PlaneDataDistributed
+#
+jg.runtime.space_plane_distributed = 1
+
+for num_ranks in [1, 2, 3]:
+	setup_ranks(num_ranks)
+	jg.gen_jobscript_directory()
+
+
+exitcode = exec_program('mule.benchmark.jobs_run_directly', catch_output=False)
+if exitcode != 0:
+	sys.exit(exitcode)
+
+pickle_PlaneDataPhysicalDiff()
+
+
+#
+# The distributed results have to match the reference up to round-off errors
+#
+eps = 1e-10
+
+j = JobsData(verbosity=0)
+jobs = j.get_flattened_data()
+
+for key, job in jobs.items():
+	if 'jobgeneration.reference_job_unique_id' not in job:
+		continue
+
+	for var in ['prog_h_pert', 'prog_u', 'prog_v']:
+		error = job['plane_data_diff_'+var+'.res_norm_linf']
+		print(key+": "+var+" error "+str(error))
+
+		if error > eps:
+			print("Error too high!")
+			sys.exit(1)
+
+print("Benchmarks successfully finished")
+
+exec_program('mule.benchmark.cleanup_all', catch_output=False)
@@ -0,0 +1,58 @@
+#! /usr/bin/env python3
+
+import sys
+
+from mule_local.JobMule import *
+from mule.exec_program import *
+from mule.InfoError import *
+
+jg = JobGeneration()
+
+
+"""
+Compile parameters
+"""
+jg.compile.program = 'swe_sphere'
+
+jg.compile.plane_spectral_space = 'disable'
+jg.compile.plane_spectral_dealiasing = 'disable'
+jg.compile.sphere_spectral_space = 'enable'
+jg.compile.sphere_spectral_dealiasing = 'enable'
+
+jg.compile.threading = 'omp'
+
+jg.unique_id_filter = ['runtime.simparams', 'parallelization', 'benchmark', 'runtime.rexi_params']
+
+
+"""
+Runtime parameters
+"""
+jg.runtime.benchmark_name = 'galewsky'
+
+jg.runtime.space_res_spectral = 64
+jg.runtime.space_res_physical = None
+
+jg.runtime.timestepping_method = 'ln_erk'
+jg.runtime.timestepping_order = 2
+jg.runtime.timestepping_order2 = 2
+
+# run 10 time steps
+jg.runtime.timestep_size = 60
+jg.runtime.max_simulation_time = 10*60
+
+jg.runtime.instability_checks = 1
+jg.runtime.verbosity = 2
+
+jg.runtime.ensemble_members = 3
+
+# All members are identical without perturbation
+params_runtime_ensemble_perturbation = [0, 1e-6]
+
+
+#
+# allow including this file
+#
+if __name__ == "__main__":
+
+	for jg.runtime.ensemble_perturbation in params_runtime_ensemble_perturbation:
+		jg.gen_jobscript_directory()
@@ -0,0 +1,56 @@
+#! /usr/bin/env python3
+
+import sys
+
+from mule.postprocessing.JobsData import *
+
+
+j = JobsData('./job_bench_*', verbosity=0)
+
+jobs_data = j.get_flattened_data()
+
+if len(jobs_data) != 2:
+	raise Exception("Expected 2 jobs, found "+str(len(jobs_data)))
+
+
+for job_key, job_data in jobs_data.items():
+
+	num_members = job_data['runtime.ensemble_members']
+	perturbation = job_data['runtime.ensemble_perturbation']
+
+	print(job_data['jobgeneration.job_dirpath']+": perturbation = "+str(perturbation))
+
+	if int(job_data['output.ensemble.num_members']) != num_members:
+		raise Exception("Wrong number of ensemble members")
+
+	if int(job_data['output.ensemble.num_stable_members']) != num_members:
+		raise Exception("Unstable ensemble members")
+
+	total_mass = []
+	for i in range(num_members):
+		prefix = 'output.ensemble.member_'+str(i).zfill(4)+'.'
+
+		# Each member has its own time control
+		simtime = float(job_data[prefix+'current_simulation_time'])
+		if abs(simtime - job_data['runtime.max_simulation_time']) > 1e-10:
+			raise Exception("Member "+str(i)+" stopped at simulation time "+str(simtime))
+
+		total_mass.append(float(job_data[prefix+'total_mass']))
+
+	spread = float(job_data['output.ensemble.spread_phi_rms'])
+	print(" + spread_phi_rms: "+str(spread))
+	print(" + total_mass: "+str(total_mass))
+
+	if perturbation == 0:
+		# Members don't share any state which is modified, hence they have to be identical
+		if spread != 0:
+			raise Exception("Members without perturbation differ")
+
+		if max(total_mass) != min(total_mass):
+			raise Exception("Members without perturbation differ in mass")
+
+	else:
+		if spread <= 0:
+			raise Exception("No spread of perturbed members")
+
+print("Test successful")